@@ -710,6 +710,75 @@ Vector<double> BoundingLayer::calculate_outputs(const Vector<double>& inputs) co
 }  
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&) const method
+
+/// Bounds a batch of inputs at once, column by column.
+/// @param inputs Matrix of inputs to the bounding layer. The number of columns must be equal to the number of bounding neurons.
+
+Matrix<double> BoundingLayer::calculate_outputs(const Matrix<double>& inputs) const
+{
+   const size_t rows_number = inputs.get_rows_number();
+   const size_t bounding_neurons_number = get_bounding_neurons_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   const size_t columns_number = inputs.get_columns_number();
+
+   if(columns_number != bounding_neurons_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: BoundingLayer class.\n"
+             << "Matrix<double> calculate_outputs(const Matrix<double>&) const method.\n"
+             << "Number of columns of inputs must be equal to number of bounding neurons.\n";
+
+	  throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   Matrix<double> outputs(inputs);
+
+   if(bounding_method == NoBounding)
+   {
+       return(outputs);
+   }
+   else if(bounding_method == Bounding)
+   {
+       for(size_t j = 0; j < bounding_neurons_number; j++)
+       {
+           double* column = outputs.data() + j*rows_number;
+
+           for(size_t i = 0; i < rows_number; i++)
+           {
+               if(column[i] < lower_bounds[j])
+               {
+                   column[i] = lower_bounds[j];
+               }
+               else if(column[i] > upper_bounds[j])
+               {
+                   column[i] = upper_bounds[j];
+               }
+           }
+       }
+
+       return(outputs);
+   }
+   else
+   {
+       std::ostringstream buffer;
+
+       buffer << "OpenNN Exception: BoundingLayer class.\n"
+              << "Matrix<double> calculate_outputs(const Matrix<double>&) const method.\n"
+              << "Unknown bounding method.\n";
+
+       throw std::logic_error(buffer.str());
+   }
+}
+
+
 // Vector<double> calculate_derivative(const Vector<double>&) const method
 
 /// Returns the derivatives of the outputs with respect to the inputs.
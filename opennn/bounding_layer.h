@@ -134,6 +134,8 @@ public:
    Vector<double> calculate_derivative(const Vector<double>&) const;
    Vector<double> calculate_second_derivative(const Vector<double>&) const;
 
+   Matrix<double> calculate_outputs(const Matrix<double>&) const;
+
    Matrix<double> arrange_Jacobian(const Vector<double>&) const;
    Vector< Matrix<double> > arrange_Hessian_form(const Vector<double>&) const;
 
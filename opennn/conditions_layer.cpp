@@ -760,6 +760,28 @@ Vector<double> ConditionsLayer::calculate_outputs(const Vector<double>& external
 }
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the outputs satisfying the conditions for a batch of external inputs and raw outputs.
+/// The particular and homogeneous solutions depend on each external input, so they are evaluated row by row.
+/// @param external_inputs Matrix of external inputs. Each row contains one external input vector.
+/// @param inputs Matrix of inputs to the conditions layer. Each row contains one input vector.
+
+Matrix<double> ConditionsLayer::calculate_outputs(const Matrix<double>& external_inputs, const Matrix<double>& inputs) const
+{
+   const size_t rows_number = inputs.get_rows_number();
+
+   Matrix<double> outputs(rows_number, inputs.get_columns_number());
+
+   for(size_t i = 0; i < rows_number; i++)
+   {
+      outputs.set_row(i, calculate_outputs(external_inputs.arrange_row(i), inputs.arrange_row(i)));
+   }
+
+   return(outputs);
+}
+
+
 // Matrix<double> calculate_Jacobian(const Vector<double>&, const Vector<double>&) const method
 
 /// Calculates the partial derivatives of the outputs satisfying some boundary conditions with respect to the raw outputs. 
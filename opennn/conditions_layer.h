@@ -143,6 +143,7 @@ public:
    virtual Vector< Matrix<double> > calculate_homogeneous_solution_Hessian_form(const Vector<double>&) const;
 
    Vector<double> calculate_outputs(const Vector<double>&, const Vector<double>&) const;
+   Matrix<double> calculate_outputs(const Matrix<double>&, const Matrix<double>&) const;
 
    Matrix<double> calculate_Jacobian(const Vector<double>&, const Vector<double>&, const Matrix<double>&) const;
 
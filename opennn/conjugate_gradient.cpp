@@ -1203,7 +1203,7 @@ double ConjugateGradient::calculate_PR_parameter(const Vector<double>& old_gradi
 
    double PR_parameter = 0.0;
 
-   const double numerator = (gradient-old_gradient).dot(gradient);
+   const double numerator = (gradient.eigen_map() - old_gradient.eigen_map()).dot(gradient.eigen_map());
    const double denominator = old_gradient.dot(old_gradient);
 
    // Prevent a possible division by 0
@@ -1300,13 +1300,14 @@ Vector<double> ConjugateGradient::calculate_PR_training_direction
    const double PR_parameter = calculate_PR_parameter(old_gradient, gradient);
 
    const Vector<double> gradient_descent_term = calculate_gradient_descent_training_direction(gradient);
-   const Vector<double> conjugate_direction_term = old_training_direction*PR_parameter;
 
-   const Vector<double> PR_training_direction = gradient_descent_term + conjugate_direction_term;
+   Vector<double> PR_training_direction = gradient_descent_term.eigen_map() + old_training_direction.eigen_map()*PR_parameter;
 
    const double PR_training_direction_norm = PR_training_direction.calculate_norm();   
 
-   return(PR_training_direction/PR_training_direction_norm);
+   PR_training_direction.eigen_map() /= PR_training_direction_norm;
+
+   return(PR_training_direction);
 }
 
 
@@ -1377,13 +1378,14 @@ Vector<double> ConjugateGradient::calculate_FR_training_direction
    const double FR_parameter = calculate_FR_parameter(old_gradient, gradient);
 
    const Vector<double> gradient_descent_term = calculate_gradient_descent_training_direction(gradient);
-   const Vector<double> conjugate_direction_term = old_training_direction*FR_parameter;
 
-   const Vector<double> FR_training_direction = gradient_descent_term + conjugate_direction_term;
+   Vector<double> FR_training_direction = gradient_descent_term.eigen_map() + old_training_direction.eigen_map()*FR_parameter;
 
    const double FR_training_direction_norm = FR_training_direction.calculate_norm();   
 
-   return(FR_training_direction/FR_training_direction_norm);
+   FR_training_direction.eigen_map() /= FR_training_direction_norm;
+
+   return(FR_training_direction);
 }
 
 
@@ -1526,7 +1528,14 @@ Vector<double> ConjugateGradient::calculate_gradient_descent_training_direction(
 
     #endif
 
-    return(gradient.calculate_normalized()*(-1.0));
+    const double gradient_norm = gradient.calculate_norm();
+
+    if(gradient_norm == 0.0)
+    {
+       return(Vector<double>(gradient.size(), 0.0));
+    }
+
+    return(gradient.eigen_map()*(-1.0/gradient_norm));
 }
 
 
@@ -1836,6 +1845,8 @@ ConjugateGradient::ConjugateGradientResults* ConjugateGradient::perform_training
    Vector<double> gradient(parameters_number);
    double gradient_norm;
 
+   LossIndex::FirstOrderloss first_order_loss;
+
    double selection_loss = 0.0; 
    double old_selection_loss = 0.0;
 
@@ -1875,8 +1886,6 @@ ConjugateGradient::ConjugateGradientResults* ConjugateGradient::perform_training
 
       // Neural network
 
-      parameters = neural_network_pointer->arrange_parameters();
-
       parameters_norm = parameters.calculate_norm();
 
       if(parameters_norm >= error_parameters_norm)
@@ -1897,17 +1906,21 @@ ConjugateGradient::ConjugateGradientResults* ConjugateGradient::perform_training
       // Loss index stuff
     
       if(iteration == 0)
-      {      
-         loss = loss_index_pointer->calculate_loss();
-         loss_increase = 0.0; 
+      {
+         first_order_loss = loss_index_pointer->calculate_first_order_loss();
+
+         loss = first_order_loss.loss;
+         loss_increase = 0.0;
+
+         gradient = first_order_loss.gradient;
       }
       else
       {
          loss = directional_point[1];
-         loss_increase = old_loss - loss; 
-      }
+         loss_increase = old_loss - loss;
 
-      gradient = loss_index_pointer->calculate_gradient();
+         gradient = loss_index_pointer->calculate_gradient();
+      }
 
       gradient_norm = gradient.calculate_norm();
 
@@ -1922,7 +1935,7 @@ ConjugateGradient::ConjugateGradientResults* ConjugateGradient::perform_training
       {
           minimum_selection_error = selection_loss;
 
-          minimum_selection_error_parameters = neural_network_pointer->arrange_parameters();
+          minimum_selection_error_parameters = parameters;
       }
       else if(iteration != 0 && selection_loss > old_selection_loss)
       {
@@ -1932,7 +1945,7 @@ ConjugateGradient::ConjugateGradientResults* ConjugateGradient::perform_training
       {
           minimum_selection_error = selection_loss;
 
-          minimum_selection_error_parameters = neural_network_pointer->arrange_parameters();
+          minimum_selection_error_parameters = parameters;
       }
 
       // Training algorithm 
@@ -1995,7 +2008,7 @@ ConjugateGradient::ConjugateGradientResults* ConjugateGradient::perform_training
 		 training_rate = directional_point[0];
       }
 
-      parameters_increment = training_direction*training_rate;
+      parameters_increment = training_direction.eigen_map()*training_rate;
       parameters_increment_norm = parameters_increment.calculate_norm();
       
       // Elapsed time
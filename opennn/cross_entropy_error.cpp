@@ -276,71 +276,45 @@ double CrossEntropyError::calculate_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
-   // Data set stuff 
+   // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-   const size_t training_instances_number = instances.count_training_instances_number();
+      return(calculate_instances_error(training_indices, multilayer_perceptron_pointer->arrange_parameters()));
+   }
 
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-   size_t training_index;
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-   const Variables& variables = data_set_pointer->get_variables();
+   // Cross entropy error stuff
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Cross entropy error
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
+   const size_t size = outputs.size();
 
    double cross_entropy_error = 0.0;
 
-   int i = 0;
-
-
-#pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : cross_entropy_error)
+   double output;
 
-   for(i = 0; i < (int)training_instances_number; i++)
+   for(size_t i = 0; i < size; i++)
    {
-       training_index = training_indices[i];
+      output = outputs[i];
 
-      // Input vector
-
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
-
-      // Target vector
-
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
-
-      // Cross entropy error
-
-      for(size_t j = 0; j < outputs_number; j++)
+      if(output == 0.0)
       {
-          if(outputs[j] == 0.0)
-          {
-              outputs[j] = 1.0e-6;
-          }
-          else if(outputs[j] == 1.0)
-          {
-              outputs[j] = 0.999999;
-          }
-
-          cross_entropy_error -= (targets[j]*log(outputs[j]) + (1.0 - targets[j])*log(1.0 - outputs[j]));
+          output = 1.0e-6;
+      }
+      else if(output == 1.0)
+      {
+          output = 0.999999;
       }
+
+      cross_entropy_error -= (targets[i]*log(output) + (1.0 - targets[i])*log(1.0 - output));
    }
 
-   return(cross_entropy_error/(double)training_instances_number);
+   return(cross_entropy_error/(double)inputs.get_rows_number());
 }
 
 
@@ -385,70 +359,45 @@ double CrossEntropyError::calculate_error(const Vector<double>& parameters) cons
 
     const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
-    // Data set stuff
-
-    const Instances& instances = data_set_pointer->get_instances();
-
-    const size_t training_instances_number = instances.count_training_instances_number();
-
-    const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-    size_t training_index;
-
-    const Variables& variables = data_set_pointer->get_variables();
-
-    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-    // Cross-entropy error stuff
-
-    Vector<double> inputs(inputs_number);
-    Vector<double> outputs(outputs_number);
-    Vector<double> targets(outputs_number);
-
-    double cross_entropy_error = 0.0;
+   // Data set stuff
 
-    int i = 0;
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-    #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : cross_entropy_error)
+      return(calculate_instances_error(training_indices, parameters));
+   }
 
-    for(i = 0; i < (int)training_instances_number; i++)
-    {
-        training_index = training_indices[i];
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-       // Input vector
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
-       inputs = data_set_pointer->get_instance(training_index, inputs_indices);
+   // Cross entropy error stuff
 
-       // Output vector
-
-       outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
+   const size_t size = outputs.size();
 
-       // Target vector
+   double cross_entropy_error = 0.0;
 
-       targets = data_set_pointer->get_instance(training_index, targets_indices);
+   double output;
 
-       // Cross-entropy error
+   for(size_t i = 0; i < size; i++)
+   {
+      output = outputs[i];
 
-       for(size_t j = 0; j < outputs_number; j++)
-       {
-           if(outputs[j] == 0.0)
-           {
-               outputs[j] = 1.0e-6;
-           }
-           else if(outputs[j] == 1)
-           {
-               outputs[j] = 0.99999;
-           }
+      if(output == 0.0)
+      {
+          output = 1.0e-6;
+      }
+      else if(output == 1.0)
+      {
+          output = 0.99999;
+      }
 
-           cross_entropy_error -= (targets[j]*log(outputs[j]) + (1.0 - targets[j])*log(1.0 - outputs[j]));
-       }
-    }
+      cross_entropy_error -= (targets[i]*log(output) + (1.0 - targets[i])*log(1.0 - output));
+   }
 
-    return(cross_entropy_error/(double)training_instances_number);
+   return(cross_entropy_error/(double)inputs.get_rows_number());
 }
 
 
@@ -565,70 +514,56 @@ double CrossEntropyError::calculate_selection_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
    const Instances& instances = data_set_pointer->get_instances();
 
    const size_t selection_instances_number = instances.count_selection_instances_number();
 
-   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
-
-   size_t selection_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Loss index
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   double selection_loss = 0.0;
+   if(selection_instances_number == 0)
+   {
+      return(0.0);
+   }
 
-   int i = 0;
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> selection_indices = instances.arrange_selection_indices();
 
-   #pragma omp parallel for private(i, selection_index, inputs, outputs, targets) reduction(- : selection_loss)
+      // The error of each batch is normalized by the number of training instances
 
-   for(i = 0; i < (int)selection_instances_number; i++)
-   {
-       selection_index = selection_indices[i];
+      return(calculate_instances_error(selection_indices, multilayer_perceptron_pointer->arrange_parameters())*(double)instances.count_training_instances_number()/(double)selection_instances_number);
+   }
 
-      // Input vector
+   const Matrix<double>& inputs = data_set_pointer->get_selection_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
 
-      inputs = data_set_pointer->get_instance(selection_index, inputs_indices);
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-      // Output vector
+   // Cross entropy error stuff
 
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+   const size_t size = outputs.size();
 
-      // Target vector
+   double selection_loss = 0.0;
 
-      targets = data_set_pointer->get_instance(selection_index, targets_indices);
+   double output;
 
-      // Cross entropy error
+   for(size_t i = 0; i < size; i++)
+   {
+      output = outputs[i];
 
-      for(size_t j = 0; j < outputs_number; j++)
+      if(output == 0.0)
       {
-          if(outputs[j] == 0.0)
-          {
-              outputs[j] = 1.0e-6;
-          }
-          else if(outputs[j] == 1.0)
-          {
-              outputs[j] = 0.999999;
-          }
-
-          selection_loss -= (targets[j]*log(outputs[j]) + (1.0 - targets[j])*log(1.0 - outputs[j]));
+          output = 1.0e-6;
       }
+      else if(output == 1.0)
+      {
+          output = 0.999999;
+      }
+
+      selection_loss -= (targets[i]*log(output) + (1.0 - targets[i])*log(1.0 - output));
    }
 
-   return(selection_loss/(double)selection_instances_number);
+   return(selection_loss/(double)inputs.get_rows_number());
 }
 
 
@@ -1236,6 +1171,62 @@ Vector<double> CrossEntropyError::calculate_output_gradient(const Vector<double>
 }
 
 
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the contribution of a batch of instances to the cross-entropy error,
+/// which is normalized by the number of training instances.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
+
+double CrossEntropyError::calculate_batch_error(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+   const size_t training_instances_number = data_set_pointer->get_instances().count_training_instances_number();
+
+   const size_t size = outputs.size();
+
+   double cross_entropy_error = 0.0;
+
+   double output;
+
+   for(size_t i = 0; i < size; i++)
+   {
+      output = outputs[i];
+
+      if(output == 0.0)
+      {
+          output = 1.0e-6;
+      }
+      else if(output == 1.0)
+      {
+          output = 0.999999;
+      }
+
+      cross_entropy_error -= (targets[i]*log(output) + (1.0 - targets[i])*log(1.0 - output));
+   }
+
+   return(cross_entropy_error/(double)training_instances_number);
+}
+
+
+// FirstOrderPerformance calculate_first_order_loss(void) const method
+
+/// Returns the cross-entropy error and its gradient on the training instances,
+/// both computed from a single forward propagation of the instances.
+
+ErrorTerm::FirstOrderPerformance CrossEntropyError::calculate_first_order_loss(void) const
+{
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
+
+    return(calculate_batch_first_order_loss(training_indices));
+}
+
+
 // Matrix<double> calculate_output_Hessian(const Vector<double>&, const Vector<double>&) const method
 
 /// Returns the cross-entropy error function otuput Hessian of a multilayer perceptron on a data set.
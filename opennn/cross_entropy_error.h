@@ -104,6 +104,10 @@ public:
    Vector<double> calculate_output_gradient(const Vector<double> &, const Vector<double> &) const;
    Matrix<double> calculate_output_Hessian(const Vector<double> &, const Vector<double> &) const;
 
+   double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const;
+
+   FirstOrderPerformance calculate_first_order_loss(void) const;
+
    Vector<double> calculate_output_gradient_unnormalized(const Vector<double> &, const Vector<double> &) const;
 
    Vector<double> calculate_gradient_unnormalized(void) const;
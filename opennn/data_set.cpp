@@ -15,6 +15,15 @@
 
 #include "data_set.h"
 
+// System includes
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 
 namespace OpenNN
 {
@@ -26,6 +35,8 @@ namespace OpenNN
 
 DataSet::DataSet(void)
 {
+   data_version = 0;
+
    set();  
 
    set_default();
@@ -40,6 +51,8 @@ DataSet::DataSet(void)
 
 DataSet::DataSet(const Matrix<double>& data)
 {
+   data_version = 0;
+
    set(data);
 
    set_default();
@@ -57,6 +70,8 @@ DataSet::DataSet(const Matrix<double>& data)
 
 DataSet::DataSet(const size_t& new_instances_number, const size_t& new_variables_number)
 {
+   data_version = 0;
+
    set(new_instances_number, new_variables_number);
 
    set_default();
@@ -74,6 +89,8 @@ DataSet::DataSet(const size_t& new_instances_number, const size_t& new_variables
 
 DataSet::DataSet(const size_t& new_instances_number, const size_t& new_inputs_number, const size_t& new_targets_number)
 {
+   data_version = 0;
+
    set(new_instances_number, new_inputs_number, new_targets_number);
 
    set_default();
@@ -87,6 +104,8 @@ DataSet::DataSet(const size_t& new_instances_number, const size_t& new_inputs_nu
 
 DataSet::DataSet(const tinyxml2::XMLDocument& data_set_document)
 {
+   data_version = 0;
+
    set_default();
 
    from_XML(data_set_document);
@@ -101,6 +120,8 @@ DataSet::DataSet(const tinyxml2::XMLDocument& data_set_document)
 
 DataSet::DataSet(const std::string& file_name)
 {
+   data_version = 0;
+
    set();
 
    set_default();
@@ -117,6 +138,8 @@ DataSet::DataSet(const std::string& file_name)
 
 DataSet::DataSet(const DataSet& other_data_set)
 {
+   data_version = 0;
+
    set_default();
 
    set(other_data_set);
@@ -129,6 +152,7 @@ DataSet::DataSet(const DataSet& other_data_set)
 
 DataSet::~DataSet(void)
 {
+   close_out_of_core_data();
 }
 
 
@@ -159,6 +183,10 @@ DataSet& DataSet::operator = (const DataSet& other_data_set)
       // Utilities
 
       display = other_data_set.display;
+
+      invalidate_split_data();
+
+      copy_out_of_core_data(other_data_set);
    }
 
    return(*this);
@@ -337,6 +365,18 @@ const Matrix<double>& DataSet::get_data(void) const
 }
 
 
+// const size_t& get_data_version(void) const method
+
+/// Returns the number of modifications of the data matrix since the data set was constructed.
+/// Quantities calculated from the data, such as the normalization coefficients of some error terms,
+/// are out of date if the data version has changed since they were calculated.
+
+const size_t& DataSet::get_data_version(void) const
+{
+   return(data_version);
+}
+
+
 // const Matrix<double>& get_time_series_data(void) const method
 
 /// Returns a reference to the time series data matrix in the data set.
@@ -948,6 +988,114 @@ Matrix<double> DataSet::arrange_testing_target_data(void) const
 }
 
 
+// const Matrix<double>& get_training_input_data(void) const method
+
+/// Returns a reference to the matrix with the training instances and input variables.
+/// The matrix is arranged from the data on first use, and kept until the data, the instances uses
+/// or the variables uses change.
+/// The number of rows is the number of training instances.
+/// The number of columns is the number of input variables.
+
+const Matrix<double>& DataSet::get_training_input_data(void) const
+{
+   return(get_split_data(Instances::Training).inputs);
+}
+
+
+// const Matrix<double>& get_training_target_data(void) const method
+
+/// Returns a reference to the matrix with the training instances and target variables.
+/// The matrix is arranged from the data on first use, and kept until the data, the instances uses
+/// or the variables uses change.
+/// The number of rows is the number of training instances.
+/// The number of columns is the number of target variables.
+
+const Matrix<double>& DataSet::get_training_target_data(void) const
+{
+   return(get_split_data(Instances::Training).targets);
+}
+
+
+// const Matrix<double>& get_selection_input_data(void) const method
+
+/// Returns a reference to the matrix with the selection instances and input variables.
+/// The matrix is arranged from the data on first use, and kept until the data, the instances uses
+/// or the variables uses change.
+/// The number of rows is the number of selection instances.
+/// The number of columns is the number of input variables.
+
+const Matrix<double>& DataSet::get_selection_input_data(void) const
+{
+   return(get_split_data(Instances::Selection).inputs);
+}
+
+
+// const Matrix<double>& get_selection_target_data(void) const method
+
+/// Returns a reference to the matrix with the selection instances and target variables.
+/// The matrix is arranged from the data on first use, and kept until the data, the instances uses
+/// or the variables uses change.
+/// The number of rows is the number of selection instances.
+/// The number of columns is the number of target variables.
+
+const Matrix<double>& DataSet::get_selection_target_data(void) const
+{
+   return(get_split_data(Instances::Selection).targets);
+}
+
+
+// const Matrix<double>& get_testing_input_data(void) const method
+
+/// Returns a reference to the matrix with the testing instances and input variables.
+/// The matrix is arranged from the data on first use, and kept until the data, the instances uses
+/// or the variables uses change.
+/// The number of rows is the number of testing instances.
+/// The number of columns is the number of input variables.
+
+const Matrix<double>& DataSet::get_testing_input_data(void) const
+{
+   return(get_split_data(Instances::Testing).inputs);
+}
+
+
+// const Matrix<double>& get_testing_target_data(void) const method
+
+/// Returns a reference to the matrix with the testing instances and target variables.
+/// The matrix is arranged from the data on first use, and kept until the data, the instances uses
+/// or the variables uses change.
+/// The number of rows is the number of testing instances.
+/// The number of columns is the number of target variables.
+
+const Matrix<double>& DataSet::get_testing_target_data(void) const
+{
+   return(get_split_data(Instances::Testing).targets);
+}
+
+
+// bool has_split_data(const Instances::Use&) const method
+
+/// Returns true if the input and target data of the training, selection or testing instances are arranged and kept in memory,
+/// and false otherwise.
+/// In out-of-core mode, the error terms read the instances by batches and do not arrange these matrices.
+/// @param use Use of the instances.
+
+bool DataSet::has_split_data(const Instances::Use& use) const
+{
+   const SplitData& split_data = use == Instances::Training ? training_split_data
+                               : use == Instances::Selection ? selection_split_data
+                               : testing_split_data;
+
+   bool arranged;
+
+   #pragma omp critical(data_set_split_data)
+   {
+      arranged = split_data.arranged;
+   }
+
+   return(arranged);
+}
+
+
 // Vector<double> get_instance(const size_t&) const method
 
 /// Returns the inputs and target values of a single instance in the data set. 
@@ -1089,6 +1237,8 @@ void DataSet::set(void)
    first_cell = "";
    last_cell = "";
 
+   close_out_of_core_data();
+
    data.set();
 
    variables.set();
@@ -1099,6 +1249,8 @@ void DataSet::set(void)
    display = true;
 
    file_type = DAT;
+
+   invalidate_split_data();
 }
 
 
@@ -1121,6 +1273,8 @@ void DataSet::set(const Matrix<double>& new_data)
    display = true;
 
    file_type = DAT;
+
+   invalidate_split_data();
 }
 
 
@@ -1162,6 +1316,8 @@ void DataSet::set(const size_t& new_instances_number, const size_t& new_variable
 
     #endif
 
+   close_out_of_core_data();
+
    data.set(new_instances_number, new_variables_number);
 
    instances.set(new_instances_number);
@@ -1173,6 +1329,8 @@ void DataSet::set(const size_t& new_instances_number, const size_t& new_variable
    display = true;
 
    file_type = DAT;
+
+   invalidate_split_data();
 }
 
 
@@ -1190,6 +1348,8 @@ void DataSet::set(const size_t& new_instances_number, const size_t& new_inputs_n
 
    const size_t new_variables_number = new_inputs_number + new_targets_number;
 
+   close_out_of_core_data();
+
    data.set(new_instances_number, new_variables_number);
 
    variables.set(new_inputs_number, new_targets_number);
@@ -1230,6 +1390,10 @@ void DataSet::set(const DataSet& other_data_set)
    display = other_data_set.display;
 
    file_type = other_data_set.file_type;
+
+   invalidate_split_data();
+
+   copy_out_of_core_data(other_data_set);
 }
 
 
@@ -1558,12 +1722,15 @@ void DataSet::set_data(const Matrix<double>& new_data)
    #endif
 
    // Set data
-   
+
+   close_out_of_core_data();
+
    data = new_data;   
 
    instances.set_instances_number(data.get_rows_number());
    variables.set_variables_number(data.get_columns_number());
 
+   invalidate_split_data();
 }
 
 
@@ -1850,6 +2017,8 @@ void DataSet::set_instances_number(const size_t& new_instances_number)
    data.set(new_instances_number, variables_number);
 
    instances.set(new_instances_number);
+
+   invalidate_split_data();
 }
 
 
@@ -1867,6 +2036,8 @@ void DataSet::set_variables_number(const size_t& new_variables_number)
    data.set(instances_number, new_variables_number);
 
    variables.set(new_variables_number);
+
+   invalidate_split_data();
 }
 
 
@@ -1914,6 +2085,8 @@ void DataSet::set_instance(const size_t& instance_index, const Vector<double>& i
    // Set instance
 
    data.set_row(instance_index, instance);
+
+   invalidate_split_data();
 }
 
 
@@ -1952,6 +2125,8 @@ void DataSet::add_instance(const Vector<double>& instance)
    data.append_row(instance);
 
    instances.set(instances_number+1);
+
+   invalidate_split_data();
 }
 
 
@@ -1987,6 +2162,7 @@ void DataSet::subtract_instance(const size_t& instance_index)
 
    instances.set_instances_number(instances_number-1);
 
+    invalidate_split_data();
 }
 
 
@@ -2028,6 +2204,8 @@ void DataSet::append_variable(const Vector<double>& variable)
    set_variables_number(new_variables_number);
 
    set_data(new_data);
+
+   invalidate_split_data();
 }
 
 
@@ -2066,6 +2244,8 @@ void DataSet::subtract_variable(const size_t& variable_index)
    set_variables_number(new_variables_number);
 
    set_data(new_data);
+
+   invalidate_split_data();
 }
 
 
@@ -2112,19 +2292,197 @@ Vector<size_t> DataSet::unuse_constant_variables(void)
 }
 
 
-// Vector<size_t> unuse_repeated_instances(void) method
+// Vector< Vector<size_t> > calculate_repeated_instances_groups(void) const method
 
-/// Removes the training, selection and testing indices of that instances which are repeated in the data matrix.
-/// It might change the size of the vectors containing the training, selection and testing indices. 
+/// Returns the groups of instances which have the same values in all the used variables.
+/// Each group contains the indices of its instances in increasing order, and the groups are sorted by their first instance.
+/// The instances are hashed in parallel by blocks, and only the instances which share a hash are compared.
+/// Instances with not-a-number values are never repeated.
 
-Vector<size_t> DataSet::unuse_repeated_instances(void)
+Vector< Vector<size_t> > DataSet::calculate_repeated_instances_groups(void) const
 {
     const size_t instances_number = instances.get_instances_number();
 
+    const Vector<size_t> used_variables_indices = variables.arrange_used_indices();
+    const size_t used_variables_number = used_variables_indices.size();
+
+    Vector< Vector<size_t> > repeated_instances_groups;
+
+    if(used_variables_number == 0)
+    {
+        return(repeated_instances_groups);
+    }
+
+    Vector<size_t> instances_indices(instances_number);
+    instances_indices.initialize_sequential();
+
+    // Hash the instances
+
+    const size_t block_size = 65536;
+
+    Vector<uint64_t> hashes(instances_number);
+    Vector<int> comparable(instances_number, 1);
+
+    Matrix<double> block;
+
+    for(size_t first_index = 0; first_index < instances_number; first_index += block_size)
+    {
+        const size_t block_instances_number = std::min(block_size, instances_number - first_index);
+
+        arrange_instances_data(instances_indices, first_index, block_instances_number, used_variables_indices, block);
+
+        int i;
+
+        #pragma omp parallel for
+
+        for(i = 0; i < (int)block_instances_number; i++)
+        {
+            uint64_t hash = 14695981039346656037ULL;
+
+            for(size_t j = 0; j < used_variables_number; j++)
+            {
+                double value = block(i,j);
+
+                if(value != value)
+                {
+                    comparable[first_index + i] = 0;
+                }
+
+                if(value == 0.0)
+                {
+                    value = 0.0;
+                }
+
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+
+                hash = (hash ^ bits)*1099511628211ULL;
+                hash ^= hash >> 32;
+            }
+
+            hashes[first_index + i] = hash;
+        }
+    }
+
+    // Bucket the instances by hash
+
+    std::unordered_map<uint64_t, size_t> buckets_indices;
+    buckets_indices.reserve(instances_number);
+
+    Vector<size_t> instances_buckets(instances_number);
+    Vector<size_t> buckets_sizes;
+
+    for(size_t i = 0; i < instances_number; i++)
+    {
+        if(!comparable[i])
+        {
+            continue;
+        }
+
+        const std::pair<std::unordered_map<uint64_t, size_t>::iterator, bool> insertion
+        = buckets_indices.insert(std::make_pair(hashes[i], buckets_sizes.size()));
+
+        if(insertion.second)
+        {
+            buckets_sizes.push_back(0);
+        }
+
+        instances_buckets[i] = insertion.first->second;
+        buckets_sizes[instances_buckets[i]]++;
+    }
+
+    // Candidates are the instances whose hash is shared
+
+    Vector<size_t> candidates_indices;
+
+    for(size_t i = 0; i < instances_number; i++)
+    {
+        if(comparable[i] && buckets_sizes[instances_buckets[i]] > 1)
+        {
+            candidates_indices.push_back(i);
+        }
+    }
+
+    const size_t candidates_number = candidates_indices.size();
+
+    if(candidates_number == 0)
+    {
+        return(repeated_instances_groups);
+    }
+
+    Matrix<double> candidates_data;
+
+    arrange_instances_data(candidates_indices, 0, candidates_number, used_variables_indices, candidates_data);
+
+    // Split each bucket into groups of equal instances, in order of their first instance
+
+    Vector< Vector<size_t> > groups;
+
+    Vector<size_t> groups_representatives;
+
+    std::unordered_map< size_t, Vector<size_t> > buckets_groups;
+
+    for(size_t k = 0; k < candidates_number; k++)
+    {
+        Vector<size_t>& bucket_groups = buckets_groups[instances_buckets[candidates_indices[k]]];
+
+        bool found = false;
+
+        for(size_t g = 0; g < bucket_groups.size() && !found; g++)
+        {
+            const size_t representative = groups_representatives[bucket_groups[g]];
+
+            found = true;
+
+            for(size_t j = 0; j < used_variables_number; j++)
+            {
+                if(candidates_data(k,j) != candidates_data(representative,j))
+                {
+                    found = false;
+                    break;
+                }
+            }
+
+            if(found)
+            {
+                groups[bucket_groups[g]].push_back(candidates_indices[k]);
+            }
+        }
+
+        if(!found)
+        {
+            bucket_groups.push_back(groups.size());
+            groups_representatives.push_back(k);
+            groups.push_back(Vector<size_t>(1, candidates_indices[k]));
+        }
+    }
+
+    for(size_t g = 0; g < groups.size(); g++)
+    {
+        if(groups[g].size() > 1)
+        {
+            repeated_instances_groups.push_back(groups[g]);
+        }
+    }
+
+    return(repeated_instances_groups);
+}
+
+
+// Vector<size_t> unuse_repeated_instances(void) method
+
+/// Unuses the instances which are repeated in the data matrix, keeping the first instance of each group of repeated instances.
+/// The instances are compared on the used variables.
+/// It returns the indices of the newly unused instances, in increasing order.
+
+Vector<size_t> DataSet::unuse_repeated_instances(void)
+{
     // Control sentence (if debug)
 
     #ifdef __OPENNN_DEBUG__
 
+    const size_t instances_number = instances.get_instances_number();
+
     if(instances_number == 0)
     {
        std::ostringstream buffer;
@@ -2138,31 +2496,25 @@ Vector<size_t> DataSet::unuse_repeated_instances(void)
 
     #endif
 
-    Vector<size_t> repeated_instances;
+    const Vector< Vector<size_t> > repeated_instances_groups = calculate_repeated_instances_groups();
 
-	Vector<double> instance_i;
-	Vector<double> instance_j;    
+    Vector<size_t> repeated_instances;
 
-    int i = 0;
+    for(size_t g = 0; g < repeated_instances_groups.size(); g++)
+    {
+        for(size_t k = 1; k < repeated_instances_groups[g].size(); k++)
+        {
+            const size_t index = repeated_instances_groups[g][k];
 
-    #pragma omp parallel for private(i, instance_i, instance_j) schedule(dynamic)
+            if(instances.get_use(index) != Instances::Unused)
+            {
+                instances.set_use(index, Instances::Unused);
+                repeated_instances.push_back(index);
+            }
+        }
+    }
 
-    for(i = 0; i < (int)instances_number; i++)
-	{
-	   instance_i = get_instance(i);
-
-       for(size_t j = i+1; j < instances_number; j++)
-	   {	      
-          instance_j = get_instance(j);
-
-          if(instances.get_use(j) != Instances::Unused
-          && instance_j == instance_i)
-		  {
-              instances.set_use(j, Instances::Unused);
-              repeated_instances.push_back(j);
-		  }
-	   }	    
-	}
+    std::sort(repeated_instances.begin(), repeated_instances.end());
 
     return(repeated_instances);
 }
@@ -2235,37 +2587,10 @@ Vector<size_t> DataSet::unuse_non_significant_inputs(void)
 
 Vector< Histogram<double> > DataSet::calculate_data_histograms(const size_t& bins_number) const
 {
-   const size_t used_variables_number = variables.count_used_variables_number();
    const Vector<size_t> used_variables_indices = variables.arrange_used_indices();
-   const size_t used_instances_number = instances.count_used_instances_number();
    const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
-   const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-   Vector< Histogram<double> > histograms(used_variables_number);
-
-   Vector<double> column(used_instances_number);
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, column) shared(histograms)
-
-   for(i = 0; i < (int)used_variables_number; i++)
-   {
-       column = data.arrange_column(used_variables_indices[i], used_instances_indices);
-
-       if (column.is_binary())
-       {
-           histograms[i] = column.calculate_histogram_binary();
-       }
-       else
-       {
-           histograms[i] = column.calculate_histogram(bins_number);
-//           histograms[i] = column.calculate_histogram_missing_values(missing_indices[i], bins_number);
-       }
-   }
-
-   return(histograms);
+   return(calculate_variables_histograms(used_instances_indices, used_variables_indices, bins_number, true));
 }
 
 
@@ -2281,27 +2606,10 @@ Vector< Histogram<double> > DataSet::calculate_data_histograms(const size_t& bin
 
 Vector< Histogram<double> > DataSet::calculate_targets_histograms(const size_t& bins_number) const
 {
-   const size_t targets_number = variables.count_targets_number();
-
    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   const size_t used_instances_number = instances.count_used_instances_number();
    const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
-   const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-   Vector< Histogram<double> > histograms(targets_number);
-
-   Vector<double> column(used_instances_number);
-
-   for(size_t i = 0; i < targets_number; i++)
-   {
-       column = data.arrange_column(targets_indices[i], used_instances_indices);
-
-       histograms[i] = column.calculate_histogram_missing_values(missing_indices[i], bins_number);
-   }
-
-   return(histograms);
+   return(calculate_variables_histograms(used_instances_indices, targets_indices, bins_number, false));
 }
 
 
@@ -2320,28 +2628,11 @@ Vector< Histogram<double> > DataSet::calculate_targets_histograms(const size_t&
 
 Vector< Vector<double> > DataSet::calculate_box_plots(void) const
 {
-    const size_t variables_number = variables.count_used_variables_number();
     const Vector<size_t> variables_indices = variables.arrange_used_indices();
 
-    const size_t instances_number = instances.count_used_instances_number();
     const Vector<size_t> instances_indices = instances.arrange_used_indices();
 
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-    Vector< Vector<double> > box_plots;
-    box_plots.set(variables_number);
-
-    Vector<double> column(instances_number);
-
-#pragma omp parallel for private(column)
-    for(int i = 0; i < (int)variables_number; i++)
-    {
-        column = data.arrange_column(variables_indices[i], instances_indices);
-
-        box_plots[i] = column.calculate_box_plots_missing_values(missing_indices[i]);
-    }
-
-    return(box_plots);
+    return(calculate_variables_box_plots(instances_indices, variables_indices));
 }
 
 
@@ -2356,25 +2647,25 @@ size_t DataSet::calculate_training_negatives(const size_t& target_index) const
 
     const size_t training_instances_number = instances.count_training_instances_number();
 
-    Vector<size_t> training_indices = instances.arrange_training_indices();
+    const Vector<size_t> training_indices = instances.arrange_training_indices();
+
+    Matrix<double> target_data;
 
-    size_t training_index;
+    arrange_instances_data(training_indices, 0, training_instances_number, Vector<size_t>(1, target_index), target_data);
 
     for(size_t i = 0; i < training_instances_number; i++)
     {
-        training_index = training_indices[i];
-
-        if(data(training_index, target_index) == 0.0)
+        if(target_data(i,0) == 0.0)
         {
             negatives++;
         }
-        else if(data(training_index, target_index) != 1.0)
+        else if(target_data(i,0) != 1.0)
         {
             std::ostringstream buffer;
 
            buffer << "OpenNN Exception: DataSet class.\n"
                   << "size_t calculate_training_negatives(const size_t&) const method.\n"
-                  << "Training instance is neither a positive nor a negative: " << data(training_index, target_index) << std::endl;
+                  << "Training instance is neither a positive nor a negative: " << target_data(i,0) << std::endl;
 
            throw std::logic_error(buffer.str());
         }
@@ -2395,25 +2686,25 @@ size_t DataSet::calculate_selection_negatives(const size_t& target_index) const
 
     const size_t selection_instances_number = instances.count_selection_instances_number();
 
-    Vector<size_t> selection_indices = instances.arrange_selection_indices();
+    const Vector<size_t> selection_indices = instances.arrange_selection_indices();
+
+    Matrix<double> target_data;
 
-    size_t selection_index;
+    arrange_instances_data(selection_indices, 0, selection_instances_number, Vector<size_t>(1, target_index), target_data);
 
     for(size_t i = 0; i < selection_instances_number; i++)
     {
-        selection_index = selection_indices[i];
-
-        if(data(selection_index, target_index) == 0.0)
+        if(target_data(i,0) == 0.0)
         {
             negatives++;
         }
-        else if(data(selection_index, target_index) != 1.0)
+        else if(target_data(i,0) != 1.0)
         {
             std::ostringstream buffer;
 
            buffer << "OpenNN Exception: DataSet class.\n"
                   << "size_t calculate_selection_negatives(const size_t&) const method.\n"
-                  << "Selection instance is neither a positive nor a negative: " << data(selection_index, target_index) << std::endl;
+                  << "Selection instance is neither a positive nor a negative: " << target_data(i,0) << std::endl;
 
            throw std::logic_error(buffer.str());
         }
@@ -2434,25 +2725,25 @@ size_t DataSet::calculate_testing_negatives(const size_t& target_index) const
 
     const size_t testing_instances_number = instances.count_testing_instances_number();
 
-    Vector<size_t> testing_indices = instances.arrange_testing_indices();
+    const Vector<size_t> testing_indices = instances.arrange_testing_indices();
+
+    Matrix<double> target_data;
 
-    size_t testing_index;
+    arrange_instances_data(testing_indices, 0, testing_instances_number, Vector<size_t>(1, target_index), target_data);
 
     for(size_t i = 0; i < testing_instances_number; i++)
     {
-        testing_index = testing_indices[i];
-
-        if(data(testing_index, target_index) == 0.0)
+        if(target_data(i,0) == 0.0)
         {
             negatives++;
         }
-        else if(data(testing_index, target_index) != 1.0)
+        else if(target_data(i,0) != 1.0)
         {
             std::ostringstream buffer;
 
            buffer << "OpenNN Exception: DataSet class.\n"
                   << "size_t calculate_selection_negatives(const size_t&) const method.\n"
-                  << "Testing instance is neither a positive nor a negative: " << data(testing_index, target_index) << std::endl;
+                  << "Testing instance is neither a positive nor a negative: " << target_data(i,0) << std::endl;
 
            throw std::logic_error(buffer.str());
         }
@@ -2475,9 +2766,13 @@ size_t DataSet::calculate_testing_negatives(const size_t& target_index) const
 
 Vector< Statistics<double> > DataSet::calculate_data_statistics(void) const
 {
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+    Vector<size_t> instances_indices(instances.get_instances_number());
+    instances_indices.initialize_sequential();
 
-    return(data.calculate_statistics_missing_values(missing_indices));
+    Vector<size_t> variables_indices(variables.get_variables_number());
+    variables_indices.initialize_sequential();
+
+    return(calculate_variables_statistics(instances_indices, variables_indices));
 }
 
 
@@ -2492,9 +2787,13 @@ Vector< Statistics<double> > DataSet::calculate_data_statistics(void) const
 
 Vector< Vector<double> > DataSet::calculate_data_shape_parameters(void) const
 {
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+    Vector<size_t> instances_indices(instances.get_instances_number());
+    instances_indices.initialize_sequential();
 
-    return(data.calculate_shape_parameters_missing_values(missing_indices));
+    Vector<size_t> variables_indices(variables.get_variables_number());
+    variables_indices.initialize_sequential();
+
+    return(calculate_variables_shape_parameters(instances_indices, variables_indices));
 }
 
 
@@ -2506,24 +2805,18 @@ Vector< Vector<double> > DataSet::calculate_data_shape_parameters(void) const
 
 Matrix<double> DataSet::calculate_data_statistics_matrix(void) const
 {
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
     const Vector<size_t> used_variables_indices = variables.arrange_used_indices();
     const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
     const size_t variables_number = used_variables_indices.size();//variables.count_used_variables_number();
 
+    const Vector< Statistics<double> > data_statistics = calculate_variables_statistics(used_instances_indices, used_variables_indices);
+
     Matrix<double> data_statistics_matrix(variables_number, 4);
 
     for(size_t i = 0; i < variables_number; i++)
     {
-        const size_t variable_index = used_variables_indices[i];
-
-        const Vector<double> variable_data = data.arrange_column(variable_index, used_instances_indices);
-
-        const Statistics<double> data_statistics = variable_data.calculate_statistics_missing_values(missing_indices[variable_index]);
-
-        data_statistics_matrix.set_row(i, data_statistics.to_vector());
+        data_statistics_matrix.set_row(i, data_statistics[i].to_vector());
     }
 
     return(data_statistics_matrix);
@@ -2573,23 +2866,17 @@ Matrix<double> DataSet::calculate_positives_data_statistics_matrix(void) const
 
     const Vector<size_t> inputs_variables_indices = variables.arrange_inputs_indices();
 
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
     const size_t inputs_number = inputs_variables_indices.size();
 
     const Vector<size_t> positives_used_instances_indices = used_instances_indices.arrange_subvector(targets.calculate_equal_than_indices(1.0));
 
+    const Vector< Statistics<double> > data_statistics = calculate_variables_statistics(positives_used_instances_indices, inputs_variables_indices);
+
     Matrix<double> data_statistics_matrix(inputs_number, 4);
 
     for(size_t i = 0; i < inputs_number; i++)
     {
-        const size_t variable_index = inputs_variables_indices[i];
-
-        const Vector<double> variable_data = data.arrange_column(variable_index, positives_used_instances_indices);
-
-        const Statistics<double> data_statistics = variable_data.calculate_statistics_missing_values(missing_indices[variable_index]);
-
-        data_statistics_matrix.set_row(i, data_statistics.to_vector());
+        data_statistics_matrix.set_row(i, data_statistics[i].to_vector());
     }
     return data_statistics_matrix;
 }
@@ -2620,8 +2907,6 @@ Matrix<double> DataSet::calculate_negatives_data_statistics_matrix(void) const
 
     const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
     const Vector<double> targets = data.arrange_column(target_index, used_instances_indices);
 
 #ifdef __OPENNN_DEBUG__
@@ -2644,17 +2929,13 @@ Matrix<double> DataSet::calculate_negatives_data_statistics_matrix(void) const
 
     const Vector<size_t> negatives_used_instances_indices = used_instances_indices.arrange_subvector(targets.calculate_equal_than_indices(0.0));
 
+    const Vector< Statistics<double> > data_statistics = calculate_variables_statistics(negatives_used_instances_indices, inputs_variables_indices);
+
     Matrix<double> data_statistics_matrix(inputs_number, 4);
 
     for(size_t i = 0; i < inputs_number; i++)
     {
-        const size_t variable_index = inputs_variables_indices[i];
-
-        const Vector<double> variable_data = data.arrange_column(variable_index, negatives_used_instances_indices);
-
-        const Statistics<double> data_statistics = variable_data.calculate_statistics_missing_values(missing_indices[variable_index]);
-
-        data_statistics_matrix.set_row(i, data_statistics.to_vector());
+        data_statistics_matrix.set_row(i, data_statistics[i].to_vector());
     }
     return data_statistics_matrix;
 }
@@ -2667,26 +2948,18 @@ Matrix<double> DataSet::calculate_negatives_data_statistics_matrix(void) const
 
 Matrix<double> DataSet::calculate_data_shape_parameters_matrix(void) const
 {
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
     const Vector<size_t> used_variables_indices = variables.arrange_used_indices();
     const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
-    const Vector< Vector<size_t> > used_missing_indices = missing_indices.arrange_subvector(used_variables_indices);
-
     const size_t variables_number = variables.count_used_variables_number();
 
+    const Vector< Vector<double> > shape_parameters = calculate_variables_shape_parameters(used_instances_indices, used_variables_indices);
+
     Matrix<double> data_shape_parameters_matrix(variables_number, 2);
 
     for(size_t i = 0; i < variables_number; i++)
     {
-        const size_t variable_index = used_variables_indices[i];
-
-        const Vector<double> variable_data = data.arrange_column(variable_index, used_instances_indices);
-
-        const Vector<double> shape_parameters = variable_data.calculate_shape_parameters_missing_values(used_missing_indices[variable_index]);
-
-        data_shape_parameters_matrix.set_row(i, shape_parameters);
+        data_shape_parameters_matrix.set_row(i, shape_parameters[i]);
     }
 
     return(data_shape_parameters_matrix);
@@ -2708,9 +2981,10 @@ Vector< Statistics<double> > DataSet::calculate_training_instances_statistics(vo
 {
    const Vector<size_t> training_indices = instances.arrange_training_indices();
 
-   const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+   Vector<size_t> variables_indices(variables.get_variables_number());
+   variables_indices.initialize_sequential();
 
-   return(data.calculate_rows_statistics_missing_values(training_indices, missing_indices));
+   return(calculate_variables_statistics(training_indices, variables_indices));
 }
 
 
@@ -2727,11 +3001,12 @@ Vector< Statistics<double> > DataSet::calculate_training_instances_statistics(vo
 
 Vector< Statistics<double> > DataSet::calculate_selection_instances_statistics(void) const
 {
-    const Vector<size_t> selection_indices = instances.arrange_selection_indices();
+   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
 
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+   Vector<size_t> variables_indices(variables.get_variables_number());
+   variables_indices.initialize_sequential();
 
-   return(data.calculate_rows_statistics_missing_values(selection_indices, missing_indices));
+   return(calculate_variables_statistics(selection_indices, variables_indices));
 }
 
 
@@ -2748,11 +3023,12 @@ Vector< Statistics<double> > DataSet::calculate_selection_instances_statistics(v
 
 Vector< Statistics<double> > DataSet::calculate_testing_instances_statistics(void) const
 {
-    const Vector<size_t> testing_indices = instances.arrange_testing_indices();
+   const Vector<size_t> testing_indices = instances.arrange_testing_indices();
 
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+   Vector<size_t> variables_indices(variables.get_variables_number());
+   variables_indices.initialize_sequential();
 
-   return(data.calculate_rows_statistics_missing_values(testing_indices, missing_indices));
+   return(calculate_variables_statistics(testing_indices, variables_indices));
 }
 
 
@@ -2769,9 +3045,10 @@ Vector< Vector<double> > DataSet::calculate_training_instances_shape_parameters(
 {
    const Vector<size_t> training_indices = instances.arrange_training_indices();
 
-   const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+   Vector<size_t> variables_indices(variables.get_variables_number());
+   variables_indices.initialize_sequential();
 
-   return(data.calculate_rows_shape_parameters_missing_values(training_indices, missing_indices));
+   return(calculate_variables_shape_parameters(training_indices, variables_indices));
 }
 
 
@@ -2786,11 +3063,12 @@ Vector< Vector<double> > DataSet::calculate_training_instances_shape_parameters(
 
 Vector< Vector<double> > DataSet::calculate_selection_instances_shape_parameters(void) const
 {
-    const Vector<size_t> selection_indices = instances.arrange_selection_indices();
+   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
 
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+   Vector<size_t> variables_indices(variables.get_variables_number());
+   variables_indices.initialize_sequential();
 
-   return(data.calculate_rows_shape_parameters_missing_values(selection_indices, missing_indices));
+   return(calculate_variables_shape_parameters(selection_indices, variables_indices));
 }
 
 
@@ -2805,11 +3083,12 @@ Vector< Vector<double> > DataSet::calculate_selection_instances_shape_parameters
 
 Vector< Vector<double> > DataSet::calculate_testing_instances_shape_parameters(void) const
 {
-    const Vector<size_t> testing_indices = instances.arrange_testing_indices();
+   const Vector<size_t> testing_indices = instances.arrange_testing_indices();
 
-    const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+   Vector<size_t> variables_indices(variables.get_variables_number());
+   variables_indices.initialize_sequential();
 
-   return(data.calculate_rows_shape_parameters_missing_values(testing_indices, missing_indices));
+   return(calculate_variables_shape_parameters(testing_indices, variables_indices));
 }
 
 
@@ -2829,19 +3108,9 @@ Vector< Statistics<double> > DataSet::calculate_inputs_statistics(void) const
 {
     const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
 
-    Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-    const Vector<size_t> unused_instances_indices = instances.arrange_unused_indices();
-
-    for (size_t i = 0; i < unused_instances_indices.size(); i++)
-    {
-        for (size_t j = 0; j < missing_indices.size(); j++)
-        {
-            missing_indices[j].push_back(unused_instances_indices[i]);
-        }
-    }
+    const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
-   return(data.calculate_columns_statistics_missing_values(inputs_indices, missing_indices));
+    return(calculate_variables_statistics(used_instances_indices, inputs_indices));
 }
 
 
@@ -2860,19 +3129,9 @@ Vector< Statistics<double> > DataSet::calculate_targets_statistics(void) const
 {
    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-   Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-   const Vector<size_t> unused_instances_indices = instances.arrange_unused_indices();
-
-   for (size_t i = 0; i < unused_instances_indices.size(); i++)
-   {
-       for (size_t j = 0; j < missing_indices.size(); j++)
-       {
-           missing_indices[j].push_back(unused_instances_indices[i]);
-       }
-   }
+   const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
-   return(data.calculate_columns_statistics_missing_values(targets_indices, missing_indices));
+   return(calculate_variables_statistics(used_instances_indices, targets_indices));
 }
 
 
@@ -2886,9 +3145,7 @@ Vector<double> DataSet::calculate_training_target_data_mean(void) const
 
    const Vector<size_t> training_indices = instances.arrange_training_indices();
 
-   const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-   return(data.calculate_mean_missing_values(training_indices, targets_indices, missing_indices));
+   return(calculate_variables_means(training_indices, targets_indices));
 }
 
 
@@ -2902,9 +3159,7 @@ Vector<double> DataSet::calculate_selection_target_data_mean(void) const
 
    const Vector<size_t> selection_indices = instances.arrange_selection_indices();
 
-   const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-   return(data.calculate_mean_missing_values(selection_indices, targets_indices, missing_indices));
+   return(calculate_variables_means(selection_indices, targets_indices));
 }
 
 
@@ -2918,9 +3173,7 @@ Vector<double> DataSet::calculate_testing_target_data_mean(void) const
 
    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-   const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
-
-   return(data.calculate_mean_missing_values(testing_indices, targets_indices, missing_indices));
+   return(calculate_variables_means(testing_indices, targets_indices));
 }
 
 
@@ -2932,42 +3185,13 @@ Vector<double> DataSet::calculate_testing_target_data_mean(void) const
 
 Matrix<double> DataSet::calculate_linear_correlations(void) const
 {
-   const size_t inputs_number = variables.count_inputs_number();
-   const size_t targets_number = variables.count_targets_number();
-
    const Vector<size_t> input_indices = variables.arrange_inputs_indices();
    const Vector<size_t> target_indices = variables.arrange_targets_indices();
 
-   size_t input_index;
-   size_t target_index;
-
-   const size_t instances_number = instances.get_instances_number();
-
-   Vector<double> input_variable(instances_number);
-   Vector<double> target_variable(instances_number);
-
-   Matrix<double> linear_correlations(inputs_number, targets_number);
-
-#ifndef __OPENNN_MPI__
-#pragma omp parallel for private(input_index, input_variable, target_index, target_variable)
-#endif
-   for(int i = 0; i < (int)inputs_number; i++)
-   {
-       for(int j = 0; j < (int)targets_number; j++)
-       {
-           input_index = input_indices[i];
-
-           input_variable = data.arrange_column(input_index);
-
-           target_index = target_indices[j];
-
-           target_variable = data.arrange_column(target_index);
+   Vector<size_t> instances_indices(instances.get_instances_number());
+   instances_indices.initialize_sequential();
 
-           linear_correlations(i,j) = input_variable.calculate_linear_correlation(target_variable);
-       }
-   }
-
-   return(linear_correlations);
+   return(calculate_variables_cross_moments(instances_indices, input_indices, target_indices).calculate_linear_correlation_matrix());
 }
 
 
@@ -2982,30 +3206,7 @@ Matrix<double> DataSet::calculate_covariance_matrix(void) const
     const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
     const Vector<size_t> used_instances_indices = instances.arrange_used_indices();
 
-    const size_t inputs_number = variables.count_inputs_number();
-
-    Matrix<double> covariance_matrix(inputs_number, inputs_number, 0.0);
-
-#pragma omp parallel for
-
-    for(int i = 0; i < (int)inputs_number; i++)
-    {
-        const size_t first_input_index = inputs_indices[i];
-
-        const Vector<double> first_input_data = data.arrange_column(first_input_index, used_instances_indices);
-
-        for(size_t j = 0; j < inputs_number; j++)
-        {
-            const size_t second_input_index = inputs_indices[j];
-
-            const Vector<double> second_input_data = data.arrange_column(second_input_index, used_instances_indices);
-
-            covariance_matrix(i,j) = first_input_data.calculate_covariance(second_input_data);
-            covariance_matrix(j,i) = covariance_matrix(i,j);
-        }
-    }
-
-    return (covariance_matrix);
+    return(calculate_variables_cross_moments(used_instances_indices, inputs_indices, inputs_indices).calculate_covariance_matrix());
 }
 
 
@@ -3207,6 +3408,8 @@ void DataSet::transform_principal_components_data(const Matrix<double>& principa
     }
 
     data = new_data.assemble_columns(target_data);
+
+    invalidate_split_data();
 }
 
 
@@ -3225,7 +3428,7 @@ void DataSet::scale_data_mean_standard_deviation(const Vector< Statistics<double
 
    std::ostringstream buffer;
 
-   const size_t columns_number = data.get_columns_number();
+   const size_t columns_number = variables.get_variables_number();
 
    const size_t statistics_size = data_statistics.size();
 
@@ -3253,7 +3456,9 @@ void DataSet::scale_data_mean_standard_deviation(const Vector< Statistics<double
         }
     }
 
-   data.scale_mean_standard_deviation(data_statistics);
+   get_scaled_data().scale_mean_standard_deviation(data_statistics);
+
+   invalidate_split_data();
 }
 
 
@@ -3318,6 +3523,8 @@ void DataSet::subtract_input_data_mean(void)
             data(instance_index,input_index) = data(instance_index,input_index) - input_mean;
         }
     }
+
+    invalidate_split_data();
 }
 
 
@@ -3363,7 +3570,9 @@ void DataSet::scale_data_minimum_maximum(const Vector< Statistics<double> >& dat
     }
 
 
-   data.scale_minimum_maximum(data_statistics);
+   get_scaled_data().scale_minimum_maximum(data_statistics);
+
+    invalidate_split_data();
 }
 
 /*
@@ -3458,7 +3667,9 @@ void DataSet::scale_inputs_mean_standard_deviation(const Vector< Statistics<doub
 {
     const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
 
-    data.scale_columns_mean_standard_deviation(inputs_statistics, inputs_indices);
+    get_scaled_data().scale_columns_mean_standard_deviation(inputs_statistics, inputs_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3474,7 +3685,7 @@ Vector< Statistics<double> > DataSet::scale_inputs_mean_standard_deviation(void)
 
     #ifdef __OPENNN_DEBUG__
 
-    if(data.empty())
+    if(!has_data())
     {
        std::ostringstream buffer;
 
@@ -3506,7 +3717,9 @@ void DataSet::scale_inputs_minimum_maximum(const Vector< Statistics<double> >& i
 {
     const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
 
-    data.scale_columns_minimum_maximum(inputs_statistics, inputs_indices);
+    get_scaled_data().scale_columns_minimum_maximum(inputs_statistics, inputs_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3522,7 +3735,7 @@ Vector< Statistics<double> > DataSet::scale_inputs_minimum_maximum(void)
 
     #ifdef __OPENNN_DEBUG__
 
-    if(data.empty())
+    if(!has_data())
     {
        std::ostringstream buffer;
 
@@ -3641,7 +3854,9 @@ void DataSet::scale_targets_mean_standard_deviation(const Vector< Statistics<dou
 {
     const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-    data.scale_columns_mean_standard_deviation(targets_statistics, targets_indices);
+    get_scaled_data().scale_columns_mean_standard_deviation(targets_statistics, targets_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3657,7 +3872,7 @@ Vector< Statistics<double> > DataSet::scale_targets_mean_standard_deviation(void
 
     #ifdef __OPENNN_DEBUG__
 
-    if(data.empty())
+    if(!has_data())
     {
        std::ostringstream buffer;
 
@@ -3691,7 +3906,7 @@ void DataSet::scale_targets_minimum_maximum(const Vector< Statistics<double> >&
 
     #ifdef __OPENNN_DEBUG__
 
-    if(data.empty())
+    if(!has_data())
     {
        std::ostringstream buffer;
 
@@ -3706,7 +3921,9 @@ void DataSet::scale_targets_minimum_maximum(const Vector< Statistics<double> >&
 
     const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-    data.scale_columns_minimum_maximum(targets_statistics, targets_indices);
+    get_scaled_data().scale_columns_minimum_maximum(targets_statistics, targets_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3820,7 +4037,9 @@ void DataSet::scale_targets(const std::string& scaling_unscaling_method, const V
 
 void DataSet::unscale_data_mean_standard_deviation(const Vector< Statistics<double> >& data_statistics)
 {
-   data.unscale_mean_standard_deviation(data_statistics);
+   get_scaled_data().unscale_mean_standard_deviation(data_statistics);
+
+   invalidate_split_data();
 }
 
 
@@ -3833,7 +4052,9 @@ void DataSet::unscale_data_mean_standard_deviation(const Vector< Statistics<doub
 
 void DataSet::unscale_data_minimum_maximum(const Vector< Statistics<double> >& data_statistics)
 {
-   data.unscale_minimum_maximum(data_statistics);
+   get_scaled_data().unscale_minimum_maximum(data_statistics);
+
+   invalidate_split_data();
 }
 
 
@@ -3848,7 +4069,9 @@ void DataSet::unscale_inputs_mean_standard_deviation(const Vector< Statistics<do
 {
     const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
 
-    data.unscale_columns_mean_standard_deviation(data_statistics, inputs_indices);
+    get_scaled_data().unscale_columns_mean_standard_deviation(data_statistics, inputs_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3863,7 +4086,9 @@ void DataSet::unscale_inputs_minimum_maximum(const Vector< Statistics<double> >&
 {
     const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
 
-    data.unscale_columns_minimum_maximum(data_statistics, inputs_indices);
+    get_scaled_data().unscale_columns_minimum_maximum(data_statistics, inputs_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3878,7 +4103,9 @@ void DataSet::unscale_targets_mean_standard_deviation(const Vector< Statistics<d
 {
     const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-    data.unscale_columns_mean_standard_deviation(data_statistics, targets_indices);
+    get_scaled_data().unscale_columns_mean_standard_deviation(data_statistics, targets_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3893,7 +4120,9 @@ void DataSet::unscale_targets_minimum_maximum(const Vector< Statistics<double> >
 {
     const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-    data.unscale_columns_minimum_maximum(data_statistics, targets_indices);
+    get_scaled_data().unscale_columns_minimum_maximum(data_statistics, targets_indices);
+
+    invalidate_split_data();
 }
 
 
@@ -3905,6 +4134,8 @@ void DataSet::unscale_targets_minimum_maximum(const Vector< Statistics<double> >
 void DataSet::initialize_data(const double& new_value)
 {
    data.initialize(new_value);
+
+   invalidate_split_data();
 }
 
 
@@ -3916,6 +4147,8 @@ void DataSet::initialize_data(const double& new_value)
 void DataSet::randomize_data_uniform(const double& minimum, const double& maximum)
 {
    data.randomize_uniform(minimum, maximum);
+
+   invalidate_split_data();
 }
 
 
@@ -3927,6 +4160,8 @@ void DataSet::randomize_data_uniform(const double& minimum, const double& maximu
 void DataSet::randomize_data_normal(const double& mean, const double& standard_deviation)
 {
    data.randomize_normal(mean, standard_deviation);
+
+   invalidate_split_data();
 }
 
 
@@ -4839,6 +5074,101 @@ void DataSet::save_data(void) const
 }
 
 
+// void save_data_binary(void) const method
+
+/// Saves to the data file a binary copy of the data set which can be loaded with load_data_binary().
+/// The file contains a versioned header, the variables and instances information,
+/// the data matrix in column-major order aligned to 64 bytes, and a bitmap of the missing values.
+
+void DataSet::save_data_binary(void) const
+{
+   std::ofstream file(data_file_name.c_str(), std::ios::binary);
+
+   if(!file.is_open())
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: DataSet class.\n"
+             << "void save_data_binary(void) const method.\n"
+             << "Cannot open data file.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   const size_t instances_number = data.get_rows_number();
+   const size_t variables_number = data.get_columns_number();
+
+   // Variables and instances
+
+   tinyxml2::XMLPrinter variables_printer;
+   variables.write_XML(variables_printer);
+
+   tinyxml2::XMLPrinter instances_printer;
+   instances.write_XML(instances_printer);
+
+   // Missing values
+
+   Vector<uint64_t> missing_values_bitmap((instances_number*variables_number + 63)/64, 0);
+
+   const size_t missing_values_number = missing_values.get_missing_values_number();
+
+   for(size_t i = 0; i < missing_values_number; i++)
+   {
+      const MissingValues::Item& item = missing_values.get_item(i);
+
+      const size_t index = item.instance_index + item.variable_index*instances_number;
+
+      missing_values_bitmap[index/64] |= (uint64_t)1 << (index%64);
+   }
+
+   // Header
+
+   BinaryDataFileHeader header;
+
+   memcpy(header.magic, "OPENNNDS", 8);
+
+   header.version = 1;
+   header.byte_order = 0x0102030405060708ULL;
+
+   header.instances_number = instances_number;
+   header.variables_number = variables_number;
+
+   header.variables_offset = sizeof(BinaryDataFileHeader);
+   header.variables_size = variables_printer.CStrSize() - 1;
+
+   header.instances_offset = header.variables_offset + header.variables_size;
+   header.instances_size = instances_printer.CStrSize() - 1;
+
+   header.data_offset = (header.instances_offset + header.instances_size + 63)/64*64;
+
+   header.missing_values_offset = header.data_offset + instances_number*variables_number*sizeof(double);
+   header.missing_values_size = missing_values_bitmap.size()*sizeof(uint64_t);
+
+   // Write file
+
+   file.write(reinterpret_cast<const char*>(&header), sizeof(BinaryDataFileHeader));
+
+   file.write(variables_printer.CStr(), header.variables_size);
+   file.write(instances_printer.CStr(), header.instances_size);
+
+   const std::string padding(header.data_offset - header.instances_offset - header.instances_size, '\0');
+
+   file.write(padding.data(), padding.size());
+
+   if(!data.empty())
+   {
+      file.write(reinterpret_cast<const char*>(data.data()), instances_number*variables_number*sizeof(double));
+   }
+
+   if(!missing_values_bitmap.empty())
+   {
+      file.write(reinterpret_cast<const char*>(missing_values_bitmap.data()), header.missing_values_size);
+   }
+
+   file.close();
+}
+
+
 // size_t get_column_index(const Vector< Vector<std::string> >&, const size_t) const method
 
 /// Returns the index of a variable when reading the data file.
@@ -5058,263 +5388,516 @@ Vector<std::string> DataSet::read_header_line(void) const
 }
 
 
-// void read_instance(const std::string&, const Vector< Vector<std::string> >&, const size_t&) method
+// void split_data_file_line(const char*, const char*, const char&, Vector< std::pair<const char*, const char*> >&) const method
 
-/// Sets the values of a single instance in the data matrix from a line in the data file.
-/// @param line Data file line.
-/// @param nominal_labels Values of all nominal variables in the data file.
-/// @param instance_index Index of instance.
+/// Splits a line of the data file into tokens, without copying it.
+/// Consecutive separators are merged, and the tokens are trimmed of blank characters.
+/// Tabs are taken as blank characters unless they are the separator.
+/// @param begin Pointer to the first character of the line.
+/// @param end Pointer past the last character of the line.
+/// @param separator_character Character which separates the tokens.
+/// @param tokens Begin and end pointers of the tokens in the line. It is empty if the line is blank.
 
-void DataSet::read_instance(const std::string& line, const Vector< Vector<std::string> >& nominal_labels, const size_t& instance_index)
+void DataSet::split_data_file_line(const char* begin, const char* end, const char& separator_character,
+                                   Vector< std::pair<const char*, const char*> >& tokens) const
 {
-    // Control sentence (if debug)
-
-    #ifdef __OPENNN_DEBUG__
+    tokens.clear();
 
-    const size_t instances_number = instances.get_instances_number();
+    const char* position = begin;
 
-    if(instance_index >= instances_number)
+    while(position < end)
     {
-       std::ostringstream buffer;
-
-       buffer << "OpenNN Exception: DataSet class.\n"
-              << "void read_instance(const std::string&, const Vector< Vector<std::string> >&, const size_t&) method.\n"
-              << "Index of instance (" << instance_index << ") must be less than number of instances (" << instances_number << ").\n";
+        while(position < end
+        && (*position == separator_character || (separator_character == ' ' && *position == '\t')))
+        {
+            position++;
+        }
 
-       throw std::logic_error(buffer.str());
-    }
+        if(position == end)
+        {
+            break;
+        }
 
-    #endif
+        const char* token_begin = position;
 
-    const Vector<std::string> tokens = get_tokens(line);
+        while(position < end
+        && *position != separator_character && !(separator_character == ' ' && *position == '\t'))
+        {
+            position++;
+        }
 
-    #ifdef __OPENNN_DEBUG__
+        const char* token_end = position;
 
-    if(tokens.size() != nominal_labels.size())
-    {
-       std::ostringstream buffer;
+        while(token_begin < token_end && (*token_begin == ' ' || *token_begin == '\t'))
+        {
+            token_begin++;
+        }
 
-       buffer << "OpenNN Exception: DataSet class.\n"
-              << "void read_instance(const std::string&, const Vector< Vector<std::string> >&, const size_t&) method.\n"
-              << "Size of tokens (" << tokens.size() << ") must be equal to size of names (" << nominal_labels.size() << ").\n";
+        while(token_end > token_begin && (*(token_end-1) == ' ' || *(token_end-1) == '\t'))
+        {
+            token_end--;
+        }
 
-       throw std::logic_error(buffer.str());
+        tokens.push_back(std::make_pair(token_begin, token_end));
     }
+}
 
-    #endif
-
-    size_t column_index;
-
-    for(size_t j = 0; j < tokens.size(); j++)
-    {
-        column_index = get_column_index(nominal_labels, j);
 
-        if(nominal_labels[j].size() == 0) // Numeric variable
-        {
-            if(tokens[j] != missing_values_label) // No missing values
-            {
-                data(instance_index, column_index) = atof(tokens[j].c_str());
-            }
-            else // Missing values
-            {
-                data(instance_index, column_index) = -99.9;
+// bool parse_data_file_number(const char*, const char*, std::string&, double&) const method
 
-                missing_values.append(instance_index, column_index);
-            }
-        }
+/// Converts a token of the data file to a number.
+/// Returns true if the whole token is a number, and false otherwise.
+/// @param begin Pointer to the first character of the token.
+/// @param end Pointer past the last character of the token.
+/// @param token Buffer where the token is copied, so that it can be reused between calls.
+/// @param value Value of the number.
 
-        else if(nominal_labels[j].size() == 2) // Binary variable
-        {
-            if(tokens[j] != missing_values_label) // No missing values
-            {
-                if(tokens[j] == "false" || tokens[j] == "False"||  tokens[j] == "FALSE" || tokens[j] == "F"
-                || tokens[j] == "negative"|| tokens[j] == "Negative"|| tokens[j] == "NEGATIVE")
-                {
-                    data(instance_index, column_index) = 0.0;
-                }
-                else if(tokens[j] == "true" || tokens[j] == "True"||  tokens[j] == "TRUE" || tokens[j] == "T"
-                || tokens[j] == "positive"|| tokens[j] == "Positive"|| tokens[j] == "POSITIVE")
-                {
-                    data(instance_index, column_index) = 1.0;
-                }
-                else if(tokens[j] == nominal_labels[j][0])
-                {
-                    data(instance_index, column_index) = 0.0;
-                }
-                else if(tokens[j] == nominal_labels[j][1])
-                {
-                    data(instance_index, column_index) = 1.0;
-                }
-                else
-                {
-                    std::ostringstream buffer;
+bool DataSet::parse_data_file_number(const char* begin, const char* end, std::string& token, double& value) const
+{
+    if(begin == end)
+    {
+        return(false);
+    }
 
-                    buffer << "OpenNN Exception: DataSet class.\n"
-                           << "void read_instance(const std::string&, const Vector< Vector<std::string> >&, const size_t&) method.\n"
-                           << "Unknown token binary value.\n";
+    if(!isdigit(*begin) && *begin != '-' && *begin != '+' && *begin != '.')
+    {
+        return(false);
+    }
 
-                    throw std::logic_error(buffer.str());
-                }
-            }
-            else // Missing values
-            {
-                data(instance_index, column_index) = -99.9;
+    token.assign(begin, end);
 
-                missing_values.append(instance_index, column_index);
-            }
-        }
+    char* number_end;
 
-        else // Nominal variable
-        {
-            if(tokens[j] != missing_values_label)
-            {
-                for(size_t k = 0; k < nominal_labels[j].size(); k++)
-                {
-                    if(tokens[j] == nominal_labels[j][k])
-                    {
-                        data(instance_index, column_index+k) = 1.0;
-                    }
-                    else
-                    {
-                        data(instance_index, column_index+k) = 0.0;
-                    }
-                }
-            }
-            else // Missing values
-            {
-                for(size_t k = 0; k < nominal_labels[j].size(); k++)
-                {
-                    data(instance_index, column_index+k) = -99.9;
+    value = strtod(token.c_str(), &number_end);
 
-                    missing_values.append(instance_index, column_index+k);
-                }
-            }
-        }
-    }       
+    return(number_end == token.c_str() + token.size());
 }
 
 
-// Vector< Vector<std::string> > set_from_data_file(void) method
+// Vector<DataFileChunk> split_data_file(const DataFileMapping&) const method
 
-/// Performs a first data file read in which the format is checked,
-/// and the numbers of variables, instances and missing values are set.
+/// Splits the data file into chunks of whole lines, which can be parsed independently.
+/// The header line, if any, is not included in the chunks.
+/// @param data_file Contents of the data file.
 
-Vector< Vector<std::string> > DataSet::set_from_data_file(void)
+Vector<DataSet::DataFileChunk> DataSet::split_data_file(const DataFileMapping& data_file) const
 {
-    const size_t columns_number = count_data_file_columns_number();
-
-    Vector< Vector<std::string> > nominal_labels(columns_number);
+    const size_t chunk_size = 4194304;
 
-    std::string line;
-    Vector<std::string> tokens;
+    const char separator_character = get_separator_string()[0];
 
-//    bool numeric;
+    Vector<DataFileChunk> chunks;
 
-    check_header_line();
+    const char* position = data_file.begin;
 
-    int instances_count;
+    // Header line
 
     if(header_line)
     {
-        instances_count = -1;
-    }
-    else
+        Vector< std::pair<const char*, const char*> > tokens;
+
+        while(position < data_file.end)
+        {
+            const char* line_end = (const char*)memchr(position, '\n', data_file.end - position);
+
+            if(!line_end)
+            {
+                line_end = data_file.end;
+            }
+
+            split_data_file_line(position, line_end, separator_character, tokens);
+
+            position = line_end < data_file.end ? line_end + 1 : data_file.end;
+
+            if(!tokens.empty())
+            {
+                break;
+            }
+        }
+    }
+
+    // Chunks
+
+    while(position < data_file.end)
     {
-        instances_count = 0;
+        DataFileChunk chunk;
+
+        chunk.begin = position;
+
+        if((size_t)(data_file.end - position) <= chunk_size)
+        {
+            chunk.end = data_file.end;
+        }
+        else
+        {
+            const char* line_end = (const char*)memchr(position + chunk_size, '\n', data_file.end - position - chunk_size);
+
+            chunk.end = line_end ? line_end + 1 : data_file.end;
+        }
+
+        chunks.push_back(chunk);
+
+        position = chunk.end;
     }
 
-    std::ifstream file(data_file_name.c_str());   
+    return(chunks);
+}
 
-    // Rest of lines
 
-    while(file.good())
+// void scan_data_file_chunk(DataFileChunk&, const size_t&) const method
+
+/// Performs the first read of a chunk of the data file.
+/// It counts the instances in the chunk, and gathers the nominal labels of each column.
+/// @param chunk Chunk of the data file.
+/// @param columns_number Number of columns in the data file.
+
+void DataSet::scan_data_file_chunk(DataFileChunk& chunk, const size_t& columns_number) const
+{
+    const char separator_character = get_separator_string()[0];
+
+    Vector< std::pair<const char*, const char*> > tokens;
+
+    std::string token;
+    double value;
+
+    chunk.instances_number = 0;
+    chunk.nominal_labels.set(columns_number);
+
+    const char* line_begin = chunk.begin;
+
+    while(line_begin < chunk.end)
     {
-        getline(file, line);
+        const char* line_end = (const char*)memchr(line_begin, '\n', chunk.end - line_begin);
 
-        if(separator != Tab)
+        if(!line_end)
         {
-            std::replace(line.begin(), line.end(), '\t', ' ');
+            line_end = chunk.end;
         }
 
-        trim(line);
+        const char* next_line_begin = line_end < chunk.end ? line_end + 1 : chunk.end;
 
-        if(line.empty())
+        if(line_end > line_begin && *(line_end-1) == '\r')
+        {
+            line_end--;
+        }
+
+        split_data_file_line(line_begin, line_end, separator_character, tokens);
+
+        line_begin = next_line_begin;
+
+        if(tokens.empty())
         {
             continue;
         }
 
-        if(header_line && instances_count == -1)
+        chunk.instances_number++;
+
+        const size_t tokens_number = std::min(tokens.size(), columns_number);
+
+        for(size_t j = 0; j < tokens_number; j++)
         {
-            instances_count = 0;
+            if(parse_data_file_number(tokens[j].first, tokens[j].second, token, value))
+            {
+                continue;
+            }
 
-            continue;
+            token.assign(tokens[j].first, tokens[j].second);
+
+            if(token != missing_values_label && !chunk.nominal_labels[j].contains(token))
+            {
+                chunk.nominal_labels[j].push_back(token);
+            }
         }
+    }
+}
 
-        check_separator(line);
 
-        tokens = get_tokens(line);
-// caixa
-  /*      if(tokens.size() != columns_number)
+// void read_data_file_chunk(DataFileChunk&, const Vector< Vector<std::string> >&) method
+
+/// Performs the second read of a chunk of the data file, in which its instances are set in the data matrix.
+/// The missing values found are kept in the chunk, and any error found is written to its error message.
+/// @param chunk Chunk of the data file.
+/// @param nominal_labels Values of all nominal variables in the data file.
+
+void DataSet::read_data_file_chunk(DataFileChunk& chunk, const Vector< Vector<std::string> >& nominal_labels)
+{
+    const char separator_character = get_separator_string()[0];
+
+    Vector< std::pair<const char*, const char*> > tokens;
+
+    size_t instance_index = chunk.first_instance_index;
+
+    const char* line_begin = chunk.begin;
+
+    try
+    {
+        while(line_begin < chunk.end)
         {
-            std::ostringstream buffer;
+            const char* line_end = (const char*)memchr(line_begin, '\n', chunk.end - line_begin);
 
-            buffer << "OpenNN Exception: DataSet class.\n"
-                   << "Vector< Vector<std::string> > DataSet::set_from_data_file(void).\n"
-                   << "Row " << instances_count << ": Size of tokens (" << tokens.size() << ") is not equal to "
-                   << "number of columns (" << columns_number << ").\n";
+            if(!line_end)
+            {
+                line_end = chunk.end;
+            }
 
-            throw std::logic_error(buffer.str());
+            const char* next_line_begin = line_end < chunk.end ? line_end + 1 : chunk.end;
+
+            if(line_end > line_begin && *(line_end-1) == '\r')
+            {
+                line_end--;
+            }
+
+            split_data_file_line(line_begin, line_end, separator_character, tokens);
+
+            line_begin = next_line_begin;
+
+            if(tokens.empty())
+            {
+                continue;
+            }
+
+            read_instance(tokens, nominal_labels, instance_index, chunk);
+
+            instance_index++;
         }
-*/
-        instances_count++;
+    }
+    catch(const std::logic_error& e)
+    {
+        chunk.error_message = e.what();
+    }
+}
+
+
+// void read_instance(const Vector< std::pair<const char*, const char*> >&, const Vector< Vector<std::string> >&, const size_t&, DataFileChunk&) method
+
+/// Sets the values of a single instance in the data matrix from the tokens of a line in the data file.
+/// The missing values are appended to the chunk of the data file which contains the line.
+/// @param tokens Begin and end pointers of the tokens in the line.
+/// @param nominal_labels Values of all nominal variables in the data file.
+/// @param instance_index Index of instance.
+/// @param chunk Chunk of the data file which contains the line.
+
+void DataSet::read_instance(const Vector< std::pair<const char*, const char*> >& tokens,
+                            const Vector< Vector<std::string> >& nominal_labels,
+                            const size_t& instance_index,
+                            DataFileChunk& chunk)
+{
+    // Control sentence (if debug)
+
+    #ifdef __OPENNN_DEBUG__
+
+    const size_t instances_number = instances.get_instances_number();
+
+    if(instance_index >= instances_number)
+    {
+       std::ostringstream buffer;
+
+       buffer << "OpenNN Exception: DataSet class.\n"
+              << "void read_instance(const Vector< std::pair<const char*, const char*> >&, const Vector< Vector<std::string> >&, const size_t&, DataFileChunk&) method.\n"
+              << "Index of instance (" << instance_index << ") must be less than number of instances (" << instances_number << ").\n";
+
+       throw std::logic_error(buffer.str());
+    }
+
+    if(tokens.size() != nominal_labels.size())
+    {
+       std::ostringstream buffer;
+
+       buffer << "OpenNN Exception: DataSet class.\n"
+              << "void read_instance(const Vector< std::pair<const char*, const char*> >&, const Vector< Vector<std::string> >&, const size_t&, DataFileChunk&) method.\n"
+              << "Size of tokens (" << tokens.size() << ") must be equal to size of names (" << nominal_labels.size() << ").\n";
+
+       throw std::logic_error(buffer.str());
+    }
+
+    #endif
+
+    const size_t tokens_number = std::min(tokens.size(), nominal_labels.size());
+
+    std::string token;
+    double value;
+
+    size_t column_index = 0;
+
+    for(size_t j = 0; j < tokens_number; j++)
+    {
+        const bool missing_value = missing_values_label.size() == (size_t)(tokens[j].second - tokens[j].first)
+                                && std::equal(tokens[j].first, tokens[j].second, missing_values_label.begin());
 
-        /*
-        if(tokens.size() == columns_number)
+        if(nominal_labels[j].size() == 0) // Numeric variable
         {
-            instances_count++;
-            for(size_t j = 0; j < columns_number; j++)
+            if(!missing_value)
+            {
+                if(!parse_data_file_number(tokens[j].first, tokens[j].second, token, value))
+                {
+                    token.assign(tokens[j].first, tokens[j].second);
+
+                    value = atof(token.c_str());
+                }
+
+                data(instance_index, column_index) = value;
+            }
+            else
             {
-                numeric = is_numeric(tokens[j]);
+                data(instance_index, column_index) = -99.9;
+
+                chunk.missing_instances_indices.push_back(instance_index);
+                chunk.missing_variables_indices.push_back(column_index);
+            }
+
+            column_index++;
+        }
+
+        else if(nominal_labels[j].size() == 2) // Binary variable
+        {
+            token.assign(tokens[j].first, tokens[j].second);
 
-                if(!numeric
-                && tokens[j] != missing_values_label
-                && !nominal_labels[j].contains(tokens[j]))
+            if(!missing_value)
+            {
+                if(token == "false" || token == "False"||  token == "FALSE" || token == "F"
+                || token == "negative"|| token == "Negative"|| token == "NEGATIVE")
+                {
+                    data(instance_index, column_index) = 0.0;
+                }
+                else if(token == "true" || token == "True"||  token == "TRUE" || token == "T"
+                || token == "positive"|| token == "Positive"|| token == "POSITIVE")
+                {
+                    data(instance_index, column_index) = 1.0;
+                }
+                else if(token == nominal_labels[j][0])
+                {
+                    data(instance_index, column_index) = 0.0;
+                }
+                else if(token == nominal_labels[j][1])
+                {
+                    data(instance_index, column_index) = 1.0;
+                }
+                else
                 {
-                    nominal_labels[j].push_back(tokens[j]);
+                    std::ostringstream buffer;
+
+                    buffer << "OpenNN Exception: DataSet class.\n"
+                           << "void read_instance(const Vector< std::pair<const char*, const char*> >&, const Vector< Vector<std::string> >&, const size_t&, DataFileChunk&) method.\n"
+                           << "Unknown token binary value.\n";
+
+                    throw std::logic_error(buffer.str());
                 }
             }
-        }*/
+            else
+            {
+                data(instance_index, column_index) = -99.9;
+
+                chunk.missing_instances_indices.push_back(instance_index);
+                chunk.missing_variables_indices.push_back(column_index);
+            }
+
+            column_index++;
+        }
+
+        else // Nominal variable
+        {
+            token.assign(tokens[j].first, tokens[j].second);
+
+            for(size_t k = 0; k < nominal_labels[j].size(); k++)
+            {
+                if(!missing_value)
+                {
+                    data(instance_index, column_index+k) = token == nominal_labels[j][k] ? 1.0 : 0.0;
+                }
+                else
+                {
+                    data(instance_index, column_index+k) = -99.9;
 
+                    chunk.missing_instances_indices.push_back(instance_index);
+                    chunk.missing_variables_indices.push_back(column_index+k);
+                }
+            }
 
+            column_index += nominal_labels[j].size();
+        }
     }
+}
 
-    file.close();
+
+// Vector< Vector<std::string> > set_from_data_file(const DataFileMapping&, Vector<DataFileChunk>&) method
+
+/// Performs a first data file read in which the format is checked,
+/// and the numbers of variables, instances and missing values are set.
+/// The data file is split into chunks of whole lines, which are read in parallel,
+/// and their nominal labels are merged in order of appearance.
+/// @param data_file Contents of the data file.
+/// @param chunks Chunks of the data file. They are set with the index of their first instance.
+
+Vector< Vector<std::string> > DataSet::set_from_data_file(const DataFileMapping& data_file, Vector<DataFileChunk>& chunks)
+{
+    const size_t columns_number = count_data_file_columns_number();
+
+    Vector< Vector<std::string> > nominal_labels(columns_number);
+
+    check_header_line();
+
+    chunks = split_data_file(data_file);
+
+    const int chunks_number = (int)chunks.size();
+
+    int i;
+
+    #pragma omp parallel for private(i) schedule(dynamic)
+
+    for(i = 0; i < chunks_number; i++)
+    {
+        scan_data_file_chunk(chunks[i], columns_number);
+    }
+
+    // Merge chunks
+
+    size_t instances_count = 0;
+
+    for(i = 0; i < chunks_number; i++)
+    {
+        chunks[i].first_instance_index = instances_count;
+
+        instances_count += chunks[i].instances_number;
+
+        for(size_t j = 0; j < columns_number; j++)
+        {
+            for(size_t k = 0; k < chunks[i].nominal_labels[j].size(); k++)
+            {
+                if(!nominal_labels[j].contains(chunks[i].nominal_labels[j][k]))
+                {
+                    nominal_labels[j].push_back(chunks[i].nominal_labels[j][k]);
+                }
+            }
+        }
+
+        chunks[i].nominal_labels.clear();
+    }
 
     size_t variables_count = 0;
 
-    for(size_t i = 0; i < columns_number; i++)
+    for(size_t j = 0; j < columns_number; j++)
     {
-        if(nominal_labels[i].size() == 0 || nominal_labels[i].size() == 2)
+        if(nominal_labels[j].size() == 0 || nominal_labels[j].size() == 2)
         {
             variables_count++;
         }
         else
         {
-            variables_count += nominal_labels[i].size();
+            variables_count += nominal_labels[j].size();
         }
     }
 
     // Fix label case
 
-    for(size_t i = 0; i < columns_number; i++)
+    for(size_t j = 0; j < columns_number; j++)
     {
-        if(nominal_labels[i].size() == (size_t)instances_count)
+        if(nominal_labels[j].size() == instances_count)
         {
             std::ostringstream buffer;
 
             buffer << "OpenNN Exception: DataSet class.\n"
-                   << "Vector< Vector<std::string> > DataSet::set_from_data_file(void).\n"
-                   << "Column " << i << ": All elements are nominal and different. It contains meaningless data.\n";
+                   << "Vector< Vector<std::string> > DataSet::set_from_data_file(const DataFileMapping&, Vector<DataFileChunk>&).\n"
+                   << "Column " << j << ": All elements are nominal and different. It contains meaningless data.\n";
 
             throw std::logic_error(buffer.str());
         }
@@ -5337,95 +5920,65 @@ Vector< Vector<std::string> > DataSet::set_from_data_file(void)
 
         if(nominal_labels[columns_number-1].size() > 2)
         {
-            for(size_t i = variables_count-1; i >= variables_count - nominal_labels[columns_number-1].size(); i--)
+            for(size_t j = variables_count-1; j >= variables_count - nominal_labels[columns_number-1].size(); j--)
             {
-                variables.set_use(i, Variables::Target);
+                variables.set_use(j, Variables::Target);
             }
         }
     }
 
-    if(instances.get_instances_number() != (size_t)instances_count)
+    if(instances.get_instances_number() != instances_count)
     {
         instances.set(instances_count);
     }
 
     missing_values.set(instances.get_instances_number(), variables.get_variables_number());
 
+    invalidate_split_data();
+
     return(nominal_labels);
 }
 
 
-// void read_from_data_file(Vector< Vector<std::string> >&) method
+// void read_from_data_file(const Vector< Vector<std::string> >&, Vector<DataFileChunk>&) method
 
 /// Performs a second data file read in which the data is set.
+/// The chunks of the data file are parsed in parallel, each one writing its own rows of the data matrix.
+/// @param nominal_labels Values of all nominal variables in the data file.
+/// @param chunks Chunks of the data file, as set in the first read.
 
-void DataSet::read_from_data_file(const Vector< Vector<std::string> >& nominal_labels)
+void DataSet::read_from_data_file(const Vector< Vector<std::string> >& nominal_labels, Vector<DataFileChunk>& chunks)
 {
-    std::ifstream file(data_file_name.c_str());
-
-    file.clear();
-    file.seekg(0, std::ios::beg);
-
-    std::string line;
-
-    if(header_line)
+    if(data.empty())
     {
-        while(file.good())
-        {
-            getline(file, line);
+        return;
+    }
 
-            if(separator != Tab)
-            {
-                std::replace(line.begin(), line.end(), '\t', ' ');
-            }
+    const int chunks_number = (int)chunks.size();
 
-            trim(line);
+    int i;
 
-            if(line.empty())
-            {
-                continue;
-            }
+    #pragma omp parallel for private(i) schedule(dynamic)
 
-            break;
-        }                
+    for(i = 0; i < chunks_number; i++)
+    {
+        read_data_file_chunk(chunks[i], nominal_labels);
     }
 
-    size_t i = 0;
-
-//    #pragma omp parallel for private(i, line)
-
-    while(file.good())
+    for(i = 0; i < chunks_number; i++)
     {
-        getline(file, line);
-
-        if(separator != Tab)
+        if(!chunks[i].error_message.empty())
         {
-            std::replace(line.begin(), line.end(), '\t', ' ');
+            throw std::logic_error(chunks[i].error_message);
         }
 
-        const Vector<std::string> tokens = get_tokens(line);
-
-        trim(line);
-
-        if(line.empty())
+        for(size_t j = 0; j < chunks[i].missing_instances_indices.size(); j++)
         {
-            continue;
+            missing_values.append(chunks[i].missing_instances_indices[j], chunks[i].missing_variables_indices[j]);
         }
-
-        // #pragma omp task
-/*
-        if(tokens.size() == nominal_labels.size())
-        {
-            read_instance(line, nominal_labels, i);
-            i++;
-        }*/
-// caixa
-        read_instance(line, nominal_labels, i);
-        i++;
-
     }
 
-    file.close();
+    invalidate_split_data();
 }
 
 
@@ -5492,6 +6045,8 @@ void DataSet::convert_time_series(void)
     instances.convert_time_series(lags_number);
 
     missing_values.convert_time_series(lags_number);
+
+    invalidate_split_data();
 }
 
 
@@ -5507,6 +6062,105 @@ void DataSet::convert_association(void)
     variables.convert_association();
 
     missing_values.convert_association();
+
+    invalidate_split_data();
+}
+
+
+// DataFileMapping(const std::string&) constructor
+
+/// File name constructor.
+/// It maps the data file into memory where the system supports it, and reads it into a buffer otherwise.
+/// @param file_name Name of the data file.
+
+DataSet::DataFileMapping::DataFileMapping(const std::string& file_name)
+{
+    begin = NULL;
+    end = NULL;
+
+    mapping = NULL;
+    mapping_size = 0;
+
+    #if defined(__unix__) || defined(__APPLE__)
+
+    const int file_descriptor = open(file_name.c_str(), O_RDONLY);
+
+    if(file_descriptor != -1)
+    {
+        struct stat file_status;
+
+        if(fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+        {
+            void* address = mmap(NULL, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+            if(address != MAP_FAILED)
+            {
+                madvise(address, (size_t)file_status.st_size, MADV_SEQUENTIAL);
+
+                mapping = address;
+                mapping_size = (size_t)file_status.st_size;
+            }
+        }
+
+        close(file_descriptor);
+
+        if(mapping)
+        {
+            begin = (const char*)mapping;
+            end = begin + mapping_size;
+
+            return;
+        }
+    }
+
+    #endif
+
+    std::ifstream file(file_name.c_str(), std::ios::binary);
+
+    if(!file.is_open())
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "DataFileMapping(const std::string&) constructor.\n"
+               << "Cannot open data file: " << file_name << "\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    file.seekg(0, std::ios::end);
+
+    buffer.resize((size_t)file.tellg());
+
+    file.seekg(0, std::ios::beg);
+
+    if(!buffer.empty())
+    {
+        file.read(&buffer[0], buffer.size());
+    }
+
+    file.close();
+
+    begin = buffer.data();
+    end = begin + buffer.size();
+}
+
+
+// DESTRUCTOR
+
+/// Destructor.
+/// It unmaps the data file from memory.
+
+DataSet::DataFileMapping::~DataFileMapping(void)
+{
+    #if defined(__unix__) || defined(__APPLE__)
+
+    if(mapping)
+    {
+        munmap(mapping, mapping_size);
+    }
+
+    #endif
 }
 
 
@@ -5542,9 +6196,15 @@ void DataSet::load_data(void)
 
     file.close();
 
-    const Vector< Vector<std::string> > nominal_labels = set_from_data_file();
+    close_out_of_core_data();
+
+    const DataFileMapping data_file(data_file_name);
 
-    read_from_data_file(nominal_labels);
+    Vector<DataFileChunk> chunks;
+
+    const Vector< Vector<std::string> > nominal_labels = set_from_data_file(data_file, chunks);
+
+    read_from_data_file(nominal_labels, chunks);
 
     // Variables name
 
@@ -5591,7 +6251,12 @@ void DataSet::load_data(void)
 }
 
 
+// void load_data_binary(void) method
+
 /// This method loads the data from a binary data file.
+/// Files written by save_data_binary() also set the variables, the instances and the missing values.
+/// Otherwise, the file must contain the number of variables, the number of instances and the data in column-major order.
+/// The file is memory mapped and the data is copied in a single block, without parsing.
 
 void DataSet::load_data_binary(void)
 {
@@ -5610,28 +6275,284 @@ void DataSet::load_data_binary(void)
         throw std::logic_error(buffer.str());
     }
 
-    std::streamsize size = sizeof(size_t);
+    file.close();
 
-    size_t variables_number;
-    size_t instances_number;
+    close_out_of_core_data();
 
-    file.read(reinterpret_cast<char*>(&variables_number), size);
-    file.read(reinterpret_cast<char*>(&instances_number), size);
+    const DataFileMapping data_file(data_file_name);
 
-    size = sizeof(double);
+    const size_t file_size = data_file.end - data_file.begin;
 
-    double value;
+    if(file_size >= sizeof(BinaryDataFileHeader) && memcmp(data_file.begin, "OPENNNDS", 8) == 0)
+    {
+        load_data_binary(data_file);
+
+        return;
+    }
+
+    size_t variables_number = 0;
+    size_t instances_number = 0;
+
+    if(file_size >= 2*sizeof(size_t))
+    {
+        memcpy(&variables_number, data_file.begin, sizeof(size_t));
+        memcpy(&instances_number, data_file.begin + sizeof(size_t), sizeof(size_t));
+    }
+
+    if(file_size < 2*sizeof(size_t)
+    || (variables_number != 0 && instances_number > (file_size - 2*sizeof(size_t))/sizeof(double)/variables_number))
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void load_data_binary(void) method.\n"
+               << "Data file " << data_file_name << " is too small for its number of instances and variables.\n";
+
+        throw std::logic_error(buffer.str());
+    }
 
     data.set(instances_number, variables_number);
 
-    for(size_t i = 0; i < variables_number*instances_number; i++)
+    if(!data.empty())
     {
-        file.read(reinterpret_cast<char*>(&value), size);
+        memcpy(data.data(), data_file.begin + 2*sizeof(size_t), variables_number*instances_number*sizeof(double));
+    }
 
-        data[i] = value;
+    invalidate_split_data();
+}
+
+
+// BinaryDataFileHeader load_binary_data_file_information(const DataFileMapping&) method
+
+/// Checks the header of a binary data file written by save_data_binary(),
+/// and sets the variables, the instances and the missing values from it.
+/// It returns the header of the file, which locates the data matrix.
+/// @param data_file Contents of the binary data file.
+
+DataSet::BinaryDataFileHeader DataSet::load_binary_data_file_information(const DataFileMapping& data_file)
+{
+    const size_t file_size = data_file.end - data_file.begin;
+
+    BinaryDataFileHeader header;
+
+    memcpy(&header, data_file.begin, sizeof(BinaryDataFileHeader));
+
+    std::ostringstream buffer;
+
+    if(header.version != 1)
+    {
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "BinaryDataFileHeader load_binary_data_file_information(const DataFileMapping&) method.\n"
+               << "Unknown version of binary data file (" << header.version << ").\n";
+
+        throw std::logic_error(buffer.str());
     }
 
-    file.close();
+    if(header.byte_order != 0x0102030405060708ULL)
+    {
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "BinaryDataFileHeader load_binary_data_file_information(const DataFileMapping&) method.\n"
+               << "Binary data file has been written with a different byte order.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    const size_t instances_number = (size_t)header.instances_number;
+    const size_t variables_number = (size_t)header.variables_number;
+
+    // The data matrix must fit in the file, which also prevents the size of the data from overflowing
+
+    if(variables_number != 0 && instances_number > file_size/sizeof(double)/variables_number)
+    {
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "BinaryDataFileHeader load_binary_data_file_information(const DataFileMapping&) method.\n"
+               << "Binary data file " << data_file_name << " is too small for its number of instances (" << instances_number
+               << ") and variables (" << variables_number << ").\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    const size_t data_size = instances_number*variables_number*sizeof(double);
+
+    const size_t words_number = (instances_number*variables_number + 63)/64;
+
+    // Every section is compared with the space left after its offset, so that no sum can wrap around
+
+    if(header.variables_offset > file_size || header.variables_size > file_size - header.variables_offset
+    || header.instances_offset > file_size || header.instances_size > file_size - header.instances_offset
+    || header.data_offset > file_size || data_size > file_size - header.data_offset
+    || header.missing_values_offset > file_size || header.missing_values_size > file_size - header.missing_values_offset
+    || header.missing_values_size < words_number*sizeof(uint64_t))
+    {
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "BinaryDataFileHeader load_binary_data_file_information(const DataFileMapping&) method.\n"
+               << "Binary data file " << data_file_name << " is truncated.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    // Variables
+
+    tinyxml2::XMLDocument variables_document;
+
+    variables_document.Parse(data_file.begin + header.variables_offset, (size_t)header.variables_size);
+
+    variables.from_XML(variables_document);
+
+    // Instances
+
+    tinyxml2::XMLDocument instances_document;
+
+    instances_document.Parse(data_file.begin + header.instances_offset, (size_t)header.instances_size);
+
+    instances.from_XML(instances_document);
+
+    if(variables.get_variables_number() != variables_number || instances.get_instances_number() != instances_number)
+    {
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "BinaryDataFileHeader load_binary_data_file_information(const DataFileMapping&) method.\n"
+               << "Numbers of variables (" << variables.get_variables_number() << ") and instances (" << instances.get_instances_number()
+               << ") in binary data file " << data_file_name << " must be equal to those in its header ("
+               << variables_number << " and " << instances_number << ").\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    // Missing values
+
+    missing_values.set(instances_number, variables_number);
+
+    const uint64_t* missing_values_bitmap = reinterpret_cast<const uint64_t*>(data_file.begin + header.missing_values_offset);
+
+    Vector< std::pair<size_t, size_t> > missing_values_indices;
+
+    for(size_t i = 0; i < words_number; i++)
+    {
+        uint64_t word;
+
+        memcpy(&word, missing_values_bitmap + i, sizeof(uint64_t));
+
+        for(size_t j = 0; word != 0; j++, word >>= 1)
+        {
+            if(word & 1)
+            {
+                const size_t index = i*64 + j;
+
+                missing_values_indices.push_back(std::make_pair(index%instances_number, index/instances_number));
+            }
+        }
+    }
+
+    std::sort(missing_values_indices.begin(), missing_values_indices.end());
+
+    for(size_t i = 0; i < missing_values_indices.size(); i++)
+    {
+        missing_values.append(missing_values_indices[i].first, missing_values_indices[i].second);
+    }
+
+    return(header);
+}
+
+
+// void load_data_binary(const DataFileMapping&) method
+
+/// Sets the data, the variables, the instances and the missing values from a binary data file
+/// written by save_data_binary().
+/// @param data_file Contents of the binary data file.
+
+void DataSet::load_data_binary(const DataFileMapping& data_file)
+{
+    const BinaryDataFileHeader header = load_binary_data_file_information(data_file);
+
+    const size_t instances_number = (size_t)header.instances_number;
+    const size_t variables_number = (size_t)header.variables_number;
+
+    data.set(instances_number, variables_number);
+
+    if(!data.empty())
+    {
+        memcpy(data.data(), data_file.begin + header.data_offset, instances_number*variables_number*sizeof(double));
+    }
+
+    invalidate_split_data();
+}
+
+
+// void load_data_out_of_core(const size_t&, const size_t&) method
+
+/// Opens a binary data file written by save_data_binary() without loading its data matrix in memory.
+/// The variables, the instances and the missing values are set from the file, and the data is read
+/// by chunks of consecutive instances when it is needed. The most recently used chunks are kept in memory.
+/// The data file is memory mapped where the system supports it, and the next chunk is prefetched
+/// every time that a chunk is read.
+/// The data statistics, the scaling and unscaling methods and the error terms work chunk by chunk.
+/// Methods which access the data matrix directly are not available in this mode.
+/// @param new_chunk_instances_number Number of instances in each chunk.
+/// @param new_maximum_cached_chunks_number Maximum number of chunks kept in memory.
+
+void DataSet::load_data_out_of_core(const size_t& new_chunk_instances_number, const size_t& new_maximum_cached_chunks_number)
+{
+    if(new_chunk_instances_number == 0 || new_maximum_cached_chunks_number == 0)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void load_data_out_of_core(const size_t&, const size_t&) method.\n"
+               << "Number of instances per chunk and maximum number of cached chunks must be greater than zero.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    close_out_of_core_data();
+
+    data.set();
+
+    DataFileMapping* data_file_pointer = new DataFileMapping(data_file_name);
+
+    const size_t file_size = data_file_pointer->end - data_file_pointer->begin;
+
+    if(file_size < sizeof(BinaryDataFileHeader) || memcmp(data_file_pointer->begin, "OPENNNDS", 8) != 0)
+    {
+        delete data_file_pointer;
+
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void load_data_out_of_core(const size_t&, const size_t&) method.\n"
+               << "Data file " << data_file_name << " has not been written by save_data_binary().\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    BinaryDataFileHeader header;
+
+    try
+    {
+        header = load_binary_data_file_information(*data_file_pointer);
+    }
+    catch(const std::logic_error&)
+    {
+        delete data_file_pointer;
+
+        throw;
+    }
+
+    const size_t variables_number = (size_t)header.variables_number;
+
+    out_of_core_data.data_file_pointer = data_file_pointer;
+    out_of_core_data.data_offset = (size_t)header.data_offset;
+
+    out_of_core_data.chunk_instances_number = new_chunk_instances_number;
+    out_of_core_data.maximum_cached_chunks_number = new_maximum_cached_chunks_number;
+
+    out_of_core_data.scaling.set(2, variables_number, 0.0);
+
+    if(variables_number != 0)
+    {
+        out_of_core_data.scaling.set_row(1, Vector<double>(variables_number, 1.0));
+    }
+
+    invalidate_split_data();
 }
 
 
@@ -5700,6 +6621,8 @@ void DataSet::load_time_series_data_binary(void)
     }    
 
     file.close();
+
+    invalidate_split_data();
 }
 
 
@@ -5762,6 +6685,7 @@ void DataSet::load_time_series_data(void)
 
     variables.set_uses(uses);
 
+    invalidate_split_data();
 }
 */
 
@@ -5790,7 +6714,7 @@ Vector<size_t> DataSet::calculate_target_distribution(void) const
 
       for(size_t instance_index = 0; instance_index < instances_number; instance_index++)
       {
-          if(missing_values.arrange_missing_indices()[target_index].contains(instance_index))
+          if(missing_values.is_missing_value(instance_index, target_index))
           {
               continue;
           }
@@ -6287,79 +7211,60 @@ void DataSet::sum_binary_inputs(void)
 }
 
 
-// Vector<double> calculate_distances(const size_t&) const
+// KdTree<double> build_instances_kd_tree(void) const method
 
-/// Returns a matrix with the distances between every instance and the rest of the instances.
-/// The number of rows is the number of instances in the data set.
-/// The number of columns is the number of instances in the data set.
-/// @param nearest_neighbours_number Nearest neighbors number.
+/// Returns a k-dimensional tree over the used instances of the data set, with the values of the used variables.
+/// The points of the tree are numbered as the used instances.
 
-Matrix<double> DataSet::calculate_instances_distances(const size_t& nearest_neighbours_number) const
+KdTree<double> DataSet::build_instances_kd_tree(void) const
 {
-    const size_t instances_number = instances.count_used_instances_number();
     const Vector<size_t> instances_indices = instances.arrange_used_indices();
+    const Vector<size_t> variables_indices = variables.arrange_used_indices();
 
-    //Matrix<double> distances(instances_number, instances_number, 0.0);
-
-    Vector<double> distances(nearest_neighbours_number , -1.0);
+    Matrix<double> instances_data;
 
-    Vector<double> instance;
-    Vector<double> other_instance;
+    arrange_instances_data(instances_indices, 0, instances_indices.size(), variables_indices, instances_data);
 
-    size_t maximal_index;
+    return(KdTree<double>(instances_data));
+}
 
-    double distance;
 
-// #pragma omp parallel for private(maximal_index, distance) collapse(2)
+// Matrix<double> calculate_instances_distances(const size_t&) const method
 
-    for(size_t i = 0; i < instances_number; i++)
-    {
-        for(size_t j = 0; j < instances_number; j++)
-         {
+/// Returns a matrix with the distances between every used instance and its nearest neighbors, in increasing order.
+/// The number of rows is the number of used instances in the data set.
+/// The number of columns is the number of nearest neighbors.
+/// @param nearest_neighbours_number Nearest neighbors number.
 
-              distance = data.calculate_distance(instances_indices[i], instances_indices[j]);
+Matrix<double> DataSet::calculate_instances_distances(const size_t& nearest_neighbours_number) const
+{
+    const KdTree<double> kd_tree = build_instances_kd_tree();
 
-              if(distances.count_greater_than(distance) != 0)
-              {
-                   maximal_index = distances.calculate_maximal_index();
+    Matrix<size_t> nearest_neighbors;
+    Matrix<double> distances;
 
-                   distances[maximal_index] = distance;
-              }
-          }
-    }
+    kd_tree.calculate_nearest_neighbors(nearest_neighbours_number, nearest_neighbors, distances);
 
-    Matrix<double> distances1(instances_number, instances_number, 0.0);
-    return(distances1);
+    return(distances);
 }
 
 
-// Matrix<size_t> calculate_nearest_neighbors(const Matrix<double>&, const size_t&) const
+// Matrix<size_t> calculate_nearest_neighbors(const size_t&) const
 
-/// Returns a matrix with the k-nearest neighbors to every used instance in the data set.
-/// Number of rows is the number of isntances in the data set.
+/// Returns a matrix with the k-nearest neighbors to every used instance in the data set, in increasing order of distance.
+/// The neighbors are numbered as the used instances.
+/// Number of rows is the number of used instances in the data set.
 /// Number of columns is the number of nearest neighbors to calculate.
-/// @param distances Distances between every instance and the rest of them.
 /// @param nearest_neighbours_number Number of nearest neighbors to be calculated.
 
-Matrix<size_t> DataSet::calculate_nearest_neighbors(const Matrix<double>& distances, const size_t& nearest_neighbours_number) const
+Matrix<size_t> DataSet::calculate_nearest_neighbors(const size_t& nearest_neighbours_number) const
 {
-    const size_t instances_number = instances.count_used_instances_number();
-
-    Matrix<size_t> nearest_neighbors(instances_number, nearest_neighbours_number);
+    const KdTree<double> kd_tree = build_instances_kd_tree();
 
-    Vector<double> instance_distances;
-    Vector<size_t> minimal_distances_indices;
-
-    for(size_t i = 0; i < instances_number; i++)
-    {
-        instance_distances = distances.arrange_row(i);
-        minimal_distances_indices = instance_distances.calculate_minimal_indices(nearest_neighbours_number + 1);
+    Matrix<size_t> nearest_neighbors;
+    Matrix<double> distances;
 
-        for(size_t j = 0; j < nearest_neighbours_number; j++)
-        {
-            nearest_neighbors(i, j) = minimal_distances_indices[j + 1];
-        }
-    }
+    kd_tree.calculate_nearest_neighbors(nearest_neighbours_number, nearest_neighbors, distances);
 
     return(nearest_neighbors);
 }
@@ -6369,118 +7274,103 @@ Matrix<size_t> DataSet::calculate_nearest_neighbors(const Matrix<double>& distan
 
 /// Returns a vector with the k-distance of every instance in the data set, which is the distance between every
 /// instance and k-th nearest neighbor.
-/// @param distances Distances between every instance in the data set.
-/// @param nearest_neighbours_number Number of nearest neighbors to be calculated.
+/// @param distances Distances between every instance and its nearest neighbors, in increasing order.
 
-Vector<double> DataSet::calculate_k_distances(const Matrix<double>& distances, const size_t& nearest_neighbours_number) const
+Vector<double> DataSet::calculate_k_distances(const Matrix<double>& distances) const
 {
-    const size_t instances_number = instances.count_used_instances_number();
+    return(distances.arrange_column(distances.get_columns_number() - 1));
+}
 
-    const Matrix<size_t> nearest_neighbors = calculate_nearest_neighbors(distances, nearest_neighbours_number);
 
-    size_t maximal_index;
+// Matrix<double> calculate_reachability_distances(const Matrix<size_t>&, const Matrix<double>&) const
 
-    Vector<double> k_distances(instances_number);
+/// Calculates the reachability distances between every instance and its nearest neighbors.
+/// The reachability distance to a neighbor is the largest of their distance and the k-distance of that neighbor.
+/// @param nearest_neighbors Nearest neighbors of every instance.
+/// @param distances Distances between every instance and its nearest neighbors, in increasing order.
 
-    for(size_t i = 0; i < instances_number; i++)
-    {
-        maximal_index = nearest_neighbors(i, nearest_neighbours_number - 1);
+Matrix<double> DataSet::calculate_reachability_distances(const Matrix<size_t>& nearest_neighbors, const Matrix<double>& distances) const
+{
+    const size_t instances_number = distances.get_rows_number();
+    const size_t nearest_neighbours_number = distances.get_columns_number();
 
-        k_distances[i] = distances.arrange_row(i)[maximal_index];
-    }
+    const Vector<double> k_distances = calculate_k_distances(distances);
 
-    return(k_distances);
-}
-
-
-// Matrix<double> calculate_reachability_distance(const Matrix<double>&, Vector<double>&) const
-
-/// Calculates the reachability distances for the instances in the data set.
-/// @param distances Distances between every instance.
-/// @param k_distances Distances of the k-th nearest neighbors.
-
-Matrix<double> DataSet::calculate_reachability_distances(const Matrix<double>& distances, const Vector<double>& k_distances) const
-{
-    const size_t instances_number = instances.count_used_instances_number();
-
-    Matrix<double> reachability_distances(instances_number, instances_number);
+    Matrix<double> reachability_distances(instances_number, nearest_neighbours_number);
 
-    for(size_t i = 0; i < instances_number; i++)
+    for(size_t j = 0; j < nearest_neighbours_number; j++)
     {
-        for(size_t j = i; j < instances_number; j++)
+        for(size_t i = 0; i < instances_number; i++)
         {
-            if(distances(i, j) <= k_distances[i])
-            {
-                reachability_distances(i, j) = k_distances[i];
-                reachability_distances(j, i) = k_distances[i];
-            }
-            else if(distances(i, j) > k_distances[i])
-            {
-                reachability_distances(i, j) = distances(i, j);
-                reachability_distances(j, i) = distances(j, i);
-            }
-         }
+            reachability_distances(i, j) = std::max(distances(i, j), k_distances[nearest_neighbors(i, j)]);
+        }
     }
 
     return (reachability_distances);
 }
 
 
-// Vector<double> calculate_reachability_density(const Matrix<double>&, const size_t&) const
+// Vector<double> calculate_reachability_density(const Matrix<double>&) const
 
-/// Calculates reachability density for every element of the data set.
-/// @param distances Distances between every instance in the data set.
-/// @param nearest_neighbours_number Number of nearest neighbors to be calculated.
+/// Calculates the local reachability density for every instance of the data set,
+/// which is the inverse of the mean reachability distance to its nearest neighbors.
+/// @param reachability_distances Reachability distances between every instance and its nearest neighbors.
 
-Vector<double> DataSet::calculate_reachability_density(const Matrix<double>& distances, const size_t& nearest_neighbours_number) const
+Vector<double> DataSet::calculate_reachability_density(const Matrix<double>& reachability_distances) const
 {
-   const size_t instances_number = instances.count_used_instances_number();
-
-   const Vector<double> k_distances = calculate_k_distances(distances, nearest_neighbours_number);
-
-   const Matrix<double> reachability_distances = calculate_reachability_distances(distances, k_distances);
-
-   const Matrix<size_t> nearest_neighbors_indices = calculate_nearest_neighbors(distances, nearest_neighbours_number);
+   const size_t instances_number = reachability_distances.get_rows_number();
+   const size_t nearest_neighbours_number = reachability_distances.get_columns_number();
 
-   Vector<double> reachability_density(instances_number);
+   Vector<double> reachability_density(instances_number, 0.0);
 
-   Vector<size_t> nearest_neighbors_instance;
+   for(size_t j = 0; j < nearest_neighbours_number; j++)
+   {
+       for(size_t i = 0; i < instances_number; i++)
+       {
+           reachability_density[i] += reachability_distances(i, j);
+       }
+   }
 
    for(size_t i = 0; i < instances_number; i++)
    {
-       nearest_neighbors_instance = nearest_neighbors_indices.arrange_row(i);
-
-       reachability_density[i] = nearest_neighbours_number/ reachability_distances.arrange_row(i).calculate_partial_sum(nearest_neighbors_instance);
+       reachability_density[i] = nearest_neighbours_number/reachability_density[i];
    }
 
    return (reachability_density);
-
 }
 
 
 // Vector<double> calculate_local_outlier_factor(const size_t&) const
 
 /// Returns a vector with the local outlier factors for every used instance.
+/// The nearest neighbors are found with a k-dimensional tree, so that it takes O(n log n) time and O(n k) memory.
 /// @param nearest_neighbours_number Number of neighbors to be calculated.
 
 Vector<double> DataSet::calculate_local_outlier_factor(const size_t& nearest_neighbours_number) const
 {
-    const size_t instances_number = instances.count_used_instances_number();
+    const KdTree<double> kd_tree = build_instances_kd_tree();
+
+    Matrix<size_t> nearest_neighbors;
+    Matrix<double> distances;
 
-    const Matrix<double> distances = calculate_instances_distances(nearest_neighbours_number);
-    const Vector<double> reachability_density = calculate_reachability_density(distances, nearest_neighbours_number);
+    kd_tree.calculate_nearest_neighbors(nearest_neighbours_number, nearest_neighbors, distances);
 
-    const Matrix<size_t> nearest_neighbors = calculate_nearest_neighbors(distances, nearest_neighbours_number);
+    const Vector<double> reachability_density = calculate_reachability_density(calculate_reachability_distances(nearest_neighbors, distances));
 
-    Vector<size_t> instance_nearest_neighbors(nearest_neighbours_number);
+    const size_t instances_number = nearest_neighbors.get_rows_number();
 
     Vector<double> local_outlier_factor(instances_number);
 
     for(size_t i = 0; i < instances_number; i++)
     {
-        instance_nearest_neighbors = nearest_neighbors.arrange_row(i);
+        double neighbors_density = 0.0;
+
+        for(size_t j = 0; j < nearest_neighbours_number; j++)
+        {
+            neighbors_density += reachability_density[nearest_neighbors(i, j)];
+        }
 
-        local_outlier_factor[i] = (reachability_density.calculate_partial_sum(instance_nearest_neighbors))/(nearest_neighbours_number*reachability_density[i]);
+        local_outlier_factor[i] = neighbors_density/(nearest_neighbours_number*reachability_density[i]);
     }
 
     return (local_outlier_factor);
@@ -6523,19 +7413,31 @@ Vector<size_t> DataSet::clean_local_outlier_factor(const size_t& nearest_neighbo
 
 Vector<size_t> DataSet::calculate_Tukey_outliers(const size_t& variable_index, const double& cleaning_parameter) const
 {
-    const size_t instances_number = instances.count_used_instances_number();
     const Vector<size_t> instances_indices = instances.arrange_used_indices();
 
+    const size_t instances_number = instances_indices.size();
+
+    const Vector<size_t> variables_indices(1, variable_index);
+
     double interquartile_range;
 
     Vector<size_t> unused_instances_indices;
 
-    if(is_binary_variable(variable_index))
+    if(instances_number == 0)
+    {
+        return(unused_instances_indices);
+    }
+
+    Matrix<double> column;
+
+    arrange_instances_data(instances_indices, 0, instances_number, variables_indices, column);
+
+    if(column.is_binary())
     {
         return(unused_instances_indices);
     }
 
-    const Vector<double> box_plot = data.arrange_column(variable_index).calculate_box_plots();
+    const Vector<double> box_plot = calculate_variables_box_plots(instances_indices, variables_indices)[0];
 
     if(box_plot[3] == box_plot[1])
     {
@@ -6548,13 +7450,11 @@ Vector<size_t> DataSet::calculate_Tukey_outliers(const size_t& variable_index, c
 
     for(size_t j = 0; j < instances_number; j++)
     {
-        const Vector<double> instance = get_instance(instances_indices[j]);
-
-        if(instance[variable_index] < (box_plot[1] - cleaning_parameter*interquartile_range))
+        if(column(j,0) < (box_plot[1] - cleaning_parameter*interquartile_range))
         {
             unused_instances_indices.push_back(instances_indices[j]);
         }
-        else if(instance[variable_index] > (box_plot[3] + cleaning_parameter*interquartile_range))
+        else if(column(j,0) > (box_plot[3] + cleaning_parameter*interquartile_range))
         {
             unused_instances_indices.push_back(instances_indices[j]);
         }
@@ -6567,6 +7467,8 @@ Vector<size_t> DataSet::calculate_Tukey_outliers(const size_t& variable_index, c
 // Vector< Vector<size_t> > calculate_Tukey_outliers(const double&) const
 
 /// Calculate the outliers from the data set using the Tukey's test.
+/// The box plots of all the variables are computed in a single pass, and the instances are then checked
+/// by batches, so that the data is read twice in total.
 /// @param cleaning_parameter Parameter used to detect outliers.
 
 Vector< Vector<size_t> > DataSet::calculate_Tukey_outliers(const double& cleaning_parameter) const
@@ -6577,68 +7479,85 @@ Vector< Vector<size_t> > DataSet::calculate_Tukey_outliers(const double& cleanin
     const size_t variables_number = variables.count_used_variables_number();
     const Vector<size_t> used_variables_indices = variables.arrange_used_indices();
 
-    double interquartile_range;
-
     Vector< Vector<size_t> > return_values(2);
     return_values[0] = Vector<size_t>(instances_number, 0);
     return_values[1] = Vector<size_t>(variables_number, 0);
 
-    size_t variable_index;
+    if(instances_number == 0 || variables_number == 0)
+    {
+        return(return_values);
+    }
 
-    Vector< Vector<double> > box_plots(variables_number);
+    const Vector< Vector<double> > box_plots = calculate_variables_box_plots(instances_indices, used_variables_indices);
 
-#pragma omp parallel for private(variable_index) schedule(dynamic)
+    // Variables without interquartile range have no outliers
 
-    for(int i = 0; i < (int)variables_number; i++)
-    {
-        variable_index = used_variables_indices[i];
+    Vector<double> lower_bounds(variables_number, -std::numeric_limits<double>::max());
+    Vector<double> upper_bounds(variables_number, std::numeric_limits<double>::max());
 
-        if(is_binary_variable(variable_index))
+    for(size_t i = 0; i < variables_number; i++)
+    {
+        if(box_plots[i][3] != box_plots[i][1])
         {
-            continue;
-        }
+            const double interquartile_range = std::abs((box_plots[i][3] - box_plots[i][1]));
 
-        box_plots[i] = data.arrange_column(variable_index).calculate_box_plots();
+            lower_bounds[i] = box_plots[i][1] - cleaning_parameter*interquartile_range;
+            upper_bounds[i] = box_plots[i][3] + cleaning_parameter*interquartile_range;
+        }
     }
 
-    for(int i = 0; i < (int)variables_number; i++)
-    {
-        variable_index = used_variables_indices[i];
+    // Outliers of each variable, and whether it is binary (not a vector of bool, which threads cannot write at once)
 
-        if(is_binary_variable(variable_index))
-        {
-            continue;
-        }
+    Vector< Vector<size_t> > outliers_positions(variables_number);
 
-        const Vector<double> variable_box_plot = box_plots[i];
+    Vector<int> binary_variables(variables_number, 1);
 
-        if(variable_box_plot[3] == variable_box_plot[1])
-        {
-            continue;
-        }
-        else
-        {
-            interquartile_range = std::abs((variable_box_plot[3] - variable_box_plot[1]));
-        }
+    const size_t batch_size = 4096;
+
+    Matrix<double> batch;
 
-        size_t variables_outliers = 0;
+    for(size_t first_index = 0; first_index < instances_number; first_index += batch_size)
+    {
+        const size_t batch_instances_number = std::min(batch_size, instances_number - first_index);
 
-#pragma omp parallel for schedule(dynamic) reduction(+ : variables_outliers)
+        arrange_instances_data(instances_indices, first_index, batch_instances_number, used_variables_indices, batch);
 
-        for(int j = 0; j < instances_number; j++)
-        {
-            const Vector<double> instance = get_instance(instances_indices[j]);
+        int i;
 
-            if(instance[variable_index] < (variable_box_plot[1] - cleaning_parameter*interquartile_range) ||
-               instance[variable_index] > (variable_box_plot[3] + cleaning_parameter*interquartile_range))
+#pragma omp parallel for schedule(dynamic)
+
+        for(i = 0; i < (int)variables_number; i++)
+        {
+            for(size_t j = 0; j < batch_instances_number; j++)
             {
-                    return_values[0][j] = 1;
+                const double value = batch(j,i);
 
-                    variables_outliers++;
+                if(value != 0.0 && value != 1.0)
+                {
+                    binary_variables[i] = 0;
+                }
+
+                if(value < lower_bounds[i] || value > upper_bounds[i])
+                {
+                    outliers_positions[i].push_back(first_index + j);
+                }
             }
         }
+    }
+
+    for(size_t i = 0; i < variables_number; i++)
+    {
+        if(binary_variables[i])
+        {
+            continue;
+        }
 
-        return_values[1][i] = variables_outliers;
+        for(size_t j = 0; j < outliers_positions[i].size(); j++)
+        {
+            return_values[0][outliers_positions[i][j]] = 1;
+        }
+
+        return_values[1][i] = outliers_positions[i].size();
     }
 
     return(return_values);
@@ -6765,6 +7684,8 @@ void DataSet::generate_data_approximation(const size_t& instances_number, const
 //    set(new_data);
 
     data.scale_minimum_maximum();
+
+    invalidate_split_data();
 }
 
 
@@ -6823,7 +7744,7 @@ void DataSet::generate_data_multiple_classification(const size_t&, const size_t&
 
 bool DataSet::has_data(void) const
 {
-    if(data.empty())
+    if(data.empty() && !is_out_of_core())
     {
         return(false);
     }
@@ -6956,6 +7877,7 @@ void DataSet::convert_angular_variable_degrees(const size_t& variable_index)
 
     data.convert_angular_variables_degrees(variable_index);
 
+    invalidate_split_data();
 }
 
 
@@ -7002,6 +7924,7 @@ void DataSet::convert_angular_variable_radians(const size_t& variable_index)
 
     data.convert_angular_variables_radians(variable_index);
 
+    invalidate_split_data();
 }
 
 
@@ -7179,6 +8102,8 @@ void DataSet::scrub_missing_values_mean(void)
             data(instance_index, i) = means[i];
         }
     }
+
+    invalidate_split_data();
 }
 
 
@@ -7468,6 +8393,865 @@ bool DataSet::is_mixed(const Vector<std::string>& v) const
     }
 }
 
+
+// const SplitData& get_split_data(const Instances::Use&) const method
+
+/// Returns the input and target data of the training, selection or testing instances.
+/// They are arranged again from the data matrix only if the data, the instances uses or the variables uses
+/// have changed since the last call.
+/// @param use Use of the instances (training, selection or testing).
+
+const DataSet::SplitData& DataSet::get_split_data(const Instances::Use& use) const
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(use == Instances::Unused)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: DataSet class.\n"
+             << "const SplitData& get_split_data(const Instances::Use&) const method.\n"
+             << "Use must be training, selection or testing.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   SplitData& split_data = use == Instances::Training ? training_split_data
+                         : use == Instances::Selection ? selection_split_data
+                         : testing_split_data;
+
+   #pragma omp critical(data_set_split_data)
+   {
+      if(!split_data.arranged
+      || split_data.instances_version != instances.get_version()
+      || split_data.variables_version != variables.get_version())
+      {
+         Vector<size_t> instances_indices;
+
+         if(use == Instances::Training)
+         {
+            instances_indices = instances.arrange_training_indices();
+         }
+         else if(use == Instances::Selection)
+         {
+            instances_indices = instances.arrange_selection_indices();
+         }
+         else
+         {
+            instances_indices = instances.arrange_testing_indices();
+         }
+
+         const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
+         const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+
+         if(instances_indices.empty())
+         {
+            split_data.inputs.set();
+            split_data.targets.set();
+         }
+         else if(is_out_of_core())
+         {
+            arrange_instances_data(instances_indices, 0, instances_indices.size(), inputs_indices, split_data.inputs);
+            arrange_instances_data(instances_indices, 0, instances_indices.size(), targets_indices, split_data.targets);
+         }
+         else
+         {
+            split_data.inputs = inputs_indices.empty() ? Matrix<double>() : data.arrange_submatrix(instances_indices, inputs_indices);
+            split_data.targets = targets_indices.empty() ? Matrix<double>() : data.arrange_submatrix(instances_indices, targets_indices);
+         }
+
+         split_data.instances_version = instances.get_version();
+         split_data.variables_version = variables.get_version();
+
+         split_data.arranged = true;
+      }
+   }
+
+   return(split_data);
+}
+
+
+// void invalidate_split_data(void) method
+
+/// Marks the training, selection and testing input and target data as out of date, and increments the data version.
+/// It must be called by every method which modifies the data matrix.
+
+void DataSet::invalidate_split_data(void)
+{
+   training_split_data.arranged = false;
+   selection_split_data.arranged = false;
+   testing_split_data.arranged = false;
+
+   data_version++;
+}
+
+
+// void arrange_instances_data(const Vector<size_t>&, const size_t&, const size_t&, const Vector<size_t>&, Matrix<double>&) const method
+
+/// Arranges the values of some variables on a batch of instances.
+/// It reads the data matrix, or the chunks of the data file if the data set is in out-of-core mode.
+/// @param instances_indices Indices of the instances.
+/// @param first_index Position in the instances indices of the first instance in the batch.
+/// @param instances_number Number of instances in the batch.
+/// @param variables_indices Indices of the variables.
+/// @param instances_data Matrix where the values are written, with a row for each instance and a column for each variable.
+
+void DataSet::arrange_instances_data(const Vector<size_t>& instances_indices,
+                                     const size_t& first_index,
+                                     const size_t& instances_number,
+                                     const Vector<size_t>& variables_indices,
+                                     Matrix<double>& instances_data) const
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(first_index + instances_number > instances_indices.size())
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: DataSet class.\n"
+             << "void arrange_instances_data(const Vector<size_t>&, const size_t&, const size_t&, const Vector<size_t>&, Matrix<double>&) const method.\n"
+             << "Batch exceeds size of instances indices.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   const size_t variables_number = variables_indices.size();
+
+   if(instances_number == 0 || variables_number == 0)
+   {
+      instances_data.set();
+
+      return;
+   }
+
+   if(instances_data.get_rows_number() != instances_number || instances_data.get_columns_number() != variables_number)
+   {
+      instances_data.set(instances_number, variables_number);
+   }
+
+   if(!is_out_of_core())
+   {
+      for(size_t i = 0; i < instances_number; i++)
+      {
+         const size_t instance_index = instances_indices[first_index+i];
+
+         for(size_t j = 0; j < variables_number; j++)
+         {
+            instances_data(i,j) = data(instance_index, variables_indices[j]);
+         }
+      }
+
+      return;
+   }
+
+   const size_t chunk_instances_number = out_of_core_data.chunk_instances_number;
+
+   #pragma omp critical(data_set_chunks)
+   {
+      size_t i = 0;
+
+      while(i < instances_number)
+      {
+         const size_t chunk_index = instances_indices[first_index+i]/chunk_instances_number;
+
+         const Matrix<double>& chunk = get_cached_data_chunk(chunk_index);
+
+         const size_t first_chunk_instance = chunk_index*chunk_instances_number;
+
+         // Instances in the same chunk are read without looking for it again
+
+         while(i < instances_number && instances_indices[first_index+i]/chunk_instances_number == chunk_index)
+         {
+            const size_t chunk_row = instances_indices[first_index+i] - first_chunk_instance;
+
+            for(size_t j = 0; j < variables_number; j++)
+            {
+               instances_data(i,j) = chunk(chunk_row, variables_indices[j]);
+            }
+
+            i++;
+         }
+      }
+   }
+}
+
+
+// bool is_out_of_core(void) const method
+
+/// Returns true if the data matrix is read by chunks from a binary data file,
+/// and false if it is kept in memory.
+
+bool DataSet::is_out_of_core(void) const
+{
+   return(out_of_core_data.data_file_pointer != NULL);
+}
+
+
+// const size_t& get_chunk_instances_number(void) const method
+
+/// Returns the number of instances in each chunk of the data file in out-of-core mode.
+
+const size_t& DataSet::get_chunk_instances_number(void) const
+{
+   return(out_of_core_data.chunk_instances_number);
+}
+
+
+// const size_t& get_maximum_cached_chunks_number(void) const method
+
+/// Returns the maximum number of chunks of the data file kept in memory in out-of-core mode.
+
+const size_t& DataSet::get_maximum_cached_chunks_number(void) const
+{
+   return(out_of_core_data.maximum_cached_chunks_number);
+}
+
+
+// size_t count_chunks_number(void) const method
+
+/// Returns the number of chunks in the data file in out-of-core mode, and zero otherwise.
+
+size_t DataSet::count_chunks_number(void) const
+{
+   if(!is_out_of_core())
+   {
+      return(0);
+   }
+
+   const size_t instances_number = instances.get_instances_number();
+   const size_t chunk_instances_number = out_of_core_data.chunk_instances_number;
+
+   return((instances_number + chunk_instances_number - 1)/chunk_instances_number);
+}
+
+
+// Matrix<double> get_data_chunk(const size_t&) const method
+
+/// Returns the values of all the variables on a chunk of consecutive instances in out-of-core mode.
+/// The last chunk might have fewer instances than the others.
+/// @param chunk_index Index of the chunk.
+
+Matrix<double> DataSet::get_data_chunk(const size_t& chunk_index) const
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(chunk_index >= count_chunks_number())
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: DataSet class.\n"
+             << "Matrix<double> get_data_chunk(const size_t&) const method.\n"
+             << "Index of chunk must be less than number of chunks.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   Matrix<double> chunk;
+
+   #pragma omp critical(data_set_chunks)
+   {
+      chunk = get_cached_data_chunk(chunk_index);
+   }
+
+   return(chunk);
+}
+
+
+// const Matrix<double>& get_cached_data_chunk(const size_t&) const method
+
+/// Returns a chunk of the data file, reading it only if it is not among the most recently used chunks.
+/// When the cache is full, the least recently used chunk is replaced.
+/// The chunk is scaled as the rest of the data set, and the next chunk is prefetched.
+/// The reference is valid until the next call, and the calls must be inside the data_set_chunks critical section.
+/// @param chunk_index Index of the chunk.
+
+const Matrix<double>& DataSet::get_cached_data_chunk(const size_t& chunk_index) const
+{
+   OutOfCoreData& ooc = out_of_core_data;
+
+   ooc.chunks_uses_count++;
+
+   const size_t cached_chunks_number = ooc.cached_chunks_indices.size();
+
+   for(size_t i = 0; i < cached_chunks_number; i++)
+   {
+      if(ooc.cached_chunks_indices[i] == chunk_index)
+      {
+         ooc.cached_chunks_uses[i] = ooc.chunks_uses_count;
+
+         return(ooc.cached_chunks[i]);
+      }
+   }
+
+   size_t cache_index;
+
+   if(cached_chunks_number < ooc.maximum_cached_chunks_number)
+   {
+      cache_index = cached_chunks_number;
+
+      ooc.cached_chunks.push_back(Matrix<double>());
+      ooc.cached_chunks_indices.push_back(chunk_index);
+      ooc.cached_chunks_uses.push_back(ooc.chunks_uses_count);
+   }
+   else
+   {
+      cache_index = ooc.cached_chunks_uses.calculate_minimal_index();
+
+      ooc.cached_chunks_indices[cache_index] = chunk_index;
+      ooc.cached_chunks_uses[cache_index] = ooc.chunks_uses_count;
+   }
+
+   // Read chunk
+
+   const size_t instances_number = instances.get_instances_number();
+   const size_t variables_number = variables.get_variables_number();
+
+   const size_t first_instance = chunk_index*ooc.chunk_instances_number;
+   const size_t chunk_instances_number = std::min(ooc.chunk_instances_number, instances_number - first_instance);
+
+   Matrix<double>& chunk = ooc.cached_chunks[cache_index];
+
+   chunk.set(chunk_instances_number, variables_number);
+
+   const char* data_begin = ooc.data_file_pointer->begin + ooc.data_offset;
+
+   for(size_t j = 0; j < variables_number; j++)
+   {
+      double* column = chunk.data() + j*chunk_instances_number;
+
+      memcpy(column, data_begin + (j*instances_number + first_instance)*sizeof(double), chunk_instances_number*sizeof(double));
+
+      const double intercept = ooc.scaling(0,j);
+      const double slope = ooc.scaling(1,j) - intercept;
+
+      if(slope != 1.0 || intercept != 0.0)
+      {
+         for(size_t i = 0; i < chunk_instances_number; i++)
+         {
+            column[i] = slope*column[i] + intercept;
+         }
+      }
+   }
+
+   // Prefetch next chunk
+
+   #if defined(__unix__) || defined(__APPLE__)
+
+   const size_t next_first_instance = first_instance + chunk_instances_number;
+
+   if(next_first_instance < instances_number)
+   {
+      const size_t next_chunk_instances_number = std::min(ooc.chunk_instances_number, instances_number - next_first_instance);
+
+      const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+      for(size_t j = 0; j < variables_number; j++)
+      {
+         const size_t segment_begin = (size_t)(data_begin + (j*instances_number + next_first_instance)*sizeof(double));
+         const size_t segment_end = segment_begin + next_chunk_instances_number*sizeof(double);
+
+         const size_t page_begin = segment_begin/page_size*page_size;
+
+         madvise((void*)page_begin, segment_end - page_begin, MADV_WILLNEED);
+      }
+   }
+
+   #endif
+
+   return(chunk);
+}
+
+
+// Matrix<double>& get_scaled_data(void) method
+
+/// Returns the matrix which the scaling and unscaling methods must modify.
+/// It is the data matrix, or the images of 0 and 1 for each variable in out-of-core mode,
+/// since the scaling methods are affine transformations of each variable.
+/// In that case the chunks in memory are released, so that they are read again with the new scaling.
+
+Matrix<double>& DataSet::get_scaled_data(void)
+{
+   if(!is_out_of_core())
+   {
+      return(data);
+   }
+
+   out_of_core_data.cached_chunks.clear();
+   out_of_core_data.cached_chunks_indices.clear();
+   out_of_core_data.cached_chunks_uses.clear();
+
+   invalidate_split_data();
+
+   return(out_of_core_data.scaling);
+}
+
+
+// Vector< Moments<double> > calculate_variables_moments(const Vector<size_t>&, const Vector<size_t>&) const method
+
+/// Returns the number of values, the extreme values and the central moments of some variables on some instances,
+/// leaving out the missing values.
+/// The data is traversed once, in parallel, and in out-of-core mode it is read chunk by chunk.
+/// @param instances_indices Indices of the instances.
+/// @param variables_indices Indices of the variables.
+
+Vector< Moments<double> > DataSet::calculate_variables_moments(const Vector<size_t>& instances_indices, const Vector<size_t>& variables_indices) const
+{
+   if(!is_out_of_core())
+   {
+      const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+
+      return(data.calculate_columns_moments_missing_values(instances_indices, variables_indices, missing_indices));
+   }
+
+   Vector<size_t> sorted_instances_indices(instances_indices);
+
+   std::sort(sorted_instances_indices.begin(), sorted_instances_indices.end());
+
+   const Vector< Vector<size_t> > sorted_missing_indices = arrange_sorted_missing_indices();
+
+   Vector< Moments<double> > moments(variables_indices.size());
+
+   Vector<size_t> chunk_rows;
+
+   Vector< Vector<size_t> > chunk_missing_indices;
+
+   size_t position = 0;
+
+   while(position < sorted_instances_indices.size())
+   {
+      const size_t chunk_index = arrange_chunk_instances(sorted_instances_indices, sorted_missing_indices, position, chunk_rows, chunk_missing_indices);
+
+      #pragma omp critical(data_set_chunks)
+      {
+         const Matrix<double>& chunk = get_cached_data_chunk(chunk_index);
+
+         const Vector< Moments<double> > chunk_moments = chunk.calculate_columns_moments_missing_values(chunk_rows, variables_indices, chunk_missing_indices);
+
+         for(size_t j = 0; j < moments.size(); j++)
+         {
+            moments[j].merge(chunk_moments[j]);
+         }
+      }
+   }
+
+   return(moments);
+}
+
+
+// Vector<double> calculate_variables_means(const Vector<size_t>&, const Vector<size_t>&) const method
+
+/// Returns the mean values of some variables on some instances, leaving out the missing values.
+/// In out-of-core mode the data is read chunk by chunk.
+/// @param instances_indices Indices of the instances.
+/// @param variables_indices Indices of the variables.
+
+Vector<double> DataSet::calculate_variables_means(const Vector<size_t>& instances_indices, const Vector<size_t>& variables_indices) const
+{
+   if(!is_out_of_core())
+   {
+      const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+
+      return(data.calculate_mean_missing_values(instances_indices, variables_indices, missing_indices));
+   }
+
+   const Vector< Moments<double> > moments = calculate_variables_moments(instances_indices, variables_indices);
+
+   Vector<double> means(moments.size());
+
+   for(size_t i = 0; i < moments.size(); i++)
+   {
+      means[i] = moments[i].mean;
+   }
+
+   return(means);
+}
+
+
+// Vector< Statistics<double> > calculate_variables_statistics(const Vector<size_t>&, const Vector<size_t>&) const method
+
+/// Returns the minimum, maximum, mean and standard deviation of some variables on some instances,
+/// leaving out the missing values.
+/// @param instances_indices Indices of the instances.
+/// @param variables_indices Indices of the variables.
+
+Vector< Statistics<double> > DataSet::calculate_variables_statistics(const Vector<size_t>& instances_indices, const Vector<size_t>& variables_indices) const
+{
+   const Vector< Moments<double> > moments = calculate_variables_moments(instances_indices, variables_indices);
+
+   Vector< Statistics<double> > statistics(moments.size());
+
+   for(size_t i = 0; i < moments.size(); i++)
+   {
+      statistics[i] = moments[i].calculate_statistics();
+   }
+
+   return(statistics);
+}
+
+
+// Vector< Vector<double> > calculate_variables_shape_parameters(const Vector<size_t>&, const Vector<size_t>&) const method
+
+/// Returns the asymmetry and the kurtosis of some variables on some instances,
+/// leaving out the missing values.
+/// @param instances_indices Indices of the instances.
+/// @param variables_indices Indices of the variables.
+
+Vector< Vector<double> > DataSet::calculate_variables_shape_parameters(const Vector<size_t>& instances_indices, const Vector<size_t>& variables_indices) const
+{
+   const Vector< Moments<double> > moments = calculate_variables_moments(instances_indices, variables_indices);
+
+   Vector< Vector<double> > shape_parameters(moments.size());
+
+   for(size_t i = 0; i < moments.size(); i++)
+   {
+      shape_parameters[i] = moments[i].calculate_shape_parameters();
+   }
+
+   return(shape_parameters);
+}
+
+
+// Vector< Vector<double> > calculate_variables_box_plots(const Vector<size_t>&, const Vector<size_t>&) const method
+
+/// Returns the box and whiskers of some variables on some instances, leaving out the missing values.
+/// The quartiles are exact, and they are computed in linear time.
+/// In out-of-core mode they are approximated with quantile sketches, which are computed chunk by chunk and merged.
+/// @param instances_indices Indices of the instances.
+/// @param variables_indices Indices of the variables.
+
+Vector< Vector<double> > DataSet::calculate_variables_box_plots(const Vector<size_t>& instances_indices, const Vector<size_t>& variables_indices) const
+{
+   if(!is_out_of_core())
+   {
+      const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+
+      return(data.calculate_columns_box_plots_missing_values(instances_indices, variables_indices, missing_indices));
+   }
+
+   const size_t sketch_capacity = 1024;
+
+   Vector<size_t> sorted_instances_indices(instances_indices);
+
+   std::sort(sorted_instances_indices.begin(), sorted_instances_indices.end());
+
+   const Vector< Vector<size_t> > sorted_missing_indices = arrange_sorted_missing_indices();
+
+   Vector< QuantileSketch<double> > sketches(variables_indices.size(), QuantileSketch<double>(sketch_capacity));
+
+   Vector<size_t> chunk_rows;
+
+   Vector< Vector<size_t> > chunk_missing_indices;
+
+   size_t position = 0;
+
+   while(position < sorted_instances_indices.size())
+   {
+      const size_t chunk_index = arrange_chunk_instances(sorted_instances_indices, sorted_missing_indices, position, chunk_rows, chunk_missing_indices);
+
+      #pragma omp critical(data_set_chunks)
+      {
+         const Matrix<double>& chunk = get_cached_data_chunk(chunk_index);
+
+         const Vector< QuantileSketch<double> > chunk_sketches
+         = chunk.calculate_columns_quantile_sketches_missing_values(chunk_rows, variables_indices, chunk_missing_indices, sketch_capacity);
+
+         for(size_t j = 0; j < sketches.size(); j++)
+         {
+            sketches[j].merge(chunk_sketches[j]);
+         }
+      }
+   }
+
+   Vector< Vector<double> > box_plots(variables_indices.size());
+
+   for(size_t j = 0; j < box_plots.size(); j++)
+   {
+      box_plots[j] = sketches[j].calculate_box_plots();
+   }
+
+   return(box_plots);
+}
+
+
+// Vector< Histogram<double> > calculate_variables_histograms(const Vector<size_t>&, const Vector<size_t>&, const size_t&, const bool&) const method
+
+/// Returns a histogram of equally spaced bins for some variables on some instances, leaving out the missing values.
+/// The bins are computed from the range of the variables, and the frequencies are counted in a single pass.
+/// In out-of-core mode the frequencies are counted chunk by chunk.
+/// @param instances_indices Indices of the instances.
+/// @param variables_indices Indices of the variables.
+/// @param bins_number Number of bins.
+/// @param binary_histograms True if the binary variables are to have a histogram of two bins, false otherwise.
+
+Vector< Histogram<double> > DataSet::calculate_variables_histograms(const Vector<size_t>& instances_indices,
+                                                                    const Vector<size_t>& variables_indices,
+                                                                    const size_t& bins_number,
+                                                                    const bool& binary_histograms) const
+{
+   if(!is_out_of_core())
+   {
+      const Vector< Vector<size_t> > missing_indices = missing_values.arrange_missing_indices();
+
+      return(data.calculate_columns_histograms_missing_values(instances_indices, variables_indices, missing_indices, bins_number, binary_histograms));
+   }
+
+   const size_t variables_number = variables_indices.size();
+
+   const Vector< Moments<double> > moments = calculate_variables_moments(instances_indices, variables_indices);
+
+   Vector< Histogram<double> > histograms(variables_number);
+
+   Vector< Vector<size_t> > binary_frequencies(variables_number, Vector<size_t>(2, 0));
+
+   for(size_t j = 0; j < variables_number; j++)
+   {
+      histograms[j].set_equal_width_bins(moments[j].minimum, moments[j].maximum, bins_number);
+   }
+
+   Vector<size_t> sorted_instances_indices(instances_indices);
+
+   std::sort(sorted_instances_indices.begin(), sorted_instances_indices.end());
+
+   const Vector< Vector<size_t> > sorted_missing_indices = arrange_sorted_missing_indices();
+
+   Vector<size_t> chunk_rows;
+
+   Vector< Vector<size_t> > chunk_missing_indices;
+
+   size_t position = 0;
+
+   while(position < sorted_instances_indices.size())
+   {
+      const size_t chunk_index = arrange_chunk_instances(sorted_instances_indices, sorted_missing_indices, position, chunk_rows, chunk_missing_indices);
+
+      #pragma omp critical(data_set_chunks)
+      {
+         const Matrix<double>& chunk = get_cached_data_chunk(chunk_index);
+
+         for(size_t j = 0; j < variables_number; j++)
+         {
+            const Vector<size_t>& missing_rows = chunk_missing_indices[variables_indices[j]];
+
+            for(size_t i = 0; i < chunk_rows.size(); i++)
+            {
+               if(std::binary_search(missing_rows.begin(), missing_rows.end(), chunk_rows[i]))
+               {
+                  continue;
+               }
+
+               const double value = chunk(chunk_rows[i], variables_indices[j]);
+
+               histograms[j].frequencies[histograms[j].calculate_bin(value)]++;
+
+               if(value == 0.0)
+               {
+                  binary_frequencies[j][0]++;
+               }
+               else if(value == 1.0)
+               {
+                  binary_frequencies[j][1]++;
+               }
+            }
+         }
+      }
+   }
+
+   if(binary_histograms)
+   {
+      for(size_t j = 0; j < variables_number; j++)
+      {
+         if(binary_frequencies[j][0] + binary_frequencies[j][1] == moments[j].count)
+         {
+            histograms[j].minimums.set(2);
+            histograms[j].minimums[0] = 0.0;
+            histograms[j].minimums[1] = 1.0;
+
+            histograms[j].maximums = histograms[j].minimums;
+            histograms[j].centers = histograms[j].minimums;
+            histograms[j].frequencies = binary_frequencies[j];
+         }
+      }
+   }
+
+   return(histograms);
+}
+
+
+// CrossMoments<double> calculate_variables_cross_moments(const Vector<size_t>&, const Vector<size_t>&, const Vector<size_t>&) const method
+
+/// Returns the means, the sums of squared deviations and the sums of cross deviations of two sets of variables on some instances.
+/// The cross deviations are computed with matrix products over blocks of instances.
+/// In out-of-core mode the blocks are the chunks of the data file.
+/// @param instances_indices Indices of the instances.
+/// @param first_variables_indices Indices of the first set of variables.
+/// @param second_variables_indices Indices of the second set of variables.
+
+CrossMoments<double> DataSet::calculate_variables_cross_moments(const Vector<size_t>& instances_indices,
+                                                                const Vector<size_t>& first_variables_indices,
+                                                                const Vector<size_t>& second_variables_indices) const
+{
+   if(!is_out_of_core())
+   {
+      return(data.calculate_columns_cross_moments(instances_indices, first_variables_indices, second_variables_indices));
+   }
+
+   Vector<size_t> sorted_instances_indices(instances_indices);
+
+   std::sort(sorted_instances_indices.begin(), sorted_instances_indices.end());
+
+   const Vector< Vector<size_t> > no_missing_indices;
+
+   CrossMoments<double> cross_moments(first_variables_indices.size(), second_variables_indices.size());
+
+   Vector<size_t> chunk_rows;
+
+   Vector< Vector<size_t> > chunk_missing_indices;
+
+   size_t position = 0;
+
+   while(position < sorted_instances_indices.size())
+   {
+      const size_t chunk_index = arrange_chunk_instances(sorted_instances_indices, no_missing_indices, position, chunk_rows, chunk_missing_indices);
+
+      #pragma omp critical(data_set_chunks)
+      {
+         const Matrix<double>& chunk = get_cached_data_chunk(chunk_index);
+
+         cross_moments.merge(chunk.calculate_columns_cross_moments(chunk_rows, first_variables_indices, second_variables_indices));
+      }
+   }
+
+   return(cross_moments);
+}
+
+
+// Vector< Vector<size_t> > arrange_sorted_missing_indices(void) const method
+
+/// Returns the indices of the instances with missing values for each variable, in increasing order.
+
+Vector< Vector<size_t> > DataSet::arrange_sorted_missing_indices(void) const
+{
+   Vector< Vector<size_t> > sorted_missing_indices = missing_values.arrange_missing_indices();
+
+   sorted_missing_indices.resize(variables.get_variables_number());
+
+   for(size_t j = 0; j < sorted_missing_indices.size(); j++)
+   {
+      std::sort(sorted_missing_indices[j].begin(), sorted_missing_indices[j].end());
+   }
+
+   return(sorted_missing_indices);
+}
+
+
+// size_t arrange_chunk_instances(const Vector<size_t>&, const Vector< Vector<size_t> >&, size_t&, Vector<size_t>&, Vector< Vector<size_t> >&) const method
+
+/// Arranges the instances in the next chunk of the data file, and the missing values in that chunk,
+/// relative to the first instance of the chunk. It returns the index of the chunk.
+/// @param sorted_instances_indices Indices of the instances, in increasing order.
+/// @param sorted_missing_indices Indices of the instances with missing values for each variable, in increasing order.
+/// @param position Position in the instances indices of the first instance in the chunk.
+/// It is moved past the last instance in the chunk.
+/// @param chunk_rows Rows of the instances in the chunk.
+/// @param chunk_missing_indices Rows of the missing values in the chunk for each variable.
+
+size_t DataSet::arrange_chunk_instances(const Vector<size_t>& sorted_instances_indices,
+                                        const Vector< Vector<size_t> >& sorted_missing_indices,
+                                        size_t& position,
+                                        Vector<size_t>& chunk_rows,
+                                        Vector< Vector<size_t> >& chunk_missing_indices) const
+{
+   const size_t chunk_instances_number = out_of_core_data.chunk_instances_number;
+
+   const size_t chunk_index = sorted_instances_indices[position]/chunk_instances_number;
+
+   const size_t first_instance = chunk_index*chunk_instances_number;
+   const size_t last_instance = first_instance + chunk_instances_number;
+
+   chunk_rows.clear();
+
+   while(position < sorted_instances_indices.size() && sorted_instances_indices[position] < last_instance)
+   {
+      chunk_rows.push_back(sorted_instances_indices[position] - first_instance);
+
+      position++;
+   }
+
+   chunk_missing_indices.set(sorted_missing_indices.size());
+
+   for(size_t j = 0; j < sorted_missing_indices.size(); j++)
+   {
+      const Vector<size_t>& variable_missing_indices = sorted_missing_indices[j];
+
+      chunk_missing_indices[j].clear();
+
+      Vector<size_t>::const_iterator it = std::lower_bound(variable_missing_indices.begin(), variable_missing_indices.end(), first_instance);
+
+      for(; it != variable_missing_indices.end() && *it < last_instance; ++it)
+      {
+         chunk_missing_indices[j].push_back(*it - first_instance);
+      }
+   }
+
+   return(chunk_index);
+}
+
+
+// void copy_out_of_core_data(const DataSet&) method
+
+/// Sets the out-of-core mode of this data set as that of another data set.
+/// The data file is opened again, so that both data sets can be used independently.
+/// @param other_data_set Data set object to be copied.
+
+void DataSet::copy_out_of_core_data(const DataSet& other_data_set)
+{
+   close_out_of_core_data();
+
+   if(!other_data_set.is_out_of_core())
+   {
+      return;
+   }
+
+   out_of_core_data.data_file_pointer = new DataFileMapping(other_data_set.data_file_name);
+
+   out_of_core_data.data_offset = other_data_set.out_of_core_data.data_offset;
+   out_of_core_data.chunk_instances_number = other_data_set.out_of_core_data.chunk_instances_number;
+   out_of_core_data.maximum_cached_chunks_number = other_data_set.out_of_core_data.maximum_cached_chunks_number;
+   out_of_core_data.scaling = other_data_set.out_of_core_data.scaling;
+}
+
+
+// void close_out_of_core_data(void) method
+
+/// Closes the data file of the out-of-core mode, and releases the chunks in memory.
+/// It does nothing if the data set is not in out-of-core mode.
+
+void DataSet::close_out_of_core_data(void)
+{
+   if(!is_out_of_core())
+   {
+      return;
+   }
+
+   delete out_of_core_data.data_file_pointer;
+
+   out_of_core_data = OutOfCoreData();
+
+   invalidate_split_data();
+}
+
 }
 
 // OpenNN: Open Neural Networks Library.
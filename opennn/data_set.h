@@ -26,6 +26,11 @@
 #include <stdexcept>
 #include <ctime>
 #include <exception>
+#include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
 
 #ifdef __OPENNN_MPI__
 #include <mpi.h>
@@ -34,6 +39,7 @@
 
 #include "vector.h"
 #include "matrix.h"
+#include "kd_tree.h"
 
 #include "missing_values.h"
 #include "variables.h"
@@ -175,6 +181,8 @@ public:
    const Matrix<double>& get_data(void) const;
    const Matrix<double>& get_time_series_data(void) const;
 
+   const size_t& get_data_version(void) const;
+
    Matrix<double> get_instances_submatrix_data(const Vector<size_t>&) const;
 
    Matrix<double> arrange_training_data(void) const;
@@ -194,6 +202,28 @@ public:
    Matrix<double> arrange_testing_input_data(void) const;
    Matrix<double> arrange_testing_target_data(void) const;
 
+   const Matrix<double>& get_training_input_data(void) const;
+   const Matrix<double>& get_training_target_data(void) const;
+   const Matrix<double>& get_selection_input_data(void) const;
+   const Matrix<double>& get_selection_target_data(void) const;
+   const Matrix<double>& get_testing_input_data(void) const;
+   const Matrix<double>& get_testing_target_data(void) const;
+
+   bool has_split_data(const Instances::Use&) const;
+
+   void arrange_instances_data(const Vector<size_t>&, const size_t&, const size_t&, const Vector<size_t>&, Matrix<double>&) const;
+
+   // Out-of-core methods
+
+   bool is_out_of_core(void) const;
+
+   const size_t& get_chunk_instances_number(void) const;
+   const size_t& get_maximum_cached_chunks_number(void) const;
+
+   size_t count_chunks_number(void) const;
+
+   Matrix<double> get_data_chunk(const size_t&) const;
+
    // Instance methods
 
    Vector<double> get_instance(const size_t&) const;
@@ -266,6 +296,7 @@ public:
    void subtract_variable(const size_t&);
 
    Vector<size_t> unuse_constant_variables(void);
+   Vector< Vector<size_t> > calculate_repeated_instances_groups(void) const;
    Vector<size_t> unuse_repeated_instances(void);
 
    Vector<size_t> unuse_non_significant_inputs(void);
@@ -406,11 +437,13 @@ public:
 
    // Outlier detection
 
+   KdTree<double> build_instances_kd_tree(void) const;
+
    Matrix<double> calculate_instances_distances(const size_t&) const;
-   Matrix<size_t> calculate_nearest_neighbors(const Matrix<double>&, const size_t&) const;
-   Vector<double> calculate_k_distances(const Matrix<double>&, const size_t&) const;
-   Matrix<double> calculate_reachability_distances(const Matrix<double>&, const Vector<double>&) const;
-   Vector<double> calculate_reachability_density(const Matrix<double>&, const size_t&) const;
+   Matrix<size_t> calculate_nearest_neighbors(const size_t&) const;
+   Vector<double> calculate_k_distances(const Matrix<double>&) const;
+   Matrix<double> calculate_reachability_distances(const Matrix<size_t>&, const Matrix<double>&) const;
+   Vector<double> calculate_reachability_density(const Matrix<double>&) const;
    Vector<double> calculate_local_outlier_factor(const size_t& = 5) const;
 
    Vector<size_t> clean_local_outlier_factor(const size_t& = 5);
@@ -451,6 +484,7 @@ public:
    void print_data_preview(void) const;
 
    void save_data(void) const;
+   void save_data_binary(void) const;
 
    bool has_data(void) const;
 
@@ -460,6 +494,8 @@ public:
    void load_data_binary(void);
    void load_time_series_data_binary(void);
 
+   void load_data_out_of_core(const size_t&, const size_t&);
+
    Vector<std::string> arrange_time_series_names(const Vector<std::string>&) const;
 
    Vector<std::string> arrange_association_names(const Vector<std::string>&) const;
@@ -503,6 +539,253 @@ public:
 
 private:
 
+   // STRUCTURES
+
+   ///
+   /// This structure contains the input and target data of the training, selection or testing instances,
+   /// together with the instances and variables versions they were arranged with.
+   ///
+
+   struct SplitData
+   {
+      /// Default constructor.
+
+      SplitData(void)
+      {
+         instances_version = 0;
+         variables_version = 0;
+
+         arranged = false;
+      }
+
+      /// Input data of the instances.
+      /// The number of rows is the number of instances, and the number of columns is the number of input variables.
+
+      Matrix<double> inputs;
+
+      /// Target data of the instances.
+      /// The number of rows is the number of instances, and the number of columns is the number of target variables.
+
+      Matrix<double> targets;
+
+      /// Version of the instances object when the data was arranged.
+
+      size_t instances_version;
+
+      /// Version of the variables object when the data was arranged.
+
+      size_t variables_version;
+
+      /// True if the data has been arranged and the data matrix has not changed since then, false otherwise.
+
+      bool arranged;
+   };
+
+   ///
+   /// This structure gives access to the contents of the data file as a contiguous array of characters.
+   /// The file is memory mapped where the system supports it, and read with a single call otherwise.
+   ///
+
+   struct DataFileMapping
+   {
+      explicit DataFileMapping(const std::string&);
+
+      ~DataFileMapping(void);
+
+      /// Pointer to the first character of the data file.
+
+      const char* begin;
+
+      /// Pointer past the last character of the data file.
+
+      const char* end;
+
+   private:
+
+      DataFileMapping(const DataFileMapping&);
+
+      DataFileMapping& operator = (const DataFileMapping&);
+
+      /// Address of the memory mapping, or NULL if the file has been read into the buffer.
+
+      void* mapping;
+
+      /// Size of the memory mapping.
+
+      size_t mapping_size;
+
+      /// Contents of the data file when it cannot be memory mapped.
+
+      std::string buffer;
+   };
+
+   ///
+   /// This structure contains a line-aligned chunk of the data file, together with the information
+   /// gathered from it when the data file is parsed in parallel.
+   ///
+
+   struct DataFileChunk
+   {
+      /// Default constructor.
+
+      DataFileChunk(void)
+      {
+         begin = NULL;
+         end = NULL;
+
+         instances_number = 0;
+         first_instance_index = 0;
+      }
+
+      /// Pointer to the first character of the chunk.
+
+      const char* begin;
+
+      /// Pointer past the last character of the chunk.
+
+      const char* end;
+
+      /// Number of non empty lines in the chunk.
+
+      size_t instances_number;
+
+      /// Index in the data matrix of the first instance in the chunk.
+
+      size_t first_instance_index;
+
+      /// Nominal labels found in each column of the chunk, in order of appearance.
+
+      Vector< Vector<std::string> > nominal_labels;
+
+      /// Instance indices of the missing values found in the chunk.
+
+      Vector<size_t> missing_instances_indices;
+
+      /// Variable indices of the missing values found in the chunk.
+
+      Vector<size_t> missing_variables_indices;
+
+      /// Error found when parsing the chunk, or empty string if there was none.
+
+      std::string error_message;
+   };
+
+   ///
+   /// This structure is the header of a binary data file.
+   /// It is followed by the variables and instances XML, the data matrix in column-major order aligned to 64 bytes,
+   /// and a column-major bitmap of the missing values.
+   ///
+
+   struct BinaryDataFileHeader
+   {
+      /// Identifier of the file format, "OPENNNDS".
+
+      char magic[8];
+
+      /// Version of the file format.
+
+      uint64_t version;
+
+      /// Byte order mark, written as 0x0102030405060708 in the byte order of the writer.
+
+      uint64_t byte_order;
+
+      /// Number of instances.
+
+      uint64_t instances_number;
+
+      /// Number of variables.
+
+      uint64_t variables_number;
+
+      /// Offset of the variables XML from the beginning of the file.
+
+      uint64_t variables_offset;
+
+      /// Size in bytes of the variables XML.
+
+      uint64_t variables_size;
+
+      /// Offset of the instances XML from the beginning of the file.
+
+      uint64_t instances_offset;
+
+      /// Size in bytes of the instances XML.
+
+      uint64_t instances_size;
+
+      /// Offset of the data matrix from the beginning of the file.
+
+      uint64_t data_offset;
+
+      /// Offset of the missing values bitmap from the beginning of the file.
+
+      uint64_t missing_values_offset;
+
+      /// Size in bytes of the missing values bitmap.
+
+      uint64_t missing_values_size;
+   };
+
+   ///
+   /// This structure contains the state of the out-of-core mode, in which the data matrix is not kept in memory.
+   /// The instances are read by chunks from a binary data file, and the most recently used chunks are cached.
+   ///
+
+   struct OutOfCoreData
+   {
+      /// Default constructor.
+
+      OutOfCoreData(void)
+      {
+         data_file_pointer = NULL;
+
+         data_offset = 0;
+
+         chunk_instances_number = 0;
+         maximum_cached_chunks_number = 0;
+
+         chunks_uses_count = 0;
+      }
+
+      /// Binary data file, or NULL if the data set is not in out-of-core mode.
+
+      DataFileMapping* data_file_pointer;
+
+      /// Offset of the data matrix from the beginning of the binary data file.
+
+      size_t data_offset;
+
+      /// Number of instances in each chunk.
+
+      size_t chunk_instances_number;
+
+      /// Maximum number of chunks kept in memory.
+
+      size_t maximum_cached_chunks_number;
+
+      /// Values taken by 0 and 1 in each variable after the scaling of the data set.
+      /// The chunks are scaled with them when they are read.
+
+      Matrix<double> scaling;
+
+      /// Chunks kept in memory.
+
+      Vector< Matrix<double> > cached_chunks;
+
+      /// Indices of the chunks kept in memory.
+
+      Vector<size_t> cached_chunks_indices;
+
+      /// Last use of each chunk kept in memory, for the least recently used replacement.
+
+      Vector<size_t> cached_chunks_uses;
+
+      /// Number of chunk uses.
+
+      size_t chunks_uses_count;
+   };
+
    // MEMBERS
 
    /// File type.
@@ -593,8 +876,58 @@ private:
    
    bool display;
 
+   /// Input and target data of the training instances, arranged on demand from the data matrix.
+
+   mutable SplitData training_split_data;
+
+   /// Input and target data of the selection instances, arranged on demand from the data matrix.
+
+   mutable SplitData selection_split_data;
+
+   /// Input and target data of the testing instances, arranged on demand from the data matrix.
+
+   mutable SplitData testing_split_data;
+
+   /// Chunked data of the out-of-core mode.
+
+   mutable OutOfCoreData out_of_core_data;
+
+   /// Number of modifications of the data matrix.
+   /// Objects which keep quantities calculated from the data compare it with the version they were calculated with.
+
+   size_t data_version;
+
    // METHODS
 
+   const SplitData& get_split_data(const Instances::Use&) const;
+
+   void invalidate_split_data(void);
+
+   const Matrix<double>& get_cached_data_chunk(const size_t&) const;
+
+   Matrix<double>& get_scaled_data(void);
+
+   Vector< Moments<double> > calculate_variables_moments(const Vector<size_t>&, const Vector<size_t>&) const;
+
+   Vector<double> calculate_variables_means(const Vector<size_t>&, const Vector<size_t>&) const;
+
+   Vector< Statistics<double> > calculate_variables_statistics(const Vector<size_t>&, const Vector<size_t>&) const;
+
+   Vector< Vector<double> > calculate_variables_shape_parameters(const Vector<size_t>&, const Vector<size_t>&) const;
+
+   Vector< Vector<double> > calculate_variables_box_plots(const Vector<size_t>&, const Vector<size_t>&) const;
+
+   Vector< Histogram<double> > calculate_variables_histograms(const Vector<size_t>&, const Vector<size_t>&, const size_t&, const bool&) const;
+
+   CrossMoments<double> calculate_variables_cross_moments(const Vector<size_t>&, const Vector<size_t>&, const Vector<size_t>&) const;
+
+   Vector< Vector<size_t> > arrange_sorted_missing_indices(void) const;
+
+   size_t arrange_chunk_instances(const Vector<size_t>&, const Vector< Vector<size_t> >&, size_t&, Vector<size_t>&, Vector< Vector<size_t> >&) const;
+
+   void copy_out_of_core_data(const DataSet&);
+   void close_out_of_core_data(void);
+
    size_t get_column_index(const Vector< Vector<std::string> >&, const size_t) const;
 
    void check_separator(const std::string&) const;
@@ -603,10 +936,22 @@ private:
    void check_header_line(void);
    Vector<std::string> read_header_line(void) const;
 
-   void read_instance(const std::string&, const Vector< Vector<std::string> >&, const size_t&);
+   void split_data_file_line(const char*, const char*, const char&, Vector< std::pair<const char*, const char*> >&) const;
+   bool parse_data_file_number(const char*, const char*, std::string&, double&) const;
+
+   Vector<DataFileChunk> split_data_file(const DataFileMapping&) const;
+
+   void scan_data_file_chunk(DataFileChunk&, const size_t&) const;
+   void read_data_file_chunk(DataFileChunk&, const Vector< Vector<std::string> >&);
+
+   void read_instance(const Vector< std::pair<const char*, const char*> >&, const Vector< Vector<std::string> >&, const size_t&, DataFileChunk&);
+
+   BinaryDataFileHeader load_binary_data_file_information(const DataFileMapping&);
+
+   void load_data_binary(const DataFileMapping&);
 
-   Vector< Vector<std::string> > set_from_data_file(void);
-   void read_from_data_file(const Vector< Vector<std::string> >&);
+   Vector< Vector<std::string> > set_from_data_file(const DataFileMapping&, Vector<DataFileChunk>&);
+   void read_from_data_file(const Vector< Vector<std::string> >&, Vector<DataFileChunk>&);
 
 };
 
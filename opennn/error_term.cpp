@@ -663,6 +663,226 @@ Vector< Vector<double> > ErrorTerm::calculate_layers_delta
 
 
 
+// Vector< Matrix<double> > calculate_layers_delta(const Vector< Matrix<double> >&, const Matrix<double>&) const method
+
+/// Returns the delta matrices of all the layers in the multilayer perceptron for a batch of instances.
+/// Each matrix has one row per instance and one column per neuron in the layer.
+/// @param layers_activation_derivative Forward propagation activation derivatives of the batch.
+/// @param output_gradient Gradient of the outputs objective function. Each row corresponds to one instance.
+
+Vector< Matrix<double> > ErrorTerm::calculate_layers_delta
+(const Vector< Matrix<double> >& layers_activation_derivative,
+ const Matrix<double>& output_gradient) const
+{
+   Vector< Matrix<double> > layers_delta;
+
+   calculate_layers_delta(layers_activation_derivative, output_gradient, layers_delta);
+
+   return(layers_delta);
+}
+
+
+// Vector< Matrix<double> > calculate_layers_delta(const Vector< Matrix<double> >&, const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the delta matrices of all the layers in the multilayer perceptron for a batch of instances,
+/// when boundary conditions are imposed.
+/// @param layers_activation_derivative Forward propagation activation derivatives of the batch.
+/// @param homogeneous_solution Homogeneous solutions for the batch. Each row corresponds to one instance.
+/// @param output_gradient Gradient of the outputs objective function. Each row corresponds to one instance.
+
+Vector< Matrix<double> > ErrorTerm::calculate_layers_delta
+(const Vector< Matrix<double> >& layers_activation_derivative,
+ const Matrix<double>& homogeneous_solution,
+ const Matrix<double>& output_gradient) const
+{
+   return(calculate_layers_delta(layers_activation_derivative, homogeneous_solution*output_gradient));
+}
+
+
+// void calculate_layers_delta(const Vector< Matrix<double> >&, const Matrix<double>&, Vector< Matrix<double> >&) const method
+
+/// Writes the delta matrices of all the layers in the multilayer perceptron for a batch of instances.
+/// The matrices are only reallocated when their size changes, and the synaptic weights of each layer
+/// are read in place from the parameters of the multilayer perceptron.
+/// @param layers_activation_derivative Forward propagation activation derivatives of the batch.
+/// @param output_gradient Gradient of the outputs objective function. Each row corresponds to one instance.
+/// @param layers_delta Vector of matrices where the deltas are written.
+
+void ErrorTerm::calculate_layers_delta
+(const Vector< Matrix<double> >& layers_activation_derivative,
+ const Matrix<double>& output_gradient,
+ Vector< Matrix<double> >& layers_delta) const
+{
+   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+   const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(layers_activation_derivative.size() != layers_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: ErrorTerm class.\n"
+             << "void calculate_layers_delta(const Vector< Matrix<double> >&, const Matrix<double>&, Vector< Matrix<double> >&) const method.\n"
+             << "Size of forward propagation activation derivative vector must be equal to number of layers.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   layers_delta.set(layers_number);
+
+   if(layers_number == 0)
+   {
+      return;
+   }
+
+   // Output layer
+
+   const Matrix<double>& output_activation_derivative = layers_activation_derivative[layers_number-1];
+
+   const size_t rows_number = output_activation_derivative.get_rows_number();
+
+   layers_delta[layers_number-1].set(rows_number, output_activation_derivative.get_columns_number());
+
+   const size_t output_size = output_activation_derivative.size();
+
+   for(size_t k = 0; k < output_size; k++)
+   {
+      layers_delta[layers_number-1][k] = output_activation_derivative[k]*output_gradient[k];
+   }
+
+   // Rest of hidden layers
+
+   for(int i = (int)layers_number-2; i >= 0; i--)
+   {
+      const PerceptronLayer& next_layer = multilayer_perceptron_pointer->get_layer(i+1);
+
+      const size_t next_inputs_number = next_layer.get_inputs_number();
+      const size_t next_perceptrons_number = next_layer.get_perceptrons_number();
+
+      layers_delta[i].set(rows_number, next_inputs_number);
+
+      const Eigen::Map<const Eigen::MatrixXd> next_delta_eigen(layers_delta[i+1].data(), rows_number, next_perceptrons_number);
+
+      const Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<> >
+      synaptic_weights_eigen(next_layer.get_parameters_data() + 1, next_inputs_number, next_perceptrons_number, Eigen::OuterStride<>(next_inputs_number + 1));
+
+      const Eigen::Map<const Eigen::MatrixXd> activation_derivative_eigen(layers_activation_derivative[i].data(), rows_number, next_inputs_number);
+
+      Eigen::Map<Eigen::MatrixXd> delta_eigen(layers_delta[i].data(), rows_number, next_inputs_number);
+
+      delta_eigen.noalias() = next_delta_eigen*synaptic_weights_eigen.transpose();
+
+      delta_eigen.array() *= activation_derivative_eigen.array();
+   }
+}
+
+
+// void calculate_layers_delta(const Vector< Matrix<float> >&, const Matrix<double>&, const Vector<float>&, Vector< Matrix<float> >&) const method
+
+/// Writes in single precision the delta matrices of all the layers in the multilayer perceptron for a batch of instances.
+/// The output gradient is given in double precision, and it is rounded when multiplied by the output activation derivatives.
+/// @param layers_activation_derivative Single precision forward propagation activation derivatives of the batch.
+/// @param output_gradient Gradient of the outputs objective function. Each row corresponds to one instance.
+/// @param parameters Single precision parameters of the multilayer perceptron, from which the synaptic weights are read.
+/// @param layers_delta Vector of matrices where the deltas are written.
+
+void ErrorTerm::calculate_layers_delta
+(const Vector< Matrix<float> >& layers_activation_derivative,
+ const Matrix<double>& output_gradient,
+ const Vector<float>& parameters,
+ Vector< Matrix<float> >& layers_delta) const
+{
+   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+   const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(layers_activation_derivative.size() != layers_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: ErrorTerm class.\n"
+             << "void calculate_layers_delta(const Vector< Matrix<float> >&, const Matrix<double>&, const Vector<float>&, Vector< Matrix<float> >&) const method.\n"
+             << "Size of forward propagation activation derivative vector must be equal to number of layers.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   if(parameters.size() != multilayer_perceptron_pointer->count_parameters_number())
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: ErrorTerm class.\n"
+             << "void calculate_layers_delta(const Vector< Matrix<float> >&, const Matrix<double>&, const Vector<float>&, Vector< Matrix<float> >&) const method.\n"
+             << "Size of parameters must be equal to number of parameters.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   layers_delta.set(layers_number);
+
+   if(layers_number == 0)
+   {
+      return;
+   }
+
+   // Output layer
+
+   const Matrix<float>& output_activation_derivative = layers_activation_derivative[layers_number-1];
+
+   const size_t rows_number = output_activation_derivative.get_rows_number();
+
+   layers_delta[layers_number-1].set(rows_number, output_activation_derivative.get_columns_number());
+
+   const size_t output_size = output_activation_derivative.size();
+
+   for(size_t k = 0; k < output_size; k++)
+   {
+      layers_delta[layers_number-1][k] = (float)(output_activation_derivative[k]*output_gradient[k]);
+   }
+
+   // Rest of hidden layers, walking the parameters backwards from the output layer
+
+   size_t position = parameters.size() - multilayer_perceptron_pointer->get_layer(layers_number-1).count_parameters_number();
+
+   for(int i = (int)layers_number-2; i >= 0; i--)
+   {
+      const PerceptronLayer& next_layer = multilayer_perceptron_pointer->get_layer(i+1);
+
+      const size_t next_inputs_number = next_layer.get_inputs_number();
+      const size_t next_perceptrons_number = next_layer.get_perceptrons_number();
+
+      layers_delta[i].set(rows_number, next_inputs_number);
+
+      const Eigen::Map<const Eigen::MatrixXf> next_delta_eigen(layers_delta[i+1].data(), rows_number, next_perceptrons_number);
+
+      const Eigen::Map<const Eigen::MatrixXf, 0, Eigen::OuterStride<> >
+      synaptic_weights_eigen(parameters.data() + position + 1, next_inputs_number, next_perceptrons_number, Eigen::OuterStride<>(next_inputs_number + 1));
+
+      const Eigen::Map<const Eigen::MatrixXf> activation_derivative_eigen(layers_activation_derivative[i].data(), rows_number, next_inputs_number);
+
+      Eigen::Map<Eigen::MatrixXf> delta_eigen(layers_delta[i].data(), rows_number, next_inputs_number);
+
+      delta_eigen.noalias() = next_delta_eigen*synaptic_weights_eigen.transpose();
+
+      delta_eigen.array() *= activation_derivative_eigen.array();
+
+      position -= multilayer_perceptron_pointer->get_layer(i).count_parameters_number();
+   }
+}
+
+
 // Vector<double> calculate_point_gradient(const Vector<double>&, const Vector< Vector<double> >&, const Vector<double>&) const method
 
 /// Returns the gradient of the error term function at some input point.
@@ -909,6 +1129,207 @@ Vector<double> ErrorTerm::calculate_point_gradient
    return(point_gradient);
 }
 
+
+// Vector<double> calculate_batch_gradient(const Matrix<double>&, const Vector< Matrix<double> >&, const Vector< Matrix<double> >&) const method
+
+/// Returns the gradient of the error term summed over a batch of instances.
+/// @param inputs Matrix of inputs to the multilayer perceptron. Each row contains one instance.
+/// @param layers_activation Activations of all layers for the batch.
+/// @param layers_delta Delta matrices of all layers for the batch.
+
+Vector<double> ErrorTerm::calculate_batch_gradient
+(const Matrix<double>& inputs,
+ const Vector< Matrix<double> >& layers_activation,
+ const Vector< Matrix<double> >& layers_delta) const
+{
+   const size_t parameters_number = neural_network_pointer->get_multilayer_perceptron_pointer()->count_parameters_number();
+
+   Vector<double> batch_gradient(parameters_number, 0.0);
+
+   calculate_batch_gradient(inputs, layers_activation, layers_delta, batch_gradient);
+
+   return(batch_gradient);
+}
+
+
+// void calculate_batch_gradient(const Matrix<double>&, const Vector< Matrix<double> >&, const Vector< Matrix<double> >&, Vector<double>&) const method
+
+/// Adds the gradient of the error term over a batch of instances to a given vector,
+/// so that the contributions of several batches can be accumulated without temporary vectors.
+/// The synaptic weights derivatives of each layer are obtained with a single product between
+/// the transposed layer inputs and the layer deltas, and the biases derivatives are the column sums of the deltas.
+/// @param inputs Matrix of inputs to the multilayer perceptron. Each row contains one instance.
+/// @param layers_activation Activations of all layers for the batch.
+/// @param layers_delta Delta matrices of all layers for the batch.
+/// @param gradient Gradient vector where the contribution of the batch is added.
+
+void ErrorTerm::calculate_batch_gradient
+(const Matrix<double>& inputs,
+ const Vector< Matrix<double> >& layers_activation,
+ const Vector< Matrix<double> >& layers_delta,
+ Vector<double>& gradient) const
+{
+   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+   const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   const size_t parameters_number = multilayer_perceptron_pointer->count_parameters_number();
+
+   if(gradient.size() != parameters_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: ErrorTerm class.\n"
+             << "void calculate_batch_gradient(const Matrix<double>&, const Vector< Matrix<double> >&, const Vector< Matrix<double> >&, Vector<double>&) const method.\n"
+             << "Size of gradient (" << gradient.size() << ") must be equal to number of parameters (" << parameters_number << ").\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   size_t index = 0;
+
+   for(size_t i = 0; i < layers_number; i++)
+   {
+      const Matrix<double>& layer_inputs = (i == 0) ? inputs : layers_activation[i-1];
+
+      const Matrix<double>& layer_delta = layers_delta[i];
+
+      const size_t rows_number = layer_delta.get_rows_number();
+      const size_t perceptrons_number = layer_delta.get_columns_number();
+      const size_t layer_inputs_number = layer_inputs.get_columns_number();
+
+      const size_t perceptron_parameters_number = 1 + layer_inputs_number;
+
+      // Synaptic weights derivatives, written in place between the biases
+
+      if(layer_inputs_number != 0)
+      {
+         const Eigen::Map<const Eigen::MatrixXd> layer_inputs_eigen(layer_inputs.data(), rows_number, layer_inputs_number);
+
+         const Eigen::Map<const Eigen::MatrixXd> layer_delta_eigen(layer_delta.data(), rows_number, perceptrons_number);
+
+         Eigen::Map<Eigen::MatrixXd, 0, Eigen::OuterStride<> >
+         synaptic_weights_derivatives_eigen(gradient.data() + index + 1, layer_inputs_number, perceptrons_number, Eigen::OuterStride<>(perceptron_parameters_number));
+
+         synaptic_weights_derivatives_eigen.noalias() += layer_inputs_eigen.transpose()*layer_delta_eigen;
+      }
+
+      // Biases derivatives
+
+      for(size_t j = 0; j < perceptrons_number; j++)
+      {
+         const double* delta_column = layer_delta.data() + j*rows_number;
+
+         gradient[index + j*perceptron_parameters_number] += std::accumulate(delta_column, delta_column + rows_number, 0.0);
+      }
+
+      index += perceptrons_number*perceptron_parameters_number;
+   }
+}
+
+
+// void calculate_batch_gradient(const Matrix<float>&, const Vector< Matrix<float> >&, const Vector< Matrix<float> >&, Matrix<float>&, Vector<double>&) const method
+
+/// Adds the gradient of the error term over a batch of instances, back-propagated in single precision,
+/// to a double precision vector.
+/// The synaptic weights derivatives of each layer are obtained with a single precision matrix product,
+/// and then accumulated in double precision, as are the column sums of the deltas for the biases.
+/// @param inputs Single precision matrix of inputs to the multilayer perceptron. Each row contains one instance.
+/// @param layers_activation Single precision activations of all layers for the batch.
+/// @param layers_delta Single precision delta matrices of all layers for the batch.
+/// @param synaptic_weights_derivatives Scratch matrix for the synaptic weights derivatives of one layer.
+/// @param gradient Gradient vector where the contribution of the batch is added.
+
+void ErrorTerm::calculate_batch_gradient
+(const Matrix<float>& inputs,
+ const Vector< Matrix<float> >& layers_activation,
+ const Vector< Matrix<float> >& layers_delta,
+ Matrix<float>& synaptic_weights_derivatives,
+ Vector<double>& gradient) const
+{
+   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+   const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   const size_t parameters_number = multilayer_perceptron_pointer->count_parameters_number();
+
+   if(gradient.size() != parameters_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: ErrorTerm class.\n"
+             << "void calculate_batch_gradient(const Matrix<float>&, const Vector< Matrix<float> >&, const Vector< Matrix<float> >&, Matrix<float>&, Vector<double>&) const method.\n"
+             << "Size of gradient (" << gradient.size() << ") must be equal to number of parameters (" << parameters_number << ").\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   size_t index = 0;
+
+   for(size_t i = 0; i < layers_number; i++)
+   {
+      const Matrix<float>& layer_inputs = (i == 0) ? inputs : layers_activation[i-1];
+
+      const Matrix<float>& layer_delta = layers_delta[i];
+
+      const size_t rows_number = layer_delta.get_rows_number();
+      const size_t perceptrons_number = layer_delta.get_columns_number();
+      const size_t layer_inputs_number = layer_inputs.get_columns_number();
+
+      const size_t perceptron_parameters_number = 1 + layer_inputs_number;
+
+      // Synaptic weights derivatives
+
+      if(layer_inputs_number != 0)
+      {
+         synaptic_weights_derivatives.set(layer_inputs_number, perceptrons_number);
+
+         const Eigen::Map<const Eigen::MatrixXf> layer_inputs_eigen(layer_inputs.data(), rows_number, layer_inputs_number);
+
+         const Eigen::Map<const Eigen::MatrixXf> layer_delta_eigen(layer_delta.data(), rows_number, perceptrons_number);
+
+         Eigen::Map<Eigen::MatrixXf> synaptic_weights_derivatives_eigen(synaptic_weights_derivatives.data(), layer_inputs_number, perceptrons_number);
+
+         synaptic_weights_derivatives_eigen.noalias() = layer_inputs_eigen.transpose()*layer_delta_eigen;
+
+         for(size_t j = 0; j < perceptrons_number; j++)
+         {
+            const float* derivatives_column = synaptic_weights_derivatives.data() + j*layer_inputs_number;
+
+            double* gradient_column = gradient.data() + index + j*perceptron_parameters_number + 1;
+
+            for(size_t k = 0; k < layer_inputs_number; k++)
+            {
+               gradient_column[k] += derivatives_column[k];
+            }
+         }
+      }
+
+      // Biases derivatives
+
+      for(size_t j = 0; j < perceptrons_number; j++)
+      {
+         const float* delta_column = layer_delta.data() + j*rows_number;
+
+         gradient[index + j*perceptron_parameters_number] += std::accumulate(delta_column, delta_column + rows_number, 0.0);
+      }
+
+      index += perceptrons_number*perceptron_parameters_number;
+   }
+}
+
 /// @todo
 
 double ErrorTerm::calculate_loss_output_combinations(const Vector<double>& combinations) const
@@ -1637,10 +2058,33 @@ Matrix<double> ErrorTerm::calculate_single_hidden_layer_point_Hessian
     return single_hidden_layer_point_Hessian;
 }
 
+// Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the gradient of the error term with respect to the outputs, for a batch of instances.
+/// By default it evaluates the single instance output gradient row by row.
+/// Error terms with a closed form expression for the whole batch should override this method.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
+
+Matrix<double> ErrorTerm::calculate_output_gradient(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    const size_t rows_number = outputs.get_rows_number();
+
+    Matrix<double> output_gradient(rows_number, outputs.get_columns_number());
+
+    for(size_t i = 0; i < rows_number; i++)
+    {
+        output_gradient.set_row(i, calculate_output_gradient(outputs.arrange_row(i), targets.arrange_row(i)));
+    }
+
+    return(output_gradient);
+}
+
+
 // Vector<double> calculate_gradient(void) const method
 
 /// Returns the default gradient vector of the error term.
-/// It uses numerical differentiation.
+/// It uses the back-propagation method on all the training instances.
 
 Vector<double> ErrorTerm::calculate_gradient(void) const
 {
@@ -1650,104 +2094,558 @@ Vector<double> ErrorTerm::calculate_gradient(void) const
 
     #endif
 
-    // Neural network stuff
-
-    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+    const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-    // Neural network stuff
+    return(ErrorTerm::calculate_batch_gradient(training_indices));
+}
 
-    const bool has_conditions_layer = neural_network_pointer->has_conditions_layer();
 
-    const ConditionsLayer* conditions_layer_pointer = has_conditions_layer ? neural_network_pointer->get_conditions_layer_pointer() : NULL;
+// Vector<double> calculate_batch_gradient(const Vector<size_t>&) const method
 
-    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
+/// Returns the contribution of a subset of instances to the gradient of the error term.
+/// It uses the back-propagation method on blocks of those instances.
+/// When the library is built with __OPENNN_SINGLE_PRECISION__, the blocks are back-propagated in single precision.
+/// The normalization of the error term is not changed, so that the gradients of a partition
+/// of the training instances add up to the gradient of the error term.
+/// Error terms with a normalization applied after the back-propagation must override this method.
+/// @param instances_indices Indices of the instances in the data set.
+
+Vector<double> ErrorTerm::calculate_batch_gradient(const Vector<size_t>& instances_indices) const
+{
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    return(back_propagate(instances_indices, false).gradient);
+}
+
+
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the contribution of a batch of instances to the error term, from their outputs and targets.
+/// It must have the same normalization as the output gradient of the batch,
+/// so that the contributions of a partition of the training instances add up to the error.
+/// Error terms which are a sum over instances override this method,
+/// which allows to compute the error in the same pass over the data as the gradient.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
+
+double ErrorTerm::calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const
+{
+    std::ostringstream buffer;
+
+    buffer << "OpenNN Exception: ErrorTerm class.\n"
+           << "double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method.\n"
+           << "The error of a batch is not defined for this error term.\n";
+
+    throw std::logic_error(buffer.str());
+}
+
+
+// FirstOrderPerformance calculate_first_order_loss(void) const method
+
+/// Returns the error and the gradient of the error term on the training instances.
+/// By default they are calculated separately.
+/// Error terms which implement calculate_batch_error override this method to obtain both from a single pass
+/// over the training instances.
+
+ErrorTerm::FirstOrderPerformance ErrorTerm::calculate_first_order_loss(void) const
+{
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    FirstOrderPerformance first_order_loss;
+
+    first_order_loss.loss = calculate_error();
+    first_order_loss.gradient = calculate_gradient();
+
+    return(first_order_loss);
+}
+
+
+// FirstOrderPerformance calculate_batch_first_order_loss(const Vector<size_t>&) const method
+
+/// Returns the contribution of a subset of instances to the error and to the gradient of the error term,
+/// both computed from the same forward propagation of the instances.
+/// The error term must implement calculate_batch_error.
+/// @param instances_indices Indices of the instances in the data set.
+
+ErrorTerm::FirstOrderPerformance ErrorTerm::calculate_batch_first_order_loss(const Vector<size_t>& instances_indices) const
+{
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    return(back_propagate(instances_indices, true));
+}
+
+
+// DataSetState get_data_set_state(void) const method
+
+/// Returns the current state of the data set associated to this error term.
+/// Constants calculated from the data set are valid while this state does not change.
+
+ErrorTerm::DataSetState ErrorTerm::get_data_set_state(void) const
+{
+    DataSetState data_set_state;
+
+    data_set_state.data_set_pointer = data_set_pointer;
+
+    if(data_set_pointer)
+    {
+        data_set_state.instances_version = data_set_pointer->get_instances().get_version();
+        data_set_state.variables_version = data_set_pointer->get_variables().get_version();
+        data_set_state.data_version = data_set_pointer->get_data_version();
+    }
+
+    return(data_set_state);
+}
+
+
+// FirstOrderPerformance back_propagate(const Vector<size_t>&, const bool&) const method
+
+/// Back-propagates blocks of a subset of instances, and returns their contribution to the gradient of the error term.
+/// Every block is forward propagated as a matrix, and its contribution to the gradient is obtained with
+/// one matrix product per layer.
+/// Each thread owns a back-propagation workspace, sized once from the architecture,
+/// so that no memory is allocated from block to block.
+/// When the library is built with __OPENNN_SINGLE_PRECISION__, the blocks are back-propagated in single precision.
+/// @param instances_indices Indices of the instances in the data set.
+/// @param error_needed True if the contribution of the blocks to the error is also computed, from the outputs of the forward propagation.
+/// Otherwise the loss member of the result is zero.
+
+ErrorTerm::FirstOrderPerformance ErrorTerm::back_propagate(const Vector<size_t>& instances_indices, const bool& error_needed) const
+{
+    #ifdef __OPENNN_SINGLE_PRECISION__
+
+    return(back_propagate_single_precision(instances_indices, error_needed));
+
+    #else
+
+    // Neural network stuff
+
+    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+    const bool has_conditions_layer = neural_network_pointer->has_conditions_layer();
+
+    const ConditionsLayer* conditions_layer_pointer = has_conditions_layer ? neural_network_pointer->get_conditions_layer_pointer() : NULL;
+
+    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
 
     const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
 
     const size_t neural_parameters_number = multilayer_perceptron_pointer->count_parameters_number();
 
-    Vector< Vector< Vector<double> > > first_order_forward_propagation(2);
+    // Data set stuff
 
-    Vector<double> particular_solution;
-    Vector<double> homogeneous_solution;
+    const size_t instances_number = instances_indices.size();
 
-    // Data set stuff
+    const Variables& variables = data_set_pointer->get_variables();
 
-    const Instances& instances = data_set_pointer->get_instances();
+    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
+    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-    const size_t training_instances_number = instances.count_training_instances_number();
+    // Batches stuff
 
-    const Vector<size_t> training_indices = instances.arrange_training_indices();
+    const size_t batch_size = 256;
 
-    size_t training_index;
+    const size_t batches_number = (instances_number + batch_size - 1)/batch_size;
+
+    // Error term stuff
+
+    FirstOrderPerformance first_order_loss;
+
+    first_order_loss.loss = 0.0;
+    first_order_loss.gradient.set(neural_parameters_number, 0.0);
+
+    if(layers_number == 0 || instances_number == 0)
+    {
+        return(first_order_loss);
+    }
+
+    double error = 0.0;
+
+    #pragma omp parallel reduction(+ : error)
+    {
+        BackPropagationWorkspace<double> workspace(*multilayer_perceptron_pointer, std::min(batch_size, instances_number));
+
+        const Vector< Matrix<double> >& layers_activation = workspace.forward_propagation.layers_activation;
+        const Vector< Matrix<double> >& layers_activation_derivative = workspace.forward_propagation.layers_activation_derivative;
+
+        Matrix<double> particular_solution;
+        Matrix<double> homogeneous_solution;
+
+        int i;
+
+        #pragma omp for
+
+        for(i = 0; i < (int)batches_number; i++)
+        {
+            const size_t first_index = i*batch_size;
+            const size_t batch_instances_number = std::min(batch_size, instances_number - first_index);
+
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, inputs_indices, workspace.inputs);
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, targets_indices, workspace.targets);
+
+            multilayer_perceptron_pointer->calculate_first_order_forward_propagation(workspace.inputs, workspace.forward_propagation);
+
+            if(error_needed)
+            {
+                error += calculate_batch_error(layers_activation[layers_number-1], workspace.targets);
+            }
+
+            if(!has_conditions_layer)
+            {
+                workspace.output_gradient = calculate_output_gradient(layers_activation[layers_number-1], workspace.targets);
+
+                calculate_layers_delta(layers_activation_derivative, workspace.output_gradient, workspace.layers_delta);
+            }
+            else
+            {
+                particular_solution.set(batch_instances_number, outputs_number);
+                homogeneous_solution.set(batch_instances_number, outputs_number);
+
+                for(size_t j = 0; j < batch_instances_number; j++)
+                {
+                    particular_solution.set_row(j, conditions_layer_pointer->calculate_particular_solution(workspace.inputs.arrange_row(j)));
+                    homogeneous_solution.set_row(j, conditions_layer_pointer->calculate_homogeneous_solution(workspace.inputs.arrange_row(j)));
+                }
+
+                workspace.output_gradient = (particular_solution+homogeneous_solution*layers_activation[layers_number-1] - workspace.targets)*2.0;
+
+                calculate_layers_delta(layers_activation_derivative, homogeneous_solution*workspace.output_gradient, workspace.layers_delta);
+            }
+
+            calculate_batch_gradient(workspace.inputs, layers_activation, workspace.layers_delta, workspace.gradient);
+        }
+
+        #pragma omp critical
+        first_order_loss.gradient += workspace.gradient;
+    }
+
+    first_order_loss.loss = error;
+
+    return(first_order_loss);
+
+    #endif
+}
+
+
+// Vector<double> calculate_single_precision_gradient(void) const method
+
+/// Returns the gradient vector of the error term, back-propagated in single precision on all the training instances.
+
+Vector<double> ErrorTerm::calculate_single_precision_gradient(void) const
+{
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
+
+    return(calculate_single_precision_batch_gradient(training_indices));
+}
+
+
+// Vector<double> calculate_single_precision_batch_gradient(const Vector<size_t>&) const method
+
+/// Returns the contribution of a subset of instances to the gradient of the error term, back-propagated in single precision.
+/// The blocks are gathered, forward propagated and back-propagated as in calculate_batch_gradient,
+/// but with single precision inputs, parameters, activations and deltas,
+/// which halves the memory traffic of the matrix products.
+/// The output gradient and the accumulation of the block contributions are computed in double precision,
+/// so that the rounding error does not grow with the number of instances.
+/// @param instances_indices Indices of the instances in the data set.
+
+Vector<double> ErrorTerm::calculate_single_precision_batch_gradient(const Vector<size_t>& instances_indices) const
+{
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    return(back_propagate_single_precision(instances_indices, false).gradient);
+}
+
+
+// FirstOrderPerformance back_propagate_single_precision(const Vector<size_t>&, const bool&) const method
+
+/// Back-propagates blocks of a subset of instances in single precision,
+/// and returns their contribution to the gradient of the error term.
+/// The error of the blocks, if needed, is computed in double precision from the single precision outputs.
+/// @param instances_indices Indices of the instances in the data set.
+/// @param error_needed True if the contribution of the blocks to the error is also computed.
+
+ErrorTerm::FirstOrderPerformance ErrorTerm::back_propagate_single_precision(const Vector<size_t>& instances_indices, const bool& error_needed) const
+{
+    // Neural network stuff
+
+    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+    const bool has_conditions_layer = neural_network_pointer->has_conditions_layer();
+
+    const ConditionsLayer* conditions_layer_pointer = has_conditions_layer ? neural_network_pointer->get_conditions_layer_pointer() : NULL;
+
+    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
+    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
+
+    const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
+
+    const size_t neural_parameters_number = multilayer_perceptron_pointer->count_parameters_number();
+
+    const Vector<float> parameters = multilayer_perceptron_pointer->arrange_single_precision_parameters();
+
+    // Data set stuff
+
+    const size_t instances_number = instances_indices.size();
 
     const Variables& variables = data_set_pointer->get_variables();
 
     const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
     const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-    Vector<double> inputs(inputs_number);
-    Vector<double> targets(outputs_number);
+    // Batches stuff
 
-    // Sum squared error stuff
+    const size_t batch_size = 256;
 
-    Vector<double> output_gradient(outputs_number);
+    const size_t batches_number = (instances_number + batch_size - 1)/batch_size;
 
-    Vector< Matrix<double> > layers_combination_parameters_Jacobian;
+    // Error term stuff
 
-    Vector< Vector<double> > layers_inputs(layers_number);
-    Vector< Vector<double> > layers_delta;
+    FirstOrderPerformance first_order_loss;
 
-    Vector<double> point_gradient(neural_parameters_number, 0.0);
+    first_order_loss.loss = 0.0;
+    first_order_loss.gradient.set(neural_parameters_number, 0.0);
 
-    Vector<double> gradient(neural_parameters_number, 0.0);
-
-    int i;
+    if(layers_number == 0 || instances_number == 0)
+    {
+        return(first_order_loss);
+    }
 
-    #pragma omp parallel for private(i, training_index, inputs, targets, first_order_forward_propagation, layers_inputs, layers_combination_parameters_Jacobian,\
-     output_gradient, layers_delta, particular_solution, homogeneous_solution, point_gradient)
+    double error = 0.0;
 
-    for(i = 0; i < (int)training_instances_number; i++)
+    #pragma omp parallel reduction(+ : error)
     {
-        training_index = training_indices[i];
+        BackPropagationWorkspace<float> workspace(*multilayer_perceptron_pointer, std::min(batch_size, instances_number));
 
-       inputs = data_set_pointer->get_instance(training_index, inputs_indices);
+        const Vector< Matrix<float> >& layers_activation = workspace.forward_propagation.layers_activation;
+        const Vector< Matrix<float> >& layers_activation_derivative = workspace.forward_propagation.layers_activation_derivative;
 
-       targets = data_set_pointer->get_instance(training_index, targets_indices);
+        Matrix<double> inputs;
+
+        Matrix<double> particular_solution;
+        Matrix<double> homogeneous_solution;
 
-       first_order_forward_propagation = multilayer_perceptron_pointer->calculate_first_order_forward_propagation(inputs);
+        int i;
 
-       const Vector< Vector<double> >& layers_activation = first_order_forward_propagation[0];
-       const Vector< Vector<double> >& layers_activation_derivative = first_order_forward_propagation[1];
+        #pragma omp for
 
-       layers_inputs = multilayer_perceptron_pointer->arrange_layers_input(inputs, layers_activation);
+        for(i = 0; i < (int)batches_number; i++)
+        {
+            const size_t first_index = i*batch_size;
+            const size_t batch_instances_number = std::min(batch_size, instances_number - first_index);
 
-       layers_combination_parameters_Jacobian = multilayer_perceptron_pointer->calculate_layers_combination_parameters_Jacobian(layers_inputs);
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, inputs_indices, inputs);
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, targets_indices, workspace.targets);
 
-       if(!has_conditions_layer)
-       {
-           output_gradient = calculate_output_gradient(layers_activation[layers_number-1], targets);
+            workspace.inputs.set(batch_instances_number, inputs_number);
 
-           layers_delta = calculate_layers_delta(layers_activation_derivative, output_gradient);
-       }
-       else
-       {
-          particular_solution = conditions_layer_pointer->calculate_particular_solution(inputs);
-          homogeneous_solution = conditions_layer_pointer->calculate_homogeneous_solution(inputs);
+            std::copy(inputs.begin(), inputs.end(), workspace.inputs.begin());
 
-          output_gradient = (particular_solution+homogeneous_solution*layers_activation[layers_number-1] - targets)*2.0;
+            multilayer_perceptron_pointer->calculate_first_order_forward_propagation(workspace.inputs, parameters, workspace.forward_propagation);
 
-          layers_delta = calculate_layers_delta(layers_activation_derivative, homogeneous_solution, output_gradient);
-       }
+            const Matrix<float>& outputs = layers_activation[layers_number-1];
 
-       point_gradient = calculate_point_gradient(layers_combination_parameters_Jacobian, layers_delta);
+            workspace.outputs.set(batch_instances_number, outputs_number);
+
+            std::copy(outputs.begin(), outputs.end(), workspace.outputs.begin());
+
+            if(error_needed)
+            {
+                error += calculate_batch_error(workspace.outputs, workspace.targets);
+            }
+
+            if(!has_conditions_layer)
+            {
+                workspace.output_gradient = calculate_output_gradient(workspace.outputs, workspace.targets);
+
+                calculate_layers_delta(layers_activation_derivative, workspace.output_gradient, parameters, workspace.layers_delta);
+            }
+            else
+            {
+                particular_solution.set(batch_instances_number, outputs_number);
+                homogeneous_solution.set(batch_instances_number, outputs_number);
 
-       #pragma omp critical
-       gradient += point_gradient;
+                for(size_t j = 0; j < batch_instances_number; j++)
+                {
+                    const Vector<double> instance_inputs = inputs.arrange_row(j);
+
+                    particular_solution.set_row(j, conditions_layer_pointer->calculate_particular_solution(instance_inputs));
+                    homogeneous_solution.set_row(j, conditions_layer_pointer->calculate_homogeneous_solution(instance_inputs));
+                }
+
+                workspace.output_gradient = (particular_solution+homogeneous_solution*workspace.outputs - workspace.targets)*2.0;
+
+                calculate_layers_delta(layers_activation_derivative, homogeneous_solution*workspace.output_gradient, parameters, workspace.layers_delta);
+            }
+
+            calculate_batch_gradient(workspace.inputs, layers_activation, workspace.layers_delta, workspace.synaptic_weights_derivatives, workspace.gradient);
+        }
+
+        #pragma omp critical
+        first_order_loss.gradient += workspace.gradient;
     }
 
-    return(gradient);
+    first_order_loss.loss = error;
+
+    return(first_order_loss);
+}
+
+
+// double calculate_instances_error(const Vector<size_t>&, const Vector<double>&) const method
+
+/// Returns the contribution of a subset of instances to the error term for a vector of parameters,
+/// as the sum of calculate_batch_error over blocks of instances.
+/// The blocks are arranged directly from the data set, so that the inputs and targets of the whole subset
+/// are never held in memory. This is how the error is evaluated when the data set is out of core.
+/// The error term must implement calculate_batch_error.
+/// @param instances_indices Indices of the instances in the data set.
+/// @param parameters Vector of parameters for the multilayer perceptron.
+
+double ErrorTerm::calculate_instances_error(const Vector<size_t>& instances_indices, const Vector<double>& parameters) const
+{
+    // Neural network stuff
+
+    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+    // Data set stuff
+
+    const size_t instances_number = instances_indices.size();
+
+    const Variables& variables = data_set_pointer->get_variables();
+
+    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
+    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+
+    // Batches stuff
+
+    const size_t batch_size = 256;
+
+    const size_t batches_number = (instances_number + batch_size - 1)/batch_size;
+
+    // Error term stuff
+
+    double error = 0.0;
+
+    #pragma omp parallel reduction(+ : error)
+    {
+        Matrix<double> inputs;
+        Matrix<double> targets;
+
+        int i;
+
+        #pragma omp for
+
+        for(i = 0; i < (int)batches_number; i++)
+        {
+            const size_t first_index = i*batch_size;
+            const size_t batch_instances_number = std::min(batch_size, instances_number - first_index);
+
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, inputs_indices, inputs);
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, targets_indices, targets);
+
+            const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
+
+            error += calculate_batch_error(outputs, targets);
+        }
+    }
+
+    return(error);
+}
+
+
+// void calculate_instances_outputs(const Vector<size_t>&, const Vector<double>&, Matrix<double>&, Matrix<double>&) const method
+
+/// Calculates the outputs of the multilayer perceptron for a subset of instances and a vector of parameters,
+/// together with the targets of those instances.
+/// The inputs are arranged by blocks of instances, so that only the outputs and the targets of the whole subset are held in memory.
+/// @param instances_indices Indices of the instances in the data set.
+/// @param parameters Vector of parameters for the multilayer perceptron.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of targets. Each row corresponds to one instance.
+
+void ErrorTerm::calculate_instances_outputs(const Vector<size_t>& instances_indices, const Vector<double>& parameters,
+                                            Matrix<double>& outputs, Matrix<double>& targets) const
+{
+    // Neural network stuff
+
+    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
+
+    // Data set stuff
+
+    const size_t instances_number = instances_indices.size();
+
+    const Variables& variables = data_set_pointer->get_variables();
+
+    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
+    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+
+    const size_t targets_number = targets_indices.size();
+
+    // Batches stuff
+
+    const size_t batch_size = 256;
+
+    const size_t batches_number = (instances_number + batch_size - 1)/batch_size;
+
+    outputs.set(instances_number, outputs_number);
+    targets.set(instances_number, targets_number);
+
+    #pragma omp parallel
+    {
+        Matrix<double> batch_inputs;
+        Matrix<double> batch_targets;
+
+        int i;
+
+        #pragma omp for
+
+        for(i = 0; i < (int)batches_number; i++)
+        {
+            const size_t first_index = i*batch_size;
+            const size_t batch_instances_number = std::min(batch_size, instances_number - first_index);
+
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, inputs_indices, batch_inputs);
+            data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, targets_indices, batch_targets);
+
+            const Matrix<double> batch_outputs = multilayer_perceptron_pointer->calculate_outputs(batch_inputs, parameters);
+
+            for(size_t j = 0; j < batch_instances_number; j++)
+            {
+                for(size_t k = 0; k < outputs_number; k++)
+                {
+                    outputs(first_index+j,k) = batch_outputs(j,k);
+                }
+
+                for(size_t k = 0; k < targets_number; k++)
+                {
+                    targets(first_index+j,k) = batch_targets(j,k);
+                }
+            }
+        }
+    }
 }
 
 
@@ -2262,6 +3160,76 @@ size_t ErrorTerm::calculate_Kronecker_delta(const size_t& a, const size_t& b) co
    }
 }
 
+
+// BackPropagationWorkspace structure
+
+/// Default constructor. It creates an empty workspace, which must be set before use.
+
+template <class T>
+ErrorTerm::BackPropagationWorkspace<T>::BackPropagationWorkspace(void)
+{
+}
+
+
+/// Architecture constructor. It allocates a back-propagation workspace for a multilayer perceptron and a batch size.
+/// @param multilayer_perceptron Multilayer perceptron to be back-propagated.
+/// @param batch_instances_number Maximum number of instances in a batch.
+
+template <class T>
+ErrorTerm::BackPropagationWorkspace<T>::BackPropagationWorkspace(const MultilayerPerceptron& multilayer_perceptron, const size_t& batch_instances_number)
+{
+   set(multilayer_perceptron, batch_instances_number);
+}
+
+
+/// Destructor.
+
+template <class T>
+ErrorTerm::BackPropagationWorkspace<T>::~BackPropagationWorkspace(void)
+{
+}
+
+
+/// Sizes all the matrices of the workspace for a multilayer perceptron and a batch size,
+/// and sets the accumulated gradient to zero.
+/// @param multilayer_perceptron Multilayer perceptron to be back-propagated.
+/// @param batch_instances_number Maximum number of instances in a batch.
+
+template <class T>
+void ErrorTerm::BackPropagationWorkspace<T>::set(const MultilayerPerceptron& multilayer_perceptron, const size_t& batch_instances_number)
+{
+   const size_t inputs_number = multilayer_perceptron.get_inputs_number();
+   const size_t outputs_number = multilayer_perceptron.get_outputs_number();
+
+   const size_t layers_number = multilayer_perceptron.get_layers_number();
+
+   const Vector<size_t> layers_perceptrons_number = multilayer_perceptron.arrange_layers_perceptrons_numbers();
+
+   forward_propagation.set(multilayer_perceptron, batch_instances_number);
+
+   layers_delta.set(layers_number);
+
+   gradient.set(multilayer_perceptron.count_parameters_number(), 0.0);
+
+   if(batch_instances_number == 0 || layers_number == 0)
+   {
+      return;
+   }
+
+   inputs.set(batch_instances_number, inputs_number);
+   targets.set(batch_instances_number, outputs_number);
+
+   output_gradient.set(batch_instances_number, outputs_number);
+
+   for(size_t i = 0; i < layers_number; i++)
+   {
+      layers_delta[i].set(batch_instances_number, layers_perceptrons_number[i]);
+   }
+}
+
+template struct ErrorTerm::BackPropagationWorkspace<double>;
+template struct ErrorTerm::BackPropagationWorkspace<float>;
+
 }
 
 
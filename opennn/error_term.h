@@ -155,6 +155,57 @@ public:
    };
 
 
+   /// This structure holds the scratch quantities of the back-propagation of a batch of instances.
+   /// It is sized once from the architecture of the multilayer perceptron,
+   /// and each thread computing the gradient owns one workspace, which it reuses for all its batches.
+   /// It is instantiated for double and float. In single precision the propagation quantities are stored as float,
+   /// while the targets, the output gradient and the accumulated gradient are kept in double precision.
+
+   template <class T>
+   struct BackPropagationWorkspace
+   {
+      explicit BackPropagationWorkspace(void);
+
+      explicit BackPropagationWorkspace(const MultilayerPerceptron&, const size_t&);
+
+      virtual ~BackPropagationWorkspace(void);
+
+      void set(const MultilayerPerceptron&, const size_t&);
+
+      /// Inputs of the batch. Each row contains one instance.
+
+      Matrix<T> inputs;
+
+      /// Targets of the batch. Each row contains one instance.
+
+      Matrix<double> targets;
+
+      /// Forward propagation quantities of the batch.
+
+      MultilayerPerceptron::ForwardPropagationWorkspace<T> forward_propagation;
+
+      /// Outputs of the batch in double precision, used to evaluate the output gradient of a single precision workspace.
+
+      Matrix<double> outputs;
+
+      /// Gradient of the outputs objective function. Each row contains one instance.
+
+      Matrix<double> output_gradient;
+
+      /// Delta matrices of all the layers for the batch.
+
+      Vector< Matrix<T> > layers_delta;
+
+      /// Synaptic weights derivatives of one layer, used to accumulate a single precision product into the gradient.
+
+      Matrix<T> synaptic_weights_derivatives;
+
+      /// Gradient accumulated over all the batches back-propagated with this workspace.
+
+      Vector<double> gradient;
+   };
+
+
    // METHODS
 
    // Get methods
@@ -267,6 +318,12 @@ public:
    Vector< Vector<double> > calculate_layers_delta(const Vector< Vector<double> >&, const Vector<double>&) const;
    Vector< Vector<double> > calculate_layers_delta(const Vector< Vector<double> >&, const Vector<double>&, const Vector<double>&) const;   
 
+   Vector< Matrix<double> > calculate_layers_delta(const Vector< Matrix<double> >&, const Matrix<double>&) const;
+   Vector< Matrix<double> > calculate_layers_delta(const Vector< Matrix<double> >&, const Matrix<double>&, const Matrix<double>&) const;
+
+   void calculate_layers_delta(const Vector< Matrix<double> >&, const Matrix<double>&, Vector< Matrix<double> >&) const;
+   void calculate_layers_delta(const Vector< Matrix<float> >&, const Matrix<double>&, const Vector<float>&, Vector< Matrix<float> >&) const;
+
    // Interlayers Delta methods
 
    double calculate_loss_output_combinations(const Vector<double>& combinations) const;
@@ -283,6 +340,10 @@ public:
    Vector<double> calculate_point_gradient(const Vector<double>&, const Vector< Vector<double> >&, const Vector< Vector<double> >&) const;
    Vector<double> calculate_point_gradient(const Vector< Matrix<double> >&, const Vector< Vector<double> >&) const;
 
+   Vector<double> calculate_batch_gradient(const Matrix<double>&, const Vector< Matrix<double> >&, const Vector< Matrix<double> >&) const;
+   void calculate_batch_gradient(const Matrix<double>&, const Vector< Matrix<double> >&, const Vector< Matrix<double> >&, Vector<double>&) const;
+   void calculate_batch_gradient(const Matrix<float>&, const Vector< Matrix<float> >&, const Vector< Matrix<float> >&, Matrix<float>&, Vector<double>&) const;
+
    Matrix<double> calculate_point_Hessian(const Vector< Vector<double> >&, const Vector< Vector< Vector<double> > >&, const Matrix< Matrix<double> >&, const Vector< Vector<double> >&, const Matrix< Matrix<double> >&) const;
    Matrix<double> calculate_single_hidden_layer_point_Hessian(const Vector< Vector<double> >&,
                                                               const Vector< Vector<double> >&,
@@ -316,10 +377,23 @@ public:
         return(output_gradient);
    }
 
+   virtual Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const;
+
    virtual Vector<double> calculate_gradient(void) const; 
 
    virtual Vector<double> calculate_gradient(const Vector<double>&) const;
 
+   virtual Vector<double> calculate_batch_gradient(const Vector<size_t>&) const;
+
+   Vector<double> calculate_single_precision_gradient(void) const;
+   Vector<double> calculate_single_precision_batch_gradient(const Vector<size_t>&) const;
+
+   virtual double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const;
+
+   virtual FirstOrderPerformance calculate_first_order_loss(void) const;
+
+   FirstOrderPerformance calculate_batch_first_order_loss(const Vector<size_t>&) const;
+
    /// Returns the error term Hessian.
 
    virtual Matrix<double> calculate_output_Hessian(const Vector<double>&, const Vector<double>&) const
@@ -360,6 +434,67 @@ public:
 
 protected:
 
+   // STRUCTURES
+
+   ///
+   /// This structure identifies the state of the data set from which some constants of an error term were calculated.
+   /// The constants are out of date if the data set, its instances, its variables or its data have changed since then.
+   ///
+
+   struct DataSetState
+   {
+      /// Default constructor.
+
+      DataSetState(void)
+      {
+         data_set_pointer = NULL;
+
+         instances_version = 0;
+         variables_version = 0;
+         data_version = 0;
+      }
+
+      /// Returns true if this state is equal to another state.
+      /// @param other_state Other state to be compared with.
+
+      bool operator == (const DataSetState& other_state) const
+      {
+         return(data_set_pointer == other_state.data_set_pointer
+             && instances_version == other_state.instances_version
+             && variables_version == other_state.variables_version
+             && data_version == other_state.data_version);
+      }
+
+      /// Pointer to the data set.
+
+      const DataSet* data_set_pointer;
+
+      /// Version of the instances object.
+
+      size_t instances_version;
+
+      /// Version of the variables object.
+
+      size_t variables_version;
+
+      /// Version of the data matrix.
+
+      size_t data_version;
+   };
+
+   // METHODS
+
+   DataSetState get_data_set_state(void) const;
+
+   FirstOrderPerformance back_propagate(const Vector<size_t>&, const bool&) const;
+   FirstOrderPerformance back_propagate_single_precision(const Vector<size_t>&, const bool&) const;
+
+   double calculate_instances_error(const Vector<size_t>&, const Vector<double>&) const;
+
+   void calculate_instances_outputs(const Vector<size_t>&, const Vector<double>&, Matrix<double>&, Matrix<double>&) const;
+
+   // MEMBERS
+
    /// Pointer to a multilayer perceptron object.
 
    NeuralNetwork* neural_network_pointer;
@@ -964,7 +964,14 @@ Vector<double> GradientDescent::calculate_training_direction(const Vector<double
 
     #endif
 
-   return(gradient.calculate_normalized()*(-1.0));
+   const double gradient_norm = gradient.calculate_norm();
+
+   if(gradient_norm == 0.0)
+   {
+      return(Vector<double>(gradient.size(), 0.0));
+   }
+
+   return(gradient.eigen_map()*(-1.0/gradient_norm));
 }
 
 
@@ -1265,7 +1272,7 @@ GradientDescent::GradientDescentResults* GradientDescent::perform_training(void)
 
    const size_t parameters_number = neural_network_pointer->count_parameters_number();
 
-   Vector<double> parameters(parameters_number);
+   Vector<double> parameters = neural_network_pointer->arrange_parameters();
    double parameters_norm;
 
    Vector<double> parameters_increment(parameters_number);
@@ -1316,8 +1323,6 @@ GradientDescent::GradientDescentResults* GradientDescent::perform_training(void)
    {
       // Neural network stuff
 
-      parameters = neural_network_pointer->arrange_parameters();
-
       parameters_norm = parameters.calculate_norm();
 
       if(display && parameters_norm >= warning_parameters_norm)
@@ -1328,17 +1333,21 @@ GradientDescent::GradientDescentResults* GradientDescent::perform_training(void)
       // Loss index stuff
 
       if(iteration == 0)
-      {      
-         loss = loss_index_pointer->calculate_loss();
+      {
+         first_order_loss = loss_index_pointer->calculate_first_order_loss();
+
+         loss = first_order_loss.loss;
          loss_increase = 1.0e99;
+
+         gradient = first_order_loss.gradient;
       }
       else
       {
          loss = directional_point[1];
-         loss_increase = old_loss - loss; 
-      }
+         loss_increase = old_loss - loss;
 
-      gradient = loss_index_pointer->calculate_gradient();
+         gradient = loss_index_pointer->calculate_gradient();
+      }
 
       gradient_norm = gradient.calculate_norm();
 
@@ -1353,7 +1362,7 @@ GradientDescent::GradientDescentResults* GradientDescent::perform_training(void)
       {
           minimum_selection_error = selection_loss;
 
-          minimum_selection_error_parameters = neural_network_pointer->arrange_parameters();
+          minimum_selection_error_parameters = parameters;
       }
       else if(iteration != 0 && selection_loss > old_selection_loss)
       {
@@ -1363,7 +1372,7 @@ GradientDescent::GradientDescentResults* GradientDescent::perform_training(void)
       {
           minimum_selection_error = selection_loss;
 
-          minimum_selection_error_parameters = neural_network_pointer->arrange_parameters();
+          minimum_selection_error_parameters = parameters;
       }
 
       // Training algorithm 
@@ -1383,7 +1392,7 @@ GradientDescent::GradientDescentResults* GradientDescent::perform_training(void)
 
       training_rate = directional_point[0];
 
-      parameters_increment = training_direction*training_rate;
+      parameters_increment = training_direction.eigen_map()*training_rate;
       parameters_increment_norm = parameters_increment.calculate_norm();
       
       // Elapsed time
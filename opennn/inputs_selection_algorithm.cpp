@@ -672,20 +672,32 @@ Matrix<double> InputsSelectionAlgorithm::calculate_logistic_correlations(void) c
 
     Matrix<double> correlations(inputs_number, targets_number, 0.0);
 
+    // The correlations of the binary inputs are linear, and they are all computed in a single pass over the data
+
+    const Matrix<double> linear_correlations = data_set_pointer->calculate_linear_correlations();
+
+    Vector< Vector<double> > targets_variables(targets_number);
+
+    for(size_t j = 0; j < targets_number; j++)
+    {
+        targets_variables[j] = data_set_pointer->get_variable(target_indices[j]);
+    }
+
     srand(0);
 
     for(size_t i = 0; i < inputs_number; i++)
     {
         const Vector<double> inputs = data_set_pointer->get_variable(input_indices[i]);
 
+        const bool binary_input = inputs.is_binary();
+
         for(size_t j = 0; j < targets_number; j++)
         {
-            const Vector<double> targets = data_set_pointer->get_variable(target_indices[j]);
+            const Vector<double>& targets = targets_variables[j];
 
-            if (inputs.is_binary())
+            if (binary_input)
             {
-
-                correlations(i,j) = targets.calculate_linear_correlation(inputs);
+                correlations(i,j) = linear_correlations(i,j);
 
                 continue;
             }
@@ -27,6 +27,8 @@ namespace OpenNN
 
 Instances::Instances(void)
 {
+   version = 0;
+
    set();
 }
 
@@ -40,6 +42,8 @@ Instances::Instances(void)
 
 Instances::Instances(const size_t& new_instances_number)
 {
+    version = 0;
+
     set(new_instances_number);
 }
 
@@ -52,6 +56,8 @@ Instances::Instances(const size_t& new_instances_number)
 
 Instances::Instances(const tinyxml2::XMLDocument& instances_document)
 {   
+   version = 0;
+
    set(instances_document);
 }
 
@@ -67,6 +73,8 @@ Instances::Instances(const Instances& other_instances)
    items = other_instances.items;
 
    display = other_instances.display;
+
+   version = 0;
 }
 
 
@@ -91,6 +99,8 @@ Instances& Instances::operator=(const Instances& other_instances)
    {
       items = other_instances.items;
       display = other_instances.display;
+
+      version++;
    }
 
    return(*this);
@@ -708,6 +718,17 @@ const bool& Instances::get_display(void) const
 }
 
 
+// const size_t& get_version(void) const method
+
+/// Returns the number of times that the uses of the instances have been modified.
+/// Objects keeping data arranged by instance uses can compare it with the value they were built with.
+
+const size_t& Instances::get_version(void) const
+{
+   return(version);
+}
+
+
 // void set(void) method
 
 /// Sets a instances object with zero instances. 
@@ -793,6 +814,8 @@ void Instances::set_uses(const Vector<Instances::Use>& new_uses)
    {
        items[i].use = new_uses[i];
    }
+
+   version++;
 }
 
 
@@ -853,6 +876,8 @@ void Instances::set_uses(const Vector<std::string>& new_uses)
 	     throw std::logic_error(buffer.str());
 	  }
    }   
+
+   version++;
 }
 
 
@@ -867,6 +892,8 @@ void Instances::set_uses(const Vector<std::string>& new_uses)
 void Instances::set_use(const size_t& i, const Use& new_use)
 {
     items[i].use = new_use;
+
+    version++;
 }
 
 
@@ -904,6 +931,8 @@ void Instances::set_use(const size_t& i, const std::string& new_use)
 
        throw std::logic_error(buffer.str());
     }
+
+    version++;
 }
 
 
@@ -923,6 +952,8 @@ void Instances::set_unused(const Vector<size_t> & indices)
 
         items[index].use = Unused;
     }
+
+    version++;
 }
 
 
@@ -938,6 +969,8 @@ void Instances::set_training(void)
    {
        items[i].use = Training;
    }
+
+   version++;
 }
 
 
@@ -953,6 +986,8 @@ void Instances::set_selection(void)
     {
         items[i].use = Selection;
     }
+
+    version++;
 }
 
 
@@ -968,6 +1003,8 @@ void Instances::set_testing(void)
     {
         items[i].use = Testing;
     }
+
+    version++;
 }
 
 
@@ -995,6 +1032,8 @@ void Instances::set_instances_number(const size_t& new_instances_number)
    items.set(new_instances_number);
 
    split_instances();
+
+   version++;
 }
 
 
@@ -1371,6 +1410,8 @@ void Instances::split_random_indices
 
       i++;
    }
+
+   version++;
 }
 
 
@@ -1457,6 +1498,8 @@ void Instances::split_sequential_indices(const double& training_instances_ratio,
 
       i++;
    }
+
+   version++;
 }
 
 
@@ -169,6 +169,8 @@ public:
 
    const bool& get_display(void) const;
 
+   const size_t& get_version(void) const;
+
    // Set methods
 
    void set(void);
@@ -231,6 +233,10 @@ private:
    /// Display messages to screen.
    
    bool display;
+
+   /// Modification counter of the instances uses.
+
+   size_t version;
 };
 
 }
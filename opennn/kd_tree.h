@@ -0,0 +1,444 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   K D   T R E E   C O N T A I N E R                                                                          */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+#ifndef __KDTREE_H__
+#define __KDTREE_H__
+
+// System includes
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// OpenNN includes
+
+#include "vector.h"
+#include "matrix.h"
+
+namespace OpenNN {
+
+/// This template is a k-dimensional tree over the rows of a matrix.
+/// It splits the points recursively at the median of the coordinate with the largest spread,
+/// and it answers k-nearest neighbors queries with the Euclidean distance in logarithmic expected time.
+/// The points are copied in the order of the tree, so that the points of a leaf are contiguous in memory.
+
+template <typename T> class KdTree {
+public:
+  // CONSTRUCTORS
+
+  // Default constructor.
+
+  explicit KdTree(void);
+
+  // Points constructor.
+
+  explicit KdTree(const Matrix<T> &);
+
+  // DESTRUCTOR
+
+  virtual ~KdTree(void);
+
+  // METHODS
+
+  size_t get_points_number(void) const;
+
+  size_t get_dimensions_number(void) const;
+
+  void set(const Matrix<T> &);
+
+  void calculate_nearest_neighbors(const size_t &, const size_t &, Vector<size_t> &, Vector<double> &) const;
+
+  void calculate_nearest_neighbors(const size_t &, Matrix<size_t> &, Matrix<double> &) const;
+
+private:
+  /// Node of the tree.
+  /// The points of a node are those between its first and last positions in the tree order.
+
+  struct Node {
+    /// Position of the first point of the node.
+
+    size_t first_position;
+
+    /// Position after the last point of the node.
+
+    size_t last_position;
+
+    /// Coordinate in which the node is split.
+
+    size_t split_dimension;
+
+    /// Value of the split coordinate. Points on the left are not greater, and points on the right are not smaller.
+
+    double split_value;
+
+    /// Index of the left child node, or zero if the node is a leaf.
+
+    size_t left_node;
+
+    /// Index of the right child node, or zero if the node is a leaf.
+
+    size_t right_node;
+  };
+
+  void search(const size_t &, const double *, const size_t &, const size_t &,
+              std::vector< std::pair<double, size_t> > &) const;
+
+  /// Maximum number of points in a leaf.
+
+  static const size_t leaf_size = 16;
+
+  /// Number of coordinates of each point.
+
+  size_t dimensions_number;
+
+  /// Coordinates of the points, row by row in the order of the tree.
+
+  Vector<double> points;
+
+  /// Index in the original matrix of the point at each position of the tree.
+
+  Vector<size_t> indices;
+
+  /// Position in the tree of each point of the original matrix.
+
+  Vector<size_t> positions;
+
+  /// Nodes of the tree. The first one is the root.
+
+  std::vector<Node> nodes;
+};
+
+// CONSTRUCTORS
+
+/// Default constructor. It creates a tree without points.
+
+template <class T> KdTree<T>::KdTree(void) : dimensions_number(0) {}
+
+/// Points constructor. It builds a tree over the rows of a matrix.
+/// @param new_points Matrix whose rows are the points.
+
+template <class T> KdTree<T>::KdTree(const Matrix<T> &new_points) : dimensions_number(0) {
+  set(new_points);
+}
+
+// DESTRUCTOR
+
+/// Destructor.
+
+template <class T> KdTree<T>::~KdTree(void) {}
+
+// size_t get_points_number(void) const method
+
+/// Returns the number of points in the tree.
+
+template <class T> size_t KdTree<T>::get_points_number(void) const {
+  return (indices.size());
+}
+
+// size_t get_dimensions_number(void) const method
+
+/// Returns the number of coordinates of the points in the tree.
+
+template <class T> size_t KdTree<T>::get_dimensions_number(void) const {
+  return (dimensions_number);
+}
+
+// void set(const Matrix<T>&) method
+
+/// Builds the tree over the rows of a matrix.
+/// The construction takes O(n log n) time, and the tree takes O(n) memory besides the copy of the points.
+/// @param new_points Matrix whose rows are the points.
+
+template <class T> void KdTree<T>::set(const Matrix<T> &new_points) {
+  const size_t points_number = new_points.get_rows_number();
+
+  dimensions_number = new_points.get_columns_number();
+
+  indices.set(points_number);
+  indices.initialize_sequential();
+
+  nodes.clear();
+
+  if(points_number == 0) {
+    points.set();
+    positions.set();
+    return;
+  }
+
+  Node root;
+  root.first_position = 0;
+  root.last_position = points_number;
+  root.split_dimension = 0;
+  root.split_value = 0.0;
+  root.left_node = 0;
+  root.right_node = 0;
+
+  nodes.push_back(root);
+
+  // Split the nodes in breadth-first order
+
+  for (size_t n = 0; n < nodes.size(); n++) {
+    const size_t first_position = nodes[n].first_position;
+    const size_t last_position = nodes[n].last_position;
+
+    if(last_position - first_position <= leaf_size || dimensions_number == 0) {
+      continue;
+    }
+
+    // Coordinate with the largest spread
+
+    size_t split_dimension = 0;
+    double maximum_spread = -1.0;
+
+    for (size_t j = 0; j < dimensions_number; j++) {
+      const T *column = new_points.data() + points_number * j;
+
+      double minimum = column[indices[first_position]];
+      double maximum = minimum;
+
+      for (size_t i = first_position + 1; i < last_position; i++) {
+        const double value = column[indices[i]];
+
+        if(value < minimum) {
+          minimum = value;
+        } else if(value > maximum) {
+          maximum = value;
+        }
+      }
+
+      if(maximum - minimum > maximum_spread) {
+        maximum_spread = maximum - minimum;
+        split_dimension = j;
+      }
+    }
+
+    if(maximum_spread <= 0.0) {
+      continue;
+    }
+
+    // Median of that coordinate
+
+    const T *column = new_points.data() + points_number * split_dimension;
+
+    const size_t median_position = first_position + (last_position - first_position) / 2;
+
+    std::nth_element(indices.begin() + first_position,
+                     indices.begin() + median_position,
+                     indices.begin() + last_position,
+                     [column](const size_t &a, const size_t &b) { return (column[a] < column[b]); });
+
+    nodes[n].split_dimension = split_dimension;
+    nodes[n].split_value = column[indices[median_position]];
+
+    Node left_child;
+    left_child.first_position = first_position;
+    left_child.last_position = median_position;
+    left_child.split_dimension = 0;
+    left_child.split_value = 0.0;
+    left_child.left_node = 0;
+    left_child.right_node = 0;
+
+    Node right_child = left_child;
+    right_child.first_position = median_position;
+    right_child.last_position = last_position;
+
+    nodes[n].left_node = nodes.size();
+    nodes.push_back(left_child);
+
+    nodes[n].right_node = nodes.size();
+    nodes.push_back(right_child);
+  }
+
+  // Copy the points in the order of the tree
+
+  points.set(points_number * dimensions_number);
+  positions.set(points_number);
+
+  for (size_t i = 0; i < points_number; i++) {
+    positions[indices[i]] = i;
+
+    for (size_t j = 0; j < dimensions_number; j++) {
+      points[i * dimensions_number + j] = (double)new_points(indices[i], j);
+    }
+  }
+}
+
+// void calculate_nearest_neighbors(const size_t&, const size_t&, Vector<size_t>&, Vector<double>&) const method
+
+/// Calculates the nearest neighbors of a point in the tree, other than the point itself.
+/// The neighbors are sorted by increasing distance, and ties are broken by increasing index.
+/// @param point_index Index of the point in the original matrix.
+/// @param neighbors_number Number of neighbors to be found.
+/// @param neighbors_indices Indices of the neighbors in the original matrix.
+/// @param neighbors_distances Euclidean distances to the neighbors.
+
+template <class T>
+void KdTree<T>::calculate_nearest_neighbors(const size_t &point_index,
+                                            const size_t &neighbors_number,
+                                            Vector<size_t> &neighbors_indices,
+                                            Vector<double> &neighbors_distances) const {
+  // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+  if(neighbors_number >= get_points_number()) {
+    std::ostringstream buffer;
+
+    buffer << "OpenNN Exception: KdTree Template.\n"
+           << "void calculate_nearest_neighbors(const size_t&, const size_t&, Vector<size_t>&, Vector<double>&) const method.\n"
+           << "Number of neighbors (" << neighbors_number << ") must be less than number of points (" << get_points_number() << ").\n";
+
+    throw std::logic_error(buffer.str());
+  }
+
+#endif
+
+  const size_t position = positions[point_index];
+
+  std::vector< std::pair<double, size_t> > heap;
+  heap.reserve(neighbors_number + 1);
+
+  search(0, points.data() + position * dimensions_number, position, neighbors_number, heap);
+
+  std::sort_heap(heap.begin(), heap.end());
+
+  neighbors_indices.set(heap.size());
+  neighbors_distances.set(heap.size());
+
+  for (size_t k = 0; k < heap.size(); k++) {
+    neighbors_indices[k] = heap[k].second;
+    neighbors_distances[k] = sqrt(heap[k].first);
+  }
+}
+
+// void calculate_nearest_neighbors(const size_t&, Matrix<size_t>&, Matrix<double>&) const method
+
+/// Calculates the nearest neighbors of every point in the tree, other than the point itself.
+/// The queries are independent, and they are run in parallel.
+/// @param neighbors_number Number of neighbors of each point.
+/// @param neighbors_indices Matrix with the indices of the neighbors of each point, by increasing distance.
+/// The number of rows is the number of points, and the number of columns is the number of neighbors.
+/// @param neighbors_distances Matrix with the Euclidean distances to the neighbors of each point.
+
+template <class T>
+void KdTree<T>::calculate_nearest_neighbors(const size_t &neighbors_number,
+                                            Matrix<size_t> &neighbors_indices,
+                                            Matrix<double> &neighbors_distances) const {
+  const size_t points_number = get_points_number();
+
+  neighbors_indices.set(points_number, neighbors_number);
+  neighbors_distances.set(points_number, neighbors_number);
+
+  #pragma omp parallel
+  {
+    Vector<size_t> point_neighbors_indices;
+    Vector<double> point_neighbors_distances;
+
+    int i;
+
+    #pragma omp for schedule(dynamic, 64)
+
+    for (i = 0; i < (int)points_number; i++) {
+      calculate_nearest_neighbors(i, neighbors_number, point_neighbors_indices, point_neighbors_distances);
+
+      for (size_t k = 0; k < neighbors_number; k++) {
+        neighbors_indices(i, k) = point_neighbors_indices[k];
+        neighbors_distances(i, k) = point_neighbors_distances[k];
+      }
+    }
+  }
+}
+
+// void search(const size_t&, const double*, const size_t&, const size_t&, std::vector< std::pair<double, size_t> >&) const method
+
+/// Searches a node for the nearest neighbors of a point.
+/// The heap keeps the best candidates found so far as pairs of squared distance and index, with the worst one on top.
+/// @param node_index Index of the node.
+/// @param point Coordinates of the point.
+/// @param excluded_position Position in the tree of the point itself, which is not a neighbor.
+/// @param neighbors_number Number of neighbors to be found.
+/// @param heap Best candidates found so far.
+
+template <class T>
+void KdTree<T>::search(const size_t &node_index,
+                       const double *point,
+                       const size_t &excluded_position,
+                       const size_t &neighbors_number,
+                       std::vector< std::pair<double, size_t> > &heap) const {
+  const Node &node = nodes[node_index];
+
+  if(node.left_node == 0) {
+    for (size_t i = node.first_position; i < node.last_position; i++) {
+      if(i == excluded_position) {
+        continue;
+      }
+
+      const double *other_point = points.data() + i * dimensions_number;
+
+      double squared_distance = 0.0;
+
+      for (size_t j = 0; j < dimensions_number; j++) {
+        const double difference = point[j] - other_point[j];
+
+        squared_distance += difference * difference;
+      }
+
+      const std::pair<double, size_t> candidate(squared_distance, indices[i]);
+
+      if(heap.size() < neighbors_number) {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end());
+      } else if(neighbors_number > 0 && candidate < heap.front()) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = candidate;
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+
+    return;
+  }
+
+  const double difference = point[node.split_dimension] - node.split_value;
+
+  const size_t near_node = difference < 0.0 ? node.left_node : node.right_node;
+  const size_t far_node = difference < 0.0 ? node.right_node : node.left_node;
+
+  search(near_node, point, excluded_position, neighbors_number, heap);
+
+  if(heap.size() < neighbors_number || difference * difference <= heap.front().first) {
+    search(far_node, point, excluded_position, neighbors_number, heap);
+  }
+}
+
+} // end namespace OpenNN
+
+#endif
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (c) 2005-2016 Roberto Lopez.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
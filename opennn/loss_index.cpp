@@ -2921,6 +2921,228 @@ Vector<double> LossIndex::calculate_error_gradient(void) const
 }
 
 
+// Vector<double> calculate_error_batch_gradient(const Vector<size_t>&) const method
+
+/// Returns an estimate of the error gradient computed on a subset of the training instances, according to the error type.
+/// The contribution of the batch is scaled by the ratio between the number of training instances and the batch size,
+/// so that the estimate is unbiased and has the same magnitude as the gradient on all the training instances.
+/// Error terms which are not a sum over instances, such as the root mean squared error or the ROC area error,
+/// return the gradient on all the training instances.
+/// @param instances_indices Indices of the instances in the batch.
+
+Vector<double> LossIndex::calculate_error_batch_gradient(const Vector<size_t>& instances_indices) const
+{
+    // Control sentence (if debug)
+
+    #ifdef __OPENNN_DEBUG__
+
+    check_neural_network();
+
+    if(instances_indices.empty())
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: LossIndex class.\n"
+               << "Vector<double> calculate_error_batch_gradient(const Vector<size_t>&) const method.\n"
+               << "Number of instances in batch must be greater than zero.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    #endif
+
+    const size_t parameters_number = neural_network_pointer->count_parameters_number();
+
+    Vector<double> gradient(parameters_number, 0.0);
+
+    const ErrorTerm* error_term_pointer = NULL;
+
+     switch(error_type)
+     {
+         case NO_ERROR:
+         {
+             return(gradient);
+         }
+         break;
+
+         case SUM_SQUARED_ERROR:
+         {
+             error_term_pointer = sum_squared_error_pointer;
+         }
+         break;
+
+         case MEAN_SQUARED_ERROR:
+         {
+             error_term_pointer = mean_squared_error_pointer;
+         }
+         break;
+
+         case ROOT_MEAN_SQUARED_ERROR:
+         {
+             return(root_mean_squared_error_pointer->calculate_gradient());
+         }
+         break;
+
+         case NORMALIZED_SQUARED_ERROR:
+         {
+             error_term_pointer = normalized_squared_error_pointer;
+         }
+         break;
+
+         case WEIGHTED_SQUARED_ERROR:
+         {
+             error_term_pointer = weighted_squared_error_pointer;
+         }
+         break;
+
+         case ROC_AREA_ERROR:
+         {
+             return(roc_area_error_pointer->calculate_gradient());
+         }
+         break;
+
+         case MINKOWSKI_ERROR:
+         {
+             error_term_pointer = Minkowski_error_pointer;
+         }
+         break;
+
+         case CROSS_ENTROPY_ERROR:
+         {
+             error_term_pointer = cross_entropy_error_pointer;
+         }
+         break;
+
+         case USER_ERROR:
+         {
+             error_term_pointer = user_error_pointer;
+         }
+         break;
+
+         default:
+         {
+             std::ostringstream buffer;
+
+             buffer << "OpenNN Exception: LossIndex class.\n"
+                    << "Vector<double> calculate_error_batch_gradient(const Vector<size_t>&) const method.\n"
+                    << "Unknown error type.\n";
+
+             throw std::logic_error(buffer.str());
+         }
+         break;
+     }
+
+     const size_t training_instances_number = error_term_pointer->get_data_set_pointer()->get_instances().count_training_instances_number();
+
+     gradient = error_term_pointer->calculate_batch_gradient(instances_indices);
+
+     gradient *= (double)training_instances_number/(double)instances_indices.size();
+
+     return(gradient);
+}
+
+
+// ErrorTerm::FirstOrderPerformance calculate_error_first_order_loss(void) const method
+
+/// Returns the value and the gradient of the error term, according to the error type.
+/// Error terms which are a sum over instances compute both from a single pass over the training instances.
+
+ErrorTerm::FirstOrderPerformance LossIndex::calculate_error_first_order_loss(void) const
+{
+    // Control sentence (if debug)
+
+    #ifdef __OPENNN_DEBUG__
+
+    check_neural_network();
+
+    #endif
+
+    const ErrorTerm* error_term_pointer = NULL;
+
+     switch(error_type)
+     {
+         case NO_ERROR:
+         {
+             ErrorTerm::FirstOrderPerformance first_order_loss;
+
+             first_order_loss.loss = 0.0;
+             first_order_loss.gradient.set(neural_network_pointer->count_parameters_number(), 0.0);
+
+             return(first_order_loss);
+         }
+         break;
+
+         case SUM_SQUARED_ERROR:
+         {
+             error_term_pointer = sum_squared_error_pointer;
+         }
+         break;
+
+         case MEAN_SQUARED_ERROR:
+         {
+             error_term_pointer = mean_squared_error_pointer;
+         }
+         break;
+
+         case ROOT_MEAN_SQUARED_ERROR:
+         {
+             error_term_pointer = root_mean_squared_error_pointer;
+         }
+         break;
+
+         case NORMALIZED_SQUARED_ERROR:
+         {
+             error_term_pointer = normalized_squared_error_pointer;
+         }
+         break;
+
+         case WEIGHTED_SQUARED_ERROR:
+         {
+             error_term_pointer = weighted_squared_error_pointer;
+         }
+         break;
+
+         case ROC_AREA_ERROR:
+         {
+             error_term_pointer = roc_area_error_pointer;
+         }
+         break;
+
+         case MINKOWSKI_ERROR:
+         {
+             error_term_pointer = Minkowski_error_pointer;
+         }
+         break;
+
+         case CROSS_ENTROPY_ERROR:
+         {
+             error_term_pointer = cross_entropy_error_pointer;
+         }
+         break;
+
+         case USER_ERROR:
+         {
+             error_term_pointer = user_error_pointer;
+         }
+         break;
+
+         default:
+         {
+             std::ostringstream buffer;
+
+             buffer << "OpenNN Exception: LossIndex class.\n"
+                    << "ErrorTerm::FirstOrderPerformance calculate_error_first_order_loss(void) const method.\n"
+                    << "Unknown error type.\n";
+
+             throw std::logic_error(buffer.str());
+         }
+         break;
+     }
+
+     return(error_term_pointer->calculate_first_order_loss());
+}
+
+
 // Vector<double> calculate_error_gradient(const Vector<double>&) const method
 
 /// Returns the gradient of the objective, according to the objective type.
@@ -4397,6 +4619,26 @@ Vector<double> LossIndex::calculate_gradient(const Vector<double>& parameters) c
 
 
 
+// Vector<double> calculate_batch_gradient(const Vector<size_t>&) const method
+
+/// Returns an estimate of the loss gradient computed on a subset of the training instances.
+/// This is used by stochastic training algorithms, which update the parameters once per mini-batch.
+/// @param instances_indices Indices of the instances in the batch.
+
+Vector<double> LossIndex::calculate_batch_gradient(const Vector<size_t>& instances_indices) const
+{
+   #ifdef __OPENNN_DEBUG__
+
+    check_neural_network();
+
+    check_error_terms();
+
+   #endif
+
+   return(calculate_error_batch_gradient(instances_indices) + calculate_regularization_gradient());
+}
+
+
 // Matrix<double> calculate_Hessian(void) const method
 
 /// Returns the default objective function Hessian matrix,
@@ -4596,14 +4838,34 @@ LossIndex::ZeroOrderloss LossIndex::calculate_zero_order_loss(void) const
 // FirstOrderloss calculate_first_order_loss(void) const method
 
 /// Returns a first order loss structure, which contains the value and the gradient of the loss function.
+/// The error term and its gradient are obtained from a single pass over the training instances when the error term allows it.
 
 LossIndex::FirstOrderloss LossIndex::calculate_first_order_loss(void) const
 {
+   #ifdef __OPENNN_DEBUG__
+
+    check_neural_network();
+
+    check_error_terms();
+
+   #endif
+
    FirstOrderloss first_order_loss;
 
+#ifdef __OPENNN_MPI__
+
    first_order_loss.loss = calculate_loss();
    first_order_loss.gradient = calculate_gradient();
 
+#else
+
+   const ErrorTerm::FirstOrderPerformance error_first_order_loss = calculate_error_first_order_loss();
+
+   first_order_loss.loss = error_first_order_loss.loss + calculate_regularization();
+   first_order_loss.gradient = error_first_order_loss.gradient + calculate_regularization_gradient();
+
+#endif
+
    return(first_order_loss);
 }
 
@@ -4614,10 +4876,12 @@ LossIndex::FirstOrderloss LossIndex::calculate_first_order_loss(void) const
 
 LossIndex::SecondOrderloss LossIndex::calculate_second_order_loss(void) const
 {
+   const FirstOrderloss first_order_loss = calculate_first_order_loss();
+
    SecondOrderloss second_order_loss;
 
-   second_order_loss.loss = calculate_loss();
-   second_order_loss.gradient = calculate_gradient();
+   second_order_loss.loss = first_order_loss.loss;
+   second_order_loss.gradient = first_order_loss.gradient;
    second_order_loss.Hessian = calculate_Hessian();
 
    return(second_order_loss);
@@ -4724,11 +4988,29 @@ double LossIndex::calculate_second_order_Taylor_approximation(const Vector<doubl
 // double calculate_loss(const Vector<double>&, const double&) const method
 
 /// Returns the value of the loss function at some step along some direction.
+/// When the parameters are contiguous, the trial point is written in place and the original parameters are restored afterwards.
 /// @param direction Direction vector.
 /// @param rate Step value. 
 
 double LossIndex::calculate_loss(const Vector<double>& direction, const double& rate) const
 {
+   if(neural_network_pointer->has_parameters_span())
+   {
+      // Evaluate the trial point in place and restore the original parameters afterwards
+
+      VectorSpan<double> parameters = neural_network_pointer->get_parameters_span();
+
+      const Vector<double> origin = parameters.to_vector();
+
+      parameters.assign(origin, direction, rate);
+
+      const double loss = calculate_loss();
+
+      parameters.assign(origin);
+
+      return(loss);
+   }
+
    const Vector<double> parameters = neural_network_pointer->arrange_parameters();
    const Vector<double> increment = direction*rate;
 
@@ -357,6 +357,10 @@ public:
    Vector<double> calculate_error_gradient(const Vector<double>&) const;
    Vector<double> calculate_regularization_gradient(const Vector<double>&) const;
 
+   Vector<double> calculate_error_batch_gradient(const Vector<size_t>&) const;
+
+   ErrorTerm::FirstOrderPerformance calculate_error_first_order_loss(void) const;
+
 #ifdef __OPENNN_MPI__
    Vector<double> calculate_error_gradient_MPI(const Vector<double>&) const;
 #endif
@@ -375,6 +379,8 @@ public:
    Vector<double> calculate_gradient(const Vector<double>&) const;
    Matrix<double> calculate_Hessian(const Vector<double>&) const;
 
+   Vector<double> calculate_batch_gradient(const Vector<size_t>&) const;
+
    virtual Matrix<double> calculate_inverse_Hessian(void) const;
 
    virtual Vector<double> calculate_vector_dot_Hessian(const Vector<double>&) const;
@@ -31,6 +31,8 @@
 namespace OpenNN
 {
 
+template <class T> struct CrossMoments;
+
 /// This template class defines a matrix for general purpose use.
 /// This matrix also implements some mathematical methods which can be useful. 
 
@@ -52,6 +54,10 @@ public:
 
     Matrix(const Matrix&);
 
+    Matrix(Matrix&&);
+
+    template <class Derived> Matrix(const Eigen::MatrixBase<Derived>&);
+
     // DESTRUCTOR
 
     virtual ~Matrix(void);
@@ -60,6 +66,10 @@ public:
 
     inline Matrix<T>& operator = (const Matrix<T>&);
 
+    inline Matrix<T>& operator = (Matrix<T>&&);
+
+    template <class Derived> Matrix<T>& operator = (const Eigen::MatrixBase<Derived>&);
+
     // REFERENCE OPERATORS
 
     inline T& operator () (const size_t&, const size_t&);
@@ -243,6 +253,12 @@ public:
 
     Vector< Statistics<T> > calculate_columns_statistics_missing_values(const Vector<size_t>&, const Vector< Vector<size_t> >) const;
 
+    Vector< Moments<T> > calculate_columns_moments_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&) const;
+
+    Vector< Vector<double> > calculate_columns_box_plots_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&) const;
+
+    Vector< QuantileSketch<T> > calculate_columns_quantile_sketches_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&, const size_t& = 256) const;
+
     Vector< Vector<double> > calculate_shape_parameters(void) const;
 
     Vector< Vector<double> > calculate_shape_parameters_missing_values(const Vector<Vector<size_t> > &) const;
@@ -263,6 +279,10 @@ public:
 
     Vector< Histogram<T> > calculate_histograms_missing_values(const Vector< Vector<size_t> >&, const size_t& = 10) const;
 
+    Vector< Histogram<T> > calculate_columns_histograms_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&, const size_t& = 10, const bool& = false) const;
+
+    CrossMoments<T> calculate_columns_cross_moments(const Vector<size_t>&, const Vector<size_t>&, const Vector<size_t>&) const;
+
     Matrix<size_t> calculate_less_than_indices(const T&) const;
 
     Matrix<size_t> calculate_greater_than_indices(const T&) const;
@@ -423,6 +443,10 @@ public:
 
     Vector<T> to_vector(void) const;
 
+    Eigen::Map< Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > eigen_map(void);
+
+    Eigen::Map< const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > eigen_map(void) const;
+
     void print_preview(void) const;
 
 private:
@@ -558,6 +582,37 @@ Matrix<T>::Matrix(const Matrix& other_matrix) : std::vector<T>(other_matrix.begi
 }
 
 
+/// Move constructor. It takes the elements of a temporary matrix without copying them,
+/// so that returning matrices by value does not allocate twice.
+/// @param other_matrix Matrix to be moved.
+
+template <class T>
+Matrix<T>::Matrix(Matrix&& other_matrix) : std::vector<T>(std::move(other_matrix))
+{
+   rows_number = other_matrix.rows_number;
+   columns_number = other_matrix.columns_number;
+
+   other_matrix.rows_number = 0;
+   other_matrix.columns_number = 0;
+}
+
+
+/// Expression constructor. It creates a matrix by evaluating an Eigen expression in a single loop,
+/// without intermediate matrices.
+/// Expressions are built on the maps returned by eigen_map().
+/// @param expression Expression to be evaluated.
+
+template <class T>
+template <class Derived>
+Matrix<T>::Matrix(const Eigen::MatrixBase<Derived>& expression) : std::vector<T>(expression.rows()*expression.cols())
+{
+   rows_number = expression.rows();
+   columns_number = expression.cols();
+
+   eigen_map().noalias() = expression;
+}
+
+
 // DESTRUCTOR
 
 /// Destructor.
@@ -592,6 +647,49 @@ Matrix<T>& Matrix<T>::operator = (const Matrix<T>& other_matrix)
 }
 
 
+/// Move assignment operator. It takes the elements of a temporary matrix,
+/// such as the result of an arithmetic operator, without copying them.
+/// @param other_matrix Matrix to be moved.
+
+template <class T>
+Matrix<T>& Matrix<T>::operator = (Matrix<T>&& other_matrix)
+{
+    std::vector<T>::operator = (std::move(other_matrix));
+
+    rows_number = other_matrix.rows_number;
+    columns_number = other_matrix.columns_number;
+
+    other_matrix.rows_number = 0;
+    other_matrix.columns_number = 0;
+
+    return(*this);
+}
+
+
+/// Expression assignment operator. It evaluates an Eigen expression directly into this matrix,
+/// in a single loop and without intermediate matrices.
+/// The matrix is only reallocated when its size changes.
+/// @param expression Expression to be evaluated.
+
+template <class T>
+template <class Derived>
+Matrix<T>& Matrix<T>::operator = (const Eigen::MatrixBase<Derived>& expression)
+{
+    if(rows_number != (size_t)expression.rows() || columns_number != (size_t)expression.cols())
+    {
+        Matrix<T> result(expression);
+
+        *this = std::move(result);
+    }
+    else
+    {
+        eigen_map() = expression;
+    }
+
+    return(*this);
+}
+
+
 // REFERENCE OPERATORS
 
 /// Reference operator.
@@ -3410,21 +3508,41 @@ Vector<double> Matrix<T>::calculate_mean_missing_values(const Vector<size_t>& ro
 
    Vector<size_t> count(column_indices_size, 0);
 
+   // Missing rows are marked once per column instead of searched for every row
+
+   Vector<bool> missing_rows(rows_number, false);
+
    for(size_t j = 0; j < column_indices_size; j++)
    {
       column_index = column_indices[j];
 
+      for(size_t k = 0; k < missing_indices[j].size(); k++)
+      {
+         if(missing_indices[j][k] < rows_number)
+         {
+            missing_rows[missing_indices[j][k]] = true;
+         }
+      }
+
       for(size_t i = 0; i < row_indices_size; i++)
       {
          row_index = row_indices[i];
 
-         if(!missing_indices[j].contains(row_index))
+         if(!missing_rows[row_index])
          {
             mean[j] += (*this)(row_index,column_index);
             count[j]++;
          }
       }
 
+      for(size_t k = 0; k < missing_indices[j].size(); k++)
+      {
+         if(missing_indices[j][k] < rows_number)
+         {
+            missing_rows[missing_indices[j][k]] = false;
+         }
+      }
+
       if(count[j] != 0)
       {
           mean[j] /= (double)count[j];
@@ -3938,15 +4056,19 @@ Vector< Statistics<T> > Matrix<T>::calculate_statistics_missing_values(const Vec
 
    #endif
 
-   Vector< Statistics<T> > statistics(columns_number);
+   Vector<size_t> row_indices(rows_number);
+   row_indices.initialize_sequential();
 
-   Vector<T> column(rows_number);
+   Vector<size_t> column_indices(columns_number);
+   column_indices.initialize_sequential();
+
+   const Vector< Moments<T> > moments = calculate_columns_moments_missing_values(row_indices, column_indices, missing_indices);
+
+   Vector< Statistics<T> > statistics(columns_number);
 
    for(size_t i = 0; i < columns_number; i++)
    {
-      column = arrange_column(i);
-
-      statistics[i] = column.calculate_statistics_missing_values(missing_indices[i]);
+      statistics[i] = moments[i].calculate_statistics();
    }
 
    return(statistics);
@@ -4084,23 +4206,301 @@ Vector< Statistics<T> > Matrix<T>::calculate_columns_statistics_missing_values(c
 {
     const size_t column_indices_size = column_indices.size();
 
+    Vector<size_t> row_indices(rows_number);
+    row_indices.initialize_sequential();
+
+    const Vector< Moments<T> > moments = calculate_columns_moments_missing_values(row_indices, column_indices, missing_indices);
+
     Vector< Statistics<T> > statistics(column_indices_size);
 
-    size_t index;
-    Vector<T> column(rows_number);
+    for(size_t i = 0; i < column_indices_size; i++)
+    {
+        statistics[i] = moments[i].calculate_statistics();
+    }
+
+    return statistics;
+}
+
+
+// Vector< Moments<T> > calculate_columns_moments_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&) const method
+
+/// Returns the number of values, the extreme values and the central moments of given columns for given rows,
+/// leaving out the missing values.
+/// The columns are traversed once, in blocks of rows which are processed in parallel and merged at the end.
+/// The format is a vector of moments structures.
+/// The size of that vector is equal to the number of given columns.
+/// @param row_indices Indices of the rows for which the moments are to be computed.
+/// @param column_indices Indices of the columns for which the moments are to be computed.
+/// @param missing_indices Vector of vectors with the row indices of the missing values in each column of this matrix.
+/// It might be empty if there are no missing values.
+
+template <class T>
+Vector< Moments<T> > Matrix<T>::calculate_columns_moments_missing_values(const Vector<size_t>& row_indices,
+                                                                        const Vector<size_t>& column_indices,
+                                                                        const Vector< Vector<size_t> >& missing_indices) const
+{
+    // Control sentence (if debug)
 
-#pragma omp parallel for private(index, column)
+    #ifdef __OPENNN_DEBUG__
 
-    for(int i = 0; i < column_indices_size; i++)
+    if(!missing_indices.empty() && missing_indices.size() != columns_number)
     {
-        index = column_indices[i];
+       std::ostringstream buffer;
 
-        column = arrange_column(index);
+       buffer << "OpenNN Exception: Matrix template.\n"
+              << "Vector< Moments<T> > calculate_columns_moments_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&) const method.\n"
+              << "Size of missing indices (" << missing_indices.size() << ") must be equal to to number of columns (" << columns_number << ").\n";
+
+       throw std::logic_error(buffer.str());
+    }
+
+    #endif
+
+    const size_t row_indices_size = row_indices.size();
+    const size_t column_indices_size = column_indices.size();
+
+    const size_t block_size = 4096;
 
-        statistics[i] = column.calculate_statistics_missing_values(missing_indices[index]);
+    const size_t blocks_number = (row_indices_size + block_size - 1)/block_size;
+
+    // Missing rows of each column, sorted for binary search
+
+    Vector< Vector<size_t> > columns_missing_indices(column_indices_size);
+
+    for(size_t j = 0; j < column_indices_size; j++)
+    {
+        if(column_indices[j] < missing_indices.size())
+        {
+            columns_missing_indices[j] = missing_indices[column_indices[j]];
+
+            std::sort(columns_missing_indices[j].begin(), columns_missing_indices[j].end());
+        }
     }
 
-    return statistics;
+    // Each task is a block of rows in a column
+
+    const size_t tasks_number = column_indices_size*blocks_number;
+
+    Vector< Moments<T> > blocks_moments(tasks_number);
+
+    #pragma omp parallel
+    {
+        Vector<T> values(std::min(block_size, row_indices_size));
+
+        int k;
+
+        #pragma omp for schedule(dynamic)
+
+        for(k = 0; k < (int)tasks_number; k++)
+        {
+            const size_t j = k/blocks_number;
+            const size_t first_position = (k%blocks_number)*block_size;
+            const size_t last_position = std::min(first_position + block_size, row_indices_size);
+
+            const T* column = this->data() + rows_number*column_indices[j];
+
+            const Vector<size_t>& column_missing_indices = columns_missing_indices[j];
+
+            size_t values_number = 0;
+
+            if(column_missing_indices.empty())
+            {
+                for(size_t i = first_position; i < last_position; i++)
+                {
+                    values[values_number++] = column[row_indices[i]];
+                }
+            }
+            else
+            {
+                for(size_t i = first_position; i < last_position; i++)
+                {
+                    if(!std::binary_search(column_missing_indices.begin(), column_missing_indices.end(), row_indices[i]))
+                    {
+                        values[values_number++] = column[row_indices[i]];
+                    }
+                }
+            }
+
+            blocks_moments[k].set(values.data(), values_number);
+        }
+    }
+
+    // Merge blocks in order
+
+    Vector< Moments<T> > moments(column_indices_size);
+
+    for(size_t j = 0; j < column_indices_size; j++)
+    {
+        for(size_t b = 0; b < blocks_number; b++)
+        {
+            moments[j].merge(blocks_moments[j*blocks_number + b]);
+        }
+    }
+
+    return(moments);
+}
+
+
+// Vector< Vector<double> > calculate_columns_box_plots_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&) const method
+
+/// Returns the box and whiskers of given columns for given rows, leaving out the missing values.
+/// The quartiles are exact, as those of Vector::calculate_box_plots(), but they are selected in linear time
+/// on a buffer which each thread reuses for all its columns.
+/// The format is a vector of subvectors of size five (minimum, first quartile, median, third quartile and maximum).
+/// The size of that vector is equal to the number of given columns.
+/// @param row_indices Indices of the rows.
+/// @param column_indices Indices of the columns.
+/// @param missing_indices Vector of vectors with the row indices of the missing values in each column of this matrix.
+/// It might be empty if there are no missing values.
+
+template <class T>
+Vector< Vector<double> > Matrix<T>::calculate_columns_box_plots_missing_values(const Vector<size_t>& row_indices,
+                                                                              const Vector<size_t>& column_indices,
+                                                                              const Vector< Vector<size_t> >& missing_indices) const
+{
+    const size_t row_indices_size = row_indices.size();
+    const size_t column_indices_size = column_indices.size();
+
+    Vector< Vector<double> > box_plots(column_indices_size);
+
+    #pragma omp parallel
+    {
+        Vector<T> buffer;
+        buffer.reserve(row_indices_size);
+
+        Vector<size_t> column_missing_indices;
+
+        int j;
+
+        #pragma omp for schedule(dynamic)
+
+        for(j = 0; j < (int)column_indices_size; j++)
+        {
+            const T* column = this->data() + rows_number*column_indices[j];
+
+            column_missing_indices.clear();
+
+            if(column_indices[j] < missing_indices.size())
+            {
+                column_missing_indices = missing_indices[column_indices[j]];
+
+                std::sort(column_missing_indices.begin(), column_missing_indices.end());
+            }
+
+            buffer.clear();
+
+            for(size_t i = 0; i < row_indices_size; i++)
+            {
+                if(column_missing_indices.empty()
+                || !std::binary_search(column_missing_indices.begin(), column_missing_indices.end(), row_indices[i]))
+                {
+                    buffer.push_back(column[row_indices[i]]);
+                }
+            }
+
+            box_plots[j].set(5, 0.0);
+
+            if(buffer.empty())
+            {
+                continue;
+            }
+
+            const Vector<double> quartiles = buffer.select_quartiles();
+
+            box_plots[j][0] = *std::min_element(buffer.begin(), buffer.begin() + buffer.size()/4 + 1);
+            box_plots[j][1] = quartiles[0];
+            box_plots[j][2] = quartiles[1];
+            box_plots[j][3] = quartiles[2];
+            box_plots[j][4] = quartiles[3];
+        }
+    }
+
+    return(box_plots);
+}
+
+
+// Vector< QuantileSketch<T> > calculate_columns_quantile_sketches_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&, const size_t&) const method
+
+/// Returns sketches of the values of given columns for given rows, leaving out the missing values.
+/// They approximate the quantiles of the columns, and they can be merged with those of other rows.
+/// The columns are traversed once, in blocks of rows which are processed in parallel and merged at the end.
+/// The size of the returned vector is equal to the number of given columns.
+/// @param row_indices Indices of the rows.
+/// @param column_indices Indices of the columns.
+/// @param missing_indices Vector of vectors with the row indices of the missing values in each column of this matrix.
+/// It might be empty if there are no missing values.
+/// @param capacity Maximum number of values in each level of the sketches.
+
+template <class T>
+Vector< QuantileSketch<T> > Matrix<T>::calculate_columns_quantile_sketches_missing_values(const Vector<size_t>& row_indices,
+                                                                                        const Vector<size_t>& column_indices,
+                                                                                        const Vector< Vector<size_t> >& missing_indices,
+                                                                                        const size_t& capacity) const
+{
+    const size_t row_indices_size = row_indices.size();
+    const size_t column_indices_size = column_indices.size();
+
+    const size_t block_size = 65536;
+
+    const size_t blocks_number = (row_indices_size + block_size - 1)/block_size;
+
+    // Missing rows of each column, sorted for binary search
+
+    Vector< Vector<size_t> > columns_missing_indices(column_indices_size);
+
+    for(size_t j = 0; j < column_indices_size; j++)
+    {
+        if(column_indices[j] < missing_indices.size())
+        {
+            columns_missing_indices[j] = missing_indices[column_indices[j]];
+
+            std::sort(columns_missing_indices[j].begin(), columns_missing_indices[j].end());
+        }
+    }
+
+    // Each task is a block of rows in a column
+
+    const size_t tasks_number = column_indices_size*blocks_number;
+
+    Vector< QuantileSketch<T> > blocks_sketches(tasks_number, QuantileSketch<T>(capacity));
+
+    int k;
+
+    #pragma omp parallel for schedule(dynamic)
+
+    for(k = 0; k < (int)tasks_number; k++)
+    {
+        const size_t j = k/blocks_number;
+        const size_t first_position = (k%blocks_number)*block_size;
+        const size_t last_position = std::min(first_position + block_size, row_indices_size);
+
+        const T* column = this->data() + rows_number*column_indices[j];
+
+        const Vector<size_t>& column_missing_indices = columns_missing_indices[j];
+
+        for(size_t i = first_position; i < last_position; i++)
+        {
+            if(column_missing_indices.empty()
+            || !std::binary_search(column_missing_indices.begin(), column_missing_indices.end(), row_indices[i]))
+            {
+                blocks_sketches[k].update(column[row_indices[i]]);
+            }
+        }
+    }
+
+    // Merge blocks in order
+
+    Vector< QuantileSketch<T> > sketches(column_indices_size, QuantileSketch<T>(capacity));
+
+    for(size_t j = 0; j < column_indices_size; j++)
+    {
+        for(size_t b = 0; b < blocks_number; b++)
+        {
+            sketches[j].merge(blocks_sketches[j*blocks_number + b]);
+        }
+    }
+
+    return(sketches);
 }
 
 
@@ -4183,15 +4583,19 @@ Vector< Vector<double> > Matrix<T>::calculate_shape_parameters_missing_values(co
 
    #endif
 
-   Vector< Vector<double> > shape_parameters(columns_number);
+   Vector<size_t> row_indices(rows_number);
+   row_indices.initialize_sequential();
 
-   Vector<T> column(rows_number);
+   Vector<size_t> column_indices(columns_number);
+   column_indices.initialize_sequential();
+
+   const Vector< Moments<T> > moments = calculate_columns_moments_missing_values(row_indices, column_indices, missing_indices);
+
+   Vector< Vector<double> > shape_parameters(columns_number);
 
    for(size_t i = 0; i < columns_number; i++)
    {
-      column = arrange_column(i);
-
-      shape_parameters[i] = column.calculate_shape_parameters_missing_values(missing_indices[i]);
+      shape_parameters[i] = moments[i].calculate_shape_parameters();
    }
 
    return(shape_parameters);
@@ -4372,25 +4776,13 @@ Matrix<double> Matrix<T>::calculate_covariance_matrix(void) const
 
     #endif
 
-    Matrix<double> covariance_matrix(size, size, 0.0);
-
-    Vector<double> first_column;
-    Vector<double> second_column;
-
-    for(size_t i = 0; i < size; i++)
-    {
-        first_column = (*this).arrange_column(i);
-
-        for(size_t j = i; j < size; j++)
-        {
-            second_column = (*this).arrange_column(j);
+    Vector<size_t> row_indices(rows_number);
+    row_indices.initialize_sequential();
 
-            covariance_matrix(i,j) = first_column.calculate_covariance(second_column);
-            covariance_matrix(j,i) = covariance_matrix(i,j);
-        }
-    }
+    Vector<size_t> column_indices(size);
+    column_indices.initialize_sequential();
 
-    return covariance_matrix;
+    return(calculate_columns_cross_moments(row_indices, column_indices, column_indices).calculate_covariance_matrix());
 }
 
 
@@ -4405,25 +4797,15 @@ Matrix<double> Matrix<T>::calculate_covariance_matrix(void) const
 template <class T>
 Vector< Histogram<T> > Matrix<T>::calculate_histograms(const size_t& bins_number) const
 {
-   Vector< Histogram<T> > histograms(columns_number);
-
-   Vector<T> column(rows_number);
+   Vector<size_t> row_indices(rows_number);
+   row_indices.initialize_sequential();
 
-   for(size_t i = 0; i < columns_number; i++)
-   {
-      column = arrange_column(i);
+   Vector<size_t> column_indices(columns_number);
+   column_indices.initialize_sequential();
 
-      if (column.is_binary())
-      {
-          histograms[i] = column.calculate_histogram_binary();
-      }
-      else
-      {
-          histograms[i] = column.calculate_histogram(bins_number);
-      }
-   }
+   const Vector< Vector<size_t> > missing_indices;
 
-   return(histograms);
+   return(calculate_columns_histograms_missing_values(row_indices, column_indices, missing_indices, bins_number, true));
 }
 
 
@@ -4439,18 +4821,243 @@ Vector< Histogram<T> > Matrix<T>::calculate_histograms(const size_t& bins_number
 template <class T>
 Vector< Histogram<T> > Matrix<T>::calculate_histograms_missing_values(const Vector< Vector<size_t> >& missing_indices, const size_t& bins_number) const
 {
-   Vector< Histogram<T> > histograms(columns_number);
+   Vector<size_t> row_indices(rows_number);
+   row_indices.initialize_sequential();
 
-   Vector<T> column(rows_number);
+   Vector<size_t> column_indices(columns_number);
+   column_indices.initialize_sequential();
 
-   for(size_t i = 0; i < columns_number; i++)
-   {
-      column = arrange_column(i);
+   return(calculate_columns_histograms_missing_values(row_indices, column_indices, missing_indices, bins_number));
+}
 
-      histograms[i] = column.calculate_histogram_missing_values(missing_indices[i], bins_number);
-   }
 
-   return(histograms);
+// Vector< Histogram<T> > calculate_columns_histograms_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&, const size_t&, const bool&) const method
+
+/// Calculates a histogram of equally spaced bins for given columns and rows, leaving out the missing values.
+/// The range of the columns is computed in a first pass. The bins are then computed arithmetically in a second pass,
+/// where blocks of rows are counted in parallel and merged at the end.
+/// @param row_indices Indices of the rows for which the histograms are to be computed.
+/// @param column_indices Indices of the columns for which the histograms are to be computed.
+/// @param missing_indices Vector of vectors with the row indices of the missing values in each column of this matrix.
+/// It might be empty if there are no missing values.
+/// @param bins_number Number of bins for each histogram.
+/// @param binary_histograms True if the columns with only zeros and ones are to have a histogram of two bins, false otherwise.
+
+template <class T>
+Vector< Histogram<T> > Matrix<T>::calculate_columns_histograms_missing_values(const Vector<size_t>& row_indices,
+                                                                             const Vector<size_t>& column_indices,
+                                                                             const Vector< Vector<size_t> >& missing_indices,
+                                                                             const size_t& bins_number,
+                                                                             const bool& binary_histograms) const
+{
+    // Control sentence (if debug)
+
+    #ifdef __OPENNN_DEBUG__
+
+    if(bins_number == 0)
+    {
+       std::ostringstream buffer;
+
+       buffer << "OpenNN Exception: Matrix template.\n"
+              << "Vector< Histogram<T> > calculate_columns_histograms_missing_values(const Vector<size_t>&, const Vector<size_t>&, const Vector< Vector<size_t> >&, const size_t&, const bool&) const method.\n"
+              << "Number of bins is zero.\n";
+
+       throw std::logic_error(buffer.str());
+    }
+
+    #endif
+
+    const size_t row_indices_size = row_indices.size();
+    const size_t column_indices_size = column_indices.size();
+
+    // Range of each column
+
+    const Vector< Moments<T> > moments = calculate_columns_moments_missing_values(row_indices, column_indices, missing_indices);
+
+    Vector< Histogram<T> > histograms(column_indices_size);
+
+    Vector<bool> binary_candidates(column_indices_size, false);
+
+    for(size_t j = 0; j < column_indices_size; j++)
+    {
+        histograms[j].set_equal_width_bins(moments[j].minimum, moments[j].maximum, bins_number);
+
+        binary_candidates[j] = binary_histograms
+                            && (moments[j].count == 0
+                            || ((moments[j].minimum == 0 || moments[j].minimum == 1) && (moments[j].maximum == 0 || moments[j].maximum == 1)));
+    }
+
+    Vector< Vector<size_t> > columns_missing_indices(column_indices_size);
+
+    for(size_t j = 0; j < column_indices_size; j++)
+    {
+        if(column_indices[j] < missing_indices.size())
+        {
+            columns_missing_indices[j] = missing_indices[column_indices[j]];
+
+            std::sort(columns_missing_indices[j].begin(), columns_missing_indices[j].end());
+        }
+    }
+
+    // Each task counts a block of rows in a column
+
+    const size_t block_size = 65536;
+
+    const size_t blocks_number = (row_indices_size + block_size - 1)/block_size;
+
+    const size_t tasks_number = column_indices_size*blocks_number;
+
+    Vector< Vector<size_t> > blocks_frequencies(tasks_number);
+    Vector< Vector<size_t> > blocks_binary_frequencies(tasks_number);
+
+    int k;
+
+    #pragma omp parallel for schedule(dynamic)
+
+    for(k = 0; k < (int)tasks_number; k++)
+    {
+        const size_t j = k/blocks_number;
+        const size_t first_position = (k%blocks_number)*block_size;
+        const size_t last_position = std::min(first_position + block_size, row_indices_size);
+
+        const T* column = this->data() + rows_number*column_indices[j];
+
+        const Vector<size_t>& column_missing_indices = columns_missing_indices[j];
+
+        const Histogram<T>& histogram = histograms[j];
+
+        Vector<size_t>& frequencies = blocks_frequencies[k];
+        Vector<size_t>& binary_frequencies = blocks_binary_frequencies[k];
+
+        frequencies.set(bins_number, 0);
+        binary_frequencies.set(2, 0);
+
+        for(size_t i = first_position; i < last_position; i++)
+        {
+            if(!column_missing_indices.empty()
+            && std::binary_search(column_missing_indices.begin(), column_missing_indices.end(), row_indices[i]))
+            {
+                continue;
+            }
+
+            const T& value = column[row_indices[i]];
+
+            frequencies[histogram.calculate_bin(value)]++;
+
+            if(binary_candidates[j])
+            {
+                if(value == 0)
+                {
+                    binary_frequencies[0]++;
+                }
+                else if(value == 1)
+                {
+                    binary_frequencies[1]++;
+                }
+            }
+        }
+    }
+
+    // Merge blocks
+
+    for(size_t j = 0; j < column_indices_size; j++)
+    {
+        Vector<size_t> binary_frequencies(2, 0);
+
+        for(size_t b = 0; b < blocks_number; b++)
+        {
+            histograms[j].frequencies += blocks_frequencies[j*blocks_number + b];
+            binary_frequencies += blocks_binary_frequencies[j*blocks_number + b];
+        }
+
+        if(binary_candidates[j] && binary_frequencies[0] + binary_frequencies[1] == moments[j].count)
+        {
+            histograms[j].minimums.set(2);
+            histograms[j].minimums[0] = 0;
+            histograms[j].minimums[1] = 1;
+
+            histograms[j].maximums = histograms[j].minimums;
+            histograms[j].centers = histograms[j].minimums;
+            histograms[j].frequencies = binary_frequencies;
+        }
+    }
+
+    return(histograms);
+}
+
+
+// CrossMoments<T> calculate_columns_cross_moments(const Vector<size_t>&, const Vector<size_t>&, const Vector<size_t>&) const method
+
+/// Returns the means, the sums of squared deviations and the sums of cross deviations
+/// of two sets of columns for given rows.
+/// The rows are processed in blocks, and the cross deviations of each block are computed with a single matrix product.
+/// If both sets of columns are equal, only half of that product is computed, and the cross deviations are symmetric.
+/// @param row_indices Indices of the rows.
+/// @param first_column_indices Indices of the first set of columns.
+/// @param second_column_indices Indices of the second set of columns.
+
+template <class T>
+CrossMoments<T> Matrix<T>::calculate_columns_cross_moments(const Vector<size_t>& row_indices,
+                                                           const Vector<size_t>& first_column_indices,
+                                                           const Vector<size_t>& second_column_indices) const
+{
+    const size_t row_indices_size = row_indices.size();
+
+    const size_t block_size = 16384;
+
+    const bool same_columns = (first_column_indices == second_column_indices);
+
+    CrossMoments<T> cross_moments(first_column_indices.size(), second_column_indices.size());
+
+    CrossMoments<T> block_cross_moments;
+
+    Matrix<double> first_block;
+    Matrix<double> second_block;
+
+    for(size_t first_position = 0; first_position < row_indices_size; first_position += block_size)
+    {
+        const size_t block_rows_number = std::min(block_size, row_indices_size - first_position);
+
+        first_block.set(block_rows_number, first_column_indices.size());
+
+        if(!same_columns)
+        {
+            second_block.set(block_rows_number, second_column_indices.size());
+        }
+
+        for(size_t j = 0; j < first_column_indices.size(); j++)
+        {
+            const T* column = this->data() + rows_number*first_column_indices[j];
+
+            for(size_t i = 0; i < block_rows_number; i++)
+            {
+                first_block(i,j) = (double)column[row_indices[first_position + i]];
+            }
+        }
+
+        if(same_columns)
+        {
+            block_cross_moments.set(first_block, first_block);
+        }
+        else
+        {
+            for(size_t j = 0; j < second_column_indices.size(); j++)
+            {
+                const T* column = this->data() + rows_number*second_column_indices[j];
+
+                for(size_t i = 0; i < block_rows_number; i++)
+                {
+                    second_block(i,j) = (double)column[row_indices[first_position + i]];
+                }
+            }
+
+            block_cross_moments.set(first_block, second_block);
+        }
+
+        cross_moments.merge(block_cross_moments);
+    }
+
+    return(cross_moments);
 }
 
 
@@ -5271,9 +5878,11 @@ double Matrix<T>::calculate_sum_squared_error(const Matrix<double>& other_matrix
    #endif
 
 
+   const size_t this_size = this->size();
+
    double sum_squared_error = 0.0;
 
-   for(size_t i = 0; i < rows_number; i++)
+   for(size_t i = 0; i < this_size; i++)
    {
         sum_squared_error += ((*this)[i] - other_matrix[i])*((*this)[i] - other_matrix[i]);
    }
@@ -7370,7 +7979,7 @@ void Matrix<T>::save_binary(const std::string& file_name) const
 
    double value;
 
-   for(int i = 0; i < this->size(); i++)
+   for(size_t i = 0; i < this->size(); i++)
    {
        value = (*this)[i];
 
@@ -7618,6 +8227,31 @@ Vector<T> Matrix<T>::to_vector(void) const
 }
 
 
+// Eigen::Map< Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > eigen_map(void) method
+
+/// Returns an Eigen view of the elements of this matrix, which does not copy them.
+/// Both this matrix and Eigen store the elements by columns, so that the view can be used directly in Eigen products.
+/// Arithmetic on Eigen views is lazy, so that compound expressions are evaluated in a single loop when they are assigned.
+/// The view is invalidated when the matrix is resized.
+
+template <class T>
+Eigen::Map< Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > Matrix<T>::eigen_map(void)
+{
+    return(Eigen::Map< Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >(this->data(), rows_number, columns_number));
+}
+
+
+// Eigen::Map< const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > eigen_map(void) const method
+
+/// Returns a constant Eigen view of the elements of this matrix, which does not copy them.
+
+template <class T>
+Eigen::Map< const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > Matrix<T>::eigen_map(void) const
+{
+    return(Eigen::Map< const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >(this->data(), rows_number, columns_number));
+}
+
+
 // void print_preview(void) const method
 
 /// Prints to the sceen a preview of the matrix,
@@ -7749,6 +8383,275 @@ std::ostream& operator << (std::ostream& os, const Matrix< Matrix<T> >& m)
 
    return(os);
 }
+
+///
+/// This structure contains the means, the sums of squared deviations and the sums of cross deviations
+/// of two sets of variables. The cross deviations of a block of values are computed with one matrix product
+/// of the centered blocks, and the cross moments of disjoint blocks are merged with the pairwise updating formulas.
+/// It gives the covariance and the linear correlation matrices of large sets of values, even if they are read in chunks.
+///
+
+template <class T> struct CrossMoments
+{
+   // Default constructor.
+
+   CrossMoments(void);
+
+   // Sizes constructor.
+
+   CrossMoments(const size_t&, const size_t&);
+
+   /// Destructor.
+
+   virtual ~CrossMoments(void);
+
+   // METHODS
+
+   void set(const Matrix<double>&, const Matrix<double>&);
+
+   void merge(const CrossMoments<T>&);
+
+   Matrix<double> calculate_covariance_matrix(void) const;
+
+   Matrix<double> calculate_linear_correlation_matrix(void) const;
+
+   /// Number of values of each variable.
+
+   size_t count;
+
+   /// Means of the first set of variables.
+
+   Vector<double> first_means;
+
+   /// Means of the second set of variables.
+
+   Vector<double> second_means;
+
+   /// Sums of the squared deviations from the mean of the first set of variables.
+
+   Vector<double> first_M2;
+
+   /// Sums of the squared deviations from the mean of the second set of variables.
+
+   Vector<double> second_M2;
+
+   /// Sums of the products of the deviations from the means.
+   /// The number of rows is the number of first variables, and the number of columns is the number of second variables.
+
+   Matrix<double> comoments;
+};
+
+
+/// Default constructor.
+/// It sets the cross moments of two empty sets of variables.
+
+template <class T>
+CrossMoments<T>::CrossMoments(void)
+{
+   count = 0;
+}
+
+
+/// Sizes constructor.
+/// It sets the cross moments of two sets of variables without values.
+/// @param first_variables_number Number of variables in the first set.
+/// @param second_variables_number Number of variables in the second set.
+
+template <class T>
+CrossMoments<T>::CrossMoments(const size_t& first_variables_number, const size_t& second_variables_number)
+{
+   count = 0;
+
+   first_means.set(first_variables_number, 0.0);
+   second_means.set(second_variables_number, 0.0);
+
+   first_M2.set(first_variables_number, 0.0);
+   second_M2.set(second_variables_number, 0.0);
+
+   comoments.set(first_variables_number, second_variables_number, 0.0);
+}
+
+
+/// Destructor.
+
+template <class T>
+CrossMoments<T>::~CrossMoments(void)
+{
+}
+
+
+/// Sets the cross moments of a block of values.
+/// If both blocks are the same matrix, the cross deviations are computed as a symmetric rank update.
+/// @param first_block Values of the first set of variables. Each column is a variable.
+/// @param second_block Values of the second set of variables, for the same rows.
+
+template <class T>
+void CrossMoments<T>::set(const Matrix<double>& first_block, const Matrix<double>& second_block)
+{
+   const size_t rows_number = first_block.get_rows_number();
+
+   const size_t first_variables_number = first_block.get_columns_number();
+   const size_t second_variables_number = second_block.get_columns_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(second_block.get_rows_number() != rows_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: Matrix template.\n"
+             << "void CrossMoments<T>::set(const Matrix<double>&, const Matrix<double>&) method.\n"
+             << "Number of rows of both blocks must be equal.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   *this = CrossMoments<T>(first_variables_number, second_variables_number);
+
+   if(rows_number == 0)
+   {
+      return;
+   }
+
+   count = rows_number;
+
+   const Eigen::Map<const Eigen::MatrixXd> first_eigen(first_block.data(), rows_number, first_variables_number);
+   const Eigen::Map<const Eigen::MatrixXd> second_eigen(second_block.data(), rows_number, second_variables_number);
+
+   Eigen::Map<Eigen::VectorXd> first_means_eigen(first_means.data(), first_variables_number);
+   Eigen::Map<Eigen::VectorXd> second_means_eigen(second_means.data(), second_variables_number);
+
+   first_means_eigen = first_eigen.colwise().mean().transpose();
+   second_means_eigen = second_eigen.colwise().mean().transpose();
+
+   const Eigen::MatrixXd first_centered = first_eigen.rowwise() - first_means_eigen.transpose();
+   const Eigen::MatrixXd second_centered = second_eigen.rowwise() - second_means_eigen.transpose();
+
+   Eigen::Map<Eigen::VectorXd>(first_M2.data(), first_variables_number) = first_centered.colwise().squaredNorm().transpose();
+   Eigen::Map<Eigen::VectorXd>(second_M2.data(), second_variables_number) = second_centered.colwise().squaredNorm().transpose();
+
+   Eigen::Map<Eigen::MatrixXd> comoments_eigen(comoments.data(), first_variables_number, second_variables_number);
+
+   if(&first_block == &second_block)
+   {
+      comoments_eigen.template selfadjointView<Eigen::Lower>().rankUpdate(first_centered.transpose());
+
+      comoments_eigen.template triangularView<Eigen::StrictlyUpper>() = comoments_eigen.transpose();
+   }
+   else
+   {
+      comoments_eigen.noalias() = first_centered.transpose()*second_centered;
+   }
+}
+
+
+/// Adds to this structure the cross moments of a disjoint block of values of the same variables.
+/// @param other_cross_moments Cross moments of the other block.
+
+template <class T>
+void CrossMoments<T>::merge(const CrossMoments<T>& other_cross_moments)
+{
+   if(other_cross_moments.count == 0)
+   {
+      return;
+   }
+
+   if(count == 0)
+   {
+      *this = other_cross_moments;
+      return;
+   }
+
+   const double n_a = (double)count;
+   const double n_b = (double)other_cross_moments.count;
+   const double n = n_a + n_b;
+
+   const Vector<double> first_deltas = other_cross_moments.first_means - first_means;
+   const Vector<double> second_deltas = other_cross_moments.second_means - second_means;
+
+   const size_t first_variables_number = first_means.size();
+   const size_t second_variables_number = second_means.size();
+
+   const double weight = n_a*n_b/n;
+
+   for(size_t j = 0; j < second_variables_number; j++)
+   {
+      for(size_t i = 0; i < first_variables_number; i++)
+      {
+         comoments(i,j) += other_cross_moments.comoments(i,j) + first_deltas[i]*second_deltas[j]*weight;
+      }
+   }
+
+   for(size_t i = 0; i < first_variables_number; i++)
+   {
+      first_M2[i] += other_cross_moments.first_M2[i] + first_deltas[i]*first_deltas[i]*n_a*n_b/n;
+      first_means[i] += first_deltas[i]*n_b/n;
+   }
+
+   for(size_t j = 0; j < second_variables_number; j++)
+   {
+      second_M2[j] += other_cross_moments.second_M2[j] + second_deltas[j]*second_deltas[j]*n_a*n_b/n;
+      second_means[j] += second_deltas[j]*n_b/n;
+   }
+
+   count += other_cross_moments.count;
+}
+
+
+/// Returns the sample covariances between the first and the second sets of variables.
+/// The number of rows is the number of first variables, and the number of columns is the number of second variables.
+
+template <class T>
+Matrix<double> CrossMoments<T>::calculate_covariance_matrix(void) const
+{
+   if(count <= 1)
+   {
+      return(Matrix<double>(first_means.size(), second_means.size(), 0.0));
+   }
+
+   return(comoments/(double)(count-1));
+}
+
+
+/// Returns the linear correlations between the first and the second sets of variables.
+/// The correlation of a constant variable is zero, unless both variables are always zero, in which case it is one.
+/// The number of rows is the number of first variables, and the number of columns is the number of second variables.
+
+template <class T>
+Matrix<double> CrossMoments<T>::calculate_linear_correlation_matrix(void) const
+{
+   const size_t first_variables_number = first_means.size();
+   const size_t second_variables_number = second_means.size();
+
+   Matrix<double> linear_correlations(first_variables_number, second_variables_number, 0.0);
+
+   for(size_t j = 0; j < second_variables_number; j++)
+   {
+      for(size_t i = 0; i < first_variables_number; i++)
+      {
+         if(first_means[i] == 0.0 && first_M2[i] == 0.0 && second_means[j] == 0.0 && second_M2[j] == 0.0)
+         {
+            linear_correlations(i,j) = 1.0;
+         }
+         else
+         {
+            const double radicand = first_M2[i]*second_M2[j];
+
+            if(radicand > 0.0 && sqrt(radicand) >= 1.0e-50)
+            {
+               linear_correlations(i,j) = comoments(i,j)/sqrt(radicand);
+            }
+         }
+      }
+   }
+
+   return(linear_correlations);
+}
+
 } // end namespace
 
 #endif
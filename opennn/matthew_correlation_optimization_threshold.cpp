@@ -192,6 +192,7 @@ void MatthewCorrelationOptimizationThreshold::set_step(const double& new_step)
 // MatthewCorrelationOptimizationThresholdResults* perform_order_selection(void) method
 
 /// Perform the decision threshold selection optimizing the Matthew correlation.
+/// The thresholds tried are the distinct selection outputs between the minimum and the maximum thresholds.
 
 MatthewCorrelationOptimizationThreshold::MatthewCorrelationOptimizationThresholdResults* MatthewCorrelationOptimizationThreshold::perform_threshold_selection(void)
 {
@@ -207,7 +208,13 @@ MatthewCorrelationOptimizationThreshold::MatthewCorrelationOptimizationThreshold
 
     NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
 
-    double current_threshold = minimum_threshold;
+    const RocCurve<double> roc_curve = calculate_selection_roc_curve();
+
+    const Vector<double> thresholds = roc_curve.arrange_thresholds(minimum_threshold, maximum_threshold);
+
+    const size_t history_period = calculate_history_period(thresholds.size());
+
+    double current_threshold;
 
     Matrix<size_t> current_confusion;
 
@@ -227,23 +234,13 @@ MatthewCorrelationOptimizationThreshold::MatthewCorrelationOptimizationThreshold
 
     while (!end)
     {
-        current_confusion = calculate_confusion(current_threshold);
+        current_threshold = thresholds[iterations];
+
+        current_confusion = roc_curve.calculate_confusion(current_threshold);
         current_binary_classification_test = calculate_binary_classification_test(current_confusion);
 
         current_matthew_correlation = current_binary_classification_test[12];
 
-        results->threshold_data.push_back(current_threshold);
-
-        if(reserve_binary_classification_tests_data)
-        {
-            results->binary_classification_test_data.push_back(current_binary_classification_test);
-        }
-
-        if(reserve_function_data)
-        {
-            results->function_data.push_back(current_matthew_correlation);
-        }
-
         if (current_matthew_correlation > optimum_matthew_correlation ||
             (current_matthew_correlation == optimum_matthew_correlation && current_binary_classification_test[1] < optimal_binary_classification_test[1]))
         {
@@ -265,7 +262,7 @@ MatthewCorrelationOptimizationThreshold::MatthewCorrelationOptimizationThreshold
 
             results->stopping_condition = ThresholdSelectionAlgorithm::PerfectConfusionMatrix;
         }
-        else if (current_threshold == maximum_threshold)
+        else if (iterations == thresholds.size())
         {
             end = true;
 
@@ -277,27 +274,28 @@ MatthewCorrelationOptimizationThreshold::MatthewCorrelationOptimizationThreshold
             results->stopping_condition = ThresholdSelectionAlgorithm::AlgorithmFinished;
         }
 
-        if (display)
+        if(end || (iterations-1)%history_period == 0)
         {
-            std::cout << "Iteration: " << iterations << std::endl;
-            std::cout << "Current threshold: " << current_threshold << std::endl;
-            std::cout << "Current error: " << current_binary_classification_test[1] << std::endl;
-            std::cout << "Current sensitivity: " << current_binary_classification_test[2] << std::endl;
-            std::cout << "Current specifity: " << current_binary_classification_test[3] << std::endl;
-            std::cout << "Current Matthew correlation: " << current_binary_classification_test[12] << std::endl;
-            std::cout << "Confusion matrix: " << std::endl
-                      << current_confusion << std::endl;
-            std::cout << std::endl;
-        }
+            results->threshold_data.push_back(current_threshold);
 
-        current_threshold = fmin(maximum_threshold, current_threshold + step);
+            if(reserve_binary_classification_tests_data)
+            {
+                results->binary_classification_test_data.push_back(current_binary_classification_test);
+            }
 
+            if(reserve_function_data)
+            {
+                results->function_data.push_back(current_matthew_correlation);
+            }
+        }
     }
 
     if (display)
     {
+        std::cout << "Iterations number: " << iterations << std::endl;
         std::cout << "Optimum threshold: " << optimum_threshold << std::endl;
         std::cout << "Optimal error: " << optimal_binary_classification_test[1] << std::endl;
+        std::cout << "Optimal Matthew correlation: " << optimum_matthew_correlation << std::endl;
     }
 
     results->iterations_number = iterations;
@@ -139,6 +139,8 @@ private:
     double maximum_threshold;
 
     /// Difference in the thresholds between two consecutive iterations.
+    /// It is kept for serialization only and is ignored by perform_threshold_selection(void),
+    /// which tries every distinct selection output between the minimum and the maximum threshold.
 
     double step;
 
@@ -218,58 +218,25 @@ double MeanSquaredError::calculate_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
-   // Data set stuff 
-
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Mean squared error stuff
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   int i = 0;
-
-   double sum_squared_error = 0.0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+:sum_squared_error)
+   // Data set stuff
 
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-      // Input vector
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+      return(calculate_instances_error(training_indices, multilayer_perceptron_pointer->arrange_parameters()));
+   }
 
-      // Target vector
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-      // Sum squared error
+   // Mean squared error stuff
 
-	  sum_squared_error += outputs.calculate_sum_squared_error(targets);
-   }
+   const double sum_squared_error = outputs.calculate_sum_squared_error(targets);
 
-   return(sum_squared_error/(double)training_instances_number);
+   return(sum_squared_error/(double)inputs.get_rows_number());
 }
 
 
@@ -312,58 +279,25 @@ double MeanSquaredError::calculate_error(const Vector<double>& parameters) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Mean squared error stuff
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   double sum_squared_error = 0.0;
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+:sum_squared_error)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-      // Input vector
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
+      return(calculate_instances_error(training_indices, parameters));
+   }
 
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      // Target vector
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+   // Mean squared error stuff
 
-      // Sum squared error
+   const double sum_squared_error = outputs.calculate_sum_squared_error(targets);
 
-      sum_squared_error += outputs.calculate_sum_squared_error(targets);
-   }
-
-   return(sum_squared_error/(double)training_instances_number);
+   return(sum_squared_error/(double)inputs.get_rows_number());
 }
 
 
@@ -384,8 +318,7 @@ double MeanSquaredError::calculate_selection_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
+   // Data set stuff
 
    const Instances& instances = data_set_pointer->get_instances();
 
@@ -396,62 +329,55 @@ double MeanSquaredError::calculate_selection_error(void) const
       return(0.0);
    }
 
-   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
-
-   size_t selection_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-
-      Vector<double> inputs(inputs_number);
-      Vector<double> outputs(outputs_number);
-      Vector<double> targets(outputs_number);
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> selection_indices = data_set_pointer->get_instances().arrange_selection_indices();
 
-      double selection_loss = 0.0;
+      // The error of each batch is normalized by the number of training instances
 
-      int i = 0;
+      return(calculate_instances_error(selection_indices, multilayer_perceptron_pointer->arrange_parameters())*(double)instances.count_training_instances_number()/(double)selection_instances_number);
+   }
 
-      #pragma omp parallel for private(i, selection_index, inputs, outputs, targets) reduction(+:selection_loss)
+   const Matrix<double>& inputs = data_set_pointer->get_selection_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
 
-      for(i = 0; i < (int)selection_instances_number; i++)
-      {
-          selection_index = selection_indices[i];
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-         // Input vector
+   // Mean squared error stuff
 
-         inputs = data_set_pointer->get_instance(selection_index, inputs_indices);
+   const double sum_squared_error = outputs.calculate_sum_squared_error(targets);
 
-         // Output vector
+   return(sum_squared_error/(double)selection_instances_number);
+}
 
-         outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-         // Target vector
+// Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const method
 
-         targets = data_set_pointer->get_instance(selection_index, targets_indices);
+Vector<double> MeanSquaredError::calculate_output_gradient(const Vector<double>& output, const Vector<double>& target) const
+{
+    const Instances& instances = data_set_pointer->get_instances();
 
-         // Sum of squares error
+    const size_t training_instances_number = instances.count_training_instances_number();
 
-         selection_loss += outputs.calculate_sum_squared_error(targets);
-      }
+    const Vector<double> output_gradient = (output-target)*(2.0/(double)training_instances_number);
 
-      return(selection_loss/(double)selection_instances_number);
+    return(output_gradient);
 }
 
 
-// Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const method
+// Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const method
 
-Vector<double> MeanSquaredError::calculate_output_gradient(const Vector<double>& output, const Vector<double>& target) const
+/// Returns the mean squared error gradient with respect to the outputs, for a batch of instances.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of targets. Each row corresponds to one instance.
+
+Matrix<double> MeanSquaredError::calculate_output_gradient(const Matrix<double>& outputs, const Matrix<double>& targets) const
 {
     const Instances& instances = data_set_pointer->get_instances();
 
     const size_t training_instances_number = instances.count_training_instances_number();
 
-    const Vector<double> output_gradient = (output-target)*(2.0/(double)training_instances_number);
-
-    return(output_gradient);
+    return((outputs-targets)*(2.0/(double)training_instances_number));
 }
 
 
@@ -472,26 +398,39 @@ Matrix<double> MeanSquaredError::calculate_output_Hessian(const Vector<double>&,
 }
 
 
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the contribution of a batch of instances to the mean squared error,
+/// which is its sum squared error divided by the number of training instances.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
+
+double MeanSquaredError::calculate_batch_error(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    const Instances& instances = data_set_pointer->get_instances();
+
+    const size_t training_instances_number = instances.count_training_instances_number();
+
+    return(outputs.calculate_sum_squared_error(targets)/(double)training_instances_number);
+}
+
+
 // FirstOrderPerformance calculate_first_order_loss(void) const method
 
-/// @todo
+/// Returns the mean squared error and its gradient on the training instances,
+/// both computed from a single forward propagation of the instances.
 
 ErrorTerm::FirstOrderPerformance MeanSquaredError::calculate_first_order_loss(void) const
 {
-    // Control sentence
-
     #ifdef __OPENNN_DEBUG__
 
     check();
 
     #endif
 
-   FirstOrderPerformance first_order_loss;
-
-   first_order_loss.loss = calculate_error();
-   first_order_loss.gradient = calculate_gradient();
+    const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-   return(first_order_loss);
+    return(calculate_batch_first_order_loss(training_indices));
 }
 
 
@@ -509,10 +448,12 @@ ErrorTerm::SecondOrderPerformance MeanSquaredError::calculate_second_order_loss(
 
     #endif
 
+   const FirstOrderPerformance first_order_loss = calculate_first_order_loss();
+
    SecondOrderPerformance second_order_loss;
 
-   second_order_loss.loss = calculate_error();
-   second_order_loss.gradient = calculate_gradient();
+   second_order_loss.loss = first_order_loss.loss;
+   second_order_loss.gradient = first_order_loss.gradient;
    second_order_loss.Hessian = calculate_Hessian();
 
    return(second_order_loss);
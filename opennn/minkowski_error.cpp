@@ -263,53 +263,40 @@ double MinkowskiError::calculate_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
+   // Data set stuff
 
-   // Data set
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-   const Instances& instances = data_set_pointer->get_instances();
+      return(calculate_instances_error(training_indices, multilayer_perceptron_pointer->arrange_parameters()));
+   }
 
-   const size_t training_instances_number = instances.count_training_instances_number();
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-   size_t training_index;
+   // Minkowski error stuff
 
-   const Variables& variables = data_set_pointer->get_variables();
+   const size_t rows_number = outputs.get_rows_number();
+   const size_t columns_number = outputs.get_columns_number();
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+   Vector<double> rows_sum(rows_number, 0.0);
 
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
+   for(size_t j = 0; j < columns_number; j++)
+   {
+      for(size_t i = 0; i < rows_number; i++)
+      {
+         rows_sum[i] += pow(fabs(outputs(i,j) - targets(i,j)), Minkowski_parameter);
+      }
+   }
 
    double Minkowski_error = 0.0;
 
-   int i = 0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : Minkowski_error)
-
-   for(i = 0; i < (int)training_instances_number; i++)
-   {       
-       training_index = training_indices[i];
-
-      // Input vector
-
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
-
-      // Target vector
-
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
-
-      // Minkowski error
-
-      Minkowski_error += (outputs-targets).calculate_p_norm(Minkowski_parameter);
+   for(size_t i = 0; i < rows_number; i++)
+   {
+      Minkowski_error += pow(rows_sum[i], 1.0/Minkowski_parameter);
    }
 
    return(Minkowski_error);
@@ -355,52 +342,40 @@ double MinkowskiError::calculate_error(const Vector<double>& parameters) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
-   // Data set
-
-   const Instances& instances = data_set_pointer->get_instances();
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
+   // Data set stuff
 
-   size_t training_index;
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-   const Variables& variables = data_set_pointer->get_variables();
+      return(calculate_instances_error(training_indices, parameters));
+   }
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
-   double Minkowski_error = 0.0;
+   // Minkowski error stuff
 
-   int i = 0;
+   const size_t rows_number = outputs.get_rows_number();
+   const size_t columns_number = outputs.get_columns_number();
 
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : Minkowski_error)
+   Vector<double> rows_sum(rows_number, 0.0);
 
-   for(i = 0; i < (int)training_instances_number; i++)
+   for(size_t j = 0; j < columns_number; j++)
    {
-       training_index = training_indices[i];
-
-      // Input vector
-
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
-
-      // Target vector
-
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+      for(size_t i = 0; i < rows_number; i++)
+      {
+         rows_sum[i] += pow(fabs(outputs(i,j) - targets(i,j)), Minkowski_parameter);
+      }
+   }
 
-      // Minkowski error
+   double Minkowski_error = 0.0;
 
-      Minkowski_error += (outputs-targets).calculate_p_norm(Minkowski_parameter);
+   for(size_t i = 0; i < rows_number; i++)
+   {
+      Minkowski_error += pow(rows_sum[i], 1.0/Minkowski_parameter);
    }
 
    return(Minkowski_error);
@@ -426,69 +401,114 @@ double MinkowskiError::calculate_selection_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
-   // Data set
+   // Data set stuff
 
    const Instances& instances = data_set_pointer->get_instances();
 
    const size_t selection_instances_number = instances.count_selection_instances_number();
 
-   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
+   if(selection_instances_number == 0)
+   {
+      return(0.0);
+   }
 
-   size_t selection_index;
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> selection_indices = data_set_pointer->get_instances().arrange_selection_indices();
 
-   const Variables& variables = data_set_pointer->get_variables();
+      return(calculate_instances_error(selection_indices, multilayer_perceptron_pointer->arrange_parameters()));
+   }
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+   const Matrix<double>& inputs = data_set_pointer->get_selection_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
 
-   // Loss index
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
+   // Minkowski error stuff
 
-   double selection_loss = 0.0;
+   const size_t rows_number = outputs.get_rows_number();
+   const size_t columns_number = outputs.get_columns_number();
 
-   int i = 0;
+   Vector<double> rows_sum(rows_number, 0.0);
 
-   #pragma omp parallel for private(i, selection_index, inputs, outputs, targets) reduction(+ : selection_loss)
+   for(size_t j = 0; j < columns_number; j++)
+   {
+      for(size_t i = 0; i < rows_number; i++)
+      {
+         rows_sum[i] += pow(fabs(outputs(i,j) - targets(i,j)), Minkowski_parameter);
+      }
+   }
+
+   double selection_loss = 0.0;
 
-   for(i = 0; i < (int)selection_instances_number; i++)
+   for(size_t i = 0; i < rows_number; i++)
    {
-       selection_index = selection_indices[i];
+      selection_loss += pow(rows_sum[i], 1.0/Minkowski_parameter);
+   }
+
+   return(selection_loss);
+}
+
+
+// Vector<double> calculate_output_gradient(const Vector<double>&, conts Vector<double>&) const method
+
+/// Returns the Minkowski error function output gradient of a multilayer perceptron on a data set.
+/// It uses the error back-propagation method.
 
-      // Input vector
+Vector<double> MinkowskiError::calculate_output_gradient(const Vector<double>& output, const Vector<double>& target) const
+{
+    return (output-target).calculate_p_norm_gradient(Minkowski_parameter);
+}
 
-      inputs = data_set_pointer->get_instance(selection_index, inputs_indices);
 
-      // Output vector
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
 
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+/// Returns the Minkowski error of a batch of instances.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
 
-      // Target vector
+double MinkowskiError::calculate_batch_error(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+   const size_t rows_number = outputs.get_rows_number();
+   const size_t columns_number = outputs.get_columns_number();
 
-      targets = data_set_pointer->get_instance(selection_index, targets_indices);
+   Vector<double> rows_sum(rows_number, 0.0);
 
-      // Minkowski error
+   for(size_t j = 0; j < columns_number; j++)
+   {
+      for(size_t i = 0; i < rows_number; i++)
+      {
+         rows_sum[i] += pow(fabs(outputs(i,j) - targets(i,j)), Minkowski_parameter);
+      }
+   }
+
+   double Minkowski_error = 0.0;
 
-      selection_loss += (outputs-targets).calculate_p_norm(Minkowski_parameter);
+   for(size_t i = 0; i < rows_number; i++)
+   {
+      Minkowski_error += pow(rows_sum[i], 1.0/Minkowski_parameter);
    }
 
-   return(selection_loss);
+   return(Minkowski_error);
 }
 
 
-// Vector<double> calculate_output_gradient(const Vector<double>&, conts Vector<double>&) const method
+// FirstOrderPerformance calculate_first_order_loss(void) const method
 
-/// Returns the Minkowski error function output gradient of a multilayer perceptron on a data set.
-/// It uses the error back-propagation method.
+/// Returns the Minkowski error and its gradient on the training instances,
+/// both computed from a single forward propagation of the instances.
 
-Vector<double> MinkowskiError::calculate_output_gradient(const Vector<double>& output, const Vector<double>& target) const
+ErrorTerm::FirstOrderPerformance MinkowskiError::calculate_first_order_loss(void) const
 {
-    return (output-target).calculate_p_norm_gradient(Minkowski_parameter);
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
+
+    return(calculate_batch_first_order_loss(training_indices));
 }
 
 
@@ -94,6 +94,10 @@ public:
    Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const;
    Matrix<double> calculate_output_Hessian(const Vector<double>&, const Vector<double>&) const;
 
+   double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const;
+
+   FirstOrderPerformance calculate_first_order_loss(void) const;
+
    std::string write_error_term_type(void) const;
 
    // Serialization methods
@@ -102,6 +102,8 @@ MissingValues& MissingValues::operator=(const MissingValues& other_missing_value
         items = other_missing_values.items;
 
         display = other_missing_values.display;
+
+        invalidate_indices();
     }
 
     return(*this);
@@ -160,17 +162,13 @@ size_t MissingValues::get_variables_number(void) const
 
 Vector<size_t> MissingValues::get_missing_values_numbers(void) const
 {
-    Vector<size_t> missing_values_numbers(variables_number, 0);
+    const Indices& missing_indices = get_indices();
 
-    const size_t missing_values_number = get_missing_values_number();
-
-    size_t variable_index;
+    Vector<size_t> missing_values_numbers(variables_number, 0);
 
-    for(size_t i = 0; i < missing_values_number; i++)
+    for(size_t i = 0; i < variables_number; i++)
     {
-        variable_index = items[i].variable_index;
-
-        missing_values_numbers[variable_index]++;
+        missing_values_numbers[i] = missing_indices.variables_offsets[i+1] - missing_indices.variables_offsets[i];
     }
 
     return(missing_values_numbers);
@@ -405,6 +403,8 @@ void MissingValues::set_display(const bool& new_display)
 void MissingValues::set_items(const Vector<Item>& new_items)
 {
     items = new_items;
+
+    invalidate_indices();
 }
 
 
@@ -457,6 +457,8 @@ void MissingValues::set_item(const size_t& index, const size_t& instance_index,
 
     items[index].instance_index = instance_index;
     items[index].variable_index = variable_index;
+
+    invalidate_indices();
 }
 
 
@@ -497,6 +499,8 @@ void MissingValues::append(const size_t& instance_index, const size_t& variable_
     Item item(instance_index, variable_index);
 
     items.push_back(item);
+
+    invalidate_indices();
 }
 
 
@@ -508,6 +512,8 @@ void MissingValues::append(const size_t& instance_index, const size_t& variable_
 void MissingValues::set_missing_values_number(const size_t& new_missing_values_number)
 {
     items.set(new_missing_values_number);
+
+    invalidate_indices();
 }
 
 
@@ -580,17 +586,14 @@ bool MissingValues::has_missing_values(const size_t& instance_index) const
         return(false);
     }
 
-    const size_t missing_values_number = get_missing_values_number();
+    const Indices& missing_indices = get_indices();
 
-    for(size_t i = 0; i < missing_values_number; i++)
+    if(instance_index+1 >= missing_indices.instances_offsets.size())
     {
-        if(items[i].instance_index == instance_index)
-        {
-            return(true);
-        }
+        return(false);
     }
 
-    return(false);
+    return(missing_indices.instances_offsets[instance_index+1] != missing_indices.instances_offsets[instance_index]);
 }
 
 
@@ -603,21 +606,23 @@ bool MissingValues::has_missing_values(const size_t& instance_index) const
 
 bool MissingValues::has_missing_values(const size_t& instance_index, const Vector<size_t>& variables_indices) const
 {
-    const size_t missing_values_number = get_missing_values_number();
+    if(!has_missing_values(instance_index))
+    {
+        return(false);
+    }
+
+    const Indices& missing_indices = get_indices();
+
+    const size_t* begin = missing_indices.variables.data() + missing_indices.instances_offsets[instance_index];
+    const size_t* end = missing_indices.variables.data() + missing_indices.instances_offsets[instance_index+1];
 
     const size_t variables_number = variables_indices.size();
 
-    for(size_t i = 0; i < missing_values_number; i++)
+    for(size_t j = 0; j < variables_number; j++)
     {
-        if(items[i].instance_index == instance_index)
+        if(std::binary_search(begin, end, variables_indices[j]))
         {
-            for(size_t j = 0; j < variables_number; j++)
-            {
-                if(items[i].variable_index == variables_indices[j])
-                {
-                    return(true);
-                }
-            }
+            return(true);
         }
     }
 
@@ -633,40 +638,37 @@ bool MissingValues::has_missing_values(const size_t& instance_index, const Vecto
 
 bool MissingValues::is_missing_value(const size_t& instance_index, const size_t& variable_index) const
 {
-    if(items.empty())
+    if(!has_missing_values(instance_index))
     {
         return(false);
     }
 
-    const size_t missing_values_number = get_missing_values_number();
+    const Indices& missing_indices = get_indices();
 
-    for(size_t i = 0; i < missing_values_number; i++)
-    {
-        if(items[i].instance_index == instance_index && items[i].variable_index == variable_index)
-        {
-            return(true);
-        }
-    }
+    const size_t* begin = missing_indices.variables.data() + missing_indices.instances_offsets[instance_index];
+    const size_t* end = missing_indices.variables.data() + missing_indices.instances_offsets[instance_index+1];
 
-    return(false);
+    return(std::binary_search(begin, end, variable_index));
 }
 
 
 // Vector<size_t> arrange_missing_instances(void) const method
 
-/// Returns a vector with the indices of those instances with missing values.
+/// Returns a vector with the indices of those instances with missing values, in ascending order.
 
 Vector<size_t> MissingValues::arrange_missing_instances(void) const
 {
-    const size_t missing_values_number = get_missing_values_number();
+    const Indices& missing_indices = get_indices();
+
+    const size_t indexed_instances_number = missing_indices.instances_offsets.size() - 1;
 
     Vector<size_t> missing_instances;
 
-    for(size_t i = 0; i < missing_values_number; i++)
+    for(size_t i = 0; i < indexed_instances_number; i++)
     {
-        if(!missing_instances.contains(items[i].instance_index))
+        if(missing_indices.instances_offsets[i+1] != missing_indices.instances_offsets[i])
         {
-            missing_instances.push_back(items[i].instance_index);
+            missing_instances.push_back(i);
         }
     }
 
@@ -674,31 +676,68 @@ Vector<size_t> MissingValues::arrange_missing_instances(void) const
 }
 
 
+// Vector<size_t> arrange_missing_instances(const size_t&) const method
+
+/// Returns a vector with the indices of the instances with a missing value in a given variable, in ascending order.
+/// @param variable_index Index of variable.
+
+Vector<size_t> MissingValues::arrange_missing_instances(const size_t& variable_index) const
+{
+    const Indices& missing_indices = get_indices();
+
+    if(variable_index+1 >= missing_indices.variables_offsets.size())
+    {
+        return(Vector<size_t>());
+    }
+
+    const size_t begin = missing_indices.variables_offsets[variable_index];
+    const size_t end = missing_indices.variables_offsets[variable_index+1];
+
+    return(Vector<size_t>(missing_indices.instances.begin() + begin, missing_indices.instances.begin() + end));
+}
+
+
 // size_t count_missing_instances(void) const method
 
 /// Returns the number of instances with missing values.
 
 size_t MissingValues::count_missing_instances(void) const
 {
-    return(arrange_missing_instances().size());
+    const Indices& missing_indices = get_indices();
+
+    const size_t indexed_instances_number = missing_indices.instances_offsets.size() - 1;
+
+    size_t count = 0;
+
+    for(size_t i = 0; i < indexed_instances_number; i++)
+    {
+        if(missing_indices.instances_offsets[i+1] != missing_indices.instances_offsets[i])
+        {
+            count++;
+        }
+    }
+
+    return(count);
 }
 
 
 // Vector<size_t> arrange_missing_variables(void) const method
 
-/// Returns a vector with the indices of those variables with missing values.
+/// Returns a vector with the indices of those variables with missing values, in ascending order.
 
 Vector<size_t> MissingValues::arrange_missing_variables(void) const
 {
-    const size_t missing_values_number = get_missing_values_number();
+    const Indices& missing_indices = get_indices();
+
+    const size_t indexed_variables_number = missing_indices.variables_offsets.size() - 1;
 
     Vector<size_t> missing_variables;
 
-    for(size_t i = 0; i < missing_values_number; i++)
+    for(size_t i = 0; i < indexed_variables_number; i++)
     {
-        if(!missing_variables.contains(items[i].variable_index))
+        if(missing_indices.variables_offsets[i+1] != missing_indices.variables_offsets[i])
         {
-            missing_variables.push_back(items[i].variable_index);
+            missing_variables.push_back(i);
         }
     }
 
@@ -706,6 +745,27 @@ Vector<size_t> MissingValues::arrange_missing_variables(void) const
 }
 
 
+// Vector<size_t> arrange_missing_variables(const size_t&) const method
+
+/// Returns a vector with the indices of the variables with a missing value in a given instance, in ascending order.
+/// @param instance_index Index of instance.
+
+Vector<size_t> MissingValues::arrange_missing_variables(const size_t& instance_index) const
+{
+    const Indices& missing_indices = get_indices();
+
+    if(instance_index+1 >= missing_indices.instances_offsets.size())
+    {
+        return(Vector<size_t>());
+    }
+
+    const size_t begin = missing_indices.instances_offsets[instance_index];
+    const size_t end = missing_indices.instances_offsets[instance_index+1];
+
+    return(Vector<size_t>(missing_indices.variables.begin() + begin, missing_indices.variables.begin() + end));
+}
+
+
 // void convert_time_series(const size_t&) method
 
 /// @todo Complete method.
@@ -765,26 +825,130 @@ void MissingValues::convert_association(void)
 
 /// Returns a vector of vectors with the indices of the missing values for each variable.
 /// The size of the vector is the number of variables.
-/// The size of each subvector is the number of missing values for the corresponding variable.
+/// The size of each subvector is the number of missing values for the corresponding variable,
+/// and its instance indices are in ascending order.
 
 Vector< Vector<size_t> > MissingValues::arrange_missing_indices(void) const
 {
     Vector< Vector<size_t> > missing_indices(variables_number);
 
-    const size_t missing_values_number = get_missing_values_number();
+    for(size_t i = 0; i < variables_number; i++)
+    {
+        missing_indices[i] = arrange_missing_instances(i);
+    }
 
-    size_t variable_index;
-    size_t instance_index;
+    return(missing_indices);
+}
 
-    for(size_t i = 0; i < missing_values_number; i++)
+
+// const Indices& get_indices(void) const method
+
+/// Returns the missing values indexed by instance and by variable, arranging them from the items if they have changed.
+/// The indices are built with three stable counting sorts, in time linear in the number of missing values,
+/// instances and variables.
+/// The reference is valid until the items are modified.
+
+const MissingValues::Indices& MissingValues::get_indices(void) const
+{
+    #pragma omp critical(missing_values_indices)
     {
-        variable_index = items[i].variable_index;
-        instance_index = items[i].instance_index;
+        if(!indices.arranged)
+        {
+            const size_t missing_values_number = get_missing_values_number();
+
+            size_t indexed_instances_number = instances_number;
+            size_t indexed_variables_number = variables_number;
+
+            for(size_t i = 0; i < missing_values_number; i++)
+            {
+                indexed_instances_number = std::max(indexed_instances_number, items[i].instance_index+1);
+                indexed_variables_number = std::max(indexed_variables_number, items[i].variable_index+1);
+            }
+
+            // Items sorted by variable
+
+            Vector<size_t> variables_order(missing_values_number);
+
+            Vector<size_t> variables_offsets(indexed_variables_number+1, 0);
 
-        missing_indices[variable_index].push_back(instance_index);
+            for(size_t i = 0; i < missing_values_number; i++)
+            {
+                variables_offsets[items[i].variable_index+1]++;
+            }
+
+            for(size_t j = 0; j < indexed_variables_number; j++)
+            {
+                variables_offsets[j+1] += variables_offsets[j];
+            }
+
+            Vector<size_t> positions(variables_offsets.begin(), variables_offsets.end()-1);
+
+            for(size_t i = 0; i < missing_values_number; i++)
+            {
+                variables_order[positions[items[i].variable_index]++] = i;
+            }
+
+            // Items sorted by instance and then by variable
+
+            Vector<size_t> instances_order(missing_values_number);
+
+            Vector<size_t> instances_offsets(indexed_instances_number+1, 0);
+
+            for(size_t i = 0; i < missing_values_number; i++)
+            {
+                instances_offsets[items[i].instance_index+1]++;
+            }
+
+            for(size_t j = 0; j < indexed_instances_number; j++)
+            {
+                instances_offsets[j+1] += instances_offsets[j];
+            }
+
+            positions.assign(instances_offsets.begin(), instances_offsets.end()-1);
+
+            indices.variables.set(missing_values_number);
+
+            for(size_t i = 0; i < missing_values_number; i++)
+            {
+                const size_t item_index = variables_order[i];
+
+                const size_t position = positions[items[item_index].instance_index]++;
+
+                instances_order[position] = item_index;
+                indices.variables[position] = items[item_index].variable_index;
+            }
+
+            // Items sorted by variable and then by instance
+
+            positions.assign(variables_offsets.begin(), variables_offsets.end()-1);
+
+            indices.instances.set(missing_values_number);
+
+            for(size_t i = 0; i < missing_values_number; i++)
+            {
+                const size_t item_index = instances_order[i];
+
+                indices.instances[positions[items[item_index].variable_index]++] = items[item_index].instance_index;
+            }
+
+            indices.instances_offsets = instances_offsets;
+            indices.variables_offsets = variables_offsets;
+
+            indices.arranged = true;
+        }
     }
 
-    return(missing_indices);
+    return(indices);
+}
+
+
+// void invalidate_indices(void) method
+
+/// Marks the indices of the missing values as out of date, so that they are arranged again when they are needed.
+
+void MissingValues::invalidate_indices(void)
+{
+    indices.arranged = false;
 }
 
 
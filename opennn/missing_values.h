@@ -200,10 +200,12 @@ public:
    bool is_missing_value(const size_t&, const size_t&) const;
 
    Vector<size_t> arrange_missing_instances(void) const;
+   Vector<size_t> arrange_missing_instances(const size_t&) const;
 
    size_t count_missing_instances(void) const;
 
    Vector<size_t> arrange_missing_variables(void) const;
+   Vector<size_t> arrange_missing_variables(const size_t&) const;
 
    Vector< Vector<size_t> > arrange_missing_indices(void) const;
 
@@ -224,6 +226,47 @@ public:
 
 private:
 
+   // STRUCTURES
+
+   ///
+   /// This structure contains the missing values indexed by instance and by variable, in compressed sparse row format.
+   /// The missing variables of instance i are variables[instances_offsets[i]] to variables[instances_offsets[i+1]-1],
+   /// and the missing instances of variable j are instances[variables_offsets[j]] to instances[variables_offsets[j+1]-1],
+   /// both in ascending order.
+   ///
+
+   struct Indices
+   {
+      /// Default constructor.
+
+      Indices(void)
+      {
+         arranged = false;
+      }
+
+      /// Positions in the variables vector where the missing values of each instance start.
+      /// The size is the number of indexed instances plus one.
+
+      Vector<size_t> instances_offsets;
+
+      /// Variables of the missing values, grouped by instance.
+
+      Vector<size_t> variables;
+
+      /// Positions in the instances vector where the missing values of each variable start.
+      /// The size is the number of indexed variables plus one.
+
+      Vector<size_t> variables_offsets;
+
+      /// Instances of the missing values, grouped by variable.
+
+      Vector<size_t> instances;
+
+      /// True if the indices correspond to the current items, and false if they must be arranged again.
+
+      bool arranged;
+   };
+
    // MEMBERS
 
    /// Number of instances.
@@ -245,6 +288,16 @@ private:
    /// Display messages to screen.
    
    bool display;
+
+   /// Missing values indexed by instance and by variable, arranged on demand from the items.
+
+   mutable Indices indices;
+
+   // METHODS
+
+   const Indices& get_indices(void) const;
+
+   void invalidate_indices(void);
 };
 
 }
@@ -434,6 +434,11 @@ size_t MultilayerPerceptron::count_parameters_number(void) const
 
 Vector<double> MultilayerPerceptron::arrange_parameters(void) const
 {
+    if(are_layers_parameters_bound())
+    {
+        return(parameters_buffer);
+    }
+
     const size_t layers_number = get_layers_number();
 
     const size_t parameters_number = count_parameters_number();
@@ -454,6 +459,66 @@ Vector<double> MultilayerPerceptron::arrange_parameters(void) const
     return(parameters);
 }
 
+
+// Vector<float> arrange_single_precision_parameters(void) const method
+
+/// Returns the values of all the biases and synaptic weights in the multilayer perceptron as a single vector,
+/// rounded to single precision.
+/// It is arranged as the vector returned by arrange_parameters, and it is meant to be computed once
+/// and reused for many single precision propagations.
+
+Vector<float> MultilayerPerceptron::arrange_single_precision_parameters(void) const
+{
+    const size_t layers_number = get_layers_number();
+
+    const size_t parameters_number = count_parameters_number();
+
+    Vector<float> parameters(parameters_number);
+
+    size_t position = 0;
+
+    for(size_t i = 0; i < layers_number; i++)
+    {
+        const double* layer_parameters = layers[i].get_parameters_data();
+        const size_t layer_parameters_number = layers[i].count_parameters_number();
+
+        std::copy(layer_parameters, layer_parameters + layer_parameters_number, parameters.begin() + position);
+
+        position += layer_parameters_number;
+    }
+
+    return(parameters);
+}
+
+
+// bool are_layers_parameters_bound(void) const method
+
+/// Returns true if the parameters of all the layers are bound, in order, to the single parameters buffer
+/// of this multilayer perceptron, and false otherwise.
+/// Copying or resizing a layer moves its parameters out of that buffer.
+
+bool MultilayerPerceptron::are_layers_parameters_bound(void) const
+{
+    const size_t layers_number = get_layers_number();
+
+    size_t position = 0;
+
+    for(size_t i = 0; i < layers_number; i++)
+    {
+        const size_t layer_parameters_number = layers[i].count_parameters_number();
+
+        if(layer_parameters_number != 0 && layers[i].get_parameters_data() != parameters_buffer.data() + position)
+        {
+            return(false);
+        }
+
+        position += layer_parameters_number;
+    }
+
+    return(position == parameters_buffer.size());
+}
+
+
 // Vector<double> arrange_parameters_statistics(void) const method
 
 /// Returns the statistics of all the biases and synaptic weights in the multilayer perceptron.
@@ -602,7 +667,7 @@ size_t MultilayerPerceptron::get_layer_bias_index(const size_t& layer_index, con
 
     for(size_t j = 0; j < perceptron_index; j++)
     {
-        layer_bias_index += layers[layer_index].get_perceptron(j).count_parameters_number();
+        layer_bias_index += layers[layer_index].count_perceptron_parameters_number();
     }
 
     return(layer_bias_index);
@@ -682,7 +747,7 @@ size_t MultilayerPerceptron::get_layer_synaptic_weight_index
     {
         for(size_t i = 0; i < perceptron_index-1; i++)
         {
-            layer_synaptic_weight_index += layers[layer_index].get_perceptron(i).count_parameters_number();
+            layer_synaptic_weight_index += layers[layer_index].count_perceptron_parameters_number();
         }
     }
 
@@ -752,7 +817,7 @@ Matrix<size_t> MultilayerPerceptron::arrange_parameters_indices(void) const
     {
         for(size_t j = 0; j < layers_size[i]; j++)
         {
-            perceptron_parameters_number = layers[i].get_perceptron(j).count_parameters_number();
+            perceptron_parameters_number = layers[i].count_perceptron_parameters_number();
 
             for(size_t k = 0; k < perceptron_parameters_number; k++)
             {
@@ -1330,23 +1395,52 @@ void MultilayerPerceptron::set_parameters(const Vector<double>& new_parameters)
 
 #endif
 
+    get_parameters_span().assign(new_parameters);
+}
+
+
+// void bind_layers_parameters(void) method
+
+/// Builds a single contiguous buffer with all the biases and synaptic weights of the multilayer perceptron,
+/// and binds the parameters of every layer to consecutive positions of it.
+/// The current values of the parameters are preserved.
+
+void MultilayerPerceptron::bind_layers_parameters(void)
+{
     const size_t layers_number = get_layers_number();
 
-    size_t layer_parameters_number;
-    Vector<double> layer_parameters;
+    Vector<double> new_parameters_buffer(count_parameters_number());
 
     size_t position = 0;
 
     for(size_t i = 0; i < layers_number; i++)
     {
-        layer_parameters_number = layers[i].count_parameters_number();
-        layer_parameters = layers[i].arrange_parameters();
+        layers[i].bind_parameters(new_parameters_buffer.data() + position);
 
-        layer_parameters = new_parameters.take_out(position, layer_parameters_number);
+        position += layers[i].count_parameters_number();
+    }
 
-        layers[i].set_parameters(layer_parameters);
-        position += layer_parameters_number;
+    // Swapping keeps the addresses the layers are bound to
+
+    parameters_buffer.swap(new_parameters_buffer);
+}
+
+
+// VectorSpan<double> get_parameters_span(void) method
+
+/// Returns a handle to the single buffer with all the biases and synaptic weights of the multilayer perceptron.
+/// Writing through it modifies the parameters of the layers in place, without any gather or scatter.
+/// The layers are bound to that buffer first if needed.
+/// The handle is invalidated by any change in the architecture of the multilayer perceptron.
+
+VectorSpan<double> MultilayerPerceptron::get_parameters_span(void)
+{
+    if(!are_layers_parameters_bound())
+    {
+        bind_layers_parameters();
     }
+
+    return(VectorSpan<double>(parameters_buffer.data(), parameters_buffer.size()));
 }
 
 
@@ -2879,6 +2973,210 @@ Vector< Matrix<double> > MultilayerPerceptron::calculate_Hessian_form(const Vect
 }
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&) const method
+
+/// Returns the outputs of the multilayer perceptron for a batch of inputs.
+/// Each layer is evaluated for the whole batch at once, with a matrix product and an element-wise activation.
+/// @param inputs Matrix of inputs to the first layer. Each row contains one input vector.
+
+Matrix<double> MultilayerPerceptron::calculate_outputs(const Matrix<double>& inputs) const
+{
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    const size_t columns_number = inputs.get_columns_number();
+
+    const size_t inputs_number = get_inputs_number();
+
+    if(columns_number != inputs_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "Matrix<double> calculate_outputs(const Matrix<double>&) const method.\n"
+               << "Number of columns of inputs (" << columns_number <<") must be equal to number of inputs (" << inputs_number << ").\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    const size_t layers_number = get_layers_number();
+
+    Matrix<double> outputs;
+
+    if(layers_number == 0)
+    {
+        return(outputs);
+    }
+
+    outputs = layers[0].calculate_outputs(inputs);
+
+    for(size_t i = 1; i < layers_number; i++)
+    {
+        outputs = layers[i].calculate_outputs(outputs);
+    }
+
+    return(outputs);
+}
+
+
+// Matrix<double> calculate_outputs(const Matrix<double>&, const Vector<double>&) const method
+
+/// Returns which would be the outputs of the multilayer perceptron for a batch of inputs and a set of parameters.
+/// @param inputs Matrix of inputs to the first layer. Each row contains one input vector.
+/// @param parameters Vector of potential parameters of the multilayer perceptron.
+
+Matrix<double> MultilayerPerceptron::calculate_outputs(const Matrix<double>& inputs, const Vector<double>& parameters) const
+{
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    const size_t columns_number = inputs.get_columns_number();
+
+    const size_t inputs_number = get_inputs_number();
+
+    if(columns_number != inputs_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "Matrix<double> calculate_outputs(const Matrix<double>&, const Vector<double>&) const method.\n"
+               << "Number of columns of inputs (" << columns_number <<") must be equal to number of inputs (" << inputs_number << ").\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    const size_t parameters_size = parameters.size();
+
+    const size_t parameters_number = count_parameters_number();
+
+    if(parameters_size != parameters_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "Matrix<double> calculate_outputs(const Matrix<double>&, const Vector<double>&) const method.\n"
+               << "Size of parameters (" << parameters_size <<") must be equal to number of parameters (" << parameters_number << ").\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    const size_t layers_number = get_layers_number();
+
+    Matrix<double> outputs;
+
+    if(layers_number == 0)
+    {
+        return(outputs);
+    }
+
+    const Vector<size_t> layers_parameters_numbers = count_layers_parameters_numbers();
+
+    const Vector<size_t> layers_cumulative_parameters_number = arrange_layers_cumulative_parameters_number();
+
+    Vector<double> layer_parameters = parameters.take_out(0, layers_parameters_numbers[0]);
+
+    outputs = layers[0].calculate_outputs(inputs, layer_parameters);
+
+    for(size_t i = 1; i < layers_number; i++)
+    {
+        layer_parameters = parameters.take_out(layers_cumulative_parameters_number[i-1], layers_parameters_numbers[i]);
+
+        outputs = layers[i].calculate_outputs(outputs, layer_parameters);
+    }
+
+    return(outputs);
+}
+
+
+// Matrix<float> calculate_outputs(const Matrix<float>&) const method
+
+/// Returns the outputs of the multilayer perceptron for a batch of inputs, computed in single precision.
+/// The parameters are rounded to single precision for this call only.
+/// When many batches are to be evaluated, it is cheaper to arrange the single precision parameters once
+/// and to use the method with a parameters argument.
+/// @param inputs Matrix of inputs to the first layer. Each row contains one input vector.
+
+Matrix<float> MultilayerPerceptron::calculate_outputs(const Matrix<float>& inputs) const
+{
+    return(calculate_outputs(inputs, arrange_single_precision_parameters()));
+}
+
+
+// Matrix<float> calculate_outputs(const Matrix<float>&, const Vector<float>&) const method
+
+/// Returns the outputs of the multilayer perceptron for a batch of inputs and a set of single precision parameters.
+/// All the products and activations are computed in single precision,
+/// which halves the memory traffic and doubles the width of the vector instructions with respect to double precision.
+/// @param inputs Matrix of inputs to the first layer. Each row contains one input vector.
+/// @param parameters Single precision parameters of the multilayer perceptron, arranged as in arrange_parameters.
+
+Matrix<float> MultilayerPerceptron::calculate_outputs(const Matrix<float>& inputs, const Vector<float>& parameters) const
+{
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    const size_t columns_number = inputs.get_columns_number();
+
+    const size_t inputs_number = get_inputs_number();
+
+    if(columns_number != inputs_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "Matrix<float> calculate_outputs(const Matrix<float>&, const Vector<float>&) const method.\n"
+               << "Number of columns of inputs (" << columns_number <<") must be equal to number of inputs (" << inputs_number << ").\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    const size_t parameters_size = parameters.size();
+
+    const size_t parameters_number = count_parameters_number();
+
+    if(parameters_size != parameters_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "Matrix<float> calculate_outputs(const Matrix<float>&, const Vector<float>&) const method.\n"
+               << "Size of parameters (" << parameters_size <<") must be equal to number of parameters (" << parameters_number << ").\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    const size_t layers_number = get_layers_number();
+
+    Matrix<float> outputs;
+
+    Matrix<float> combinations;
+
+    size_t position = 0;
+
+    for(size_t i = 0; i < layers_number; i++)
+    {
+        const Matrix<float>& layer_inputs = (i == 0) ? inputs : outputs;
+
+        layers[i].calculate_combinations(layer_inputs, parameters.data() + position, combinations);
+
+        layers[i].calculate_activations(combinations, outputs);
+
+        position += layers[i].count_parameters_number();
+    }
+
+    return(outputs);
+}
+
+
 // Vector< Vector<double> > arrange_layers_input(const Vector<double>&, const Vector< Vector<double> >&) const method
 
 /// Returns the layers inputs from the multilayer perceptron inputs and the layers outputs. 
@@ -3623,6 +3921,219 @@ Vector< Vector< Vector<double> > > MultilayerPerceptron::calculate_second_order_
 }
 
 
+// Vector< Vector< Matrix<double> > > calculate_first_order_forward_propagation(const Matrix<double>&) const method
+
+/// Returns the first order forward propagation quantities from the multilayer perceptron for a batch of inputs.
+/// The first index refers to the activation derivative order (0 for the activation and 1 for the activation derivative).
+/// The second index is the index of the layer.
+/// Each matrix has one row per instance and one column per neuron in the layer.
+/// @param inputs Matrix of inputs to the multilayer perceptron. Each row contains one input vector.
+
+Vector< Vector< Matrix<double> > > MultilayerPerceptron::calculate_first_order_forward_propagation(const Matrix<double>& inputs) const
+{
+    ForwardPropagationWorkspace<double> workspace(*this, inputs.get_rows_number());
+
+    calculate_first_order_forward_propagation(inputs, workspace);
+
+    Vector< Vector< Matrix<double> > > first_order_forward_propagation(2);
+
+    first_order_forward_propagation[0].swap(workspace.layers_activation);
+    first_order_forward_propagation[1].swap(workspace.layers_activation_derivative);
+
+    return(first_order_forward_propagation);
+}
+
+
+// void calculate_first_order_forward_propagation(const Matrix<double>&, ForwardPropagationWorkspace<double>&) const method
+
+/// Computes the first order forward propagation quantities for a batch of inputs, and writes them into a workspace.
+/// The matrices of the workspace are only reallocated when their size changes,
+/// so that propagating batches of the same size does not allocate memory.
+/// @param inputs Matrix of inputs to the multilayer perceptron. Each row contains one input vector.
+/// @param workspace Forward propagation workspace, which must have been set for this multilayer perceptron.
+
+void MultilayerPerceptron::calculate_first_order_forward_propagation(const Matrix<double>& inputs, ForwardPropagationWorkspace<double>& workspace) const
+{
+    const size_t layers_number = get_layers_number();
+
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    const size_t columns_number = inputs.get_columns_number();
+
+    const size_t inputs_number = get_inputs_number();
+
+    if(columns_number != inputs_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "void calculate_first_order_forward_propagation(const Matrix<double>&, ForwardPropagationWorkspace<double>&) const method.\n"
+               << "Number of columns must be equal to number of inputs.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    if(workspace.layers_activation.size() != layers_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "void calculate_first_order_forward_propagation(const Matrix<double>&, ForwardPropagationWorkspace<double>&) const method.\n"
+               << "Workspace must be set for this multilayer perceptron.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    for(size_t i = 0; i < layers_number; i++)
+    {
+        const Matrix<double>& layer_inputs = (i == 0) ? inputs : workspace.layers_activation[i-1];
+
+        layers[i].calculate_combinations(layer_inputs, workspace.layers_combination[i]);
+
+        layers[i].calculate_activations(workspace.layers_combination[i], workspace.layers_activation[i]);
+
+        layers[i].calculate_activations_derivatives(workspace.layers_combination[i], workspace.layers_activation_derivative[i]);
+    }
+}
+
+
+// void calculate_first_order_forward_propagation(const Matrix<float>&, const Vector<float>&, ForwardPropagationWorkspace<float>&) const method
+
+/// Computes in single precision the first order forward propagation quantities for a batch of inputs,
+/// and writes them into a single precision workspace.
+/// @param inputs Matrix of inputs to the multilayer perceptron. Each row contains one input vector.
+/// @param parameters Single precision parameters of the multilayer perceptron, arranged as in arrange_parameters.
+/// @param workspace Forward propagation workspace, which must have been set for this multilayer perceptron.
+
+void MultilayerPerceptron::calculate_first_order_forward_propagation(const Matrix<float>& inputs, const Vector<float>& parameters, ForwardPropagationWorkspace<float>& workspace) const
+{
+    const size_t layers_number = get_layers_number();
+
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    const size_t columns_number = inputs.get_columns_number();
+
+    const size_t inputs_number = get_inputs_number();
+
+    if(columns_number != inputs_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "void calculate_first_order_forward_propagation(const Matrix<float>&, const Vector<float>&, ForwardPropagationWorkspace<float>&) const method.\n"
+               << "Number of columns must be equal to number of inputs.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    if(parameters.size() != count_parameters_number())
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "void calculate_first_order_forward_propagation(const Matrix<float>&, const Vector<float>&, ForwardPropagationWorkspace<float>&) const method.\n"
+               << "Size of parameters must be equal to number of parameters.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    if(workspace.layers_activation.size() != layers_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultilayerPerceptron class.\n"
+               << "void calculate_first_order_forward_propagation(const Matrix<float>&, const Vector<float>&, ForwardPropagationWorkspace<float>&) const method.\n"
+               << "Workspace must be set for this multilayer perceptron.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    size_t position = 0;
+
+    for(size_t i = 0; i < layers_number; i++)
+    {
+        const Matrix<float>& layer_inputs = (i == 0) ? inputs : workspace.layers_activation[i-1];
+
+        layers[i].calculate_combinations(layer_inputs, parameters.data() + position, workspace.layers_combination[i]);
+
+        layers[i].calculate_activations(workspace.layers_combination[i], workspace.layers_activation[i]);
+
+        layers[i].calculate_activations_derivatives(workspace.layers_combination[i], workspace.layers_activation_derivative[i]);
+
+        position += layers[i].count_parameters_number();
+    }
+}
+
+
+// ForwardPropagationWorkspace structure
+
+/// Default constructor. It creates an empty workspace, which must be set before use.
+
+template <class T>
+MultilayerPerceptron::ForwardPropagationWorkspace<T>::ForwardPropagationWorkspace(void)
+{
+}
+
+
+/// Architecture constructor. It allocates the matrices of a workspace for a multilayer perceptron and a batch size.
+/// @param multilayer_perceptron Multilayer perceptron to be propagated.
+/// @param batch_instances_number Maximum number of instances in a batch.
+
+template <class T>
+MultilayerPerceptron::ForwardPropagationWorkspace<T>::ForwardPropagationWorkspace(const MultilayerPerceptron& multilayer_perceptron, const size_t& batch_instances_number)
+{
+    set(multilayer_perceptron, batch_instances_number);
+}
+
+
+/// Destructor.
+
+template <class T>
+MultilayerPerceptron::ForwardPropagationWorkspace<T>::~ForwardPropagationWorkspace(void)
+{
+}
+
+
+/// Sizes the matrices of the workspace for a multilayer perceptron and a batch size.
+/// @param multilayer_perceptron Multilayer perceptron to be propagated.
+/// @param batch_instances_number Maximum number of instances in a batch.
+
+template <class T>
+void MultilayerPerceptron::ForwardPropagationWorkspace<T>::set(const MultilayerPerceptron& multilayer_perceptron, const size_t& batch_instances_number)
+{
+    const size_t layers_number = multilayer_perceptron.get_layers_number();
+
+    const Vector<size_t> layers_perceptrons_number = multilayer_perceptron.arrange_layers_perceptrons_numbers();
+
+    layers_combination.set(layers_number);
+    layers_activation.set(layers_number);
+    layers_activation_derivative.set(layers_number);
+
+    if(batch_instances_number == 0)
+    {
+        return;
+    }
+
+    for(size_t i = 0; i < layers_number; i++)
+    {
+        layers_combination[i].set(batch_instances_number, layers_perceptrons_number[i]);
+        layers_activation[i].set(batch_instances_number, layers_perceptrons_number[i]);
+        layers_activation_derivative[i].set(batch_instances_number, layers_perceptrons_number[i]);
+    }
+}
+
+template struct MultilayerPerceptron::ForwardPropagationWorkspace<double>;
+template struct MultilayerPerceptron::ForwardPropagationWorkspace<float>;
+
+
 // std::string to_string(void) const method
 
 /// Returns a string representation of the current multilayer perceptron object. 
@@ -32,6 +32,7 @@
 
 #include "vector.h"
 #include "matrix.h"
+#include "vector_span.h"
 #include "numerical_differentiation.h"
 
 // TinyXml includes
@@ -88,6 +89,38 @@ public:
 
    bool operator == (const MultilayerPerceptron&) const;
 
+   // STRUCTURES
+
+   /// This structure holds the first order forward propagation quantities of a batch of instances.
+   /// It is sized once from the architecture and then reused from batch to batch,
+   /// so that repeated forward propagations do not allocate memory.
+   /// It is instantiated for double and float, the latter being used to propagate batches in single precision.
+   /// A workspace must not be shared between threads.
+
+   template <class T>
+   struct ForwardPropagationWorkspace
+   {
+      explicit ForwardPropagationWorkspace(void);
+
+      explicit ForwardPropagationWorkspace(const MultilayerPerceptron&, const size_t&);
+
+      virtual ~ForwardPropagationWorkspace(void);
+
+      void set(const MultilayerPerceptron&, const size_t&);
+
+      /// Combinations of all layers. Each matrix has one row per instance and one column per perceptron.
+
+      Vector< Matrix<T> > layers_combination;
+
+      /// Activations of all layers. Each matrix has one row per instance and one column per perceptron.
+
+      Vector< Matrix<T> > layers_activation;
+
+      /// Activation derivatives of all layers. Each matrix has one row per instance and one column per perceptron.
+
+      Vector< Matrix<T> > layers_activation_derivative;
+   };
+
    // GET METHODS
 
    /// Returns a vector with the architecture of the multilayer perceptron.
@@ -272,6 +305,9 @@ public:
 
    size_t count_parameters_number(void) const;
    Vector<double> arrange_parameters(void) const;   
+   Vector<float> arrange_single_precision_parameters(void) const;
+
+   bool are_layers_parameters_bound(void) const;
    
    Vector<double> arrange_parameters_statistics(void) const;
 
@@ -327,6 +363,10 @@ public:
 
    void set_parameters(const Vector<double>&);
 
+   void bind_layers_parameters(void);
+
+   VectorSpan<double> get_parameters_span(void);
+
    void initialize_biases(const double&); 
    void initialize_synaptic_weights(const double&);
    void initialize_parameters(const double&);
@@ -434,6 +474,10 @@ public:
    Vector< Vector< Vector<double> > > calculate_first_order_forward_propagation(const Vector<double>&) const;
    Vector< Vector< Vector<double> > > calculate_second_order_forward_propagation(const Vector<double>&) const;
 
+   Vector< Vector< Matrix<double> > > calculate_first_order_forward_propagation(const Matrix<double>&) const;
+   void calculate_first_order_forward_propagation(const Matrix<double>&, ForwardPropagationWorkspace<double>&) const;
+   void calculate_first_order_forward_propagation(const Matrix<float>&, const Vector<float>&, ForwardPropagationWorkspace<float>&) const;
+
    // Output 
 
    Vector<double> calculate_outputs(const Vector<double>&) const;
@@ -444,6 +488,12 @@ public:
    Matrix<double> calculate_Jacobian(const Vector<double>&, const Vector<double>&) const;
    Vector< Matrix<double> > calculate_Hessian_form(const Vector<double>&, const Vector<double>&) const;
 
+   Matrix<double> calculate_outputs(const Matrix<double>&) const;
+   Matrix<double> calculate_outputs(const Matrix<double>&, const Vector<double>&) const;
+
+   Matrix<float> calculate_outputs(const Matrix<float>&) const;
+   Matrix<float> calculate_outputs(const Matrix<float>&, const Vector<float>&) const;
+
    // Serialization methods
 
    tinyxml2::XMLDocument* to_XML(void) const;
@@ -479,6 +529,11 @@ protected:
 
    Vector<PerceptronLayer> layers;
 
+   /// Single contiguous buffer with all the biases and synaptic weights, to which the parameters of the layers are bound.
+   /// It is rebuilt whenever the architecture changes and the layers are no longer bound to it.
+
+   Vector<double> parameters_buffer;
+
    /// Display messages to screen. 
 
    bool display;
@@ -1603,6 +1603,48 @@ void NeuralNetwork::set_parameters(const Vector<double>& new_parameters)
 }
 
 
+// bool has_parameters_span(void) const method
+
+/// Returns true if all the parameters of the neural network are stored in a single contiguous buffer,
+/// which can be modified in place through get_parameters_span().
+/// That is the case when the neural network has a multilayer perceptron and no independent parameters.
+
+bool NeuralNetwork::has_parameters_span(void) const
+{
+    if(multilayer_perceptron_pointer && !independent_parameters_pointer)
+    {
+        return(true);
+    }
+    else
+    {
+        return(false);
+    }
+}
+
+
+// VectorSpan<double> get_parameters_span(void) method
+
+/// Returns a handle to the single buffer with all the parameters of the neural network.
+/// Writing through it modifies the parameters in place, without gathering or scattering them.
+/// The handle is invalidated by any change in the architecture of the neural network.
+
+VectorSpan<double> NeuralNetwork::get_parameters_span(void)
+{
+    if(!has_parameters_span())
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: NeuralNetwork class.\n"
+               << "VectorSpan<double> get_parameters_span(void) method.\n"
+               << "The parameters are only contiguous for a multilayer perceptron without independent parameters.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    return(multilayer_perceptron_pointer->get_parameters_span());
+}
+
+
 // void delete_pointers(void) method
 
 /// This method deletes all the pointers composing the neural network:
@@ -2919,17 +2961,17 @@ Vector<double> NeuralNetwork::calculate_outputs(const Vector<double>& inputs, co
 
 /// Calculates a set of outputs from the neural network in response to a set of inputs.
 /// The format is a matrix, where each row contains the output for a single input.
+/// All the inputs are propagated together through every layer, as a batch.
 /// @param input_data Matrix of inputs to the neural network. 
 
 Matrix<double> NeuralNetwork::calculate_output_data(const Matrix<double>& input_data) const
 {
-    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
     // Control sentence (if debug)
 
 #ifdef __OPENNN_DEBUG__
 
+    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
+
     const size_t columns_number = input_data.get_columns_number();
 
     if(columns_number != inputs_number)
@@ -2945,20 +2987,55 @@ Matrix<double> NeuralNetwork::calculate_output_data(const Matrix<double>& input_
 
 #endif
 
-    const size_t input_vectors_number = input_data.get_rows_number();
+    Matrix<double> output_data(input_data);
 
-    Matrix<double> output_data(input_vectors_number, outputs_number);
+    // Scaling layer
 
-    Vector<double> inputs(inputs_number);
-    Vector<double> outputs(outputs_number);
+    if(scaling_layer_pointer)
+    {
+        output_data = scaling_layer_pointer->calculate_outputs(input_data);
+    }
 
-#pragma omp parallel for private(inputs, outputs)
+    // Principal components layer
 
-    for(int i = 0; i < input_vectors_number; i++)
+    if(principal_components_layer_pointer)
     {
-        inputs = input_data.arrange_row(i);
-        outputs = calculate_outputs(inputs);
-        output_data.set_row(i, outputs);
+        output_data = principal_components_layer_pointer->calculate_outputs(output_data);
+    }
+
+    // Multilayer perceptron
+
+    if(multilayer_perceptron_pointer)
+    {
+        output_data = multilayer_perceptron_pointer->calculate_outputs(output_data);
+    }
+
+    // Conditions
+
+    if(conditions_layer_pointer)
+    {
+        output_data = conditions_layer_pointer->calculate_outputs(input_data, output_data);
+    }
+
+    // Unscaling layer
+
+    if(unscaling_layer_pointer)
+    {
+        output_data = unscaling_layer_pointer->calculate_outputs(output_data);
+    }
+
+    // Probabilistic layer
+
+    if(probabilistic_layer_pointer)
+    {
+        output_data = probabilistic_layer_pointer->calculate_outputs(output_data);
+    }
+
+    // Bounding layer
+
+    if(bounding_layer_pointer)
+    {
+        output_data = bounding_layer_pointer->calculate_outputs(output_data);
     }
 
     return(output_data);
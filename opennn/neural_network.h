@@ -245,6 +245,9 @@ public:
 
    void set_parameters(const Vector<double>&);
 
+   bool has_parameters_span(void) const;
+   VectorSpan<double> get_parameters_span(void);
+
    // Parameters initialization methods
 
    void initialize_parameters(const double&);
@@ -1270,6 +1270,8 @@ NewtonMethod::NewtonMethodResults* NewtonMethod::perform_training(void)
    Vector<double> gradient(parameters_number);
    double gradient_norm;
 
+   LossIndex::FirstOrderloss first_order_loss;
+
    Matrix<double> inverse_Hessian(parameters_number, parameters_number);
 
    // Training algorithm stuff 
@@ -1309,14 +1311,20 @@ NewtonMethod::NewtonMethodResults* NewtonMethod::perform_training(void)
       // Loss index stuff
 
       if(iteration == 0)
-      {      
-         loss = loss_index_pointer->calculate_loss();
-         loss_increase = 0.0; 
+      {
+         first_order_loss = loss_index_pointer->calculate_first_order_loss();
+
+         loss = first_order_loss.loss;
+         loss_increase = 0.0;
+
+         gradient = first_order_loss.gradient;
       }
       else
       {
          loss = directional_point[1];
-         loss_increase = old_loss - loss; 
+         loss_increase = old_loss - loss;
+
+         gradient = loss_index_pointer->calculate_gradient();
       }
 
       selection_loss = loss_index_pointer->calculate_selection_loss();
@@ -1330,8 +1338,6 @@ NewtonMethod::NewtonMethodResults* NewtonMethod::perform_training(void)
          selection_loss_increment = selection_loss - old_selection_loss;
       }
 
-      gradient = loss_index_pointer->calculate_gradient();
-
       gradient_norm = gradient.calculate_norm();
 
       if(display && gradient_norm >= warning_gradient_norm)
@@ -1628,6 +1634,8 @@ NewtonMethod::NewtonMethodResults* NewtonMethod::perform_training(void)
     Vector<double> old_gradient(parameters_number);
     double gradient_norm;
 
+    LossIndex::FirstOrderloss first_order_loss;
+
 //    Matrix<double> inverse_Hessian(parameters_number, parameters_number);
     Matrix<double> Hessian(parameters_number, parameters_number);
 
@@ -1680,16 +1688,20 @@ NewtonMethod::NewtonMethodResults* NewtonMethod::perform_training(void)
 
        if(iteration == 0)
        {
-          loss = loss_index_pointer->calculate_loss();
+          first_order_loss = loss_index_pointer->calculate_first_order_loss();
+
+          loss = first_order_loss.loss;
           loss_increase = 0.0;
+
+          gradient = first_order_loss.gradient;
        }
        else
        {
           loss = directional_point[1];
           loss_increase = old_loss - loss;
-       }
 
-       gradient = loss_index_pointer->calculate_gradient();
+          gradient = loss_index_pointer->calculate_gradient();
+       }
 
        gradient_norm = gradient.calculate_norm();
 
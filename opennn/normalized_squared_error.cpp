@@ -106,6 +106,152 @@ double NormalizedSquaredError::calculate_normalization_coefficient(const Matrix<
 }
 
 
+// double calculate_normalization_coefficient(const Vector<size_t>&, const Vector<double>&) const method
+
+/// Returns the normalization coefficient of a subset of instances, reading their targets by blocks of instances.
+/// It is used when the data set is out of core, so that the targets of the whole subset are never held in memory.
+/// @param instances_indices Indices of the instances in the data set.
+/// @param target_data_mean Mean values of the target variables on those instances.
+
+double NormalizedSquaredError::calculate_normalization_coefficient(const Vector<size_t>& instances_indices, const Vector<double>& target_data_mean) const
+{
+   const Vector<size_t> targets_indices = data_set_pointer->get_variables().arrange_targets_indices();
+
+   const size_t instances_number = instances_indices.size();
+
+   const size_t batch_size = 256;
+
+   double normalization_coefficient = 0.0;
+
+   Matrix<double> targets;
+
+   for(size_t first_index = 0; first_index < instances_number; first_index += batch_size)
+   {
+      const size_t batch_instances_number = std::min(batch_size, instances_number - first_index);
+
+      data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, targets_indices, targets);
+
+      normalization_coefficient += calculate_normalization_coefficient(targets, target_data_mean);
+   }
+
+   return(normalization_coefficient);
+}
+
+
+// double get_training_normalization_coefficient(void) const method
+
+/// Returns the normalization coefficient of the training instances.
+/// It is calculated the first time it is needed, and it is not calculated again until the data set,
+/// its instances or its variables change.
+
+double NormalizedSquaredError::get_training_normalization_coefficient(void) const
+{
+   const DataSetState data_set_state = get_data_set_state();
+
+   bool calculated;
+   double training_normalization_coefficient;
+
+   #pragma omp critical(normalized_squared_error_coefficients)
+   {
+      calculated = normalization_coefficients.training_calculated && data_set_state == normalization_coefficients.data_set_state;
+
+      training_normalization_coefficient = normalization_coefficients.training;
+   }
+
+   if(calculated)
+   {
+      return(training_normalization_coefficient);
+   }
+
+   const Vector<double> training_target_data_mean = data_set_pointer->calculate_training_target_data_mean();
+
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
+
+      training_normalization_coefficient = calculate_normalization_coefficient(training_indices, training_target_data_mean);
+   }
+   else
+   {
+      const Matrix<double>& targets = data_set_pointer->get_training_target_data();
+
+      training_normalization_coefficient = calculate_normalization_coefficient(targets, training_target_data_mean);
+   }
+
+   #pragma omp critical(normalized_squared_error_coefficients)
+   {
+      if(!(data_set_state == normalization_coefficients.data_set_state))
+      {
+         normalization_coefficients.data_set_state = data_set_state;
+         normalization_coefficients.training_calculated = false;
+         normalization_coefficients.selection_calculated = false;
+      }
+
+      normalization_coefficients.training = training_normalization_coefficient;
+      normalization_coefficients.training_calculated = true;
+   }
+
+   return(training_normalization_coefficient);
+}
+
+
+// double get_selection_normalization_coefficient(void) const method
+
+/// Returns the normalization coefficient of the selection instances.
+/// It is calculated the first time it is needed, and it is not calculated again until the data set,
+/// its instances or its variables change.
+
+double NormalizedSquaredError::get_selection_normalization_coefficient(void) const
+{
+   const DataSetState data_set_state = get_data_set_state();
+
+   bool calculated;
+   double selection_normalization_coefficient;
+
+   #pragma omp critical(normalized_squared_error_coefficients)
+   {
+      calculated = normalization_coefficients.selection_calculated && data_set_state == normalization_coefficients.data_set_state;
+
+      selection_normalization_coefficient = normalization_coefficients.selection;
+   }
+
+   if(calculated)
+   {
+      return(selection_normalization_coefficient);
+   }
+
+   const Vector<double> selection_target_data_mean = data_set_pointer->calculate_selection_target_data_mean();
+
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> selection_indices = data_set_pointer->get_instances().arrange_selection_indices();
+
+      selection_normalization_coefficient = calculate_normalization_coefficient(selection_indices, selection_target_data_mean);
+   }
+   else
+   {
+      const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
+
+      selection_normalization_coefficient = calculate_normalization_coefficient(targets, selection_target_data_mean);
+   }
+
+   #pragma omp critical(normalized_squared_error_coefficients)
+   {
+      if(!(data_set_state == normalization_coefficients.data_set_state))
+      {
+         normalization_coefficients.data_set_state = data_set_state;
+         normalization_coefficients.training_calculated = false;
+         normalization_coefficients.selection_calculated = false;
+      }
+
+      normalization_coefficients.selection = selection_normalization_coefficient;
+      normalization_coefficients.selection_calculated = true;
+   }
+
+   return(selection_normalization_coefficient);
+}
+
+
 // void check(void) const method
 
 /// Checks that there are a neural network and a data set associated to the normalized squared error, 
@@ -215,64 +361,29 @@ double NormalizedSquaredError::calculate_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
+   double sum_squared_error;
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   const Vector<double> training_target_data_mean = data_set_pointer->calculate_training_target_data_mean();
-
-   // Normalized squared error stuff 
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   int i = 0;
-
-   double sum_squared_error = 0.0;
-   double normalization_coefficient = 0.0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : sum_squared_error, normalization_coefficient)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-      // Input vector
-
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      // Target vector
-
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+      sum_squared_error = calculate_instances_error(training_indices, multilayer_perceptron_pointer->arrange_parameters());
+   }
+   else
+   {
+      const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+      const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      // Sum squared error
+      const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-      sum_squared_error += outputs.calculate_sum_squared_error(targets);
+      sum_squared_error = outputs.calculate_sum_squared_error(targets);
+   }
 
-	  // Normalization coefficient
+   // Normalized squared error stuff
 
-	  normalization_coefficient += targets.calculate_sum_squared_error(training_target_data_mean);
-   }
+   const double normalization_coefficient = get_training_normalization_coefficient();
 
    if(normalization_coefficient < 1.0e-99)
    {
@@ -329,63 +440,29 @@ double NormalizedSquaredError::calculate_error(const Vector<double>& parameters)
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
+   double sum_squared_error;
 
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   const Vector<double> training_target_data_mean = data_set_pointer->calculate_training_target_data_mean();
-
-   // Normalized squared error stuff
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   double sum_squared_error = 0.0;
-   double normalization_coefficient = 0.0;
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : sum_squared_error, normalization_coefficient)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-      // Input vector
-
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      // Target vector
-
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+      sum_squared_error = calculate_instances_error(training_indices, parameters);
+   }
+   else
+   {
+      const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+      const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      // Sum squared error
+      const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
-      sum_squared_error += outputs.calculate_sum_squared_error(targets);
+      sum_squared_error = outputs.calculate_sum_squared_error(targets);
+   }
 
-      // Normalization coefficient
+   // Normalized squared error stuff
 
-      normalization_coefficient += targets.calculate_sum_squared_error(training_target_data_mean);
-   }
+   const double normalization_coefficient = get_training_normalization_coefficient();
 
    if(normalization_coefficient < 1.0e-99)
    {
@@ -421,9 +498,6 @@ double NormalizedSquaredError::calculate_selection_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
    const Instances& instances = data_set_pointer->get_instances();
@@ -434,60 +508,35 @@ double NormalizedSquaredError::calculate_selection_error(void) const
    {
       return(0.0);
    }
-   
-   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
-
-   size_t selection_index;
 
-   const Variables& variables = data_set_pointer->get_variables();
+   double sum_squared_error;
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   const Vector<double> selection_target_data_mean = data_set_pointer->calculate_selection_target_data_mean();
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   double sum_squared_error = 0.0;
-   double normalization_coefficient = 0.0;
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, selection_index, inputs, outputs, targets) reduction(+ : sum_squared_error, normalization_coefficient)
-
-   for(i = 0; i < (int)selection_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       selection_index = selection_indices[i];
-
-      // Input vector
-
-      inputs = data_set_pointer->get_instance(selection_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
-
-      // Target vector
+      const Vector<size_t> selection_indices = data_set_pointer->get_instances().arrange_selection_indices();
 
-      targets = data_set_pointer->get_instance(selection_index, targets_indices);
+      sum_squared_error = calculate_instances_error(selection_indices, multilayer_perceptron_pointer->arrange_parameters());
+   }
+   else
+   {
+      const Matrix<double>& inputs = data_set_pointer->get_selection_input_data();
+      const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
 
-      // Sum squared error
+      const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-	  sum_squared_error += outputs.calculate_sum_squared_error(targets);
+      sum_squared_error = outputs.calculate_sum_squared_error(targets);
+   }
 
-	  // Normalization coefficient
+   // Normalized squared error stuff
 
-	  normalization_coefficient += targets.calculate_sum_squared_error(selection_target_data_mean);
-   }
+   const double normalization_coefficient = get_selection_normalization_coefficient();
 
    if(normalization_coefficient < 1.0e-99)
    {
       std::ostringstream buffer;
 
       buffer << "OpenNN Exception: NormalizedSquaredError class.\n"
-		     << "double calculate_selection_loss(void) const method.\n"
+             << "double calculate_selection_loss(void) const method.\n"
              << "Normalization coefficient is zero.\n"
              << "Unuse constant target variables or choose another error functional. ";
 
@@ -825,133 +874,123 @@ Vector<double> NormalizedSquaredError::calculate_gradient(void) const
 
    #endif
 
-   // Neural network stuff
-
-   const size_t parameters_number = neural_network_pointer->count_parameters_number();
-
-   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
-
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
-   const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
-
-   Vector< Vector< Vector<double> > > first_order_forward_propagation(2);
-
-   Vector< Vector<double> > layers_inputs(layers_number);
+   // Normalized squared error stuff
 
-   Vector< Matrix<double> > layers_combination_parameters_Jacobian;
+   const double normalization_coefficient = get_training_normalization_coefficient();
 
-   const bool has_conditions_layer = neural_network_pointer->has_conditions_layer();
+   if(normalization_coefficient < 1.0e-99)
+   {
+      std::ostringstream buffer;
 
-   const ConditionsLayer* conditions_layer_pointer = has_conditions_layer ? neural_network_pointer->get_conditions_layer_pointer() : NULL;
+      buffer << "OpenNN Exception: NormalizedSquaredError class.\n"
+             << "Vector<double> calculate_gradient(void) const method.\n"
+             << "Normalization coefficient is zero.\n"
+             << "Unuse constant target variables or choose another error functional. ";
 
-   Vector<double> particular_solution;
-   Vector<double> homogeneous_solution;
+      throw std::logic_error(buffer.str());
+   }
 
-   // Data set stuff
+   const Vector<double> gradient = ErrorTerm::calculate_gradient();
 
-   const Instances& instances = data_set_pointer->get_instances();
+   return(gradient/normalization_coefficient);
+}
 
-   const size_t training_instances_number = instances.count_training_instances_number();
 
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
+// Vector<double> calculate_batch_gradient(const Vector<size_t>&) const method
 
-   size_t training_index;
+/// Returns the contribution of a subset of instances to the normalized squared error gradient.
+/// The normalization coefficient is the one of all the training instances,
+/// so that the gradients of a partition of the training instances add up to the gradient.
+/// @param instances_indices Indices of the instances in the data set.
 
-   const Variables& variables = data_set_pointer->get_variables();
+Vector<double> NormalizedSquaredError::calculate_batch_gradient(const Vector<size_t>& instances_indices) const
+{
+   // Control sentence (if debug)
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+   #ifdef __OPENNN_DEBUG__
 
-   const Vector<double> training_target_data_mean = data_set_pointer->calculate_training_target_data_mean();
+   check();
 
-   Vector<double> inputs(inputs_number);
-   Vector<double> targets(outputs_number);
+   #endif
 
    // Normalized squared error stuff
 
-   Vector<double> output_gradient(outputs_number);
-
-   Vector< Vector<double> > layers_delta;
-
-   Vector<double> point_gradient(parameters_number, 0.0);
-
-   double normalization_coefficient = 0.0;
-
-   // Main loop
+   const double normalization_coefficient = get_training_normalization_coefficient();
 
-   Vector<double> gradient(parameters_number, 0.0);
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, training_index, inputs, targets, first_order_forward_propagation, layers_inputs, layers_combination_parameters_Jacobian,\
-    output_gradient, layers_delta, particular_solution, homogeneous_solution, point_gradient) \
-    reduction(+ : normalization_coefficient)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(normalization_coefficient < 1.0e-99)
    {
-       training_index = training_indices[i];
+      std::ostringstream buffer;
 
-      // Data set
+      buffer << "OpenNN Exception: NormalizedSquaredError class.\n"
+             << "Vector<double> calculate_batch_gradient(const Vector<size_t>&) const method.\n"
+             << "Normalization coefficient is zero.\n"
+             << "Unuse constant target variables or choose another error functional. ";
 
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
+      throw std::logic_error(buffer.str());
+   }
 
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+   const Vector<double> gradient = ErrorTerm::calculate_batch_gradient(instances_indices);
 
-      // Multilayer perceptron
+   return(gradient/normalization_coefficient);
+}
 
-      first_order_forward_propagation = multilayer_perceptron_pointer->calculate_first_order_forward_propagation(inputs);
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
 
-      const Vector< Vector<double> >& layers_activation = first_order_forward_propagation[0];
-      const Vector< Vector<double> >& layers_activation_derivative = first_order_forward_propagation[1];
+/// Returns the sum squared error of a batch of instances, before the normalization.
+/// Its normalization is the same as that of the output gradient.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
 
-      layers_inputs = multilayer_perceptron_pointer->arrange_layers_input(inputs, layers_activation);
+double NormalizedSquaredError::calculate_batch_error(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+   return(outputs.calculate_sum_squared_error(targets));
+}
 
-      layers_combination_parameters_Jacobian = multilayer_perceptron_pointer->calculate_layers_combination_parameters_Jacobian(layers_inputs);
 
-      // Loss index
+// FirstOrderPerformance calculate_first_order_loss(void) const method
 
-      if(!has_conditions_layer)
-      {
-         output_gradient = (layers_activation[layers_number-1]-targets)*2.0;
+/// Returns the normalized squared error and its gradient on the training instances,
+/// both computed from a single forward propagation of the instances and normalized afterwards.
 
-         layers_delta = calculate_layers_delta(layers_activation_derivative, output_gradient);
-      }
-      else
-      {
-         particular_solution = conditions_layer_pointer->calculate_particular_solution(inputs);
-         homogeneous_solution = conditions_layer_pointer->calculate_homogeneous_solution(inputs);
+ErrorTerm::FirstOrderPerformance NormalizedSquaredError::calculate_first_order_loss(void) const
+{
+   // Control sentence (if debug)
 
-         output_gradient = (particular_solution+homogeneous_solution*layers_activation[layers_number-1] - targets)*2.0;
+   #ifdef __OPENNN_DEBUG__
 
-         layers_delta = calculate_layers_delta(layers_activation_derivative, homogeneous_solution, output_gradient);
-      }
+   check();
 
-      point_gradient = calculate_point_gradient(layers_combination_parameters_Jacobian, layers_delta);
+   #endif
 
-      #pragma omp critical
+   // Data set stuff
 
-      gradient += point_gradient;
+   const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      normalization_coefficient += targets.calculate_sum_squared_error(training_target_data_mean);
-   }
+   // Normalized squared error stuff
+
+   const double normalization_coefficient = get_training_normalization_coefficient();
 
    if(normalization_coefficient < 1.0e-99)
    {
       std::ostringstream buffer;
 
       buffer << "OpenNN Exception: NormalizedSquaredError class.\n"
-             << "Vector<double> calculate_gradient(void) const method.\n"
+             << "FirstOrderPerformance calculate_first_order_loss(void) const method.\n"
              << "Normalization coefficient is zero.\n"
              << "Unuse constant target variables or choose another error functional. ";
 
       throw std::logic_error(buffer.str());
    }
 
-   return(gradient/normalization_coefficient);
+   FirstOrderPerformance first_order_loss = calculate_batch_first_order_loss(training_indices);
+
+   first_order_loss.loss /= normalization_coefficient;
+   first_order_loss.gradient /= normalization_coefficient;
+
+   return(first_order_loss);
 }
 
+
 // Vector<double> calculate_gradient_normalization(conts Vector<double>&) const method
 
 /// Returns the normalized squared error function output gradient of a multilayer perceptron on a data set.
@@ -968,115 +1007,14 @@ Vector<double> NormalizedSquaredError::calculate_gradient_normalization(const Ve
 
    #endif
 
-   // Neural network stuff
-
-   const size_t parameters_number = neural_network_pointer->count_parameters_number();
-
-   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
-
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
-   const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
-
-   Vector< Vector< Vector<double> > > first_order_forward_propagation(2);
-
-   Vector< Vector<double> > layers_inputs(layers_number);
-
-   Vector< Matrix<double> > layers_combination_parameters_Jacobian;
-
-   const bool has_conditions_layer = neural_network_pointer->has_conditions_layer();
-
-   const ConditionsLayer* conditions_layer_pointer = has_conditions_layer ? neural_network_pointer->get_conditions_layer_pointer() : NULL;
-
-   Vector<double> particular_solution;
-   Vector<double> homogeneous_solution;
-
    // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> targets(outputs_number);
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
    // Normalized squared error stuff
 
-   Vector<double> output_gradient(outputs_number);
-
-   Vector< Vector<double> > layers_delta;
-
-   Vector<double> point_gradient(parameters_number, 0.0);
-
-   double normalization_coefficient = 0.0;
-
-   // Main loop
-
-   Vector<double> gradient(parameters_number, 0.0);
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, training_index, inputs, targets, first_order_forward_propagation, layers_inputs, layers_combination_parameters_Jacobian,\
-    output_gradient, layers_delta, particular_solution, homogeneous_solution, point_gradient) \
-    reduction(+ : normalization_coefficient)
-
-   for(i = 0; i < (int)training_instances_number; i++)
-   {
-       training_index = training_indices[i];
-
-      // Data set
-
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
-
-      // Multilayer perceptron
-
-      first_order_forward_propagation = multilayer_perceptron_pointer->calculate_first_order_forward_propagation(inputs);
-
-      const Vector< Vector<double> >& layers_activation = first_order_forward_propagation[0];
-      const Vector< Vector<double> >& layers_activation_derivative = first_order_forward_propagation[1];
-
-      layers_inputs = multilayer_perceptron_pointer->arrange_layers_input(inputs, layers_activation);
-
-      layers_combination_parameters_Jacobian = multilayer_perceptron_pointer->calculate_layers_combination_parameters_Jacobian(layers_inputs);
-
-      // Loss index
-
-      if(!has_conditions_layer)
-      {
-         output_gradient = (layers_activation[layers_number-1]-targets)*2.0;
-
-         layers_delta = calculate_layers_delta(layers_activation_derivative, output_gradient);
-      }
-      else
-      {
-         particular_solution = conditions_layer_pointer->calculate_particular_solution(inputs);
-         homogeneous_solution = conditions_layer_pointer->calculate_homogeneous_solution(inputs);
-
-         output_gradient = (particular_solution+homogeneous_solution*layers_activation[layers_number-1] - targets)*2.0;
-
-         layers_delta = calculate_layers_delta(layers_activation_derivative, homogeneous_solution, output_gradient);
-      }
+   const double normalization_coefficient = targets.calculate_sum_squared_error(training_target_data_mean);
 
-      point_gradient = calculate_point_gradient(layers_combination_parameters_Jacobian, layers_delta);
-
-      #pragma omp critical
-
-      gradient += point_gradient;
-
-      normalization_coefficient += targets.calculate_sum_squared_error(training_target_data_mean);
-   }
 #ifndef __OPENNN_MPI__
    if(normalization_coefficient < 1.0e-99)
    {
@@ -1090,6 +1028,8 @@ Vector<double> NormalizedSquaredError::calculate_gradient_normalization(const Ve
       throw std::logic_error(buffer.str());
    }
 #endif
+   Vector<double> gradient = ErrorTerm::calculate_gradient();
+
    gradient.push_back(normalization_coefficient);
 
    return(gradient);
@@ -1118,11 +1058,20 @@ Matrix<double> NormalizedSquaredError::calculate_Hessian(void) const
 
 Vector<double> NormalizedSquaredError::calculate_output_gradient(const Vector<double>& output, const Vector<double>& target) const
 {
-    const Vector<double> training_target_data_mean = data_set_pointer->calculate_training_target_data_mean();
+    return (output-target)*2.0;
+}
 
-    //const double normalization_coefficient = target.calculate_sum_squared_error(training_target_data_mean);
 
-    return (output-target)*2.0/*/normalization_coefficient*/;
+// Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the normalized squared error gradient with respect to the outputs, for a batch of instances.
+/// The normalization coefficient is not included, and it is applied once to the whole gradient.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of targets. Each row corresponds to one instance.
+
+Matrix<double> NormalizedSquaredError::calculate_output_gradient(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    return((outputs-targets)*2.0);
 }
 
 
@@ -1184,8 +1133,6 @@ Vector<double> NormalizedSquaredError::calculate_terms(void) const
    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-   const Vector<double> training_target_data_mean = data_set_pointer->calculate_training_target_data_mean();
-
    // Calculate
 
    Vector<double> error_terms(training_instances_number);
@@ -1194,11 +1141,9 @@ Vector<double> NormalizedSquaredError::calculate_terms(void) const
    Vector<double> outputs(outputs_number);
    Vector<double> targets(outputs_number);
 
-   double normalization_coefficient = 0.0;
-
    int i = 0;
 
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : normalization_coefficient)
+   #pragma omp parallel for private(i, training_index, inputs, outputs, targets)
 
    for(i = 0; i < (int)training_instances_number; i++)
    {
@@ -1219,12 +1164,10 @@ Vector<double> NormalizedSquaredError::calculate_terms(void) const
       // Sum squared error
 
 	  error_terms[i] = outputs.calculate_distance(targets);
-
-	  // Normalization coefficient
-
-	  normalization_coefficient += targets.calculate_sum_squared_error(training_target_data_mean);
    }
 
+   const double normalization_coefficient = get_training_normalization_coefficient();
+
    if(normalization_coefficient < 1.0e-99)
    {
       std::ostringstream buffer;
@@ -1345,8 +1288,6 @@ Matrix<double> NormalizedSquaredError::calculate_terms_Jacobian(void) const
    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
 
-   const Vector<double> training_target_data_mean = data_set_pointer->calculate_training_target_data_mean();
-
    Vector<double> inputs(inputs_number);
    Vector<double> targets(outputs_number);
 
@@ -1362,8 +1303,6 @@ Matrix<double> NormalizedSquaredError::calculate_terms_Jacobian(void) const
 
    Matrix<double> terms_Jacobian(training_instances_number, parameters_number);
 
-   double normalization_coefficient = 0.0;
-
    // Main loop
 
    int i = 0;
@@ -1434,14 +1373,14 @@ Matrix<double> NormalizedSquaredError::calculate_terms_Jacobian(void) const
          layers_delta = calculate_layers_delta(layers_activation_derivative, homogeneous_solution, output_gradient);
 	  }
 
-	  normalization_coefficient += targets.calculate_sum_squared_error(training_target_data_mean);
-
       point_gradient = calculate_point_gradient(layers_combination_parameters_Jacobian, layers_delta);
 
       terms_Jacobian.set_row(i, point_gradient);
 
   }
 
+   const double normalization_coefficient = get_training_normalization_coefficient();
+
    if(normalization_coefficient < 1.0e-99)
    {
       std::ostringstream buffer;
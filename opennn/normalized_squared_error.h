@@ -79,6 +79,10 @@ public:
    // Normalization coefficients 
 
    double calculate_normalization_coefficient(const Matrix<double>&, const Vector<double>&) const;
+   double calculate_normalization_coefficient(const Vector<size_t>&, const Vector<double>&) const;
+
+   double get_training_normalization_coefficient(void) const;
+   double get_selection_normalization_coefficient(void) const;
 
    // Checking methods
 
@@ -95,9 +99,16 @@ public:
    Vector<double> calculate_selection_error_normalization(const Vector<double>&) const;
 
    Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const;
+   Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const;
    Matrix<double> calculate_output_Hessian(const Vector<double>&, const Vector<double>&) const;
 
    Vector<double> calculate_gradient(void) const;
+
+   Vector<double> calculate_batch_gradient(const Vector<size_t>&) const;
+
+   double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const;
+
+   FirstOrderPerformance calculate_first_order_loss(void) const;
 //   Matrix<double> calculate_Hessian(void) const;
 
    Vector<double> calculate_gradient_normalization(const Vector<double>&) const;
@@ -132,8 +143,44 @@ public:
 
 private:
 
+   /// Normalization coefficients of the training and the selection instances.
+   /// They are computed on demand and kept until the data set changes.
+
+   struct NormalizationCoefficients
+   {
+      /// Default constructor.
+
+      NormalizationCoefficients(void) : training_calculated(false), training(0.0), selection_calculated(false), selection(0.0)
+      {
+      }
+
+      /// State of the data set when the coefficients were computed.
+
+      DataSetState data_set_state;
+
+      /// True if the training normalization coefficient is up to date.
+
+      bool training_calculated;
+
+      /// Sum squared error of the training targets with respect to their mean.
+
+      double training;
+
+      /// True if the selection normalization coefficient is up to date.
+
+      bool selection_calculated;
+
+      /// Sum squared error of the selection targets with respect to their mean.
+
+      double selection;
+   };
+
    // MEMBERS
 
+   /// Cached normalization coefficients.
+
+   mutable NormalizationCoefficients normalization_coefficients;
+
    /// Mean values of all the target variables. 
 
 //   Vector<double> training_target_mean;
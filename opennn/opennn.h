@@ -85,6 +85,7 @@
 
 // Training strategy
 
+#include "adaptive_moment_estimation.h"
 #include "conjugate_gradient.h"
 #include "evolutionary_algorithm.h"
 #include "gradient_descent.h"
@@ -92,15 +93,19 @@
 #include "newton_method.h"
 #include "quasi_newton_method.h"
 #include "random_search.h"
+#include "stochastic_gradient_descent.h"
 #include "training_algorithm.h"
 #include "training_rate_algorithm.h"
 
 // Utilities
 
+#include "kd_tree.h"
 #include "matrix.h"
 #include "numerical_differentiation.h"
 #include "numerical_integration.h"
+#include "roc_curve.h"
 #include "vector.h"
+#include "vector_span.h"
 #include "math.h"
 
 #endif
@@ -26,6 +26,19 @@ CONFIG(debug, debug|release) {
 
 #DEFINES += __Cpp11__
 
+# Uncomment next line to use the fast approximations of the logistic and hyperbolic tangent activations
+
+#DEFINES += __OPENNN_FAST_ACTIVATIONS__
+
+# Uncomment one of the next lines to vectorize the fast activations with AVX2 and FMA, or with AVX-512, instructions
+
+#QMAKE_CXXFLAGS += -mavx2 -mfma
+#QMAKE_CXXFLAGS += -mavx512f
+
+# Uncomment next line to back-propagate the training batches in single precision
+
+#DEFINES += __OPENNN_SINGLE_PRECISION__
+
 # Eigen library
 
 INCLUDEPATH += eigen
@@ -86,6 +99,8 @@ HEADERS += \
     quasi_newton_method.h \
     newton_method.h \
     levenberg_marquardt_algorithm.h \
+    stochastic_gradient_descent.h \
+    adaptive_moment_estimation.h \
     gradient_descent.h \
     evolutionary_algorithm.h \
     conjugate_gradient.h \
@@ -102,6 +117,9 @@ HEADERS += \
     testing_analysis.h \
     vector.h \
     matrix.h \
+    vector_span.h \
+    kd_tree.h \
+    roc_curve.h \
     numerical_integration.h \
     numerical_differentiation.h \
     opennn.h \
@@ -154,6 +172,8 @@ SOURCES += \
     quasi_newton_method.cpp \
     newton_method.cpp \
     levenberg_marquardt_algorithm.cpp \
+    stochastic_gradient_descent.cpp \
+    adaptive_moment_estimation.cpp \
     gradient_descent.cpp \
     evolutionary_algorithm.cpp \
     conjugate_gradient.cpp \
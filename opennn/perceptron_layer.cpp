@@ -15,6 +15,12 @@
 
 #include "perceptron_layer.h"
 
+// System includes
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace OpenNN
 {
 
@@ -26,6 +32,8 @@ namespace OpenNN
 
 PerceptronLayer::PerceptronLayer(void)
 {
+   parameters_data = NULL;
+
    set();
 }
 
@@ -41,6 +49,8 @@ PerceptronLayer::PerceptronLayer(void)
 
 PerceptronLayer::PerceptronLayer(const size_t& new_inputs_number, const size_t& new_perceptrons_number)
 {
+   parameters_data = NULL;
+
    set(new_inputs_number, new_perceptrons_number);
 }
  
@@ -53,6 +63,8 @@ PerceptronLayer::PerceptronLayer(const size_t& new_inputs_number, const size_t&
 
 PerceptronLayer::PerceptronLayer(const PerceptronLayer& other_perceptron_layer)
 {
+   parameters_data = NULL;
+
    set(other_perceptron_layer);
 }
 
@@ -60,7 +72,7 @@ PerceptronLayer::PerceptronLayer(const PerceptronLayer& other_perceptron_layer)
 // DESTRUCTOR
 
 /// Destructor.
-/// This destructor does not delete any pointer.
+/// This destructor does not delete any pointer, so an external parameters buffer is not released.
 
 PerceptronLayer::~PerceptronLayer(void)
 {
@@ -71,15 +83,14 @@ PerceptronLayer::~PerceptronLayer(void)
 
 /// Assignment operator. 
 /// It assigns to this object the members of an existing perceptron layer object.
+/// The parameters are copied into the storage owned by this layer, even if those of the other layer are bound to an external buffer.
 /// @param other_perceptron_layer Perceptron layer object to be assigned.
 
 PerceptronLayer& PerceptronLayer::operator = (const PerceptronLayer& other_perceptron_layer)
 {
    if(this != &other_perceptron_layer) 
    {
-      perceptrons = other_perceptron_layer.perceptrons; 
-
-      display = other_perceptron_layer.display;
+      set(other_perceptron_layer);
    }
 
    return(*this);
@@ -97,7 +108,10 @@ PerceptronLayer& PerceptronLayer::operator = (const PerceptronLayer& other_perce
 
 bool PerceptronLayer::operator == (const PerceptronLayer& other_perceptron_layer) const
 {
-   if(perceptrons == other_perceptron_layer.perceptrons 
+   if(get_inputs_number() == other_perceptron_layer.get_inputs_number()
+   && get_perceptrons_number() == other_perceptron_layer.get_perceptrons_number()
+   && arrange_parameters() == other_perceptron_layer.arrange_parameters()
+   && activation_function == other_perceptron_layer.activation_function
    && display == other_perceptron_layer.display)
    {
       return(true);
@@ -118,7 +132,7 @@ bool PerceptronLayer::operator == (const PerceptronLayer& other_perceptron_layer
 
 bool PerceptronLayer::is_empty(void) const
 {
-    if(perceptrons.empty())
+    if(perceptrons_number == 0)
     {
         return(true);
     }
@@ -129,12 +143,23 @@ bool PerceptronLayer::is_empty(void) const
 }
 
 
-// const Vector<Perceptron>& get_perceptrons(void) const method
+// Vector<Perceptron> get_perceptrons(void) const method
 
-/// Returns a constant reference to the vector of perceptrons defining the layer. 
+/// Returns the vector of perceptrons defining the layer.
+/// The perceptrons are built from the layer parameters and activation function,
+/// so that modifying them does not modify the layer. 
 
-const Vector<Perceptron>& PerceptronLayer::get_perceptrons(void) const
+Vector<Perceptron> PerceptronLayer::get_perceptrons(void) const
 {
+   const size_t perceptrons_number = get_perceptrons_number();
+
+   Vector<Perceptron> perceptrons(perceptrons_number);
+
+   for(size_t i = 0; i < perceptrons_number; i++)
+   {
+      perceptrons[i] = get_perceptron(i);
+   }
+
    return(perceptrons);
 }
 
@@ -151,7 +176,7 @@ size_t PerceptronLayer::get_inputs_number(void) const
    }
    else
    {
-      return(perceptrons[0].get_inputs_number());
+      return(inputs_number);
    }
 }
 
@@ -162,18 +187,17 @@ size_t PerceptronLayer::get_inputs_number(void) const
 
 size_t PerceptronLayer::get_perceptrons_number(void) const
 {
-   const size_t perceptrons_number = perceptrons.size();
-
    return(perceptrons_number);
 }
 
 
-// const Perceptron& get_perceptron(const size_t&) const method
+// Perceptron get_perceptron(const size_t&) const method
 
-/// Returns a reference to a given element in the perceptrons vector.
+/// Returns a single perceptron of the layer, built from its bias, its synaptic weights
+/// and the layer activation function.
 /// @param index Index of perceptron element.
 
-const Perceptron& PerceptronLayer::get_perceptron(const size_t& index) const
+Perceptron PerceptronLayer::get_perceptron(const size_t& index) const
 {
    // Control sentence (if debug)
 
@@ -186,7 +210,7 @@ const Perceptron& PerceptronLayer::get_perceptron(const size_t& index) const
       std::ostringstream buffer;
 
       buffer << "OpenNN Exception: PerceptronLayer class.\n"
-             << "const Perceptron& get_perceptron(const size_t&) const method.\n"
+             << "Perceptron get_perceptron(const size_t&) const method.\n"
              << "Index of perceptron must be less than layer size.\n";
 
 	  throw std::logic_error(buffer.str());
@@ -194,7 +218,22 @@ const Perceptron& PerceptronLayer::get_perceptron(const size_t& index) const
 
    #endif
 
-   return(perceptrons[index]);
+   const double* perceptron_parameters = parameters_data + index*(1 + inputs_number);
+
+   Perceptron perceptron(inputs_number, 0.0);
+
+   perceptron.set_bias(perceptron_parameters[0]);
+
+   if(inputs_number != 0)
+   {
+      perceptron.set_synaptic_weights(Vector<double>(perceptron_parameters + 1, perceptron_parameters + 1 + inputs_number));
+   }
+
+   perceptron.set_activation_function(activation_function);
+
+   perceptron.set_display(display);
+
+   return(perceptron);
 }
 
 
@@ -206,14 +245,7 @@ size_t PerceptronLayer::count_parameters_number(void) const
 {
    const size_t perceptrons_number = get_perceptrons_number();
 
-   size_t parameters_number = 0;
-
-   for(size_t i = 0; i < perceptrons_number; i++)
-   {   
-      parameters_number += perceptrons[i].count_parameters_number();
-   }
-
-   return(parameters_number);
+   return(perceptrons_number*count_perceptron_parameters_number());
 }
 
 
@@ -226,16 +258,13 @@ Vector<size_t> PerceptronLayer::count_cumulative_parameters_number(void) const
 {
    const size_t perceptrons_number = get_perceptrons_number();
 
+   const size_t perceptron_parameters_number = count_perceptron_parameters_number();
+
    Vector<size_t> cumulative_parameters_number(perceptrons_number);
 
-   if(perceptrons_number > 0)
+   for(size_t i = 0; i < perceptrons_number; i++)
    {
-      cumulative_parameters_number[0] = perceptrons[0].count_parameters_number();
-
-      for(size_t i = 1; i < perceptrons_number; i++)
-      {  
-         cumulative_parameters_number[i] = cumulative_parameters_number[i-1] + perceptrons[i].count_parameters_number();   
-      }
+      cumulative_parameters_number[i] = (i+1)*perceptron_parameters_number;
    }
 
    return(cumulative_parameters_number);
@@ -250,13 +279,11 @@ Vector<size_t> PerceptronLayer::count_cumulative_parameters_number(void) const
 
 Vector<double> PerceptronLayer::arrange_biases(void) const
 {   
-   const size_t perceptrons_number = get_perceptrons_number();
-
    Vector<double> biases(perceptrons_number);
 
    for(size_t i = 0; i < perceptrons_number; i++)
    {
-      biases[i] = perceptrons[i].get_bias();   
+      biases[i] = parameters_data[i*(1 + inputs_number)];
    }
 
    return(biases);
@@ -272,17 +299,18 @@ Vector<double> PerceptronLayer::arrange_biases(void) const
 
 Matrix<double> PerceptronLayer::arrange_synaptic_weights(void) const 
 {
-   const size_t perceptrons_number = get_perceptrons_number();
-
-   const size_t inputs_number = get_inputs_number(); 
+   if(inputs_number == 0 || perceptrons_number == 0)
+   {
+      return(Matrix<double>());
+   }
 
    Matrix<double> synaptic_weights(perceptrons_number, inputs_number);
-   
+
    for(size_t i = 0; i < perceptrons_number; i++)
    {
       for(size_t j = 0; j < inputs_number; j++)
       {
-         synaptic_weights(i,j) = perceptrons[i].get_synaptic_weight(j);
+         synaptic_weights(i,j) = parameters_data[i*(1 + inputs_number) + 1 + j];
       }
    }
 
@@ -298,35 +326,14 @@ Matrix<double> PerceptronLayer::arrange_synaptic_weights(void) const
 
 Vector<double> PerceptronLayer::arrange_parameters(void) const
 {
-   const size_t perceptrons_number = get_perceptrons_number();
+   const size_t parameters_number = count_parameters_number();
 
-   if(perceptrons_number == 0)
+   if(parameters_number == 0)
    {
-      Vector<double> parameters;
-         
-      return(parameters);
+      return(Vector<double>());
    }
-   else
-   {
-      const size_t parameters_number = count_parameters_number(); 
 
-      Vector<double> parameters(parameters_number);
-
-      const size_t perceptron_parameters_number = perceptrons[0].count_parameters_number();
-      
-      Vector<double> perceptron_parameters(perceptron_parameters_number);
-
-      size_t position = 0;
-
-      for(size_t i = 0; i < perceptrons_number; i++)
-      {
-         perceptron_parameters = perceptrons[i].arrange_parameters();
-         parameters.tuck_in(position, perceptron_parameters);
-         position += perceptron_parameters_number; 
-      }
-
-      return(parameters);
-   }
+   return(Vector<double>(parameters_data, parameters_data + parameters_number));
 }
 
 
@@ -343,6 +350,18 @@ size_t PerceptronLayer::count_perceptron_parameters_number(void) const
 }
 
 
+// const double* get_parameters_data(void) const method
+
+/// Returns a pointer to the parameters in use by the layer.
+/// They are arranged perceptron by perceptron, with the bias first and then the synaptic weights.
+/// The pointer is either to the storage owned by the layer, or to the external buffer the parameters are bound to.
+
+const double* PerceptronLayer::get_parameters_data(void) const
+{
+   return(parameters_data);
+}
+
+
 // Vector< Vector<double> > arrange_perceptrons_parameters(void) const method
 
 /// Returns the parameters of every single perceptron in the layer.
@@ -354,11 +373,15 @@ Vector< Vector<double> > PerceptronLayer::arrange_perceptrons_parameters(void) c
 {
     const size_t perceptrons_number = get_perceptrons_number();
 
+    const size_t perceptron_parameters_number = count_perceptron_parameters_number();
+
+    const Vector<double> parameters = arrange_parameters();
+
     Vector< Vector<double> > perceptrons_parameters(perceptrons_number);
 
     for(size_t i = 0; i < perceptrons_number; i++)
     {
-        perceptrons_parameters[i] = perceptrons[i].arrange_parameters();
+        perceptrons_parameters[i] = parameters.take_out(i*perceptron_parameters_number, perceptron_parameters_number);
     }
 
     return(perceptrons_parameters);
@@ -376,7 +399,7 @@ const Perceptron::ActivationFunction& PerceptronLayer::get_activation_function(v
 
    if(perceptrons_number > 0)
    {
-      return(perceptrons[0].get_activation_function());
+      return(activation_function);
    }
    else
    {
@@ -465,7 +488,9 @@ const bool& PerceptronLayer::get_display(void) const
 
 void PerceptronLayer::set(void)
 {
-   perceptrons.set();
+   set_parameters_size(0, 0);
+
+   activation_function = Perceptron::HyperbolicTangent;
 
    set_default();
 }
@@ -478,7 +503,7 @@ void PerceptronLayer::set(void)
 
 void PerceptronLayer::set(const Vector<Perceptron>& new_perceptrons)
 {
-   perceptrons = new_perceptrons;   
+   set_perceptrons(new_perceptrons);
 
    set_default();
 }
@@ -493,12 +518,11 @@ void PerceptronLayer::set(const Vector<Perceptron>& new_perceptrons)
 
 void PerceptronLayer::set(const size_t& new_inputs_number, const size_t& new_perceptrons_number)
 {
-   perceptrons.set(new_perceptrons_number);
+   activation_function = Perceptron::HyperbolicTangent;
 
-   for(size_t i = 0; i < new_perceptrons_number; i++)
-   {
-      perceptrons[i].set_inputs_number(new_inputs_number);
-   }
+   set_parameters_size(new_inputs_number, new_perceptrons_number);
+
+   owned_parameters.randomize_normal(0.0, 1.0);
    
    set_default();
 }
@@ -511,7 +535,18 @@ void PerceptronLayer::set(const size_t& new_inputs_number, const size_t& new_per
 
 void PerceptronLayer::set(const PerceptronLayer& other_perceptron_layer)
 {
-   perceptrons = other_perceptron_layer.perceptrons;
+   if(this == &other_perceptron_layer)
+   {
+      return;
+   }
+
+   set_parameters_size(other_perceptron_layer.inputs_number, other_perceptron_layer.perceptrons_number);
+
+   std::copy(other_perceptron_layer.parameters_data,
+             other_perceptron_layer.parameters_data + owned_parameters.size(),
+             owned_parameters.begin());
+
+   activation_function = other_perceptron_layer.activation_function;
    
    display = other_perceptron_layer.display;
 }
@@ -524,19 +559,54 @@ void PerceptronLayer::set(const PerceptronLayer& other_perceptron_layer)
 
 void PerceptronLayer::set_perceptrons(const Vector<Perceptron>& new_perceptrons) 
 {
-   perceptrons = new_perceptrons;
+   const size_t new_perceptrons_number = new_perceptrons.size();
+
+   const size_t new_inputs_number = new_perceptrons_number == 0 ? 0 : new_perceptrons[0].get_inputs_number();
+
+   set_parameters_size(new_inputs_number, new_perceptrons_number);
+
+   activation_function = new_perceptrons_number == 0 ? Perceptron::HyperbolicTangent : new_perceptrons[0].get_activation_function();
+
+   for(size_t i = 0; i < new_perceptrons_number; i++)
+   {
+      set_perceptron(i, new_perceptrons[i]);
+   }
 }
 
 
 // void set_perceptron(const size_t&, const Perceptron&) method
 
-/// Sets a single perceptron in the layer. 
+/// Sets the bias and the synaptic weights of a single perceptron in the layer. 
+/// The activation function of the layer is not modified.
 /// @param i Index of perceptron. 
 /// @param new_perceptron Perceptron neuron to be set. 
 
 void PerceptronLayer::set_perceptron(const size_t& i, const Perceptron& new_perceptron)
 {
-   perceptrons[i] = new_perceptron;
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__ 
+
+   if(new_perceptron.get_inputs_number() != inputs_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "void set_perceptron(const size_t&, const Perceptron&) method.\n"
+             << "Number of perceptron inputs must be equal to number of layer inputs.\n";
+
+	  throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   double* perceptron_parameters = parameters_data + i*(1 + inputs_number);
+
+   perceptron_parameters[0] = new_perceptron.get_bias();
+
+   const Vector<double>& new_synaptic_weights = new_perceptron.arrange_synaptic_weights();
+
+   std::copy(new_synaptic_weights.begin(), new_synaptic_weights.end(), perceptron_parameters + 1);
 }
 
 
@@ -553,20 +623,36 @@ void PerceptronLayer::set_default(void)
 }
 
 
+// void set_parameters_size(const size_t&, const size_t&) method
+
+/// Sets new numbers of inputs and perceptrons, and resizes the storage owned by the layer accordingly.
+/// If the parameters were bound to an external buffer, they are moved back to the storage owned by the layer.
+/// The values of the new parameters are not initialized.
+/// @param new_inputs_number Number of inputs.
+/// @param new_perceptrons_number Number of perceptrons.
+
+void PerceptronLayer::set_parameters_size(const size_t& new_inputs_number, const size_t& new_perceptrons_number)
+{
+   inputs_number = new_inputs_number;
+   perceptrons_number = new_perceptrons_number;
+
+   owned_parameters.set(new_perceptrons_number*(1 + new_inputs_number));
+
+   parameters_data = owned_parameters.data();
+}
+
+
 // void set_inputs_number(const size_t&) method
 
 /// Sets a new number of inputs in the layer. 
-/// The new synaptic weights are initialized at random. 
+/// The biases and the new synaptic weights are initialized at random. 
 /// @param new_inputs_number Number of layer inputs.
  
 void PerceptronLayer::set_inputs_number(const size_t& new_inputs_number)
 {
-   const size_t perceptrons_number = get_perceptrons_number();
+   set_parameters_size(new_inputs_number, perceptrons_number);
 
-   for(size_t i = 0; i < perceptrons_number; i++)
-   {
-      perceptrons[i].set_inputs_number(new_inputs_number);
-   }
+   owned_parameters.randomize_normal(0.0, 1.0);
 }
 
 
@@ -578,21 +664,16 @@ void PerceptronLayer::set_inputs_number(const size_t& new_inputs_number)
 
 void PerceptronLayer::set_perceptrons_number(const size_t& new_perceptrons_number)
 {
-   const size_t perceptrons_number = get_perceptrons_number();
    const size_t inputs_number = get_inputs_number();
 
-   if(perceptrons_number > 0)
-   {
-      const Perceptron::ActivationFunction& activation_function = get_activation_function();
-      perceptrons.set(new_perceptrons_number);
-      set_activation_function(activation_function); 
-   }
-   else
+   if(is_empty())
    {
-      perceptrons.set(new_perceptrons_number);  
+      activation_function = Perceptron::HyperbolicTangent;
    }
 
-   set_inputs_number(inputs_number);
+   set_parameters_size(inputs_number, new_perceptrons_number);
+
+   owned_parameters.randomize_normal(0.0, 1.0);
 }
 
 
@@ -628,8 +709,8 @@ void PerceptronLayer::set_biases(const Vector<double>& new_biases)
 
    for(size_t i = 0; i < perceptrons_number; i++)
    {
-      perceptrons[i].set_bias(new_biases[i]); 
-   }   
+      parameters_data[i*(1 + inputs_number)] = new_biases[i];
+   }
 }
 
 
@@ -680,7 +761,7 @@ void PerceptronLayer::set_synaptic_weights(const Matrix<double>& new_synaptic_we
    {
       for(size_t j = 0; j < inputs_number; j++)
       {
-         perceptrons[i].set_synaptic_weight(j, new_synaptic_weights(i,j));
+         parameters_data[i*(1 + inputs_number) + 1 + j] = new_synaptic_weights(i,j);
       }
    }
 }
@@ -693,8 +774,6 @@ void PerceptronLayer::set_synaptic_weights(const Matrix<double>& new_synaptic_we
 
 void PerceptronLayer::set_parameters(const Vector<double>& new_parameters)
 {
-   const size_t perceptrons_number = get_perceptrons_number();
-
    // Control sentence (if debug)
 
    #ifdef __OPENNN_DEBUG__ 
@@ -716,21 +795,32 @@ void PerceptronLayer::set_parameters(const Vector<double>& new_parameters)
 
    #endif
 
-   if(perceptrons_number != 0)
-   {
-      const size_t perceptron_parameters_number = perceptrons[0].count_parameters_number();
+   std::copy(new_parameters.begin(), new_parameters.end(), parameters_data);
+}
 
-      Vector<double> perceptron_parameters(perceptron_parameters_number);
 
-      size_t position = 0;
+// void bind_parameters(double*) method
 
-      for(size_t i = 0; i < perceptrons_number; i++)
-      {                  
-         perceptron_parameters = new_parameters.take_out(position, perceptron_parameters_number);
-         perceptrons[i].set_parameters(perceptron_parameters);
-         position += perceptron_parameters_number;
-      }
+/// Binds the parameters of this layer to an external buffer, such as the parameters of a multilayer perceptron.
+/// The current parameters are copied into that buffer, and from then on the layer reads and writes them there.
+/// The buffer must have room for all the layer parameters, and must outlive the binding.
+/// Any change in the size of the layer moves the parameters back to the storage owned by the layer.
+/// @param new_parameters_data Pointer to the external buffer.
+
+void PerceptronLayer::bind_parameters(double* new_parameters_data)
+{
+   if(new_parameters_data == parameters_data)
+   {
+      return;
    }
+
+   const size_t parameters_number = count_parameters_number();
+
+   std::copy(parameters_data, parameters_data + parameters_number, new_parameters_data);
+
+   owned_parameters.set();
+
+   parameters_data = new_parameters_data;
 }
 
 
@@ -741,12 +831,7 @@ void PerceptronLayer::set_parameters(const Vector<double>& new_parameters)
 
 void PerceptronLayer::set_activation_function(const Perceptron::ActivationFunction& new_activation_function)
 {
-   const size_t perceptrons_number = get_perceptrons_number();
-
-   for(size_t i = 0; i < perceptrons_number; i++)
-   {
-      perceptrons[i].set_activation_function(new_activation_function);
-   }
+   activation_function = new_activation_function;
 }
 
 
@@ -758,11 +843,35 @@ void PerceptronLayer::set_activation_function(const Perceptron::ActivationFuncti
 
 void PerceptronLayer::set_activation_function(const std::string& new_activation_function)
 {
-   const size_t perceptrons_number = get_perceptrons_number();
-
-   for(size_t i = 0; i < perceptrons_number; i++)
+   if(new_activation_function == "Logistic")
+   {
+      activation_function = Perceptron::Logistic;
+   }
+   else if(new_activation_function == "HyperbolicTangent")
+   {
+      activation_function = Perceptron::HyperbolicTangent;
+   }
+   else if(new_activation_function == "Threshold")
    {
-      perceptrons[i].set_activation_function(new_activation_function);
+      activation_function = Perceptron::Threshold;
+   }
+   else if(new_activation_function == "SymmetricThreshold")
+   {
+      activation_function = Perceptron::SymmetricThreshold;
+   }
+   else if(new_activation_function == "Linear")
+   {
+      activation_function = Perceptron::Linear;
+   }
+   else
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "void set_activation_function(const std::string&) method.\n"
+             << "Unknown activation function: " << new_activation_function << ".\n";
+
+      throw std::logic_error(buffer.str());
    }
 }
 
@@ -786,11 +895,24 @@ void PerceptronLayer::set_display(const bool& new_display)
 
 void PerceptronLayer::grow_input(void)
 {
-   const size_t perceptrons_number = get_perceptrons_number();
+   if(perceptrons_number == 0)
+   {
+      return;
+   }
+
+   const Vector<double> old_parameters = arrange_parameters();
+
+   const size_t old_perceptron_parameters_number = count_perceptron_parameters_number();
+
+   set_parameters_size(inputs_number+1, perceptrons_number);
+
+   owned_parameters.initialize(0.0);
 
    for(size_t i = 0; i < perceptrons_number; i++)
    {
-      perceptrons[i].grow_input();
+      std::copy(old_parameters.begin() + i*old_perceptron_parameters_number,
+                old_parameters.begin() + (i+1)*old_perceptron_parameters_number,
+                owned_parameters.begin() + i*(old_perceptron_parameters_number+1));
    }
 }
 
@@ -803,15 +925,18 @@ void PerceptronLayer::grow_perceptron(void)
 {
    const size_t inputs_number = get_inputs_number();
 
-   const Perceptron::ActivationFunction activation_function = get_activation_function();
+   if(is_empty())
+   {
+      activation_function = Perceptron::HyperbolicTangent;
+   }
 
-   Perceptron perceptron(inputs_number);
+   const Vector<double> old_parameters = arrange_parameters();
 
-   perceptron.initialize_parameters(0.0);
+   set_parameters_size(inputs_number, perceptrons_number+1);
 
-   perceptron.set_activation_function(activation_function);
+   owned_parameters.initialize(0.0);
 
-   perceptrons.push_back(perceptron);
+   std::copy(old_parameters.begin(), old_parameters.end(), owned_parameters.begin());
 }
 
 //void grow_perceptrons(const size_t&) mehtod
@@ -852,11 +977,21 @@ void PerceptronLayer::prune_input(const size_t& index)
 
     #endif
 
-   const size_t perceptrons_number = get_perceptrons_number();
+   const Vector<double> old_parameters = arrange_parameters();
 
-   for(size_t i = 0; i < perceptrons_number; i++)
+   const size_t old_inputs_number = inputs_number;
+
+   set_parameters_size(old_inputs_number-1, perceptrons_number);
+
+   size_t position = 0;
+
+   for(size_t i = 0; i < old_parameters.size(); i++)
    {
-      perceptrons[i].prune_input(index);
+      if(i%(1 + old_inputs_number) != 1 + index)
+      {
+         owned_parameters[position] = old_parameters[i];
+         position++;
+      }
    }
 }
 
@@ -887,7 +1022,16 @@ void PerceptronLayer::prune_perceptron(const size_t& index)
 
     #endif
 
-   perceptrons.erase(perceptrons.begin() + index);
+   Vector<double> new_parameters = arrange_parameters();
+
+   const size_t perceptron_parameters_number = count_perceptron_parameters_number();
+
+   new_parameters.erase(new_parameters.begin() + index*perceptron_parameters_number,
+                        new_parameters.begin() + (index+1)*perceptron_parameters_number);
+
+   set_parameters_size(inputs_number, perceptrons_number-1);
+
+   std::copy(new_parameters.begin(), new_parameters.end(), owned_parameters.begin());
 }
 
 
@@ -918,7 +1062,7 @@ void PerceptronLayer::initialize_biases(const double& value)
 
    for(size_t i = 0; i < perceptrons_number; i++)
    {
-      perceptrons[i].initialize_bias(value);
+      parameters_data[i*(1 + inputs_number)] = value;
    }
 }
 
@@ -934,7 +1078,7 @@ void PerceptronLayer::initialize_synaptic_weights(const double& value)
 
    for(size_t i = 0; i < perceptrons_number; i++)
    {
-      perceptrons[i].initialize_synaptic_weights(value);
+      std::fill(parameters_data + i*(1 + inputs_number) + 1, parameters_data + (i+1)*(1 + inputs_number), value);
    }
 }
 
@@ -1148,14 +1292,16 @@ Vector<double> PerceptronLayer::calculate_combinations(const Vector<double>& inp
 
    // Calculate combination to layer
 
-   Vector<double> combination(perceptrons_number);
-   
+   Vector<double> combinations(perceptrons_number);
+
    for(size_t i = 0; i < perceptrons_number; i++)
-   {         
-      combination[i] = perceptrons[i].calculate_combination(inputs);
-   }             
-   
-   return(combination);
+   {
+      const double* perceptron_parameters = parameters_data + i*(1 + inputs_number);
+
+      combinations[i] = std::inner_product(inputs.begin(), inputs.end(), perceptron_parameters + 1, perceptron_parameters[0]);
+   }
+
+   return(combinations);
 }
 
 
@@ -1243,13 +1389,11 @@ Vector<double> PerceptronLayer::calculate_combinations(const Vector<double>& inp
 
    Vector<double> combinations(perceptrons_number);
 
-   Vector<double> perceptron_parameters(perceptron_parameters_number);
-
    for(size_t i = 0; i < perceptrons_number; i++)
    {   
-       perceptron_parameters = parameters.take_out(i*perceptron_parameters_number, perceptron_parameters_number);
+       const Vector<double>::const_iterator bias = parameters.begin() + i*perceptron_parameters_number;
 
-       combinations[i] = perceptrons[i].calculate_combination(inputs, perceptron_parameters);
+       combinations[i] = std::inner_product(inputs.begin(), inputs.end(), bias + 1, *bias);
    }
 
    return(combinations);
@@ -1316,140 +1460,1068 @@ Vector< Matrix<double> > PerceptronLayer::calculate_combinations_Hessian_form(co
 }
 
 
-// Vector<double> calculate_activations(const Vector<double>&) const method
+// Matrix<double> calculate_combinations(const Matrix<double>&) const method
 
-/// Returns the activations from every perceptron in a layer as a function of their combination.
-/// @param combinations Combination from every neuron in the layer.
+/// Returns the combinations of every perceptron in the layer for a batch of inputs.
+/// The whole batch is computed with a single matrix product, followed by the addition of the biases.
+/// @param inputs Matrix of inputs to the layer. Each row contains one input vector.
 
-Vector<double> PerceptronLayer::calculate_activations(const Vector<double>& combinations) const
+Matrix<double> PerceptronLayer::calculate_combinations(const Matrix<double>& inputs) const
 {
-   const size_t perceptrons_number = get_perceptrons_number();
-
    // Control sentence (if debug)
 
-   #ifdef __OPENNN_DEBUG__ 
-
-   const size_t combination_size = combinations.size();
-
-   if(combination_size != perceptrons_number) 
-   {
-      std::ostringstream buffer;
+   #ifdef __OPENNN_DEBUG__
 
-      buffer << "OpenNN Exception: PerceptronLayer class.\n"
-             << "Vector<double> calculate_activation(const Vector<double>&) const method.\n"
-             << "Combination size must be equal to number of neurons.\n";
+   const size_t inputs_number = get_inputs_number();
 
-	  throw std::logic_error(buffer.str());
-   }   
+   const size_t columns_number = inputs.get_columns_number();
 
-   if(combination_size == 0)
+   if(columns_number != inputs_number)
    {
       std::ostringstream buffer;
 
       buffer << "OpenNN Exception: PerceptronLayer class.\n"
-             << "Vector<double> calculate_activation(const Vector<double>&) const method.\n"
-             << "Combination size cannot be empty.\n";
+             << "Matrix<double> calculate_combinations(const Matrix<double>&) const method.\n"
+             << "Number of columns of inputs (" << columns_number << ") must be equal to number of layer inputs (" << inputs_number << ").\n";
 
       throw std::logic_error(buffer.str());
    }
 
    #endif
 
-   // Calculate activation from layer
-
-   Vector<double> activations(perceptrons_number);
+   Matrix<double> combinations;
 
-   for(size_t i = 0; i < perceptrons_number; i++)
-   {
-      activations[i] = perceptrons[i].calculate_activation(combinations[i]);
-   }
+   calculate_combinations(inputs, parameters_data, combinations);
 
-   return(activations);
-}  
+   return(combinations);
+}
 
 
-// Vector<double> calculate_activations_derivatives(const Vector<double>&) const method
+// Matrix<double> calculate_combinations(const Matrix<double>&, const Vector<double>&) const method
 
-/// Returns the activation derivative from every perceptron in the layer as a function of its combination.
-/// @param combination Combination to every neuron in the layer.
+/// Returns which would be the combinations of the layer for a batch of inputs and a set of parameters.
+/// @param inputs Matrix of inputs to the layer. Each row contains one input vector.
+/// @param parameters Vector of parameters in the layer, arranged perceptron by perceptron with the bias first.
 
-Vector<double> PerceptronLayer::calculate_activations_derivatives(const Vector<double>& combination) const
+Matrix<double> PerceptronLayer::calculate_combinations(const Matrix<double>& inputs, const Vector<double>& parameters) const
 {
-   const size_t perceptrons_number = get_perceptrons_number();
-
    // Control sentence (if debug)
 
-   #ifdef __OPENNN_DEBUG__ 
+   #ifdef __OPENNN_DEBUG__
 
-   const size_t combination_size = combination.size();
+   const size_t inputs_number = get_inputs_number();
 
-   if(combination_size != perceptrons_number) 
+   const size_t columns_number = inputs.get_columns_number();
+
+   if(columns_number != inputs_number)
    {
       std::ostringstream buffer;
 
       buffer << "OpenNN Exception: PerceptronLayer class.\n"
-             << "Vector<double> calculate_activations_derivatives(const Vector<double>&) const method.\n"
-             << "Size of combination must be equal to number of neurons.\n";
+             << "Matrix<double> calculate_combinations(const Matrix<double>&, const Vector<double>&) const method.\n"
+             << "Number of columns of inputs (" << columns_number << ") must be equal to number of layer inputs (" << inputs_number << ").\n";
 
-	  throw std::logic_error(buffer.str());
-   }   
+      throw std::logic_error(buffer.str());
+   }
 
-   #endif
+   const size_t parameters_size = parameters.size();
 
-   // Calculate activation derivative from layer
+   const size_t parameters_number = count_parameters_number();
 
-   Vector<double> activation_derivatives(perceptrons_number);
+   if(parameters_size != parameters_number)
+   {
+      std::ostringstream buffer;
 
-   for(size_t i = 0; i < perceptrons_number; i++)
-   {          
-      activation_derivatives[i] = perceptrons[i].calculate_activation_derivative(combination[i]);
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "Matrix<double> calculate_combinations(const Matrix<double>&, const Vector<double>&) const method.\n"
+             << "Size of layer parameters (" << parameters_size << ") must be equal to number of layer parameters (" << parameters_number << ").\n";
+
+      throw std::logic_error(buffer.str());
    }
 
-   return(activation_derivatives);
+   #endif
+
+   Matrix<double> combinations;
+
+   calculate_combinations(inputs, parameters.data(), combinations);
+
+   return(combinations);
 }
 
 
-// Vector<double> calculate_activations_second_derivatives(const Vector<double>&) const method
+// void calculate_combinations(const Matrix<double>&, Matrix<double>&) const method
+
+/// Writes the combinations of the layer for a batch of inputs into a given matrix.
+/// The matrix is only reallocated when its size changes, so that it can be reused between batches.
+/// @param inputs Matrix of inputs to the layer. Each row contains one input vector.
+/// @param combinations Matrix where the combinations are written. Each row contains the combinations for one instance.
+
+void PerceptronLayer::calculate_combinations(const Matrix<double>& inputs, Matrix<double>& combinations) const
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   const size_t columns_number = inputs.get_columns_number();
+
+   if(columns_number != inputs_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "void calculate_combinations(const Matrix<double>&, Matrix<double>&) const method.\n"
+             << "Number of columns of inputs (" << columns_number << ") must be equal to number of layer inputs (" << inputs_number << ").\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   calculate_combinations(inputs, parameters_data, combinations);
+}
+
+
+// void calculate_combinations(const Matrix<T>&, const T*, Matrix<T>&) const method
+
+/// Writes the combinations of the layer for a batch of inputs and the parameters stored at a given address.
+/// The parameters are arranged perceptron by perceptron with the bias first, so that the synaptic weights are read
+/// in place as a strided matrix, and the whole batch is computed with a single matrix product.
+/// It is instantiated for double and float, so that a batch can also be propagated in single precision
+/// from a single precision copy of the parameters.
+/// @param inputs Matrix of inputs to the layer. Each row contains one input vector.
+/// @param layer_parameters Pointer to the parameters of the layer.
+/// @param combinations Matrix where the combinations are written.
+
+template <class T>
+void PerceptronLayer::calculate_combinations(const Matrix<T>& inputs, const T* layer_parameters, Matrix<T>& combinations) const
+{
+   typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> MatrixType;
+
+   const size_t rows_number = inputs.get_rows_number();
+
+   const size_t perceptron_parameters_number = 1 + inputs_number;
+
+   combinations.set(rows_number, perceptrons_number);
+
+   Eigen::Map<MatrixType> combinations_eigen(combinations.data(), rows_number, perceptrons_number);
+
+   if(inputs_number != 0)
+   {
+      const Eigen::Map<const MatrixType> inputs_eigen(inputs.data(), rows_number, inputs_number);
+
+      const Eigen::Map<const MatrixType, 0, Eigen::OuterStride<> >
+      synaptic_weights_eigen(layer_parameters + 1, inputs_number, perceptrons_number, Eigen::OuterStride<>(perceptron_parameters_number));
+
+      combinations_eigen.noalias() = inputs_eigen*synaptic_weights_eigen;
+   }
+   else
+   {
+      combinations_eigen.setZero();
+   }
+
+   for(size_t j = 0; j < perceptrons_number; j++)
+   {
+      const T bias = layer_parameters[j*perceptron_parameters_number];
+
+      T* column = combinations.data() + j*rows_number;
+
+      for(size_t i = 0; i < rows_number; i++)
+      {
+         column[i] += bias;
+      }
+   }
+}
+
+template void PerceptronLayer::calculate_combinations<double>(const Matrix<double>&, const double*, Matrix<double>&) const;
+template void PerceptronLayer::calculate_combinations<float>(const Matrix<float>&, const float*, Matrix<float>&) const;
+
+
+// Vector<double> calculate_activations(const Vector<double>&) const method
+
+/// Returns the activations from every perceptron in a layer as a function of their combination.
+/// @param combinations Combination from every neuron in the layer.
+
+Vector<double> PerceptronLayer::calculate_activations(const Vector<double>& combinations) const
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__ 
+
+   const size_t perceptrons_number = get_perceptrons_number();
+
+   const size_t combination_size = combinations.size();
+
+   if(combination_size != perceptrons_number) 
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "Vector<double> calculate_activation(const Vector<double>&) const method.\n"
+             << "Combination size must be equal to number of neurons.\n";
+
+	  throw std::logic_error(buffer.str());
+   }   
+
+   if(combination_size == 0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "Vector<double> calculate_activation(const Vector<double>&) const method.\n"
+             << "Combination size cannot be empty.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   // Calculate activation from layer
+
+   return(calculate_activations(combinations.to_row_matrix()).to_vector());
+}  
+
+
+// Vector<double> calculate_activations_derivatives(const Vector<double>&) const method
+
+/// Returns the activation derivative from every perceptron in the layer as a function of its combination.
+/// @param combination Combination to every neuron in the layer.
+
+Vector<double> PerceptronLayer::calculate_activations_derivatives(const Vector<double>& combination) const
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__ 
+
+   const size_t perceptrons_number = get_perceptrons_number();
+
+   const size_t combination_size = combination.size();
+
+   if(combination_size != perceptrons_number) 
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "Vector<double> calculate_activations_derivatives(const Vector<double>&) const method.\n"
+             << "Size of combination must be equal to number of neurons.\n";
+
+	  throw std::logic_error(buffer.str());
+   }   
+
+   #endif
+
+   // Calculate activation derivative from layer
+
+   return(calculate_activations_derivatives(combination.to_row_matrix()).to_vector());
+}
+
+
+// Vector<double> calculate_activations_second_derivatives(const Vector<double>&) const method
 
 /// Returns the activation second derivative from every perceptron as a function of their combination. 
 /// @param combination Combination to every perceptron in the layer. 
 
-Vector<double> PerceptronLayer::calculate_activations_second_derivatives(const Vector<double>& combination) const
+Vector<double> PerceptronLayer::calculate_activations_second_derivatives(const Vector<double>& combination) const
+{
+   const size_t perceptrons_number = get_perceptrons_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__ 
+
+   const size_t combination_size = combination.size();
+
+   if(combination_size != perceptrons_number) 
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "Vector<double> calculate_activations_second_derivatives(const Vector<double>&) const method.\n"
+             << "Size of combinations must be equal to number of neurons.\n";
+
+	  throw std::logic_error(buffer.str());
+   }   
+
+   #endif
+
+   // Calculate activation second derivative from layer
+
+   Vector<double> activation_second_derivatives(perceptrons_number);
+
+   switch(activation_function)
+   {
+      case Perceptron::Logistic:
+      {
+         for(size_t i = 0; i < perceptrons_number; i++)
+         {
+            const double logistic = 1.0/(1.0 + exp(-combination[i]));
+
+            activation_second_derivatives[i] = logistic*(1.0 - logistic)*(1.0 - 2.0*logistic);
+         }
+      }
+      break;
+
+      case Perceptron::HyperbolicTangent:
+      {
+         for(size_t i = 0; i < perceptrons_number; i++)
+         {
+            const double hyperbolic_tangent = tanh(combination[i]);
+
+            activation_second_derivatives[i] = -2.0*hyperbolic_tangent*(1.0 - hyperbolic_tangent*hyperbolic_tangent);
+         }
+      }
+      break;
+
+      case Perceptron::Threshold:
+      case Perceptron::SymmetricThreshold:
+      {
+         if(combination.contains(0.0))
+         {
+            std::ostringstream buffer;
+
+            buffer << "OpenNN Exception: PerceptronLayer class.\n"
+                   << "Vector<double> calculate_activations_second_derivatives(const Vector<double>&) const method.\n"
+                   << "Threshold activation functions are not derivable.\n";
+
+            throw std::logic_error(buffer.str());
+         }
+
+         activation_second_derivatives.initialize(0.0);
+      }
+      break;
+
+      case Perceptron::Linear:
+      {
+         activation_second_derivatives.initialize(0.0);
+      }
+      break;
+   }
+
+   return(activation_second_derivatives);
+}
+
+
+// Matrix<double> calculate_activations(const Matrix<double>&) const method
+
+/// Returns the activations of the layer for a batch of combinations.
+/// @param combinations Matrix of combinations. Each row contains the combinations for one instance.
+
+Matrix<double> PerceptronLayer::calculate_activations(const Matrix<double>& combinations) const
+{
+   Matrix<double> activations;
+
+   calculate_activations(combinations, activations);
+
+   return(activations);
+}
+
+
+// Matrix<double> calculate_activations_derivatives(const Matrix<double>&) const method
+
+/// Returns the activation derivatives of the layer for a batch of combinations.
+/// @param combinations Matrix of combinations. Each row contains the combinations for one instance.
+
+Matrix<double> PerceptronLayer::calculate_activations_derivatives(const Matrix<double>& combinations) const
+{
+   Matrix<double> activations_derivatives;
+
+   calculate_activations_derivatives(combinations, activations_derivatives);
+
+   return(activations_derivatives);
+}
+
+
+// void calculate_activations(const Matrix<T>&, Matrix<T>&) const method
+
+/// Writes the activations of the layer for a batch of combinations into a given matrix.
+/// The activation function is resolved once for the whole layer, and then applied to every element.
+/// The matrix is only reallocated when its size changes.
+/// It is instantiated for double and float.
+/// @param combinations Matrix of combinations. Each row contains the combinations for one instance.
+/// @param activations Matrix where the activations are written.
+
+template <class T>
+void PerceptronLayer::calculate_activations(const Matrix<T>& combinations, Matrix<T>& activations) const
+{
+   const size_t rows_number = combinations.get_rows_number();
+   const size_t columns_number = combinations.get_columns_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   const size_t perceptrons_number = get_perceptrons_number();
+
+   if(columns_number != perceptrons_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "void calculate_activations(const Matrix<T>&, Matrix<T>&) const method.\n"
+             << "Number of columns of combinations must be equal to number of neurons.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   const size_t size = rows_number*columns_number;
+
+   activations.set(rows_number, columns_number);
+
+   if(size == 0)
+   {
+      return;
+   }
+
+   switch(get_activation_function())
+   {
+      case Perceptron::Logistic:
+      {
+         #ifdef __OPENNN_FAST_ACTIVATIONS__
+
+         calculate_fast_logistic_activations(combinations.data(), size, activations.data());
+
+         #else
+
+         calculate_logistic_activations(combinations.data(), size, activations.data());
+
+         #endif
+      }
+      break;
+
+      case Perceptron::HyperbolicTangent:
+      {
+         #ifdef __OPENNN_FAST_ACTIVATIONS__
+
+         calculate_fast_hyperbolic_tangent_activations(combinations.data(), size, activations.data());
+
+         #else
+
+         calculate_hyperbolic_tangent_activations(combinations.data(), size, activations.data());
+
+         #endif
+      }
+      break;
+
+      case Perceptron::Threshold:
+      {
+         for(size_t i = 0; i < size; i++)
+         {
+            activations[i] = combinations[i] < 0 ? (T)0 : (T)1;
+         }
+      }
+      break;
+
+      case Perceptron::SymmetricThreshold:
+      {
+         for(size_t i = 0; i < size; i++)
+         {
+            activations[i] = combinations[i] < 0 ? (T)-1 : (T)1;
+         }
+      }
+      break;
+
+      case Perceptron::Linear:
+      {
+         activations = combinations;
+      }
+      break;
+
+      default:
+      {
+         std::ostringstream buffer;
+
+         buffer << "OpenNN Exception: PerceptronLayer class.\n"
+                << "void calculate_activations(const Matrix<T>&, Matrix<T>&) const method.\n"
+                << "Unknown activation function.\n";
+
+         throw std::logic_error(buffer.str());
+      }
+      break;
+   }
+}
+
+
+template void PerceptronLayer::calculate_activations<double>(const Matrix<double>&, Matrix<double>&) const;
+template void PerceptronLayer::calculate_activations<float>(const Matrix<float>&, Matrix<float>&) const;
+
+
+// void calculate_activations_derivatives(const Matrix<T>&, Matrix<T>&) const method
+
+/// Writes the activation derivatives of the layer for a batch of combinations into a given matrix.
+/// The matrix is only reallocated when its size changes.
+/// @param combinations Matrix of combinations. Each row contains the combinations for one instance.
+/// @param activations_derivatives Matrix where the activation derivatives are written.
+
+template <class T>
+void PerceptronLayer::calculate_activations_derivatives(const Matrix<T>& combinations, Matrix<T>& activations_derivatives) const
+{
+   const size_t rows_number = combinations.get_rows_number();
+   const size_t columns_number = combinations.get_columns_number();
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   const size_t perceptrons_number = get_perceptrons_number();
+
+   if(columns_number != perceptrons_number)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: PerceptronLayer class.\n"
+             << "void calculate_activations_derivatives(const Matrix<T>&, Matrix<T>&) const method.\n"
+             << "Number of columns of combinations must be equal to number of neurons.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   const size_t size = rows_number*columns_number;
+
+   activations_derivatives.set(rows_number, columns_number);
+
+   if(size == 0)
+   {
+      return;
+   }
+
+   switch(get_activation_function())
+   {
+      case Perceptron::Logistic:
+      {
+         #ifdef __OPENNN_FAST_ACTIVATIONS__
+
+         calculate_fast_logistic_activations_derivatives(combinations.data(), size, activations_derivatives.data());
+
+         #else
+
+         calculate_logistic_activations_derivatives(combinations.data(), size, activations_derivatives.data());
+
+         #endif
+      }
+      break;
+
+      case Perceptron::HyperbolicTangent:
+      {
+         #ifdef __OPENNN_FAST_ACTIVATIONS__
+
+         calculate_fast_hyperbolic_tangent_activations_derivatives(combinations.data(), size, activations_derivatives.data());
+
+         #else
+
+         calculate_hyperbolic_tangent_activations_derivatives(combinations.data(), size, activations_derivatives.data());
+
+         #endif
+      }
+      break;
+
+      case Perceptron::Threshold:
+      case Perceptron::SymmetricThreshold:
+      {
+         for(size_t i = 0; i < size; i++)
+         {
+            if(combinations[i] == 0)
+            {
+               std::ostringstream buffer;
+
+               buffer << "OpenNN Exception: PerceptronLayer class.\n"
+                      << "void calculate_activations_derivatives(const Matrix<T>&, Matrix<T>&) const method.\n"
+                      << "Threshold activation function is not derivable.\n";
+
+               throw std::logic_error(buffer.str());
+            }
+         }
+
+         activations_derivatives.initialize((T)0);
+      }
+      break;
+
+      case Perceptron::Linear:
+      {
+         activations_derivatives.initialize((T)1);
+      }
+      break;
+
+      default:
+      {
+         std::ostringstream buffer;
+
+         buffer << "OpenNN Exception: PerceptronLayer class.\n"
+                << "void calculate_activations_derivatives(const Matrix<T>&, Matrix<T>&) const method.\n"
+                << "Unknown activation function.\n";
+
+         throw std::logic_error(buffer.str());
+      }
+      break;
+   }
+}
+
+template void PerceptronLayer::calculate_activations_derivatives<double>(const Matrix<double>&, Matrix<double>&) const;
+template void PerceptronLayer::calculate_activations_derivatives<float>(const Matrix<float>&, Matrix<float>&) const;
+
+
+// void calculate_logistic_activations(const T*, const size_t&, T*) method
+
+/// Writes the logistic function of an array of combinations.
+/// The loop has no branches, so that the compiler can vectorize it.
+/// It is instantiated for double and float.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations Pointer to the first activation. It can be equal to the combinations pointer.
+
+template <class T>
+void PerceptronLayer::calculate_logistic_activations(const T* combinations, const size_t& size, T* activations)
 {
-   const size_t perceptrons_number = get_perceptrons_number();
+   const T one = 1;
 
-   // Control sentence (if debug)
+   for(size_t i = 0; i < size; i++)
+   {
+      activations[i] = one/(one + std::exp(-combinations[i]));
+   }
+}
 
-   #ifdef __OPENNN_DEBUG__ 
 
-   const size_t combination_size = combination.size();
+// void calculate_logistic_activations_derivatives(const T*, const size_t&, T*) method
 
-   if(combination_size != perceptrons_number) 
+/// Writes the derivative of the logistic function of an array of combinations.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations_derivatives Pointer to the first activation derivative.
+
+template <class T>
+void PerceptronLayer::calculate_logistic_activations_derivatives(const T* combinations, const size_t& size, T* activations_derivatives)
+{
+   const T one = 1;
+
+   T logistic_function;
+
+   for(size_t i = 0; i < size; i++)
    {
-      std::ostringstream buffer;
+      logistic_function = one/(one + std::exp(-combinations[i]));
 
-      buffer << "OpenNN Exception: PerceptronLayer class.\n"
-             << "Vector<double> calculate_activations_second_derivatives(const Vector<double>&) const method.\n"
-             << "Size of combinations must be equal to number of neurons.\n";
+      activations_derivatives[i] = logistic_function*(one-logistic_function);
+   }
+}
 
-	  throw std::logic_error(buffer.str());
-   }   
+
+// void calculate_hyperbolic_tangent_activations(const T*, const size_t&, T*) method
+
+/// Writes the hyperbolic tangent of an array of combinations.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations Pointer to the first activation. It can be equal to the combinations pointer.
+
+template <class T>
+void PerceptronLayer::calculate_hyperbolic_tangent_activations(const T* combinations, const size_t& size, T* activations)
+{
+   const T one = 1;
+   const T two = 2;
+
+   for(size_t i = 0; i < size; i++)
+   {
+      activations[i] = one-two/(std::exp(two*combinations[i])+one);
+   }
+}
+
+
+// void calculate_hyperbolic_tangent_activations_derivatives(const T*, const size_t&, T*) method
+
+/// Writes the derivative of the hyperbolic tangent of an array of combinations.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations_derivatives Pointer to the first activation derivative.
+
+template <class T>
+void PerceptronLayer::calculate_hyperbolic_tangent_activations_derivatives(const T* combinations, const size_t& size, T* activations_derivatives)
+{
+   const T one = 1;
+
+   T tanh_combination;
+
+   for(size_t i = 0; i < size; i++)
+   {
+      tanh_combination = std::tanh(combinations[i]);
+
+      activations_derivatives[i] = one - tanh_combination*tanh_combination;
+   }
+}
+
+
+// Fast hyperbolic tangent
+
+// The fast activation kernels replace the exponential by a rational approximation of the hyperbolic tangent,
+// tanh(x) = x*P(x^2)/Q(x^2), with P of degree 6 and Q of degree 3, and the argument clamped to |x| <= 7.9053.
+// Its absolute error is below 3.0e-7 on the whole real line, and the logistic function is obtained
+// from it as 1/2 + tanh(x/2)/2, with an absolute error below 1.5e-7.
+// The approximation needs only products, sums and one division, so that it is evaluated with AVX-512 or AVX2 packets
+// when the compiler targets those instruction sets, and with scalar code otherwise.
+// In single precision the packets hold twice as many elements, and the error is dominated by the float rounding.
+
+static const double fast_tanh_clamp = 7.90531110763549805;
+
+static const double fast_tanh_numerator[7] =
+{4.89352455891786e-03, 6.37261928875436e-04, 1.48572235717979e-05, 5.12229709037114e-08,
+ -8.60467152213735e-11, 2.00018790482477e-13, -2.76076847742355e-16};
+
+static const double fast_tanh_denominator[4] =
+{4.89352518554385e-03, 2.26843463243900e-03, 1.18534705686654e-04, 1.19825839466702e-06};
+
+
+template <class T>
+static inline T calculate_fast_tanh(const T& argument)
+{
+   const T clamp = (T)fast_tanh_clamp;
+
+   const T x = std::min(std::max(argument, -clamp), clamp);
+   const T x2 = x*x;
+
+   T numerator = (T)fast_tanh_numerator[6];
+
+   for(int k = 5; k >= 0; k--)
+   {
+      numerator = numerator*x2 + (T)fast_tanh_numerator[k];
+   }
+
+   T denominator = (T)fast_tanh_denominator[3];
+
+   for(int k = 2; k >= 0; k--)
+   {
+      denominator = denominator*x2 + (T)fast_tanh_denominator[k];
+   }
+
+   return(x*numerator/denominator);
+}
+
+
+#if defined(__AVX512F__)
+
+static inline __m512d calculate_fast_tanh(const __m512d& argument)
+{
+   const __m512d x = _mm512_min_pd(_mm512_max_pd(argument, _mm512_set1_pd(-fast_tanh_clamp)), _mm512_set1_pd(fast_tanh_clamp));
+   const __m512d x2 = _mm512_mul_pd(x, x);
+
+   __m512d numerator = _mm512_set1_pd(fast_tanh_numerator[6]);
+
+   for(int k = 5; k >= 0; k--)
+   {
+      numerator = _mm512_fmadd_pd(numerator, x2, _mm512_set1_pd(fast_tanh_numerator[k]));
+   }
+
+   __m512d denominator = _mm512_set1_pd(fast_tanh_denominator[3]);
+
+   for(int k = 2; k >= 0; k--)
+   {
+      denominator = _mm512_fmadd_pd(denominator, x2, _mm512_set1_pd(fast_tanh_denominator[k]));
+   }
+
+   return(_mm512_div_pd(_mm512_mul_pd(x, numerator), denominator));
+}
+
+
+static inline __m512 calculate_fast_tanh(const __m512& argument)
+{
+   const __m512 x = _mm512_min_ps(_mm512_max_ps(argument, _mm512_set1_ps((float)-fast_tanh_clamp)), _mm512_set1_ps((float)fast_tanh_clamp));
+   const __m512 x2 = _mm512_mul_ps(x, x);
+
+   __m512 numerator = _mm512_set1_ps((float)fast_tanh_numerator[6]);
+
+   for(int k = 5; k >= 0; k--)
+   {
+      numerator = _mm512_fmadd_ps(numerator, x2, _mm512_set1_ps((float)fast_tanh_numerator[k]));
+   }
+
+   __m512 denominator = _mm512_set1_ps((float)fast_tanh_denominator[3]);
+
+   for(int k = 2; k >= 0; k--)
+   {
+      denominator = _mm512_fmadd_ps(denominator, x2, _mm512_set1_ps((float)fast_tanh_denominator[k]));
+   }
+
+   return(_mm512_div_ps(_mm512_mul_ps(x, numerator), denominator));
+}
+
+#endif
+
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+static inline __m256d calculate_fast_tanh(const __m256d& argument)
+{
+   const __m256d x = _mm256_min_pd(_mm256_max_pd(argument, _mm256_set1_pd(-fast_tanh_clamp)), _mm256_set1_pd(fast_tanh_clamp));
+   const __m256d x2 = _mm256_mul_pd(x, x);
+
+   __m256d numerator = _mm256_set1_pd(fast_tanh_numerator[6]);
+
+   for(int k = 5; k >= 0; k--)
+   {
+      numerator = _mm256_fmadd_pd(numerator, x2, _mm256_set1_pd(fast_tanh_numerator[k]));
+   }
+
+   __m256d denominator = _mm256_set1_pd(fast_tanh_denominator[3]);
+
+   for(int k = 2; k >= 0; k--)
+   {
+      denominator = _mm256_fmadd_pd(denominator, x2, _mm256_set1_pd(fast_tanh_denominator[k]));
+   }
+
+   return(_mm256_div_pd(_mm256_mul_pd(x, numerator), denominator));
+}
+
+
+static inline __m256 calculate_fast_tanh(const __m256& argument)
+{
+   const __m256 x = _mm256_min_ps(_mm256_max_ps(argument, _mm256_set1_ps((float)-fast_tanh_clamp)), _mm256_set1_ps((float)fast_tanh_clamp));
+   const __m256 x2 = _mm256_mul_ps(x, x);
+
+   __m256 numerator = _mm256_set1_ps((float)fast_tanh_numerator[6]);
+
+   for(int k = 5; k >= 0; k--)
+   {
+      numerator = _mm256_fmadd_ps(numerator, x2, _mm256_set1_ps((float)fast_tanh_numerator[k]));
+   }
+
+   __m256 denominator = _mm256_set1_ps((float)fast_tanh_denominator[3]);
+
+   for(int k = 2; k >= 0; k--)
+   {
+      denominator = _mm256_fmadd_ps(denominator, x2, _mm256_set1_ps((float)fast_tanh_denominator[k]));
+   }
+
+   return(_mm256_div_ps(_mm256_mul_ps(x, numerator), denominator));
+}
+
+#endif
+
+
+/// Writes offset + scale*tanh(slope*x) for the whole packets at the beginning of a double precision array,
+/// with the widest instruction set available, and returns the number of elements written.
+
+static size_t calculate_fast_tanh_packets(const double* x, const size_t& size, const double& offset, const double& scale, const double& slope, double* y)
+{
+   size_t i = 0;
+
+   #if defined(__AVX512F__)
+
+   const __m512d offset_512 = _mm512_set1_pd(offset);
+   const __m512d scale_512 = _mm512_set1_pd(scale);
+   const __m512d slope_512 = _mm512_set1_pd(slope);
+
+   for(; i + 8 <= size; i += 8)
+   {
+      const __m512d tanh_512 = calculate_fast_tanh(_mm512_mul_pd(slope_512, _mm512_loadu_pd(x + i)));
+
+      _mm512_storeu_pd(y + i, _mm512_fmadd_pd(scale_512, tanh_512, offset_512));
+   }
 
    #endif
 
-   // Calculate activation second derivative from layer
+   #if defined(__AVX2__) && defined(__FMA__)
 
-   Vector<double> activation_second_derivatives(perceptrons_number);
+   const __m256d offset_256 = _mm256_set1_pd(offset);
+   const __m256d scale_256 = _mm256_set1_pd(scale);
+   const __m256d slope_256 = _mm256_set1_pd(slope);
 
-   for(size_t i = 0; i < perceptrons_number; i++)
-   {          
-      activation_second_derivatives[i] = perceptrons[i].calculate_activation_second_derivative(combination[i]);
+   for(; i + 4 <= size; i += 4)
+   {
+      const __m256d tanh_256 = calculate_fast_tanh(_mm256_mul_pd(slope_256, _mm256_loadu_pd(x + i)));
+
+      _mm256_storeu_pd(y + i, _mm256_fmadd_pd(scale_256, tanh_256, offset_256));
    }
 
-   return(activation_second_derivatives);
+   #endif
+
+   #if !defined(__AVX512F__) && !(defined(__AVX2__) && defined(__FMA__))
+
+   // Without vector instructions there are no packets, and every element is left to the scalar code
+
+   (void)x;
+   (void)size;
+   (void)offset;
+   (void)scale;
+   (void)slope;
+   (void)y;
+
+   #endif
+
+   return(i);
+}
+
+
+/// Writes offset + scale*tanh(slope*x) for the whole packets at the beginning of a single precision array,
+/// with the widest instruction set available, and returns the number of elements written.
+
+static size_t calculate_fast_tanh_packets(const float* x, const size_t& size, const float& offset, const float& scale, const float& slope, float* y)
+{
+   size_t i = 0;
+
+   #if defined(__AVX512F__)
+
+   const __m512 offset_512 = _mm512_set1_ps(offset);
+   const __m512 scale_512 = _mm512_set1_ps(scale);
+   const __m512 slope_512 = _mm512_set1_ps(slope);
+
+   for(; i + 16 <= size; i += 16)
+   {
+      const __m512 tanh_512 = calculate_fast_tanh(_mm512_mul_ps(slope_512, _mm512_loadu_ps(x + i)));
+
+      _mm512_storeu_ps(y + i, _mm512_fmadd_ps(scale_512, tanh_512, offset_512));
+   }
+
+   #endif
+
+   #if defined(__AVX2__) && defined(__FMA__)
+
+   const __m256 offset_256 = _mm256_set1_ps(offset);
+   const __m256 scale_256 = _mm256_set1_ps(scale);
+   const __m256 slope_256 = _mm256_set1_ps(slope);
+
+   for(; i + 8 <= size; i += 8)
+   {
+      const __m256 tanh_256 = calculate_fast_tanh(_mm256_mul_ps(slope_256, _mm256_loadu_ps(x + i)));
+
+      _mm256_storeu_ps(y + i, _mm256_fmadd_ps(scale_256, tanh_256, offset_256));
+   }
+
+   #endif
+
+   #if !defined(__AVX512F__) && !(defined(__AVX2__) && defined(__FMA__))
+
+   // Without vector instructions there are no packets, and every element is left to the scalar code
+
+   (void)x;
+   (void)size;
+   (void)offset;
+   (void)scale;
+   (void)slope;
+   (void)y;
+
+   #endif
+
+   return(i);
+}
+
+
+/// Writes offset + scale*tanh(slope*x) for every element of an array, using the fast hyperbolic tangent.
+/// Whole packets are processed with the widest instruction set available, and the remainder with scalar code.
+
+template <class T>
+static void calculate_fast_tanh(const T* x, const size_t& size, const T& offset, const T& scale, const T& slope, T* y)
+{
+   for(size_t i = calculate_fast_tanh_packets(x, size, offset, scale, slope, y); i < size; i++)
+   {
+      y[i] = offset + scale*calculate_fast_tanh(slope*x[i]);
+   }
+}
+
+
+// void calculate_fast_logistic_activations(const T*, const size_t&, T*) method
+
+/// Writes an approximation of the logistic function of an array of combinations,
+/// with an absolute error below 1.5e-7 in double precision.
+/// It is used by the layers when the library is built with __OPENNN_FAST_ACTIVATIONS__.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations Pointer to the first activation. It can be equal to the combinations pointer.
+
+template <class T>
+void PerceptronLayer::calculate_fast_logistic_activations(const T* combinations, const size_t& size, T* activations)
+{
+   const T half = (T)0.5;
+
+   calculate_fast_tanh(combinations, size, half, half, half, activations);
+}
+
+
+// void calculate_fast_logistic_activations_derivatives(const T*, const size_t&, T*) method
+
+/// Writes an approximation of the derivative of the logistic function of an array of combinations,
+/// with an absolute error below 1.5e-7 in double precision.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations_derivatives Pointer to the first activation derivative.
+
+template <class T>
+void PerceptronLayer::calculate_fast_logistic_activations_derivatives(const T* combinations, const size_t& size, T* activations_derivatives)
+{
+   const T half = (T)0.5;
+   const T one = 1;
+
+   calculate_fast_tanh(combinations, size, half, half, half, activations_derivatives);
+
+   for(size_t i = 0; i < size; i++)
+   {
+      activations_derivatives[i] = activations_derivatives[i]*(one-activations_derivatives[i]);
+   }
+}
+
+
+// void calculate_fast_hyperbolic_tangent_activations(const T*, const size_t&, T*) method
+
+/// Writes an approximation of the hyperbolic tangent of an array of combinations,
+/// with an absolute error below 3.0e-7 in double precision.
+/// It is used by the layers when the library is built with __OPENNN_FAST_ACTIVATIONS__.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations Pointer to the first activation. It can be equal to the combinations pointer.
+
+template <class T>
+void PerceptronLayer::calculate_fast_hyperbolic_tangent_activations(const T* combinations, const size_t& size, T* activations)
+{
+   const T zero = 0;
+   const T one = 1;
+
+   calculate_fast_tanh(combinations, size, zero, one, one, activations);
+}
+
+
+// void calculate_fast_hyperbolic_tangent_activations_derivatives(const T*, const size_t&, T*) method
+
+/// Writes an approximation of the derivative of the hyperbolic tangent of an array of combinations,
+/// with an absolute error below 6.0e-7 in double precision.
+/// @param combinations Pointer to the first combination.
+/// @param size Number of combinations.
+/// @param activations_derivatives Pointer to the first activation derivative.
+
+template <class T>
+void PerceptronLayer::calculate_fast_hyperbolic_tangent_activations_derivatives(const T* combinations, const size_t& size, T* activations_derivatives)
+{
+   const T zero = 0;
+   const T one = 1;
+
+   calculate_fast_tanh(combinations, size, zero, one, one, activations_derivatives);
+
+   for(size_t i = 0; i < size; i++)
+   {
+      activations_derivatives[i] = one - activations_derivatives[i]*activations_derivatives[i];
+   }
 }
 
 
+// Explicit instantiations of the activation kernels
+
+template void PerceptronLayer::calculate_logistic_activations<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_logistic_activations<float>(const float*, const size_t&, float*);
+template void PerceptronLayer::calculate_logistic_activations_derivatives<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_logistic_activations_derivatives<float>(const float*, const size_t&, float*);
+
+template void PerceptronLayer::calculate_hyperbolic_tangent_activations<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_hyperbolic_tangent_activations<float>(const float*, const size_t&, float*);
+template void PerceptronLayer::calculate_hyperbolic_tangent_activations_derivatives<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_hyperbolic_tangent_activations_derivatives<float>(const float*, const size_t&, float*);
+
+template void PerceptronLayer::calculate_fast_logistic_activations<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_fast_logistic_activations<float>(const float*, const size_t&, float*);
+template void PerceptronLayer::calculate_fast_logistic_activations_derivatives<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_fast_logistic_activations_derivatives<float>(const float*, const size_t&, float*);
+
+template void PerceptronLayer::calculate_fast_hyperbolic_tangent_activations<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_fast_hyperbolic_tangent_activations<float>(const float*, const size_t&, float*);
+template void PerceptronLayer::calculate_fast_hyperbolic_tangent_activations_derivatives<double>(const double*, const size_t&, double*);
+template void PerceptronLayer::calculate_fast_hyperbolic_tangent_activations_derivatives<float>(const float*, const size_t&, float*);
+
+
 // Matrix<double> arrange_activations_Jacobian(const Vector<double>&) const method
 
 /// Arranges a "Jacobian" matrix from a vector of derivatives. 
@@ -1737,6 +2809,30 @@ Vector< Matrix<double> > PerceptronLayer::calculate_Hessian_form(const Vector<do
 }
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&) const method
+
+/// Returns the outputs of the layer for a batch of inputs.
+/// Each row of the returned matrix contains the outputs for the corresponding row of inputs.
+/// @param inputs Matrix of inputs to the layer.
+
+Matrix<double> PerceptronLayer::calculate_outputs(const Matrix<double>& inputs) const
+{
+   return(calculate_activations(calculate_combinations(inputs)));
+}
+
+
+// Matrix<double> calculate_outputs(const Matrix<double>&, const Vector<double>&) const method
+
+/// Returns which would be the outputs of the layer for a batch of inputs and a set of parameters.
+/// @param inputs Matrix of inputs to the layer.
+/// @param parameters Set of layer parameters.
+
+Matrix<double> PerceptronLayer::calculate_outputs(const Matrix<double>& inputs, const Vector<double>& parameters) const
+{
+   return(calculate_activations(calculate_combinations(inputs, parameters)));
+}
+
+
 // std::string write_expression(const Vector<std::string>&, const Vector<std::string>&) const method
 
 /// Returns a string with the expression of the inputs-outputs relationship of the layer.
@@ -1784,7 +2880,7 @@ std::string PerceptronLayer::write_expression(const Vector<std::string>& inputs_
 
    for(size_t i = 0; i < perceptrons_number; i++)
    {
-      buffer << perceptrons[i].write_expression(inputs_name, outputs_name[i]);      
+      buffer << get_perceptron(i).write_expression(inputs_name, outputs_name[i]);      
    }
 
    return(buffer.str());
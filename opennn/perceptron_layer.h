@@ -35,6 +35,9 @@ namespace OpenNN
 
 /// This class represents a layer of perceptrons.
 /// Layers of perceptrons will be used to construct multilayer perceptrons. 
+/// The parameters of the layer are stored in a single contiguous buffer, which can be owned by the layer
+/// or bound to a larger buffer, such as the parameters of a multilayer perceptron.
+/// Single Perceptron objects are only built on request.
 
 class PerceptronLayer
 {
@@ -69,8 +72,8 @@ public:
 
    bool is_empty(void) const;
 
-   const Vector<Perceptron>& get_perceptrons(void) const;
-   const Perceptron& get_perceptron(const size_t&) const;
+   Vector<Perceptron> get_perceptrons(void) const;
+   Perceptron get_perceptron(const size_t&) const;
 
    size_t get_inputs_number(void) const;
    size_t get_perceptrons_number(void) const;
@@ -88,6 +91,8 @@ public:
 
    Vector<size_t> count_cumulative_parameters_number(void) const;
 
+   const double* get_parameters_data(void) const;
+
    // Activation functions
 
    const Perceptron::ActivationFunction& get_activation_function(void) const;
@@ -122,6 +127,8 @@ public:
 
    void set_parameters(const Vector<double>&);
 
+   void bind_parameters(double*);
+
    // Activation functions
 
    void set_activation_function(const Perceptron::ActivationFunction&);
@@ -176,12 +183,39 @@ public:
    Matrix<double> calculate_combinations_Jacobian(const Vector<double>&, const Vector<double>&) const;
    Vector< Matrix<double> > calculate_combinations_Hessian_form(const Vector<double>&, const Vector<double>&) const;
 
+   Matrix<double> calculate_combinations(const Matrix<double>&) const;
+   Matrix<double> calculate_combinations(const Matrix<double>&, const Vector<double>&) const;
+
+   void calculate_combinations(const Matrix<double>&, Matrix<double>&) const;
+
+   template <class T> void calculate_combinations(const Matrix<T>&, const T*, Matrix<T>&) const;
+
    // Perceptron layer activations
 
    Vector<double> calculate_activations(const Vector<double>&) const;
    Vector<double> calculate_activations_derivatives(const Vector<double>&) const;
    Vector<double> calculate_activations_second_derivatives(const Vector<double>&) const;
 
+   Matrix<double> calculate_activations(const Matrix<double>&) const;
+   Matrix<double> calculate_activations_derivatives(const Matrix<double>&) const;
+
+   template <class T> void calculate_activations(const Matrix<T>&, Matrix<T>&) const;
+   template <class T> void calculate_activations_derivatives(const Matrix<T>&, Matrix<T>&) const;
+
+   // Activation kernels, instantiated for double and float
+
+   template <class T> static void calculate_logistic_activations(const T*, const size_t&, T*);
+   template <class T> static void calculate_logistic_activations_derivatives(const T*, const size_t&, T*);
+
+   template <class T> static void calculate_hyperbolic_tangent_activations(const T*, const size_t&, T*);
+   template <class T> static void calculate_hyperbolic_tangent_activations_derivatives(const T*, const size_t&, T*);
+
+   template <class T> static void calculate_fast_logistic_activations(const T*, const size_t&, T*);
+   template <class T> static void calculate_fast_logistic_activations_derivatives(const T*, const size_t&, T*);
+
+   template <class T> static void calculate_fast_hyperbolic_tangent_activations(const T*, const size_t&, T*);
+   template <class T> static void calculate_fast_hyperbolic_tangent_activations_derivatives(const T*, const size_t&, T*);
+
    Matrix<double> arrange_activations_Jacobian(const Vector<double>&) const;
    Vector< Matrix<double> > arrange_activations_Hessian_form(const Vector<double>&) const;
 
@@ -195,6 +229,9 @@ public:
    Matrix<double> calculate_Jacobian(const Vector<double>&, const Vector<double>&) const;
    Vector< Matrix<double> > calculate_Hessian_form(const Vector<double>&, const Vector<double>&) const;
 
+   Matrix<double> calculate_outputs(const Matrix<double>&) const;
+   Matrix<double> calculate_outputs(const Matrix<double>&, const Vector<double>&) const;
+
    // Expression methods
 
    std::string write_expression(const Vector<std::string>&, const Vector<std::string>&) const;
@@ -206,12 +243,34 @@ public:
 
 protected:
 
+   // METHODS
+
+   void set_parameters_size(const size_t&, const size_t&);
+
    // MEMBERS
 
-   /// Vectors of perceptrons which defines the layer.
-   /// The size of the vector is equal to the number of perceptrons in the layer.
+   /// Storage owned by the layer for its parameters, arranged perceptron by perceptron with the bias first.
+   /// It can be seen as a matrix with one plus the number of inputs rows and the number of perceptrons columns,
+   /// so that the bias and the synaptic weights of each perceptron are contiguous in memory.
+   /// It is empty when the parameters are bound to an external buffer.
+
+   Vector<double> owned_parameters;
+
+   /// Pointer to the parameters in use, either in the storage owned by the layer or in an external buffer.
+
+   double* parameters_data;
+
+   /// Number of inputs to the layer.
+
+   size_t inputs_number;
+
+   /// Number of perceptrons in the layer.
+
+   size_t perceptrons_number;
+
+   /// Activation function shared by all the perceptrons in the layer.
 
-   Vector<Perceptron> perceptrons;
+   Perceptron::ActivationFunction activation_function;
 
    /// Display messages to screen. 
 
@@ -238,6 +238,46 @@ Vector<double> PrincipalComponentsLayer::calculate_outputs(const Vector<double>&
 }
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&) const method
+
+/// Projects a batch of inputs onto the principal components with a single matrix product.
+/// @param inputs Matrix of inputs to the principal components layer. Each row contains one input vector.
+
+Matrix<double> PrincipalComponentsLayer::calculate_outputs(const Matrix<double>& inputs) const
+{
+    if(write_principal_components_method() != "PrincipalComponents")
+    {
+        return inputs;
+    }
+
+    const size_t rows_number = inputs.get_rows_number();
+    const size_t inputs_number = inputs.get_columns_number();
+
+    const Vector<size_t> principal_components_indices(0, 1.0, get_principal_components_number()-1);
+    const Vector<size_t> inputs_indices(0, 1.0, inputs_number-1);
+
+    const Matrix<double> used_principal_components = principal_components.arrange_submatrix(principal_components_indices, inputs_indices);
+
+    // Data adjust
+
+    Matrix<double> inputs_adjust(inputs);
+
+    for(size_t j = 0; j < inputs_number; j++)
+    {
+        double* column = inputs_adjust.data() + j*rows_number;
+
+        for(size_t i = 0; i < rows_number; i++)
+        {
+            column[i] -= means[j];
+        }
+    }
+
+    // Outputs
+
+    return(inputs_adjust.dot(used_principal_components.calculate_transpose()));
+}
+
+
 // Matrix<double> calculate_Jacobian(const Vector<double>&) const
 
 /// Returns the partial derivatives of the outputs from the principal components layer with respect to its inputs.
@@ -123,6 +123,8 @@ public:
    Vector<double> calculate_outputs(const Vector<double>&) const;
    Matrix<double> calculate_Jacobian(const Vector<double>&) const;
 
+   Matrix<double> calculate_outputs(const Matrix<double>&) const;
+
    // Expression methods
 
    std::string write_expression(const Vector<std::string>&, const Vector<std::string>&) const;
@@ -570,6 +570,119 @@ Vector<double> ProbabilisticLayer::calculate_outputs(const Vector<double>& input
 }  
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&) const method
+
+/// Returns the outputs of the probabilistic layer for a batch of inputs.
+/// Element-wise methods are applied to the whole matrix, and row-wise methods (competitive and softmax) row by row.
+/// @param inputs Matrix of inputs to the probabilistic layer. Each row contains one input vector.
+
+Matrix<double> ProbabilisticLayer::calculate_outputs(const Matrix<double>& inputs) const
+{
+    const size_t rows_number = inputs.get_rows_number();
+    const size_t columns_number = inputs.get_columns_number();
+
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    if(columns_number != probabilistic_neurons_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: ProbabilisticLayer class.\n"
+               << "Matrix<double> calculate_outputs(const Matrix<double>&) const method.\n"
+               << "Number of columns of inputs must be equal to number of probabilistic neurons.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    Matrix<double> outputs(inputs);
+
+    switch(probabilistic_method)
+    {
+    case Binary:
+    {
+        for(size_t i = 0; i < outputs.size(); i++)
+        {
+            outputs[i] = inputs[i] < decision_threshold ? 0.0 : 1.0;
+        }
+    }
+        break;
+
+    case Probability:
+    case NoProbabilistic:
+    {
+    }
+        break;
+
+    case Competitive:
+    {
+        for(size_t i = 0; i < rows_number; i++)
+        {
+            size_t maximal_index = 0;
+
+            for(size_t j = 1; j < columns_number; j++)
+            {
+                if(inputs(i,j) > inputs(i,maximal_index))
+                {
+                    maximal_index = j;
+                }
+            }
+
+            for(size_t j = 0; j < columns_number; j++)
+            {
+                outputs(i,j) = j == maximal_index ? 1.0 : 0.0;
+            }
+        }
+    }
+        break;
+
+    case Softmax:
+    {
+        Vector<double> sums(rows_number, 0.0);
+
+        for(size_t i = 0; i < outputs.size(); i++)
+        {
+            outputs[i] = exp(inputs[i]);
+        }
+
+        for(size_t j = 0; j < columns_number; j++)
+        {
+            for(size_t i = 0; i < rows_number; i++)
+            {
+                sums[i] += outputs(i,j);
+            }
+        }
+
+        for(size_t j = 0; j < columns_number; j++)
+        {
+            for(size_t i = 0; i < rows_number; i++)
+            {
+                outputs(i,j) /= sums[i];
+            }
+        }
+    }
+        break;
+
+    default:
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: ProbabilisticLayer class.\n"
+               << "Matrix<double> calculate_outputs(const Matrix<double>&) const method.\n"
+               << "Unknown probabilistic method.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+        break;
+    }
+
+    return(outputs);
+}
+
+
 // Matrix<double> calculate_Jacobian(const Vector<double>&) const method
 
 /// Returns the partial derivatives of the outputs from the probabilistic layer with respect to its inputs,
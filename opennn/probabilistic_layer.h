@@ -120,6 +120,8 @@ public:
    Matrix<double> calculate_Jacobian(const Vector<double>&) const;
    Vector< Matrix<double> > calculate_Hessian_form(const Vector<double>&) const;
 
+   Matrix<double> calculate_outputs(const Matrix<double>&) const;
+
    Vector<double> calculate_binary_output(const Vector<double>&) const;
    Matrix<double> calculate_binary_Jacobian(const Vector<double>&) const;
    Vector< Matrix<double> > calculate_binary_Hessian_form(const Vector<double>&) const;
@@ -1139,7 +1139,16 @@ double* old_inverse_Hessian_d, double* auxiliar_matrix_d) const
 
 Vector<double> QuasiNewtonMethod::calculate_training_direction(const Vector<double>& gradient, const Matrix<double>& inverse_Hessian_approximation) const
 {
-   return((inverse_Hessian_approximation.dot(gradient)*(-1.0)).calculate_normalized());
+   Vector<double> training_direction = -(inverse_Hessian_approximation.eigen_map()*gradient.eigen_map());
+
+   const double training_direction_norm = training_direction.calculate_norm();
+
+   if(training_direction_norm != 0.0)
+   {
+      training_direction.eigen_map() /= training_direction_norm;
+   }
+
+   return(training_direction);
 }
 
 
@@ -1186,7 +1195,14 @@ Vector<double> QuasiNewtonMethod::calculate_gradient_descent_training_direction(
 
     #endif
 
-    return(gradient.calculate_normalized()*(-1.0));
+    const double gradient_norm = gradient.calculate_norm();
+
+    if(gradient_norm == 0.0)
+    {
+       return(Vector<double>(gradient.size(), 0.0));
+    }
+
+    return(gradient.eigen_map()*(-1.0/gradient_norm));
 }
 
 
@@ -1329,14 +1345,22 @@ const Vector<double>& old_parameters, const Vector<double>& parameters, const Ve
       throw std::logic_error(buffer.str());	  
    }
 
+   const Vector<double> Hessian_dot_gradient_difference = old_inverse_Hessian.dot(gradient_difference);
+
+   const double parameters_dot_gradient = parameters_difference.dot(gradient_difference);
+   const double gradient_dot_Hessian_dot_gradient = gradient_difference.dot(Hessian_dot_gradient_difference);
+
+   // Rank one updates, accumulated in place without forming the outer products
+
    Matrix<double> inverse_Hessian_approximation = old_inverse_Hessian;
 
-   const Vector<double> Hessian_dot_gradient_difference = old_inverse_Hessian.dot(gradient_difference);
+   Eigen::Map<Eigen::MatrixXd> inverse_Hessian_approximation_eigen = inverse_Hessian_approximation.eigen_map();
 
-   inverse_Hessian_approximation += parameters_difference.direct(parameters_difference)/parameters_difference.dot(gradient_difference);
+   inverse_Hessian_approximation_eigen.noalias()
+   += (parameters_difference.eigen_map()/parameters_dot_gradient)*parameters_difference.eigen_map().transpose();
 
-   inverse_Hessian_approximation -= (Hessian_dot_gradient_difference).direct(Hessian_dot_gradient_difference)
-            /gradient_difference.dot(Hessian_dot_gradient_difference);
+   inverse_Hessian_approximation_eigen.noalias()
+   -= (Hessian_dot_gradient_difference.eigen_map()/gradient_dot_Hessian_dot_gradient)*Hessian_dot_gradient_difference.eigen_map().transpose();
 
    return(inverse_Hessian_approximation);
 }
@@ -1482,20 +1506,23 @@ const Vector<double>& old_parameters, const Vector<double>& parameters, const Ve
    const Vector<double> Hessian_dot_gradient = old_inverse_Hessian.dot(gradient_difference);
    const double gradient_dot_Hessian_dot_gradient = gradient_difference.dot(Hessian_dot_gradient);
 
-   const Vector<double> BFGS = parameters_difference/parameters_dot_gradient
-   - Hessian_dot_gradient
-   /gradient_dot_Hessian_dot_gradient;
+   const Vector<double> BFGS = parameters_difference.eigen_map()/parameters_dot_gradient
+   - Hessian_dot_gradient.eigen_map()/gradient_dot_Hessian_dot_gradient;
 
-   // Calculate inverse Hessian approximation
+   // Calculate inverse Hessian approximation, with rank one updates accumulated in place
 
    Matrix<double> inverse_Hessian_approximation = old_inverse_Hessian;
 
-   inverse_Hessian_approximation += parameters_difference.direct(parameters_difference)/parameters_dot_gradient;
+   Eigen::Map<Eigen::MatrixXd> inverse_Hessian_approximation_eigen = inverse_Hessian_approximation.eigen_map();
+
+   inverse_Hessian_approximation_eigen.noalias()
+   += (parameters_difference.eigen_map()/parameters_dot_gradient)*parameters_difference.eigen_map().transpose();
 
-   inverse_Hessian_approximation -= (Hessian_dot_gradient).direct(Hessian_dot_gradient)
-   /gradient_dot_Hessian_dot_gradient;
+   inverse_Hessian_approximation_eigen.noalias()
+   -= (Hessian_dot_gradient.eigen_map()/gradient_dot_Hessian_dot_gradient)*Hessian_dot_gradient.eigen_map().transpose();
 
-   inverse_Hessian_approximation += (BFGS.direct(BFGS))*(gradient_dot_Hessian_dot_gradient);
+   inverse_Hessian_approximation_eigen.noalias()
+   += (BFGS.eigen_map()*gradient_dot_Hessian_dot_gradient)*BFGS.eigen_map().transpose();
 
    return(inverse_Hessian_approximation);
 }
@@ -1888,7 +1915,7 @@ QuasiNewtonMethod::QuasiNewtonMethodResults* QuasiNewtonMethod::perform_training
 
    const size_t parameters_number = neural_network_pointer->count_parameters_number();
 
-   Vector<double> parameters(parameters_number);
+   Vector<double> parameters = neural_network_pointer->arrange_parameters();
    Vector<double> old_parameters(parameters_number);
    double parameters_norm;
 
@@ -1905,6 +1932,8 @@ QuasiNewtonMethod::QuasiNewtonMethodResults* QuasiNewtonMethod::perform_training
    Vector<double> old_gradient(parameters_number);
    double gradient_norm;
 
+   LossIndex::FirstOrderloss first_order_loss;
+
    Matrix<double> inverse_Hessian(parameters_number, parameters_number);
    Matrix<double> old_inverse_Hessian(parameters_number, parameters_number);
 
@@ -2045,8 +2074,6 @@ QuasiNewtonMethod::QuasiNewtonMethodResults* QuasiNewtonMethod::perform_training
    {
       // Neural network
 
-      parameters = neural_network_pointer->arrange_parameters();
-
       parameters_norm = parameters.calculate_norm();
 
       if(display && parameters_norm >= warning_parameters_norm)
@@ -2058,16 +2085,20 @@ QuasiNewtonMethod::QuasiNewtonMethodResults* QuasiNewtonMethod::perform_training
 
       if(iteration == 0)
       {
-         loss = loss_index_pointer->calculate_loss();
-         loss_increase = 0.0; 
+         first_order_loss = loss_index_pointer->calculate_first_order_loss();
+
+         loss = first_order_loss.loss;
+         loss_increase = 0.0;
+
+         gradient = first_order_loss.gradient;
       }
       else
       {
          loss = directional_point[1];
-         loss_increase = old_loss - loss; 
-      }
+         loss_increase = old_loss - loss;
 
-      gradient = loss_index_pointer->calculate_gradient();
+         gradient = loss_index_pointer->calculate_gradient();
+      }
 
       gradient_norm = gradient.calculate_norm();
 
@@ -2129,7 +2160,7 @@ QuasiNewtonMethod::QuasiNewtonMethodResults* QuasiNewtonMethod::perform_training
       {
           minimum_selection_error = selection_loss;
 
-          minimum_selection_error_parameters = neural_network_pointer->arrange_parameters();
+          minimum_selection_error_parameters = parameters;
       }
       else if(iteration != 0 && selection_loss > old_selection_loss)
       {
@@ -2139,7 +2170,7 @@ QuasiNewtonMethod::QuasiNewtonMethodResults* QuasiNewtonMethod::perform_training
       {
           minimum_selection_error = selection_loss;
 
-          minimum_selection_error_parameters = neural_network_pointer->arrange_parameters();
+          minimum_selection_error_parameters = parameters;
       }
 
       // Training algorithm
@@ -2186,7 +2217,7 @@ QuasiNewtonMethod::QuasiNewtonMethodResults* QuasiNewtonMethod::perform_training
           training_rate = directional_point[0];
       }
 
-      parameters_increment = training_direction*training_rate;
+      parameters_increment = training_direction.eigen_map()*training_rate;
       parameters_increment_norm = parameters_increment.calculate_norm();
       
       // Elapsed time
@@ -27,6 +27,7 @@ namespace OpenNN
 
 RocAreaError::RocAreaError(void) : ErrorTerm()
 {
+   set_default();
 }
 
 
@@ -40,6 +41,7 @@ RocAreaError::RocAreaError(void) : ErrorTerm()
 RocAreaError::RocAreaError(NeuralNetwork* new_neural_network_pointer)
 : ErrorTerm(new_neural_network_pointer)
 {
+   set_default();
 }
 
 
@@ -53,6 +55,7 @@ RocAreaError::RocAreaError(NeuralNetwork* new_neural_network_pointer)
 RocAreaError::RocAreaError(DataSet* new_data_set_pointer)
 : ErrorTerm(new_data_set_pointer)
 {
+   set_default();
 }
 
 
@@ -67,6 +70,7 @@ RocAreaError::RocAreaError(DataSet* new_data_set_pointer)
 RocAreaError::RocAreaError(NeuralNetwork* new_neural_network_pointer, DataSet* new_data_set_pointer)
  : ErrorTerm(new_neural_network_pointer, new_data_set_pointer)
 {
+   set_default();
 }
 
 
@@ -80,6 +84,7 @@ RocAreaError::RocAreaError(NeuralNetwork* new_neural_network_pointer, DataSet* n
 RocAreaError::RocAreaError(const tinyxml2::XMLDocument& roc_area_error_document)
  : ErrorTerm(roc_area_error_document)
 {
+   set_default();
 }
 
 
@@ -94,7 +99,7 @@ RocAreaError::RocAreaError(const tinyxml2::XMLDocument& roc_area_error_document)
 RocAreaError::RocAreaError(const RocAreaError& new_roc_area_error)
  : ErrorTerm(new_roc_area_error)
 {
-
+   smoothing_width = new_roc_area_error.smoothing_width;
 }
 
 
@@ -109,6 +114,59 @@ RocAreaError::~RocAreaError(void)
 
 // METHODS
 
+// const double& get_smoothing_width(void) const method
+
+/// Returns the difference of outputs over which the contribution of a positive-negative pair
+/// to the smoothed area under the ROC curve goes from zero to one.
+
+const double& RocAreaError::get_smoothing_width(void) const
+{
+   return(smoothing_width);
+}
+
+
+// void set_default(void) method
+
+/// Sets the default values to a ROC area error object:
+/// <ul>
+/// <li> Smoothing width: 0.1.
+/// <li> Display: true.
+/// </ul>
+
+void RocAreaError::set_default(void)
+{
+   smoothing_width = 0.1;
+
+   display = true;
+}
+
+
+// void set_smoothing_width(const double&) method
+
+/// Sets the difference of outputs over which the contribution of a positive-negative pair
+/// to the smoothed area under the ROC curve goes from zero to one.
+/// The smaller the width, the closer the smoothed area is to the exact area.
+/// @param new_smoothing_width Smoothing width. It must be greater than zero.
+
+void RocAreaError::set_smoothing_width(const double& new_smoothing_width)
+{
+   // Control sentence
+
+   if(new_smoothing_width <= 0.0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: RocAreaError class.\n"
+             << "void set_smoothing_width(const double&) method.\n"
+             << "Smoothing width (" << new_smoothing_width << ") must be greater than zero.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   smoothing_width = new_smoothing_width;
+}
+
+
 // void check(void) const method
 
 /// Checks that there are a neural network and a data set associated to the sum squared error, 
@@ -182,189 +240,231 @@ void RocAreaError::check(void) const
 }
 
 
-// double calculate_error(void) const method
+// double calculate_roc_area(const Matrix<double>&, const Matrix<double>&) const method
 
-/// Returns the loss value of a neural network according to the sum squared error on a data set.
+/// Returns the area under the ROC curve of the first output with respect to the first target.
+/// The outputs are sorted once, and the area is obtained from the ranks of the positive instances.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of binary targets. Each row corresponds to one instance.
 
-double RocAreaError::calculate_error(void) const
+double RocAreaError::calculate_roc_area(const Matrix<double>& outputs, const Matrix<double>& targets) const
 {
-   #ifdef __OPENNN_DEBUG__
+   const RocCurve<double> roc_curve(outputs.arrange_column(0), targets.arrange_column(0));
 
-   check();
+   if(roc_curve.get_positives_number() == 0 || roc_curve.get_negatives_number() == 0)
+   {
+      std::ostringstream buffer;
 
-   #endif
+      buffer << "OpenNN Exception: RocAreaError class.\n"
+             << "double calculate_roc_area(const Matrix<double>&, const Matrix<double>&) const method.\n"
+             << "There must be both positive and negative training instances.\n";
 
-   // Neural network stuff
+      throw std::logic_error(buffer.str());
+   }
 
-   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+   return(roc_curve.calculate_area_under_curve());
+}
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
 
-   // Data set stuff
+// double calculate_smoothed_roc_area(const Matrix<double>&, const Matrix<double>&) const method
 
-   const Instances& instances = data_set_pointer->get_instances();
+/// Returns the smoothed area under the ROC curve of the first output with respect to the first target.
+/// It is the mean over all the positive-negative pairs of a smooth step of the difference d of their outputs,
+/// which is zero for d <= -w, one for d >= w and 1/2 + 3/4 (d/w) - 1/4 (d/w)^3 in between, w being the smoothing width.
+/// Ties count one half, as in the exact area, and the smoothed area tends to the exact area as the width goes to zero.
+/// The negative outputs are sorted once, and for each positive the pairs within the width are summed
+/// with cumulative sums of powers of the sorted outputs, so that the cost is O(n log n).
+/// Positives with few negatives within the width are summed pair by pair.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of binary targets. Each row corresponds to one instance.
 
-   const size_t training_instances_number = instances.count_training_instances_number();
+double RocAreaError::calculate_smoothed_roc_area(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+   Vector<double> positive_outputs;
+   Vector<double> negative_outputs;
 
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
+   arrange_sorted_outputs(outputs, targets, positive_outputs, negative_outputs);
 
-   size_t training_index;
+   const size_t positives_number = positive_outputs.size();
+   const size_t negatives_number = negative_outputs.size();
 
-   const Variables& variables = data_set_pointer->get_variables();
+   const Matrix<double> negatives_powers = calculate_cumulative_powers(negative_outputs);
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+   const double w = smoothing_width;
 
-   // Sum squared error stuff
+   // Windows with few pairs are summed directly, which avoids the cancellation of the cumulative sums for small widths
 
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
+   const size_t direct_pairs_number = 32;
 
-   int i = 0;
+   double pairs_sum = 0.0;
 
-//   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : sum_squared_error)
+   int i;
 
-   double decision_threshold = 0.0;
+   #pragma omp parallel for reduction(+ : pairs_sum)
 
-   double true_positives = 0.0;
-   double true_negatives = 0.0;
-   double false_positives = 0.0;
-   double false_negatives = 0.0;
+   for(i = 0; i < (int)positives_number; i++)
+   {
+      const double p = positive_outputs[i];
 
-   const size_t points_number = 101;
+      // Negatives below p-w count one, and negatives above p+w count zero
 
-   Vector<double> target_data(training_instances_number);
-   Vector<double> output_data(training_instances_number);
+      const size_t lower = std::upper_bound(negative_outputs.begin(), negative_outputs.end(), p-w) - negative_outputs.begin();
+      const size_t upper = std::lower_bound(negative_outputs.begin(), negative_outputs.end(), p+w) - negative_outputs.begin();
 
-   Vector<double> true_positive_rate(points_number, 0.0);
-   Vector<double> false_positive_rate(points_number, 0.0);
+      double window_sum = 0.0;
 
-   for(i = 0; i < (int)training_instances_number; i++)
+      if(upper - lower <= direct_pairs_number)
+      {
+         for(size_t j = lower; j < upper; j++)
+         {
+            const double u = (p - negative_outputs[j])/w;
+
+            window_sum += 0.5 + 0.75*u - 0.25*u*u*u;
+         }
+      }
+      else
+      {
+         const double m = (double)(upper - lower);
+         const double s1 = negatives_powers(upper,1) - negatives_powers(lower,1);
+         const double s2 = negatives_powers(upper,2) - negatives_powers(lower,2);
+         const double s3 = negatives_powers(upper,3) - negatives_powers(lower,3);
+
+         // Sums of (p-q) and (p-q)^3 over the negatives q within the width
+
+         const double differences_sum = m*p - s1;
+         const double cubed_differences_sum = m*p*p*p - 3.0*p*p*s1 + 3.0*p*s2 - s3;
+
+         window_sum = 0.5*m + 0.75*differences_sum/w - 0.25*cubed_differences_sum/(w*w*w);
+      }
+
+      pairs_sum += (double)lower + window_sum;
+   }
+
+   return(pairs_sum/((double)positives_number*(double)negatives_number));
+}
+
+
+// Vector<double> calculate_smoothed_roc_area_gradient(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the derivatives of the smoothed area under the ROC curve with respect to the first output of each instance.
+/// The derivative for a positive instance sums the slopes of the smooth steps with the negatives within the width,
+/// and that for a negative instance subtracts the slopes of the smooth steps with the positives within the width.
+/// Both are obtained with cumulative sums of powers of the sorted outputs.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of binary targets. Each row corresponds to one instance.
+
+Vector<double> RocAreaError::calculate_smoothed_roc_area_gradient(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+   Vector<double> positive_outputs;
+   Vector<double> negative_outputs;
+
+   const double center = arrange_sorted_outputs(outputs, targets, positive_outputs, negative_outputs);
+
+   const size_t instances_number = outputs.get_rows_number();
+
+   const size_t positives_number = positive_outputs.size();
+   const size_t negatives_number = negative_outputs.size();
+
+   const Matrix<double> positives_powers = calculate_cumulative_powers(positive_outputs);
+   const Matrix<double> negatives_powers = calculate_cumulative_powers(negative_outputs);
+
+   const double w = smoothing_width;
+
+   const double normalization_coefficient = 0.75/(w*(double)positives_number*(double)negatives_number);
+
+   const size_t direct_pairs_number = 32;
+
+   Vector<double> smoothed_roc_area_gradient(instances_number);
+
+   int i;
+
+   #pragma omp parallel for
+
+   for(i = 0; i < (int)instances_number; i++)
    {
-       training_index = training_indices[i];
+      const double y = outputs(i,0) - center;
+
+      const bool positive = targets(i,0) == 1.0;
+
+      // Instances of the other class within the width
 
-       // Input vector
+      const Vector<double>& other_outputs = positive ? negative_outputs : positive_outputs;
+      const Matrix<double>& other_powers = positive ? negatives_powers : positives_powers;
 
-       inputs = data_set_pointer->get_instance(training_index, inputs_indices);
+      const size_t lower = std::upper_bound(other_outputs.begin(), other_outputs.end(), y-w) - other_outputs.begin();
+      const size_t upper = std::lower_bound(other_outputs.begin(), other_outputs.end(), y+w) - other_outputs.begin();
 
-       // Target vector
+      // Sum of the slopes 3/(4w) (1 - (d/w)^2) of the smooth steps
 
-       targets = data_set_pointer->get_instance(training_index, targets_indices);
+      double slopes_sum = 0.0;
 
-       target_data[i] = targets[0];
+      if(upper - lower <= direct_pairs_number)
+      {
+         for(size_t j = lower; j < upper; j++)
+         {
+            const double u = (y - other_outputs[j])/w;
+
+            slopes_sum += 1.0 - u*u;
+         }
+      }
+      else
+      {
+         const double m = (double)(upper - lower);
+         const double s1 = other_powers(upper,1) - other_powers(lower,1);
+         const double s2 = other_powers(upper,2) - other_powers(lower,2);
 
-       // Output vector
+         const double squared_differences_sum = m*y*y - 2.0*y*s1 + s2;
 
-       outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+         slopes_sum = m - squared_differences_sum/(w*w);
+      }
 
-       output_data[i] = outputs[0];
+      smoothed_roc_area_gradient[i] = positive ? normalization_coefficient*slopes_sum : -normalization_coefficient*slopes_sum;
    }
 
-   // Calculate binary classification tests
+   return(smoothed_roc_area_gradient);
+}
+
 
-   for(size_t i = 1; i < points_number-1; i++)
+// double calculate_error(void) const method
+
+/// Returns the squared difference between one and the smoothed area under the ROC curve of the neural network on the training instances.
+
+double RocAreaError::calculate_error(void) const
+{
+   #ifdef __OPENNN_DEBUG__
+
+   check();
+
+   #endif
+
+   // Neural network stuff
+
+   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+   // Data set stuff
+
+   if(data_set_pointer->is_out_of_core())
    {
-       decision_threshold = i*0.01;
-
-       true_positives = 0.0;
-       true_negatives = 0.0;
-       false_positives = 0.0;
-       false_negatives = 0.0;
-
-       for(size_t j = 0; j < training_instances_number; j++)
-       {
-           if(target_data[j] == 1.0)
-           {
-               if(output_data[j] >= decision_threshold)
-               {
-                   true_positives += output_data[j];
-               }
-               else
-               {
-                   false_negatives += (1.0 - output_data[j]);
-               }
-           }
-           else if(target_data[j] == 0.0)
-           {
-               if(output_data[j] >= decision_threshold)
-               {
-                   false_positives += output_data[j];
-               }
-               else
-               {
-                   true_negatives += (1.0 - output_data[j]);
-               }
-           }
-           else
-           {
-               std::ostringstream buffer;
-
-               buffer << "OpenNN Exception: RocAreaError class.\n"
-                      << "double calculate_error(void) const method.\n"
-                      << "Target is not binary.\n";
-
-               throw std::logic_error(buffer.str());
-           }
-       }
-
-       if(true_negatives+false_positives < 1.0e-12)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "Cannot compute false_positive_rate.\n";
-
-           throw std::logic_error(buffer.str());
-       }
-
-       false_positive_rate[i] = false_negatives/(true_positives+false_negatives);
-
-       if(false_positive_rate[i] < 0.0
-       || false_positive_rate[i] > 1.0)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "false_positve_rate must be between 0 and 1.\n";
-
-           throw std::logic_error(buffer.str());
-       }
-
-       if(true_positives+false_negatives < 1.0e-12)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "Cannot compute true_positive_rate.\n";
-
-           throw std::logic_error(buffer.str());
-       }
-
-       true_positive_rate[i] = true_positives/(true_negatives+false_positives);
-
-       if(true_positive_rate[i] < 0.0
-       || true_positive_rate[i] > 1.0)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "true_positve_rate must be between 0 and 1.\n";
-
-           throw std::logic_error(buffer.str());
-       }
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
+
+      Matrix<double> outputs;
+      Matrix<double> targets;
+
+      calculate_instances_outputs(training_indices, multilayer_perceptron_pointer->arrange_parameters(), outputs, targets);
+
+      const double roc_area = calculate_smoothed_roc_area(outputs, targets);
 
+      return((1.0-roc_area)*(1.0-roc_area));
    }
 
-   false_positive_rate[points_number-1] = 1.0;
-   true_positive_rate[points_number-1] = 1.0;
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-   const double roc_area = numerical_integration.calculate_trapezoid_integral(false_positive_rate, true_positive_rate);
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+
+   // ROC area error stuff
+
+   const double roc_area = calculate_smoothed_roc_area(outputs, targets);
 
    const double roc_area_error = (1.0-roc_area)*(1.0-roc_area);
 
@@ -374,7 +474,7 @@ double RocAreaError::calculate_error(void) const
 
 // double calculate_error(const Vector<double>&) const method
 
-/// Returns which would be the sum squard error loss of a neural network for an hypothetical vector of parameters. 
+/// Returns which would be the ROC area error of a neural network for an hypothetical vector of parameters. 
 /// It does not set that vector of parameters to the neural network. 
 /// @param parameters Vector of potential parameters for the neural network associated to the error term.
 
@@ -413,173 +513,30 @@ double RocAreaError::calculate_error(const Vector<double>& parameters) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Sum squared error stuff
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   int i = 0;
-
-   double decision_threshold = 0.0;
-
-   double true_positives = 0.0;
-   double true_negatives = 0.0;
-   double false_positives = 0.0;
-   double false_negatives = 0.0;
-
-   const size_t points_number = 101;
-
-   Vector<double> true_positive_rate(points_number, 0.0);
-   Vector<double> false_positive_rate(points_number, 0.0);
-
-   Vector<double> target_data(training_instances_number);
-   Vector<double> output_data(training_instances_number);
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-       // Input vector
+      Matrix<double> outputs;
+      Matrix<double> targets;
 
-       inputs = data_set_pointer->get_instance(training_index, inputs_indices);
+      calculate_instances_outputs(training_indices, parameters, outputs, targets);
 
-       // Target vector
+      const double roc_area = calculate_smoothed_roc_area(outputs, targets);
 
-       targets = data_set_pointer->get_instance(training_index, targets_indices);
-
-       target_data[i] = targets[0];
-
-       // Output vector
-
-       outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
-
-       output_data[i] = outputs[0];
+      return((1.0-roc_area)*(1.0-roc_area));
    }
 
-   // Calculate binary classification tests
-
-   for(size_t i = 1; i < points_number-1; i++)
-   {
-       decision_threshold = i*0.01;
-
-       true_positives = 0.0;
-       true_negatives = 0.0;
-       false_positives = 0.0;
-       false_negatives = 0.0;
-
-       for(size_t j = 0; j < training_instances_number; j++)
-       {
-           if(target_data[j] == 1.0)
-           {
-               if(output_data[j] >= decision_threshold)
-               {
-                   true_positives += output_data[j];
-               }
-               else
-               {
-                   false_negatives += (1.0 - output_data[j]);
-               }
-           }
-           else if(target_data[j] == 0.0)
-           {
-               if(output_data[j] >= decision_threshold)
-               {
-                   false_positives += output_data[j];
-               }
-               else
-               {
-                   true_negatives += (1.0 - output_data[j]);
-               }
-           }
-           else
-           {
-               std::ostringstream buffer;
-
-               buffer << "OpenNN Exception: RocAreaError class.\n"
-                      << "double calculate_error(void) const method.\n"
-                      << "Target is not binary.\n";
-
-               throw std::logic_error(buffer.str());
-           }
-       }
-
-       if(true_negatives+false_positives < 1.0e-12)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "Cannot compute false_positive_rate.\n";
-
-           throw std::logic_error(buffer.str());
-       }
-
-       false_positive_rate[i] = false_negatives/(true_positives+false_negatives);
-
-       if(false_positive_rate[i] < 0.0
-       || false_positive_rate[i] > 1.0)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "false_positve_rate must be between 0 and 1.\n";
-
-           throw std::logic_error(buffer.str());
-       }
-
-       if(true_positives+false_negatives < 1.0e-12)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "Cannot compute true_positive_rate.\n";
-
-           throw std::logic_error(buffer.str());
-       }
-
-       true_positive_rate[i] = true_positives/(true_negatives+false_positives);
-
-       if(true_positive_rate[i] < 0.0
-       || true_positive_rate[i] > 1.0)
-       {
-           std::ostringstream buffer;
-
-           buffer << "OpenNN Exception: RocAreaError class.\n"
-                  << "double calculate_error(void) const method.\n"
-                  << "true_positve_rate must be between 0 and 1.\n";
-
-           throw std::logic_error(buffer.str());
-       }
-
-   }
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-   false_positive_rate[points_number-1] = 1.0;
-   true_positive_rate[points_number-1] = 1.0;
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
-   NumericalIntegration numerical_integration;
+   // ROC area error stuff
 
-   const double roc_area = numerical_integration.calculate_trapezoid_integral(false_positive_rate, true_positive_rate);
+   const double roc_area = calculate_smoothed_roc_area(outputs, targets);
 
    const double roc_area_error = (1.0-roc_area)*(1.0-roc_area);
 
@@ -713,8 +670,8 @@ Vector<double> RocAreaError::calculate_output_gradient(const Vector<double>& out
 
 // Vector<double> calculate_gradient(void) const method
 
-/// Calculates the error term gradient by means of the back-propagation algorithm, 
-/// and returns it in a single vector of size the number of neural network parameters. 
+/// Calculates the gradient of the ROC area error by means of the back-propagation algorithm,
+/// and returns it in a single vector of size the number of neural network parameters.
 
 Vector<double> RocAreaError::calculate_gradient(void) const
 {
@@ -724,104 +681,202 @@ Vector<double> RocAreaError::calculate_gradient(void) const
 
    #endif
 
-   // Neural network stuff
+   const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+   return(calculate_batch_gradient(training_indices));
+}
 
-   // Neural network stuff
 
-   const bool has_conditions_layer = neural_network_pointer->has_conditions_layer();
+// Vector<double> calculate_batch_gradient(const Vector<size_t>&) const method
 
-   const ConditionsLayer* conditions_layer_pointer = has_conditions_layer ? neural_network_pointer->get_conditions_layer_pointer() : NULL;
+/// Returns the gradient of the ROC area error measured on a subset of instances.
+/// Since the area is not a sum over instances, the outputs of all the instances are calculated first,
+/// and then each instance is back-propagated with the derivative of the error with respect to its output.
+/// Both passes read the instances by batches, using the per-thread workspaces of the error term.
+/// @param instances_indices Indices of the instances in the data set.
+
+Vector<double> RocAreaError::calculate_batch_gradient(const Vector<size_t>& instances_indices) const
+{
+   #ifdef __OPENNN_DEBUG__
+
+   check();
+
+   #endif
+
+   // Neural network stuff
+
+   const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
 
    const size_t layers_number = multilayer_perceptron_pointer->get_layers_number();
 
-   const size_t neural_parameters_number = multilayer_perceptron_pointer->count_parameters_number();
+   const size_t parameters_number = multilayer_perceptron_pointer->count_parameters_number();
 
-   Vector< Vector< Vector<double> > > first_order_forward_propagation(2); 
+   // Data set stuff
 
-   Vector<double> particular_solution;
-   Vector<double> homogeneous_solution;
+   const size_t instances_number = instances_indices.size();
 
-   // Data set stuff
+   const Vector<size_t> inputs_indices = data_set_pointer->get_variables().arrange_inputs_indices();
 
-   const Instances& instances = data_set_pointer->get_instances();
+   // ROC area error stuff
 
-   const size_t training_instances_number = instances.count_training_instances_number();
+   Vector<double> gradient(parameters_number, 0.0);
 
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
+   if(layers_number == 0 || instances_number == 0)
+   {
+      return(gradient);
+   }
 
-   size_t training_index;
+   Matrix<double> outputs;
+   Matrix<double> targets;
 
-   const Variables& variables = data_set_pointer->get_variables();
+   calculate_instances_outputs(instances_indices, multilayer_perceptron_pointer->arrange_parameters(), outputs, targets);
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+   const double roc_area = calculate_smoothed_roc_area(outputs, targets);
 
-   Vector<double> inputs(inputs_number);
-   Vector<double> targets(outputs_number);
+   const Vector<double> roc_area_gradient = calculate_smoothed_roc_area_gradient(outputs, targets);
 
-   // Sum squared error stuff
+   // Batches stuff
 
-   Vector<double> output_gradient(outputs_number);
+   const size_t batch_size = 256;
 
-   Vector< Matrix<double> > layers_combination_parameters_Jacobian; 
+   const size_t batches_number = (instances_number + batch_size - 1)/batch_size;
 
-   Vector< Vector<double> > layers_inputs(layers_number); 
-   Vector< Vector<double> > layers_delta; 
+   #pragma omp parallel
+   {
+      BackPropagationWorkspace<double> workspace(*multilayer_perceptron_pointer, std::min(batch_size, instances_number));
 
-   Vector<double> point_gradient(neural_parameters_number, 0.0);
+      const Vector< Matrix<double> >& layers_activation = workspace.forward_propagation.layers_activation;
+      const Vector< Matrix<double> >& layers_activation_derivative = workspace.forward_propagation.layers_activation_derivative;
 
-   Vector<double> gradient(neural_parameters_number, 0.0);
+      int i;
 
-   int i;
+      #pragma omp for
 
-   #pragma omp parallel for private(i, training_index, inputs, targets, first_order_forward_propagation, layers_inputs, layers_combination_parameters_Jacobian,\
-    output_gradient, layers_delta, particular_solution, homogeneous_solution, point_gradient)
+      for(i = 0; i < (int)batches_number; i++)
+      {
+         const size_t first_index = i*batch_size;
+         const size_t batch_instances_number = std::min(batch_size, instances_number - first_index);
 
-   for(i = 0; i < (int)training_instances_number; i++)
-   {
-       training_index = training_indices[i];
+         data_set_pointer->arrange_instances_data(instances_indices, first_index, batch_instances_number, inputs_indices, workspace.inputs);
 
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
+         multilayer_perceptron_pointer->calculate_first_order_forward_propagation(workspace.inputs, workspace.forward_propagation);
 
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+         workspace.output_gradient.set(batch_instances_number, outputs_number, 0.0);
 
-      first_order_forward_propagation = multilayer_perceptron_pointer->calculate_first_order_forward_propagation(inputs);
+         for(size_t j = 0; j < batch_instances_number; j++)
+         {
+            workspace.output_gradient(j,0) = -2.0*(1.0-roc_area)*roc_area_gradient[first_index+j];
+         }
 
-      const Vector< Vector<double> >& layers_activation = first_order_forward_propagation[0];
-      const Vector< Vector<double> >& layers_activation_derivative = first_order_forward_propagation[1];
+         calculate_layers_delta(layers_activation_derivative, workspace.output_gradient, workspace.layers_delta);
 
-      layers_inputs = multilayer_perceptron_pointer->arrange_layers_input(inputs, layers_activation);
+         ErrorTerm::calculate_batch_gradient(workspace.inputs, layers_activation, workspace.layers_delta, workspace.gradient);
+      }
 
-      layers_combination_parameters_Jacobian = multilayer_perceptron_pointer->calculate_layers_combination_parameters_Jacobian(layers_inputs);
+      #pragma omp critical
+      gradient += workspace.gradient;
+   }
 
-      if(!has_conditions_layer)
-      {
-          output_gradient = calculate_output_gradient(layers_activation[layers_number-1], targets);
+   return(gradient);
+}
+
+
+// double arrange_sorted_outputs(const Matrix<double>&, const Matrix<double>&, Vector<double>&, Vector<double>&) const method
+
+/// Separates the first outputs of the positive and the negative instances, and sorts each of them in ascending order.
+/// The outputs are shifted by their mean, which keeps the cumulative sums of their powers well conditioned.
+/// It returns that mean.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of binary targets. Each row corresponds to one instance.
+/// @param positive_outputs Sorted outputs of the positive instances.
+/// @param negative_outputs Sorted outputs of the negative instances.
 
-          layers_delta = calculate_layers_delta(layers_activation_derivative, output_gradient);
+double RocAreaError::arrange_sorted_outputs(const Matrix<double>& outputs, const Matrix<double>& targets,
+                                           Vector<double>& positive_outputs, Vector<double>& negative_outputs) const
+{
+   const size_t instances_number = outputs.get_rows_number();
+
+   double center = 0.0;
+
+   for(size_t i = 0; i < instances_number; i++)
+   {
+      center += outputs(i,0);
+   }
+
+   if(instances_number != 0)
+   {
+      center /= (double)instances_number;
+   }
+
+   positive_outputs.clear();
+   negative_outputs.clear();
+
+   for(size_t i = 0; i < instances_number; i++)
+   {
+      if(targets(i,0) == 1.0)
+      {
+         positive_outputs.push_back(outputs(i,0) - center);
+      }
+      else if(targets(i,0) == 0.0)
+      {
+         negative_outputs.push_back(outputs(i,0) - center);
       }
       else
       {
-         particular_solution = conditions_layer_pointer->calculate_particular_solution(inputs);
-         homogeneous_solution = conditions_layer_pointer->calculate_homogeneous_solution(inputs);
+         std::ostringstream buffer;
 
-         output_gradient = (particular_solution+homogeneous_solution*layers_activation[layers_number-1] - targets)*2.0;
+         buffer << "OpenNN Exception: RocAreaError class.\n"
+                << "double arrange_sorted_outputs(const Matrix<double>&, const Matrix<double>&, Vector<double>&, Vector<double>&) const method.\n"
+                << "Target " << i << " is neither a positive nor a negative: " << targets(i,0) << ".\n";
 
-         layers_delta = calculate_layers_delta(layers_activation_derivative, homogeneous_solution, output_gradient);
+         throw std::logic_error(buffer.str());
       }
+   }
 
-      point_gradient = calculate_point_gradient(layers_combination_parameters_Jacobian, layers_delta);
+   if(positive_outputs.empty() || negative_outputs.empty())
+   {
+      std::ostringstream buffer;
 
-      #pragma omp critical
-      gradient += point_gradient;
+      buffer << "OpenNN Exception: RocAreaError class.\n"
+             << "double arrange_sorted_outputs(const Matrix<double>&, const Matrix<double>&, Vector<double>&, Vector<double>&) const method.\n"
+             << "There must be both positive and negative training instances.\n";
+
+      throw std::logic_error(buffer.str());
    }
 
-   return(gradient);
+   std::sort(positive_outputs.begin(), positive_outputs.end());
+   std::sort(negative_outputs.begin(), negative_outputs.end());
+
+   return(center);
+}
+
+
+// Matrix<double> calculate_cumulative_powers(const Vector<double>&) const method
+
+/// Returns the cumulative sums of the powers zero to three of some values.
+/// Row i contains the sums over the first i values, so that the sums over the values from i to j-1
+/// are the differences between rows j and i.
+/// @param values Vector of values.
+
+Matrix<double> RocAreaError::calculate_cumulative_powers(const Vector<double>& values) const
+{
+   const size_t values_number = values.size();
+
+   Matrix<double> cumulative_powers(values_number+1, 4, 0.0);
+
+   for(size_t i = 0; i < values_number; i++)
+   {
+      const double value = values[i];
+
+      cumulative_powers(i+1,0) = cumulative_powers(i,0) + 1.0;
+      cumulative_powers(i+1,1) = cumulative_powers(i,1) + value;
+      cumulative_powers(i+1,2) = cumulative_powers(i,2) + value*value;
+      cumulative_powers(i+1,3) = cumulative_powers(i,3) + value*value*value;
+   }
+
+   return(cumulative_powers);
 }
 
 /*
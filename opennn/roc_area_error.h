@@ -22,12 +22,13 @@
 #include <sstream>
 #include <string>
 #include <limits>
+#include <algorithm>
 
 // OpenNN includes
 
 #include "error_term.h"
 #include "data_set.h"
-#include "numerical_integration.h"
+#include "roc_curve.h"
 
 // TinyXml includes
 
@@ -36,9 +37,11 @@
 namespace OpenNN
 {
 
-/// This class represents the sum squared peformance term functional. 
-/// This is used as the error term in data modeling problems, such as function regression, 
-/// classification or time series prediction.
+/// This class represents the ROC area error term functional.
+/// It is the squared difference between one and a smoothed area under the ROC curve of the first output,
+/// in which each positive-negative pair contributes a smooth step of the difference of their outputs.
+/// The smoothed area is continuous in the outputs, so that the error and its gradient are consistent.
+/// The exact area, which is piecewise constant, is given by calculate_roc_area.
 
 class RocAreaError : public ErrorTerm
 {
@@ -77,14 +80,25 @@ public:
 
    // Get methods
 
+   const double& get_smoothing_width(void) const;
+
    // Set methods
 
+   void set_default(void);
+
+   void set_smoothing_width(const double&);
+
    // Checking methods
 
    void check(void) const;
 
    // loss methods
 
+   double calculate_roc_area(const Matrix<double>&, const Matrix<double>&) const;
+
+   double calculate_smoothed_roc_area(const Matrix<double>&, const Matrix<double>&) const;
+   Vector<double> calculate_smoothed_roc_area_gradient(const Matrix<double>&, const Matrix<double>&) const;
+
    double calculate_error(void) const;
 
 //   double calculate_selection_error(void) const;
@@ -93,6 +107,8 @@ public:
 
    Vector<double> calculate_gradient(void) const;
 
+   Vector<double> calculate_batch_gradient(const Vector<size_t>&) const;
+
 //   Matrix<double> calculate_Hessian(void) const;
 
 //   Matrix<double> calculate_single_hidden_layer_Hessian(void) const;
@@ -130,13 +146,21 @@ public:
 
 //   void write_XML(tinyxml2::XMLPrinter&) const;
 //   void read_XML(   );
+
 private:
 
-   /// Numerical integration used to calculate the error.
+   // METHODS
+
+   double arrange_sorted_outputs(const Matrix<double>&, const Matrix<double>&, Vector<double>&, Vector<double>&) const;
+
+   Matrix<double> calculate_cumulative_powers(const Vector<double>&) const;
 
-   NumericalIntegration numerical_integration;
+   // MEMBERS
 
+   /// Difference between the outputs of a positive and a negative instance over which their contribution
+   /// to the smoothed area goes from zero to one.
 
+   double smoothing_width;
 };
 
 }
@@ -0,0 +1,391 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   R O C   C U R V E   C O N T A I N E R                                                                      */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+#ifndef __ROCCURVE_H__
+#define __ROCCURVE_H__
+
+// System includes
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+// OpenNN includes
+
+#include "vector.h"
+#include "matrix.h"
+
+namespace OpenNN {
+
+/// This template holds the outputs of a binary classifier sorted in ascending order,
+/// together with the numbers of positive and negative instances below each of them.
+/// The outputs are sorted once, and then the ROC curve and the area under it are obtained in a single sweep.
+/// The area is the Mann-Whitney statistic computed from the ranks of the positive instances,
+/// where tied outputs get the average of their ranks.
+
+template <typename T> class RocCurve {
+public:
+  // CONSTRUCTORS
+
+  // Default constructor.
+
+  explicit RocCurve(void);
+
+  // Outputs and targets constructor.
+
+  explicit RocCurve(const Vector<T> &, const Vector<T> &);
+
+  // DESTRUCTOR
+
+  virtual ~RocCurve(void);
+
+  // METHODS
+
+  size_t get_instances_number(void) const;
+
+  size_t get_positives_number(void) const;
+  size_t get_negatives_number(void) const;
+
+  const Vector<T> &get_sorted_outputs(void) const;
+
+  void set(const Vector<T> &, const Vector<T> &);
+  void set(const Vector<T> &, const Vector<T> &, const Vector<size_t> &);
+
+  double calculate_area_under_curve(void) const;
+
+  Matrix<double> calculate_points(const size_t &) const;
+
+  Vector<T> arrange_thresholds(const T &, const T &) const;
+
+  Matrix<size_t> calculate_confusion(const T &) const;
+
+private:
+  /// Outputs of the instances, in ascending order.
+
+  Vector<T> sorted_outputs;
+
+  /// Number of positive instances whose output is lower than each sorted output.
+
+  Vector<size_t> lower_positives;
+
+  /// Number of negative instances whose output is lower than each sorted output.
+
+  Vector<size_t> lower_negatives;
+
+  /// Total number of positive instances.
+
+  size_t positives_number;
+
+  /// Total number of negative instances.
+
+  size_t negatives_number;
+
+  /// Sum of the ranks of the positive instances, starting at one.
+
+  double positives_ranks_sum;
+};
+
+// CONSTRUCTORS
+
+/// Default constructor. It creates a curve without instances.
+
+template <class T>
+RocCurve<T>::RocCurve(void)
+    : positives_number(0), negatives_number(0), positives_ranks_sum(0.0) {}
+
+/// Outputs and targets constructor. It sorts the outputs and counts the positives and negatives below them.
+/// @param outputs Outputs of the classifier.
+/// @param targets Binary targets of the instances.
+
+template <class T>
+RocCurve<T>::RocCurve(const Vector<T> &outputs, const Vector<T> &targets)
+    : positives_number(0), negatives_number(0), positives_ranks_sum(0.0) {
+  set(outputs, targets);
+}
+
+// DESTRUCTOR
+
+/// Destructor.
+
+template <class T> RocCurve<T>::~RocCurve(void) {}
+
+// size_t get_instances_number(void) const method
+
+/// Returns the number of instances of the curve.
+
+template <class T> size_t RocCurve<T>::get_instances_number(void) const {
+  return (sorted_outputs.size());
+}
+
+// size_t get_positives_number(void) const method
+
+/// Returns the number of instances whose target is one.
+
+template <class T> size_t RocCurve<T>::get_positives_number(void) const {
+  return (positives_number);
+}
+
+// size_t get_negatives_number(void) const method
+
+/// Returns the number of instances whose target is zero.
+
+template <class T> size_t RocCurve<T>::get_negatives_number(void) const {
+  return (negatives_number);
+}
+
+// const Vector<T>& get_sorted_outputs(void) const method
+
+/// Returns the outputs of the instances in ascending order.
+
+template <class T> const Vector<T> &RocCurve<T>::get_sorted_outputs(void) const {
+  return (sorted_outputs);
+}
+
+// void set(const Vector<T>&, const Vector<T>&) method
+
+/// Sorts the outputs and sweeps them once, counting the positives and negatives below each output
+/// and summing the ranks of the positives. It takes O(n log n) time.
+/// @param outputs Outputs of the classifier.
+/// @param targets Binary targets of the instances.
+
+template <class T>
+void RocCurve<T>::set(const Vector<T> &outputs, const Vector<T> &targets) {
+  set(outputs, targets, outputs.sort_less_indices());
+}
+
+// void set(const Vector<T>&, const Vector<T>&, const Vector<size_t>&) method
+
+/// Sweeps the outputs once in the given order, counting the positives and negatives below each output
+/// and summing the ranks of the positives. It takes O(n) time, since the outputs have already been sorted.
+/// @param outputs Outputs of the classifier.
+/// @param targets Binary targets of the instances.
+/// @param sorted_indices Indices of the outputs in ascending order, as returned by sort_less_indices.
+
+template <class T>
+void RocCurve<T>::set(const Vector<T> &outputs, const Vector<T> &targets, const Vector<size_t> &sorted_indices) {
+  const size_t instances_number = outputs.size();
+
+  if(targets.size() != instances_number || sorted_indices.size() != instances_number) {
+    std::ostringstream buffer;
+
+    buffer << "OpenNN Exception: RocCurve template.\n"
+           << "void set(const Vector<T>&, const Vector<T>&, const Vector<size_t>&) method.\n"
+           << "Sizes of targets (" << targets.size() << ") and sorted indices (" << sorted_indices.size()
+           << ") must be equal to size of outputs (" << instances_number << ").\n";
+
+    throw std::logic_error(buffer.str());
+  }
+
+  sorted_outputs.set(instances_number);
+  lower_positives.set(instances_number);
+  lower_negatives.set(instances_number);
+
+  positives_number = 0;
+  negatives_number = 0;
+  positives_ranks_sum = 0.0;
+
+  // Instances with equal outputs form a group, which is accounted for when the next group starts
+
+  size_t group_beginning = 0;
+  size_t group_positives = 0;
+  size_t group_negatives = 0;
+
+  for (size_t i = 0; i < instances_number; i++) {
+    const size_t index = sorted_indices[i];
+
+    sorted_outputs[i] = outputs[index];
+
+    if(i > 0 && sorted_outputs[i] != sorted_outputs[i - 1]) {
+      positives_ranks_sum += group_positives * 0.5 * (double)(group_beginning + 1 + i);
+
+      positives_number += group_positives;
+      negatives_number += group_negatives;
+
+      group_beginning = i;
+      group_positives = 0;
+      group_negatives = 0;
+    }
+
+    lower_positives[i] = positives_number;
+    lower_negatives[i] = negatives_number;
+
+    if(targets[index] == 1) {
+      group_positives++;
+    } else if(targets[index] == 0) {
+      group_negatives++;
+    } else {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: RocCurve template.\n"
+             << "void set(const Vector<T>&, const Vector<T>&, const Vector<size_t>&) method.\n"
+             << "Target " << index << " is neither a positive nor a negative: " << targets[index] << ".\n";
+
+      throw std::logic_error(buffer.str());
+    }
+  }
+
+  positives_ranks_sum += group_positives * 0.5 * (double)(group_beginning + 1 + instances_number);
+
+  positives_number += group_positives;
+  negatives_number += group_negatives;
+}
+
+// double calculate_area_under_curve(void) const method
+
+/// Returns the area under the ROC curve.
+/// It is the probability that a positive instance has a greater output than a negative one,
+/// counting ties as one half, which is the mean of the Wilcoxon parameters of all the positive-negative pairs.
+/// It is obtained from the sum of the ranks of the positives, without visiting the pairs.
+
+template <class T> double RocCurve<T>::calculate_area_under_curve(void) const {
+  if(positives_number == 0 || negatives_number == 0) {
+    std::ostringstream buffer;
+
+    buffer << "OpenNN Exception: RocCurve template.\n"
+           << "double calculate_area_under_curve(void) const method.\n"
+           << "Numbers of positives (" << positives_number << ") and negatives (" << negatives_number
+           << ") must be greater than zero.\n";
+
+    throw std::logic_error(buffer.str());
+  }
+
+  const double positives = (double)positives_number;
+
+  const double Mann_Whitney_statistic = positives_ranks_sum - 0.5 * positives * (positives + 1.0);
+
+  return (Mann_Whitney_statistic / (positives * (double)negatives_number));
+}
+
+// Matrix<double> calculate_points(const size_t&) const method
+
+/// Returns a matrix with the points of the ROC curve, taking as decision thresholds the sorted outputs.
+/// If there are more instances than the maximum number of points, only one every few outputs is taken.
+/// The first column is the fraction of positives below the threshold, the second column is the fraction of negatives below it,
+/// and the third column is the threshold. The last row is the point (1,1), with threshold one.
+/// @param maximum_points_number Maximum number of thresholds.
+
+template <class T>
+Matrix<double> RocCurve<T>::calculate_points(const size_t &maximum_points_number) const {
+  const size_t instances_number = sorted_outputs.size();
+
+  size_t step_size;
+  size_t points_number;
+
+  if(instances_number > maximum_points_number) {
+    step_size = (size_t)((double)instances_number / (double)maximum_points_number);
+    points_number = (size_t)((double)instances_number / (double)step_size);
+  } else {
+    points_number = instances_number;
+    step_size = 1;
+  }
+
+  Matrix<double> points(points_number + 1, 3, 0.0);
+
+  size_t current_index;
+
+  for (size_t i = 0; i < points_number; i++) {
+    current_index = i * step_size;
+
+    points(i, 0) = (double)lower_positives[current_index] / (double)positives_number;
+    points(i, 1) = (double)lower_negatives[current_index] / (double)negatives_number;
+    points(i, 2) = (double)sorted_outputs[current_index];
+  }
+
+  points(points_number, 0) = 1.0;
+  points(points_number, 1) = 1.0;
+  points(points_number, 2) = 1.0;
+
+  return (points);
+}
+
+// Vector<T> arrange_thresholds(const T&, const T&) const method
+
+/// Returns the decision thresholds between a minimum and a maximum which give different confusion matrices.
+/// They are the minimum, the distinct outputs greater than the minimum and not greater than the maximum,
+/// and the maximum if it is greater than all of them.
+/// Any other threshold in the interval classifies the instances as one of these.
+/// @param minimum_threshold Lowest decision threshold.
+/// @param maximum_threshold Highest decision threshold.
+
+template <class T>
+Vector<T> RocCurve<T>::arrange_thresholds(const T &minimum_threshold, const T &maximum_threshold) const {
+  const size_t instances_number = sorted_outputs.size();
+
+  Vector<T> thresholds(1, minimum_threshold);
+
+  for (size_t i = 0; i < instances_number; i++) {
+    if(sorted_outputs[i] > maximum_threshold) {
+      break;
+    }
+
+    if(sorted_outputs[i] > thresholds[thresholds.size() - 1]) {
+      thresholds.push_back(sorted_outputs[i]);
+    }
+  }
+
+  if(maximum_threshold > thresholds[thresholds.size() - 1]) {
+    thresholds.push_back(maximum_threshold);
+  }
+
+  return (thresholds);
+}
+
+// Matrix<size_t> calculate_confusion(const T&) const method
+
+/// Returns the confusion matrix of the instances for a decision threshold.
+/// An instance is classified as positive if its output is greater than or equal to the threshold.
+/// The first row contains the true positives and the false negatives,
+/// and the second row contains the false positives and the true negatives.
+/// It takes O(log n) time, since the instances below the threshold have already been counted.
+/// @param decision_threshold Decision threshold.
+
+template <class T>
+Matrix<size_t> RocCurve<T>::calculate_confusion(const T &decision_threshold) const {
+  const size_t instances_number = sorted_outputs.size();
+
+  const size_t position =
+      std::lower_bound(sorted_outputs.begin(), sorted_outputs.end(), decision_threshold) - sorted_outputs.begin();
+
+  const size_t false_negatives = position < instances_number ? lower_positives[position] : positives_number;
+  const size_t true_negatives = position < instances_number ? lower_negatives[position] : negatives_number;
+
+  Matrix<size_t> confusion(2, 2);
+
+  confusion(0, 0) = positives_number - false_negatives;
+  confusion(0, 1) = false_negatives;
+  confusion(1, 0) = negatives_number - true_negatives;
+  confusion(1, 1) = true_negatives;
+
+  return (confusion);
+}
+
+} // end namespace OpenNN
+
+#endif
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (c) 2005-2016 Roberto Lopez.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -192,6 +192,7 @@ void ROCCurveOptimizationThreshold::set_step(const double& new_step)
 // ROCCurveOptimizationThresholdResults* perform_order_selection(void) method
 
 /// Perform the decision threshold selection optimizing the ROC curve distance.
+/// The thresholds tried are the distinct selection outputs between the minimum and the maximum thresholds.
 
 ROCCurveOptimizationThreshold::ROCCurveOptimizationThresholdResults* ROCCurveOptimizationThreshold::perform_threshold_selection(void)
 {
@@ -207,7 +208,13 @@ ROCCurveOptimizationThreshold::ROCCurveOptimizationThresholdResults* ROCCurveOpt
 
     NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
 
-    double current_threshold = minimum_threshold;
+    const RocCurve<double> roc_curve = calculate_selection_roc_curve();
+
+    const Vector<double> thresholds = roc_curve.arrange_thresholds(minimum_threshold, maximum_threshold);
+
+    const size_t history_period = calculate_history_period(thresholds.size());
+
+    double current_threshold;
 
     Matrix<size_t> current_confusion;
 
@@ -227,7 +234,9 @@ ROCCurveOptimizationThreshold::ROCCurveOptimizationThresholdResults* ROCCurveOpt
 
     while (!end)
     {
-        current_confusion = calculate_confusion(current_threshold);
+        current_threshold = thresholds[iterations];
+
+        current_confusion = roc_curve.calculate_confusion(current_threshold);
         current_binary_classification_test = calculate_binary_classification_test(current_confusion);
 
         current_roc_curve_distance = (1-current_binary_classification_test[3])*(1-current_binary_classification_test[3]) +
@@ -235,18 +244,6 @@ ROCCurveOptimizationThreshold::ROCCurveOptimizationThresholdResults* ROCCurveOpt
 
         current_roc_curve_distance = sqrt(current_roc_curve_distance);
 
-        results->threshold_data.push_back(current_threshold);
-
-        if(reserve_binary_classification_tests_data)
-        {
-            results->binary_classification_test_data.push_back(current_binary_classification_test);
-        }
-
-        if(reserve_function_data)
-        {
-            results->function_data.push_back(current_roc_curve_distance);
-        }
-
         if (current_roc_curve_distance < optimum_roc_curve_distance ||
             (current_roc_curve_distance == optimum_roc_curve_distance && current_binary_classification_test[1] < optimal_binary_classification_test[1]))
         {
@@ -268,7 +265,7 @@ ROCCurveOptimizationThreshold::ROCCurveOptimizationThresholdResults* ROCCurveOpt
 
             results->stopping_condition = ThresholdSelectionAlgorithm::PerfectConfusionMatrix;
         }
-        else if (current_threshold == maximum_threshold)
+        else if (iterations == thresholds.size())
         {
             end = true;
 
@@ -280,27 +277,28 @@ ROCCurveOptimizationThreshold::ROCCurveOptimizationThresholdResults* ROCCurveOpt
             results->stopping_condition = ThresholdSelectionAlgorithm::AlgorithmFinished;
         }
 
-        if (display)
+        if(end || (iterations-1)%history_period == 0)
         {
-            std::cout << "Iteration: " << iterations << std::endl;
-            std::cout << "Current threshold: " << current_threshold << std::endl;
-            std::cout << "Current error: " << current_binary_classification_test[1] << std::endl;
-            std::cout << "Current sensitivity: " << current_binary_classification_test[2] << std::endl;
-            std::cout << "Current specifity: " << current_binary_classification_test[3] << std::endl;
-            std::cout << "Current ROC curve distance: " << current_roc_curve_distance << std::endl;
-            std::cout << "Confusion matrix: " << std::endl
-                      << current_confusion << std::endl;
-            std::cout << std::endl;
-        }
+            results->threshold_data.push_back(current_threshold);
 
-        current_threshold = fmin(maximum_threshold, current_threshold + step);
+            if(reserve_binary_classification_tests_data)
+            {
+                results->binary_classification_test_data.push_back(current_binary_classification_test);
+            }
 
+            if(reserve_function_data)
+            {
+                results->function_data.push_back(current_roc_curve_distance);
+            }
+        }
     }
 
     if (display)
     {
+        std::cout << "Iterations number: " << iterations << std::endl;
         std::cout << "Optimum threshold: " << optimum_threshold << std::endl;
         std::cout << "Optimal error: " << optimal_binary_classification_test[1] << std::endl;
+        std::cout << "Optimal ROC curve distance: " << optimum_roc_curve_distance << std::endl;
     }
 
     results->iterations_number = iterations;
@@ -206,62 +206,25 @@ double RootMeanSquaredError::calculate_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
-   const Matrix<double>& data = data_set_pointer->get_data();
-
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Root mean squared error
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   double sum_squared_error = 0.0;
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+:sum_squared_error)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-      // Input vector
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
-
-      // Target vector
+      return(sqrt(calculate_instances_error(training_indices, multilayer_perceptron_pointer->arrange_parameters())));
+   }
 
-//      targets = data_set_pointer->get_instance(training_index, targets_indices);
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      // Sum squaresd error
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-//	  sum_squared_error += outputs.calculate_sum_squared_error(targets);
-      sum_squared_error += outputs.calculate_sum_squared_error(data, training_index, targets_indices);
+   // Root mean squared error stuff
 
-   }
+   const double sum_squared_error = outputs.calculate_sum_squared_error(targets);
 
-   return(sqrt(sum_squared_error/(double)training_instances_number));
+   return(sqrt(sum_squared_error/(double)inputs.get_rows_number()));
 }
 
 
@@ -305,58 +268,25 @@ double RootMeanSquaredError::calculate_error(const Vector<double>& parameters) c
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Root mean squared error
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   double sum_squared_error = 0.0;
-
-   int i = 0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+:sum_squared_error)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-      // Input vector
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
+      return(sqrt(calculate_instances_error(training_indices, parameters)));
+   }
 
-      // Target vector
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
-      // Sum squaresd error
+   // Root mean squared error stuff
 
-      sum_squared_error += outputs.calculate_sum_squared_error(targets);
-   }
+   const double sum_squared_error = outputs.calculate_sum_squared_error(targets);
 
-   return(sqrt(sum_squared_error/(double)training_instances_number));
+   return(sqrt(sum_squared_error/(double)inputs.get_rows_number()));
 }
 
 
@@ -390,12 +320,10 @@ double RootMeanSquaredError::calculate_selection_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
    const Instances& instances = data_set_pointer->get_instances();
+
    const size_t selection_instances_number = instances.count_selection_instances_number();
 
    if(selection_instances_number == 0)
@@ -403,47 +331,25 @@ double RootMeanSquaredError::calculate_selection_error(void) const
       return(0.0);
    }
 
-   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
-
-   size_t selection_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   int i = 0;
-
-   double selection_loss = 0.0;
-
-   #pragma omp parallel for private(i, selection_index, inputs, outputs, targets) reduction(+ : selection_loss)
-
-   for(i = 0; i < (int)selection_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       selection_index = selection_indices[i];
-
-      // Input vector
+      const Vector<size_t> selection_indices = instances.arrange_selection_indices();
 
-      inputs = data_set_pointer->get_instance(selection_index, inputs_indices);
+      // The error of each batch is normalized by the number of training instances
 
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+      return(sqrt(calculate_instances_error(selection_indices, multilayer_perceptron_pointer->arrange_parameters())*(double)instances.count_training_instances_number()/(double)selection_instances_number));
+   }
 
-      // Target vector
+   const Matrix<double>& inputs = data_set_pointer->get_selection_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
 
-      targets = data_set_pointer->get_instance(selection_index, targets_indices);
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-      // Sum of squares error
+   // Root mean squared error stuff
 
-      selection_loss += outputs.calculate_sum_squared_error(targets);
-   }
+   const double sum_squared_error = outputs.calculate_sum_squared_error(targets);
 
-   return(sqrt(selection_loss/(double)selection_instances_number));
+   return(sqrt(sum_squared_error/(double)selection_instances_number));
 }
 
 
@@ -470,6 +376,23 @@ Matrix<double> RootMeanSquaredError::calculate_output_Hessian(const Vector<doubl
 }
 
 
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the contribution of a batch of instances to the mean squared error on the training instances,
+/// whose square root is the root mean squared error.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
+
+double RootMeanSquaredError::calculate_batch_error(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    const Instances& instances = data_set_pointer->get_instances();
+
+    const size_t training_instances_number = instances.count_training_instances_number();
+
+    return(outputs.calculate_sum_squared_error(targets)/(double)training_instances_number);
+}
+
+
 // Vector<double> calculate_gradient(void) const method
 
 /// Returns the root mean squared error function gradient of a multilayer perceptron on a data set.
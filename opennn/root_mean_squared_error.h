@@ -88,6 +88,8 @@ public:
 
    Matrix<double> calculate_output_Hessian(const Vector<double>&, const Vector<double>&) const;
 
+   double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const;
+
    Vector<double> calculate_gradient(void) const;
    Vector<double> calculate_gradient(const double&, const double&) const;
 
@@ -1002,6 +1002,75 @@ Vector<double> ScalingLayer::calculate_outputs(const Vector<double>& inputs) con
 }  
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&) const method
+
+/// Scales a batch of inputs at once, column by column, with the scaling method of the layer.
+/// Each row of the returned matrix contains the scaled values of the corresponding row of inputs.
+/// @param inputs Matrix of inputs to the scaling layer. The number of columns must be equal to the number of scaling neurons.
+
+Matrix<double> ScalingLayer::calculate_outputs(const Matrix<double>& inputs) const
+{
+    const size_t rows_number = inputs.get_rows_number();
+    const size_t scaling_neurons_number = get_scaling_neurons_number();
+
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    const size_t columns_number = inputs.get_columns_number();
+
+    if(columns_number != scaling_neurons_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: ScalingLayer class.\n"
+               << "Matrix<double> calculate_outputs(const Matrix<double>&) const method.\n"
+               << "Number of columns of inputs must be equal to number of scaling neurons.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    Matrix<double> outputs(inputs);
+
+    if(scaling_method == NoScaling)
+    {
+        return(outputs);
+    }
+
+    double slope;
+    double intercept;
+
+    for(size_t j = 0; j < scaling_neurons_number; j++)
+    {
+        if(scaling_method == MinimumMaximum && statistics[j].maximum-statistics[j].minimum >= 1e-99)
+        {
+            slope = 2.0/(statistics[j].maximum-statistics[j].minimum);
+            intercept = -2.0*statistics[j].minimum/(statistics[j].maximum-statistics[j].minimum) - 1.0;
+        }
+        else if(scaling_method == MeanStandardDeviation && statistics[j].standard_deviation >= 1e-99)
+        {
+            slope = 1.0/statistics[j].standard_deviation;
+            intercept = -statistics[j].mean/statistics[j].standard_deviation;
+        }
+        else
+        {
+            continue;
+        }
+
+        double* column = outputs.data() + j*rows_number;
+
+        for(size_t i = 0; i < rows_number; i++)
+        {
+            column[i] = slope*column[i] + intercept;
+        }
+    }
+
+    return(outputs);
+}
+
+
 // Vector<double> calculate_derivatives(const Vector<double>&) const method
 
 /// This method retuns the derivatives of the scaled inputs with respect to the raw inputs.
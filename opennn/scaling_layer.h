@@ -161,6 +161,8 @@ public:
    Vector<double> calculate_derivatives(const Vector<double>&) const;
    Vector<double> calculate_second_derivatives(const Vector<double>&) const;
 
+   Matrix<double> calculate_outputs(const Matrix<double>&) const;
+
    Vector<double> calculate_minimum_maximum_outputs(const Vector<double>&) const;
    Vector<double> calculate_minimum_maximum_derivatives(const Vector<double>&) const;
    Vector<double> calculate_minimum_maximum_second_derivatives(const Vector<double>&) const;
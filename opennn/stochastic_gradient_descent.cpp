@@ -0,0 +1,2075 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   S T O C H A S T I C   G R A D I E N T   D E S C E N T   C L A S S                                          */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+// Open NN includes
+
+#include "stochastic_gradient_descent.h"
+
+namespace OpenNN
+{
+
+// DEFAULT CONSTRUCTOR
+
+/// Default constructor.
+/// It creates a stochastic gradient descent training algorithm not associated to any loss functional object.
+/// It also initializes the class members to their default values.
+
+StochasticGradientDescent::StochasticGradientDescent(void)
+ : TrainingAlgorithm()
+{
+   set_default();
+}
+
+
+// PERFORMANCE FUNCTIONAL CONSTRUCTOR
+
+/// Loss index constructor.
+/// It creates a stochastic gradient descent training algorithm associated to a loss functional.
+/// It also initializes the class members to their default values.
+/// @param new_loss_index_pointer Pointer to a loss functional object.
+
+StochasticGradientDescent::StochasticGradientDescent(LossIndex* new_loss_index_pointer)
+: TrainingAlgorithm(new_loss_index_pointer)
+{
+   set_default();
+}
+
+
+// XML CONSTRUCTOR
+
+/// XML constructor.
+/// It creates a stochastic gradient descent training algorithm not associated to any loss functional object.
+/// It also loads the class members from a XML document.
+/// @param document TinyXML document with the members of a stochastic gradient descent object.
+
+StochasticGradientDescent::StochasticGradientDescent(const tinyxml2::XMLDocument& document) : TrainingAlgorithm(document)
+{
+   set_default();
+
+   from_XML(document);
+}
+
+
+// DESTRUCTOR
+
+/// Destructor.
+
+StochasticGradientDescent::~StochasticGradientDescent(void)
+{
+}
+
+
+// METHODS
+
+// const size_t& get_batch_size(void) const method
+
+/// Returns the number of training instances in each mini-batch.
+
+const size_t& StochasticGradientDescent::get_batch_size(void) const
+{
+   return(batch_size);
+}
+
+
+// const double& get_initial_learning_rate(void) const method
+
+/// Returns the learning rate at the first epoch.
+
+const double& StochasticGradientDescent::get_initial_learning_rate(void) const
+{
+   return(initial_learning_rate);
+}
+
+
+// const LearningRateSchedule& get_learning_rate_schedule(void) const method
+
+/// Returns the schedule of the learning rate along the epochs.
+
+const StochasticGradientDescent::LearningRateSchedule& StochasticGradientDescent::get_learning_rate_schedule(void) const
+{
+   return(learning_rate_schedule);
+}
+
+
+// std::string write_learning_rate_schedule(void) const method
+
+/// Returns a string with the name of the learning rate schedule.
+
+std::string StochasticGradientDescent::write_learning_rate_schedule(void) const
+{
+   switch(learning_rate_schedule)
+   {
+      case Constant:
+      {
+         return("Constant");
+      }
+      break;
+
+      case InverseTime:
+      {
+         return("InverseTime");
+      }
+      break;
+
+      case Exponential:
+      {
+         return("Exponential");
+      }
+      break;
+
+      default:
+      {
+         std::ostringstream buffer;
+
+         buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+                << "std::string write_learning_rate_schedule(void) const method.\n"
+                << "Unknown learning rate schedule.\n";
+
+         throw std::logic_error(buffer.str());
+      }
+      break;
+   }
+}
+
+
+// const double& get_learning_rate_decay(void) const method
+
+/// Returns the decay constant of the inverse time and exponential learning rate schedules.
+
+const double& StochasticGradientDescent::get_learning_rate_decay(void) const
+{
+   return(learning_rate_decay);
+}
+
+
+// const double& get_momentum(void) const method
+
+/// Returns the momentum coefficient.
+
+const double& StochasticGradientDescent::get_momentum(void) const
+{
+   return(momentum);
+}
+
+
+// const bool& get_nesterov(void) const method
+
+/// Returns true if the Nesterov accelerated gradient is used, and false otherwise.
+
+const bool& StochasticGradientDescent::get_nesterov(void) const
+{
+   return(nesterov);
+}
+
+
+// const double& get_loss_goal(void) const method
+
+/// Returns the goal value for the loss.
+/// This is used as a stopping criterion when training a multilayer perceptron
+
+const double& StochasticGradientDescent::get_loss_goal(void) const
+{
+   return(loss_goal);
+}
+
+
+// const size_t& get_maximum_selection_loss_decreases(void) const method
+
+/// Returns the maximum number of epochs for which the selection loss increases.
+
+const size_t& StochasticGradientDescent::get_maximum_selection_loss_decreases(void) const
+{
+   return(maximum_selection_loss_decreases);
+}
+
+
+// const size_t& get_maximum_epochs_number(void) const method
+
+/// Returns the maximum number of epochs for training.
+
+const size_t& StochasticGradientDescent::get_maximum_epochs_number(void) const
+{
+   return(maximum_epochs_number);
+}
+
+
+// const double& get_maximum_time(void) const method
+
+/// Returns the maximum training time.
+
+const double& StochasticGradientDescent::get_maximum_time(void) const
+{
+   return(maximum_time);
+}
+
+
+// const bool& get_return_minimum_selection_error_neural_network(void) const method
+
+/// Returns true if the final model will be the neural network with the minimum selection error, false otherwise.
+
+const bool& StochasticGradientDescent::get_return_minimum_selection_error_neural_network(void) const
+{
+    return(return_minimum_selection_error_neural_network);
+}
+
+
+// const bool& get_reserve_loss_history(void) const method
+
+/// Returns true if the loss history vector is to be reserved, and false otherwise.
+
+const bool& StochasticGradientDescent::get_reserve_loss_history(void) const
+{
+   return(reserve_loss_history);
+}
+
+
+// const bool& get_reserve_selection_loss_history(void) const method
+
+/// Returns true if the selection loss history vector is to be reserved, and false otherwise.
+
+const bool& StochasticGradientDescent::get_reserve_selection_loss_history(void) const
+{
+   return(reserve_selection_loss_history);
+}
+
+
+// const bool& get_reserve_learning_rate_history(void) const method
+
+/// Returns true if the learning rate history vector is to be reserved, and false otherwise.
+
+const bool& StochasticGradientDescent::get_reserve_learning_rate_history(void) const
+{
+   return(reserve_learning_rate_history);
+}
+
+
+// const bool& get_reserve_elapsed_time_history(void) const method
+
+/// Returns true if the elapsed time history vector is to be reserved, and false otherwise.
+
+const bool& StochasticGradientDescent::get_reserve_elapsed_time_history(void) const
+{
+   return(reserve_elapsed_time_history);
+}
+
+
+// void set_default(void) method
+
+void StochasticGradientDescent::set_default(void)
+{
+   // TRAINING PARAMETERS
+
+   batch_size = 32;
+
+   initial_learning_rate = 0.01;
+   learning_rate_schedule = Constant;
+   learning_rate_decay = 0.0;
+
+   momentum = 0.0;
+   nesterov = false;
+
+   // STOPPING CRITERIA
+
+   loss_goal = -1.0e99;
+   maximum_selection_loss_decreases = 1000000;
+
+   maximum_epochs_number = 1000;
+   maximum_time = 1000.0;
+
+   return_minimum_selection_error_neural_network = false;
+
+   // TRAINING HISTORY
+
+   reserve_loss_history = true;
+   reserve_selection_loss_history = false;
+   reserve_learning_rate_history = false;
+   reserve_elapsed_time_history = false;
+
+   // UTILITIES
+
+   display = true;
+   display_period = 5;
+}
+
+
+// void set_reserve_all_training_history(bool) method
+
+/// Makes the training history of all variables to reseved or not in memory:
+/// <ul>
+/// <li> Loss.
+/// <li> Selection loss.
+/// <li> Learning rate.
+/// <li> Elapsed time.
+/// </ul>
+/// @param new_reserve_all_training_history True if the training history of all variables is to be reserved, false otherwise.
+
+void StochasticGradientDescent::set_reserve_all_training_history(const bool& new_reserve_all_training_history)
+{
+   reserve_loss_history = new_reserve_all_training_history;
+   reserve_selection_loss_history = new_reserve_all_training_history;
+   reserve_learning_rate_history = new_reserve_all_training_history;
+   reserve_elapsed_time_history = new_reserve_all_training_history;
+}
+
+
+// void set_batch_size(const size_t&) method
+
+/// Sets a new number of training instances in each mini-batch.
+/// @param new_batch_size Batch size. It must be greater than zero.
+
+void StochasticGradientDescent::set_batch_size(const size_t& new_batch_size)
+{
+   // Control sentence
+
+   if(new_batch_size == 0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "void set_batch_size(const size_t&) method.\n"
+             << "Batch size must be greater than 0.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   batch_size = new_batch_size;
+}
+
+
+// void set_initial_learning_rate(const double&) method
+
+/// Sets a new learning rate for the first epoch.
+/// @param new_initial_learning_rate Initial learning rate. It must be greater than zero.
+
+void StochasticGradientDescent::set_initial_learning_rate(const double& new_initial_learning_rate)
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(new_initial_learning_rate <= 0.0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "void set_initial_learning_rate(const double&) method.\n"
+             << "Initial learning rate must be greater than 0.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   initial_learning_rate = new_initial_learning_rate;
+}
+
+
+// void set_learning_rate_schedule(const LearningRateSchedule&) method
+
+/// Sets a new schedule of the learning rate along the epochs.
+/// @param new_learning_rate_schedule Learning rate schedule.
+
+void StochasticGradientDescent::set_learning_rate_schedule(const LearningRateSchedule& new_learning_rate_schedule)
+{
+   learning_rate_schedule = new_learning_rate_schedule;
+}
+
+
+// void set_learning_rate_schedule(const std::string&) method
+
+/// Sets a new schedule of the learning rate from a string.
+/// @param new_learning_rate_schedule String with the name of the schedule: "Constant", "InverseTime" or "Exponential".
+
+void StochasticGradientDescent::set_learning_rate_schedule(const std::string& new_learning_rate_schedule)
+{
+   if(new_learning_rate_schedule == "Constant")
+   {
+      learning_rate_schedule = Constant;
+   }
+   else if(new_learning_rate_schedule == "InverseTime")
+   {
+      learning_rate_schedule = InverseTime;
+   }
+   else if(new_learning_rate_schedule == "Exponential")
+   {
+      learning_rate_schedule = Exponential;
+   }
+   else
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "void set_learning_rate_schedule(const std::string&) method.\n"
+             << "Unknown learning rate schedule: " << new_learning_rate_schedule << ".\n";
+
+      throw std::logic_error(buffer.str());
+   }
+}
+
+
+// void set_learning_rate_decay(const double&) method
+
+/// Sets a new decay constant for the inverse time and exponential learning rate schedules.
+/// @param new_learning_rate_decay Learning rate decay. It must be equal or greater than zero.
+
+void StochasticGradientDescent::set_learning_rate_decay(const double& new_learning_rate_decay)
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(new_learning_rate_decay < 0.0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "void set_learning_rate_decay(const double&) method.\n"
+             << "Learning rate decay must be equal or greater than 0.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   learning_rate_decay = new_learning_rate_decay;
+}
+
+
+// void set_momentum(const double&) method
+
+/// Sets a new momentum coefficient.
+/// @param new_momentum Momentum coefficient. It must be in the interval [0, 1).
+
+void StochasticGradientDescent::set_momentum(const double& new_momentum)
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(new_momentum < 0.0 || new_momentum >= 1.0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "void set_momentum(const double&) method.\n"
+             << "Momentum must be equal or greater than 0 and less than 1.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   momentum = new_momentum;
+}
+
+
+// void set_nesterov(const bool&) method
+
+/// Makes the Nesterov accelerated gradient to be used or not.
+/// It has no effect if the momentum is zero.
+/// @param new_nesterov True if the Nesterov accelerated gradient is to be used, false otherwise.
+
+void StochasticGradientDescent::set_nesterov(const bool& new_nesterov)
+{
+   nesterov = new_nesterov;
+}
+
+
+// void set_loss_goal(const double&) method
+
+/// Sets a new goal value for the loss.
+/// This is used as a stopping criterion when training a multilayer perceptron
+/// @param new_loss_goal Goal value for the loss.
+
+void StochasticGradientDescent::set_loss_goal(const double& new_loss_goal)
+{
+   loss_goal = new_loss_goal;
+}
+
+
+// void set_maximum_selection_loss_decreases(const size_t&) method
+
+/// Sets a new maximum number of epochs for which the selection loss increases.
+/// @param new_maximum_selection_loss_decreases Maximum number of epochs in which the selection evalutation increases.
+
+void StochasticGradientDescent::set_maximum_selection_loss_decreases(const size_t& new_maximum_selection_loss_decreases)
+{
+   maximum_selection_loss_decreases = new_maximum_selection_loss_decreases;
+}
+
+
+// void set_maximum_epochs_number(const size_t&) method
+
+/// Sets a maximum number of epochs for training.
+/// @param new_maximum_epochs_number Maximum number of epochs for training.
+
+void StochasticGradientDescent::set_maximum_epochs_number(const size_t& new_maximum_epochs_number)
+{
+   maximum_epochs_number = new_maximum_epochs_number;
+}
+
+
+// void set_maximum_time(const double&) method
+
+/// Sets a new maximum training time.
+/// @param new_maximum_time Maximum training time.
+
+void StochasticGradientDescent::set_maximum_time(const double& new_maximum_time)
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(new_maximum_time < 0.0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "void set_maximum_time(const double&) method.\n"
+             << "Maximum time must be equal or greater than 0.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   maximum_time = new_maximum_time;
+}
+
+
+// void set_return_minimum_selection_error_neural_network(const bool&) method
+
+/// Makes the minimum selection error neural network of all the epochs to be returned or not.
+/// @param new_return_minimum_selection_error_neural_network True if the final model will be the neural network with the minimum selection error, false otherwise.
+
+void StochasticGradientDescent::set_return_minimum_selection_error_neural_network(const bool& new_return_minimum_selection_error_neural_network)
+{
+   return_minimum_selection_error_neural_network = new_return_minimum_selection_error_neural_network;
+}
+
+
+// void set_reserve_loss_history(bool) method
+
+/// Makes the loss history vector to be reseved or not in memory.
+/// @param new_reserve_loss_history True if the loss history vector is to be reserved, false otherwise.
+
+void StochasticGradientDescent::set_reserve_loss_history(const bool& new_reserve_loss_history)
+{
+   reserve_loss_history = new_reserve_loss_history;
+}
+
+
+// void set_reserve_selection_loss_history(bool) method
+
+/// Makes the selection loss history to be reserved or not in memory.
+/// @param new_reserve_selection_loss_history True if the selection loss history is to be reserved, false otherwise.
+
+void StochasticGradientDescent::set_reserve_selection_loss_history(const bool& new_reserve_selection_loss_history)
+{
+   reserve_selection_loss_history = new_reserve_selection_loss_history;
+}
+
+
+// void set_reserve_learning_rate_history(bool) method
+
+/// Makes the learning rate history vector to be reseved or not in memory.
+/// @param new_reserve_learning_rate_history True if the learning rate history vector is to be reserved, false otherwise.
+
+void StochasticGradientDescent::set_reserve_learning_rate_history(const bool& new_reserve_learning_rate_history)
+{
+   reserve_learning_rate_history = new_reserve_learning_rate_history;
+}
+
+
+// void set_reserve_elapsed_time_history(bool) method
+
+/// Makes the elapsed time over the epochs to be reseved or not in memory.
+/// @param new_reserve_elapsed_time_history True if the elapsed time history vector is to be reserved, false otherwise.
+
+void StochasticGradientDescent::set_reserve_elapsed_time_history(const bool& new_reserve_elapsed_time_history)
+{
+   reserve_elapsed_time_history = new_reserve_elapsed_time_history;
+}
+
+
+// void set_display_period(size_t) method
+
+/// Sets a new number of epochs between the training showing progress.
+/// @param new_display_period
+/// Number of epochs between the training showing progress.
+
+void StochasticGradientDescent::set_display_period(const size_t& new_display_period)
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   if(new_display_period <= 0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "void set_display_period(const size_t&) method.\n"
+             << "Display period must be greater than 0.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   #endif
+
+   display_period = new_display_period;
+}
+
+
+// double calculate_learning_rate(const size_t&) const method
+
+/// Returns the learning rate at a given epoch, according to the learning rate schedule:
+/// <ul>
+/// <li> Constant: lr0.
+/// <li> Inverse time: lr0/(1 + decay*epoch).
+/// <li> Exponential: lr0*exp(-decay*epoch).
+/// </ul>
+/// @param epoch Index of epoch.
+
+double StochasticGradientDescent::calculate_learning_rate(const size_t& epoch) const
+{
+   switch(learning_rate_schedule)
+   {
+      case Constant:
+      {
+         return(initial_learning_rate);
+      }
+      break;
+
+      case InverseTime:
+      {
+         return(initial_learning_rate/(1.0 + learning_rate_decay*(double)epoch));
+      }
+      break;
+
+      case Exponential:
+      {
+         return(initial_learning_rate*exp(-learning_rate_decay*(double)epoch));
+      }
+      break;
+
+      default:
+      {
+         std::ostringstream buffer;
+
+         buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+                << "double calculate_learning_rate(const size_t&) const method.\n"
+                << "Unknown learning rate schedule.\n";
+
+         throw std::logic_error(buffer.str());
+      }
+      break;
+   }
+}
+
+
+// std::string StochasticGradientDescentResults::to_string(void) const method
+
+std::string StochasticGradientDescent::StochasticGradientDescentResults::to_string(void) const
+{
+   std::ostringstream buffer;
+
+   // Performance history
+
+   if(!loss_history.empty())
+   {
+       buffer << "% Performance history:\n"
+              << loss_history << "\n";
+   }
+
+   // Selection loss history
+
+   if(!selection_loss_history.empty())
+   {
+       buffer << "% Selection loss history:\n"
+              << selection_loss_history << "\n";
+   }
+
+   // Learning rate history
+
+   if(!learning_rate_history.empty())
+   {
+       buffer << "% Learning rate history:\n"
+              << learning_rate_history << "\n";
+   }
+
+   // Elapsed time history
+
+   if(!elapsed_time_history.empty())
+   {
+       buffer << "% Elapsed time history:\n"
+              << elapsed_time_history << "\n";
+   }
+
+   // Stopping criterion
+
+   buffer << "% Stopping criterion:\n"
+          << write_stopping_condition() << "\n";
+
+   return(buffer.str());
+}
+
+
+// Matrix<std::string> write_final_results(const size_t& precision) const method
+
+Matrix<std::string> StochasticGradientDescent::StochasticGradientDescentResults::write_final_results(const size_t& precision) const
+{
+   std::ostringstream buffer;
+
+   Vector<std::string> names;
+   Vector<std::string> values;
+
+   // Final parameters norm
+
+   names.push_back("Final parameters norm");
+
+   buffer.str("");
+   buffer << std::setprecision(precision) << final_parameters_norm;
+
+   values.push_back(buffer.str());
+
+   // Final loss
+
+   names.push_back("Final loss");
+
+   buffer.str("");
+   buffer << std::setprecision(precision) << final_loss;
+
+   values.push_back(buffer.str());
+
+   // Final selection loss
+
+   const LossIndex* loss_index_pointer = stochastic_gradient_descent_pointer->get_loss_index_pointer();
+
+   if(loss_index_pointer->has_selection())
+   {
+       names.push_back("Final selection loss");
+
+       buffer.str("");
+       buffer << std::setprecision(precision) << final_selection_loss;
+
+       values.push_back(buffer.str());
+    }
+
+   // Final learning rate
+
+   names.push_back("Final learning rate");
+
+   buffer.str("");
+   buffer << std::setprecision(precision) << final_learning_rate;
+
+   values.push_back(buffer.str());
+
+   // Epochs number
+
+   names.push_back("Epochs number");
+
+   buffer.str("");
+   buffer << epochs_number;
+
+   values.push_back(buffer.str());
+
+   // Elapsed time
+
+   names.push_back("Elapsed time");
+
+   buffer.str("");
+   buffer << elapsed_time;
+
+   values.push_back(buffer.str());
+
+   // Stopping criteria
+
+   names.push_back("Stopping criterion");
+
+   values.push_back(write_stopping_condition());
+
+   const size_t rows_number = names.size();
+   const size_t columns_number = 2;
+
+   Matrix<std::string> final_results(rows_number, columns_number);
+
+   final_results.set_column(0, names);
+   final_results.set_column(1, values);
+
+   return(final_results);
+}
+
+
+// void StochasticGradientDescentResults::resize_training_history(const size_t&) method
+
+/// Resizes the training history variables which are to be reserved by the training algorithm.
+/// @param new_size Size of training history variables.
+
+void StochasticGradientDescent::StochasticGradientDescentResults::resize_training_history(const size_t& new_size)
+{
+    // Control sentence (if debug)
+
+    #ifdef __OPENNN_DEBUG__
+
+    if(stochastic_gradient_descent_pointer == NULL)
+    {
+       std::ostringstream buffer;
+
+       buffer << "OpenNN Exception: StochasticGradientDescentResults structure.\n"
+              << "void resize_training_history(const size_t&) method.\n"
+              << "Stochastic gradient descent pointer is NULL.\n";
+
+       throw std::logic_error(buffer.str());
+    }
+
+    #endif
+
+    if(stochastic_gradient_descent_pointer->get_reserve_loss_history())
+    {
+        loss_history.resize(new_size);
+    }
+
+    if(stochastic_gradient_descent_pointer->get_reserve_selection_loss_history())
+    {
+        selection_loss_history.resize(new_size);
+    }
+
+    if(stochastic_gradient_descent_pointer->get_reserve_learning_rate_history())
+    {
+        learning_rate_history.resize(new_size);
+    }
+
+    if(stochastic_gradient_descent_pointer->get_reserve_elapsed_time_history())
+    {
+        elapsed_time_history.resize(new_size);
+    }
+}
+
+
+// StochasticGradientDescentResults* perform_training(void) method
+
+/// Trains a neural network with an associated loss functional,
+/// according to the stochastic gradient descent method.
+/// At every epoch the training instances are shuffled and split into mini-batches,
+/// and the parameters are updated once per mini-batch with the gradient of that batch.
+/// The loss and the selection loss are evaluated once per epoch, on all the instances.
+/// It returns a results structure with the history and the final values of the reserved variables.
+
+StochasticGradientDescent::StochasticGradientDescentResults* StochasticGradientDescent::perform_training(void)
+{
+   // Control sentence
+
+   if(batch_size == 0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "StochasticGradientDescentResults* perform_training(void) method.\n"
+             << "Batch size must be greater than 0.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   if(loss_index_pointer->get_data_set_pointer()->get_instances().count_training_instances_number() == 0)
+   {
+      std::ostringstream buffer;
+
+      buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+             << "StochasticGradientDescentResults* perform_training(void) method.\n"
+             << "Number of training instances must be greater than 0.\n";
+
+      throw std::logic_error(buffer.str());
+   }
+
+   StochasticGradientDescentResults* results_pointer = new StochasticGradientDescentResults(this);
+
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   check();
+
+   #endif
+
+   // Start training
+
+   if(display)
+   {
+      std::cout << "Training with stochastic gradient descent...\n";
+   }
+
+   // Neural network stuff
+
+   NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+   const size_t parameters_number = neural_network_pointer->count_parameters_number();
+
+   const bool has_parameters_span = neural_network_pointer->has_parameters_span();
+
+   VectorSpan<double> parameters_span;
+
+   if(has_parameters_span)
+   {
+      parameters_span = neural_network_pointer->get_parameters_span();
+   }
+
+   Vector<double> parameters = neural_network_pointer->arrange_parameters();
+   double parameters_norm = 0.0;
+
+   // Data set stuff
+
+   const Instances& instances = loss_index_pointer->get_data_set_pointer()->get_instances();
+
+   Vector<size_t> training_indices = instances.arrange_training_indices();
+
+   const size_t training_instances_number = training_indices.size();
+
+   const size_t batch_instances_number = std::min(batch_size, training_instances_number);
+
+   const size_t batches_number = (training_instances_number + batch_instances_number - 1)/batch_instances_number;
+
+   Vector<size_t> batch_indices;
+
+   // Loss index stuff
+
+   double selection_loss = 0.0;
+   double old_selection_loss = 0.0;
+
+   double loss = 0.0;
+
+   Vector<double> gradient(parameters_number);
+
+   // Training algorithm stuff
+
+   size_t selection_failures = 0;
+
+   Vector<double> velocity(parameters_number, 0.0);
+
+   double learning_rate = initial_learning_rate;
+
+   Vector<double> minimum_selection_error_parameters(parameters_number);
+   double minimum_selection_error = 0.0;
+
+   bool stop_training = false;
+
+   time_t beginning_time, current_time;
+   time(&beginning_time);
+   double elapsed_time = 0.0;
+
+   results_pointer->resize_training_history(maximum_epochs_number+1);
+
+   // Main loop
+
+   for(size_t epoch = 0; epoch <= maximum_epochs_number; epoch++)
+   {
+      // Neural network stuff
+
+      if(has_parameters_span)
+      {
+         parameters = parameters_span.to_vector();
+      }
+
+      parameters_norm = parameters.calculate_norm();
+
+      // Loss index stuff
+
+      loss = loss_index_pointer->calculate_loss();
+
+      selection_loss = loss_index_pointer->calculate_selection_loss();
+
+      if(epoch == 0)
+      {
+          minimum_selection_error = selection_loss;
+
+          minimum_selection_error_parameters = parameters;
+      }
+      else if(selection_loss > old_selection_loss)
+      {
+         selection_failures++;
+      }
+      else if(selection_loss < minimum_selection_error)
+      {
+          minimum_selection_error = selection_loss;
+
+          minimum_selection_error_parameters = parameters;
+      }
+
+      // Training algorithm
+
+      learning_rate = calculate_learning_rate(epoch);
+
+      // Elapsed time
+
+      time(&current_time);
+      elapsed_time = difftime(current_time, beginning_time);
+
+      // Training history
+
+      if(reserve_loss_history)
+      {
+         results_pointer->loss_history[epoch] = loss;
+      }
+
+      if(reserve_selection_loss_history)
+      {
+         results_pointer->selection_loss_history[epoch] = selection_loss;
+      }
+
+      if(reserve_learning_rate_history)
+      {
+         results_pointer->learning_rate_history[epoch] = learning_rate;
+      }
+
+      if(reserve_elapsed_time_history)
+      {
+         results_pointer->elapsed_time_history[epoch] = elapsed_time;
+      }
+
+      // Stopping Criteria
+
+      if(loss <= loss_goal)
+      {
+         if(display)
+         {
+            std::cout << "Epoch " << epoch << ": Performance goal reached.\n";
+         }
+
+         stop_training = true;
+
+         results_pointer->stopping_condition = PerformanceGoal;
+      }
+
+      else if(selection_failures >= maximum_selection_loss_decreases)
+      {
+         if(display)
+         {
+            std::cout << "Epoch " << epoch << ": Maximum selection failures reached.\n"
+                      << "Selection failures: " << selection_failures << std::endl;
+         }
+
+         stop_training = true;
+
+         results_pointer->stopping_condition = MaximumSelectionPerformanceDecreases;
+      }
+
+      else if(epoch == maximum_epochs_number)
+      {
+         if(display)
+         {
+            std::cout << "Epoch " << epoch << ": Maximum number of epochs reached.\n";
+         }
+
+         stop_training = true;
+
+         results_pointer->stopping_condition = MaximumIterationsNumber;
+      }
+
+      else if(elapsed_time >= maximum_time)
+      {
+         if(display)
+         {
+            std::cout << "Epoch " << epoch << ": Maximum training time reached.\n";
+         }
+
+         stop_training = true;
+
+         results_pointer->stopping_condition = MaximumTime;
+      }
+
+      if(epoch != 0 && epoch % save_period == 0)
+      {
+            neural_network_pointer->save(neural_network_file_name);
+      }
+
+      if(stop_training)
+      {
+         if(display)
+		 {
+            std::cout << "Parameters norm: " << parameters_norm << "\n"
+                      << "Training loss: " << loss << "\n"
+                      << loss_index_pointer->write_information()
+                      << "Learning rate: " << learning_rate << "\n"
+                      << "Elapsed time: " << elapsed_time << std::endl;
+
+            if(selection_loss != 0)
+            {
+               std::cout << "Selection loss: " << selection_loss << std::endl;
+            }
+		 }
+
+         results_pointer->resize_training_history(1+epoch);
+
+         results_pointer->final_learning_rate = learning_rate;
+
+         results_pointer->epochs_number = epoch;
+
+         break;
+      }
+      else if(display && epoch % display_period == 0)
+      {
+         std::cout << "Epoch " << epoch << ";\n"
+                   << "Parameters norm: " << parameters_norm << "\n"
+                   << "Training loss: " << loss << "\n"
+                   << loss_index_pointer->write_information()
+                   << "Learning rate: " << learning_rate << "\n"
+                   << "Elapsed time: " << elapsed_time << std::endl;
+
+         if(selection_loss != 0)
+         {
+            std::cout << "Selection loss: " << selection_loss << std::endl;
+         }
+      }
+
+      // Update the parameters once per mini-batch
+
+      std::random_shuffle(training_indices.begin(), training_indices.end());
+
+      for(size_t batch = 0; batch < batches_number; batch++)
+      {
+         const size_t first_index = batch*batch_instances_number;
+         const size_t last_index = std::min(first_index + batch_instances_number, training_instances_number);
+
+         batch_indices.assign(training_indices.begin() + first_index, training_indices.begin() + last_index);
+
+         gradient = loss_index_pointer->calculate_batch_gradient(batch_indices);
+
+         double* parameters_data = has_parameters_span ? parameters_span.data() : parameters.data();
+
+         for(size_t i = 0; i < parameters_number; i++)
+         {
+            velocity[i] = momentum*velocity[i] - learning_rate*gradient[i];
+
+            if(nesterov)
+            {
+               parameters_data[i] += momentum*velocity[i] - learning_rate*gradient[i];
+            }
+            else
+            {
+               parameters_data[i] += velocity[i];
+            }
+         }
+
+         if(!has_parameters_span)
+         {
+            neural_network_pointer->set_parameters(parameters);
+         }
+      }
+
+      // Update stuff
+
+      old_selection_loss = selection_loss;
+   }
+
+   if(return_minimum_selection_error_neural_network)
+   {
+       parameters = minimum_selection_error_parameters;
+       parameters_norm = parameters.calculate_norm();
+
+       neural_network_pointer->set_parameters(parameters);
+
+       loss = loss_index_pointer->calculate_loss();
+       selection_loss = minimum_selection_error;
+   }
+
+   results_pointer->final_parameters = parameters;
+   results_pointer->final_parameters_norm = parameters_norm;
+
+   results_pointer->final_loss = loss;
+   results_pointer->final_selection_loss = selection_loss;
+
+   results_pointer->elapsed_time = elapsed_time;
+
+   return(results_pointer);
+}
+
+
+// std::string write_training_algorithm_type(void) const method
+
+std::string StochasticGradientDescent::write_training_algorithm_type(void) const
+{
+   return("STOCHASTIC_GRADIENT_DESCENT");
+}
+
+
+// Matrix<std::string> to_string_matrix(void) const method
+
+/// Writes as matrix of strings the most representative atributes.
+
+Matrix<std::string> StochasticGradientDescent::to_string_matrix(void) const
+{
+    std::ostringstream buffer;
+
+    Vector<std::string> labels;
+    Vector<std::string> values;
+
+   // Batch size
+
+   labels.push_back("Batch size");
+
+   buffer.str("");
+   buffer << batch_size;
+
+   values.push_back(buffer.str());
+
+   // Initial learning rate
+
+   labels.push_back("Initial learning rate");
+
+   buffer.str("");
+   buffer << initial_learning_rate;
+
+   values.push_back(buffer.str());
+
+   // Learning rate schedule
+
+   labels.push_back("Learning rate schedule");
+
+   values.push_back(write_learning_rate_schedule());
+
+   // Learning rate decay
+
+   labels.push_back("Learning rate decay");
+
+   buffer.str("");
+   buffer << learning_rate_decay;
+
+   values.push_back(buffer.str());
+
+   // Momentum
+
+   labels.push_back("Momentum");
+
+   buffer.str("");
+   buffer << momentum;
+
+   values.push_back(buffer.str());
+
+   // Nesterov
+
+   labels.push_back("Nesterov");
+
+   buffer.str("");
+
+   if(nesterov)
+   {
+       buffer << "true";
+   }
+   else
+   {
+       buffer << "false";
+   }
+
+   values.push_back(buffer.str());
+
+   // Performance goal
+
+   labels.push_back("Performance goal");
+
+   buffer.str("");
+   buffer << loss_goal;
+
+   values.push_back(buffer.str());
+
+   // Maximum selection loss decreases
+
+   labels.push_back("Maximum selection loss increases");
+
+   buffer.str("");
+   buffer << maximum_selection_loss_decreases;
+
+   values.push_back(buffer.str());
+
+   // Maximum epochs number
+
+   labels.push_back("Maximum epochs number");
+
+   buffer.str("");
+   buffer << maximum_epochs_number;
+
+   values.push_back(buffer.str());
+
+   // Maximum time
+
+   labels.push_back("Maximum time");
+
+   buffer.str("");
+   buffer << maximum_time;
+
+   values.push_back(buffer.str());
+
+   // Reserve loss history
+
+   labels.push_back("Reserve loss history");
+
+   buffer.str("");
+
+   if(reserve_loss_history)
+   {
+       buffer << "true";
+   }
+   else
+   {
+       buffer << "false";
+   }
+
+   values.push_back(buffer.str());
+
+   // Reserve selection loss history
+
+   labels.push_back("Reserve selection loss history");
+
+   buffer.str("");
+
+   if(reserve_selection_loss_history)
+   {
+       buffer << "true";
+   }
+   else
+   {
+       buffer << "false";
+   }
+
+   values.push_back(buffer.str());
+
+   const size_t rows_number = labels.size();
+   const size_t columns_number = 2;
+
+   Matrix<std::string> string_matrix(rows_number, columns_number);
+
+   string_matrix.set_column(0, labels);
+   string_matrix.set_column(1, values);
+
+    return(string_matrix);
+}
+
+
+// tinyxml2::XMLDocument* to_XML(void) const method
+
+/// Serializes the training parameters, the stopping criteria and other user stuff
+/// concerning the stochastic gradient descent object.
+
+tinyxml2::XMLDocument* StochasticGradientDescent::to_XML(void) const
+{
+   std::ostringstream buffer;
+
+   tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument;
+
+   // Training algorithm
+
+   tinyxml2::XMLElement* root_element = document->NewElement("StochasticGradientDescent");
+
+   document->InsertFirstChild(root_element);
+
+   tinyxml2::XMLElement* element = NULL;
+   tinyxml2::XMLText* text = NULL;
+
+   // Batch size
+
+   element = document->NewElement("BatchSize");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << batch_size;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Initial learning rate
+
+   element = document->NewElement("InitialLearningRate");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << initial_learning_rate;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Learning rate schedule
+
+   element = document->NewElement("LearningRateSchedule");
+   root_element->LinkEndChild(element);
+
+   text = document->NewText(write_learning_rate_schedule().c_str());
+   element->LinkEndChild(text);
+
+   // Learning rate decay
+
+   element = document->NewElement("LearningRateDecay");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << learning_rate_decay;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Momentum
+
+   element = document->NewElement("Momentum");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << momentum;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Nesterov
+
+   element = document->NewElement("Nesterov");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << nesterov;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Return minimum selection error neural network
+
+   element = document->NewElement("ReturnMinimumSelectionErrorNN");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << return_minimum_selection_error_neural_network;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Performance goal
+
+   element = document->NewElement("PerformanceGoal");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << loss_goal;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Maximum selection loss decreases
+
+   element = document->NewElement("MaximumSelectionLossDecreases");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << maximum_selection_loss_decreases;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Maximum epochs number
+
+   element = document->NewElement("MaximumEpochsNumber");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << maximum_epochs_number;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Maximum time
+
+   element = document->NewElement("MaximumTime");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << maximum_time;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Reserve loss history
+
+   element = document->NewElement("ReservePerformanceHistory");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << reserve_loss_history;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Reserve selection loss history
+
+   element = document->NewElement("ReserveSelectionLossHistory");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << reserve_selection_loss_history;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Reserve learning rate history
+
+   element = document->NewElement("ReserveLearningRateHistory");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << reserve_learning_rate_history;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Reserve elapsed time history
+
+   element = document->NewElement("ReserveElapsedTimeHistory");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << reserve_elapsed_time_history;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Display period
+
+   element = document->NewElement("DisplayPeriod");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << display_period;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   // Display
+
+   element = document->NewElement("Display");
+   root_element->LinkEndChild(element);
+
+   buffer.str("");
+   buffer << display;
+
+   text = document->NewText(buffer.str().c_str());
+   element->LinkEndChild(text);
+
+   return(document);
+}
+
+
+// void write_XML(tinyxml2::XMLPrinter&) const method
+
+/// Serializes the stochastic gradient descent object into a XML document of the TinyXML library without keep the DOM tree in memory.
+/// See the OpenNN manual for more information about the format of this document.
+
+void StochasticGradientDescent::write_XML(tinyxml2::XMLPrinter& file_stream) const
+{
+    std::ostringstream buffer;
+
+    // Batch size
+
+    file_stream.OpenElement("BatchSize");
+
+    buffer.str("");
+    buffer << batch_size;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Initial learning rate
+
+    file_stream.OpenElement("InitialLearningRate");
+
+    buffer.str("");
+    buffer << initial_learning_rate;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Learning rate schedule
+
+    file_stream.OpenElement("LearningRateSchedule");
+
+    file_stream.PushText(write_learning_rate_schedule().c_str());
+
+    file_stream.CloseElement();
+
+    // Learning rate decay
+
+    file_stream.OpenElement("LearningRateDecay");
+
+    buffer.str("");
+    buffer << learning_rate_decay;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Momentum
+
+    file_stream.OpenElement("Momentum");
+
+    buffer.str("");
+    buffer << momentum;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Nesterov
+
+    file_stream.OpenElement("Nesterov");
+
+    buffer.str("");
+    buffer << nesterov;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Return minimum selection error neural network
+
+    file_stream.OpenElement("ReturnMinimumSelectionErrorNN");
+
+    buffer.str("");
+    buffer << return_minimum_selection_error_neural_network;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Performance goal
+
+    file_stream.OpenElement("PerformanceGoal");
+
+    buffer.str("");
+    buffer << loss_goal;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Maximum selection loss decreases
+
+    file_stream.OpenElement("MaximumSelectionLossDecreases");
+
+    buffer.str("");
+    buffer << maximum_selection_loss_decreases;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Maximum epochs number
+
+    file_stream.OpenElement("MaximumEpochsNumber");
+
+    buffer.str("");
+    buffer << maximum_epochs_number;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Maximum time
+
+    file_stream.OpenElement("MaximumTime");
+
+    buffer.str("");
+    buffer << maximum_time;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Reserve loss history
+
+    file_stream.OpenElement("ReservePerformanceHistory");
+
+    buffer.str("");
+    buffer << reserve_loss_history;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Reserve selection loss history
+
+    file_stream.OpenElement("ReserveSelectionLossHistory");
+
+    buffer.str("");
+    buffer << reserve_selection_loss_history;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+}
+
+
+// void from_XML(const tinyxml2::XMLDocument&) method
+
+void StochasticGradientDescent::from_XML(const tinyxml2::XMLDocument& document)
+{
+    const tinyxml2::XMLElement* root_element = document.FirstChildElement("StochasticGradientDescent");
+
+    if(!root_element)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+               << "void from_XML(const tinyxml2::XMLDocument&) method.\n"
+               << "Stochastic gradient descent element is NULL.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+   // Batch size
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("BatchSize");
+
+       if(element)
+       {
+          const size_t new_batch_size = atoi(element->GetText());
+
+          try
+          {
+             set_batch_size(new_batch_size);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Initial learning rate
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("InitialLearningRate");
+
+       if(element)
+       {
+          const double new_initial_learning_rate = atof(element->GetText());
+
+          try
+          {
+             set_initial_learning_rate(new_initial_learning_rate);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Learning rate schedule
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("LearningRateSchedule");
+
+       if(element)
+       {
+          const std::string new_learning_rate_schedule = element->GetText();
+
+          try
+          {
+             set_learning_rate_schedule(new_learning_rate_schedule);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Learning rate decay
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("LearningRateDecay");
+
+       if(element)
+       {
+          const double new_learning_rate_decay = atof(element->GetText());
+
+          try
+          {
+             set_learning_rate_decay(new_learning_rate_decay);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Momentum
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("Momentum");
+
+       if(element)
+       {
+          const double new_momentum = atof(element->GetText());
+
+          try
+          {
+             set_momentum(new_momentum);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Nesterov
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("Nesterov");
+
+       if(element)
+       {
+          const std::string new_nesterov = element->GetText();
+
+          try
+          {
+             set_nesterov(new_nesterov != "0");
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Return minimum selection error neural network
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("ReturnMinimumSelectionErrorNN");
+
+       if(element)
+       {
+          const std::string new_return_minimum_selection_error_neural_network = element->GetText();
+
+          try
+          {
+             set_return_minimum_selection_error_neural_network(new_return_minimum_selection_error_neural_network != "0");
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Performance goal
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("PerformanceGoal");
+
+       if(element)
+       {
+          const double new_loss_goal = atof(element->GetText());
+
+          try
+          {
+             set_loss_goal(new_loss_goal);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Maximum selection loss decreases
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("MaximumSelectionLossDecreases");
+
+       if(element)
+       {
+          const size_t new_maximum_selection_loss_decreases = atoi(element->GetText());
+
+          try
+          {
+             set_maximum_selection_loss_decreases(new_maximum_selection_loss_decreases);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Maximum epochs number
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("MaximumEpochsNumber");
+
+       if(element)
+       {
+          const size_t new_maximum_epochs_number = atoi(element->GetText());
+
+          try
+          {
+             set_maximum_epochs_number(new_maximum_epochs_number);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Maximum time
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("MaximumTime");
+
+       if(element)
+       {
+          const double new_maximum_time = atof(element->GetText());
+
+          try
+          {
+             set_maximum_time(new_maximum_time);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Reserve loss history
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("ReservePerformanceHistory");
+
+       if(element)
+       {
+          const std::string new_reserve_loss_history = element->GetText();
+
+          try
+          {
+             set_reserve_loss_history(new_reserve_loss_history != "0");
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Reserve selection loss history
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("ReserveSelectionLossHistory");
+
+       if(element)
+       {
+          const std::string new_reserve_selection_loss_history = element->GetText();
+
+          try
+          {
+             set_reserve_selection_loss_history(new_reserve_selection_loss_history != "0");
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Reserve learning rate history
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("ReserveLearningRateHistory");
+
+       if(element)
+       {
+          const std::string new_reserve_learning_rate_history = element->GetText();
+
+          try
+          {
+             set_reserve_learning_rate_history(new_reserve_learning_rate_history != "0");
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Reserve elapsed time history
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("ReserveElapsedTimeHistory");
+
+       if(element)
+       {
+          const std::string new_reserve_elapsed_time_history = element->GetText();
+
+          try
+          {
+             set_reserve_elapsed_time_history(new_reserve_elapsed_time_history != "0");
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Display period
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("DisplayPeriod");
+
+       if(element)
+       {
+          const size_t new_display_period = atoi(element->GetText());
+
+          try
+          {
+             set_display_period(new_display_period);
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+
+   // Display
+   {
+       const tinyxml2::XMLElement* element = root_element->FirstChildElement("Display");
+
+       if(element)
+       {
+          const std::string new_display = element->GetText();
+
+          try
+          {
+             set_display(new_display != "0");
+          }
+          catch(const std::logic_error& e)
+          {
+             std::cout << e.what() << std::endl;
+          }
+       }
+   }
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (c) 2005-2016 Roberto Lopez.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
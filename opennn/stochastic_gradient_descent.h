@@ -0,0 +1,318 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   S T O C H A S T I C   G R A D I E N T   D E S C E N T   C L A S S   H E A D E R                            */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+#ifndef __STOCHASTICGRADIENTDESCENT_H__
+#define __STOCHASTICGRADIENTDESCENT_H__
+
+// System includes
+
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <cmath>
+#include <ctime>
+
+// OpenNN includes
+
+#include "loss_index.h"
+
+#include "training_algorithm.h"
+
+
+namespace OpenNN
+{
+
+/// This concrete class represents the stochastic gradient descent training algorithm for
+/// a loss functional of a neural network.
+/// The training instances are shuffled at every epoch and split into mini-batches.
+/// The parameters are updated once per mini-batch, with optional momentum or Nesterov momentum.
+
+class StochasticGradientDescent : public TrainingAlgorithm
+{
+
+public:
+
+   // ENUMERATIONS
+
+   /// Enumeration of the available schedules for the learning rate along the epochs.
+
+   enum LearningRateSchedule{Constant, InverseTime, Exponential};
+
+   // DEFAULT CONSTRUCTOR
+
+   explicit StochasticGradientDescent(void);
+
+   // PERFORMANCE FUNCTIONAL CONSTRUCTOR
+
+   explicit StochasticGradientDescent(LossIndex*);
+
+   // XML CONSTRUCTOR
+
+   explicit StochasticGradientDescent(const tinyxml2::XMLDocument&);
+
+
+   // DESTRUCTOR
+
+   virtual ~StochasticGradientDescent(void);
+
+   // STRUCTURES
+
+   ///
+   /// This structure contains the training results for the stochastic gradient descent.
+   ///
+
+   struct StochasticGradientDescentResults : public TrainingAlgorithm::TrainingAlgorithmResults
+   {
+       /// Default constructor.
+
+       StochasticGradientDescentResults(void)
+       {
+           stochastic_gradient_descent_pointer = NULL;
+       }
+
+       /// Stochastic gradient descent constructor.
+
+       StochasticGradientDescentResults(StochasticGradientDescent* new_stochastic_gradient_descent_pointer)
+       {
+           stochastic_gradient_descent_pointer = new_stochastic_gradient_descent_pointer;
+       }
+
+       /// Destructor.
+
+       virtual ~StochasticGradientDescentResults(void)
+       {
+       }
+
+       /// Pointer to the stochastic gradient descent object for which the training results are to be stored.
+
+      StochasticGradientDescent* stochastic_gradient_descent_pointer;
+
+      // Training history
+
+      /// History of the loss function loss over the training epochs.
+
+      Vector<double> loss_history;
+
+      /// History of the selection loss over the training epochs.
+
+      Vector<double> selection_loss_history;
+
+      /// History of the learning rate over the training epochs.
+
+      Vector<double> learning_rate_history;
+
+      /// History of the elapsed time over the training epochs.
+
+      Vector<double> elapsed_time_history;
+
+      // Final values
+
+      /// Final neural network parameters vector.
+
+      Vector<double> final_parameters;
+
+      /// Final neural network parameters norm.
+
+      double final_parameters_norm;
+
+      /// Final loss function evaluation.
+
+      double final_loss;
+
+      /// Final selection loss.
+
+      double final_selection_loss;
+
+      /// Final learning rate.
+
+      double final_learning_rate;
+
+      /// Elapsed time of the training process.
+
+      double elapsed_time;
+
+      /// Number of training epochs.
+
+      size_t epochs_number;
+
+      void resize_training_history(const size_t&);
+
+      std::string to_string(void) const;
+
+      Matrix<std::string> write_final_results(const size_t& precision = 3) const;
+   };
+
+   // METHODS
+
+   // Training parameters
+
+   const size_t& get_batch_size(void) const;
+
+   const double& get_initial_learning_rate(void) const;
+   const LearningRateSchedule& get_learning_rate_schedule(void) const;
+   std::string write_learning_rate_schedule(void) const;
+   const double& get_learning_rate_decay(void) const;
+
+   const double& get_momentum(void) const;
+   const bool& get_nesterov(void) const;
+
+   // Stopping criteria
+
+   const double& get_loss_goal(void) const;
+   const size_t& get_maximum_selection_loss_decreases(void) const;
+
+   const size_t& get_maximum_epochs_number(void) const;
+   const double& get_maximum_time(void) const;
+
+   const bool& get_return_minimum_selection_error_neural_network(void) const;
+
+   // Reserve training history
+
+   const bool& get_reserve_loss_history(void) const;
+   const bool& get_reserve_selection_loss_history(void) const;
+   const bool& get_reserve_learning_rate_history(void) const;
+   const bool& get_reserve_elapsed_time_history(void) const;
+
+   // Set methods
+
+   void set_default(void);
+
+   void set_reserve_all_training_history(const bool&);
+
+   // Training parameters
+
+   void set_batch_size(const size_t&);
+
+   void set_initial_learning_rate(const double&);
+   void set_learning_rate_schedule(const LearningRateSchedule&);
+   void set_learning_rate_schedule(const std::string&);
+   void set_learning_rate_decay(const double&);
+
+   void set_momentum(const double&);
+   void set_nesterov(const bool&);
+
+   // Stopping criteria
+
+   void set_loss_goal(const double&);
+   void set_maximum_selection_loss_decreases(const size_t&);
+
+   void set_maximum_epochs_number(const size_t&);
+   void set_maximum_time(const double&);
+
+   void set_return_minimum_selection_error_neural_network(const bool&);
+
+   // Reserve training history
+
+   void set_reserve_loss_history(const bool&);
+   void set_reserve_selection_loss_history(const bool&);
+   void set_reserve_learning_rate_history(const bool&);
+   void set_reserve_elapsed_time_history(const bool&);
+
+   // Utilities
+
+   void set_display_period(const size_t&);
+
+   // Training methods
+
+   double calculate_learning_rate(const size_t&) const;
+
+   StochasticGradientDescentResults* perform_training(void);
+
+   std::string write_training_algorithm_type(void) const;
+
+   // Serialization methods
+
+   Matrix<std::string> to_string_matrix(void) const;
+
+   tinyxml2::XMLDocument* to_XML(void) const;
+   void from_XML(const tinyxml2::XMLDocument&);
+
+   void write_XML(tinyxml2::XMLPrinter&) const;
+
+private:
+
+   // TRAINING PARAMETERS
+
+   /// Number of training instances in each mini-batch.
+
+   size_t batch_size;
+
+   /// Learning rate at the first epoch.
+
+   double initial_learning_rate;
+
+   /// Schedule of the learning rate along the epochs.
+
+   LearningRateSchedule learning_rate_schedule;
+
+   /// Decay constant of the inverse time and exponential learning rate schedules.
+
+   double learning_rate_decay;
+
+   /// Momentum coefficient. A value of zero gives plain stochastic gradient descent.
+
+   double momentum;
+
+   /// True if the Nesterov accelerated gradient is to be used, false otherwise.
+
+   bool nesterov;
+
+   // STOPPING CRITERIA
+
+   /// Goal value for the loss. It is used as a stopping criterion.
+
+   double loss_goal;
+
+   /// Maximum number of epochs at which the selection loss increases.
+   /// This is an early stopping method for improving selection.
+
+   size_t maximum_selection_loss_decreases;
+
+   /// Maximum number of epochs to perform_training. It is used as a stopping criterion.
+
+   size_t maximum_epochs_number;
+
+   /// Maximum training time. It is used as a stopping criterion.
+
+   double maximum_time;
+
+   /// True if the final model will be the neural network with the minimum selection error, false otherwise.
+
+   bool return_minimum_selection_error_neural_network;
+
+   // TRAINING HISTORY
+
+   /// True if the loss history vector is to be reserved, false otherwise.
+
+   bool reserve_loss_history;
+
+   /// True if the selection loss history vector is to be reserved, false otherwise.
+
+   bool reserve_selection_loss_history;
+
+   /// True if the learning rate history vector is to be reserved, false otherwise.
+
+   bool reserve_learning_rate_history;
+
+   /// True if the elapsed time history vector is to be reserved, false otherwise.
+
+   bool reserve_elapsed_time_history;
+};
+
+}
+
+#endif
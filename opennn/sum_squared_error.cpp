@@ -198,57 +198,23 @@ double SumSquaredError::calculate_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Sum squared error stuff
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   int i = 0;
-   double sum_squared_error = 0.0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : sum_squared_error)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-      // Input vector
-
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      // Target vector
-
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+      return(calculate_instances_error(training_indices, multilayer_perceptron_pointer->arrange_parameters()));
+   }
 
-      // Output vector
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+   // Sum squared error stuff
 
-      // Sum squared error
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-      sum_squared_error += outputs.calculate_sum_squared_error(targets);
-   }
-
-   return(sum_squared_error);
+   return(outputs.calculate_sum_squared_error(targets));
 }
 
 
@@ -293,58 +259,23 @@ double SumSquaredError::calculate_error(const Vector<double>& parameters) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
-   const Instances& instances = data_set_pointer->get_instances();
-
-   const size_t training_instances_number = instances.count_training_instances_number();
-
-   const Vector<size_t> training_indices = instances.arrange_training_indices();
-
-   size_t training_index;
-
-   const Variables& variables = data_set_pointer->get_variables();
-
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-   // Sum squared error stuff
-
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   int i = 0;
-
-   double sum_squared_error = 0.0;
-
-   #pragma omp parallel for private(i, training_index, inputs, outputs, targets) reduction(+ : sum_squared_error)
-
-   for(i = 0; i < (int)training_instances_number; i++)
+   if(data_set_pointer->is_out_of_core())
    {
-       training_index = training_indices[i];
-
-       // Input vector
+      const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-      inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-      // Output vector
-
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
-
-      // Target vector
+      return(calculate_instances_error(training_indices, parameters));
+   }
 
-      targets = data_set_pointer->get_instance(training_index, targets_indices);
+   const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-      // Sum squared error
+   // Sum squared error stuff
 
-      sum_squared_error += outputs.calculate_sum_squared_error(targets);
-   }
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
-   return(sum_squared_error);
+   return(outputs.calculate_sum_squared_error(targets));
 }
 
 
@@ -411,65 +342,83 @@ double SumSquaredError::calculate_selection_error(void) const
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-   const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-   const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
    // Data set stuff
 
    const Instances& instances = data_set_pointer->get_instances();
+
    const size_t selection_instances_number = instances.count_selection_instances_number();
 
-   const Vector<size_t> selection_indices = instances.arrange_selection_indices();
+   if(selection_instances_number == 0)
+   {
+      return(0.0);
+   }
 
-   size_t selection_index;
+   if(data_set_pointer->is_out_of_core())
+   {
+      const Vector<size_t> selection_indices = data_set_pointer->get_instances().arrange_selection_indices();
 
-   const Variables& variables = data_set_pointer->get_variables();
+      return(calculate_instances_error(selection_indices, multilayer_perceptron_pointer->arrange_parameters()));
+   }
 
-   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+   const Matrix<double>& inputs = data_set_pointer->get_selection_input_data();
+   const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
 
    // Sum squared error stuff
 
-   Vector<double> inputs(inputs_number);
-   Vector<double> outputs(outputs_number);
-   Vector<double> targets(outputs_number);
-
-   double selection_loss = 0.0;
+   const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-   int i = 0;
+   return(outputs.calculate_sum_squared_error(targets));
+}
 
-   #pragma omp parallel for private(i, selection_index, inputs, outputs, targets) reduction(+ : selection_loss)
 
-   for(i = 0; i < (int)selection_instances_number; i++)
-   {
-       selection_index = selection_indices[i];
+// Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const method
 
-      // Input vector
+Vector<double> SumSquaredError::calculate_output_gradient(const Vector<double>& output, const Vector<double>& target) const
+{
+    return((output-target)*2.0);
+}
 
-      inputs = data_set_pointer->get_instance(selection_index, inputs_indices);
 
-      // Output vector
+// Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const method
 
-      outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
+/// Returns the sum squared error gradient with respect to the outputs, for a batch of instances.
+/// @param outputs Matrix of outputs. Each row corresponds to one instance.
+/// @param targets Matrix of targets. Each row corresponds to one instance.
 
-      // Target vector
+Matrix<double> SumSquaredError::calculate_output_gradient(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    return((outputs-targets)*2.0);
+}
 
-      targets = data_set_pointer->get_instance(selection_index, targets_indices);
 
-      // Sum of squares error
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
 
-      selection_loss += outputs.calculate_sum_squared_error(targets);
-   }
+/// Returns the sum squared error of a batch of instances.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
 
-   return(selection_loss);
+double SumSquaredError::calculate_batch_error(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    return(outputs.calculate_sum_squared_error(targets));
 }
 
 
-// Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const method
+// FirstOrderPerformance calculate_first_order_loss(void) const method
 
-Vector<double> SumSquaredError::calculate_output_gradient(const Vector<double>& output, const Vector<double>& target) const
+/// Returns the sum squared error and its gradient on the training instances,
+/// both computed from a single forward propagation of the instances.
+
+ErrorTerm::FirstOrderPerformance SumSquaredError::calculate_first_order_loss(void) const
 {
-    return((output-target)*2.0);
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
+
+    return(calculate_batch_first_order_loss(training_indices));
 }
 
 
@@ -89,9 +89,14 @@ public:
    double calculate_selection_error(void) const;
 
    Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const;
+   Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const;
 
    Matrix<double> calculate_output_Hessian(const Vector<double>&, const Vector<double>&) const;
 
+   double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const;
+
+   FirstOrderPerformance calculate_first_order_loss(void) const;
+
    double calculate_error(const Vector<double>&) const;
 
    Matrix<double> calculate_single_hidden_layer_Hessian(void) const;
@@ -357,6 +357,195 @@ void TestingAnalysis::check(void) const
 }
 
 
+// const TestingOutputs& get_testing_outputs(void) const method
+
+/// Returns the targets and the outputs of the testing instances, together with their order by the first output.
+/// The neural network is evaluated on all the testing instances at once, and the outputs are sorted once.
+/// They are calculated the first time they are needed, and they are not calculated again
+/// until the parameters or the layers of the neural network, or the data set, change.
+/// All the testing reports are obtained from them, without copying them.
+/// If the data set is out of core, the testing inputs are read by blocks of instances instead of being arranged as a whole.
+/// The returned reference is updated by the next call after the neural network or the data set change.
+
+const TestingAnalysis::TestingOutputs& TestingAnalysis::get_testing_outputs(void) const
+{
+   // Control sentence (if debug)
+
+   #ifdef __OPENNN_DEBUG__
+
+   check();
+
+   #endif
+
+   const EvaluationState evaluation_state = get_evaluation_state();
+
+   #pragma omp critical(testing_analysis_outputs)
+   {
+      if(!testing_outputs_cache.calculated || !(evaluation_state == testing_outputs_cache.evaluation_state))
+      {
+         TestingOutputs& testing_outputs = testing_outputs_cache.testing_outputs;
+
+         if(data_set_pointer->is_out_of_core())
+         {
+            calculate_testing_outputs_by_batches(testing_outputs.output_data, testing_outputs.target_data);
+         }
+         else
+         {
+            const Matrix<double>& testing_input_data = data_set_pointer->get_testing_input_data();
+
+            testing_outputs.target_data = data_set_pointer->get_testing_target_data();
+            testing_outputs.output_data = neural_network_pointer->calculate_output_data(testing_input_data);
+         }
+
+         if(testing_outputs.output_data.get_columns_number() != 0)
+         {
+            testing_outputs.sorted_indices = testing_outputs.output_data.arrange_column(0).sort_less_indices();
+         }
+         else
+         {
+            testing_outputs.sorted_indices.clear();
+         }
+
+         testing_outputs_cache.evaluation_state = evaluation_state;
+         testing_outputs_cache.calculated = true;
+      }
+   }
+
+   return(testing_outputs_cache.testing_outputs);
+}
+
+
+// void calculate_testing_outputs_by_batches(Matrix<double>&, Matrix<double>&) const method
+
+/// Calculates the outputs of the neural network and the targets on the testing instances,
+/// reading the testing inputs from the data set by blocks of instances.
+/// In this way only the outputs and the targets of the testing instances are held in memory.
+/// @param output_data Matrix of outputs. Each row corresponds to one testing instance.
+/// @param target_data Matrix of targets. Each row corresponds to one testing instance.
+
+void TestingAnalysis::calculate_testing_outputs_by_batches(Matrix<double>& output_data, Matrix<double>& target_data) const
+{
+   const Vector<size_t> testing_indices = data_set_pointer->get_instances().arrange_testing_indices();
+
+   const size_t testing_instances_number = testing_indices.size();
+
+   const Variables& variables = data_set_pointer->get_variables();
+
+   const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
+   const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+
+   const size_t outputs_number = neural_network_pointer->get_outputs_number();
+   const size_t targets_number = targets_indices.size();
+
+   const size_t batch_size = 256;
+
+   output_data.set(testing_instances_number, outputs_number);
+   target_data.set(testing_instances_number, targets_number);
+
+   Matrix<double> batch_inputs;
+   Matrix<double> batch_targets;
+
+   for(size_t first_index = 0; first_index < testing_instances_number; first_index += batch_size)
+   {
+      const size_t batch_instances_number = std::min(batch_size, testing_instances_number - first_index);
+
+      data_set_pointer->arrange_instances_data(testing_indices, first_index, batch_instances_number, inputs_indices, batch_inputs);
+      data_set_pointer->arrange_instances_data(testing_indices, first_index, batch_instances_number, targets_indices, batch_targets);
+
+      const Matrix<double> batch_outputs = neural_network_pointer->calculate_output_data(batch_inputs);
+
+      for(size_t i = 0; i < batch_instances_number; i++)
+      {
+         for(size_t j = 0; j < outputs_number; j++)
+         {
+            output_data(first_index+i,j) = batch_outputs(i,j);
+         }
+
+         for(size_t j = 0; j < targets_number; j++)
+         {
+            target_data(first_index+i,j) = batch_targets(i,j);
+         }
+      }
+   }
+}
+
+
+// EvaluationState get_evaluation_state(void) const method
+
+/// Returns the current state of the neural network and the data set associated to this testing analysis.
+/// The testing outputs are valid while this state does not change.
+/// The layers of the neural network are described by their string representations,
+/// and the multilayer perceptron by its architecture and activation functions.
+
+TestingAnalysis::EvaluationState TestingAnalysis::get_evaluation_state(void) const
+{
+   EvaluationState evaluation_state;
+
+   evaluation_state.neural_network_pointer = neural_network_pointer;
+   evaluation_state.data_set_pointer = data_set_pointer;
+
+   if(neural_network_pointer)
+   {
+      evaluation_state.parameters = neural_network_pointer->arrange_parameters();
+
+      std::ostringstream buffer;
+
+      if(neural_network_pointer->has_scaling_layer())
+      {
+         buffer << neural_network_pointer->get_scaling_layer_pointer()->to_string();
+      }
+
+      if(neural_network_pointer->has_principal_components_layer())
+      {
+         tinyxml2::XMLPrinter printer;
+
+         neural_network_pointer->get_principal_components_layer_pointer()->write_XML(printer);
+
+         buffer << printer.CStr();
+      }
+
+      if(neural_network_pointer->has_multilayer_perceptron())
+      {
+         const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
+
+         buffer << multilayer_perceptron_pointer->arrange_architecture() << "\n"
+                << multilayer_perceptron_pointer->write_layers_activation_function() << "\n";
+      }
+
+      if(neural_network_pointer->has_conditions_layer())
+      {
+         buffer << neural_network_pointer->get_conditions_layer_pointer()->to_string();
+      }
+
+      if(neural_network_pointer->has_unscaling_layer())
+      {
+         buffer << neural_network_pointer->get_unscaling_layer_pointer()->to_string();
+      }
+
+      if(neural_network_pointer->has_bounding_layer())
+      {
+         buffer << neural_network_pointer->get_bounding_layer_pointer()->to_string();
+      }
+
+      if(neural_network_pointer->has_probabilistic_layer())
+      {
+         buffer << neural_network_pointer->get_probabilistic_layer_pointer()->to_string();
+      }
+
+      evaluation_state.layers_description = buffer.str();
+   }
+
+   if(data_set_pointer)
+   {
+      evaluation_state.instances_version = data_set_pointer->get_instances().get_version();
+      evaluation_state.variables_version = data_set_pointer->get_variables().get_version();
+      evaluation_state.data_version = data_set_pointer->get_data_version();
+   }
+
+   return(evaluation_state);
+}
+
+
 // Vector< Matrix<double> > calculate_target_output_data(void) const method
 
 /// Returns a vector of matrices with number of rows equal to number of testing instances and
@@ -378,17 +567,16 @@ Vector< Matrix<double> > TestingAnalysis::calculate_target_output_data(void) con
 
    const size_t testing_instances_number = instances.count_testing_instances_number();
 
-   const Matrix<double> testing_input_data = data_set_pointer->arrange_testing_input_data();
-
-   const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
-
    // Neural network stuff
 
    const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
 
-   const Matrix<double> output_data = neural_network_pointer->calculate_output_data(testing_input_data);
+   const TestingOutputs& testing_outputs = get_testing_outputs();
+
+   const Matrix<double>& target_data = testing_outputs.target_data;
+   const Matrix<double>& output_data = testing_outputs.output_data;
 
    // Approximation testing stuff
 
@@ -455,9 +643,10 @@ Vector< LinearRegressionParameters<double> > TestingAnalysis::calculate_linear_r
 
    // Calculate regression parameters
 
-   const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-   const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
-   const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+   const TestingOutputs& testing_outputs = get_testing_outputs();
+
+   const Matrix<double>& target_data = testing_outputs.target_data;
+   const Matrix<double>& output_data = testing_outputs.output_data;
 
    Vector<double> target_variable(testing_instances_number);
    Vector<double> output_variable(testing_instances_number);
@@ -570,13 +759,13 @@ Vector< Matrix<double> > TestingAnalysis::calculate_error_data(void) const
     #endif
 
 
-   const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
+   const TestingOutputs& testing_outputs = get_testing_outputs();
 
-   const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+   const Matrix<double>& target_data = testing_outputs.target_data;
 
    // Neural network stuff
 
-   const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+   const Matrix<double>& output_data = testing_outputs.output_data;
 
    const UnscalingLayer* unscaling_layer_pointer = neural_network_pointer->get_unscaling_layer_pointer();
 
@@ -777,13 +966,13 @@ Vector<double> TestingAnalysis::calculate_testing_errors(void) const
 
      #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const Matrix<double>& target_data = testing_outputs.target_data;
 
     // Neural network stuff
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
     #ifdef __OPENNN_DEBUG__   
 
@@ -850,13 +1039,13 @@ Vector<double> TestingAnalysis::calculate_classification_testing_errors(void) co
 
      #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const Matrix<double>& target_data = testing_outputs.target_data;
 
     // Neural network stuff
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
     Vector<double> errors(5,0.0);
 
@@ -1205,10 +1394,10 @@ Matrix<size_t> TestingAnalysis::calculate_confusion(void) const
 
    #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();    
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& target_data = testing_outputs.target_data;
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
 //    output_data.save("../data/output_data.dat");
 
@@ -1303,15 +1492,23 @@ TestingAnalysis::RocAnalysisResults TestingAnalysis::perform_roc_analysis (void)
 
     #endif
 
-     const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-     const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+     const TestingOutputs& testing_outputs = get_testing_outputs();
+
+     const Matrix<double>& target_data = testing_outputs.target_data;
+     const Matrix<double>& output_data = testing_outputs.output_data;
 
-     const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+     RocCurve<double> roc_curve;
+
+     roc_curve.set(output_data.arrange_column(0), target_data.arrange_column(0), testing_outputs.sorted_indices);
+
+     const size_t maximum_points_number = 1000;
 
      RocAnalysisResults roc_analysis_results;
 
-     roc_analysis_results.roc_curve = calculate_roc_curve(target_data, output_data);
-     roc_analysis_results.area_under_curve = calculate_area_under_curve(target_data, output_data);
+     // The area is calculated first, since it checks that there are positive and negative instances
+
+     roc_analysis_results.area_under_curve = roc_curve.calculate_area_under_curve();
+     roc_analysis_results.roc_curve = roc_curve.calculate_points(maximum_points_number);
      roc_analysis_results.optimal_threshold = calculate_optimal_threshold(target_data, output_data, roc_analysis_results.roc_curve);
 
      return(roc_analysis_results);
@@ -1346,17 +1543,18 @@ double TestingAnalysis::calculate_Wilcoxon_parameter (const double& x, const dou
 
 /// Returns a matrix with the values of a ROC curve for a binary classification problem.
 /// The number of columns is three. The third column contains the decision threshold.
-/// The number of rows is one more than the number of outputs if the number of outputs is lower than 100
-/// or 50 in other case.
+/// The number of rows is one more than the number of outputs if the number of outputs is lower than 1000
+/// or about 1000 in other case.
+/// The outputs are sorted once, and all the points are obtained in a single sweep.
 /// @param target_data Testing target data.
 /// @param output_data Testing output data.
 
 Matrix<double> TestingAnalysis::calculate_roc_curve(const Matrix<double>& target_data, const Matrix<double>& output_data) const
 {
-    const Vector<size_t> positives_negatives_rate = calculate_positives_negatives_rate(target_data, output_data);
+    const RocCurve<double> roc_curve(output_data.arrange_column(0), target_data.arrange_column(0));
 
-    const size_t total_positives = positives_negatives_rate[0];
-    const size_t total_negatives = positives_negatives_rate[1];
+    const size_t total_positives = roc_curve.get_positives_number();
+    const size_t total_negatives = roc_curve.get_negatives_number();
 
     if(total_positives == 0)
     {
@@ -1382,101 +1580,31 @@ Matrix<double> TestingAnalysis::calculate_roc_curve(const Matrix<double>& target
 
     const size_t maximum_points_number = 1000;
 
-    size_t step_size;
-
-    const size_t testing_instances_number = target_data.get_rows_number();
-    size_t points_number;
-
-    if(testing_instances_number > maximum_points_number)
-    {
-        step_size = (size_t)((double)testing_instances_number/(double)maximum_points_number);
-        points_number = (size_t)((double)testing_instances_number/(double)step_size);
-    }
-    else
-    {
-        points_number = testing_instances_number;
-        step_size = 1;
-    }
-
-    Matrix<double> target_output_data = output_data.assemble_columns(target_data);
-
-    Matrix<double> sorted_target_output_data = target_output_data.sort_less_rows(0);
-
-    const Vector<size_t> columns_output_indices(1,0);
-    const Vector<size_t> columns_target_indices(1,1);
-
-    const Matrix<double> sorted_target_data = sorted_target_output_data.arrange_submatrix_columns(columns_target_indices);
-    const Matrix<double> sorted_output_data = sorted_target_output_data.arrange_submatrix_columns(columns_output_indices);
-
-    Matrix<double> roc_curve(points_number+1, 3, 0.0);
-
-    double threshold = 0;
-
-    size_t positives;
-    size_t negatives;
-
-    size_t current_index;
-
-    int j = 0;
-    int i = 0;
-
-    const size_t step_s = step_size;
-
-#pragma omp parallel for private(i, j, positives, negatives, threshold, current_index) schedule(dynamic)
-
-    for(i = 0; i < (int)points_number; i++)
-    {
-        positives = 0;
-        negatives = 0;
-
-        current_index = i*step_s;
-
-        threshold = sorted_output_data(current_index, 0);
-
-        for(j = 0; j < (int)current_index; j++)
-        {
-             if(sorted_output_data(j,0) < threshold && sorted_target_data(j,0) == 1.0)
-             {
-                 positives++;
-             }
-             if(sorted_output_data(j,0) < threshold && sorted_target_data(j,0) == 0.0)
-             {
-                 negatives++;
-             }
-        }
-
-        roc_curve(i,0) = (double)positives/(double)(total_positives);
-        roc_curve(i,1) = (double)negatives/(double)(total_negatives);
-        roc_curve(i,2) = (double)threshold;
-    }
-
-    roc_curve(points_number, 0) = 1.0;
-    roc_curve(points_number, 1) = 1.0;
-    roc_curve(points_number, 2) = 1.0;
-
-    return (roc_curve);
+    return(roc_curve.calculate_points(maximum_points_number));
 }
 
 
 // double calculate_area_under_curve(const Matrix<double>& , const Matrix<double>& ) const
 
 /// Returns the area under a ROC curve.
+/// It is the mean of the Wilcoxon parameters of all the pairs of positive and negative instances,
+/// which is computed from the ranks of the positive outputs (Mann-Whitney statistic) in O(n log n) time.
 /// @param target_data Testing target data.
 /// @param output_data Testing output data.
 
 double TestingAnalysis::calculate_area_under_curve (const Matrix<double>& target_data, const Matrix<double>& output_data) const
 {
-    const Vector<size_t> positives_negatives_rate = calculate_positives_negatives_rate(target_data, output_data);
+    const RocCurve<double> roc_curve(output_data.arrange_column(0), target_data.arrange_column(0));
 
-    const size_t total_positives = positives_negatives_rate[0];
-    const size_t total_negatives = positives_negatives_rate[1];
+    const size_t total_positives = roc_curve.get_positives_number();
+    const size_t total_negatives = roc_curve.get_negatives_number();
 
     if(total_positives == 0)
     {
         std::ostringstream buffer;
 
         buffer << "OpenNN Exception: TestingAnalysis class.\n"
-               << "Matrix<double> calculate_roc_curve(const Matrix<double>&, const Matrix<double>&) const.\n"
+               << "double calculate_area_under_curve(const Matrix<double>&, const Matrix<double>&) const.\n"
                << "Number of positive instances ("<< total_positives <<") must be greater than zero.\n";
 
         throw std::logic_error(buffer.str());
@@ -1487,39 +1615,13 @@ double TestingAnalysis::calculate_area_under_curve (const Matrix<double>& target
         std::ostringstream buffer;
 
         buffer << "OpenNN Exception: TestingAnalysis class.\n"
-               << "Matrix<double> calculate_roc_curve(const Matrix<double>&, const Matrix<double>&) const.\n"
+               << "double calculate_area_under_curve(const Matrix<double>&, const Matrix<double>&) const.\n"
                << "Number of negative instances ("<< total_negatives <<") must be greater than zero.\n";
 
         throw std::logic_error(buffer.str());
      }
 
-    size_t testing_instances_number = target_data.get_rows_number();
-
-    double sum = 0.0;
-
-    double area_under_curve;
-
-    int i,j;
-
-#pragma omp parallel for private(i, j) reduction(+ : sum) schedule(dynamic)
-
-    for(i = 0; i < testing_instances_number; i++)
-    {
-        if(target_data(i,0) == 1)
-        {
-            for(j = 0; j < testing_instances_number; j++)
-            {
-                if(target_data(j,0) == 0)
-                {
-                   sum += calculate_Wilcoxon_parameter(output_data(i,0),output_data(j,0));
-                }
-            }
-        }
-    }
-
-    area_under_curve = (double)sum/(double)(total_positives*total_negatives);
-
-    return (area_under_curve);
+    return(roc_curve.calculate_area_under_curve());
 }
 
 
@@ -1531,109 +1633,32 @@ double TestingAnalysis::calculate_area_under_curve (const Matrix<double>& target
 
 double TestingAnalysis::calculate_optimal_threshold (const Matrix<double>& target_data, const Matrix<double>& output_data ) const
 {
-    const size_t rows_number = target_data.get_rows_number();
-    const size_t columns_number = target_data.get_columns_number();
-
-    const size_t maximum_points_number = 1000;
-
-    size_t step_size;
-    size_t points_number;
+    const Matrix<double> roc_curve = calculate_roc_curve(target_data, output_data);
 
-    if(rows_number > maximum_points_number)
-    {
-        step_size = rows_number/maximum_points_number;
-        points_number = rows_number/step_size;
-    }
-    else
-    {
-        points_number = rows_number;
-        step_size = 1;
-    }
-
-    Matrix<double> target_output_data = output_data.assemble_columns(target_data);
-
-    Matrix<double> sorted_target_output_data = target_output_data.sort_less_rows(0);
-
-    const Vector<size_t> columns_output_indices(0, 1, columns_number - 1);
-    const Vector<size_t> columns_target_indices(columns_number, 1, 2*columns_number - 1);
-
-    const Matrix<double> sorted_target_data = sorted_target_output_data.arrange_submatrix_columns(columns_target_indices);
-    const Matrix<double> sorted_output_data = sorted_target_output_data.arrange_submatrix_columns(columns_output_indices);
-
-    const Matrix<double> roc_curve = calculate_roc_curve(sorted_target_data, sorted_output_data);
-
-    double threshold = 0.0;
-    double optimal_threshold = 0.5;
-
-    double minimun_distance = std::numeric_limits<double>::max();
-    double distance;
-
-    size_t current_index;
-
-    for(size_t i = 0; i < points_number; i++)
-    {
-        current_index = i*step_size;
-
-        threshold = sorted_output_data(current_index, 0);
-
-        distance = sqrt(roc_curve(i,0)*roc_curve(i,0) + (roc_curve(i,1) - 1.0)*(roc_curve(i,1) - 1.0));
-
-        if(distance < minimun_distance)
-        {
-            optimal_threshold = threshold;
-
-            minimun_distance = distance;
-        }
-    }
-
-    return (optimal_threshold);
+    return(calculate_optimal_threshold(target_data, output_data, roc_curve));
 }
 
 // double calculate_optimal_threshold (const Matrix<double>& , const Matrix<double>&, const Matrix<double>&) const
 
 /// Returns the point of optimal classification accuracy, which is the nearest ROC curve point to the upper left corner (0,1).
-/// @param target_data Testing target data.
-/// @param output_data Testing output data.
+/// The thresholds are taken from the third column of the ROC curve.
 /// @param roc_curve ROC curve.
 
-double TestingAnalysis::calculate_optimal_threshold (const Matrix<double>& target_data, const Matrix<double>& output_data, const Matrix<double>& roc_curve) const
+double TestingAnalysis::calculate_optimal_threshold (const Matrix<double>&, const Matrix<double>&, const Matrix<double>& roc_curve) const
 {
-    const size_t rows_number = target_data.get_rows_number();
-    const size_t columns_number = target_data.get_columns_number();
-
-    size_t step_size;
     const size_t points_number = roc_curve.get_rows_number();
 
-    if(rows_number > points_number)
-    {
-        step_size = rows_number/points_number;
-    }
-    else
-    {
-        step_size = 1;
-    }
-
-    Matrix<double> target_output_data = output_data.assemble_columns(target_data);
-
-    Matrix<double> sorted_target_output_data = target_output_data.sort_less_rows(0);
-
-    const Vector<size_t> columns_output_indices(0, 1, columns_number - 1);
-
-    const Matrix<double> sorted_output_data = sorted_target_output_data.arrange_submatrix_columns(columns_output_indices);
-
     double threshold = 0.0;
     double optimal_threshold = 0.5;
 
     double minimun_distance = std::numeric_limits<double>::max();
     double distance;
 
-    size_t current_index;
+    // The last point of the curve is the corner (1,1), which does not correspond to any output
 
-    for(size_t i = 0; i < points_number; i++)
+    for(size_t i = 0; i + 1 < points_number; i++)
     {
-        current_index = i*step_size;
-
-        threshold = sorted_output_data(current_index, 0);
+        threshold = roc_curve(i,2);
 
         distance = sqrt(roc_curve(i,0)*roc_curve(i,0) + (roc_curve(i,1) - 1.0)*(roc_curve(i,1) - 1.0));
 
@@ -1712,12 +1737,11 @@ Matrix<double> TestingAnalysis::perform_cumulative_gain_analysis(void) const
 
     #endif
 
-     const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-     const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+     const TestingOutputs& testing_outputs = get_testing_outputs();
 
-     const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+     const Matrix<double>& target_data = testing_outputs.target_data;
 
-     const Matrix<double> cumulative_gain = calculate_cumulative_gain(target_data, output_data);
+     const Matrix<double> cumulative_gain = calculate_cumulative_gain(target_data, testing_outputs.sorted_indices, 1.0);
 
      return(cumulative_gain);
 }
@@ -1726,114 +1750,79 @@ Matrix<double> TestingAnalysis::perform_cumulative_gain_analysis(void) const
 // Matrix<double> calculate_cumulative_gain(const Matrix<double>& , const Matrix<double>&) const
 
 /// Returns a matrix with the values of a cumulative gain chart.
-/// The number of columns is two, the number of rows is 20.
+/// The number of columns is two, the number of rows is 21.
 /// @param target_data Testing target data.
 /// @param output_data Testing output data.
 
 Matrix<double> TestingAnalysis::calculate_cumulative_gain(const Matrix<double>& target_data, const Matrix<double>& output_data) const
 {
-    const size_t total_positives = calculate_positives_negatives_rate(target_data, output_data)[0];
+    const Vector<size_t> sorted_indices = output_data.arrange_column(0).sort_less_indices();
 
-    if(total_positives == 0)
-    {
-        std::ostringstream buffer;
-
-        buffer << "OpenNN Exception: TestingAnalysis class.\n"
-               << "Matrix<double> calculate_cumulative_gain(const Matrix<double>&, const Matrix<double>&) const.\n"
-               << "Number of positive instances (" << total_positives << ") must be greater than zero.\n";
-
-        throw std::logic_error(buffer.str());
-     }
-
-    const size_t rows_number = target_data.get_rows_number();
+    return(calculate_cumulative_gain(target_data, sorted_indices, 1.0));
+}
 
-    const Matrix<double> target_output_data = output_data.assemble_columns(target_data);
 
-    const Matrix<double> sorted_target_output_data = target_output_data.sort_greater_rows(0);
+// Matrix<double> calculate_negative_cumulative_gain(const Matrix<double>& , const Matrix<double>&) const
 
-    const Vector<size_t> target_indices(1,1);
+/// Returns a matrix with the values of a cumulative gain chart for the negative instances.
+/// The number of columns is two, the number of rows is 21.
+/// @param target_data Testing target data.
+/// @param output_data Testing output data.
 
-    const Matrix<double> sorted_target_data = sorted_target_output_data.arrange_submatrix_columns(target_indices);
+Matrix<double> TestingAnalysis::calculate_negative_cumulative_gain(const Matrix<double>& target_data, const Matrix<double>& output_data) const
+{
+    const Vector<size_t> sorted_indices = output_data.arrange_column(0).sort_less_indices();
 
-    const size_t points_number = 21;
-    const double percentage_increment = 0.05;
+    return(calculate_cumulative_gain(target_data, sorted_indices, 0.0));
+}
 
-    Matrix<double> cumulative_gain(points_number, 2);
 
-    cumulative_gain(0,0) = 0.0;
-    cumulative_gain(0,1) = 0.0;
+// Matrix<double> calculate_cumulative_gain(const Matrix<double>&, const Vector<size_t>&, const double&) const
 
-    size_t positives = 0;
-    size_t negatives = 0;
+/// Returns a matrix with the values of a cumulative gain chart for the instances with a given target.
+/// The instances are visited once, in descending order of their first output,
+/// and the number of instances with that target is accumulated from one point of the chart to the next.
+/// The number of columns is two, the number of rows is 21.
+/// @param target_data Testing target data.
+/// @param sorted_indices Rows of the testing instances in ascending order of their first output.
+/// @param target_value Target of the instances to be counted, one for the positives and zero for the negatives.
 
-    double percentage = 0.0;
+Matrix<double> TestingAnalysis::calculate_cumulative_gain(const Matrix<double>& target_data, const Vector<size_t>& sorted_indices, const double& target_value) const
+{
+    const size_t rows_number = target_data.get_rows_number();
 
-    size_t maximum_index;
+    size_t total_instances = 0;
 
-    for(size_t i = 0; i < points_number - 1; i++)
+    for(size_t i = 0; i < rows_number; i++)
     {
-        percentage += percentage_increment;
-        positives = 0;
-        negatives = 0;
-        maximum_index = (size_t)(percentage*rows_number);
-
-        for(size_t j = 0; j < maximum_index; j++)
+        if(target_data(i, 0) == target_value)
         {
-            if(sorted_target_data(j, 0) == 1.0)
-            {
-                 positives++;
-            }
+            total_instances++;
         }
-
-        cumulative_gain(i + 1, 0) = (double) percentage;
-        cumulative_gain(i + 1, 1) = (double) positives/(double)(total_positives);
     }
 
-    return(cumulative_gain);
-}
-
-
-// Matrix<double> calculate_cumulative_gain(const Matrix<double>& , const Matrix<double>&) const
-
-/// Returns a matrix with the values of a cumulative gain chart for the negative instances.
-/// The number of columns is two, the number of rows is 20.
-/// @param target_data Testing target data.
-/// @param output_data Testing output data.
-
-Matrix<double> TestingAnalysis::calculate_negative_cumulative_gain(const Matrix<double>& target_data, const Matrix<double>& output_data) const
-{
-    const size_t total_negatives = calculate_positives_negatives_rate(target_data, output_data)[1];
-
-    if(total_negatives == 0)
+    if(total_instances == 0)
     {
         std::ostringstream buffer;
 
         buffer << "OpenNN Exception: TestingAnalysis class.\n"
-               << "Matrix<double> calculate_negative_cumulative_gain(const Matrix<double>&, const Matrix<double>&) const.\n"
-               << "Number of negative instances (" << total_negatives << ") must be greater than zero.\n";
+               << "Matrix<double> calculate_cumulative_gain(const Matrix<double>&, const Vector<size_t>&, const double&) const.\n"
+               << "Number of instances with target " << target_value << " (" << total_instances << ") must be greater than zero.\n";
 
         throw std::logic_error(buffer.str());
      }
 
-    const size_t rows_number = target_data.get_rows_number();
-
-    const Matrix<double> target_output_data = output_data.assemble_columns(target_data);
-
-    const Matrix<double> sorted_target_output_data = target_output_data.sort_greater_rows(0);
-
-    const Vector<size_t> target_indices(1,1);
-
-    const Matrix<double> sorted_target_data = sorted_target_output_data.arrange_submatrix_columns(target_indices);
-
     const size_t points_number = 21;
     const double percentage_increment = 0.05;
 
-    Matrix<double> negative_cumulative_gain(points_number, 2);
+    Matrix<double> cumulative_gain(points_number, 2);
+
+    cumulative_gain(0,0) = 0.0;
+    cumulative_gain(0,1) = 0.0;
 
-    negative_cumulative_gain(0,0) = 0.0;
-    negative_cumulative_gain(0,1) = 0.0;
+    size_t instances = 0;
 
-    size_t negatives = 0;
+    size_t visited_instances = 0;
 
     double percentage = 0.0;
 
@@ -1842,22 +1831,21 @@ Matrix<double> TestingAnalysis::calculate_negative_cumulative_gain(const Matrix<
     for(size_t i = 0; i < points_number - 1; i++)
     {
         percentage += percentage_increment;
-        negatives = 0;
         maximum_index = (size_t)(percentage*rows_number);
 
-        for(size_t j = 0; j < maximum_index; j++)
+        for(; visited_instances < maximum_index && visited_instances < rows_number; visited_instances++)
         {
-            if(sorted_target_data(j, 0) == 0.0)
+            if(target_data(sorted_indices[rows_number - 1 - visited_instances], 0) == target_value)
             {
-                 negatives++;
+                 instances++;
             }
         }
 
-        negative_cumulative_gain(i + 1, 0) = (double) percentage;
-        negative_cumulative_gain(i + 1, 1) = (double) negatives/(double)(total_negatives);
+        cumulative_gain(i + 1, 0) = (double) percentage;
+        cumulative_gain(i + 1, 1) = (double) instances/(double)(total_instances);
     }
 
-    return(negative_cumulative_gain);
+    return(cumulative_gain);
 }
 
 
@@ -1925,12 +1913,11 @@ Matrix<double> TestingAnalysis::perform_lift_chart_analysis(void) const
 
     #endif
 
-     const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-     const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+     const TestingOutputs& testing_outputs = get_testing_outputs();
 
-     const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+     const Matrix<double>& target_data = testing_outputs.target_data;
 
-     const Matrix<double> cumulative_gain = calculate_cumulative_gain(target_data, output_data);
+     const Matrix<double> cumulative_gain = calculate_cumulative_gain(target_data, testing_outputs.sorted_indices, 1.0);
      const Matrix<double> lift_chart = calculate_lift_chart(cumulative_gain);
 
      return(lift_chart);
@@ -2034,15 +2021,14 @@ TestingAnalysis::KolmogorovSmirnovResults TestingAnalysis::perform_Kolmogorov_Sm
 
     #endif
 
-     const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-     const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+     const TestingOutputs& testing_outputs = get_testing_outputs();
 
-     const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+     const Matrix<double>& target_data = testing_outputs.target_data;
 
      TestingAnalysis::KolmogorovSmirnovResults Kolmogorov_Smirnov_results;
 
-     Kolmogorov_Smirnov_results.positive_cumulative_gain = calculate_cumulative_gain(target_data, output_data);
-     Kolmogorov_Smirnov_results.negative_cumulative_gain = calculate_negative_cumulative_gain(target_data, output_data);
+     Kolmogorov_Smirnov_results.positive_cumulative_gain = calculate_cumulative_gain(target_data, testing_outputs.sorted_indices, 1.0);
+     Kolmogorov_Smirnov_results.negative_cumulative_gain = calculate_cumulative_gain(target_data, testing_outputs.sorted_indices, 0.0);
      Kolmogorov_Smirnov_results.maximum_gain =
      calculate_maximum_gain(Kolmogorov_Smirnov_results.positive_cumulative_gain,Kolmogorov_Smirnov_results.negative_cumulative_gain);
 
@@ -2161,10 +2147,10 @@ Matrix<double> TestingAnalysis::perform_calibration_plot_analysis(void) const
 
     #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& target_data = testing_outputs.target_data;
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
     const Matrix<double> calibration_plot = calculate_calibration_plot(target_data, output_data);
 
@@ -2353,10 +2339,10 @@ TestingAnalysis::BinaryClassifcationRates TestingAnalysis::calculate_binary_clas
 
     #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& target_data = testing_outputs.target_data;
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
     const Vector<size_t> testing_indices = data_set_pointer->get_instances().arrange_testing_indices();
 
@@ -2553,10 +2539,10 @@ Matrix< Vector<size_t> > TestingAnalysis::calculate_multiple_classification_rate
 
     #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& target_data = testing_outputs.target_data;
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
     const Vector<size_t> testing_indices = data_set_pointer->get_instances().arrange_testing_indices();
 
@@ -2659,10 +2645,10 @@ Vector< Vector<double> > TestingAnalysis::calculate_error_autocorrelation(const
 
     #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& target_data = testing_outputs.target_data;
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
     const size_t targets_number = target_data.get_columns_number();
 
@@ -2746,10 +2732,12 @@ Vector< Vector<double> > TestingAnalysis::calculate_input_error_cross_correlatio
 
     #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
+
+    const Matrix<double>& target_data = testing_outputs.target_data;
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& input_data = data_set_pointer->get_testing_input_data();
 
     const size_t targets_number = target_data.get_columns_number();
 
@@ -3145,10 +3133,10 @@ double TestingAnalysis::calculate_logloss(void) const
 
     #endif
 
-    const Matrix<double> input_data = data_set_pointer->arrange_testing_input_data();
-    const Matrix<double> target_data = data_set_pointer->arrange_testing_target_data();
+    const TestingOutputs& testing_outputs = get_testing_outputs();
 
-    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+    const Matrix<double>& target_data = testing_outputs.target_data;
+    const Matrix<double>& output_data = testing_outputs.output_data;
 
     const size_t testing_instances_number = target_data.get_rows_number();
 
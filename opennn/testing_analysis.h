@@ -16,6 +16,7 @@
 
 // System includes
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -26,6 +27,7 @@
 
 #include "vector.h"
 #include "matrix.h"
+#include "roc_curve.h"
 
 #include "data_set.h"
 #include "mathematical_model.h"
@@ -165,6 +167,25 @@ public:
         Vector<size_t> true_negative_instances;
     };
 
+    ///
+    /// Structure with the targets and the outputs of the testing instances, from which the testing reports are obtained.
+    ///
+
+    struct TestingOutputs
+    {
+        /// Target data of the testing instances.
+
+        Matrix<double> target_data;
+
+        /// Output data of the neural network for the testing instances.
+
+        Matrix<double> output_data;
+
+        /// Rows of the testing instances sorted by their first output, in ascending order.
+
+        Vector<size_t> sorted_indices;
+    };
+
 
    // METHODS
 
@@ -192,6 +213,8 @@ public:
 
    // Target and output data methods
 
+   const TestingOutputs& get_testing_outputs(void) const;
+
    Vector< Matrix<double> > calculate_target_output_data(void) const;
 
    // Error data methods
@@ -304,6 +327,104 @@ public:
 
 private: 
 
+   // STRUCTURES
+
+   ///
+   /// This structure identifies the state of the neural network and the data set from which the testing outputs were calculated.
+   /// The outputs are out of date if the parameters or the layers of the neural network,
+   /// or the instances, the variables or the data of the data set have changed since then.
+   ///
+
+   struct EvaluationState
+   {
+      /// Default constructor.
+
+      EvaluationState(void)
+      {
+         neural_network_pointer = NULL;
+         data_set_pointer = NULL;
+
+         instances_version = 0;
+         variables_version = 0;
+         data_version = 0;
+      }
+
+      /// Returns true if this state is equal to another state.
+      /// @param other_state Other state to be compared with.
+
+      bool operator == (const EvaluationState& other_state) const
+      {
+         return(neural_network_pointer == other_state.neural_network_pointer
+             && parameters == other_state.parameters
+             && layers_description == other_state.layers_description
+             && data_set_pointer == other_state.data_set_pointer
+             && instances_version == other_state.instances_version
+             && variables_version == other_state.variables_version
+             && data_version == other_state.data_version);
+      }
+
+      /// Pointer to the neural network.
+
+      const NeuralNetwork* neural_network_pointer;
+
+      /// Parameters of the neural network.
+
+      Vector<double> parameters;
+
+      /// Description of the layers of the neural network, other than its parameters.
+
+      std::string layers_description;
+
+      /// Pointer to the data set.
+
+      const DataSet* data_set_pointer;
+
+      /// Version of the instances object.
+
+      size_t instances_version;
+
+      /// Version of the variables object.
+
+      size_t variables_version;
+
+      /// Version of the data matrix.
+
+      size_t data_version;
+   };
+
+   ///
+   /// Testing outputs computed on demand, which are kept until the neural network or the data set change.
+   ///
+
+   struct TestingOutputsCache
+   {
+      /// Default constructor.
+
+      TestingOutputsCache(void) : calculated(false)
+      {
+      }
+
+      /// True if the testing outputs have been calculated.
+
+      bool calculated;
+
+      /// State of the neural network and the data set when the testing outputs were calculated.
+
+      EvaluationState evaluation_state;
+
+      /// Targets, outputs and sorted order of the testing instances.
+
+      TestingOutputs testing_outputs;
+   };
+
+   // METHODS
+
+   EvaluationState get_evaluation_state(void) const;
+
+   void calculate_testing_outputs_by_batches(Matrix<double>&, Matrix<double>&) const;
+
+   Matrix<double> calculate_cumulative_gain(const Matrix<double>&, const Vector<size_t>&, const double&) const;
+
    // MEMBERS
 
    /// Pointer to the neural network object to be tested. 
@@ -321,6 +442,10 @@ private:
    /// Display messages to screen.
    
    bool display;
+
+   /// Testing outputs shared by all the testing reports.
+
+   mutable TestingOutputsCache testing_outputs_cache;
 };
 
 }
@@ -351,6 +351,94 @@ Matrix<size_t> ThresholdSelectionAlgorithm::calculate_confusion(const double& de
      return(confusion);
 }
 
+// RocCurve<double> calculate_selection_roc_curve(void) const method
+
+/// Returns the ROC curve of the neural network on the selection instances of the data set.
+/// The outputs are calculated once and sorted once, and then the confusion matrix of any decision threshold
+/// is obtained without visiting the instances again.
+/// If the data set is out of core, the selection inputs are read by blocks of instances,
+/// so that only the first output and the first target of each selection instance are held in memory.
+
+RocCurve<double> ThresholdSelectionAlgorithm::calculate_selection_roc_curve(void) const
+{
+    #ifdef __OPENNN_DEBUG__
+
+    check();
+
+    #endif
+
+    const LossIndex* loss_index_pointer = training_strategy_pointer->get_loss_index_pointer();
+
+    const DataSet* data_set_pointer = loss_index_pointer->get_data_set_pointer();
+
+    const NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+    if(data_set_pointer->is_out_of_core())
+    {
+        const Vector<size_t> selection_indices = data_set_pointer->get_instances().arrange_selection_indices();
+
+        const size_t selection_instances_number = selection_indices.size();
+
+        const Variables& variables = data_set_pointer->get_variables();
+
+        const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
+        const Vector<size_t> target_index(1, variables.arrange_targets_indices()[0]);
+
+        const size_t batch_size = 256;
+
+        Vector<double> outputs(selection_instances_number);
+        Vector<double> targets(selection_instances_number);
+
+        Matrix<double> batch_inputs;
+        Matrix<double> batch_targets;
+
+        for(size_t first_index = 0; first_index < selection_instances_number; first_index += batch_size)
+        {
+            const size_t batch_instances_number = std::min(batch_size, selection_instances_number - first_index);
+
+            data_set_pointer->arrange_instances_data(selection_indices, first_index, batch_instances_number, inputs_indices, batch_inputs);
+            data_set_pointer->arrange_instances_data(selection_indices, first_index, batch_instances_number, target_index, batch_targets);
+
+            const Matrix<double> batch_outputs = neural_network_pointer->calculate_output_data(batch_inputs);
+
+            for(size_t i = 0; i < batch_instances_number; i++)
+            {
+                outputs[first_index+i] = batch_outputs(i,0);
+                targets[first_index+i] = batch_targets(i,0);
+            }
+        }
+
+        return(RocCurve<double>(outputs, targets));
+    }
+
+    const Matrix<double>& input_data = data_set_pointer->get_selection_input_data();
+    const Matrix<double>& target_data = data_set_pointer->get_selection_target_data();
+
+    const Matrix<double> output_data = neural_network_pointer->calculate_output_data(input_data);
+
+    return(RocCurve<double>(output_data.arrange_column(0), target_data.arrange_column(0)));
+}
+
+
+// size_t calculate_history_period(const size_t&) const method
+
+/// Returns the number of iterations between two consecutive entries of the threshold selection history.
+/// It keeps the history within a thousand entries whatever the number of thresholds tried.
+/// @param thresholds_number Number of thresholds to be tried by the algorithm.
+
+size_t ThresholdSelectionAlgorithm::calculate_history_period(const size_t& thresholds_number) const
+{
+    const size_t maximum_history_size = 1000;
+
+    if(thresholds_number <= maximum_history_size)
+    {
+        return(1);
+    }
+
+    return((thresholds_number + maximum_history_size - 1)/maximum_history_size);
+}
+
+
 /// Returns the results of a binary classification test in a single vector.
 /// The size of that vector is fifteen.
 
@@ -27,6 +27,7 @@
 
 #include "vector.h"
 #include "matrix.h"
+#include "roc_curve.h"
 
 #include "training_strategy.h"
 
@@ -152,6 +153,8 @@ public:
 
     Matrix<size_t> calculate_confusion(const double&) const;
 
+    RocCurve<double> calculate_selection_roc_curve(void) const;
+
     Vector<double> calculate_binary_classification_test(const Matrix<size_t>&) const;
 
     // threshold selection methods
@@ -164,6 +167,10 @@ public:
 
 protected:
 
+    // METHODS
+
+    size_t calculate_history_period(const size_t&) const;
+
     // MEMBERS
 
     /// Pointer to a training strategy object.
@@ -32,6 +32,8 @@ TrainingStrategy::TrainingStrategy(void)
  , conjugate_gradient_pointer(NULL)
  , quasi_Newton_method_pointer(NULL)
  , Levenberg_Marquardt_algorithm_pointer(NULL)
+ , stochastic_gradient_descent_pointer(NULL)
+ , adaptive_moment_estimation_pointer(NULL)
  , Newton_method_pointer(NULL)
 {
     set_initialization_type(NO_INITIALIZATION);
@@ -57,6 +59,8 @@ TrainingStrategy::TrainingStrategy(LossIndex* new_loss_index_pointer)
  , conjugate_gradient_pointer(NULL)
  , quasi_Newton_method_pointer(NULL)
  , Levenberg_Marquardt_algorithm_pointer(NULL)
+ , stochastic_gradient_descent_pointer(NULL)
+ , adaptive_moment_estimation_pointer(NULL)
  , Newton_method_pointer(NULL)
 {
     set_initialization_type(NO_INITIALIZATION);
@@ -82,6 +86,8 @@ TrainingStrategy::TrainingStrategy(const tinyxml2::XMLDocument& document)
  , conjugate_gradient_pointer(NULL)
  , quasi_Newton_method_pointer(NULL)
  , Levenberg_Marquardt_algorithm_pointer(NULL)
+ , stochastic_gradient_descent_pointer(NULL)
+ , adaptive_moment_estimation_pointer(NULL)
  , Newton_method_pointer(NULL)
 {
     set_initialization_type(NO_INITIALIZATION);
@@ -109,6 +115,8 @@ TrainingStrategy::TrainingStrategy(const std::string& file_name)
  , conjugate_gradient_pointer(NULL)
  , quasi_Newton_method_pointer(NULL)
  , Levenberg_Marquardt_algorithm_pointer(NULL)
+ , stochastic_gradient_descent_pointer(NULL)
+ , adaptive_moment_estimation_pointer(NULL)
  , Newton_method_pointer(NULL)
 {
     set_initialization_type(NO_INITIALIZATION);
@@ -139,6 +147,8 @@ TrainingStrategy::~TrainingStrategy(void)
     delete conjugate_gradient_pointer;
     delete quasi_Newton_method_pointer;
     delete Levenberg_Marquardt_algorithm_pointer;
+    delete stochastic_gradient_descent_pointer;
+    delete adaptive_moment_estimation_pointer;
     delete Newton_method_pointer;
 }
 
@@ -399,6 +409,50 @@ LevenbergMarquardtAlgorithm* TrainingStrategy::get_Levenberg_Marquardt_algorithm
 }
 
 
+// StochasticGradientDescent* get_stochastic_gradient_descent_pointer(void) const method
+
+/// Returns a pointer to the stochastic gradient descent main algorithm.
+/// It also throws an exception if that pointer is NULL.
+
+StochasticGradientDescent* TrainingStrategy::get_stochastic_gradient_descent_pointer(void) const
+{
+    if(!stochastic_gradient_descent_pointer)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: TrainingStrategy class.\n"
+               << "StochasticGradientDescent* get_stochastic_gradient_descent_pointer(void) const method.\n"
+               << "Stochastic gradient descent pointer is NULL.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    return(stochastic_gradient_descent_pointer);
+}
+
+
+// AdaptiveMomentEstimation* get_adaptive_moment_estimation_pointer(void) const method
+
+/// Returns a pointer to the adaptive moment estimation main algorithm.
+/// It also throws an exception if that pointer is NULL.
+
+AdaptiveMomentEstimation* TrainingStrategy::get_adaptive_moment_estimation_pointer(void) const
+{
+    if(!adaptive_moment_estimation_pointer)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: TrainingStrategy class.\n"
+               << "AdaptiveMomentEstimation* get_adaptive_moment_estimation_pointer(void) const method.\n"
+               << "Adaptive moment estimation pointer is NULL.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+    return(adaptive_moment_estimation_pointer);
+}
+
+
 // NewtonMethod* get_Newton_method_pointer(void) const method
 
 /// Returns a pointer to the Newton method refinement algorithm.
@@ -512,6 +566,14 @@ std::string TrainingStrategy::write_main_type(void) const
    {
       return("LEVENBERG_MARQUARDT_ALGORITHM");
    }
+   else if(main_type == STOCHASTIC_GRADIENT_DESCENT)
+   {
+      return("STOCHASTIC_GRADIENT_DESCENT");
+   }
+   else if(main_type == ADAPTIVE_MOMENT_ESTIMATION)
+   {
+      return("ADAPTIVE_MOMENT_ESTIMATION");
+   }
    else if(main_type == USER_MAIN)
    {
       return("USER_MAIN");
@@ -621,6 +683,14 @@ std::string TrainingStrategy::write_main_type_text(void) const
    {
       return("Levenberg-Marquardt algorithm");
    }
+   else if(main_type == STOCHASTIC_GRADIENT_DESCENT)
+   {
+      return("stochastic gradient descent");
+   }
+   else if(main_type == ADAPTIVE_MOMENT_ESTIMATION)
+   {
+      return("adaptive moment estimation");
+   }
    else if(main_type == USER_MAIN)
    {
       return("user defined");
@@ -818,6 +888,18 @@ void TrainingStrategy::set_main_type(const MainType& new_main_type)
       }
       break;
 
+      case STOCHASTIC_GRADIENT_DESCENT:
+      {
+         stochastic_gradient_descent_pointer = new StochasticGradientDescent(loss_index_pointer);
+      }
+      break;
+
+      case ADAPTIVE_MOMENT_ESTIMATION:
+      {
+         adaptive_moment_estimation_pointer = new AdaptiveMomentEstimation(loss_index_pointer);
+      }
+      break;
+
       case USER_MAIN:
       {
          // do nothing
@@ -953,6 +1035,14 @@ void TrainingStrategy::set_main_type(const std::string& new_main_type)
    {
       set_main_type(LEVENBERG_MARQUARDT_ALGORITHM);
    }
+   else if(new_main_type == "STOCHASTIC_GRADIENT_DESCENT")
+   {
+      set_main_type(STOCHASTIC_GRADIENT_DESCENT);
+   }
+   else if(new_main_type == "ADAPTIVE_MOMENT_ESTIMATION")
+   {
+      set_main_type(ADAPTIVE_MOMENT_ESTIMATION);
+   }
    else if(new_main_type == "USER_MAIN")
    {
       set_main_type(USER_MAIN);
@@ -1087,6 +1177,18 @@ void TrainingStrategy::set_loss_index_pointer(LossIndex* new_loss_index_pointer)
       }
       break;
 
+      case STOCHASTIC_GRADIENT_DESCENT:
+      {
+         stochastic_gradient_descent_pointer->set_loss_index_pointer(new_loss_index_pointer);
+      }
+      break;
+
+      case ADAPTIVE_MOMENT_ESTIMATION:
+      {
+         adaptive_moment_estimation_pointer->set_loss_index_pointer(new_loss_index_pointer);
+      }
+      break;
+
       case USER_MAIN:
       {
          // do nothing
@@ -1233,6 +1335,18 @@ void TrainingStrategy::set_display(const bool& new_display)
       }
       break;
 
+      case STOCHASTIC_GRADIENT_DESCENT:
+      {
+           stochastic_gradient_descent_pointer->set_display(display);
+      }
+      break;
+
+      case ADAPTIVE_MOMENT_ESTIMATION:
+      {
+           adaptive_moment_estimation_pointer->set_display(display);
+      }
+      break;
+
       case USER_MAIN:
       {
          // do nothing
@@ -1702,11 +1816,15 @@ void TrainingStrategy::destruct_main(void)
     delete conjugate_gradient_pointer;
     delete quasi_Newton_method_pointer;
     delete Levenberg_Marquardt_algorithm_pointer;
+    delete stochastic_gradient_descent_pointer;
+    delete adaptive_moment_estimation_pointer;
 
     gradient_descent_pointer = NULL;
     conjugate_gradient_pointer = NULL;
     quasi_Newton_method_pointer = NULL;
     Levenberg_Marquardt_algorithm_pointer = NULL;
+    stochastic_gradient_descent_pointer = NULL;
+    adaptive_moment_estimation_pointer = NULL;
 
    main_type = NO_MAIN;
 }
@@ -1935,6 +2053,24 @@ TrainingStrategy::Results TrainingStrategy::perform_training(void)
       }
       break;
 
+      case STOCHASTIC_GRADIENT_DESCENT:
+      {
+           stochastic_gradient_descent_pointer->set_display(display);
+
+           training_strategy_results.stochastic_gradient_descent_results_pointer
+           = stochastic_gradient_descent_pointer->perform_training();
+      }
+      break;
+
+      case ADAPTIVE_MOMENT_ESTIMATION:
+      {
+           adaptive_moment_estimation_pointer->set_display(display);
+
+           training_strategy_results.adaptive_moment_estimation_results_pointer
+           = adaptive_moment_estimation_pointer->perform_training();
+      }
+      break;
+
       case USER_MAIN:
       {
          // do nothing
@@ -2087,6 +2223,18 @@ std::string TrainingStrategy::to_string(void) const
       }
       break;
 
+      case STOCHASTIC_GRADIENT_DESCENT:
+      {
+           buffer << stochastic_gradient_descent_pointer->to_string();
+      }
+      break;
+
+      case ADAPTIVE_MOMENT_ESTIMATION:
+      {
+           buffer << adaptive_moment_estimation_pointer->to_string();
+      }
+      break;
+
       case USER_MAIN:
       {
          // do nothing
@@ -2324,6 +2472,40 @@ tinyxml2::XMLDocument* TrainingStrategy::to_XML(void) const
       }
       break;
 
+      case STOCHASTIC_GRADIENT_DESCENT:
+      {
+           tinyxml2::XMLElement* main_element = document->NewElement("Main");
+           training_strategy_element->LinkEndChild(main_element);
+
+           main_element->SetAttribute("Type", "STOCHASTIC_GRADIENT_DESCENT");
+
+           const tinyxml2::XMLDocument* stochastic_gradient_descent_document = stochastic_gradient_descent_pointer->to_XML();
+
+           const tinyxml2::XMLElement* stochastic_gradient_descent_element = stochastic_gradient_descent_document->FirstChildElement("StochasticGradientDescent");
+
+           DeepClone(main_element, stochastic_gradient_descent_element, document, NULL);
+
+           delete stochastic_gradient_descent_document;
+      }
+      break;
+
+      case ADAPTIVE_MOMENT_ESTIMATION:
+      {
+           tinyxml2::XMLElement* main_element = document->NewElement("Main");
+           training_strategy_element->LinkEndChild(main_element);
+
+           main_element->SetAttribute("Type", "ADAPTIVE_MOMENT_ESTIMATION");
+
+           const tinyxml2::XMLDocument* adaptive_moment_estimation_document = adaptive_moment_estimation_pointer->to_XML();
+
+           const tinyxml2::XMLElement* adaptive_moment_estimation_element = adaptive_moment_estimation_document->FirstChildElement("AdaptiveMomentEstimation");
+
+           DeepClone(main_element, adaptive_moment_estimation_element, document, NULL);
+
+           delete adaptive_moment_estimation_document;
+      }
+      break;
+
       case USER_MAIN:
       {
          // do nothing
@@ -2475,6 +2657,30 @@ void TrainingStrategy::write_XML(tinyxml2::XMLPrinter& file_stream) const
        }
        break;
 
+       case STOCHASTIC_GRADIENT_DESCENT:
+       {
+            file_stream.OpenElement("Main");
+
+            file_stream.PushAttribute("Type", "STOCHASTIC_GRADIENT_DESCENT");
+
+            stochastic_gradient_descent_pointer->write_XML(file_stream);
+
+            file_stream.CloseElement();
+       }
+       break;
+
+       case ADAPTIVE_MOMENT_ESTIMATION:
+       {
+            file_stream.OpenElement("Main");
+
+            file_stream.PushAttribute("Type", "ADAPTIVE_MOMENT_ESTIMATION");
+
+            adaptive_moment_estimation_pointer->write_XML(file_stream);
+
+            file_stream.CloseElement();
+       }
+       break;
+
        case USER_MAIN:
        {
           // do nothing
@@ -2697,6 +2903,32 @@ void TrainingStrategy::from_XML(const tinyxml2::XMLDocument& document)
              }
              break;
 
+             case STOCHASTIC_GRADIENT_DESCENT:
+             {
+                  tinyxml2::XMLDocument new_document;
+
+                  tinyxml2::XMLElement* element_clone = new_document.NewElement("StochasticGradientDescent");
+                  new_document.InsertFirstChild(element_clone);
+
+                  DeepClone(element_clone, element, &new_document, NULL);
+
+                  stochastic_gradient_descent_pointer->from_XML(new_document);
+             }
+             break;
+
+             case ADAPTIVE_MOMENT_ESTIMATION:
+             {
+                  tinyxml2::XMLDocument new_document;
+
+                  tinyxml2::XMLElement* element_clone = new_document.NewElement("AdaptiveMomentEstimation");
+                  new_document.InsertFirstChild(element_clone);
+
+                  DeepClone(element_clone, element, &new_document, NULL);
+
+                  adaptive_moment_estimation_pointer->from_XML(new_document);
+             }
+             break;
+
              case USER_MAIN:
              {
                 // do nothing
@@ -2850,6 +3082,10 @@ TrainingStrategy::Results::Results(void)
 
     Levenberg_Marquardt_algorithm_results_pointer = NULL;
 
+    stochastic_gradient_descent_results_pointer = NULL;
+
+    adaptive_moment_estimation_results_pointer = NULL;
+
     Newton_method_results_pointer = NULL;
 }
 
@@ -2870,6 +3106,10 @@ TrainingStrategy::Results::~Results(void)
 
 //    delete Levenberg_Marquardt_algorithm_results_pointer;
 
+//    delete stochastic_gradient_descent_results_pointer;
+
+//    delete adaptive_moment_estimation_results_pointer;
+
 //    delete Newton_method_results_pointer;
 
 }
@@ -2914,6 +3154,16 @@ void TrainingStrategy::Results::save(const std::string& file_name) const
       file << Levenberg_Marquardt_algorithm_results_pointer->to_string();
    }
 
+   if(stochastic_gradient_descent_results_pointer)
+   {
+      file << stochastic_gradient_descent_results_pointer->to_string();
+   }
+
+   if(adaptive_moment_estimation_results_pointer)
+   {
+      file << adaptive_moment_estimation_results_pointer->to_string();
+   }
+
    if(Newton_method_results_pointer)
    {
       file << Newton_method_results_pointer->to_string();
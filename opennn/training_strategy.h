@@ -40,6 +40,8 @@
 #include "conjugate_gradient.h"
 #include "quasi_newton_method.h"
 #include "levenberg_marquardt_algorithm.h"
+#include "stochastic_gradient_descent.h"
+#include "adaptive_moment_estimation.h"
 
 #include "newton_method.h"
 
@@ -105,6 +107,8 @@ public:
        NEWTON_METHOD,
        QUASI_NEWTON_METHOD,
        LEVENBERG_MARQUARDT_ALGORITHM,
+       STOCHASTIC_GRADIENT_DESCENT,
+       ADAPTIVE_MOMENT_ESTIMATION,
        USER_MAIN
     };
 
@@ -159,6 +163,14 @@ public:
 
         LevenbergMarquardtAlgorithm::LevenbergMarquardtAlgorithmResults* Levenberg_Marquardt_algorithm_results_pointer;
 
+        /// Pointer to a structure with the results from the stochastic gradient descent training algorithm.
+
+        StochasticGradientDescent::StochasticGradientDescentResults* stochastic_gradient_descent_results_pointer;
+
+        /// Pointer to a structure with the results from the adaptive moment estimation training algorithm.
+
+        AdaptiveMomentEstimation::AdaptiveMomentEstimationResults* adaptive_moment_estimation_results_pointer;
+
         /// Pointer to a structure with results from the Newton method training algorithm.
 
         NewtonMethod::NewtonMethodResults* Newton_method_results_pointer;
@@ -189,6 +201,8 @@ public:
    ConjugateGradient* get_conjugate_gradient_pointer(void) const;
    QuasiNewtonMethod* get_quasi_Newton_method_pointer(void) const;
    LevenbergMarquardtAlgorithm* get_Levenberg_Marquardt_algorithm_pointer(void) const;
+   StochasticGradientDescent* get_stochastic_gradient_descent_pointer(void) const;
+   AdaptiveMomentEstimation* get_adaptive_moment_estimation_pointer(void) const;
 
    NewtonMethod* get_Newton_method_pointer(void) const;
 
@@ -287,6 +301,14 @@ protected:
 
     LevenbergMarquardtAlgorithm* Levenberg_Marquardt_algorithm_pointer;
 
+    /// Pointer to a stochastic gradient descent object to be used as a main training algorithm.
+
+    StochasticGradientDescent* stochastic_gradient_descent_pointer;
+
+    /// Pointer to an adaptive moment estimation object to be used as a main training algorithm.
+
+    AdaptiveMomentEstimation* adaptive_moment_estimation_pointer;
+
     /// Pointer to a Newton method object to be used for refinement in the training strategy.
 
     NewtonMethod* Newton_method_pointer;
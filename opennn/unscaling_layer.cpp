@@ -744,6 +744,75 @@ Vector<double> UnscalingLayer::calculate_outputs(const Vector<double>& inputs) c
 }  
 
 
+// Matrix<double> calculate_outputs(const Matrix<double>&) const method
+
+/// Unscales a batch of outputs at once, column by column, with the unscaling method of the layer.
+/// Each row of the returned matrix contains the unscaled values of the corresponding row of inputs.
+/// @param inputs Matrix of inputs to the unscaling layer. The number of columns must be equal to the number of unscaling neurons.
+
+Matrix<double> UnscalingLayer::calculate_outputs(const Matrix<double>& inputs) const
+{
+    const size_t rows_number = inputs.get_rows_number();
+    const size_t unscaling_neurons_number = get_unscaling_neurons_number();
+
+    // Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+    const size_t columns_number = inputs.get_columns_number();
+
+    if(columns_number != unscaling_neurons_number)
+    {
+        std::ostringstream buffer;
+
+        buffer << "OpenNN Exception: UnscalingLayer class.\n"
+               << "Matrix<double> calculate_outputs(const Matrix<double>&) const method.\n"
+               << "Number of columns of inputs must be equal to number of unscaling neurons.\n";
+
+        throw std::logic_error(buffer.str());
+    }
+
+#endif
+
+    Matrix<double> outputs(inputs);
+
+    if(unscaling_method == NoUnscaling)
+    {
+        return(outputs);
+    }
+
+    double slope;
+    double intercept;
+
+    for(size_t j = 0; j < unscaling_neurons_number; j++)
+    {
+        if(unscaling_method == MinimumMaximum && statistics[j].maximum-statistics[j].minimum >= 1e-99)
+        {
+            slope = 0.5*(statistics[j].maximum-statistics[j].minimum);
+            intercept = 0.5*(statistics[j].maximum-statistics[j].minimum) + statistics[j].minimum;
+        }
+        else if(unscaling_method == MeanStandardDeviation && statistics[j].standard_deviation >= 1e-99)
+        {
+            slope = statistics[j].standard_deviation;
+            intercept = statistics[j].mean;
+        }
+        else
+        {
+            continue;
+        }
+
+        double* column = outputs.data() + j*rows_number;
+
+        for(size_t i = 0; i < rows_number; i++)
+        {
+            column[i] = slope*column[i] + intercept;
+        }
+    }
+
+    return(outputs);
+}
+
+
 // Vector<double> calculate_derivatives(const Vector<double>&) const method
 
 /// This method retuns the derivatives of the unscaled outputs with respect to the scaled outputs.
@@ -31,6 +31,8 @@ namespace OpenNN
 
 Variables::Variables(void)
 {
+   version = 0;
+
    set();  
 }
 
@@ -45,6 +47,8 @@ Variables::Variables(void)
 
 Variables::Variables(const size_t& new_variables_number)
 {
+   version = 0;
+
    set(new_variables_number);
 }
 
@@ -59,6 +63,8 @@ Variables::Variables(const size_t& new_variables_number)
 
 Variables::Variables(const size_t& new_inputs_number, const size_t& new_targets_number)
 {
+   version = 0;
+
    set(new_inputs_number, new_targets_number);
 }
 
@@ -71,6 +77,8 @@ Variables::Variables(const size_t& new_inputs_number, const size_t& new_targets_
 
 Variables::Variables(const tinyxml2::XMLDocument& variables_document)
 {
+   version = 0;
+
    set(variables_document);
 }
 
@@ -90,6 +98,8 @@ Variables::Variables(const Variables& other_variables)
    // Utilities
 
    display = other_variables.display;
+
+   version = 0;
 }
 
 
@@ -119,6 +129,8 @@ Variables& Variables::operator=(const Variables& other_variables)
       // Utilities
 
       display = other_variables.display;
+
+      version++;
    }
 
    return(*this);
@@ -1199,6 +1211,17 @@ const bool& Variables::get_display(void) const
 }
 
 
+// const size_t& get_version(void) const method
+
+/// Returns the number of times that the variables items have been modified.
+/// Objects keeping data arranged by variable uses can compare it with the value they were built with.
+
+const size_t& Variables::get_version(void) const
+{
+   return(version);
+}
+
+
 // void set(void) method
 
 /// Sets a variables object with zero variables.
@@ -1250,6 +1273,8 @@ void Variables::set(const size_t& inputs_number, const size_t& targets_number)
    }
 
    set_default();
+
+   version++;
 }
 
 
@@ -1287,6 +1312,8 @@ void Variables::set_default(void)
 void Variables::set_items(const Vector<Item>& new_items)
 {
     items = new_items;
+
+    version++;
 }
 
 
@@ -1304,6 +1331,8 @@ void Variables::set_uses(const Vector<Variables::Use>& new_uses)
     {
         items[i].use = new_uses[i];
     }
+
+    version++;
 }
 
 
@@ -1342,6 +1371,8 @@ void Variables::set_uses(const Vector<std::string>& new_uses)
 	     throw std::logic_error(buffer.str());
 	  }
    }   
+
+   version++;
 }
 
 
@@ -1373,6 +1404,8 @@ void Variables::set_use(const size_t& i, const Use& new_use)
     #endif
 
     items[i].use = new_use;
+
+    version++;
 }
 
 
@@ -1426,6 +1459,8 @@ void Variables::set_use(const size_t& i, const std::string& new_use)
 
        throw std::logic_error(buffer.str());
     }
+
+    version++;
 }
 
 
@@ -1441,6 +1476,8 @@ void Variables::set_input(void)
     {
         items[i].use = Input;
     }
+
+    version++;
 }
 
 
@@ -1456,6 +1493,8 @@ void Variables::set_target(void)
     {
         items[i].use = Target;
     }
+
+    version++;
 }
 
 // void set_unuse(void) method
@@ -1470,6 +1509,8 @@ void Variables::set_unuse(void)
     {
         items[i].use = Unused;
     }
+
+    version++;
 }
 
 // void set_input_indices(const Vector<size_t>&) method
@@ -1573,6 +1614,8 @@ void Variables::set_default_uses(void)
 
        items[variables_number-1].use = Target;
    }
+
+   version++;
 }
 
 
@@ -1981,6 +2024,8 @@ void Variables::set_variables_number(const size_t& new_variables_number)
 {
    items.set(new_variables_number);
    set_default_uses();
+
+   version++;
 }
 
 
@@ -176,6 +176,8 @@ public:
 
    const bool& get_display(void) const;
 
+   const size_t& get_version(void) const;
+
    // Set methods
 
    void set(void);
@@ -270,6 +272,10 @@ private:
    /// Display messages to screen.
    
    bool display;
+
+   /// Modification counter of the variables items.
+
+   size_t version;
 };
 
 }
@@ -32,6 +32,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 #include <limits>
 #include <climits>
@@ -55,6 +56,8 @@ template <class T> T calculate_random_normal(const T & = 0.0, const T & = 1.0);
 
 template <class T> struct Histogram;
 template <class T> struct Statistics;
+template <class T> struct Moments;
+template <class T> struct QuantileSketch;
 template <class T> struct LinearRegressionParameters;
 template <class T> struct LogisticRegressionParameters;
 
@@ -94,10 +97,27 @@ public:
 
   Vector(const Vector<T> &);
 
+  // Move constructor.
+
+  Vector(Vector<T> &&);
+
+  // Expression constructor.
+
+  template <class Derived> Vector(const Eigen::MatrixBase<Derived> &);
+
   // DESTRUCTOR
 
   virtual ~Vector(void);
 
+  // ASSIGNMENT OPERATORS
+
+  Vector<T> &operator=(const Vector<T> &);
+
+  Vector<T> &operator=(Vector<T> &&);
+
+  template <class Derived>
+  Vector<T> &operator=(const Eigen::MatrixBase<Derived> &);
+
   // OPERATORS
 
   bool operator==(const T &) const;
@@ -262,6 +282,8 @@ public:
 
   Vector<double> calculate_quartiles_missing_values(const Vector<size_t> &) const;
 
+  Vector<double> select_quartiles(void);
+
   Vector<double> calculate_mean_standard_deviation(void) const;
 
   double calculate_mean_missing_values(const Vector<size_t> &) const;
@@ -487,6 +509,10 @@ public:
 
   Matrix<T> to_row_matrix(void) const;
 
+  Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > eigen_map(void);
+
+  Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1> > eigen_map(void) const;
+
   Matrix<T> to_column_matrix(void) const;
 
   void parse(const std::string &);
@@ -556,11 +582,75 @@ template <class T>
 Vector<T>::Vector(const Vector<T> &other_vector)
     : std::vector<T>(other_vector) {}
 
+/// Move constructor. It takes the elements of a temporary vector without
+/// copying them, so that returning vectors by value does not allocate twice.
+/// @param other_vector Vector to be moved.
+
+template <class T>
+Vector<T>::Vector(Vector<T> &&other_vector)
+    : std::vector<T>(std::move(other_vector)) {}
+
+/// Expression constructor. It creates a vector by evaluating an Eigen
+/// expression in a single loop, without intermediate vectors.
+/// Expressions are built on the maps returned by eigen_map(), for instance
+/// Vector<double> direction = gradient.eigen_map()*(-1.0) +
+/// old_direction.eigen_map()*beta.
+/// @param expression Column expression to be evaluated.
+
+template <class T>
+template <class Derived>
+Vector<T>::Vector(const Eigen::MatrixBase<Derived> &expression)
+    : std::vector<T>(expression.size()) {
+  eigen_map().noalias() = expression;
+}
+
 // DESTRUCTOR
 
 /// Destructor.
 template <class T> Vector<T>::~Vector(void) {}
 
+// ASSIGNMENT OPERATORS
+
+/// Assignment operator. It assigns to this vector a copy of another vector.
+/// @param other_vector Vector to be copied.
+
+template <class T>
+Vector<T> &Vector<T>::operator=(const Vector<T> &other_vector) {
+  std::vector<T>::operator=(other_vector);
+
+  return (*this);
+}
+
+/// Move assignment operator. It takes the elements of a temporary vector,
+/// such as the result of an arithmetic operator, without copying them.
+/// @param other_vector Vector to be moved.
+
+template <class T>
+Vector<T> &Vector<T>::operator=(Vector<T> &&other_vector) {
+  std::vector<T>::operator=(std::move(other_vector));
+
+  return (*this);
+}
+
+/// Expression assignment operator. It evaluates an Eigen expression directly
+/// into this vector, in a single loop and without intermediate vectors.
+/// The vector is only reallocated when its size changes.
+/// @param expression Column expression to be evaluated.
+
+template <class T>
+template <class Derived>
+Vector<T> &Vector<T>::operator=(const Eigen::MatrixBase<Derived> &expression) {
+  if (this->size() != (size_t)expression.size()) {
+    Vector<T> result(expression);
+
+    this->swap(result);
+  } else {
+    eigen_map() = expression;
+  }
+
+  return (*this);
+}
+
 // bool  == (const T&) const
 
 /// Equal to operator between this vector and a Type value.
@@ -1681,55 +1771,32 @@ Histogram<T> Vector<T>::calculate_histogram(const size_t &bins_number) const {
 
 #endif
 
-  Vector<T> minimums(bins_number);
-  Vector<T> maximums(bins_number);
-
-  Vector<T> centers(bins_number);
-  Vector<size_t> frequencies(bins_number, 0);
-
   const Vector<T> minimum_maximum = calculate_minimum_maximum();
 
-  const T minimum = minimum_maximum[0];
-  const T maximum = minimum_maximum[1];
+  Histogram<T> histogram;
 
-  const double length = (maximum - minimum) / (double)bins_number;
+  histogram.set_equal_width_bins(minimum_maximum[0], minimum_maximum[1], bins_number);
 
-  minimums[0] = minimum;
-  maximums[0] = minimum + length;
-  centers[0] = (maximums[0] + minimums[0]) / 2.0;
+  // Calculate bins frequency
 
-  // Calculate bins center
+  const size_t this_size = this->size();
 
-  for (size_t i = 1; i < bins_number; i++)
+  #pragma omp parallel
   {
-    minimums[i] = minimums[i - 1] + length;
-    maximums[i] = maximums[i - 1] + length;
-
-    centers[i] = (maximums[i] + minimums[i]) / 2.0;
-  }
+    Vector<size_t> frequencies(bins_number, 0);
 
-  // Calculate bins frequency
+    int i;
 
-  const size_t this_size = this->size();
+    #pragma omp for
 
-  for (size_t i = 0; i < this_size; i++) {
-    for (size_t j = 0; j < bins_number - 1; j++) {
-      if((*this)[i] >= minimums[j] && (*this)[i] < maximums[j]) {
-        frequencies[j]++;
-      }
+    for (i = 0; i < (int)this_size; i++) {
+      frequencies[histogram.calculate_bin((*this)[i])]++;
     }
 
-    if((*this)[i] >= minimums[bins_number - 1]) {
-      frequencies[bins_number - 1]++;
-    }
+    #pragma omp critical
+    histogram.frequencies += frequencies;
   }
 
-  Histogram<T> histogram(bins_number);
-  histogram.centers = centers;
-  histogram.minimums = minimums;
-  histogram.maximums = maximums;
-  histogram.frequencies = frequencies;
-
   return (histogram);
 }
 
@@ -1766,10 +1833,10 @@ Histogram<T> Vector<T>::calculate_histogram_binary(void) const {
   const size_t this_size = this->size();
 
   for (size_t i = 0; i < this_size; i++) {
-    for (size_t j = 0; j < 2; j++) {
-      if((*this)[i] == minimums[j]) {
-        frequencies[j]++;
-      }
+    if((*this)[i] == 0) {
+      frequencies[0]++;
+    } else if((*this)[i] == 1) {
+      frequencies[1]++;
     }
   }
 
@@ -1812,58 +1879,24 @@ Histogram<T> Vector<T>::calculate_histogram_missing_values(
 
 #endif
 
-  Vector<T> minimums(bins_number);
-  Vector<T> maximums(bins_number);
-
-  Vector<T> centers(bins_number);
-  Vector<size_t> frequencies(bins_number, 0);
-
-  const Vector<T> minimum_maximum =
-      calculate_minimum_maximum_missing_values(missing_indices);
-
-  const T minimum = minimum_maximum[0];
-  const T maximum = minimum_maximum[1];
-
-  const double length = (maximum - minimum) / (double)bins_number;
-
-  minimums[0] = minimum;
-  maximums[0] = minimum + length;
-  centers[0] = (maximums[0] + minimums[0]) / 2.0;
+  const size_t this_size = this->size();
 
-  // Calculate bins center
+  Vector<bool> missing(this_size, false);
 
-  for (size_t i = 1; i < bins_number; i++) {
-    minimums[i] = minimums[i - 1] + length;
-    maximums[i] = maximums[i - 1] + length;
-
-    centers[i] = (maximums[i] + minimums[i]) / 2.0;
+  for (size_t i = 0; i < missing_indices.size(); i++) {
+    missing[missing_indices[i]] = true;
   }
 
-  // Calculate bins frequency
-
-  const size_t this_size = this->size();
-
-  for (int i = 0; i < (int)this_size; i++) {
-    if(!missing_indices.contains(i)) {
-      for (int j = 0; j < (int)bins_number - 1; j++) {
-        if((*this)[i] >= minimums[j] && (*this)[i] < maximums[j]) {
-          frequencies[j]++;
-        }
-      }
+  Vector<T> values;
+  values.reserve(this_size);
 
-      if((*this)[i] >= minimums[bins_number - 1]) {
-        frequencies[bins_number - 1]++;
-      }
+  for (size_t i = 0; i < this_size; i++) {
+    if(!missing[i]) {
+      values.push_back((*this)[i]);
     }
   }
 
-  Histogram<T> histogram(bins_number);
-  histogram.centers = centers;
-  histogram.minimums = minimums;
-  histogram.maximums = maximums;
-  histogram.frequencies = frequencies;
-
-  return (histogram);
+  return (values.calculate_histogram(bins_number));
 }
 
 // size_t calculate_minimal_index(void) const method
@@ -2551,20 +2584,22 @@ Vector<double> Vector<T>::calculate_mean_standard_deviation(void) const {
 template <class T> double Vector<T>::calculate_median(void) const {
   const size_t this_size = this->size();
 
-  Vector<T> sorted_vector(*this);
+  if(this_size == 0) {
+    return (0.0);
+  }
 
-  std::sort(sorted_vector.begin(), sorted_vector.end(), std::less<double>());
+  Vector<T> buffer(*this);
+
+  const size_t median_index = this_size / 2;
 
-  size_t median_index;
+  std::nth_element(buffer.begin(), buffer.begin() + median_index, buffer.end());
 
   if(this_size % 2 == 0) {
-    median_index = (size_t)(this_size / 2);
+    const T lower_value = *std::max_element(buffer.begin(), buffer.begin() + median_index);
 
-    return ((sorted_vector[median_index] + sorted_vector[median_index]) / 2.0);
+    return ((lower_value + buffer[median_index]) / 2.0);
   } else {
-    median_index = (size_t)(this_size / 2);
-
-    return (sorted_vector[median_index + 1]);
+    return (buffer[median_index]);
   }
 }
 
@@ -2573,31 +2608,9 @@ template <class T> double Vector<T>::calculate_median(void) const {
 /// Returns the quarters of the elements in the vector.
 
 template <class T> Vector<double> Vector<T>::calculate_quartiles(void) const {
-  const size_t this_size = this->size();
-
-  Vector<T> sorted_vector(*this);
-
-  std::sort(sorted_vector.begin(), sorted_vector.end(), std::less<double>());
-
-  Vector<double> quartiles(4);
-
-  if(this_size % 2 == 0) {
-    quartiles[0] = (sorted_vector[this_size / 4] + sorted_vector[this_size / 4 + 1]) / 2;
-    quartiles[1] = (sorted_vector[this_size * 2 / 4] +
-                   sorted_vector[this_size * 2 / 4 + 1]) /
-                  2;
-    quartiles[2] = (sorted_vector[this_size * 3 / 4] +
-                   sorted_vector[this_size * 3 / 4 + 1]) /
-                  2;
-    quartiles[3] = calculate_maximum();
-  } else {
-    quartiles[0] = sorted_vector[this_size / 4 /*+ 1*/];
-    quartiles[1] = sorted_vector[this_size * 2 / 4 /*+ 1*/];
-    quartiles[2] = sorted_vector[this_size * 3 / 4 /*+ 1*/];
-    quartiles[3] = calculate_maximum();
-  }
+  Vector<T> buffer(*this);
 
-  return (quartiles);
+  return (buffer.select_quartiles());
 }
 
 // Vector<double> calculate_quartiles_missing_values(const Vector<size_t>&) const
@@ -2609,38 +2622,84 @@ template <class T>
 Vector<double> Vector<T>::calculate_quartiles_missing_values(const Vector<size_t> & missing_indices) const
 {
     const size_t this_size = this->size();
-    const size_t missing_indices_number = missing_indices.size();
 
-    Vector<T> sorted_vector(*this);
+    Vector<bool> missing(this_size, false);
 
-    for(size_t i = 0; i < missing_indices_number; i++)
+    for(size_t i = 0; i < missing_indices.size(); i++)
     {
-        sorted_vector.remove_element(missing_indices[i]);
+        missing[missing_indices[i]] = true;
     }
 
-    std::sort(sorted_vector.begin(), sorted_vector.end(), std::less<double>());
+    Vector<T> buffer;
+    buffer.reserve(this_size);
 
-    const size_t actual_size = this_size - missing_indices_number;
+    for(size_t i = 0; i < this_size; i++)
+    {
+        if(!missing[i])
+        {
+            buffer.push_back((*this)[i]);
+        }
+    }
+
+    return (buffer.select_quartiles());
+}
 
-    Vector<double> quartiles(4);
+// Vector<double> select_quartiles(void) method
 
-    if(actual_size % 2 == 0) {
-      quartiles[0] = (sorted_vector[actual_size / 4] + sorted_vector[actual_size / 4 + 1]) / 2;
-      quartiles[1] = (sorted_vector[actual_size * 2 / 4] +
-                     sorted_vector[actual_size * 2 / 4 + 1]) /
-                    2;
-      quartiles[2] = (sorted_vector[actual_size * 3 / 4] +
-                     sorted_vector[actual_size * 3 / 4 + 1]) /
-                    2;
-      quartiles[3] = sorted_vector[actual_size - 1];
-    } else {
-      quartiles[0] = sorted_vector[actual_size / 4 /*+ 1*/];
-      quartiles[1] = sorted_vector[actual_size * 2 / 4 /*+ 1*/];
-      quartiles[2] = sorted_vector[actual_size * 3 / 4 /*+ 1*/];
-      quartiles[3] = sorted_vector[actual_size - 1];
-    }
+/// Returns the quarters of the elements in the vector, as calculate_quartiles(),
+/// without sorting a copy of the vector.
+/// The order statistics are selected in place in linear time, so that the order of the elements changes.
+/// It is meant to be called on a buffer which is reused for several sets of values.
 
+template <class T> Vector<double> Vector<T>::select_quartiles(void) {
+  const size_t this_size = this->size();
+
+  Vector<double> quartiles(4, 0.0);
+
+  if(this_size == 0) {
     return (quartiles);
+  }
+
+  const size_t last_index = this_size - 1;
+
+  const size_t first_quartile_index = this_size / 4;
+  const size_t second_quartile_index = this_size * 2 / 4;
+  const size_t third_quartile_index = this_size * 3 / 4;
+
+  // Order statistics needed, in increasing order
+
+  size_t indices[7] = {first_quartile_index, std::min(first_quartile_index + 1, last_index),
+                       second_quartile_index, std::min(second_quartile_index + 1, last_index),
+                       third_quartile_index, std::min(third_quartile_index + 1, last_index),
+                       last_index};
+
+  // Each selection leaves greater elements after the selected one, so that the next one is searched there
+
+  typename std::vector<T>::iterator first = this->begin();
+
+  for(size_t i = 0; i < 7; i++) {
+    if(i > 0 && indices[i] == indices[i - 1]) {
+      continue;
+    }
+
+    std::nth_element(first, this->begin() + indices[i], this->end());
+
+    first = this->begin() + indices[i] + 1;
+  }
+
+  if(this_size % 2 == 0) {
+    quartiles[0] = ((*this)[indices[0]] + (*this)[indices[1]]) / 2.0;
+    quartiles[1] = ((*this)[indices[2]] + (*this)[indices[3]]) / 2.0;
+    quartiles[2] = ((*this)[indices[4]] + (*this)[indices[5]]) / 2.0;
+  } else {
+    quartiles[0] = (*this)[first_quartile_index];
+    quartiles[1] = (*this)[second_quartile_index];
+    quartiles[2] = (*this)[third_quartile_index];
+  }
+
+  quartiles[3] = (*this)[last_index];
+
+  return (quartiles);
 }
 
 // double calculate_mean_missing_values(const Vector<size_t>&) const method
@@ -3094,7 +3153,7 @@ Vector<double> Vector<T>::calculate_box_plots_missing_values(const Vector<size_t
 
     Vector<double> quartiles = calculate_quartiles_missing_values(missing_indices);
 
-    box_plots[0] = calculate_minimum();
+    box_plots[0] = calculate_minimum_missing_values(missing_indices);
     box_plots[1] = quartiles[0];
     box_plots[2] = quartiles[1];
     box_plots[3] = quartiles[2];
@@ -4180,6 +4239,9 @@ void Vector<T>::apply_lower_upper_bounds(const Vector<T> &lower_bound,
 // Vector<size_t> sort_less_indices(void) const method
 
 /// Returns the vector of the indices of the vector sorted by less ranks.
+/// Equal elements keep their original order.
+/// Blocks of indices are sorted in parallel, and then they are merged pairwise in parallel,
+/// so that the result does not depend on the number of threads.
 
 template <class T>
 Vector<size_t> Vector<T>::sort_less_indices(void) const
@@ -4197,8 +4259,46 @@ Vector<size_t> Vector<T>::sort_less_indices(void) const
 
 #else
 
+    const size_t this_size = this->size();
+
+    const size_t block_size = 65536;
+
+    const size_t blocks_number = (this_size + block_size - 1)/block_size;
+
     indices.initialize_sequential();
-    std::sort(indices.begin(), indices.end(), [this](size_t i1, size_t i2) {return (*this)[i1] < (*this)[i2];});
+
+    const auto less = [this](const size_t& i1, const size_t& i2)
+    {
+        return((*this)[i1] < (*this)[i2] || (!((*this)[i2] < (*this)[i1]) && i1 < i2));
+    };
+
+    int i;
+
+    #pragma omp parallel for schedule(dynamic)
+
+    for(i = 0; i < (int)blocks_number; i++)
+    {
+        const size_t first = i*block_size;
+        const size_t last = std::min(first + block_size, this_size);
+
+        std::sort(indices.begin() + first, indices.begin() + last, less);
+    }
+
+    for(size_t width = block_size; width < this_size; width *= 2)
+    {
+        const size_t merges_number = (this_size + 2*width - 1)/(2*width);
+
+        #pragma omp parallel for schedule(dynamic)
+
+        for(i = 0; i < (int)merges_number; i++)
+        {
+            const size_t first = 2*i*width;
+            const size_t middle = std::min(first + width, this_size);
+            const size_t last = std::min(first + 2*width, this_size);
+
+            std::inplace_merge(indices.begin() + first, indices.begin() + middle, indices.begin() + last, less);
+        }
+    }
 
 #endif
 
@@ -5976,6 +6076,31 @@ template <class T> Matrix<T> Vector<T>::to_row_matrix(void) const {
   return (matrix);
 }
 
+// Eigen::Map< Eigen::Matrix<T, Eigen::Dynamic, 1> > eigen_map(void) method
+
+/// Returns an Eigen view of the elements of this vector, which does not copy
+/// them. Arithmetic on Eigen views is lazy, so that compound expressions are
+/// evaluated in a single vectorized loop when they are assigned.
+/// The view is invalidated when the vector is resized.
+
+template <class T>
+Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > Vector<T>::eigen_map(void) {
+  return (Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> >(this->data(),
+                                                           this->size()));
+}
+
+// Eigen::Map< const Eigen::Matrix<T, Eigen::Dynamic, 1> > eigen_map(void) const method
+
+/// Returns a constant Eigen view of the elements of this vector, which does
+/// not copy them.
+
+template <class T>
+Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1> >
+Vector<T>::eigen_map(void) const {
+  return (Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1> >(
+      this->data(), this->size()));
+}
+
 // Matrix<T> to_column_matrix(void) const method
 
 /// Returns a column matrix with number of rows equal to the size of this vector
@@ -6467,6 +6592,468 @@ std::ostream &operator<<(std::ostream &os, const Statistics<T> &statistics) {
   return (os);
 }
 
+///
+/// This structure contains the number of values, the extreme values and the central moments up to order four
+/// of a set of values. It is computed in a single pass over contiguous blocks of values, and the moments of
+/// disjoint blocks are merged with the pairwise updating formulas of Chan, Golub and LeVeque.
+/// It gives the statistics and the shape parameters of large sets computed in parallel.
+///
+
+template <class T> struct Moments {
+  // Default constructor.
+
+  Moments(void);
+
+  /// Destructor.
+
+  virtual ~Moments(void);
+
+  // METHODS
+
+  void set(const T *, const size_t &);
+
+  void merge(const Moments<T> &);
+
+  Statistics<T> calculate_statistics(void) const;
+
+  Vector<double> calculate_shape_parameters(void) const;
+
+  /// Number of values.
+
+  size_t count;
+
+  /// Smallest value.
+
+  T minimum;
+
+  /// Biggest value.
+
+  T maximum;
+
+  /// Mean value.
+
+  double mean;
+
+  /// Sum of the squared deviations from the mean.
+
+  double M2;
+
+  /// Sum of the cubed deviations from the mean.
+
+  double M3;
+
+  /// Sum of the fourth powers of the deviations from the mean.
+
+  double M4;
+};
+
+/// Default constructor.
+/// It sets the moments of an empty set of values.
+
+template <class T> Moments<T>::Moments(void) {
+  count = 0;
+
+  minimum = std::numeric_limits<T>::max();
+
+  if(std::numeric_limits<T>::is_signed) {
+    maximum = -std::numeric_limits<T>::max();
+  } else {
+    maximum = 0;
+  }
+
+  mean = 0.0;
+
+  M2 = 0.0;
+  M3 = 0.0;
+  M4 = 0.0;
+}
+
+/// Destructor.
+
+template <class T> Moments<T>::~Moments(void) {}
+
+/// Sets the moments of a contiguous block of values.
+/// The block is traversed twice, first for the extreme values and the mean, and then for the central moments.
+/// Both loops are reductions which the compiler can vectorize, and the block should fit in cache.
+/// @param values Pointer to the first value in the block.
+/// @param size Number of values in the block.
+
+template <class T> void Moments<T>::set(const T *values, const size_t &size) {
+  *this = Moments<T>();
+
+  if(size == 0) {
+    return;
+  }
+
+  T minimum_value = minimum;
+  T maximum_value = maximum;
+
+  double sum = 0.0;
+
+  #pragma omp simd reduction(min:minimum_value) reduction(max:maximum_value) reduction(+:sum)
+
+  for (int i = 0; i < (int)size; i++) {
+    minimum_value = values[i] < minimum_value ? values[i] : minimum_value;
+    maximum_value = values[i] > maximum_value ? values[i] : maximum_value;
+
+    sum += values[i];
+  }
+
+  count = size;
+  minimum = minimum_value;
+  maximum = maximum_value;
+  mean = sum / size;
+
+  const double block_mean = mean;
+
+  double sum_2 = 0.0;
+  double sum_3 = 0.0;
+  double sum_4 = 0.0;
+
+  #pragma omp simd reduction(+:sum_2, sum_3, sum_4)
+
+  for (int i = 0; i < (int)size; i++) {
+    const double deviation = values[i] - block_mean;
+    const double squared_deviation = deviation * deviation;
+
+    sum_2 += squared_deviation;
+    sum_3 += squared_deviation * deviation;
+    sum_4 += squared_deviation * squared_deviation;
+  }
+
+  M2 = sum_2;
+  M3 = sum_3;
+  M4 = sum_4;
+}
+
+/// Adds to this structure the moments of a disjoint set of values.
+/// @param other_moments Moments of the other set of values.
+
+template <class T> void Moments<T>::merge(const Moments<T> &other_moments) {
+  if(other_moments.count == 0) {
+    return;
+  }
+
+  if(count == 0) {
+    *this = other_moments;
+    return;
+  }
+
+  const double n_a = (double)count;
+  const double n_b = (double)other_moments.count;
+  const double n = n_a + n_b;
+
+  const double delta = other_moments.mean - mean;
+  const double delta_2 = delta * delta;
+
+  const double new_M2 = M2 + other_moments.M2 + delta_2 * n_a * n_b / n;
+
+  const double new_M3 = M3 + other_moments.M3
+                      + delta_2 * delta * n_a * n_b * (n_a - n_b) / (n * n)
+                      + 3.0 * delta * (n_a * other_moments.M2 - n_b * M2) / n;
+
+  const double new_M4 = M4 + other_moments.M4
+                      + delta_2 * delta_2 * n_a * n_b * (n_a * n_a - n_a * n_b + n_b * n_b) / (n * n * n)
+                      + 6.0 * delta_2 * (n_a * n_a * other_moments.M2 + n_b * n_b * M2) / (n * n)
+                      + 4.0 * delta * (n_a * other_moments.M3 - n_b * M3) / n;
+
+  count += other_moments.count;
+
+  if(other_moments.minimum < minimum) {
+    minimum = other_moments.minimum;
+  }
+
+  if(other_moments.maximum > maximum) {
+    maximum = other_moments.maximum;
+  }
+
+  mean += delta * n_b / n;
+
+  M2 = new_M2;
+  M3 = new_M3;
+  M4 = new_M4;
+}
+
+/// Returns the minimum, maximum, mean and standard deviation of the set of values.
+/// The standard deviation is that of a sample.
+
+template <class T> Statistics<T> Moments<T>::calculate_statistics(void) const {
+  Statistics<T> statistics;
+
+  statistics.minimum = minimum;
+  statistics.maximum = maximum;
+  statistics.mean = (T)mean;
+
+  if(count <= 1) {
+    statistics.standard_deviation = (T)0.0;
+  } else {
+    statistics.standard_deviation = (T)sqrt(M2 / (count - 1.0));
+  }
+
+  return (statistics);
+}
+
+/// Returns the asymmetry and the kurtosis of the set of values,
+/// as Vector::calculate_asymmetry() and Vector::calculate_kurtosis().
+
+template <class T> Vector<double> Moments<T>::calculate_shape_parameters(void) const {
+  Vector<double> shape_parameters(2, 0.0);
+
+  if(count <= 1) {
+    return (shape_parameters);
+  }
+
+  const double variance = M2 / (count - 1.0);
+  const double standard_deviation = sqrt(variance);
+
+  shape_parameters[0] = (M3 / count) / (variance * standard_deviation);
+  shape_parameters[1] = (M4 / count) / (variance * variance) - 3.0;
+
+  return (shape_parameters);
+}
+
+///
+/// This structure summarizes a set of values in a small amount of memory, so that their quantiles
+/// can be approximated in a single pass. The values are kept in levels of compactors, in which each value
+/// stands for 2^level values of the set. When a level is full it is sorted, and every other value
+/// is moved up to the next level (Manku, Rajagopalan and Lindsay; Karnin, Lang and Liberty).
+/// Sketches of disjoint sets of values can be merged, so that they can be computed in parallel or by chunks.
+/// The error in the rank of a quantile is at most log2(count/capacity)/capacity times the number of values,
+/// and it is much smaller in practice. The minimum and the maximum are exact.
+///
+
+template <class T> struct QuantileSketch {
+  // Default constructor.
+
+  explicit QuantileSketch(const size_t & = 256);
+
+  /// Destructor.
+
+  virtual ~QuantileSketch(void);
+
+  // METHODS
+
+  void update(const T &);
+
+  void merge(const QuantileSketch<T> &);
+
+  double calculate_quantile(const double &) const;
+
+  Vector<double> calculate_quartiles(void) const;
+
+  Vector<double> calculate_box_plots(void) const;
+
+  /// Maximum number of values in each level.
+
+  size_t capacity;
+
+  /// Number of values in the set.
+
+  size_t count;
+
+  /// Smallest value.
+
+  T minimum;
+
+  /// Biggest value.
+
+  T maximum;
+
+  /// Values kept in each level. Each value in the level i stands for 2^i values of the set.
+
+  Vector< Vector<T> > levels;
+
+  /// Number of times that each level has been compacted.
+  /// It alternates the values which are moved up, so that the errors of consecutive compactions cancel out.
+
+  Vector<size_t> compactions_numbers;
+
+private:
+
+  void compact(void);
+};
+
+/// Default constructor.
+/// @param new_capacity Maximum number of values in each level. The error decreases as the capacity increases.
+
+template <class T> QuantileSketch<T>::QuantileSketch(const size_t &new_capacity) {
+  capacity = std::max(new_capacity, (size_t)2);
+
+  count = 0;
+
+  minimum = std::numeric_limits<T>::max();
+
+  if(std::numeric_limits<T>::is_signed) {
+    maximum = -std::numeric_limits<T>::max();
+  } else {
+    maximum = 0;
+  }
+}
+
+/// Destructor.
+
+template <class T> QuantileSketch<T>::~QuantileSketch(void) {}
+
+/// Adds a value to the set.
+/// @param value Value to be added.
+
+template <class T> void QuantileSketch<T>::update(const T &value) {
+  if(levels.empty()) {
+    levels.resize(1);
+    compactions_numbers.resize(1, 0);
+
+    levels[0].reserve(capacity);
+  }
+
+  levels[0].push_back(value);
+
+  count++;
+
+  if(value < minimum) {
+    minimum = value;
+  }
+
+  if(value > maximum) {
+    maximum = value;
+  }
+
+  if(levels[0].size() >= capacity) {
+    compact();
+  }
+}
+
+/// Adds to this sketch the values of another sketch, built over a disjoint set of values.
+/// @param other_sketch Sketch of the other set of values.
+
+template <class T> void QuantileSketch<T>::merge(const QuantileSketch<T> &other_sketch) {
+  if(other_sketch.count == 0) {
+    return;
+  }
+
+  if(levels.size() < other_sketch.levels.size()) {
+    levels.resize(other_sketch.levels.size());
+    compactions_numbers.resize(other_sketch.levels.size(), 0);
+  }
+
+  for(size_t i = 0; i < other_sketch.levels.size(); i++) {
+    levels[i].insert(levels[i].end(), other_sketch.levels[i].begin(), other_sketch.levels[i].end());
+
+    compactions_numbers[i] += other_sketch.compactions_numbers[i];
+  }
+
+  count += other_sketch.count;
+
+  if(other_sketch.minimum < minimum) {
+    minimum = other_sketch.minimum;
+  }
+
+  if(other_sketch.maximum > maximum) {
+    maximum = other_sketch.maximum;
+  }
+
+  compact();
+}
+
+/// Moves up half of the values of every full level.
+/// When a level has an odd number of values, its biggest value stays in it.
+
+template <class T> void QuantileSketch<T>::compact(void) {
+  for(size_t i = 0; i < levels.size(); i++) {
+    if(levels[i].size() < capacity) {
+      continue;
+    }
+
+    if(i + 1 == levels.size()) {
+      levels.resize(i + 2);
+      compactions_numbers.resize(i + 2, 0);
+    }
+
+    Vector<T>& level = levels[i];
+
+    std::sort(level.begin(), level.end());
+
+    const size_t compacted_number = level.size() - level.size() % 2;
+
+    for(size_t j = compactions_numbers[i] % 2; j < compacted_number; j += 2) {
+      levels[i + 1].push_back(level[j]);
+    }
+
+    level.erase(level.begin(), level.begin() + compacted_number);
+
+    compactions_numbers[i]++;
+  }
+}
+
+/// Returns an approximation of a quantile of the set of values.
+/// @param probability Fraction of the values which are smaller than the quantile, between 0 and 1.
+
+template <class T> double QuantileSketch<T>::calculate_quantile(const double &probability) const {
+  if(count == 0) {
+    return (0.0);
+  }
+
+  if(probability <= 0.0) {
+    return (minimum);
+  }
+
+  if(probability >= 1.0) {
+    return (maximum);
+  }
+
+  Vector< std::pair<T, size_t> > weighted_values;
+
+  for(size_t i = 0; i < levels.size(); i++) {
+    for(size_t j = 0; j < levels[i].size(); j++) {
+      weighted_values.push_back(std::make_pair(levels[i][j], (size_t)1 << i));
+    }
+  }
+
+  std::sort(weighted_values.begin(), weighted_values.end());
+
+  const double rank = probability * count;
+
+  size_t cumulative_weight = 0;
+
+  for(size_t i = 0; i < weighted_values.size(); i++) {
+    cumulative_weight += weighted_values[i].second;
+
+    if(cumulative_weight > rank) {
+      return (weighted_values[i].first);
+    }
+  }
+
+  return (maximum);
+}
+
+/// Returns an approximation of the quarters of the set of values, as Vector::calculate_quartiles().
+
+template <class T> Vector<double> QuantileSketch<T>::calculate_quartiles(void) const {
+  Vector<double> quartiles(4);
+
+  quartiles[0] = calculate_quantile(0.25);
+  quartiles[1] = calculate_quantile(0.5);
+  quartiles[2] = calculate_quantile(0.75);
+  quartiles[3] = count == 0 ? 0.0 : (double)maximum;
+
+  return (quartiles);
+}
+
+/// Returns an approximation of the box and whiskers of the set of values, as Vector::calculate_box_plots().
+
+template <class T> Vector<double> QuantileSketch<T>::calculate_box_plots(void) const {
+  const Vector<double> quartiles = calculate_quartiles();
+
+  Vector<double> box_plots(5);
+
+  box_plots[0] = count == 0 ? 0.0 : (double)minimum;
+  box_plots[1] = quartiles[0];
+  box_plots[2] = quartiles[1];
+  box_plots[3] = quartiles[2];
+  box_plots[4] = quartiles[3];
+
+  return (box_plots);
+}
+
 ///
 /// This template contains the data needed to represent a histogram.
 ///
@@ -6502,6 +7089,8 @@ template <class T> struct Histogram {
 
   Vector<T> calculate_maximal_centers(void) const;
 
+  void set_equal_width_bins(const T &, const T &, const size_t &);
+
   size_t calculate_bin(const T &) const;
 
   size_t calculate_frequency(const T &) const;
@@ -6618,38 +7207,88 @@ Vector<T> Histogram<T>::calculate_maximal_centers(void) const {
 template <class T> size_t Histogram<T>::calculate_bin(const T &value) const {
   const size_t bins_number = get_bins_number();
 
-  const double minimum_center = centers[0];
-  const double maximum_center = centers[bins_number - 1];
+  if(bins_number <= 1) {
+    return (0);
+  }
+
+  const size_t last_bin = bins_number - 1;
+
+  // Bins limits
 
-  const double length =
-      (double)(maximum_center - minimum_center) / (double)(bins_number - 1);
+  double first_maximum;
+  double last_minimum;
 
-  double minimum_value = centers[0] - length / 2;
-  double maximum_value = minimum_value + length;
+  if(minimums.size() == bins_number && maximums.size() == bins_number) {
+    first_maximum = maximums[0];
+    last_minimum = minimums[last_bin];
+  } else {
+    const double length = (double)(centers[last_bin] - centers[0]) / (double)last_bin;
 
-  if(value < maximum_value) {
+    first_maximum = centers[0] + length / 2;
+    last_minimum = centers[last_bin] - length / 2;
+  }
+
+  if(!(value >= first_maximum)) {
     return (0);
   }
 
-  for (size_t j = 1; j < bins_number - 1; j++) {
-    minimum_value = minimum_value + length;
-    maximum_value = maximum_value + length;
+  if(value >= last_minimum) {
+    return (last_bin);
+  }
+
+  // The bin is computed arithmetically, and corrected against the limits of the bins if there are any
 
-    if(value >= minimum_value && value < maximum_value) {
-      return (j);
+  const double length = (last_minimum - first_maximum) / (double)(bins_number - 2);
+
+  size_t bin = 1 + (size_t)((value - first_maximum) / length);
+
+  if(bin > last_bin - 1) {
+    bin = last_bin - 1;
+  }
+
+  if(minimums.size() == bins_number && maximums.size() == bins_number) {
+    while(bin > 1 && value < minimums[bin]) {
+      bin--;
+    }
+
+    while(bin < last_bin - 1 && value >= maximums[bin]) {
+      bin++;
     }
   }
 
-  if(value >= maximum_value) {
-    return (bins_number - 1);
-  } else {
-    std::ostringstream buffer;
+  return (bin);
+}
 
-    buffer << "OpenNN Exception: Vector Template.\n"
-           << "Vector<size_t> Histogram<T>::calculate_bin(const T&) const.\n"
-           << "Unknown return value.\n";
+// void set_equal_width_bins(const T&, const T&, const size_t&) method
 
-    throw std::logic_error(buffer.str());
+/// Sets a given number of equally spaced bins between two values, with zero frequencies.
+/// The last bin also contains the values greater than its maximum.
+/// @param minimum Minimum of the first bin.
+/// @param maximum Maximum of the last bin.
+/// @param bins_number Number of bins.
+
+template <class T>
+void Histogram<T>::set_equal_width_bins(const T &minimum, const T &maximum, const size_t &bins_number) {
+  minimums.set(bins_number);
+  maximums.set(bins_number);
+  centers.set(bins_number);
+  frequencies.set(bins_number, 0);
+
+  if(bins_number == 0) {
+    return;
+  }
+
+  const double length = (maximum - minimum) / (double)bins_number;
+
+  minimums[0] = minimum;
+  maximums[0] = minimum + length;
+  centers[0] = (maximums[0] + minimums[0]) / 2.0;
+
+  for (size_t i = 1; i < bins_number; i++) {
+    minimums[i] = minimums[i - 1] + length;
+    maximums[i] = maximums[i - 1] + length;
+
+    centers[i] = (maximums[i] + minimums[i]) / 2.0;
   }
 }
 
@@ -0,0 +1,277 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   V E C T O R   S P A N   C O N T A I N E R                                                                  */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+#ifndef __VECTORSPAN_H__
+#define __VECTORSPAN_H__
+
+// System includes
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+// OpenNN includes
+
+#include "vector.h"
+
+namespace OpenNN {
+
+/// This template represents a non-owning view of a contiguous array of numbers.
+/// It is used to read and modify in place a buffer owned by another object, such as the parameters of a neural network,
+/// without gathering it into a new vector.
+/// A span is invalidated when the owner of the buffer changes its size.
+
+template <typename T> class VectorSpan {
+public:
+  // CONSTRUCTORS
+
+  // Default constructor.
+
+  explicit VectorSpan(void);
+
+  // Data constructor.
+
+  explicit VectorSpan(T *, const size_t &);
+
+  // DESTRUCTOR
+
+  virtual ~VectorSpan(void);
+
+  // OPERATORS
+
+  T &operator[](const size_t &);
+
+  const T &operator[](const size_t &) const;
+
+  void operator+=(const Vector<T> &);
+
+  // METHODS
+
+  T *data(void) const;
+
+  size_t size(void) const;
+
+  bool empty(void) const;
+
+  T *begin(void) const;
+
+  T *end(void) const;
+
+  Vector<T> to_vector(void) const;
+
+  void assign(const Vector<T> &);
+
+  void assign(const Vector<T> &, const Vector<T> &, const T &);
+
+private:
+  /// Pointer to the first element of the viewed buffer.
+
+  T *span_data;
+
+  /// Number of elements in the viewed buffer.
+
+  size_t span_size;
+};
+
+// CONSTRUCTORS
+
+/// Default constructor. It creates an empty span.
+
+template <class T>
+VectorSpan<T>::VectorSpan(void)
+    : span_data(NULL), span_size(0) {}
+
+/// Data constructor. It creates a span over an existing buffer.
+/// @param new_data Pointer to the first element of the buffer.
+/// @param new_size Number of elements in the buffer.
+
+template <class T>
+VectorSpan<T>::VectorSpan(T *new_data, const size_t &new_size)
+    : span_data(new_data), span_size(new_size) {}
+
+// DESTRUCTOR
+
+/// Destructor. The viewed buffer is not deleted.
+
+template <class T> VectorSpan<T>::~VectorSpan(void) {}
+
+// T& operator [] (const size_t&) method
+
+/// Returns a reference to the element at a given position of the span.
+/// @param i Index of element.
+
+template <class T> T &VectorSpan<T>::operator[](const size_t &i) {
+  return (span_data[i]);
+}
+
+// const T& operator [] (const size_t&) const method
+
+/// Returns a constant reference to the element at a given position of the span.
+/// @param i Index of element.
+
+template <class T> const T &VectorSpan<T>::operator[](const size_t &i) const {
+  return (span_data[i]);
+}
+
+// void operator += (const Vector<T>&) method
+
+/// Sums a vector to the viewed buffer, element by element and in place.
+/// @param other_vector Vector to be added.
+
+template <class T> void VectorSpan<T>::operator+=(const Vector<T> &other_vector) {
+// Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+  if (other_vector.size() != span_size) {
+    std::ostringstream buffer;
+
+    buffer << "OpenNN Exception: VectorSpan Template.\n"
+           << "void operator += (const Vector<T>&) method.\n"
+           << "Size of vector (" << other_vector.size()
+           << ") must be equal to size of span (" << span_size << ").\n";
+
+    throw std::logic_error(buffer.str());
+  }
+
+#endif
+
+  for (size_t i = 0; i < span_size; i++) {
+    span_data[i] += other_vector[i];
+  }
+}
+
+// T* data(void) const method
+
+/// Returns a pointer to the first element of the viewed buffer.
+
+template <class T> T *VectorSpan<T>::data(void) const { return (span_data); }
+
+// size_t size(void) const method
+
+/// Returns the number of elements in the viewed buffer.
+
+template <class T> size_t VectorSpan<T>::size(void) const {
+  return (span_size);
+}
+
+// bool empty(void) const method
+
+/// Returns true if the span does not contain any element, and false otherwise.
+
+template <class T> bool VectorSpan<T>::empty(void) const {
+  return (span_size == 0);
+}
+
+// T* begin(void) const method
+
+/// Returns an iterator to the first element of the span.
+
+template <class T> T *VectorSpan<T>::begin(void) const { return (span_data); }
+
+// T* end(void) const method
+
+/// Returns an iterator past the last element of the span.
+
+template <class T> T *VectorSpan<T>::end(void) const {
+  return (span_data + span_size);
+}
+
+// Vector<T> to_vector(void) const method
+
+/// Returns a copy of the viewed buffer as a new vector.
+
+template <class T> Vector<T> VectorSpan<T>::to_vector(void) const {
+  return (Vector<T>(span_data, span_data + span_size));
+}
+
+// void assign(const Vector<T>&) method
+
+/// Copies the elements of a vector into the viewed buffer.
+/// @param new_values Vector of new values, with the same size as the span.
+
+template <class T> void VectorSpan<T>::assign(const Vector<T> &new_values) {
+// Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+  if (new_values.size() != span_size) {
+    std::ostringstream buffer;
+
+    buffer << "OpenNN Exception: VectorSpan Template.\n"
+           << "void assign(const Vector<T>&) method.\n"
+           << "Size of vector (" << new_values.size()
+           << ") must be equal to size of span (" << span_size << ").\n";
+
+    throw std::logic_error(buffer.str());
+  }
+
+#endif
+
+  std::copy(new_values.begin(), new_values.end(), span_data);
+}
+
+// void assign(const Vector<T>&, const Vector<T>&, const T&) method
+
+/// Writes into the viewed buffer the point origin + rate*direction, without any temporary vector.
+/// This is used to evaluate trial points along a training direction.
+/// @param origin Origin point.
+/// @param direction Direction vector.
+/// @param rate Step along the direction.
+
+template <class T>
+void VectorSpan<T>::assign(const Vector<T> &origin, const Vector<T> &direction,
+                           const T &rate) {
+// Control sentence (if debug)
+
+#ifdef __OPENNN_DEBUG__
+
+  if (origin.size() != span_size || direction.size() != span_size) {
+    std::ostringstream buffer;
+
+    buffer << "OpenNN Exception: VectorSpan Template.\n"
+           << "void assign(const Vector<T>&, const Vector<T>&, const T&) "
+              "method.\n"
+           << "Size of origin and direction must be equal to size of span ("
+           << span_size << ").\n";
+
+    throw std::logic_error(buffer.str());
+  }
+
+#endif
+
+  for (size_t i = 0; i < span_size; i++) {
+    span_data[i] = origin[i] + rate * direction[i];
+  }
+}
+
+} // end namespace OpenNN
+
+#endif
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (c) 2005-2016 Roberto Lopez.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
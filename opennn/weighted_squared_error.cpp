@@ -136,6 +136,100 @@ double WeightedSquaredError::get_negatives_weight(void) const
 }
 
 
+// size_t get_training_negatives_number(void) const method
+
+/// Returns the number of negatives of the first target variable in the training instances.
+/// It is counted the first time it is needed, and it is not counted again until the data set,
+/// its instances or its variables change.
+
+size_t WeightedSquaredError::get_training_negatives_number(void) const
+{
+    const DataSetState data_set_state = get_data_set_state();
+
+    bool calculated;
+    size_t training_negatives_number;
+
+    #pragma omp critical(weighted_squared_error_negatives)
+    {
+        calculated = negatives_numbers.training_calculated && data_set_state == negatives_numbers.data_set_state;
+
+        training_negatives_number = negatives_numbers.training;
+    }
+
+    if(calculated)
+    {
+        return(training_negatives_number);
+    }
+
+    const Variables& variables = data_set_pointer->get_variables();
+    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+
+    training_negatives_number = data_set_pointer->calculate_training_negatives(targets_indices[0]);
+
+    #pragma omp critical(weighted_squared_error_negatives)
+    {
+        if(!(data_set_state == negatives_numbers.data_set_state))
+        {
+            negatives_numbers.data_set_state = data_set_state;
+            negatives_numbers.training_calculated = false;
+            negatives_numbers.selection_calculated = false;
+        }
+
+        negatives_numbers.training = training_negatives_number;
+        negatives_numbers.training_calculated = true;
+    }
+
+    return(training_negatives_number);
+}
+
+
+// size_t get_selection_negatives_number(void) const method
+
+/// Returns the number of negatives of the first target variable in the selection instances.
+/// It is counted the first time it is needed, and it is not counted again until the data set,
+/// its instances or its variables change.
+
+size_t WeightedSquaredError::get_selection_negatives_number(void) const
+{
+    const DataSetState data_set_state = get_data_set_state();
+
+    bool calculated;
+    size_t selection_negatives_number;
+
+    #pragma omp critical(weighted_squared_error_negatives)
+    {
+        calculated = negatives_numbers.selection_calculated && data_set_state == negatives_numbers.data_set_state;
+
+        selection_negatives_number = negatives_numbers.selection;
+    }
+
+    if(calculated)
+    {
+        return(selection_negatives_number);
+    }
+
+    const Variables& variables = data_set_pointer->get_variables();
+    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+
+    selection_negatives_number = data_set_pointer->calculate_selection_negatives(targets_indices[0]);
+
+    #pragma omp critical(weighted_squared_error_negatives)
+    {
+        if(!(data_set_state == negatives_numbers.data_set_state))
+        {
+            negatives_numbers.data_set_state = data_set_state;
+            negatives_numbers.training_calculated = false;
+            negatives_numbers.selection_calculated = false;
+        }
+
+        negatives_numbers.selection = selection_negatives_number;
+        negatives_numbers.selection_calculated = true;
+    }
+
+    return(selection_negatives_number);
+}
+
+
 // void check(void) const method
 
 /// Checks that there are a neural network and a data set associated to the weighted squared error,
@@ -483,66 +577,46 @@ double WeightedSquaredError::calculate_error(void) const
 
     const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
     // Data set stuff
 
-    const Instances& instances = data_set_pointer->get_instances();
+    if(data_set_pointer->is_out_of_core())
+    {
+        const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-    const size_t training_instances_number = instances.count_training_instances_number();
+        return(calculate_instances_error(training_indices, multilayer_perceptron_pointer->arrange_parameters()));
+    }
 
-    const Vector<size_t> training_indices = instances.arrange_training_indices();
+    const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+    const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-    size_t training_index;
-
-    const Variables& variables = data_set_pointer->get_variables();
-
-    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+    const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
     // Weighted squared error stuff
 
-    Vector<double> inputs(inputs_number);
-    Vector<double> outputs(outputs_number);
-    Vector<double> targets(outputs_number);
-
-    int i = 0;
-
-    double error = 0;
+    const size_t rows_number = outputs.get_rows_number();
+    const size_t columns_number = outputs.get_columns_number();
 
-    double sum_squared_error = 0.0;    
+    Vector<double> rows_sum_squared_error(rows_number, 0.0);
 
-    const double positives_w = positives_weight;
-    const double negatives_w = negatives_weight;
-
-#pragma omp parallel for private(i, training_index, inputs, outputs, targets, error) reduction(+:sum_squared_error)
-
-    for(i = 0; i < (int)training_instances_number; i++)
+    for(size_t j = 0; j < columns_number; j++)
     {
-        training_index = training_indices[i];
-
-        // Input vector
-
-        inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-        // Output vector
-
-        outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
-
-        // Target vector
-
-        targets = data_set_pointer->get_instance(training_index, targets_indices);
+        for(size_t i = 0; i < rows_number; i++)
+        {
+            rows_sum_squared_error[i] += (outputs(i,j) - targets(i,j))*(outputs(i,j) - targets(i,j));
+        }
+    }
 
-        // Sum squared error
+    double sum_squared_error = 0.0;
 
-        if(targets[0] == 1.0)
+    for(size_t i = 0; i < rows_number; i++)
+    {
+        if(targets(i,0) == 1.0)
         {
-            error = positives_w*outputs.calculate_sum_squared_error(targets);
+            sum_squared_error += positives_weight*rows_sum_squared_error[i];
         }
-        else if(targets[0] == 0.0)
+        else if(targets(i,0) == 0.0)
         {
-            error = negatives_w*outputs.calculate_sum_squared_error(targets);
+            sum_squared_error += negatives_weight*rows_sum_squared_error[i];
         }
         else
         {
@@ -554,11 +628,9 @@ double WeightedSquaredError::calculate_error(void) const
 
             throw std::logic_error(buffer.str());
         }
-
-        sum_squared_error += error;
     }
 
-    const size_t negatives = data_set_pointer->calculate_training_negatives(targets_indices[0]);
+    const size_t negatives = get_training_negatives_number();
 
     const double normalization_coefficient = negatives*negatives_weight*0.5;
 
@@ -605,66 +677,46 @@ double WeightedSquaredError::calculate_error(const Vector<double>& parameters) c
 
     const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
-
     // Data set stuff
 
-    const Instances& instances = data_set_pointer->get_instances();
-
-    const size_t training_instances_number = instances.count_training_instances_number();
-
-    const Vector<size_t> training_indices = instances.arrange_training_indices();
+    if(data_set_pointer->is_out_of_core())
+    {
+        const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-    size_t training_index;
+        return(calculate_instances_error(training_indices, parameters));
+    }
 
-    const Variables& variables = data_set_pointer->get_variables();
+    const Matrix<double>& inputs = data_set_pointer->get_training_input_data();
+    const Matrix<double>& targets = data_set_pointer->get_training_target_data();
 
-    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+    const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
 
     // Weighted squared error stuff
 
-    Vector<double> inputs(inputs_number);
-    Vector<double> outputs(outputs_number);
-    Vector<double> targets(outputs_number);
+    const size_t rows_number = outputs.get_rows_number();
+    const size_t columns_number = outputs.get_columns_number();
 
-    double sum_squared_error = 0.0;
-
-    int i = 0;
-
-    double error = 0;
+    Vector<double> rows_sum_squared_error(rows_number, 0.0);
 
-    const double positives_w = positives_weight;
-    const double negatives_w = negatives_weight;
-
-#pragma omp parallel for private(i, training_index, inputs, outputs, targets, error) reduction(+:sum_squared_error)
-
-    for(i = 0; i < (int)training_instances_number; i++)
+    for(size_t j = 0; j < columns_number; j++)
     {
-        training_index = training_indices[i];
-
-        // Input vector
-
-        inputs = data_set_pointer->get_instance(training_index, inputs_indices);
-
-        // Output vector
-
-        outputs = multilayer_perceptron_pointer->calculate_outputs(inputs, parameters);
-
-        // Target vector
-
-        targets = data_set_pointer->get_instance(training_index, targets_indices);
+        for(size_t i = 0; i < rows_number; i++)
+        {
+            rows_sum_squared_error[i] += (outputs(i,j) - targets(i,j))*(outputs(i,j) - targets(i,j));
+        }
+    }
 
-        // Sum squared error
+    double sum_squared_error = 0.0;
 
-        if(targets[0] == 1.0)
+    for(size_t i = 0; i < rows_number; i++)
+    {
+        if(targets(i,0) == 1.0)
         {
-            error = positives_w*outputs.calculate_sum_squared_error(targets);
+            sum_squared_error += positives_weight*rows_sum_squared_error[i];
         }
-        else if(targets[0] == 0.0)
+        else if(targets(i,0) == 0.0)
         {
-            error = negatives_w*outputs.calculate_sum_squared_error(targets);
+            sum_squared_error += negatives_weight*rows_sum_squared_error[i];
         }
         else
         {
@@ -676,12 +728,9 @@ double WeightedSquaredError::calculate_error(const Vector<double>& parameters) c
 
             throw std::logic_error(buffer.str());
         }
-
-        sum_squared_error += error;
-
     }
 
-    const size_t negatives = data_set_pointer->calculate_training_negatives(targets_indices[0]);
+    const size_t negatives = get_training_negatives_number();
 
     const double normalization_coefficient = negatives*negatives_weight*0.5;
 
@@ -706,8 +755,7 @@ double WeightedSquaredError::calculate_selection_error(void) const
 
     const MultilayerPerceptron* multilayer_perceptron_pointer = neural_network_pointer->get_multilayer_perceptron_pointer();
 
-    const size_t inputs_number = multilayer_perceptron_pointer->get_inputs_number();
-    const size_t outputs_number = multilayer_perceptron_pointer->get_outputs_number();
+    // Data set stuff
 
     const Instances& instances = data_set_pointer->get_instances();
 
@@ -718,71 +766,60 @@ double WeightedSquaredError::calculate_selection_error(void) const
         return(0.0);
     }
 
-    const Vector<size_t> selection_indices = instances.arrange_selection_indices();
-
-    size_t selection_index;
+    if(data_set_pointer->is_out_of_core())
+    {
+        const Vector<size_t> selection_indices = data_set_pointer->get_instances().arrange_selection_indices();
 
-    const Variables& variables = data_set_pointer->get_variables();
+        // The error of each batch is normalized by the number of training negatives
 
-    const Vector<size_t> inputs_indices = variables.arrange_inputs_indices();
-    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
+        return(calculate_instances_error(selection_indices, multilayer_perceptron_pointer->arrange_parameters())*(double)get_training_negatives_number()/(double)get_selection_negatives_number());
+    }
 
-    Vector<double> inputs(inputs_number);
-    Vector<double> outputs(outputs_number);
-    Vector<double> targets(outputs_number);
+    const Matrix<double>& inputs = data_set_pointer->get_selection_input_data();
+    const Matrix<double>& targets = data_set_pointer->get_selection_target_data();
 
-    double selection_loss = 0.0;
+    const Matrix<double> outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
 
-    double loss = 0.0;
+    // Weighted squared error stuff
 
-    int i = 0;
+    const size_t rows_number = outputs.get_rows_number();
+    const size_t columns_number = outputs.get_columns_number();
 
-    const double positives_w = positives_weight;
-    const double negatives_w = negatives_weight;
+    Vector<double> rows_sum_squared_error(rows_number, 0.0);
 
-#pragma omp parallel for private(i, selection_index, inputs, outputs, targets, loss) reduction(+:selection_loss)
-
-    for(i = 0; i < (int)selection_instances_number; i++)
+    for(size_t j = 0; j < columns_number; j++)
     {
-        selection_index = selection_indices[i];
-
-        // Input vector
-
-        inputs = data_set_pointer->get_instance(selection_index, inputs_indices);
-
-        // Output vector
-
-        outputs = multilayer_perceptron_pointer->calculate_outputs(inputs);
-
-        // Target vector
-
-        targets = data_set_pointer->get_instance(selection_index, targets_indices);
+        for(size_t i = 0; i < rows_number; i++)
+        {
+            rows_sum_squared_error[i] += (outputs(i,j) - targets(i,j))*(outputs(i,j) - targets(i,j));
+        }
+    }
 
-        // Sum squared error
+    double selection_loss = 0.0;
 
-        if(targets[0] == 1.0)
+    for(size_t i = 0; i < rows_number; i++)
+    {
+        if(targets(i,0) == 1.0)
         {
-            loss = positives_w*outputs.calculate_sum_squared_error(targets);
+            selection_loss += positives_weight*rows_sum_squared_error[i];
         }
-        else if(targets[0] == 0.0)
+        else if(targets(i,0) == 0.0)
         {
-            loss = negatives_w*outputs.calculate_sum_squared_error(targets);
+            selection_loss += negatives_weight*rows_sum_squared_error[i];
         }
         else
         {
             std::ostringstream buffer;
 
             buffer << "OpenNN Exception: WeightedSquaredError class.\n"
-                   << "double calculate_error(const Vector<double>&) const method.\n"
+                   << "double calculate_selection_error(void) const method.\n"
                    << "Target is neither a positive nor a negative.\n";
 
             throw std::logic_error(buffer.str());
         }
-
-        selection_loss += loss;
     }
 
-    const size_t negatives = data_set_pointer->calculate_selection_negatives(targets_indices[0]);
+    const size_t negatives = get_selection_negatives_number();
 
     const double normalization_coefficient = negatives*negatives_weight*0.5;
 
@@ -1127,9 +1164,6 @@ Vector<double> WeightedSquaredError::calculate_output_gradient(const Vector<doub
 
     //size_t training_index;
 
-    const Variables& variables = data_set_pointer->get_variables();
-    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
 //    for(size_t i = 0; i < training_instances_number; i++)
 //    {
         //targets = data_set_pointer->get_instance(training_index, targets_indices);
@@ -1154,7 +1188,7 @@ Vector<double> WeightedSquaredError::calculate_output_gradient(const Vector<doub
     }
 //    }
 
-    const size_t negatives = data_set_pointer->calculate_training_negatives(targets_indices[0]);
+    const size_t negatives = get_training_negatives_number();
 
     const double normalization_coefficient = negatives*negatives_weight*0.5;
 
@@ -1162,6 +1196,57 @@ Vector<double> WeightedSquaredError::calculate_output_gradient(const Vector<doub
 }
 
 
+// Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the weighted squared error gradient with respect to the outputs, for a batch of instances.
+/// The number of training negatives is counted once for the whole batch.
+/// @param outputs Matrix of outputs of the model. Each row corresponds to one instance.
+/// @param targets Matrix of targets of the data set. Each row corresponds to one instance.
+
+Matrix<double> WeightedSquaredError::calculate_output_gradient(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    const size_t rows_number = outputs.get_rows_number();
+    const size_t columns_number = outputs.get_columns_number();
+
+    const size_t negatives = get_training_negatives_number();
+
+    const double normalization_coefficient = negatives*negatives_weight*0.5;
+
+    Matrix<double> output_gradient(rows_number, columns_number);
+
+    double weight;
+
+    for(size_t i = 0; i < rows_number; i++)
+    {
+        if(targets(i,0) == 1.0)
+        {
+            weight = positives_weight;
+        }
+        else if(targets(i,0) == 0.0)
+        {
+            weight = negatives_weight;
+        }
+        else
+        {
+            std::ostringstream buffer;
+
+            buffer << "OpenNN Exception: WeightedSquaredError class.\n"
+                   << "Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const method.\n"
+                   << "Target is neither a positive nor a negative.\n";
+
+            throw std::logic_error(buffer.str());
+        }
+
+        for(size_t j = 0; j < columns_number; j++)
+        {
+            output_gradient(i,j) = (outputs(i,j)-targets(i,j))*weight*2.0/normalization_coefficient;
+        }
+    }
+
+    return(output_gradient);
+}
+
+
 // Matrix<double> calculate_output_Hessian(void) const method
 
 /// @todo
@@ -1183,10 +1268,7 @@ Matrix<double> WeightedSquaredError::calculate_output_Hessian(const Vector<doubl
 
     //size_t training_index;
 
-    const Variables& variables = data_set_pointer->get_variables();
-    const Vector<size_t> targets_indices = variables.arrange_targets_indices();
-
-    const size_t negatives = data_set_pointer->calculate_training_negatives(targets_indices[0]);
+    const size_t negatives = get_training_negatives_number();
 
     const double normalization_coefficient = negatives*negatives_weight*0.5;
 
@@ -1386,26 +1468,73 @@ Vector<double> WeightedSquaredError::calculate_gradient_with_normalization(const
     return(gradient);
 }
 
+// double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method
+
+/// Returns the contribution of a batch of instances to the weighted squared error.
+/// The normalization coefficient is the one of all the training instances.
+/// @param outputs Matrix of outputs from the multilayer perceptron. Each row corresponds to one instance.
+/// @param targets Matrix of targets from the data set. Each row corresponds to one instance.
+
+double WeightedSquaredError::calculate_batch_error(const Matrix<double>& outputs, const Matrix<double>& targets) const
+{
+    const size_t rows_number = outputs.get_rows_number();
+    const size_t columns_number = outputs.get_columns_number();
+
+    const size_t negatives = get_training_negatives_number();
+
+    const double normalization_coefficient = negatives*negatives_weight*0.5;
+
+    double sum_squared_error = 0.0;
+
+    double weight;
+
+    for(size_t i = 0; i < rows_number; i++)
+    {
+        if(targets(i,0) == 1.0)
+        {
+            weight = positives_weight;
+        }
+        else if(targets(i,0) == 0.0)
+        {
+            weight = negatives_weight;
+        }
+        else
+        {
+            std::ostringstream buffer;
+
+            buffer << "OpenNN Exception: WeightedSquaredError class.\n"
+                   << "double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const method.\n"
+                   << "Target is neither a positive nor a negative.\n";
+
+            throw std::logic_error(buffer.str());
+        }
+
+        for(size_t j = 0; j < columns_number; j++)
+        {
+            sum_squared_error += weight*(outputs(i,j)-targets(i,j))*(outputs(i,j)-targets(i,j));
+        }
+    }
+
+    return(sum_squared_error/normalization_coefficient);
+}
+
+
 // FirstOrderPerformance calculate_first_order_loss(void) const method
 
-/// @todo
+/// Returns the weighted squared error and its gradient on the training instances,
+/// both computed from a single forward propagation of the instances.
 
 ErrorTerm::FirstOrderPerformance WeightedSquaredError::calculate_first_order_loss(void) const
 {
-    // Control sentence
-
-#ifdef __OPENNN_DEBUG__
+    #ifdef __OPENNN_DEBUG__
 
     check();
 
-#endif
-
-    FirstOrderPerformance first_order_loss;
+    #endif
 
-    first_order_loss.loss = calculate_error();
-    first_order_loss.gradient = calculate_gradient();
+    const Vector<size_t> training_indices = data_set_pointer->get_instances().arrange_training_indices();
 
-    return(first_order_loss);
+    return(calculate_batch_first_order_loss(training_indices));
 }
 
 
@@ -1423,10 +1552,12 @@ ErrorTerm::SecondOrderPerformance WeightedSquaredError::calculate_second_order_l
 
 #endif
 
+    const FirstOrderPerformance first_order_loss = calculate_first_order_loss();
+
     SecondOrderPerformance second_order_loss;
 
-    second_order_loss.loss = calculate_error();
-    second_order_loss.gradient = calculate_gradient();
+    second_order_loss.loss = first_order_loss.loss;
+    second_order_loss.gradient = first_order_loss.gradient;
     second_order_loss.Hessian = calculate_Hessian();
 
     return(second_order_loss);
@@ -1523,7 +1654,7 @@ Vector<double> WeightedSquaredError::calculate_terms(void) const
         }
     }
 
-    const size_t negatives = data_set_pointer->calculate_training_negatives(targets_indices[0]);
+    const size_t negatives = get_training_negatives_number();
 
     const double normalization_coefficient = negatives*negatives_weight*0.5;
 
@@ -1707,8 +1838,7 @@ Matrix<double> WeightedSquaredError::calculate_terms_Jacobian(void) const
         terms_Jacobian.set_row(i, point_gradient);
     }
 
-    const double negatives = training_instances_number
-                           - data_set_pointer->arrange_training_target_data().arrange_column(0).calculate_sum();
+    const size_t negatives = get_training_negatives_number();
 
     const double normalization_coefficient = negatives*negatives_weight*0.5;
 
@@ -83,6 +83,9 @@ public:
    double get_positives_weight(void) const;
    double get_negatives_weight(void) const;
 
+   size_t get_training_negatives_number(void) const;
+   size_t get_selection_negatives_number(void) const;
+
    // Set methods
 
    // Checking methods
@@ -112,11 +115,14 @@ public:
    double calculate_selection_error(const double&) const;
 
    Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&) const;
+   Matrix<double> calculate_output_gradient(const Matrix<double>&, const Matrix<double>&) const;
    Matrix<double> calculate_output_Hessian(const Vector<double>&, const Vector<double>&) const;
 
    Vector<double> calculate_output_gradient(const Vector<double>&, const Vector<double>&, const double&) const;
    Vector<double> calculate_gradient_with_normalization(const double&) const;
 
+   double calculate_batch_error(const Matrix<double>&, const Matrix<double>&) const;
+
    FirstOrderPerformance calculate_first_order_loss(void) const;
    SecondOrderPerformance calculate_second_order_loss(void) const;
 
@@ -153,7 +159,41 @@ private:
 
    double negatives_weight;
 
+   /// Numbers of negatives in the training and the selection instances.
+   /// They are counted on demand and kept until the data set changes.
+
+   struct NegativesNumbers
+   {
+      /// Default constructor.
+
+      NegativesNumbers(void) : training_calculated(false), training(0), selection_calculated(false), selection(0)
+      {
+      }
+
+      /// State of the data set when the negatives were counted.
+
+      DataSetState data_set_state;
+
+      /// True if the number of training negatives is up to date.
+
+      bool training_calculated;
+
+      /// Number of negatives in the training instances.
+
+      size_t training;
+
+      /// True if the number of selection negatives is up to date.
+
+      bool selection_calculated;
+
+      /// Number of negatives in the selection instances.
+
+      size_t selection;
+   };
+
+   /// Cached numbers of negatives.
 
+   mutable NegativesNumbers negatives_numbers;
 };
 
 }
@@ -0,0 +1,359 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   A D A P T I V E   M O M E N T   E S T I M A T I O N   T E S T   C L A S S                                  */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+// Unit testing includes
+
+#include "adaptive_moment_estimation_test.h"
+
+using namespace OpenNN;
+
+
+// GENERAL CONSTRUCTOR
+
+AdaptiveMomentEstimationTest::AdaptiveMomentEstimationTest(void) : UnitTesting()
+{
+}
+
+
+// DESTRUCTOR
+
+AdaptiveMomentEstimationTest::~AdaptiveMomentEstimationTest(void)
+{
+}
+
+
+// METHODS
+
+void AdaptiveMomentEstimationTest::test_constructor(void)
+{
+   message += "test_constructor\n";
+
+   LossIndex pf;
+
+   // Default constructor
+
+   AdaptiveMomentEstimation ame1;
+   assert_true(ame1.has_loss_index() == false, LOG);
+
+   // Loss index constructor
+
+   AdaptiveMomentEstimation ame2(&pf);
+   assert_true(ame2.has_loss_index() == true, LOG);
+}
+
+
+void AdaptiveMomentEstimationTest::test_destructor(void)
+{
+   message += "test_destructor\n";
+}
+
+
+void AdaptiveMomentEstimationTest::test_set_reserve_all_training_history(void)
+{
+   message += "test_set_reserve_all_training_history\n";
+
+   AdaptiveMomentEstimation ame;
+
+   ame.set_reserve_all_training_history(true);
+
+   assert_true(ame.get_reserve_loss_history() == true, LOG);
+   assert_true(ame.get_reserve_selection_loss_history() == true, LOG);
+   assert_true(ame.get_reserve_learning_rate_history() == true, LOG);
+   assert_true(ame.get_reserve_elapsed_time_history() == true, LOG);
+}
+
+
+void AdaptiveMomentEstimationTest::test_set_learning_rate_schedule(void)
+{
+   message += "test_set_learning_rate_schedule\n";
+
+   AdaptiveMomentEstimation ame;
+
+   // Test
+
+   ame.set_learning_rate_schedule("InverseTime");
+
+   assert_true(ame.get_learning_rate_schedule() == AdaptiveMomentEstimation::InverseTime, LOG);
+   assert_true(ame.write_learning_rate_schedule() == "InverseTime", LOG);
+
+   // Test
+
+   ame.set_learning_rate_schedule("Exponential");
+
+   assert_true(ame.get_learning_rate_schedule() == AdaptiveMomentEstimation::Exponential, LOG);
+}
+
+
+void AdaptiveMomentEstimationTest::test_set_batch_size(void)
+{
+   message += "test_set_batch_size\n";
+
+   AdaptiveMomentEstimation ame;
+
+   bool exception_thrown;
+
+   // Test
+
+   ame.set_batch_size(16);
+
+   assert_true(ame.get_batch_size() == 16, LOG);
+
+   // Test
+
+   exception_thrown = false;
+
+   try
+   {
+      ame.set_batch_size(0);
+   }
+   catch(const std::logic_error&)
+   {
+      exception_thrown = true;
+   }
+
+   assert_true(exception_thrown, LOG);
+   assert_true(ame.get_batch_size() == 16, LOG);
+}
+
+
+void AdaptiveMomentEstimationTest::test_calculate_learning_rate(void)
+{
+   message += "test_calculate_learning_rate\n";
+
+   AdaptiveMomentEstimation ame;
+
+   ame.set_initial_learning_rate(0.1);
+   ame.set_learning_rate_decay(0.5);
+
+   // Test
+
+   ame.set_learning_rate_schedule(AdaptiveMomentEstimation::Constant);
+
+   assert_true(ame.calculate_learning_rate(10) == 0.1, LOG);
+
+   // Test
+
+   ame.set_learning_rate_schedule(AdaptiveMomentEstimation::InverseTime);
+
+   assert_true(ame.calculate_learning_rate(0) == 0.1, LOG);
+   assert_true(fabs(ame.calculate_learning_rate(2) - 0.05) < 1.0e-12, LOG);
+
+   // Test
+
+   ame.set_learning_rate_schedule(AdaptiveMomentEstimation::Exponential);
+
+   assert_true(fabs(ame.calculate_learning_rate(2) - 0.1*exp(-1.0)) < 1.0e-12, LOG);
+}
+
+
+void AdaptiveMomentEstimationTest::test_perform_training(void)
+{
+   message += "test_perform_training\n";
+
+   DataSet ds(100, 2, 1);
+   ds.randomize_data_normal();
+
+   NeuralNetwork nn(2, 2, 1);
+   nn.randomize_parameters_normal();
+
+   LossIndex pf(&nn, &ds);
+
+   pf.destruct_all_terms();
+   pf.set_error_type(LossIndex::MEAN_SQUARED_ERROR);
+
+   AdaptiveMomentEstimation ame(&pf);
+
+   ame.set_display(false);
+
+   AdaptiveMomentEstimation::AdaptiveMomentEstimationResults* results_pointer;
+
+   double old_loss;
+   double loss;
+
+   Vector<double> parameters;
+   Vector<double> gradient;
+
+   // Test
+
+   old_loss = pf.calculate_loss();
+
+   ame.set_batch_size(10);
+   ame.set_maximum_epochs_number(10);
+
+   results_pointer = ame.perform_training();
+
+   loss = pf.calculate_loss();
+
+   assert_true(loss < old_loss, LOG);
+   assert_true(results_pointer->epochs_number == 10, LOG);
+   assert_true(results_pointer->loss_history.size() == 11, LOG);
+
+   delete results_pointer;
+
+   // Test
+
+   nn.randomize_parameters_normal();
+
+   parameters = nn.arrange_parameters();
+   gradient = pf.calculate_gradient();
+
+   ame.set_batch_size(1000);
+   ame.set_maximum_epochs_number(1);
+
+   results_pointer = ame.perform_training();
+
+   // The first bias-corrected step moves every parameter by the learning rate against the sign of its gradient
+
+   for(size_t i = 0; i < parameters.size(); i++)
+   {
+      parameters[i] -= 0.001*gradient[i]/(fabs(gradient[i]) + 1.0e-8);
+   }
+
+   assert_true((nn.arrange_parameters() - parameters).calculate_absolute_value() < 1.0e-6, LOG);
+
+   delete results_pointer;
+
+   // Performance goal
+
+   parameters = nn.arrange_parameters();
+
+   ame.set_loss_goal(1.0e99);
+
+   results_pointer = ame.perform_training();
+
+   assert_true(results_pointer->stopping_condition == TrainingAlgorithm::PerformanceGoal, LOG);
+   assert_true(nn.arrange_parameters() == parameters, LOG);
+
+   delete results_pointer;
+
+   // No training instances
+
+   ds.get_instances_pointer()->set_selection();
+
+   bool exception_thrown = false;
+
+   try
+   {
+      results_pointer = ame.perform_training();
+
+      delete results_pointer;
+   }
+   catch(const std::logic_error&)
+   {
+      exception_thrown = true;
+   }
+
+   assert_true(exception_thrown, LOG);
+}
+
+
+void AdaptiveMomentEstimationTest::test_to_XML(void)
+{
+   message += "test_to_XML\n";
+
+   AdaptiveMomentEstimation ame;
+
+   tinyxml2::XMLDocument* document;
+
+   // Test
+
+   document = ame.to_XML();
+   assert_true(document != NULL, LOG);
+
+   delete document;
+}
+
+
+void AdaptiveMomentEstimationTest::test_from_XML(void)
+{
+   message += "test_from_XML\n";
+
+   AdaptiveMomentEstimation ame1;
+   AdaptiveMomentEstimation ame2;
+
+   tinyxml2::XMLDocument* document;
+
+   // Test
+
+   ame1.set_batch_size(7);
+   ame1.set_initial_learning_rate(0.5);
+   ame1.set_learning_rate_schedule(AdaptiveMomentEstimation::Exponential);
+   ame1.set_learning_rate_decay(0.25);
+   ame1.set_beta_1(0.75);
+   ame1.set_beta_2(0.875);
+   ame1.set_epsilon(1.0e-6);
+   ame1.set_maximum_epochs_number(3);
+
+   document = ame1.to_XML();
+
+   ame2.from_XML(*document);
+
+   delete document;
+
+   assert_true(ame2.get_batch_size() == 7, LOG);
+   assert_true(ame2.get_initial_learning_rate() == 0.5, LOG);
+   assert_true(ame2.get_learning_rate_schedule() == AdaptiveMomentEstimation::Exponential, LOG);
+   assert_true(ame2.get_learning_rate_decay() == 0.25, LOG);
+   assert_true(ame2.get_beta_1() == 0.75, LOG);
+   assert_true(ame2.get_beta_2() == 0.875, LOG);
+   assert_true(ame2.get_epsilon() == 1.0e-6, LOG);
+   assert_true(ame2.get_maximum_epochs_number() == 3, LOG);
+}
+
+
+void AdaptiveMomentEstimationTest::run_test_case(void)
+{
+   message += "Running adaptive moment estimation test case...\n";
+
+   // Constructor and destructor methods
+
+   test_constructor();
+   test_destructor();
+
+   // Set methods
+
+   test_set_reserve_all_training_history();
+   test_set_learning_rate_schedule();
+   test_set_batch_size();
+
+   // Training methods
+
+   test_calculate_learning_rate();
+
+   test_perform_training();
+
+   // Serialization methods
+
+   test_to_XML();
+   test_from_XML();
+
+   message += "End of adaptive moment estimation test case.\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2016 Roberto Lopez.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
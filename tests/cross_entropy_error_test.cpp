@@ -134,6 +134,39 @@ void CrossEntropyErrorTest::test_calculate_loss(void)
 
    assert_true(cee.calculate_error() > 0, LOG);
 
+   // Test
+
+   nn.set(3, 4, 2);
+
+   mlpp = nn.get_multilayer_perceptron_pointer();
+
+   mlpp->get_layer_pointer(0)->set_activation_function(Perceptron::Logistic);
+   mlpp->get_layer_pointer(1)->set_activation_function(Perceptron::Logistic);
+
+   nn.randomize_parameters_normal();
+
+   parameters = nn.arrange_parameters();
+
+   ds.set(300, 3, 2);
+   ds.randomize_data_uniform(0.0, 1.0);
+   ds.get_instances_pointer()->split_random_indices();
+
+   ds.set_data_file_name("../data/data.dat");
+   ds.save_data_binary();
+
+   DataSet ds_out_of_core;
+
+   ds_out_of_core.set_data_file_name("../data/data.dat");
+   ds_out_of_core.load_data_out_of_core(64, 2);
+
+   CrossEntropyError cee_out_of_core(&nn, &ds_out_of_core);
+
+   assert_true(fabs(cee_out_of_core.calculate_error() - cee.calculate_error()) < 1.0e-9, LOG);
+   assert_true(fabs(cee_out_of_core.calculate_error(parameters*2.0) - cee.calculate_error(parameters*2.0)) < 1.0e-9, LOG);
+   assert_true(fabs(cee_out_of_core.calculate_selection_error() - cee.calculate_selection_error()) < 1.0e-9, LOG);
+
+   assert_true(!ds_out_of_core.has_split_data(Instances::Training), LOG);
+   assert_true(!ds_out_of_core.has_split_data(Instances::Selection), LOG);
 }
 
 
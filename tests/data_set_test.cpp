@@ -233,6 +233,54 @@ void DataSetTest::test_arrange_target_data(void)
 }
 
 
+void DataSetTest::test_get_training_input_data(void)
+{
+   message += "test_get_training_input_data\n";
+
+   DataSet ds(10, 3, 2);
+
+   ds.randomize_data_normal();
+
+   Instances* instances_pointer = ds.get_instances_pointer();
+   Variables* variables_pointer = ds.get_variables_pointer();
+
+   // Test
+
+   assert_true(ds.get_training_input_data() == ds.arrange_training_input_data(), LOG);
+   assert_true(ds.get_training_target_data() == ds.arrange_training_target_data(), LOG);
+   assert_true(ds.get_selection_input_data() == ds.arrange_selection_input_data(), LOG);
+   assert_true(ds.get_selection_target_data() == ds.arrange_selection_target_data(), LOG);
+   assert_true(ds.get_testing_input_data() == ds.arrange_testing_input_data(), LOG);
+   assert_true(ds.get_testing_target_data() == ds.arrange_testing_target_data(), LOG);
+
+   // Test
+
+   instances_pointer->set_training();
+
+   assert_true(ds.get_training_input_data().get_rows_number() == 10, LOG);
+   assert_true(ds.get_selection_input_data().empty(), LOG);
+
+   instances_pointer->set_use(0, Instances::Selection);
+
+   assert_true(ds.get_training_input_data() == ds.arrange_training_input_data(), LOG);
+   assert_true(ds.get_selection_target_data() == ds.arrange_selection_target_data(), LOG);
+
+   // Test
+
+   variables_pointer->set_use(0, Variables::Unused);
+
+   assert_true(ds.get_training_input_data().get_columns_number() == 2, LOG);
+   assert_true(ds.get_training_input_data() == ds.arrange_training_input_data(), LOG);
+
+   // Test
+
+   ds.initialize_data(1.0);
+
+   assert_true(ds.get_training_input_data() == 1.0, LOG);
+   assert_true(ds.get_training_target_data() == 1.0, LOG);
+}
+
+
 void DataSetTest::test_get_instance(void)
 {
    message += "test_get_instance\n";
@@ -899,6 +947,59 @@ void DataSetTest::test_subtract_constant_variables(void)
 void DataSetTest::test_subtract_repeated_instances(void)
 {
    message += "test_subtract_repeated_instances\n"; 
+
+   DataSet ds;
+
+   Matrix<double> data;
+
+   Vector< Vector<size_t> > repeated_instances_groups;
+   Vector<size_t> repeated_instances;
+
+   // Test
+
+   data.set(7, 3);
+   data.randomize_normal();
+
+   data.set_row(3, data.arrange_row(1));
+   data.set_row(6, data.arrange_row(1));
+   data.set_row(5, data.arrange_row(0));
+
+   data(2,2) = 0.0;
+   data(4,0) = data(2,0);
+   data(4,1) = data(2,1);
+   data(4,2) = -0.0;
+
+   ds.set(data);
+
+   repeated_instances_groups = ds.calculate_repeated_instances_groups();
+
+   assert_true(repeated_instances_groups.size() == 3, LOG);
+   assert_true(repeated_instances_groups[0].size() == 2, LOG);
+   assert_true(repeated_instances_groups[0][0] == 0, LOG);
+   assert_true(repeated_instances_groups[0][1] == 5, LOG);
+   assert_true(repeated_instances_groups[1].size() == 3, LOG);
+   assert_true(repeated_instances_groups[1][2] == 6, LOG);
+   assert_true(repeated_instances_groups[2][1] == 4, LOG);
+
+   ds.get_instances_pointer()->set_use(6, Instances::Unused);
+
+   repeated_instances = ds.unuse_repeated_instances();
+
+   assert_true(repeated_instances.size() == 3, LOG);
+   assert_true(repeated_instances[0] == 3, LOG);
+   assert_true(repeated_instances[1] == 4, LOG);
+   assert_true(repeated_instances[2] == 5, LOG);
+   assert_true(ds.get_instances().count_unused_instances_number() == 4, LOG);
+
+   // Test
+
+   data(2,2) = 1.0;
+
+   ds.set_data(data);
+
+   ds.get_variables_pointer()->set_use(2, Variables::Unused);
+
+   assert_true(ds.calculate_repeated_instances_groups().size() == 3, LOG);
 }
 
 
@@ -1470,21 +1571,53 @@ void DataSetTest::test_balance_function_regression_targets_distribution(void)
     assert_true(unused_instances.size() == 1000, LOG);
 }
 
-/*
-void DataSetTest::test_calculate_instances_distances()
+void DataSetTest::test_calculate_instances_distances(void)
 {
     message += "test_calculate_instances_distances\n";
 
-    DataSet ds(5, 5, 2);
+    DataSet ds(300, 2, 1);
     ds.randomize_data_normal();
 
+    const Matrix<double>& data = ds.get_data();
+
+    const size_t nearest_neighbors_number = 4;
+
     Matrix<double> distances;
+    Matrix<size_t> nearest_neighbors;
 
-    //distances = ds.calculate_instances_distances();
+    Vector<double> instance_distances(300);
 
-    assert_true(distances(0, 0) == 0, LOG);
-    assert_true(distances(1, 1) == 0, LOG);
-    assert_true(distances(0, 1) == distances(1, 0), LOG);
+    // Test
+
+    distances = ds.calculate_instances_distances(nearest_neighbors_number);
+    nearest_neighbors = ds.calculate_nearest_neighbors(nearest_neighbors_number);
+
+    assert_true(distances.get_rows_number() == 300, LOG);
+    assert_true(distances.get_columns_number() == nearest_neighbors_number, LOG);
+
+    for(size_t i = 0; i < 300; i += 37)
+    {
+        for(size_t j = 0; j < 300; j++)
+        {
+            instance_distances[j] = (i == j) ? 1.0e99 : data.arrange_row(i).calculate_distance(data.arrange_row(j));
+        }
+
+        const Vector<size_t> minimal_indices = instance_distances.calculate_minimal_indices(nearest_neighbors_number);
+
+        for(size_t k = 0; k < nearest_neighbors_number; k++)
+        {
+            assert_true(nearest_neighbors(i, k) == minimal_indices[k], LOG);
+            assert_true(fabs(distances(i, k) - instance_distances[minimal_indices[k]]) < 1.0e-12, LOG);
+        }
+    }
+
+    // Test
+
+    ds.get_instances_pointer()->set_use(0, Instances::Unused);
+
+    distances = ds.calculate_instances_distances(nearest_neighbors_number);
+
+    assert_true(distances.get_rows_number() == 299, LOG);
 }
 
 
@@ -1492,26 +1625,18 @@ void DataSetTest::test_calculate_k_distances(void)
 {
     message += "test_calculate_k_distances\n";
 
-    DataSet ds(5, 5, 10);
-    ds.randomize_data_normal();
-
-    size_t nearest_neighbors_number = 2;
+    DataSet ds;
 
     Vector<double> k_distances;
 
-    Matrix<double> distances(10, 10);
+    Matrix<double> distances(10, 3);
     distances.randomize_uniform(0, 100);
 
-    for(size_t i = 0; i < 10; i++)
-    {
-        distances(i, i) = 0;
-    }
-
-    k_distances = ds.calculate_k_distances(distances, nearest_neighbors_number);
+    k_distances = ds.calculate_k_distances(distances);
 
     assert_true(k_distances.size() == 10, LOG);
-    assert_true(k_distances[0] == distances(0, distances.arrange_row(0).calculate_minimal_indices(nearest_neighbors_number + 1)[nearest_neighbors_number]), LOG);
-    assert_true(k_distances[9] == distances(9, distances.arrange_row(9).calculate_minimal_indices(nearest_neighbors_number + 1)[nearest_neighbors_number]), LOG);
+    assert_true(k_distances[0] == distances(0, 2), LOG);
+    assert_true(k_distances[9] == distances(9, 2), LOG);
 }
 
 
@@ -1519,70 +1644,53 @@ void DataSetTest::test_calculate_reachability_distances(void)
 {
     message += "test_calculate_reachability_distances\n";
 
-    DataSet ds(5, 5, 10);
-    ds.randomize_data_normal();
+    DataSet ds;
 
-    Matrix<double> distances(10, 10);
-    Vector<double> k_distances(10);
+    Matrix<size_t> nearest_neighbors(3, 2);
+    Matrix<double> distances(3, 2);
 
     Matrix<double> reachability_distances;
 
     // Test
 
-    distances.initialize(1.0);
-    k_distances.initialize(3.0);
+    nearest_neighbors(0, 0) = 1;
+    nearest_neighbors(0, 1) = 2;
+    nearest_neighbors(1, 0) = 0;
+    nearest_neighbors(1, 1) = 2;
+    nearest_neighbors(2, 0) = 1;
+    nearest_neighbors(2, 1) = 0;
 
-    reachability_distances = ds.calculate_reachability_distances(distances, k_distances);
-
-    assert_true(reachability_distances.get_columns_number() == 10, LOG);
-    assert_true(reachability_distances.get_rows_number() == 10, LOG);
-    assert_true(reachability_distances.arrange_row(0).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(1).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(2).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(3).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(4).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(5).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(6).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(7).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(8).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(9).is_in(3.0, 3.0), LOG);
-
-    // Test
+    distances(0, 0) = 1.0;
+    distances(0, 1) = 3.0;
+    distances(1, 0) = 1.0;
+    distances(1, 1) = 2.0;
+    distances(2, 0) = 2.0;
+    distances(2, 1) = 3.0;
 
-    distances.initialize(3.0);
-    k_distances.initialize(1.0);
+    reachability_distances = ds.calculate_reachability_distances(nearest_neighbors, distances);
 
-    reachability_distances = ds.calculate_reachability_distances(distances, k_distances);
-
-    assert_true(reachability_distances.get_columns_number() == 10, LOG);
-    assert_true(reachability_distances.get_rows_number() == 10, LOG);
-    assert_true(reachability_distances.arrange_row(0).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(1).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(2).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(3).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(4).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(5).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(6).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(7).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(8).is_in(3.0, 3.0), LOG);
-    assert_true(reachability_distances.arrange_row(9).is_in(3.0, 3.0), LOG);
+    assert_true(reachability_distances.get_rows_number() == 3, LOG);
+    assert_true(reachability_distances.get_columns_number() == 2, LOG);
+    assert_true(reachability_distances(0, 0) == 2.0, LOG);
+    assert_true(reachability_distances(0, 1) == 3.0, LOG);
+    assert_true(reachability_distances(1, 0) == 3.0, LOG);
+    assert_true(reachability_distances(1, 1) == 3.0, LOG);
+    assert_true(reachability_distances(2, 0) == 2.0, LOG);
+    assert_true(reachability_distances(2, 1) == 3.0, LOG);
 }
 
 
-void DataSetTest::test_calculate_reachability_density()
+void DataSetTest::test_calculate_reachability_density(void)
 {
     message += "test_calculate_reachability_density\n";
 
-    DataSet ds(5, 5, 10);
-    ds.randomize_data_normal();
-
-    size_t nearest_neighbors_number = 2;
+    DataSet ds;
 
-    Matrix<double> distances(10, 10, 1.0);
+    Matrix<double> reachability_distances(10, 2, 1.0);
 
     Vector<double> reachability_density;
 
-    reachability_density = ds.calculate_reachability_density(distances, nearest_neighbors_number);
+    reachability_density = ds.calculate_reachability_density(reachability_distances);
 
     assert_true(reachability_density.size() == 10, LOG);
     assert_true(reachability_density.is_in(1.0, 1.0), LOG);
@@ -1593,8 +1701,8 @@ void DataSetTest::test_calculate_local_outlier_factor(void)
 {
     message += "test_calculate_local_outlier_factor\n";
 
-    DataSet ds(2, 1, 100);
-    ds.generate_artificial_data(100, 3);
+    DataSet ds(100, 2, 1);
+    ds.randomize_data_normal();
 
     Vector<double> instance1(3, 1.0);
     instance1[2] = 50.0;
@@ -1621,6 +1729,7 @@ void DataSetTest::test_calculate_local_outlier_factor(void)
     Vector<double> local_outlier_factor = ds.calculate_local_outlier_factor(8);
 
     assert_true(local_outlier_factor.size() == 100, LOG);
+    assert_true(local_outlier_factor.calculate_maximal_index() == 96, LOG);
 }
 
 
@@ -1628,16 +1737,19 @@ void DataSetTest::test_clean_local_outlier_factor(void)
 {
     message += "test_clean_local_outlier_factor\n";
 
-    DataSet ds(5, 1, 100);
-    ds.randomize_data_uniform(1.0, 2.0);
+    DataSet ds(100, 1, 1);
 
-    Vector<double> instance(6);
+    for(size_t i = 0; i < 100; i++)
+    {
+        Vector<double> instance(2);
 
-    instance[0] = 1.0;
-    instance[1] = 1.9;
-    instance[2] = 2.5;
-    instance[3] = 1.1;
-    instance[4] = 1.8;
+        instance[0] = (double)(i%10);
+        instance[1] = (double)(i/10);
+
+        ds.set_instance(i, instance);
+    }
+
+    Vector<double> instance(2, 50.0);
 
     ds.set_instance(9, instance);
 
@@ -1649,7 +1761,7 @@ void DataSetTest::test_clean_local_outlier_factor(void)
     assert_true(unused_instances.size() == 1, LOG);
     assert_true(unused_instances[0] == 9, LOG);
 }
-*/
+
 
 void DataSetTest::test_clean_Tukey_outliers(void)
 {
@@ -2284,6 +2396,252 @@ void DataSetTest::test_load_data(void)
    assert_true(data.get_rows_number() == 10, LOG);
    assert_true(data.get_columns_number() == 7, LOG);
 
+   // Test
+
+   ds.set_header_line(false);
+   ds.set_separator("Comma");
+   ds.set_missing_values_label("NaN");
+   ds.set_file_type("dat");
+
+   data_string = "1,2\r\n"
+                 "\r\n"
+                 "3,NaN\r\n"
+                 "5,6";
+
+   file.open(data_file_name.c_str(), std::ios::binary);
+   file << data_string;
+   file.close();
+
+   ds.load_data();
+
+   data = ds.get_data();
+
+   assert_true(data.get_rows_number() == 3, LOG);
+   assert_true(data.get_columns_number() == 2, LOG);
+
+   assert_true(data(0,1) == 2, LOG);
+   assert_true(data(2,0) == 5, LOG);
+   assert_true(data(2,1) == 6, LOG);
+
+   assert_true(ds.get_missing_values().get_missing_values_number() == 1, LOG);
+   assert_true(ds.get_missing_values().get_item(0).instance_index == 1, LOG);
+}
+
+
+void DataSetTest::test_load_data_binary(void)
+{
+   message += "test_load_data_binary\n";
+
+   const std::string data_file_name = "../data/data.dat";
+
+   DataSet ds(4, 2, 1);
+
+   DataSet ds_copy;
+
+   Matrix<double> data;
+
+   ds.set_data_file_name(data_file_name);
+   ds_copy.set_data_file_name(data_file_name);
+
+   // Test
+
+   ds.randomize_data_normal();
+
+   ds.get_instances_pointer()->set_use(1, Instances::Testing);
+   ds.get_variables_pointer()->set_use(0, Variables::Unused);
+   ds.get_variables_pointer()->set_name(2, "y");
+   ds.get_missing_values_pointer()->append(2, 1);
+
+   ds.save_data_binary();
+
+   ds_copy.load_data_binary();
+
+   assert_true(ds_copy.get_data() == ds.get_data(), LOG);
+
+   assert_true(ds_copy.get_instances().get_use(1) == Instances::Testing, LOG);
+   assert_true(ds_copy.get_variables().get_use(0) == Variables::Unused, LOG);
+   assert_true(ds_copy.get_variables().get_name(2) == "y", LOG);
+
+   assert_true(ds_copy.get_missing_values().get_missing_values_number() == 1, LOG);
+   assert_true(ds_copy.get_missing_values().get_item(0).instance_index == 2, LOG);
+   assert_true(ds_copy.get_missing_values().get_item(0).variable_index == 1, LOG);
+
+   // Test
+
+   data.set(3, 2);
+   data.randomize_normal();
+
+   data.save_binary(data_file_name);
+
+   ds_copy.load_data_binary();
+
+   assert_true(ds_copy.get_data() == data, LOG);
+
+   // Test
+
+   ds.save_data_binary();
+
+   std::ifstream binary_file(data_file_name.c_str(), std::ios::binary);
+
+   const std::string binary_data((std::istreambuf_iterator<char>(binary_file)), std::istreambuf_iterator<char>());
+
+   binary_file.close();
+
+   // Header fields at bytes 40 (offset of the variables) and 24 (number of instances) are corrupted with
+   // an offset which wraps around when the size of the variables is added to it,
+   // a number of instances whose data size overflows, and a number of instances different from that in the file
+
+   const size_t corrupted_fields_number = 3;
+
+   const size_t field_positions[corrupted_fields_number] = {40, 24, 24};
+   const uint64_t field_values[corrupted_fields_number] = {0xFFFFFFFFFFFFFFF0ULL, 0x2000000000000001ULL, 3};
+
+   for(size_t i = 0; i < corrupted_fields_number; i++)
+   {
+      std::string corrupted_data(binary_data);
+
+      memcpy(&corrupted_data[field_positions[i]], &field_values[i], sizeof(uint64_t));
+
+      std::ofstream corrupted_file(data_file_name.c_str(), std::ios::binary);
+
+      corrupted_file.write(corrupted_data.data(), corrupted_data.size());
+
+      corrupted_file.close();
+
+      bool exception_thrown = false;
+
+      try
+      {
+         ds_copy.load_data_binary();
+      }
+      catch(const std::logic_error&)
+      {
+         exception_thrown = true;
+      }
+
+      assert_true(exception_thrown, LOG);
+   }
+}
+
+
+void DataSetTest::test_load_data_out_of_core(void)
+{
+   message += "test_load_data_out_of_core\n";
+
+   const std::string data_file_name = "../data/data.dat";
+
+   DataSet ds(10, 3, 2);
+
+   DataSet ds_copy;
+
+   Vector<size_t> instances_indices;
+   Vector<size_t> variables_indices;
+
+   Matrix<double> instances_data;
+
+   Vector< Statistics<double> > statistics;
+   Vector< Statistics<double> > statistics_copy;
+
+   Vector< Vector<double> > box_plots;
+   Vector< Vector<double> > box_plots_copy;
+
+   Vector< Histogram<double> > histograms;
+   Vector< Histogram<double> > histograms_copy;
+
+   ds.set_data_file_name(data_file_name);
+   ds_copy.set_data_file_name(data_file_name);
+
+   ds.randomize_data_normal();
+
+   ds.get_instances_pointer()->set_use(0, Instances::Training);
+   ds.get_instances_pointer()->set_use(3, Instances::Unused);
+   ds.get_instances_pointer()->set_use(7, Instances::Selection);
+   ds.get_missing_values_pointer()->append(4, 1);
+
+   ds.save_data_binary();
+
+   // Test
+
+   ds_copy.load_data_out_of_core(3, 2);
+
+   assert_true(ds_copy.is_out_of_core(), LOG);
+   assert_true(ds_copy.has_data(), LOG);
+   assert_true(ds_copy.get_data().empty(), LOG);
+   assert_true(ds_copy.count_chunks_number() == 4, LOG);
+   assert_true(ds_copy.get_data_chunk(3).get_rows_number() == 1, LOG);
+   assert_true(ds_copy.get_data_chunk(1) == ds.get_data().arrange_submatrix_rows(Vector<size_t>(3, 1, 5)), LOG);
+
+   assert_true(ds_copy.get_training_input_data() == ds.get_training_input_data(), LOG);
+   assert_true(ds_copy.get_selection_target_data() == ds.get_selection_target_data(), LOG);
+
+   // Test
+
+   instances_indices.set(4);
+   instances_indices[0] = 9;
+   instances_indices[1] = 0;
+   instances_indices[2] = 1;
+   instances_indices[3] = 6;
+
+   variables_indices.set(2);
+   variables_indices[0] = 4;
+   variables_indices[1] = 0;
+
+   ds_copy.arrange_instances_data(instances_indices, 1, 3, variables_indices, instances_data);
+
+   assert_true(instances_data == ds.get_data().arrange_submatrix(Vector<size_t>(instances_indices.begin()+1, instances_indices.end()), variables_indices), LOG);
+
+   // Test
+
+   statistics = ds.calculate_data_statistics();
+   statistics_copy = ds_copy.calculate_data_statistics();
+
+   for(size_t i = 0; i < 5; i++)
+   {
+      assert_true(fabs(statistics_copy[i].minimum - statistics[i].minimum) < 1.0e-12, LOG);
+      assert_true(fabs(statistics_copy[i].maximum - statistics[i].maximum) < 1.0e-12, LOG);
+      assert_true(fabs(statistics_copy[i].mean - statistics[i].mean) < 1.0e-12, LOG);
+      assert_true(fabs(statistics_copy[i].standard_deviation - statistics[i].standard_deviation) < 1.0e-12, LOG);
+   }
+
+   statistics = ds.calculate_inputs_statistics();
+   statistics_copy = ds_copy.calculate_inputs_statistics();
+
+   assert_true(fabs(statistics_copy[1].mean - statistics[1].mean) < 1.0e-12, LOG);
+   assert_true(fabs(statistics_copy[1].standard_deviation - statistics[1].standard_deviation) < 1.0e-12, LOG);
+
+   box_plots = ds.calculate_box_plots();
+   box_plots_copy = ds_copy.calculate_box_plots();
+
+   assert_true(box_plots_copy.size() == box_plots.size(), LOG);
+   assert_true(box_plots_copy[0][0] == box_plots[0][0], LOG);
+   assert_true(box_plots_copy[0][4] == box_plots[0][4], LOG);
+
+   histograms = ds.calculate_data_histograms(5);
+   histograms_copy = ds_copy.calculate_data_histograms(5);
+
+   assert_true(histograms_copy.size() == histograms.size(), LOG);
+   assert_true(histograms_copy[0].frequencies == histograms[0].frequencies, LOG);
+   assert_true(histograms_copy[histograms.size()-1].frequencies == histograms[histograms.size()-1].frequencies, LOG);
+
+   assert_true((ds_copy.calculate_covariance_matrix() - ds.calculate_covariance_matrix()).calculate_absolute_value().calculate_maximum() < 1.0e-9, LOG);
+   assert_true((ds_copy.calculate_linear_correlations() - ds.calculate_linear_correlations()).calculate_absolute_value().calculate_maximum() < 1.0e-9, LOG);
+
+   // Test
+
+   ds.scale_inputs_mean_standard_deviation();
+   ds.scale_targets_minimum_maximum();
+
+   ds_copy.scale_inputs_mean_standard_deviation();
+   ds_copy.scale_targets_minimum_maximum();
+
+   assert_true((ds_copy.get_training_input_data() - ds.get_training_input_data()).calculate_absolute_value().calculate_maximum() < 1.0e-12, LOG);
+   assert_true((ds_copy.get_training_target_data() - ds.get_training_target_data()).calculate_absolute_value().calculate_maximum() < 1.0e-12, LOG);
+
+   // Test
+
+   ds_copy.set_data(ds.get_data());
+
+   assert_true(!ds_copy.is_out_of_core(), LOG);
 }
 
 
@@ -2971,6 +3329,8 @@ void DataSetTest::run_test_case(void)
    test_arrange_input_data();
    test_arrange_target_data();
 
+   test_get_training_input_data();
+
    // Instance methods
 
    test_get_instance();
@@ -3076,13 +3436,13 @@ void DataSetTest::run_test_case(void)
 
    // Outlier detection
 
-   //test_calculate_instances_distances();
-   //test_calculate_k_distances();
-   //test_calculate_reachability_distances();
-   //test_calculate_reachability_density();
-   //test_calculate_local_outlier_factor();
+   test_calculate_instances_distances();
+   test_calculate_k_distances();
+   test_calculate_reachability_distances();
+   test_calculate_reachability_density();
+   test_calculate_local_outlier_factor();
 
-   //test_clean_local_outlier_factor();
+   test_clean_local_outlier_factor();
    test_clean_Tukey_outliers();
 
    // Data generation
@@ -3104,7 +3464,9 @@ void DataSetTest::run_test_case(void)
 //   test_print_data();
 //   test_save_data();
 
-//   test_load_data();
+   test_load_data();
+   test_load_data_binary();
+   test_load_data_out_of_core();
 
 //   test_get_data_statistics();
 //   test_print_data_statistics();
@@ -68,6 +68,8 @@ public:
 
    void test_arrange_input_data(void);
    void test_arrange_target_data(void);
+
+   void test_get_training_input_data(void);
   
    // Instance methods
 
@@ -197,13 +199,13 @@ public:
 
    // Outlier detection
 
-   //void test_calculate_instances_distances(void);
-   //void test_calculate_k_distances(void);
-   //void test_calculate_reachability_distances(void);
-   //void test_calculate_reachability_density(void);
-   //void test_calculate_local_outlier_factor(void);
+   void test_calculate_instances_distances(void);
+   void test_calculate_k_distances(void);
+   void test_calculate_reachability_distances(void);
+   void test_calculate_reachability_density(void);
+   void test_calculate_local_outlier_factor(void);
 
-   //void test_clean_local_outlier_factor(void);
+   void test_clean_local_outlier_factor(void);
    void test_clean_Tukey_outliers(void);
 
    // Data generation
@@ -226,6 +228,8 @@ public:
    void test_print_data(void);
    void test_save_data(void);
    void test_load_data(void);
+   void test_load_data_binary(void);
+   void test_load_data_out_of_core(void);
 
    void test_get_data_statistics(void);
    void test_print_data_statistics(void);
@@ -246,6 +246,7 @@ void LossIndexTest::test_calculate_loss(void)
    rate = 2.3;
 
    assert_true(pf.calculate_loss(direction, rate) == pf.calculate_loss(parameters + direction*rate), LOG);
+   assert_true(nn.arrange_parameters() == parameters, LOG);
 
    // Test
 
@@ -306,6 +307,132 @@ void LossIndexTest::test_calculate_gradient(void)
 }
 
 
+void LossIndexTest::test_calculate_batch_gradient(void)
+{
+   message += "test_calculate_batch_gradient\n";
+
+   DataSet ds(20, 2, 1);
+   ds.randomize_data_normal();
+
+   NeuralNetwork nn(2, 3, 1);
+   nn.randomize_parameters_normal();
+
+   LossIndex pf(&nn, &ds);
+
+   pf.destruct_all_terms();
+
+   const Vector<size_t> training_indices = ds.get_instances().arrange_training_indices();
+   const size_t training_instances_number = training_indices.size();
+
+   const Vector<size_t> first_half(training_indices.begin(), training_indices.begin() + training_instances_number/2);
+   const Vector<size_t> second_half(training_indices.begin() + training_instances_number/2, training_indices.end());
+
+   Vector<double> gradient;
+   Vector<double> batch_gradient;
+
+   // Test
+
+   pf.set_error_type(LossIndex::MEAN_SQUARED_ERROR);
+
+   gradient = pf.calculate_gradient();
+   batch_gradient = pf.calculate_batch_gradient(training_indices);
+
+   assert_true((batch_gradient - gradient).calculate_absolute_value() < 1.0e-12, LOG);
+
+   // Test
+
+   pf.set_error_type(LossIndex::NORMALIZED_SQUARED_ERROR);
+
+   gradient = pf.calculate_gradient();
+   batch_gradient = pf.calculate_batch_gradient(training_indices);
+
+   assert_true((batch_gradient - gradient).calculate_absolute_value() < 1.0e-12, LOG);
+
+   // Test
+
+   pf.set_error_type(LossIndex::MEAN_SQUARED_ERROR);
+   pf.set_regularization_type(LossIndex::NEURAL_PARAMETERS_NORM);
+
+   gradient = pf.calculate_gradient();
+
+   batch_gradient = (pf.calculate_batch_gradient(first_half)*(double)first_half.size()
+                   + pf.calculate_batch_gradient(second_half)*(double)second_half.size())/(double)training_instances_number;
+
+   assert_true((batch_gradient - gradient).calculate_absolute_value() < 1.0e-6, LOG);
+}
+
+
+void LossIndexTest::test_calculate_first_order_loss(void)
+{
+   message += "test_calculate_first_order_loss\n";
+
+   DataSet ds(20, 2, 1);
+   ds.randomize_data_normal();
+
+   NeuralNetwork nn(2, 3, 1);
+   nn.randomize_parameters_normal();
+
+   LossIndex pf(&nn, &ds);
+
+   pf.destruct_all_terms();
+
+   LossIndex::FirstOrderloss first_order_loss;
+
+   double loss;
+   Vector<double> gradient;
+
+   Vector<LossIndex::ErrorType> error_types;
+
+   error_types.push_back(LossIndex::SUM_SQUARED_ERROR);
+   error_types.push_back(LossIndex::MEAN_SQUARED_ERROR);
+   error_types.push_back(LossIndex::ROOT_MEAN_SQUARED_ERROR);
+   error_types.push_back(LossIndex::NORMALIZED_SQUARED_ERROR);
+   error_types.push_back(LossIndex::MINKOWSKI_ERROR);
+
+   // Test
+
+   for(size_t i = 0; i < error_types.size(); i++)
+   {
+      pf.set_error_type(error_types[i]);
+      pf.set_regularization_type(LossIndex::NEURAL_PARAMETERS_NORM);
+
+      loss = pf.calculate_loss();
+      gradient = pf.calculate_gradient();
+
+      first_order_loss = pf.calculate_first_order_loss();
+
+      assert_true(fabs(first_order_loss.loss - loss) < 1.0e-12*(1.0 + fabs(loss)), LOG);
+      assert_true((first_order_loss.gradient - gradient).calculate_absolute_value() < 1.0e-12*(1.0 + gradient.calculate_norm()), LOG);
+   }
+
+   // Test
+
+   ds.randomize_data_uniform(0.0, 1.0);
+
+   nn.get_multilayer_perceptron_pointer()->get_layer_pointer(1)->set_activation_function(Perceptron::Logistic);
+
+   pf.set_error_type(LossIndex::CROSS_ENTROPY_ERROR);
+
+   loss = pf.calculate_loss();
+   gradient = pf.calculate_gradient();
+
+   first_order_loss = pf.calculate_first_order_loss();
+
+   assert_true(fabs(first_order_loss.loss - loss) < 1.0e-12*(1.0 + fabs(loss)), LOG);
+   assert_true((first_order_loss.gradient - gradient).calculate_absolute_value() < 1.0e-12*(1.0 + gradient.calculate_norm()), LOG);
+
+   // Test
+
+   pf.set_error_type(LossIndex::MEAN_SQUARED_ERROR);
+   pf.set_regularization_type(LossIndex::NO_REGULARIZATION);
+
+   const LossIndex::SecondOrderloss second_order_loss = pf.calculate_second_order_loss();
+
+   assert_true(fabs(second_order_loss.loss - pf.calculate_loss()) < 1.0e-12, LOG);
+   assert_true(second_order_loss.Hessian.get_rows_number() == nn.count_parameters_number(), LOG);
+}
+
+
 void LossIndexTest::test_calculate_gradient_norm(void)
 {
    message += "test_calculate_gradient_norm\n";
@@ -724,6 +851,10 @@ void LossIndexTest::run_test_case(void)
 
    test_calculate_gradient();
 
+   test_calculate_batch_gradient();
+
+   test_calculate_first_order_loss();
+
    test_calculate_gradient_norm();
 
    test_calculate_Hessian();
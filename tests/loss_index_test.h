@@ -82,6 +82,10 @@ public:
 
    void test_calculate_gradient(void);
 
+   void test_calculate_batch_gradient(void);
+
+   void test_calculate_first_order_loss(void);
+
    void test_calculate_gradient_norm(void);
 
    void test_calculate_Hessian(void);
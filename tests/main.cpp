@@ -80,6 +80,7 @@ int main(void)
    "weighted_squared_error\n"
    "neural_parameters_norm\n"
    "minkowski_error\n"
+   "roc_area_error\n"
    "mean_squared_error\n"
    "cross_entropy_error\n"
    "training_strategy\n"
@@ -89,6 +90,8 @@ int main(void)
    "quasi_newton_method\n"
    "newton_method\n"
    "levenberg_marquardt_algorithm\n"
+   "stochastic_gradient_descent\n"
+   "adaptive_moment_estimation\n"
    "gradient_descent\n"
    "evolutionary_algorithm\n"
    "conjugate_gradient\n"
@@ -425,6 +428,15 @@ int main(void)
         tests_passed_count += Minkowski_error_test.get_tests_passed_count();
         tests_failed_count += Minkowski_error_test.get_tests_failed_count();
       }
+      else if(test == "roc_area_error")
+      {
+        RocAreaErrorTest roc_area_error_test;
+        roc_area_error_test.run_test_case();
+        message += roc_area_error_test.get_message();
+        tests_count += roc_area_error_test.get_tests_count();
+        tests_passed_count += roc_area_error_test.get_tests_passed_count();
+        tests_failed_count += roc_area_error_test.get_tests_failed_count();
+      }
       else if(test == "cross_entropy_error")
       {
         CrossEntropyErrorTest cross_entropy_error_test;
@@ -547,6 +559,24 @@ int main(void)
         tests_passed_count += Levenberg_Marquardt_algorithm_test.get_tests_passed_count();
         tests_failed_count += Levenberg_Marquardt_algorithm_test.get_tests_failed_count();
       }
+      else if(test == "stochastic_gradient_descent")
+      {
+        StochasticGradientDescentTest stochastic_gradient_descent_test;
+        stochastic_gradient_descent_test.run_test_case();
+        message += stochastic_gradient_descent_test.get_message();
+        tests_count += stochastic_gradient_descent_test.get_tests_count();
+        tests_passed_count += stochastic_gradient_descent_test.get_tests_passed_count();
+        tests_failed_count += stochastic_gradient_descent_test.get_tests_failed_count();
+      }
+      else if(test == "adaptive_moment_estimation")
+      {
+        AdaptiveMomentEstimationTest adaptive_moment_estimation_test;
+        adaptive_moment_estimation_test.run_test_case();
+        message += adaptive_moment_estimation_test.get_message();
+        tests_count += adaptive_moment_estimation_test.get_tests_count();
+        tests_passed_count += adaptive_moment_estimation_test.get_tests_passed_count();
+        tests_failed_count += adaptive_moment_estimation_test.get_tests_failed_count();
+      }
       else if(test == "training_strategy")
       {
         TrainingStrategyTest training_strategy_test;
@@ -927,6 +957,15 @@ int main(void)
           tests_passed_count += Minkowski_error_test.get_tests_passed_count();
           tests_failed_count += Minkowski_error_test.get_tests_failed_count();
 
+          // ROC area error
+
+          RocAreaErrorTest roc_area_error_test;
+          roc_area_error_test.run_test_case();
+          message += roc_area_error_test.get_message();
+          tests_count += roc_area_error_test.get_tests_count();
+          tests_passed_count += roc_area_error_test.get_tests_passed_count();
+          tests_failed_count += roc_area_error_test.get_tests_failed_count();
+
           // cross entropy error
 
           CrossEntropyErrorTest cross_entropy_error_test;
@@ -150,6 +150,35 @@ void MatrixTest::test_assignment_operator(void)
    assert_true(b.get_rows_number() == 1, LOG);
    assert_true(b.get_columns_number() == 1, LOG);
    assert_true(b == 0, LOG);
+
+   // Test
+
+   Matrix<double> c(2, 3, 1.0);
+   Matrix<double> d;
+
+   d = c*2.0;
+
+   assert_true(d.get_rows_number() == 2, LOG);
+   assert_true(d.get_columns_number() == 3, LOG);
+   assert_true(d == 2.0, LOG);
+
+   // Test
+
+   d = c.eigen_map() + d.eigen_map()*3.0;
+
+   assert_true(d.get_rows_number() == 2, LOG);
+   assert_true(d.get_columns_number() == 3, LOG);
+   assert_true(d == 7.0, LOG);
+
+   // Test
+
+   Vector<double> v(2, 1.0);
+
+   d = v.eigen_map()*v.eigen_map().transpose();
+
+   assert_true(d.get_rows_number() == 2, LOG);
+   assert_true(d.get_columns_number() == 2, LOG);
+   assert_true(d == 1.0, LOG);
 }
 
 
@@ -1115,6 +1144,77 @@ void MatrixTest::test_calculate_statistics(void)
 }
 
 
+void MatrixTest::test_calculate_columns_moments_missing_values(void)
+{
+   message += "test_calculate_columns_moments_missing_values\n";
+
+   Matrix<double> m;
+
+   Vector<size_t> row_indices;
+   Vector<size_t> column_indices;
+
+   Vector< Vector<size_t> > missing_indices;
+
+   Vector< Moments<double> > moments;
+
+   Statistics<double> statistics;
+   Vector<double> shape_parameters;
+
+   Vector<double> column;
+
+   // Test
+
+   m.set(10000, 3);
+   m.randomize_normal();
+
+   row_indices.set(10000);
+   row_indices.initialize_sequential();
+
+   column_indices.set(2);
+   column_indices[0] = 2;
+   column_indices[1] = 0;
+
+   moments = m.calculate_columns_moments_missing_values(row_indices, column_indices, missing_indices);
+
+   assert_true(moments.size() == 2, LOG);
+   assert_true(moments[0].count == 10000, LOG);
+
+   column = m.arrange_column(2);
+
+   statistics = moments[0].calculate_statistics();
+   shape_parameters = moments[0].calculate_shape_parameters();
+
+   assert_true(statistics.minimum == column.calculate_minimum(), LOG);
+   assert_true(statistics.maximum == column.calculate_maximum(), LOG);
+   assert_true(fabs(statistics.mean - column.calculate_mean()) < 1.0e-12, LOG);
+   assert_true(fabs(statistics.standard_deviation - column.calculate_standard_deviation()) < 1.0e-12, LOG);
+   assert_true(fabs(shape_parameters[0] - column.calculate_asymmetry()) < 1.0e-9, LOG);
+   assert_true(fabs(shape_parameters[1] - column.calculate_kurtosis()) < 1.0e-9, LOG);
+
+   // Test
+
+   m.set(5, 2);
+   m.randomize_normal();
+
+   row_indices.set(3);
+   row_indices[0] = 4;
+   row_indices[1] = 1;
+   row_indices[2] = 2;
+
+   column_indices.set(1, 1);
+
+   missing_indices.set(2);
+   missing_indices[1].set(1, 2);
+
+   moments = m.calculate_columns_moments_missing_values(row_indices, column_indices, missing_indices);
+
+   assert_true(moments[0].count == 2, LOG);
+   assert_true(moments[0].minimum == std::min(m(1,1), m(4,1)), LOG);
+   assert_true(moments[0].maximum == std::max(m(1,1), m(4,1)), LOG);
+   assert_true(fabs(moments[0].mean - (m(1,1) + m(4,1))/2.0) < 1.0e-12, LOG);
+}
+
+
 void MatrixTest::test_calculate_histogram(void)
 {
    message += "test_calculate_histogram\n";
@@ -1151,6 +1251,155 @@ void MatrixTest::test_calculate_histogram(void)
 }
 
 
+void MatrixTest::test_calculate_columns_histograms_missing_values(void)
+{
+   message += "test_calculate_columns_histograms_missing_values\n";
+
+   Matrix<double> m;
+
+   Vector<size_t> row_indices;
+   Vector<size_t> column_indices;
+
+   Vector< Vector<size_t> > missing_indices;
+
+   Vector< Histogram<double> > histograms;
+
+   Histogram<double> histogram;
+
+   // Test
+
+   m.set(100000, 3);
+   m.randomize_normal();
+
+   for(size_t i = 0; i < m.get_rows_number(); i++)
+   {
+      m(i, 1) = (double)(i%2);
+   }
+
+   row_indices.set(100000);
+   row_indices.initialize_sequential();
+
+   column_indices.set(2);
+   column_indices[0] = 2;
+   column_indices[1] = 1;
+
+   histograms = m.calculate_columns_histograms_missing_values(row_indices, column_indices, missing_indices, 10, true);
+
+   assert_true(histograms.size() == 2, LOG);
+
+   histogram = m.arrange_column(2).calculate_histogram(10);
+
+   assert_true(histograms[0].frequencies == histogram.frequencies, LOG);
+   assert_true(histograms[0].centers == histogram.centers, LOG);
+
+   assert_true(histograms[1].get_bins_number() == 2, LOG);
+   assert_true(histograms[1].frequencies[0] == 50000, LOG);
+   assert_true(histograms[1].frequencies[1] == 50000, LOG);
+
+   // Test
+
+   m.set(5, 2);
+   m.randomize_normal();
+
+   m(2, 1) = 100.0;
+
+   row_indices.set(3);
+   row_indices[0] = 4;
+   row_indices[1] = 1;
+   row_indices[2] = 2;
+
+   column_indices.set(1, 1);
+
+   missing_indices.set(2);
+   missing_indices[1].set(1, 2);
+
+   histograms = m.calculate_columns_histograms_missing_values(row_indices, column_indices, missing_indices, 3);
+
+   assert_true(histograms[0].frequencies.calculate_sum() == 2, LOG);
+   assert_true(histograms[0].maximums[2] < 100.0, LOG);
+}
+
+
+void MatrixTest::test_calculate_columns_cross_moments(void)
+{
+   message += "test_calculate_columns_cross_moments\n";
+
+   Matrix<double> m;
+
+   Vector<size_t> row_indices;
+   Vector<size_t> first_column_indices;
+   Vector<size_t> second_column_indices;
+
+   CrossMoments<double> cross_moments;
+
+   Matrix<double> covariance_matrix;
+   Matrix<double> linear_correlations;
+
+   // Test
+
+   m.set(40000, 4);
+   m.randomize_normal(1.0, 2.0);
+
+   for(size_t i = 0; i < m.get_rows_number(); i++)
+   {
+      m(i, 3) = m(i, 0) + 0.5*m(i, 3);
+   }
+
+   row_indices.set(40000);
+   row_indices.initialize_sequential();
+
+   first_column_indices.set(2);
+   first_column_indices[0] = 0;
+   first_column_indices[1] = 1;
+
+   second_column_indices.set(2);
+   second_column_indices[0] = 3;
+   second_column_indices[1] = 2;
+
+   cross_moments = m.calculate_columns_cross_moments(row_indices, first_column_indices, second_column_indices);
+
+   assert_true(cross_moments.count == 40000, LOG);
+
+   covariance_matrix = cross_moments.calculate_covariance_matrix();
+   linear_correlations = cross_moments.calculate_linear_correlation_matrix();
+
+   for(size_t i = 0; i < 2; i++)
+   {
+      for(size_t j = 0; j < 2; j++)
+      {
+         const Vector<double> first_column = m.arrange_column(first_column_indices[i]);
+         const Vector<double> second_column = m.arrange_column(second_column_indices[j]);
+
+         assert_true(fabs(covariance_matrix(i,j) - first_column.calculate_covariance(second_column)) < 1.0e-9, LOG);
+         assert_true(fabs(linear_correlations(i,j) - first_column.calculate_linear_correlation(second_column)) < 1.0e-9, LOG);
+      }
+   }
+
+   // Test
+
+   cross_moments = m.calculate_columns_cross_moments(row_indices, first_column_indices, first_column_indices);
+
+   covariance_matrix = cross_moments.calculate_covariance_matrix();
+
+   assert_true(covariance_matrix.is_symmetric(), LOG);
+   assert_true(fabs(covariance_matrix(1,1) - m.arrange_column(1).calculate_variance()) < 1.0e-9, LOG);
+
+   // Test
+
+   m.set(3, 2, 0.0);
+
+   row_indices.set(3);
+   row_indices.initialize_sequential();
+
+   first_column_indices.set(1, 0);
+   second_column_indices.set(1, 1);
+
+   linear_correlations = m.calculate_columns_cross_moments(row_indices, first_column_indices, second_column_indices).calculate_linear_correlation_matrix();
+
+   assert_true(linear_correlations(0,0) == 1.0, LOG);
+}
+
+
 void MatrixTest::test_calculate_covariance_matrix(void)
 {
     message += "test_calculate_covariance_matrix\n";
@@ -1845,10 +2094,13 @@ void MatrixTest::run_test_case(void)
    test_calculate_mean_standard_deviation();
 
    test_calculate_statistics();
+   test_calculate_columns_moments_missing_values();
 
    test_calculate_histogram();
+   test_calculate_columns_histograms_missing_values();
 
    test_calculate_covariance_matrix();
+   test_calculate_columns_cross_moments();
 
    test_calculate_minimal_indices();
    test_calculate_maximal_indices();
@@ -147,10 +147,13 @@ public:
    void test_calculate_mean_standard_deviation(void);
 
    void test_calculate_statistics(void);
+   void test_calculate_columns_moments_missing_values(void);
 
    void test_calculate_histogram(void);
+   void test_calculate_columns_histograms_missing_values(void);
 
    void test_calculate_covariance_matrix(void);
+   void test_calculate_columns_cross_moments(void);
 
    void test_calculate_minimal_indices(void);
    void test_calculate_maximal_indices(void);
@@ -140,7 +140,7 @@ void MeanSquaredErrorTest::test_calculate_gradient(void)
    nn.set(3, 4, 2);
    nn.initialize_parameters(0.0);
 
-   ds.set(3, 2, 5);
+   ds.set(5, 3, 2);
    mse.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -159,7 +159,7 @@ void MeanSquaredErrorTest::test_calculate_gradient(void)
    nn.set(multilayer_perceptron_architecture);
    nn.initialize_parameters(0.0);
 
-   ds.set(2, 3, 5);
+   ds.set(5, 2, 3);
    mse.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -188,7 +188,7 @@ void MeanSquaredErrorTest::test_calculate_gradient(void)
    nn.set(3, 4, 2);
    nn.initialize_parameters(0.0);
 
-   ds.set(3, 2, 5);
+   ds.set(5, 3, 2);
    mse.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -220,6 +220,22 @@ void MeanSquaredErrorTest::test_calculate_gradient(void)
    gradient = mse.calculate_gradient();
    numerical_gradient = nd.calculate_gradient(mse, &MeanSquaredError::calculate_error, parameters);
    error = (gradient - numerical_gradient).calculate_absolute_value();
+
+   // Test
+
+   nn.set(3, 4, 2);
+   nn.randomize_parameters_normal();
+   parameters = nn.arrange_parameters();
+
+   ds.set(600, 3, 2);
+   ds.randomize_data_normal();
+
+   ds.get_instances_pointer()->set_training();
+
+   gradient = mse.calculate_gradient();
+   numerical_gradient = nd.calculate_gradient(mse, &MeanSquaredError::calculate_error, parameters);
+
+   assert_true((gradient - numerical_gradient).calculate_absolute_value() < 1.0e-3, LOG);
 }
 
 
@@ -318,7 +334,7 @@ void MeanSquaredErrorTest::test_calculate_terms_Jacobian(void)
    nn.set(3, 4, 2);
    nn.initialize_parameters(0.0);
 
-   ds.set(3, 2, 5);
+   ds.set(5, 3, 2);
    mse.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -338,7 +354,7 @@ void MeanSquaredErrorTest::test_calculate_terms_Jacobian(void)
    nn.set(multilayer_perceptron_architecture);
    nn.initialize_parameters(0.0);
 
-   ds.set(2, 2, 5);
+   ds.set(5, 2, 2);
    mse.set(&nn, &ds);
    ds.initialize_data(0.0);
 
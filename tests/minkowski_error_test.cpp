@@ -163,7 +163,7 @@ void MinkowskiErrorTest::test_calculate_gradient(void)
    nn.set(3,4,2);
    nn.initialize_parameters(0.0);
 
-   ds.set(3, 2, 5);
+   ds.set(5, 3, 2);
    me.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -182,7 +182,7 @@ void MinkowskiErrorTest::test_calculate_gradient(void)
    nn.set(architecture);
    nn.initialize_parameters(0.0);
 
-   ds.set(2, 3, 5);
+   ds.set(5, 2, 3);
    me.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -211,7 +211,7 @@ void MinkowskiErrorTest::test_calculate_gradient(void)
    nn.set(3,4,2);
    nn.initialize_parameters(0.0);
 
-   ds.set(3,2,5);
+   ds.set(5,3,2);
    me.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -230,7 +230,7 @@ void MinkowskiErrorTest::test_calculate_gradient(void)
    nn.set(architecture);
    nn.initialize_parameters(0.0);
 
-   ds.set(2,2,3);
+   ds.set(3,2,2);
    me.set(&nn, &ds);
    ds.initialize_data(0.0);
 
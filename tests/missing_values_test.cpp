@@ -176,6 +176,106 @@ void MissingValuesTest::test_convert_time_series(void)
 }
 
 
+void MissingValuesTest::test_is_missing_value(void)
+{
+    message += "test_is_missing_value\n";
+
+    MissingValues mv;
+
+    // Test
+
+    mv.set(3, 3);
+
+    assert_true(!mv.has_missing_values(), LOG);
+    assert_true(!mv.has_missing_values(0), LOG);
+    assert_true(!mv.is_missing_value(0, 0), LOG);
+
+    // Test
+
+    mv.append(2, 1);
+    mv.append(0, 2);
+
+    assert_true(mv.has_missing_values(), LOG);
+    assert_true(mv.has_missing_values(0), LOG);
+    assert_true(!mv.has_missing_values(1), LOG);
+    assert_true(mv.has_missing_values(2), LOG);
+    assert_true(mv.is_missing_value(2, 1), LOG);
+    assert_true(!mv.is_missing_value(2, 2), LOG);
+    assert_true(mv.has_missing_values(0, Vector<size_t>(1, 2)), LOG);
+    assert_true(!mv.has_missing_values(0, Vector<size_t>(1, 1)), LOG);
+
+    // Test
+
+    mv.append(1, 0);
+
+    assert_true(mv.has_missing_values(1), LOG);
+    assert_true(mv.is_missing_value(1, 0), LOG);
+
+    // Test
+
+    mv.set_item(1, 1, 1);
+
+    assert_true(!mv.has_missing_values(0), LOG);
+    assert_true(mv.is_missing_value(1, 1), LOG);
+
+    // Test
+
+    MissingValues mv_copy(mv);
+
+    mv.set(3, 3);
+
+    assert_true(!mv.has_missing_values(1), LOG);
+    assert_true(mv_copy.is_missing_value(1, 1), LOG);
+}
+
+
+void MissingValuesTest::test_arrange_missing_indices(void)
+{
+    message += "test_arrange_missing_indices\n";
+
+    MissingValues mv;
+
+    Vector< Vector<size_t> > missing_indices;
+
+    // Test
+
+    mv.set(4, 2);
+
+    missing_indices = mv.arrange_missing_indices();
+
+    assert_true(missing_indices.size() == 2, LOG);
+    assert_true(missing_indices[0].empty(), LOG);
+    assert_true(mv.arrange_missing_instances().empty(), LOG);
+    assert_true(mv.get_missing_values_numbers() == Vector<size_t>(2, 0), LOG);
+
+    // Test
+
+    mv.append(3, 1);
+    mv.append(1, 1);
+    mv.append(2, 0);
+    mv.append(1, 0);
+
+    missing_indices = mv.arrange_missing_indices();
+
+    assert_true(missing_indices.size() == 2, LOG);
+    assert_true(missing_indices[0].size() == 2, LOG);
+    assert_true(missing_indices[0][0] == 1 && missing_indices[0][1] == 2, LOG);
+    assert_true(missing_indices[1].size() == 2, LOG);
+    assert_true(missing_indices[1][0] == 1 && missing_indices[1][1] == 3, LOG);
+
+    assert_true(mv.arrange_missing_instances(1) == missing_indices[1], LOG);
+    assert_true(mv.arrange_missing_variables(1).size() == 2, LOG);
+    assert_true(mv.arrange_missing_variables(3).size() == 1, LOG);
+    assert_true(mv.arrange_missing_variables(0).empty(), LOG);
+
+    assert_true(mv.arrange_missing_instances().size() == 3, LOG);
+    assert_true(mv.arrange_missing_instances()[0] == 1, LOG);
+    assert_true(mv.count_missing_instances() == 3, LOG);
+    assert_true(mv.arrange_missing_variables().size() == 2, LOG);
+    assert_true(mv.get_missing_values_numbers() == Vector<size_t>(2, 2), LOG);
+}
+
+
 /// @todo Complete method and tests.
 
 void MissingValuesTest::test_to_XML(void)
@@ -250,6 +350,12 @@ void MissingValuesTest::run_test_case(void)
 
    test_convert_time_series();
 
+   // Missing values methods
+
+   test_is_missing_value();
+
+   test_arrange_missing_indices();
+
    // Serialization methods
 
    test_to_XML();
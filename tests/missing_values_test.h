@@ -66,6 +66,12 @@ public:
 
    void test_convert_time_series(void);
 
+   // Missing values methods
+
+   void test_is_missing_value(void);
+
+   void test_arrange_missing_indices(void);
+
    // Serialization methods
 
    void test_to_XML(void);
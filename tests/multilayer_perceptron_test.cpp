@@ -407,6 +407,58 @@ void MultilayerPerceptronTest::test_set_parameters(void)
 }
 
 
+void MultilayerPerceptronTest::test_get_parameters_span(void)
+{
+   message += "test_get_parameters_span\n";
+
+   MultilayerPerceptron mlp(2, 3, 1);
+
+   Vector<double> parameters = mlp.arrange_parameters();
+
+   VectorSpan<double> parameters_span = mlp.get_parameters_span();
+
+   assert_true(parameters_span.size() == 13, LOG);
+   assert_true(parameters_span.to_vector() == parameters, LOG);
+   assert_true(mlp.are_layers_parameters_bound(), LOG);
+
+   // Test
+
+   Vector<double> parameters_increment(13, 0.5);
+
+   parameters_span += parameters_increment;
+
+   parameters += parameters_increment;
+
+   assert_true(mlp.arrange_parameters() == parameters, LOG);
+   assert_true(mlp.get_layer(1).arrange_parameters() == parameters.take_out(9, 4), LOG);
+
+   // Test
+
+   mlp.get_layer_pointer(0)->initialize_biases(1.0);
+
+   assert_true(mlp.get_parameters_span()[0] == 1.0, LOG);
+   assert_true(mlp.get_parameters_span()[3] == 1.0, LOG);
+
+   // Test
+
+   const MultilayerPerceptron copy(mlp);
+
+   assert_true(copy.arrange_parameters() == mlp.arrange_parameters(), LOG);
+
+   mlp.initialize_parameters(0.0);
+
+   assert_true(copy.arrange_parameters() != 0.0, LOG);
+
+   // Test
+
+   mlp.grow_input();
+
+   assert_true(!mlp.are_layers_parameters_bound(), LOG);
+   assert_true(mlp.get_parameters_span().size() == 16, LOG);
+   assert_true(mlp.arrange_parameters() == 0.0, LOG);
+}
+
+
 void MultilayerPerceptronTest::test_arrange_layers_biases(void)
 {
    message += "test_arrange_layers_biases\n";
@@ -1103,6 +1155,9 @@ void MultilayerPerceptronTest::test_calculate_outputs(void)
    Vector<double> hidden_layer_output;
    Vector<double> output_layer_output;
 
+   Matrix<double> input_data;
+   Matrix<double> output_data;
+
    // Test
 
    mlp.set(2, 4, 3);
@@ -1208,6 +1263,58 @@ void MultilayerPerceptronTest::test_calculate_outputs(void)
    parameters = mlp.arrange_parameters();
 
    assert_true(mlp.calculate_outputs(inputs) == mlp.calculate_outputs(inputs, parameters), LOG);
+
+   // Test
+
+   mlp.set(3, 4, 2);
+   mlp.randomize_parameters_normal();
+
+   input_data.set(5, 3);
+   input_data.randomize_normal();
+
+   output_data = mlp.calculate_outputs(input_data);
+
+   assert_true(output_data.get_rows_number() == 5, LOG);
+   assert_true(output_data.get_columns_number() == 2, LOG);
+
+   for(size_t i = 0; i < 5; i++)
+   {
+      outputs = mlp.calculate_outputs(input_data.arrange_row(i));
+
+      assert_true((output_data.arrange_row(i) - outputs).calculate_absolute_value() < 1.0e-12, LOG);
+   }
+
+   // Test
+
+   parameters.set(mlp.count_parameters_number());
+   parameters.randomize_normal();
+
+   output_data = mlp.calculate_outputs(input_data, parameters);
+
+   for(size_t i = 0; i < 5; i++)
+   {
+      outputs = mlp.calculate_outputs(input_data.arrange_row(i), parameters);
+
+      assert_true((output_data.arrange_row(i) - outputs).calculate_absolute_value() < 1.0e-12, LOG);
+   }
+
+   // Test
+
+   Matrix<float> single_input_data(5, 3);
+
+   std::copy(input_data.begin(), input_data.end(), single_input_data.begin());
+
+   output_data = mlp.calculate_outputs(input_data);
+
+   const Matrix<float> single_output_data = mlp.calculate_outputs(single_input_data);
+
+   assert_true(single_output_data.get_rows_number() == 5, LOG);
+   assert_true(single_output_data.get_columns_number() == 2, LOG);
+
+   for(size_t i = 0; i < single_output_data.size(); i++)
+   {
+      assert_true(fabs(single_output_data[i] - output_data[i]) < 1.0e-5, LOG);
+   }
 }
 
 
@@ -2342,7 +2449,7 @@ void MultilayerPerceptronTest::test_calculate_interlayers_combination_combinatio
    mlp.set_layer_activation_function(1, Perceptron::Logistic);
    mlp.set_layer_activation_function(2, Perceptron::Logistic);
 
-   inputs.set(1);
+   inputs.set(5);
    inputs.randomize_normal();
 
    layers_combination = mlp.calculate_layers_combination(inputs);
@@ -4096,6 +4203,33 @@ void MultilayerPerceptronTest::test_calculate_first_order_forward_propagation(vo
    assert_true(first_order_forward_propagation.size() == 2, LOG);
    assert_true(first_order_forward_propagation[0].size() == 2, LOG);
    assert_true(first_order_forward_propagation[1].size() == 2, LOG);
+
+   // Test
+
+   n.set(3, 4, 2);
+   n.randomize_parameters_normal();
+
+   Matrix<double> batch_inputs(5, 3);
+   batch_inputs.randomize_normal();
+
+   MultilayerPerceptron::ForwardPropagationWorkspace<double> workspace(n, 5);
+
+   n.calculate_first_order_forward_propagation(batch_inputs, workspace);
+
+   batch_inputs.set(2, 3);
+   batch_inputs.randomize_normal();
+
+   n.calculate_first_order_forward_propagation(batch_inputs, workspace);
+
+   assert_true(workspace.layers_activation[1].get_rows_number() == 2, LOG);
+
+   for(size_t i = 0; i < 2; i++)
+   {
+      first_order_forward_propagation = n.calculate_first_order_forward_propagation(batch_inputs.arrange_row(i));
+
+      assert_true((workspace.layers_activation[1].arrange_row(i) - first_order_forward_propagation[0][1]).calculate_absolute_value() < 1.0e-12, LOG);
+      assert_true((workspace.layers_activation_derivative[0].arrange_row(i) - first_order_forward_propagation[1][0]).calculate_absolute_value() < 1.0e-12, LOG);
+   }
 }
 
 
@@ -4302,6 +4436,7 @@ void MultilayerPerceptronTest::run_test_case(void)
    test_set_layers_synaptic_weights();      
    test_set_layers_parameters();
    test_set_parameters();
+   test_get_parameters_span();
 
    // Activation functions
 
@@ -105,6 +105,8 @@ public:
 
    void test_set_parameters(void);
 
+   void test_get_parameters_span(void);
+
    void test_set_layers_biases(void);
 
    void test_set_layers_synaptic_weights(void);
@@ -645,6 +645,8 @@ void NeuralNetworkTest::test_calculate_output_data(void)
 
    Matrix<double> input_data;
    Matrix<double> output_data;
+
+   Vector<double> outputs;
    
    // Test
 
@@ -655,6 +657,34 @@ void NeuralNetworkTest::test_calculate_output_data(void)
    output_data = nn.calculate_output_data(input_data);
 
    assert_true(output_data.get_rows_number() == 2, LOG);
+
+   // Test
+
+   nn.set(3, 4, 2);
+   nn.randomize_parameters_normal();
+
+   nn.construct_scaling_layer();
+   nn.construct_unscaling_layer();
+   nn.construct_probabilistic_layer();
+
+   nn.get_scaling_layer_pointer()->set_scaling_method(ScalingLayer::MeanStandardDeviation);
+   nn.get_unscaling_layer_pointer()->set_unscaling_method(UnscalingLayer::MinimumMaximum);
+   nn.get_probabilistic_layer_pointer()->set_probabilistic_method(ProbabilisticLayer::Softmax);
+
+   input_data.set(6, 3);
+   input_data.randomize_normal();
+
+   output_data = nn.calculate_output_data(input_data);
+
+   assert_true(output_data.get_rows_number() == 6, LOG);
+   assert_true(output_data.get_columns_number() == 2, LOG);
+
+   for(size_t i = 0; i < 6; i++)
+   {
+      outputs = nn.calculate_outputs(input_data.arrange_row(i));
+
+      assert_true((output_data.arrange_row(i) - outputs).calculate_absolute_value() < 1.0e-12, LOG);
+   }
 }
 
 
@@ -71,6 +71,77 @@ void NormalizedSquaredErrorTest::test_destructor(void)
 }
 
 
+void NormalizedSquaredErrorTest::test_calculate_training_normalization_coefficient(void)
+{
+   message += "test_calculate_training_normalization_coefficient\n";
+
+   NeuralNetwork nn(2, 2);
+
+   DataSet ds(4, 2, 2);
+
+   NormalizedSquaredError nse(&nn, &ds);
+
+   double normalization_coefficient;
+
+   // Test
+
+   ds.randomize_data_normal();
+
+   normalization_coefficient = nse.calculate_normalization_coefficient(ds.get_training_target_data(), ds.calculate_training_target_data_mean());
+
+   assert_true(fabs(nse.get_training_normalization_coefficient() - normalization_coefficient) < 1.0e-12, LOG);
+   assert_true(fabs(nse.get_training_normalization_coefficient() - normalization_coefficient) < 1.0e-12, LOG);
+
+   // Test
+
+   ds.randomize_data_normal();
+
+   normalization_coefficient = nse.calculate_normalization_coefficient(ds.get_training_target_data(), ds.calculate_training_target_data_mean());
+
+   assert_true(fabs(nse.get_training_normalization_coefficient() - normalization_coefficient) < 1.0e-12, LOG);
+
+   // Test
+
+   ds.get_instances_pointer()->set_use(0, Instances::Unused);
+
+   normalization_coefficient = nse.calculate_normalization_coefficient(ds.get_training_target_data(), ds.calculate_training_target_data_mean());
+
+   assert_true(fabs(nse.get_training_normalization_coefficient() - normalization_coefficient) < 1.0e-12, LOG);
+}
+
+
+void NormalizedSquaredErrorTest::test_calculate_selection_normalization_coefficient(void)
+{
+   message += "test_calculate_selection_normalization_coefficient\n";
+
+   NeuralNetwork nn(2, 2);
+
+   DataSet ds(4, 2, 2);
+
+   NormalizedSquaredError nse(&nn, &ds);
+
+   double normalization_coefficient;
+
+   // Test
+
+   ds.get_instances_pointer()->set_selection();
+
+   ds.randomize_data_normal();
+
+   normalization_coefficient = nse.calculate_normalization_coefficient(ds.get_selection_target_data(), ds.calculate_selection_target_data_mean());
+
+   assert_true(fabs(nse.get_selection_normalization_coefficient() - normalization_coefficient) < 1.0e-12, LOG);
+
+   // Test
+
+   ds.get_variables_pointer()->set_use(3, Variables::Input);
+
+   normalization_coefficient = nse.calculate_normalization_coefficient(ds.get_selection_target_data(), ds.calculate_selection_target_data_mean());
+
+   assert_true(fabs(nse.get_selection_normalization_coefficient() - normalization_coefficient) < 1.0e-12, LOG);
+}
+
+
 void NormalizedSquaredErrorTest::test_calculate_error(void)
 {
    message += "test_calculate_error\n";
@@ -111,6 +182,31 @@ void NormalizedSquaredErrorTest::test_calculate_error(void)
    ds.randomize_data_normal();
 
    assert_true(nse.calculate_error() == nse.calculate_error(parameters), LOG);
+
+   // Test
+
+   nn.set(3, 4, 2);
+   nn.randomize_parameters_normal();
+
+   ds.set(300, 3, 2);
+   ds.randomize_data_normal();
+   ds.get_instances_pointer()->split_random_indices();
+
+   ds.set_data_file_name("../data/data.dat");
+   ds.save_data_binary();
+
+   DataSet ds_out_of_core;
+
+   ds_out_of_core.set_data_file_name("../data/data.dat");
+   ds_out_of_core.load_data_out_of_core(64, 2);
+
+   NormalizedSquaredError nse_out_of_core(&nn, &ds_out_of_core);
+
+   assert_true(fabs(nse_out_of_core.calculate_error() - nse.calculate_error()) < 1.0e-9, LOG);
+   assert_true(fabs(nse_out_of_core.calculate_selection_error() - nse.calculate_selection_error()) < 1.0e-9, LOG);
+
+   assert_true(!ds_out_of_core.has_split_data(Instances::Training), LOG);
+   assert_true(!ds_out_of_core.has_split_data(Instances::Selection), LOG);
 }
 
 
@@ -403,6 +499,11 @@ void NormalizedSquaredErrorTest::run_test_case(void)
 
    // Set methods
 
+   // Normalization coefficients
+
+   test_calculate_training_normalization_coefficient();
+   test_calculate_selection_normalization_coefficient();
+
    // Objective methods
 
    test_calculate_error();
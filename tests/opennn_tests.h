@@ -55,6 +55,7 @@
 #include "normalized_squared_error_test.h"
 #include "weighted_squared_error_test.h"
 #include "minkowski_error_test.h"
+#include "roc_area_error_test.h"
 #include "cross_entropy_error_test.h"
 #include "inverse_sum_squared_error_test.h"
 #include "final_solutions_error_test.h"
@@ -72,6 +73,8 @@
 #include "quasi_newton_method_test.h"
 #include "newton_method_test.h"
 #include "levenberg_marquardt_algorithm_test.h"
+#include "stochastic_gradient_descent_test.h"
+#include "adaptive_moment_estimation_test.h"
 #include "training_strategy_test.h"
 
 #include "model_selection_test.h"
@@ -105,6 +105,54 @@ void PerceptronLayerTest::test_get_perceptrons_number(void)
 }
 
 
+void PerceptronLayerTest::test_get_perceptron(void)
+{
+   message += "test_get_perceptron\n";
+
+   PerceptronLayer pl(3, 2);
+
+   Vector<double> parameters(8);
+   parameters[0] =  0.1;
+   parameters[1] = -0.2;
+   parameters[2] =  0.3;
+   parameters[3] = -0.4;
+   parameters[4] =  0.5;
+   parameters[5] = -0.6;
+   parameters[6] =  0.7;
+   parameters[7] = -0.8;
+
+   pl.set_parameters(parameters);
+   pl.set_activation_function(Perceptron::Logistic);
+
+   Perceptron perceptron = pl.get_perceptron(1);
+
+   assert_true(perceptron.get_inputs_number() == 3, LOG);
+   assert_true(perceptron.get_bias() == 0.5, LOG);
+   assert_true(perceptron.get_synaptic_weight(0) == -0.6, LOG);
+   assert_true(perceptron.get_synaptic_weight(2) == -0.8, LOG);
+   assert_true(perceptron.get_activation_function() == Perceptron::Logistic, LOG);
+
+   // Test
+
+   perceptron.set_bias(1.0);
+
+   pl.set_perceptron(0, perceptron);
+
+   assert_true(pl.arrange_biases()[0] == 1.0, LOG);
+   assert_true(pl.arrange_synaptic_weights()(0,1) == 0.7, LOG);
+   assert_true(pl.arrange_parameters().take_out(4, 4) == parameters.take_out(4, 4), LOG);
+
+   // Test
+
+   PerceptronLayer pl2;
+
+   pl2.set(pl.get_perceptrons());
+
+   assert_true(pl2.arrange_parameters() == pl.arrange_parameters(), LOG);
+   assert_true(pl2.get_activation_function() == Perceptron::Logistic, LOG);
+}
+
+
 void PerceptronLayerTest::test_get_activation_function(void)
 {
    message += "test_get_activation_function\n";
@@ -1411,6 +1459,74 @@ void PerceptronLayerTest::test_calculate_activation_second_derivative(void)
 }
 
 
+void PerceptronLayerTest::test_calculate_fast_activations(void)
+{
+   message += "test_calculate_fast_activations\n";
+
+   const Vector<double> combinations(-20.0, 0.01, 20.0);
+
+   const size_t size = combinations.size();
+
+   Vector<double> activations(size);
+   Vector<double> fast_activations(size);
+
+   // Test
+
+   PerceptronLayer::calculate_logistic_activations(combinations.data(), size, activations.data());
+   PerceptronLayer::calculate_fast_logistic_activations(combinations.data(), size, fast_activations.data());
+
+   assert_true((fast_activations - activations).calculate_absolute_value() < 1.5e-7, LOG);
+
+   // Test
+
+   PerceptronLayer::calculate_logistic_activations_derivatives(combinations.data(), size, activations.data());
+   PerceptronLayer::calculate_fast_logistic_activations_derivatives(combinations.data(), size, fast_activations.data());
+
+   assert_true((fast_activations - activations).calculate_absolute_value() < 1.5e-7, LOG);
+
+   // Test
+
+   PerceptronLayer::calculate_hyperbolic_tangent_activations(combinations.data(), size, activations.data());
+   PerceptronLayer::calculate_fast_hyperbolic_tangent_activations(combinations.data(), size, fast_activations.data());
+
+   assert_true((fast_activations - activations).calculate_absolute_value() < 3.0e-7, LOG);
+
+   // Test
+
+   PerceptronLayer::calculate_hyperbolic_tangent_activations_derivatives(combinations.data(), size, activations.data());
+   PerceptronLayer::calculate_fast_hyperbolic_tangent_activations_derivatives(combinations.data(), size, fast_activations.data());
+
+   assert_true((fast_activations - activations).calculate_absolute_value() < 6.0e-7, LOG);
+
+   // Test
+
+   assert_true(fabs(fast_activations[size/2] - 1.0) < 1.0e-12, LOG);
+
+   // Test
+
+   const Vector<float> single_combinations(combinations.begin(), combinations.end());
+
+   Vector<float> single_activations(size);
+   Vector<float> single_fast_activations(size);
+
+   PerceptronLayer::calculate_logistic_activations(combinations.data(), size, activations.data());
+   PerceptronLayer::calculate_logistic_activations(single_combinations.data(), size, single_activations.data());
+   PerceptronLayer::calculate_fast_logistic_activations(single_combinations.data(), size, single_fast_activations.data());
+
+   assert_true((Vector<double>(single_activations.begin(), single_activations.end()) - activations).calculate_absolute_value() < 1.0e-6, LOG);
+   assert_true((Vector<double>(single_fast_activations.begin(), single_fast_activations.end()) - activations).calculate_absolute_value() < 1.0e-6, LOG);
+
+   // Test
+
+   PerceptronLayer::calculate_hyperbolic_tangent_activations(combinations.data(), size, activations.data());
+   PerceptronLayer::calculate_hyperbolic_tangent_activations(single_combinations.data(), size, single_activations.data());
+   PerceptronLayer::calculate_fast_hyperbolic_tangent_activations(single_combinations.data(), size, single_fast_activations.data());
+
+   assert_true((Vector<double>(single_activations.begin(), single_activations.end()) - activations).calculate_absolute_value() < 1.0e-6, LOG);
+   assert_true((Vector<double>(single_fast_activations.begin(), single_fast_activations.end()) - activations).calculate_absolute_value() < 1.0e-6, LOG);
+}
+
+
 void PerceptronLayerTest::test_calculate_outputs(void)
 {
    message += "test_calculate_outputs\n";
@@ -1806,6 +1922,7 @@ void PerceptronLayerTest::run_test_case(void)
 
    test_count_inputs_number();
    test_get_perceptrons_number();
+   test_get_perceptron();
 
    // PerceptronLayer parameters
 
@@ -1903,6 +2020,8 @@ void PerceptronLayerTest::run_test_case(void)
    test_calculate_activation_derivative();
    test_calculate_activation_second_derivative();
 
+   test_calculate_fast_activations();
+
    // PerceptronLayer outputs 
 
    test_calculate_outputs();
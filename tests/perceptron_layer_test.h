@@ -142,6 +142,8 @@ public:
    void test_calculate_activation_derivative(void);
    void test_calculate_activation_second_derivative(void);
 
+   void test_calculate_fast_activations(void);
+
    // PerceptronLayer outputs 
 
    void test_calculate_outputs(void);
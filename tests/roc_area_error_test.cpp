@@ -0,0 +1,362 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   R O C   A R E A   E R R O R   T E S T   C L A S S                                                          */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+// Unit testing includes
+
+#include "roc_area_error_test.h"
+
+using namespace OpenNN;
+
+// GENERAL CONSTRUCTOR
+
+RocAreaErrorTest::RocAreaErrorTest(void) : UnitTesting() 
+{
+}
+
+
+// DESTRUCTOR
+
+RocAreaErrorTest::~RocAreaErrorTest(void) 
+{
+}
+
+
+// METHODS
+
+void RocAreaErrorTest::test_constructor(void)
+{
+   message += "test_constructor\n";
+
+   // Default
+
+   RocAreaError rae1;
+
+   assert_true(rae1.has_neural_network() == false, LOG);
+   assert_true(rae1.has_data_set() == false, LOG);
+   assert_true(rae1.get_smoothing_width() == 0.1, LOG);
+
+   // Neural network and data set
+
+   NeuralNetwork nn3;
+   DataSet ds3;
+   RocAreaError rae3(&nn3, &ds3);
+
+   assert_true(rae3.has_neural_network() == true, LOG);
+   assert_true(rae3.has_data_set() == true, LOG);
+}
+
+
+void RocAreaErrorTest::test_destructor(void)
+{
+   message += "test_destructor\n";
+}
+
+
+void RocAreaErrorTest::test_set_smoothing_width(void)
+{
+   message += "test_set_smoothing_width\n";
+
+   RocAreaError rae;
+
+   bool exception_thrown = false;
+
+   // Test
+
+   rae.set_smoothing_width(0.01);
+
+   assert_true(rae.get_smoothing_width() == 0.01, LOG);
+
+   // Test
+
+   try
+   {
+      rae.set_smoothing_width(0.0);
+   }
+   catch(const std::logic_error&)
+   {
+      exception_thrown = true;
+   }
+
+   assert_true(exception_thrown, LOG);
+}
+
+
+void RocAreaErrorTest::test_calculate_smoothed_roc_area(void)
+{
+   message += "test_calculate_smoothed_roc_area\n";
+
+   RocAreaError rae;
+
+   Matrix<double> outputs;
+   Matrix<double> targets;
+
+   size_t positives_number;
+   size_t negatives_number;
+
+   double pairs_sum;
+
+   // Test
+
+   outputs.set(2, 1);
+   outputs(0,0) = 0.1;
+   outputs(1,0) = 0.9;
+
+   targets.set(2, 1);
+   targets(0,0) = 0.0;
+   targets(1,0) = 1.0;
+
+   assert_true(rae.calculate_smoothed_roc_area(outputs, targets) == 1.0, LOG);
+
+   // Test
+
+   outputs.initialize(0.5);
+
+   assert_true(fabs(rae.calculate_smoothed_roc_area(outputs, targets) - 0.5) < 1.0e-12, LOG);
+
+   // Test
+
+   outputs.set(100, 1);
+   targets.set(100, 1);
+
+   for(size_t i = 0; i < 100; i++)
+   {
+      outputs(i,0) = (double)i/100.0;
+      targets(i,0) = (i%3 == 0) ? 1.0 : 0.0;
+   }
+
+   rae.set_smoothing_width(0.001);
+
+   assert_true(fabs(rae.calculate_smoothed_roc_area(outputs, targets) - rae.calculate_roc_area(outputs, targets)) < 1.0e-12, LOG);
+
+   // Test
+
+   outputs.set(300, 1);
+   outputs.randomize_uniform(0.0, 1.0);
+
+   targets.set(300, 1);
+
+   for(size_t i = 0; i < 300; i++)
+   {
+      targets(i,0) = outputs(i,0) + 0.1*(double)(i%7) > 0.6 ? 1.0 : 0.0;
+   }
+
+   rae.set_smoothing_width(0.2);
+
+   positives_number = 0;
+   negatives_number = 0;
+
+   pairs_sum = 0.0;
+
+   for(size_t i = 0; i < 300; i++)
+   {
+      if(targets(i,0) == 0.0)
+      {
+         negatives_number++;
+
+         continue;
+      }
+
+      positives_number++;
+
+      for(size_t j = 0; j < 300; j++)
+      {
+         if(targets(j,0) == 0.0)
+         {
+            const double u = (outputs(i,0) - outputs(j,0))/0.2;
+
+            pairs_sum += u <= -1.0 ? 0.0 : u >= 1.0 ? 1.0 : 0.5 + 0.75*u - 0.25*u*u*u;
+         }
+      }
+   }
+
+   assert_true(fabs(rae.calculate_smoothed_roc_area(outputs, targets) - pairs_sum/(double)(positives_number*negatives_number)) < 1.0e-9, LOG);
+}
+
+
+void RocAreaErrorTest::test_calculate_smoothed_roc_area_gradient(void)
+{
+   message += "test_calculate_smoothed_roc_area_gradient\n";
+
+   RocAreaError rae;
+
+   Matrix<double> outputs(200, 1);
+   Matrix<double> targets(200, 1);
+
+   Matrix<double> outputs_forward;
+   Matrix<double> outputs_backward;
+
+   Vector<double> smoothed_roc_area_gradient;
+
+   const double h = 1.0e-6;
+
+   double numerical_derivative;
+
+   // Test
+
+   outputs.randomize_uniform(0.0, 1.0);
+
+   for(size_t i = 0; i < 200; i++)
+   {
+      targets(i,0) = (i%2 == 0) ? 1.0 : 0.0;
+   }
+
+   smoothed_roc_area_gradient = rae.calculate_smoothed_roc_area_gradient(outputs, targets);
+
+   assert_true(smoothed_roc_area_gradient.size() == 200, LOG);
+
+   for(size_t i = 0; i < 200; i += 17)
+   {
+      outputs_forward = outputs;
+      outputs_backward = outputs;
+
+      outputs_forward(i,0) += h;
+      outputs_backward(i,0) -= h;
+
+      numerical_derivative = (rae.calculate_smoothed_roc_area(outputs_forward, targets) - rae.calculate_smoothed_roc_area(outputs_backward, targets))/(2.0*h);
+
+      assert_true(fabs(smoothed_roc_area_gradient[i] - numerical_derivative) < 1.0e-6, LOG);
+   }
+}
+
+
+void RocAreaErrorTest::test_calculate_error(void)
+{
+   message += "test_calculate_error\n";
+
+   NeuralNetwork nn(2, 3, 1);
+   DataSet ds(50, 2, 1);
+
+   RocAreaError rae(&nn, &ds);
+
+   Matrix<double> data;
+
+   Vector<double> parameters;
+
+   // Test
+
+   ds.randomize_data_normal();
+
+   data = ds.get_data();
+
+   for(size_t i = 0; i < 50; i++)
+   {
+      data(i,2) = data(i,0) > 0.0 ? 1.0 : 0.0;
+   }
+
+   data(0,2) = 0.0;
+   data(1,2) = 1.0;
+
+   ds.set_data(data);
+
+   nn.randomize_parameters_normal();
+
+   parameters = nn.arrange_parameters();
+
+   assert_true(rae.calculate_error() == rae.calculate_error(parameters), LOG);
+   assert_true(rae.calculate_error() >= 0.0, LOG);
+   assert_true(rae.calculate_error() <= 1.0, LOG);
+
+   // Test
+
+   assert_true(rae.calculate_error(parameters*1.0001) != rae.calculate_error(parameters), LOG);
+}
+
+
+void RocAreaErrorTest::test_calculate_gradient(void)
+{
+   message += "test_calculate_gradient\n";
+
+   NumericalDifferentiation nd;
+
+   NeuralNetwork nn(3, 4, 1);
+   DataSet ds(300, 3, 1);
+
+   RocAreaError rae(&nn, &ds);
+
+   Matrix<double> data;
+
+   Vector<double> parameters;
+
+   Vector<double> gradient;
+   Vector<double> numerical_gradient;
+
+   // Test
+
+   ds.randomize_data_normal();
+
+   data = ds.get_data();
+
+   for(size_t i = 0; i < 300; i++)
+   {
+      data(i,3) = data(i,0) + 0.5*data(i,1) > 0.0 ? 1.0 : 0.0;
+   }
+
+   data(0,3) = 0.0;
+   data(1,3) = 1.0;
+
+   ds.set_data(data);
+
+   nn.randomize_parameters_normal();
+
+   parameters = nn.arrange_parameters();
+
+   gradient = rae.calculate_gradient();
+   numerical_gradient = nd.calculate_gradient(rae, &RocAreaError::calculate_error, parameters);
+
+   assert_true(gradient.size() == nn.count_parameters_number(), LOG);
+   assert_true((gradient - numerical_gradient).calculate_absolute_value() < 1.0e-3, LOG);
+}
+
+
+void RocAreaErrorTest::run_test_case(void)
+{
+   message += "Running ROC area error test case...\n";  
+
+   // Constructor and destructor methods
+
+   test_constructor();
+   test_destructor();
+
+   // Set methods
+
+   test_set_smoothing_width();
+
+   // Objective methods
+
+   test_calculate_smoothed_roc_area();
+   test_calculate_smoothed_roc_area_gradient();
+
+   test_calculate_error();
+
+   test_calculate_gradient();
+
+   message += "End of ROC area error test case.\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2016 Roberto Lopez.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -102,6 +102,33 @@ void RootMeanSquaredErrorTest::test_calculate_loss(void)
 
    assert_true(rmse.calculate_error() == rmse.calculate_error(parameters), LOG);
 
+   // Test
+
+   nn.set(3, 4, 2);
+   nn.randomize_parameters_normal();
+
+   parameters = nn.arrange_parameters();
+
+   ds.set(300, 3, 2);
+   ds.randomize_data_normal();
+   ds.get_instances_pointer()->split_random_indices();
+
+   ds.set_data_file_name("../data/data.dat");
+   ds.save_data_binary();
+
+   DataSet ds_out_of_core;
+
+   ds_out_of_core.set_data_file_name("../data/data.dat");
+   ds_out_of_core.load_data_out_of_core(64, 2);
+
+   RootMeanSquaredError rmse_out_of_core(&nn, &ds_out_of_core);
+
+   assert_true(fabs(rmse_out_of_core.calculate_error() - rmse.calculate_error()) < 1.0e-9, LOG);
+   assert_true(fabs(rmse_out_of_core.calculate_error(parameters*2.0) - rmse.calculate_error(parameters*2.0)) < 1.0e-9, LOG);
+   assert_true(fabs(rmse_out_of_core.calculate_selection_error() - rmse.calculate_selection_error()) < 1.0e-9, LOG);
+
+   assert_true(!ds_out_of_core.has_split_data(Instances::Training), LOG);
+   assert_true(!ds_out_of_core.has_split_data(Instances::Selection), LOG);
 }
 
 
@@ -0,0 +1,369 @@
+/****************************************************************************************************************/
+/*                                                                                                              */
+/*   OpenNN: Open Neural Networks Library                                                                       */
+/*   www.opennn.net                                                                                             */
+/*                                                                                                              */
+/*   S T O C H A S T I C   G R A D I E N T   D E S C E N T   T E S T   C L A S S                                */
+/*                                                                                                              */
+/*   Roberto Lopez                                                                                              */
+/*   Artelnics - Making intelligent use of data                                                                 */
+/*   robertolopez@artelnics.com                                                                                 */
+/*                                                                                                              */
+/****************************************************************************************************************/
+
+// Unit testing includes
+
+#include "stochastic_gradient_descent_test.h"
+
+using namespace OpenNN;
+
+
+// GENERAL CONSTRUCTOR
+
+StochasticGradientDescentTest::StochasticGradientDescentTest(void) : UnitTesting()
+{
+}
+
+
+// DESTRUCTOR
+
+StochasticGradientDescentTest::~StochasticGradientDescentTest(void)
+{
+}
+
+
+// METHODS
+
+void StochasticGradientDescentTest::test_constructor(void)
+{
+   message += "test_constructor\n";
+
+   LossIndex pf;
+
+   // Default constructor
+
+   StochasticGradientDescent sgd1;
+   assert_true(sgd1.has_loss_index() == false, LOG);
+
+   // Loss index constructor
+
+   StochasticGradientDescent sgd2(&pf);
+   assert_true(sgd2.has_loss_index() == true, LOG);
+}
+
+
+void StochasticGradientDescentTest::test_destructor(void)
+{
+   message += "test_destructor\n";
+}
+
+
+void StochasticGradientDescentTest::test_set_reserve_all_training_history(void)
+{
+   message += "test_set_reserve_all_training_history\n";
+
+   StochasticGradientDescent sgd;
+
+   sgd.set_reserve_all_training_history(true);
+
+   assert_true(sgd.get_reserve_loss_history() == true, LOG);
+   assert_true(sgd.get_reserve_selection_loss_history() == true, LOG);
+   assert_true(sgd.get_reserve_learning_rate_history() == true, LOG);
+   assert_true(sgd.get_reserve_elapsed_time_history() == true, LOG);
+}
+
+
+void StochasticGradientDescentTest::test_set_learning_rate_schedule(void)
+{
+   message += "test_set_learning_rate_schedule\n";
+
+   StochasticGradientDescent sgd;
+
+   // Test
+
+   sgd.set_learning_rate_schedule("InverseTime");
+
+   assert_true(sgd.get_learning_rate_schedule() == StochasticGradientDescent::InverseTime, LOG);
+   assert_true(sgd.write_learning_rate_schedule() == "InverseTime", LOG);
+
+   // Test
+
+   sgd.set_learning_rate_schedule("Exponential");
+
+   assert_true(sgd.get_learning_rate_schedule() == StochasticGradientDescent::Exponential, LOG);
+}
+
+
+void StochasticGradientDescentTest::test_set_batch_size(void)
+{
+   message += "test_set_batch_size\n";
+
+   StochasticGradientDescent sgd;
+
+   bool exception_thrown;
+
+   // Test
+
+   sgd.set_batch_size(16);
+
+   assert_true(sgd.get_batch_size() == 16, LOG);
+
+   // Test
+
+   exception_thrown = false;
+
+   try
+   {
+      sgd.set_batch_size(0);
+   }
+   catch(const std::logic_error&)
+   {
+      exception_thrown = true;
+   }
+
+   assert_true(exception_thrown, LOG);
+   assert_true(sgd.get_batch_size() == 16, LOG);
+}
+
+
+void StochasticGradientDescentTest::test_calculate_learning_rate(void)
+{
+   message += "test_calculate_learning_rate\n";
+
+   StochasticGradientDescent sgd;
+
+   sgd.set_initial_learning_rate(0.1);
+   sgd.set_learning_rate_decay(0.5);
+
+   // Test
+
+   sgd.set_learning_rate_schedule(StochasticGradientDescent::Constant);
+
+   assert_true(sgd.calculate_learning_rate(10) == 0.1, LOG);
+
+   // Test
+
+   sgd.set_learning_rate_schedule(StochasticGradientDescent::InverseTime);
+
+   assert_true(sgd.calculate_learning_rate(0) == 0.1, LOG);
+   assert_true(fabs(sgd.calculate_learning_rate(2) - 0.05) < 1.0e-12, LOG);
+
+   // Test
+
+   sgd.set_learning_rate_schedule(StochasticGradientDescent::Exponential);
+
+   assert_true(fabs(sgd.calculate_learning_rate(2) - 0.1*exp(-1.0)) < 1.0e-12, LOG);
+}
+
+
+void StochasticGradientDescentTest::test_perform_training(void)
+{
+   message += "test_perform_training\n";
+
+   DataSet ds(100, 2, 1);
+   ds.randomize_data_normal();
+
+   NeuralNetwork nn(2, 2, 1);
+   nn.randomize_parameters_normal();
+
+   LossIndex pf(&nn, &ds);
+
+   pf.destruct_all_terms();
+   pf.set_error_type(LossIndex::MEAN_SQUARED_ERROR);
+
+   StochasticGradientDescent sgd(&pf);
+
+   sgd.set_display(false);
+
+   StochasticGradientDescent::StochasticGradientDescentResults* results_pointer;
+
+   double old_loss;
+   double loss;
+
+   Vector<double> parameters;
+   Vector<double> gradient;
+
+   // Test
+
+   old_loss = pf.calculate_loss();
+
+   sgd.set_batch_size(10);
+   sgd.set_maximum_epochs_number(10);
+
+   results_pointer = sgd.perform_training();
+
+   loss = pf.calculate_loss();
+
+   assert_true(loss < old_loss, LOG);
+   assert_true(results_pointer->epochs_number == 10, LOG);
+   assert_true(results_pointer->loss_history.size() == 11, LOG);
+
+   delete results_pointer;
+
+   // Test
+
+   nn.randomize_parameters_normal();
+
+   old_loss = pf.calculate_loss();
+
+   sgd.set_momentum(0.9);
+   sgd.set_nesterov(true);
+
+   results_pointer = sgd.perform_training();
+
+   loss = pf.calculate_loss();
+
+   assert_true(loss < old_loss, LOG);
+
+   delete results_pointer;
+
+   // Test
+
+   nn.randomize_parameters_normal();
+
+   parameters = nn.arrange_parameters();
+   gradient = pf.calculate_gradient();
+
+   sgd.set_momentum(0.0);
+   sgd.set_nesterov(false);
+   sgd.set_batch_size(1000);
+   sgd.set_maximum_epochs_number(1);
+
+   results_pointer = sgd.perform_training();
+
+   assert_true((nn.arrange_parameters() - (parameters - gradient*0.01)).calculate_absolute_value() < 1.0e-6, LOG);
+
+   delete results_pointer;
+
+   // Performance goal
+
+   parameters = nn.arrange_parameters();
+
+   sgd.set_loss_goal(1.0e99);
+
+   results_pointer = sgd.perform_training();
+
+   assert_true(results_pointer->stopping_condition == TrainingAlgorithm::PerformanceGoal, LOG);
+   assert_true(nn.arrange_parameters() == parameters, LOG);
+
+   delete results_pointer;
+
+   // No training instances
+
+   ds.get_instances_pointer()->set_selection();
+
+   bool exception_thrown = false;
+
+   try
+   {
+      results_pointer = sgd.perform_training();
+
+      delete results_pointer;
+   }
+   catch(const std::logic_error&)
+   {
+      exception_thrown = true;
+   }
+
+   assert_true(exception_thrown, LOG);
+}
+
+
+void StochasticGradientDescentTest::test_to_XML(void)
+{
+   message += "test_to_XML\n";
+
+   StochasticGradientDescent sgd;
+
+   tinyxml2::XMLDocument* document;
+
+   // Test
+
+   document = sgd.to_XML();
+   assert_true(document != NULL, LOG);
+
+   delete document;
+}
+
+
+void StochasticGradientDescentTest::test_from_XML(void)
+{
+   message += "test_from_XML\n";
+
+   StochasticGradientDescent sgd1;
+   StochasticGradientDescent sgd2;
+
+   tinyxml2::XMLDocument* document;
+
+   // Test
+
+   sgd1.set_batch_size(7);
+   sgd1.set_initial_learning_rate(0.5);
+   sgd1.set_learning_rate_schedule(StochasticGradientDescent::Exponential);
+   sgd1.set_learning_rate_decay(0.25);
+   sgd1.set_momentum(0.75);
+   sgd1.set_nesterov(true);
+   sgd1.set_maximum_epochs_number(3);
+
+   document = sgd1.to_XML();
+
+   sgd2.from_XML(*document);
+
+   delete document;
+
+   assert_true(sgd2.get_batch_size() == 7, LOG);
+   assert_true(sgd2.get_initial_learning_rate() == 0.5, LOG);
+   assert_true(sgd2.get_learning_rate_schedule() == StochasticGradientDescent::Exponential, LOG);
+   assert_true(sgd2.get_learning_rate_decay() == 0.25, LOG);
+   assert_true(sgd2.get_momentum() == 0.75, LOG);
+   assert_true(sgd2.get_nesterov() == true, LOG);
+   assert_true(sgd2.get_maximum_epochs_number() == 3, LOG);
+}
+
+
+void StochasticGradientDescentTest::run_test_case(void)
+{
+   message += "Running stochastic gradient descent test case...\n";
+
+   // Constructor and destructor methods
+
+   test_constructor();
+   test_destructor();
+
+   // Set methods
+
+   test_set_reserve_all_training_history();
+   test_set_learning_rate_schedule();
+   test_set_batch_size();
+
+   // Training methods
+
+   test_calculate_learning_rate();
+
+   test_perform_training();
+
+   // Serialization methods
+
+   test_to_XML();
+   test_from_XML();
+
+   message += "End of stochastic gradient descent test case.\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2016 Roberto Lopez.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
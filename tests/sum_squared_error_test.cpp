@@ -147,6 +147,34 @@ void SumSquaredErrorTest::test_calculate_loss(void)
    missing_values_pointer->append(0, 0);
 
 //   assert_true(sse.calculate_loss() == 0.0, LOG);
+
+   // Test
+
+   nn.set(3, 4, 2);
+   nn.randomize_parameters_normal();
+
+   parameters = nn.arrange_parameters();
+
+   ds.set(300, 3, 2);
+   ds.randomize_data_normal();
+   ds.get_instances_pointer()->split_random_indices();
+
+   ds.set_data_file_name("../data/data.dat");
+   ds.save_data_binary();
+
+   DataSet ds_out_of_core;
+
+   ds_out_of_core.set_data_file_name("../data/data.dat");
+   ds_out_of_core.load_data_out_of_core(64, 2);
+
+   SumSquaredError sse_out_of_core(&nn, &ds_out_of_core);
+
+   assert_true(fabs(sse_out_of_core.calculate_error() - sse.calculate_error()) < 1.0e-9, LOG);
+   assert_true(fabs(sse_out_of_core.calculate_error(parameters*2.0) - sse.calculate_error(parameters*2.0)) < 1.0e-9, LOG);
+   assert_true(fabs(sse_out_of_core.calculate_selection_error() - sse.calculate_selection_error()) < 1.0e-9, LOG);
+
+   assert_true(!ds_out_of_core.has_split_data(Instances::Training), LOG);
+   assert_true(!ds_out_of_core.has_split_data(Instances::Selection), LOG);
 }
 
 
@@ -184,7 +212,7 @@ void SumSquaredErrorTest::test_calculate_gradient(void)
    nn.set(3, 4, 2);
    nn.initialize_parameters(0.0);
 
-   ds.set(3, 2, 5);
+   ds.set(5, 3, 2);
    sse.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -254,7 +282,7 @@ void SumSquaredErrorTest::test_calculate_gradient(void)
    nn.set(2, 3, 4);
    nn.initialize_parameters(0.0);
 
-   ds.set(2, 4, 5);
+   ds.set(2, 2, 4);
    sse.set(&nn, &ds);
    ds.initialize_data(0.0);
 
@@ -315,6 +343,23 @@ void SumSquaredErrorTest::test_calculate_gradient(void)
    gradient.clear();
 
    gradient = sse.calculate_gradient();
+
+   // Test
+
+   nn.set(3, 5, 2);
+   nn.randomize_parameters_normal();
+   parameters = nn.arrange_parameters();
+
+   ds.set(600, 3, 2);
+   ds.randomize_data_normal();
+
+   sse.set(&nn, &ds);
+
+   gradient = sse.calculate_single_precision_gradient();
+   numerical_gradient = nd.calculate_gradient(sse, &SumSquaredError::calculate_error, parameters);
+
+   assert_true(gradient.size() == nn.count_parameters_number(), LOG);
+   assert_true((gradient - numerical_gradient).calculate_norm() < 1.0e-4*numerical_gradient.calculate_norm(), LOG);
 }
 
 
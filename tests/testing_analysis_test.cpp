@@ -116,6 +116,88 @@ void TestingAnalysisTest::test_set_display(void)
 }
 
 
+void TestingAnalysisTest::test_get_testing_outputs(void)
+{
+   message += "test_get_testing_outputs\n";
+
+   NeuralNetwork nn;
+   DataSet ds;
+
+   TestingAnalysis ta(&nn, &ds);
+
+   TestingAnalysis::TestingOutputs testing_outputs;
+
+   // Test
+
+   nn.set(1, 1);
+   nn.initialize_parameters(0.0);
+
+   ds.set(5, 1, 1);
+   ds.randomize_data_uniform();
+   ds.get_instances_pointer()->set_testing();
+
+   testing_outputs = ta.get_testing_outputs();
+
+   assert_true(testing_outputs.target_data.get_rows_number() == 5, LOG);
+   assert_true(testing_outputs.output_data.get_rows_number() == 5, LOG);
+   assert_true(testing_outputs.output_data.get_columns_number() == 1, LOG);
+   assert_true(testing_outputs.sorted_indices.size() == 5, LOG);
+   assert_true(testing_outputs.target_data == ds.get_testing_target_data(), LOG);
+
+   // Test
+
+   nn.initialize_parameters(1.0);
+
+   testing_outputs = ta.get_testing_outputs();
+
+   assert_true(testing_outputs.output_data == nn.calculate_output_data(ds.get_testing_input_data()), LOG);
+
+   for(size_t i = 1; i < 5; i++)
+   {
+      assert_true(testing_outputs.output_data(testing_outputs.sorted_indices[i-1], 0)
+               <= testing_outputs.output_data(testing_outputs.sorted_indices[i], 0), LOG);
+   }
+
+   // Test
+
+   ds.initialize_data(1.0);
+
+   testing_outputs = ta.get_testing_outputs();
+
+   assert_true(testing_outputs.target_data == 1.0, LOG);
+   assert_true(testing_outputs.output_data == nn.calculate_output_data(ds.get_testing_input_data()), LOG);
+
+   // Test
+
+   nn.set(3, 4, 2);
+   nn.randomize_parameters_normal();
+
+   ds.set(600, 3, 2);
+   ds.randomize_data_normal();
+   ds.get_instances_pointer()->split_random_indices();
+
+   ds.set_data_file_name("../data/data.dat");
+   ds.save_data_binary();
+
+   DataSet ds_out_of_core;
+
+   ds_out_of_core.set_data_file_name("../data/data.dat");
+   ds_out_of_core.load_data_out_of_core(64, 2);
+
+   TestingAnalysis ta_out_of_core(&nn, &ds_out_of_core);
+
+   testing_outputs = ta.get_testing_outputs();
+
+   const TestingAnalysis::TestingOutputs& testing_outputs_out_of_core = ta_out_of_core.get_testing_outputs();
+
+   assert_true(testing_outputs_out_of_core.target_data == testing_outputs.target_data, LOG);
+   assert_true(testing_outputs_out_of_core.output_data == testing_outputs.output_data, LOG);
+   assert_true(testing_outputs_out_of_core.sorted_indices == testing_outputs.sorted_indices, LOG);
+
+   assert_true(!ds_out_of_core.has_split_data(Instances::Testing), LOG);
+}
+
+
 void TestingAnalysisTest::test_calculate_target_output_data(void)
 {
    message += "test_calculate_target_output_data\n";
@@ -570,6 +652,37 @@ void TestingAnalysisTest::test_calculate_area_under_curve(void)
 
     assert_true(area_under_curve == 0, LOG);
 
+    // Test
+
+    target_data.set(500, 1);
+
+    output_data.set(500, 1);
+    output_data.randomize_uniform(0.0, 10.0);
+
+    for(size_t i = 0; i < 500; i++)
+    {
+        target_data(i,0) = (i%3 == 0) ? 1.0 : 0.0;
+
+        output_data(i,0) = floor(output_data(i,0))/10.0;
+    }
+
+    double sum = 0.0;
+
+    for(size_t i = 0; i < 500; i++)
+    {
+        for(size_t j = 0; j < 500; j++)
+        {
+            if(target_data(i,0) == 1.0 && target_data(j,0) == 0.0)
+            {
+                sum += ta.calculate_Wilcoxon_parameter(output_data(i,0), output_data(j,0));
+            }
+        }
+    }
+
+    area_under_curve = ta.calculate_area_under_curve(target_data, output_data);
+
+    assert_true(fabs(area_under_curve - sum/(167.0*333.0)) < 1.0e-12, LOG);
+
 }
 
 
@@ -1213,6 +1326,8 @@ void TestingAnalysisTest::run_test_case(void)
 
    // Target and output data methods
 
+   test_get_testing_outputs();
+
    test_calculate_target_output_data();
 
    // Error data methods
@@ -63,6 +63,8 @@ public:
 
    // Target and output data methods
 
+   void test_get_testing_outputs(void);
+
    void test_calculate_target_output_data(void);
 
    // Error data methods
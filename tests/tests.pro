@@ -57,6 +57,7 @@ SOURCES += \
     weighted_squared_error_test.cpp \
     neural_parameters_norm_test.cpp \
     minkowski_error_test.cpp \
+    roc_area_error_test.cpp \
     mean_squared_error_test.cpp \
     cross_entropy_error_test.cpp \
     training_strategy_test.cpp \
@@ -67,6 +68,8 @@ SOURCES += \
     quasi_newton_method_test.cpp \
     newton_method_test.cpp \
     levenberg_marquardt_algorithm_test.cpp \
+    stochastic_gradient_descent_test.cpp \
+    adaptive_moment_estimation_test.cpp \
     gradient_descent_test.cpp \
     evolutionary_algorithm_test.cpp \
     conjugate_gradient_test.cpp \
@@ -117,6 +120,7 @@ HEADERS += \
     weighted_squared_error_test.h \
     neural_parameters_norm_test.h \
     minkowski_error_test.h \
+    roc_area_error_test.h \
     mean_squared_error_test.h \
     cross_entropy_error_test.h \
     training_strategy_test.h \
@@ -127,6 +131,8 @@ HEADERS += \
     quasi_newton_method_test.h \
     newton_method_test.h \
     levenberg_marquardt_algorithm_test.h \
+    stochastic_gradient_descent_test.h \
+    adaptive_moment_estimation_test.h \
     gradient_descent_test.h \
     evolutionary_algorithm_test.h \
     conjugate_gradient_test.h \
@@ -103,6 +103,53 @@ void VectorTest::test_destructor(void)
 }
 
 
+void VectorTest::test_assignment_operator(void)
+{
+   message += "test_assignment_operator\n";
+
+   Vector<double> a(3, 1.0);
+   Vector<double> b(3, 2.0);
+   Vector<double> c;
+
+   // Test
+
+   c = a;
+
+   assert_true(c.size() == 3, LOG);
+   assert_true(c == 1.0, LOG);
+
+   // Test
+
+   c = a + b;
+
+   assert_true(c.size() == 3, LOG);
+   assert_true(c == 3.0, LOG);
+
+   // Test
+
+   c = a.eigen_map() + b.eigen_map()*2.0;
+
+   assert_true(c.size() == 3, LOG);
+   assert_true(c == 5.0, LOG);
+
+   // Test
+
+   c.set(5, 0.0);
+
+   c = a.eigen_map()*2.0;
+
+   assert_true(c.size() == 3, LOG);
+   assert_true(c == 2.0, LOG);
+
+   // Test
+
+   const Vector<double> d = a.eigen_map() - b.eigen_map();
+
+   assert_true(d.size() == 3, LOG);
+   assert_true(d == -1.0, LOG);
+}
+
+
 void VectorTest::test_sum_operator(void)
 {
    message += "test_sum_operator\n";
@@ -1036,6 +1083,101 @@ void VectorTest::test_calculate_statistics(void)
 }
 
 
+void VectorTest::test_calculate_quartiles(void)
+{
+   message += "test_calculate_quartiles\n";
+
+   Vector<double> v;
+
+   Vector<double> sorted_v;
+
+   Vector<double> quartiles;
+
+   // Test
+
+   v.set(1, 3.0);
+
+   quartiles = v.calculate_quartiles();
+
+   assert_true(quartiles == 3.0, LOG);
+   assert_true(v.calculate_median() == 3.0, LOG);
+
+   // Test
+
+   v.set(1001);
+   v.randomize_normal();
+
+   sorted_v = v;
+   std::sort(sorted_v.begin(), sorted_v.end());
+
+   quartiles = v.calculate_quartiles();
+
+   assert_true(quartiles[0] == sorted_v[250], LOG);
+   assert_true(quartiles[1] == sorted_v[500], LOG);
+   assert_true(quartiles[2] == sorted_v[750], LOG);
+   assert_true(quartiles[3] == sorted_v[1000], LOG);
+
+   assert_true(v.calculate_median() == sorted_v[500], LOG);
+
+   // Test
+
+   v.set(8);
+   v.initialize_sequential();
+
+   quartiles = v.calculate_quartiles();
+
+   assert_true(quartiles[0] == 2.5, LOG);
+   assert_true(quartiles[1] == 4.5, LOG);
+   assert_true(quartiles[2] == 6.5, LOG);
+   assert_true(quartiles[3] == 7.0, LOG);
+
+   assert_true(v.calculate_median() == 3.5, LOG);
+}
+
+
+void VectorTest::test_quantile_sketch(void)
+{
+   message += "test_quantile_sketch\n";
+
+   QuantileSketch<double> sketch(64);
+   QuantileSketch<double> other_sketch(64);
+
+   Vector<double> v;
+
+   Vector<double> sorted_v;
+
+   // Test
+
+   v.set(20000);
+   v.randomize_uniform(0.0, 1.0);
+
+   for(size_t i = 0; i < 10000; i++)
+   {
+      sketch.update(v[i]);
+   }
+
+   for(size_t i = 10000; i < 20000; i++)
+   {
+      other_sketch.update(v[i]);
+   }
+
+   sketch.merge(other_sketch);
+
+   sorted_v = v;
+   std::sort(sorted_v.begin(), sorted_v.end());
+
+   assert_true(sketch.count == 20000, LOG);
+   assert_true(sketch.calculate_quantile(0.0) == sorted_v[0], LOG);
+   assert_true(sketch.calculate_quantile(1.0) == sorted_v[19999], LOG);
+
+   const double median = sketch.calculate_quantile(0.5);
+
+   const size_t median_rank = std::lower_bound(sorted_v.begin(), sorted_v.end(), median) - sorted_v.begin();
+
+   assert_true(median_rank > 9000 && median_rank < 11000, LOG);
+}
+
+
 void VectorTest::test_calculate_histogram(void)
 {
    message += "test_calculate_histogram\n";
@@ -1090,7 +1232,45 @@ void VectorTest::test_calculate_histogram(void)
 
    assert_true(histogram.frequencies.calculate_sum() == 20, LOG);
 
+   // Test
+
+   v.set(10000);
+   v.randomize_normal();
+
+   v[0] = 0.0;
+   v[1] = 1.0;
+
+   for(size_t i = 2; i < 100; i++)
+   {
+      v[i] = (double)(i%11)/10.0;
+   }
+
+   histogram = v.calculate_histogram(7);
+
+   frequencies.set(7, 0);
 
+   for(size_t i = 0; i < v.size(); i++)
+   {
+      for(size_t j = 0; j < 6; j++)
+      {
+         if(v[i] >= histogram.minimums[j] && v[i] < histogram.maximums[j])
+         {
+            frequencies[j]++;
+         }
+      }
+
+      if(v[i] >= histogram.minimums[6])
+      {
+         frequencies[6]++;
+      }
+   }
+
+   assert_true(histogram.frequencies == frequencies, LOG);
+
+   for(size_t i = 0; i < 7; i++)
+   {
+      assert_true(histogram.calculate_bin(histogram.centers[i]) == i, LOG);
+   }
 }
 
 
@@ -1823,6 +2003,59 @@ void VectorTest::test_calculate_greater_rank(void)
 }
 
 
+void VectorTest::test_sort_less_indices(void)
+{
+   message += "test_sort_less_indices\n";
+
+   Vector<double> v;
+
+   Vector<size_t> indices;
+
+   bool sorted;
+
+   // Test
+
+   v.set(4);
+   v[0] = 2.0;
+   v[1] = 1.0;
+   v[2] = 2.0;
+   v[3] = 0.0;
+
+   indices = v.sort_less_indices();
+
+   assert_true(indices[0] == 3, LOG);
+   assert_true(indices[1] == 1, LOG);
+   assert_true(indices[2] == 0, LOG);
+   assert_true(indices[3] == 2, LOG);
+
+   // Test
+
+   v.set(200000);
+   v.randomize_uniform(0.0, 100.0);
+
+   for(size_t i = 0; i < v.size(); i++)
+   {
+      v[i] = floor(v[i]);
+   }
+
+   indices = v.sort_less_indices();
+
+   sorted = true;
+
+   for(size_t i = 1; i < indices.size(); i++)
+   {
+      if(v[indices[i-1]] > v[indices[i]]
+      || (v[indices[i-1]] == v[indices[i]] && indices[i-1] > indices[i]))
+      {
+         sorted = false;
+      }
+   }
+
+   assert_true(sorted, LOG);
+   assert_true(indices.calculate_sum() == v.size()*(v.size()-1)/2, LOG);
+}
+
+
 void VectorTest::test_calculate_linear_correlation(void)
 {
     message += "test_calculate_linear_correlation\n";
@@ -2123,6 +2356,10 @@ void VectorTest::run_test_case(void)
    test_constructor();
    test_destructor();
 
+   // Assignment operators methods
+
+   test_assignment_operator();
+
    // Arithmetic operators
 
    test_sum_operator();
@@ -2214,6 +2451,8 @@ void VectorTest::run_test_case(void)
 
    test_calculate_explained_variance();
 
+   test_calculate_quartiles();
+   test_quantile_sketch();
    test_calculate_histogram();
 
    test_calculate_bin();
@@ -2252,6 +2491,8 @@ void VectorTest::run_test_case(void)
    test_calculate_less_rank();
    test_calculate_greater_rank();
 
+   test_sort_less_indices();
+
    test_calculate_linear_correlation();
    test_calculate_linear_correlation_missing_values();
    test_calculate_linear_regression_parameters();
@@ -145,6 +145,9 @@ public:
 
    void test_calculate_statistics(void);
 
+   void test_calculate_quartiles(void);
+   void test_quantile_sketch(void);
+
    void test_calculate_histogram(void);
 
    void test_calculate_bin(void);
@@ -183,6 +186,8 @@ public:
    void test_calculate_less_rank(void);
    void test_calculate_greater_rank(void);
 
+   void test_sort_less_indices(void);
+
    void test_calculate_linear_correlation(void);
    void test_calculate_linear_correlation_missing_values(void);
 
@@ -69,6 +69,46 @@ void WeightedSquaredErrorTest::test_destructor(void)
 }
 
 
+void WeightedSquaredErrorTest::test_get_negatives_number(void)
+{
+   message += "test_get_negatives_number\n";
+
+   NeuralNetwork nn(1, 1);
+
+   DataSet ds(4, 1, 1);
+
+   WeightedSquaredError wse(&nn, &ds);
+
+   Matrix<double> data(4, 2, 0.0);
+
+   // Test
+
+   data(0,1) = 1.0;
+
+   ds.set_data(data);
+
+   ds.get_instances_pointer()->set_training();
+
+   assert_true(wse.get_training_negatives_number() == 3, LOG);
+   assert_true(wse.get_selection_negatives_number() == 0, LOG);
+
+   // Test
+
+   data(1,1) = 1.0;
+
+   ds.set_data(data);
+
+   assert_true(wse.get_training_negatives_number() == 2, LOG);
+
+   // Test
+
+   ds.get_instances_pointer()->set_use(3, Instances::Selection);
+
+   assert_true(wse.get_training_negatives_number() == 1, LOG);
+   assert_true(wse.get_selection_negatives_number() == 1, LOG);
+}
+
+
 void WeightedSquaredErrorTest::test_calculate_loss(void)
 {
    message += "test_calculate_loss\n";
@@ -508,6 +548,8 @@ void WeightedSquaredErrorTest::run_test_case(void)
 
    // Get methods
 
+   test_get_negatives_number();
+
    // Set methods
 
    // Objective methods
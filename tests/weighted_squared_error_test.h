@@ -50,6 +50,8 @@ public:
 
    // Get methods
 
+   void test_get_negatives_number(void);
+
    // Set methods
 
    // Objective methods